@@ -248,6 +248,17 @@ AwaError AwaClientSession_Process(AwaClientSession * session, AwaTimeout timeout
  */
 AwaError AwaClientSession_DispatchCallbacks(AwaClientSession * session);
 
+/**
+ * @brief Retrieve the file descriptor on which the session receives notifications and responses to
+ *        asynchronous operations, so that it can be monitored with select() or poll() in an application's
+ *        own event loop. When it becomes readable, call AwaClientSession_Process with a zero timeout,
+ *        followed by AwaClientSession_DispatchCallbacks.
+ * @param[in] session Pointer to a connected session.
+ * @return A non-negative file descriptor on success.
+ * @return -1 if the session is invalid or not connected.
+ */
+int AwaClientSession_GetFileDescriptor(const AwaClientSession * session);
+
 /**
  * @brief When a session is no longer required, or if the application intends to sleep for some time, the session can be
  *        disconnected from the Core. This maintains object and resource definition information, but prevents the
@@ -387,6 +398,19 @@ AwaClientGetOperation * AwaClientGetOperation_New(const AwaClientSession * sessi
  */
 AwaError AwaClientGetOperation_AddPath(AwaClientGetOperation * operation, const char * path);
 
+/**
+ * @brief Adds a path of interest to a Get operation, identified by IDs rather than a path string.
+ *        Behaves as AwaClientGetOperation_AddPath, without the cost of formatting and parsing a path.
+ * @param[in] operation The Get operation to add the path of interest to.
+ * @param[in] objectID The object requested for retrieval.
+ * @param[in] objectInstanceID The object instance requested for retrieval, or AWA_INVALID_ID for the whole object.
+ * @param[in] resourceID The resource requested for retrieval, or AWA_INVALID_ID for the whole object instance.
+ * @return AwaError_Success on success.
+ * @return AwaError_OperationInvalid if the operation is invalid.
+ * @return AwaError_PathInvalid if the IDs do not form a valid data model path.
+ */
+AwaError AwaClientGetOperation_AddPathByID(AwaClientGetOperation * operation, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID);
+
 /**
  * @brief Add a resource path to a multiple-instance resource and specify a range of resource instances to retrieve.
  *        The path must correspond to a resource path; object and object instance paths are not permitted.
@@ -415,6 +439,23 @@ AwaError AwaClientGetOperation_AddPathWithArrayRange(AwaClientGetOperation * ope
  */
 AwaError AwaClientGetOperation_Perform(AwaClientGetOperation * operation, AwaTimeout timeout);
 
+/**
+ * @brief Send the Get operation to the Core without waiting for its response. The response is received by
+ *        AwaClientSession_Process, and on AwaClientSession_DispatchCallbacks it is stored in the operation,
+ *        as if by AwaClientGetOperation_Perform, before callback is invoked with the result.
+ *        The operation must not be freed or performed again until its callback has been invoked.
+ * @param[in] operation The Get operation to process.
+ * @param[in] timeout The time in milliseconds to wait for a response before callback is invoked with
+ *                    AwaError_Timeout. Pass 0 to wait indefinitely.
+ * @param[in] callback The callback to invoke when the operation completes. May be NULL.
+ * @param[in] context A pointer to user-specified data passed to callback.
+ * @param[out] requestID If not NULL, set to the ID passed to callback for this request.
+ * @return AwaError_Success if the request was sent.
+ * @return Various errors on failure.
+ */
+AwaError AwaClientGetOperation_PerformAsync(AwaClientGetOperation * operation, AwaTimeout timeout,
+                                           AwaOperationCompleteCallback callback, void * context, AwaRequestID * requestID);
+
 /**
  * @brief Clean up a Get operation, freeing all allocated resources.
  *        Once freed, the operation is no longer valid.
@@ -484,6 +525,18 @@ const AwaPathResult * AwaClientGetResponse_GetPathResult(const AwaClientGetRespo
  */
 bool AwaClientGetResponse_HasValue(const AwaClientGetResponse * response, const char * path);
 
+/**
+ * @brief Test if the Get Response has a value for the resource identified by IDs.
+ *        Behaves as AwaClientGetResponse_HasValue, without the cost of parsing a path.
+ * @param[in] response A pointer to a valid Get Response.
+ * @param[in] objectID The object ID of the resource.
+ * @param[in] objectInstanceID The object instance ID of the resource.
+ * @param[in] resourceID The resource ID.
+ * @return True if the Get Response contains a value for the specified resource.
+ * @return False if the Get Response does not contain a value for the specified resource, or if the IDs are invalid.
+ */
+bool AwaClientGetResponse_HasValueByID(const AwaClientGetResponse * response, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID);
+
 /**
  * @defgroup GetResponse_GetValueAs AwaClientGetResponse_GetValueAs___Pointer
  * @addtogroup GetResponse_GetValueAs
@@ -510,6 +563,32 @@ AwaError AwaClientGetResponse_GetValueAsObjectLinkPointer(const AwaClientGetResp
 AwaError AwaClientGetResponse_GetValueAsOpaquePointer    (const AwaClientGetResponse * response, const char * path, const AwaOpaque ** value);
 /** @} */
 
+/**
+ * @defgroup GetResponse_GetValueAsByID AwaClientGetResponse_GetValueAs___PointerByID
+ * @addtogroup GetResponse_GetValueAsByID
+ * @brief Retrieve a temporary pointer to a resource's value from a Get Response. The resource is identified by IDs.
+ *        Behaves as the AwaClientGetResponse_GetValueAs___Pointer functions, without the cost of parsing a path.
+ * @param[in] response The current Get Response to retrieve the value from.
+ * @param[in] objectID The object ID of the resource requested for retrieval.
+ * @param[in] objectInstanceID The object instance ID of the resource requested for retrieval.
+ * @param[in] resourceID The ID of the resource requested for retrieval.
+ * @param[in,out] value A pointer to a const pointer that will be modified to point to the requested value. Set to null on error.
+ * @return AwaError_Success on success.
+ * @return AwaError_TypeMismatch if the resource is not of the correct type.
+ * @return AwaError_PathNotFound if the specified resource is not covered by the Get Response.
+ * @return AwaError_OperationInvalid if the specified operation is invalid or NULL.
+ * @return AwaError_PathInvalid if the IDs do not identify a resource.
+ * @{
+ */
+AwaError AwaClientGetResponse_GetValueAsCStringPointerByID   (const AwaClientGetResponse * response, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, const char ** value);
+AwaError AwaClientGetResponse_GetValueAsIntegerPointerByID   (const AwaClientGetResponse * response, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, const AwaInteger ** value);
+AwaError AwaClientGetResponse_GetValueAsFloatPointerByID     (const AwaClientGetResponse * response, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, const AwaFloat ** value);
+AwaError AwaClientGetResponse_GetValueAsBooleanPointerByID   (const AwaClientGetResponse * response, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, const AwaBoolean ** value);
+AwaError AwaClientGetResponse_GetValueAsTimePointerByID      (const AwaClientGetResponse * response, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, const AwaTime ** value);
+AwaError AwaClientGetResponse_GetValueAsObjectLinkPointerByID(const AwaClientGetResponse * response, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, const AwaObjectLink ** value);
+AwaError AwaClientGetResponse_GetValueAsOpaquePointerByID    (const AwaClientGetResponse * response, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, const AwaOpaque ** value);
+/** @} */
+
 /**
  * @brief Retrieve an opaque resource's value from a Get Response. The resource is identified by the path.
  *        This function can only be successful after a Get operation has been successfully processed.
@@ -637,6 +716,32 @@ AwaError AwaClientSetOperation_AddValueAsOpaque    (AwaClientSetOperation * oper
 AwaError AwaClientSetOperation_AddValueAsObjectLink(AwaClientSetOperation * operation, const char * path, AwaObjectLink value);
 /** @} */
 
+/**
+ * @defgroup SetOperation_AddValueAsByID AwaClientSetOperation_AddValueAs___ByID
+ * @addtogroup SetOperation_AddValueAsByID
+ * @brief Adds a resource and value to a Set Operation, with the resource identified by IDs rather than a path string.
+ *        Behaves as the AwaClientSetOperation_AddValueAs___ functions, without the cost of formatting and parsing a path.
+ * @param[in] operation The Set Operation to add the resource and value to.
+ * @param[in] objectID The object ID of the resource requested for change.
+ * @param[in] objectInstanceID The object instance ID of the resource requested for change.
+ * @param[in] resourceID The ID of the resource requested for change.
+ * @param[in] value The new value of the resource.
+ * @return AwaError_Success on success.
+ * @return AwaError_OperationInvalid if the operation is invalid.
+ * @return AwaError_PathInvalid if the IDs do not identify a resource.
+ * @return AwaError_TypeMismatch if the IDs refer to a resource with a non-corresponding type.
+ * @return AwaError_NotDefined if the IDs refer to an object or resource that is not defined.
+ * @{
+ */
+AwaError AwaClientSetOperation_AddValueAsCStringByID   (AwaClientSetOperation * operation, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, const char * value);
+AwaError AwaClientSetOperation_AddValueAsIntegerByID   (AwaClientSetOperation * operation, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, AwaInteger value);
+AwaError AwaClientSetOperation_AddValueAsFloatByID     (AwaClientSetOperation * operation, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, AwaFloat value);
+AwaError AwaClientSetOperation_AddValueAsBooleanByID   (AwaClientSetOperation * operation, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, AwaBoolean value);
+AwaError AwaClientSetOperation_AddValueAsTimeByID      (AwaClientSetOperation * operation, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, AwaTime value);
+AwaError AwaClientSetOperation_AddValueAsOpaqueByID    (AwaClientSetOperation * operation, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, AwaOpaque value);
+AwaError AwaClientSetOperation_AddValueAsObjectLinkByID(AwaClientSetOperation * operation, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, AwaObjectLink value);
+/** @} */
+
 /**
  * @defgroup SetOperation_AddValueAsArray AwaClientSetOperation_AddValueAs___Array
  * @addtogroup SetOperation_AddValueAsArray
@@ -698,6 +803,23 @@ AwaError AwaClientSetOperation_AddArrayValueAsObjectLink(AwaClientSetOperation *
  */
 AwaError AwaClientSetOperation_Perform(AwaClientSetOperation * operation, AwaTimeout timeout);
 
+/**
+ * @brief Send the Set operation to the Core without waiting for its response. The response is received by
+ *        AwaClientSession_Process, and on AwaClientSession_DispatchCallbacks it is stored in the operation,
+ *        as if by AwaClientSetOperation_Perform, before callback is invoked with the result.
+ *        The operation must not be freed or performed again until its callback has been invoked.
+ * @param[in] operation The Set operation to process.
+ * @param[in] timeout The time in milliseconds to wait for a response before callback is invoked with
+ *                    AwaError_Timeout. Pass 0 to wait indefinitely.
+ * @param[in] callback The callback to invoke when the operation completes. May be NULL.
+ * @param[in] context A pointer to user-specified data passed to callback.
+ * @param[out] requestID If not NULL, set to the ID passed to callback for this request.
+ * @return AwaError_Success if the request was sent.
+ * @return Various errors on failure.
+ */
+AwaError AwaClientSetOperation_PerformAsync(AwaClientSetOperation * operation, AwaTimeout timeout,
+                                           AwaOperationCompleteCallback callback, void * context, AwaRequestID * requestID);
+
 /**
  * @brief Obtain a Set Response instance from a processed Set Operation. This may be
  *        iterated through to determine whether the set operation succeeded for the requested paths.
@@ -69,6 +69,21 @@ typedef enum
  */
 typedef int AwaTimeout;
 
+/**
+ * Identifies an operation performed asynchronously. Valid request IDs are greater than zero.
+ */
+typedef int AwaRequestID;
+
+/**
+ * @brief A user-specified callback handler for an operation performed asynchronously, which will be
+ *        called by the session's DispatchCallbacks function once the operation's response has been
+ *        received, or it has timed out. The operation's response can be retrieved as usual from within the callback.
+ * @param[in] requestID The ID of the request, as returned when the operation was performed.
+ * @param[in] result AwaError_Success if the operation succeeded, or the error it would have returned if performed synchronously.
+ * @param[in] context A pointer to user-specified data passed when the operation was performed.
+ */
+typedef void (*AwaOperationCompleteCallback)(AwaRequestID requestID, AwaError result, void * context);
+
 /**
  * Supported subscribe types
  */
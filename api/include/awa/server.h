@@ -109,6 +109,7 @@ typedef struct _AwaServerReadOperation AwaServerReadOperation;
 typedef struct _AwaServerReadResponse AwaServerReadResponse;
 typedef struct _AwaServerWriteOperation AwaServerWriteOperation;
 typedef struct _AwaWriteResponse AwaServerWriteResponse;
+typedef struct _AwaServerBatchOperation AwaServerBatchOperation;
 typedef struct _AwaServerDeleteResponse AwaServerDeleteResponse;
 typedef struct _AwaServerDeleteOperation AwaServerDeleteOperation;
 typedef struct _AwaServerExecuteOperation AwaServerExecuteOperation;
@@ -162,6 +163,17 @@ typedef void (*AwaServerClientUpdateEventCallback)(const AwaServerClientUpdateEv
  */
 typedef void (*AwaServerClientDeregisterEventCallback)(const AwaServerClientDeregisterEvent * event, void * context);
 
+/**
+ * @brief A user-specified callback handler for Server Notifications which will be fired as each client of
+ *        a fanned-out operation completes, before the operation itself completes.
+ *        Warning: Do NOT process any operations while inside this callback!
+ * @param[in] clientID The endpoint name of the client that completed.
+ * @param[in] latency The time in milliseconds the server took to complete the request to this client.
+ * @param[in] result AwaError_Success if every path succeeded for this client, otherwise the first error.
+ * @param[in] context A pointer to user-specified data passed to ::AwaServerSession_SetFanOutResultCallback.
+ */
+typedef void (*AwaServerFanOutResultCallback)(const char * clientID, AwaInteger latency, AwaError result, void * context);
+
 
 /**************************************************************************************************
  * Server Session Management
@@ -191,6 +203,19 @@ AwaServerSession * AwaServerSession_New(void);
  */
 AwaError AwaServerSession_SetIPCAsUDP(AwaServerSession * session, const char * address, unsigned short port);
 
+/**
+ * @brief Configure the IPC mechanism used by the API to communicate with the Core.
+ *        This function configures the mechanism to use a Unix domain stream socket,
+ *        as provided by a server daemon started with --ipcUnix. Messages on this
+ *        transport are not limited to the size of a single UDP datagram.
+ * @param[in] session Pointer to the session that is to be configured.
+ * @param[in] path Specifies the filesystem path of the Core's IPC socket.
+ * @return AwaError_Success on success.
+ * @return AwaError_IPCError if the path is invalid.
+ * @return AwaError_SessionInvalid if the specified session is invalid.
+ */
+AwaError AwaServerSession_SetIPCAsUnix(AwaServerSession * session, const char * path);
+
 // Not yet implemented:
 //AwaError AwaServerSession_SetIPCAsLocal(AwaServerSession * session);
 //AwaError AwaServerSession_SetIPCAsMQTT(AwaServerSession * session /* ... */);
@@ -283,6 +308,17 @@ AwaError AwaServerSession_Process(AwaServerSession * session, AwaTimeout timeout
  */
 AwaError AwaServerSession_DispatchCallbacks(AwaServerSession * session);
 
+/**
+ * @brief Retrieve the file descriptor on which the session receives notifications and responses to
+ *        asynchronous operations, so that it can be monitored with select() or poll() in an application's
+ *        own event loop. When it becomes readable, call AwaServerSession_Process with a zero timeout,
+ *        followed by AwaServerSession_DispatchCallbacks.
+ * @param[in] session Pointer to a connected session.
+ * @return A non-negative file descriptor on success.
+ * @return -1 if the session is invalid or not connected.
+ */
+int AwaServerSession_GetFileDescriptor(const AwaServerSession * session);
+
 /**
  * @brief When a session is no longer required, or if the application intends to sleep for some time, the session can be
  *        disconnected from the Core. This maintains object and resource definition information, but prevents the
@@ -590,6 +626,20 @@ AwaServerReadOperation * AwaServerReadOperation_New(const AwaServerSession * ses
  */
 AwaError AwaServerReadOperation_AddPath(AwaServerReadOperation * operation, const char * clientID, const char * path);
 
+/**
+ * @brief Adds a path of interest to a Read operation, identified by IDs rather than a path string.
+ *        Behaves as AwaServerReadOperation_AddPath, without the cost of formatting and parsing a path.
+ * @param[in] operation The Read operation to add the path of interest to.
+ * @param[in] clientID The name of the client to query
+ * @param[in] objectID The object requested for retrieval.
+ * @param[in] objectInstanceID The object instance requested for retrieval, or AWA_INVALID_ID for the whole object.
+ * @param[in] resourceID The resource requested for retrieval, or AWA_INVALID_ID for the whole object instance.
+ * @return AwaError_Success on success.
+ * @return AwaError_OperationInvalid if the operation is invalid.
+ * @return AwaError_PathInvalid if the IDs do not form a valid data model path.
+ */
+AwaError AwaServerReadOperation_AddPathByID(AwaServerReadOperation * operation, const char * clientID, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID);
+
 /**
  * @brief Process the Read operation by sending it to the Core.
  *        If successful, the response can be obtained with AwaServerReadOperation_GetResponse
@@ -602,6 +652,23 @@ AwaError AwaServerReadOperation_AddPath(AwaServerReadOperation * operation, cons
  */
 AwaError AwaServerReadOperation_Perform(AwaServerReadOperation * operation, AwaTimeout timeout);
 
+/**
+ * @brief Send the Read operation to the Core without waiting for its response. The response is received by
+ *        AwaServerSession_Process, and on AwaServerSession_DispatchCallbacks it is stored in the operation,
+ *        as if by AwaServerReadOperation_Perform, before callback is invoked with the result.
+ *        The operation must not be freed or performed again until its callback has been invoked.
+ * @param[in] operation The Read operation to process.
+ * @param[in] timeout The time in milliseconds to wait for a response before callback is invoked with
+ *                    AwaError_Timeout. Pass 0 to wait indefinitely.
+ * @param[in] callback The callback to invoke when the operation completes. May be NULL.
+ * @param[in] context A pointer to user-specified data passed to callback.
+ * @param[out] requestID If not NULL, set to the ID passed to callback for this request.
+ * @return AwaError_Success if the request was sent.
+ * @return Various errors on failure.
+ */
+AwaError AwaServerReadOperation_PerformAsync(AwaServerReadOperation * operation, AwaTimeout timeout,
+                                            AwaOperationCompleteCallback callback, void * context, AwaRequestID * requestID);
+
 /**
  * @brief Clean up a Read operation, freeing all allocated resources.
  *        Once freed, the operation is no longer valid.
@@ -637,6 +704,32 @@ AwaClientIterator * AwaServerReadOperation_NewClientIterator(const AwaServerRead
  */
 const AwaServerReadResponse * AwaServerReadOperation_GetResponse(const AwaServerReadOperation * operation, const char * clientID);
 
+/**
+ * @brief Read from the operation's clients in parallel, with at most window requests outstanding at once.
+ *        Each client's result is delivered to the session's ::AwaServerFanOutResultCallback as it arrives,
+ *        on AwaServerSession_DispatchCallbacks, and the complete response is available once
+ *        AwaServerReadOperation_Perform returns. Operations on more than one client are always read in
+ *        parallel with a default window, but results are only streamed when a window is set.
+ * @param[in] operation The Read operation to configure.
+ * @param[in] window The maximum number of clients to read from concurrently. Pass 0 to stop streaming results.
+ * @return AwaError_Success on success.
+ * @return AwaError_OperationInvalid if the operation is not valid.
+ */
+AwaError AwaServerReadOperation_SetFanOutWindow(AwaServerReadOperation * operation, size_t window);
+
+/**
+ * @brief Obtain the time the server took to read from a client, for a processed Read operation
+ *        that targeted more than one client.
+ * @param[in] operation The processed Read operation.
+ * @param[in] clientID The endpoint name of the client.
+ * @param[out] latency The time in milliseconds between the server sending the request and completing the response.
+ * @return AwaError_Success on success.
+ * @return AwaError_OperationInvalid if the operation is not valid.
+ * @return AwaError_ResponseInvalid if the operation has not been processed, or clientID or latency is NULL.
+ * @return AwaError_ClientNotFound if no latency was reported for the client.
+ */
+AwaError AwaServerReadOperation_GetClientLatency(const AwaServerReadOperation * operation, const char * clientID, AwaInteger * latency);
+
 /**
  * @brief Create a new Path Iterator for a Read Response, used to iterate through the list of resource paths
  *        retrieved by the corresponding Read operation.
@@ -683,6 +776,18 @@ bool AwaServerReadResponse_ContainsPath(const AwaServerReadResponse * response,
  */
 bool AwaServerReadResponse_HasValue(const AwaServerReadResponse * response, const char * path);
 
+/**
+ * @brief Test if the Read Response has a value for the resource identified by IDs.
+ *        Behaves as AwaServerReadResponse_HasValue, without the cost of parsing a path.
+ * @param[in] response A pointer to a valid Read Response.
+ * @param[in] objectID The object ID of the resource.
+ * @param[in] objectInstanceID The object instance ID of the resource.
+ * @param[in] resourceID The resource ID.
+ * @return True if the Read Response contains a value for the specified resource.
+ * @return False if the Read Response does not contain a value for the specified resource, or if the IDs are invalid.
+ */
+bool AwaServerReadResponse_HasValueByID(const AwaServerReadResponse * response, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID);
+
 /**
  * @defgroup ReadResponse_GetValueAs AwaServerReadResponse_GetValueAs___Pointer
  * @addtogroup ReadResponse_GetValueAs
@@ -709,6 +814,32 @@ AwaError AwaServerReadResponse_GetValueAsObjectLinkPointer (const AwaServerReadR
 AwaError AwaServerReadResponse_GetValueAsOpaquePointer     (const AwaServerReadResponse * response, const char * path, const AwaOpaque ** value);
 /** @} */
 
+/**
+ * @defgroup ReadResponse_GetValueAsByID AwaServerReadResponse_GetValueAs___PointerByID
+ * @addtogroup ReadResponse_GetValueAsByID
+ * @brief Retrieve a temporary pointer to a resource's value from a Read Response. The resource is identified by IDs.
+ *        Behaves as the AwaServerReadResponse_GetValueAs___Pointer functions, without the cost of parsing a path.
+ * @param[in] response The current Read Response to retrieve the value from.
+ * @param[in] objectID The object ID of the resource requested for retrieval.
+ * @param[in] objectInstanceID The object instance ID of the resource requested for retrieval.
+ * @param[in] resourceID The ID of the resource requested for retrieval.
+ * @param[in,out] value A pointer to a const pointer that will be modified to point to the requested value. Set to null on error.
+ * @return AwaError_Success on success.
+ * @return AwaError_TypeMismatch if the resource is not of the correct type.
+ * @return AwaError_PathNotFound if the specified resource is not covered by the Read Response.
+ * @return AwaError_OperationInvalid if the specified operation is invalid or NULL.
+ * @return AwaError_PathInvalid if the IDs do not identify a resource.
+ * @{
+ */
+AwaError AwaServerReadResponse_GetValueAsCStringPointerByID  (const AwaServerReadResponse * response, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, const char ** value);
+AwaError AwaServerReadResponse_GetValueAsIntegerPointerByID  (const AwaServerReadResponse * response, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, const AwaInteger ** value);
+AwaError AwaServerReadResponse_GetValueAsFloatPointerByID    (const AwaServerReadResponse * response, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, const AwaFloat ** value);
+AwaError AwaServerReadResponse_GetValueAsBooleanPointerByID  (const AwaServerReadResponse * response, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, const AwaBoolean ** value);
+AwaError AwaServerReadResponse_GetValueAsTimePointerByID     (const AwaServerReadResponse * response, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, const AwaTime ** value);
+AwaError AwaServerReadResponse_GetValueAsObjectLinkPointerByID(const AwaServerReadResponse * response, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, const AwaObjectLink ** value);
+AwaError AwaServerReadResponse_GetValueAsOpaquePointerByID   (const AwaServerReadResponse * response, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, const AwaOpaque ** value);
+/** @} */
+
 /**
  * @brief Retrieve an opaque resource's value from a Read Response. The resource is identified by the path.
  *        This function can only be successful after a Read operation has been successfully processed.
@@ -870,6 +1001,32 @@ AwaError AwaServerWriteOperation_AddValueAsOpaque    (AwaServerWriteOperation *
 AwaError AwaServerWriteOperation_AddValueAsObjectLink(AwaServerWriteOperation * operation, const char * path, AwaObjectLink value);
 /** @} */
 
+/**
+ * @defgroup WriteOperation_AddValueAsByID AwaServerWriteOperation_AddValueAs___ByID
+ * @addtogroup WriteOperation_AddValueAsByID
+ * @brief Adds a resource and value to a Write Operation, with the resource identified by IDs rather than a path string.
+ *        Behaves as the AwaServerWriteOperation_AddValueAs___ functions, without the cost of formatting and parsing a path.
+ * @param[in] operation The Write Operation to add the resource and value to.
+ * @param[in] objectID The object ID of the resource requested for change.
+ * @param[in] objectInstanceID The object instance ID of the resource requested for change.
+ * @param[in] resourceID The ID of the resource requested for change.
+ * @param[in] value The new value of the resource.
+ * @return AwaError_Success on success.
+ * @return AwaError_OperationInvalid if the operation is invalid.
+ * @return AwaError_PathInvalid if the IDs do not identify a resource.
+ * @return AwaError_TypeMismatch if the IDs refer to a resource with a non-corresponding type.
+ * @return AwaError_NotDefined if the IDs refer to an object or resource that is not defined.
+ * @{
+ */
+AwaError AwaServerWriteOperation_AddValueAsCStringByID   (AwaServerWriteOperation * operation, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, const char * value);
+AwaError AwaServerWriteOperation_AddValueAsIntegerByID   (AwaServerWriteOperation * operation, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, AwaInteger value);
+AwaError AwaServerWriteOperation_AddValueAsFloatByID     (AwaServerWriteOperation * operation, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, AwaFloat value);
+AwaError AwaServerWriteOperation_AddValueAsBooleanByID   (AwaServerWriteOperation * operation, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, AwaBoolean value);
+AwaError AwaServerWriteOperation_AddValueAsTimeByID      (AwaServerWriteOperation * operation, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, AwaTime value);
+AwaError AwaServerWriteOperation_AddValueAsOpaqueByID    (AwaServerWriteOperation * operation, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, AwaOpaque value);
+AwaError AwaServerWriteOperation_AddValueAsObjectLinkByID(AwaServerWriteOperation * operation, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, AwaObjectLink value);
+/** @} */
+
 /**
  * @defgroup WriteOperation_AddValueAsArray AwaServerWriteOperation_AddValueAs___Array
  * @addtogroup WriteOperation_AddValueAsArray
@@ -934,6 +1091,23 @@ AwaError AwaServerWriteOperation_AddArrayValueAsObjectLink(AwaServerWriteOperati
  */
 AwaError AwaServerWriteOperation_Perform(AwaServerWriteOperation * operation, const char * clientID, AwaTimeout timeout);
 
+/**
+ * @brief Send the Write operation to the Core without waiting for its response. The response is received by
+ *        AwaServerSession_Process, and on AwaServerSession_DispatchCallbacks it is stored in the operation,
+ *        as if by AwaServerWriteOperation_Perform, before callback is invoked with the result.
+ *        The operation must not be freed or performed again until its callback has been invoked.
+ * @param[in] operation The Write operation to process.
+ * @param[in] timeout The time in milliseconds to wait for a response before callback is invoked with
+ *                    AwaError_Timeout. Pass 0 to wait indefinitely.
+ * @param[in] callback The callback to invoke when the operation completes. May be NULL.
+ * @param[in] context A pointer to user-specified data passed to callback.
+ * @param[out] requestID If not NULL, set to the ID passed to callback for this request.
+ * @return AwaError_Success if the request was sent.
+ * @return Various errors on failure.
+ */
+AwaError AwaServerWriteOperation_PerformAsync(AwaServerWriteOperation * operation, const char * clientID, AwaTimeout timeout,
+                                             AwaOperationCompleteCallback callback, void * context, AwaRequestID * requestID);
+
 /**
  * @brief Obtain a Write Response instance from a processed Write Operation. This may be
  *        iterated through to determine whether the write operation succeeded for the requested paths.
@@ -999,6 +1173,65 @@ const AwaPathResult * AwaServerWriteResponse_GetPathResult(const AwaServerWriteR
 bool AwaServerWriteResponse_ContainsPath(const AwaServerWriteResponse * response, const char * path);
 
 
+/**************************************************************************************************
+ * Batch Operation
+ *************************************************************************************************/
+
+/**
+ * @brief Allocate and return a pointer to a new Batch operation, that can be used to send several
+ *        Read and Write operations to the Core in a single IPC exchange. The operations added to the
+ *        batch remain owned by the caller, and their responses are retrieved from them as usual
+ *        once the batch has been processed.
+ *        The Batch operation is owned by the caller and should eventually be freed with AwaServerBatchOperation_Free.
+ * @param[in] session A pointer to a valid session instance.
+ * @return A pointer to a newly allocated Batch operation instance, or NULL on failure.
+ */
+AwaServerBatchOperation * AwaServerBatchOperation_New(const AwaServerSession * session);
+
+/**
+ * @brief Add a Read operation to a Batch operation. The Read operation must remain valid until
+ *        the batch has been processed or freed.
+ * @param[in] batch A pointer to a valid Batch operation.
+ * @param[in] operation A pointer to a valid Read operation, created with the same session as the batch.
+ * @return AwaError_Success on success.
+ * @return AwaError_OperationInvalid if the batch or operation is invalid.
+ */
+AwaError AwaServerBatchOperation_AddReadOperation(AwaServerBatchOperation * batch, AwaServerReadOperation * operation);
+
+/**
+ * @brief Add a Write operation to a Batch operation, to be performed on the specified client. The Write
+ *        operation must remain valid until the batch has been processed or freed.
+ * @param[in] batch A pointer to a valid Batch operation.
+ * @param[in] operation A pointer to a valid Write operation, created with the same session as the batch.
+ * @param[in] clientID The endpoint name of the client to write to.
+ * @return AwaError_Success on success.
+ * @return AwaError_OperationInvalid if the batch, operation or client ID is invalid.
+ */
+AwaError AwaServerBatchOperation_AddWriteOperation(AwaServerBatchOperation * batch, AwaServerWriteOperation * operation, const char * clientID);
+
+/**
+ * @brief Process the Batch operation by sending all of its operations to the Core in a single request.
+ *        The Core performs the operations in the order they were added, and each operation's
+ *        response is updated as if it had been performed individually.
+ * @param[in] batch The Batch operation to process.
+ * @param[in] timeout The function will wait at least as long as this value for a response.
+ * @return AwaError_Success if every operation in the batch succeeded.
+ * @return AwaError_OperationInvalid if the batch is invalid or empty.
+ * @return AwaError_Timeout if no response is received after the timeout duration expires.
+ * @return The first error reported by an operation in the batch otherwise.
+ */
+AwaError AwaServerBatchOperation_Perform(AwaServerBatchOperation * batch, AwaTimeout timeout);
+
+/**
+ * @brief Clean up a Batch operation, freeing all allocated resources. Operations added to the
+ *        batch are not freed. Once freed, the batch is no longer valid.
+ * @param[in,out] batch A pointer to a Batch operation pointer that will be set to NULL.
+ * @return AwaError_Success on success.
+ * @return AwaError_OperationInvalid if the batch is not valid.
+ */
+AwaError AwaServerBatchOperation_Free(AwaServerBatchOperation ** batch);
+
+
 /**************************************************************************************************
  * Object Instance & Resource Deletion Operation
  *************************************************************************************************/
@@ -1737,6 +1970,21 @@ AwaError AwaServerSession_SetClientUpdateEventCallback(AwaServerSession * sessio
  */
 AwaError AwaServerSession_SetClientDeregisterEventCallback(AwaServerSession * session, AwaServerClientDeregisterEventCallback callback, void * context);
 
+/**
+ * @brief Sets a callback function to be called as each client of a fanned-out operation completes.
+ *        Any existing callback function is replaced.
+ *
+ *        The callback of type ::AwaServerFanOutResultCallback will be passed the client's endpoint name,
+ *        latency and result, and the context pointer specified here.
+ *
+ * @param[in] session A pointer to a valid session.
+ * @param[in] callback Function pointer to call when a client's result arrives. Pass NULL to clear.
+ * @param[in] context A pointer to a user specified object for use in the callback.
+ * @return AwaError_Success on success.
+ * @return AwaError_SessionInvalid if the specified session is invalid.
+ */
+AwaError AwaServerSession_SetFanOutResultCallback(AwaServerSession * session, AwaServerFanOutResultCallback callback, void * context);
+
 /**
  * @brief Create a new Client Iterator from a Client Register Event, used to iterate through
  *        the list of client endpoint names (IDs) held by the event.
@@ -23,30 +23,33 @@
 # Preliminary API to support testing
 
 import ipc
+import ipc_core
 import ipc_lwm2m_client as client
 import ipc_lwm2m_server as server
 
 class ServerAPI(object):
 
-    def __init__(self, ipcAddress, ipcPort):
+    def __init__(self, ipcAddress, ipcPort, encoding=ipc_core.ENCODING_BINARY):
         self._ipc = "udp://" + ipcAddress + ":" + str(ipcPort)
 
-        # Connect
-        request = server.ConnectRequest(session_id=None)
+        # Connect, offering the requested encoding. The daemon confirms it if supported.
+        request = server.ConnectRequest(session_id=None, encoding=encoding)
         response = ipc.send_request_and_receive_response(self._ipc, request.serialize())
-        self._session_id = server.ConnectResponse(response).session_id
+        connectResponse = server.ConnectResponse(response)
+        self._session_id = connectResponse.session_id
+        self._encoding = connectResponse.encoding
         print("Session ID %s" % (self._session_id,))
 
     def __del__(self):
         # Disconnect
         if self._session_id is not None:
-            request = server.DisconnectRequest(session_id=self._session_id)
+            request = server.DisconnectRequest(session_id=self._session_id, encoding=self._encoding)
             response = ipc.send_request_and_receive_response(self._ipc, request.serialize())
             #print "data " + ipc.receive_datagram(self._ipc)
             #import pdb; pdb.set_trace()
 
     def GetClientList(self, clientID):
-        request = server.ListClientsRequest(session_id=self._session_id)
+        request = server.ListClientsRequest(session_id=self._session_id, encoding=self._encoding)
         response = ipc.send_request_and_receive_response(self._ipc, request.serialize())
         return server.ListClientsResponse(response).getClientIDs()
 
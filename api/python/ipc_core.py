@@ -24,6 +24,7 @@
 IPC Core Functionality
 """
 
+import struct
 from lxml import etree
 
 g_debug = True
@@ -31,13 +32,104 @@ def debug(msg):
     if g_debug:
         print(msg)
 
-def _serialize(header, msgType, sessionID, content):
+# Message encodings, negotiated by the Connect request
+ENCODING_XML = "XML"
+ENCODING_BINARY = "Binary"
+
+# Binary encoding: a header, then the root element. Each element is encoded as its name, its text and the number of
+# child elements, followed by the children. Lengths and counts are LEB128 varints, and the text length is offset by
+# one so that zero represents an element without text. Matches Xml_TreeToBinary in core/src/common/xml.c.
+BINARY_HEADER = b"\x00AW\x01"
+
+def _encode_varint(value):
+    out = bytearray()
+    while True:
+        byte = value & 0x7f
+        value >>= 7
+        if value:
+            out.append(byte | 0x80)
+        else:
+            out.append(byte)
+            return out
+
+def _encode_element(element, out):
+    name = element.tag.encode("utf-8")
+    out += _encode_varint(len(name))
+    out += name
+    if element.text is None or len(element):
+        # whitespace between child elements is not text
+        out += _encode_varint(0)
+    else:
+        text = element.text.encode("utf-8")
+        out += _encode_varint(len(text) + 1)
+        out += text
+    out += _encode_varint(len(element))
+    for child in element:
+        _encode_element(child, out)
+
+def encode_binary(element):
+    """Encode an etree.Element in the binary IPC encoding."""
+    out = bytearray(BINARY_HEADER)
+    _encode_element(element, out)
+    return bytes(out)
+
+def _decode_varint(data, pos):
+    value = 0
+    shift = 0
+    while True:
+        if pos >= len(data):
+            raise IpcError("Truncated binary message")
+        byte = data[pos]
+        pos += 1
+        value |= (byte & 0x7f) << shift
+        if not byte & 0x80:
+            return value, pos
+        shift += 7
+
+def _decode_element(data, pos):
+    length, pos = _decode_varint(data, pos)
+    element = etree.Element(bytes(data[pos:pos + length]).decode("utf-8"))
+    pos += length
+    length, pos = _decode_varint(data, pos)
+    if length:
+        element.text = bytes(data[pos:pos + length - 1]).decode("utf-8")
+        pos += length - 1
+    count, pos = _decode_varint(data, pos)
+    for _ in range(count):
+        child, pos = _decode_element(data, pos)
+        element.append(child)
+    if pos > len(data):
+        raise IpcError("Truncated binary message")
+    return element, pos
+
+def is_binary(data):
+    return bytes(data[:len(BINARY_HEADER)]) == BINARY_HEADER
+
+def decode_binary(data):
+    """Decode a message in the binary IPC encoding to an etree.Element."""
+    data = bytearray(data)
+    if not is_binary(data):
+        raise IpcError("Not a binary message")
+    element, pos = _decode_element(data, len(BINARY_HEADER))
+    if pos != len(data):
+        raise IpcError("Trailing data in binary message")
+    return element
+
+def deserialize(data):
+    """Decode a message in either encoding to an etree.Element."""
+    return decode_binary(data) if is_binary(data) else etree.fromstring(data)
+
+def _serialize(header, msgType, sessionID, content, encoding=ENCODING_XML, extra=None):
     e_root = etree.Element(header)
     e_root.append(TElement("Type", str(msgType)))
     if sessionID is not None:
         e_root.append(TElement("SessionID", str(sessionID)))
+    for tag, text in (extra or ()):
+        e_root.append(TElement(tag, text))
     if content is not None:
         e_root.append(content)
+    if encoding == ENCODING_BINARY:
+        return encode_binary(e_root)
     return etree.tostring(e_root, pretty_print=True)
 
 def is_sequence(arg):
@@ -94,8 +186,9 @@ class IpcRequest(IpcMessage):
     ContentType = IpcContent
     PathLabel = None
 
-    def __init__(self, session_id=None):
+    def __init__(self, session_id=None, encoding=ENCODING_XML):
         self._session_id = session_id
+        self._encoding = encoding
         self._content = type(self).ContentType()
 
     def __str__(self):
@@ -108,7 +201,7 @@ class IpcRequest(IpcMessage):
 
     def serialize(self):
         # use specified MessageType
-        return _serialize(self.Header, self.MessageType, self._session_id, self._content.getElement())
+        return _serialize(self.Header, self.MessageType, self._session_id, self._content.getElement(), self._encoding)
 
     @property
     def session_id(self):
@@ -134,7 +227,7 @@ class IpcResponse(IpcMessage):
 
     def parseXml(self, xml):
         #debug("RECEIVED XML: %s\n" % (xml, ))
-        e_response = etree.fromstring(xml)
+        e_response = deserialize(xml)
         if e_response.tag != "Response":
             raise IpcError("Invalid response")
         try:
@@ -151,6 +244,8 @@ class IpcResponse(IpcMessage):
             self._session_id = e_response.find("SessionID").text
         except AttributeError:
             debug("No session ID in response")
+        e_encoding = e_response.find("Encoding")
+        self._encoding = e_encoding.text if e_encoding is not None else ENCODING_XML
         self._content = type(self).ContentType(e_response)
         return e_response
 
@@ -170,6 +265,11 @@ class IpcResponse(IpcMessage):
     def session_id(self):
         return self._session_id
 
+    @property
+    def encoding(self):
+        """The encoding confirmed by a Connect response, to be used for subsequent requests."""
+        return getattr(self, "_encoding", ENCODING_XML)
+
     def getValue(self, path):
         """Path is a tuple: (objectID, objectInstanceID, resourceID, resourceInstanceID)"""
         return self._content.getValue(path)
@@ -151,6 +151,11 @@ class ConnectRequest(IpcRequest):
     MessageType = "Connect"
     ContentType = ContentNull
 
+    def serialize(self):
+        # always sent as XML, offering the requested encoding for subsequent messages
+        extra = (("Encoding", self._encoding),) if self._encoding != ipc_core.ENCODING_XML else None
+        return ipc_core._serialize(self.Header, self.MessageType, self._session_id, self._content.getElement(), ipc_core.ENCODING_XML, extra)
+
 class ConnectResponse(IpcResponse):
     MessageType = "Connect"
     ContentType = ContentNull
@@ -0,0 +1,332 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE 
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "awa/server.h"
+#include "server_session.h"
+#include "session_common.h"
+#include "memalloc.h"
+#include "log.h"
+#include "list.h"
+#include "xml.h"
+#include "ipc.h"
+#include "lwm2m_xml_interface.h"
+#include "read_operation.h"
+#include "write_operation.h"
+
+typedef enum
+{
+    BatchEntryType_Read,
+    BatchEntryType_Write,
+} BatchEntryType;
+
+typedef struct
+{
+    BatchEntryType Type;
+    void * Operation;
+    char * ClientID;      // Write only
+} BatchEntry;
+
+// A batch holds borrowed pointers to Read and Write operations, and sends their requests to the
+// daemon inside a single Batch request. Each operation's response is then updated from the
+// matching entry in the batch response, in the order the operations were added.
+struct _AwaServerBatchOperation
+{
+    const AwaServerSession * Session;
+    ListType * Entries;
+};
+
+AwaServerBatchOperation * AwaServerBatchOperation_New(const AwaServerSession * session)
+{
+    AwaServerBatchOperation * batch = NULL;
+
+    if (session != NULL)
+    {
+        if (ServerSession_IsConnected(session) != false)
+        {
+            batch = Awa_MemAlloc(sizeof(*batch));
+            if (batch != NULL)
+            {
+                memset(batch, 0, sizeof(*batch));
+                batch->Session = session;
+                batch->Entries = List_New();
+                if (batch->Entries != NULL)
+                {
+                    LogNew("AwaServerBatchOperation", batch);
+                }
+                else
+                {
+                    LogErrorWithEnum(AwaError_OutOfMemory, "Unable to initialise batch");
+                    Awa_MemSafeFree(batch);
+                    batch = NULL;
+                }
+            }
+            else
+            {
+                LogErrorWithEnum(AwaError_OutOfMemory);
+            }
+        }
+        else
+        {
+            LogErrorWithEnum(AwaError_SessionNotConnected);
+        }
+    }
+    else
+    {
+        LogErrorWithEnum(AwaError_SessionInvalid, "Session is NULL");
+    }
+    return batch;
+}
+
+static AwaError ServerBatchOperation_AddEntry(AwaServerBatchOperation * batch, BatchEntryType type, void * operation, const char * clientID)
+{
+    AwaError result = AwaError_Unspecified;
+
+    BatchEntry * entry = Awa_MemAlloc(sizeof(*entry));
+    if (entry != NULL)
+    {
+        memset(entry, 0, sizeof(*entry));
+        entry->Type = type;
+        entry->Operation = operation;
+        if (clientID != NULL)
+        {
+            entry->ClientID = strdup(clientID);
+        }
+
+        if (((clientID == NULL) || (entry->ClientID != NULL)) && List_Add(batch->Entries, entry))
+        {
+            result = AwaError_Success;
+        }
+        else
+        {
+            Awa_MemSafeFree(entry->ClientID);
+            Awa_MemSafeFree(entry);
+            result = LogErrorWithEnum(AwaError_OutOfMemory);
+        }
+    }
+    else
+    {
+        result = LogErrorWithEnum(AwaError_OutOfMemory);
+    }
+    return result;
+}
+
+AwaError AwaServerBatchOperation_AddReadOperation(AwaServerBatchOperation * batch, AwaServerReadOperation * operation)
+{
+    AwaError result = AwaError_Unspecified;
+
+    if ((batch != NULL) && (operation != NULL))
+    {
+        result = ServerBatchOperation_AddEntry(batch, BatchEntryType_Read, operation, NULL);
+    }
+    else
+    {
+        result = LogErrorWithEnum(AwaError_OperationInvalid, "Batch or operation is NULL");
+    }
+    return result;
+}
+
+AwaError AwaServerBatchOperation_AddWriteOperation(AwaServerBatchOperation * batch, AwaServerWriteOperation * operation, const char * clientID)
+{
+    AwaError result = AwaError_Unspecified;
+
+    if ((batch != NULL) && (operation != NULL))
+    {
+        if (clientID != NULL)
+        {
+            result = ServerBatchOperation_AddEntry(batch, BatchEntryType_Write, operation, clientID);
+        }
+        else
+        {
+            result = LogErrorWithEnum(AwaError_OperationInvalid, "ClientID is NULL");
+        }
+    }
+    else
+    {
+        result = LogErrorWithEnum(AwaError_OperationInvalid, "Batch or operation is NULL");
+    }
+    return result;
+}
+
+static AwaError ServerBatchOperation_NewRequest(const BatchEntry * entry, IPCMessage ** request)
+{
+    AwaError result = AwaError_Unspecified;
+    switch (entry->Type)
+    {
+        case BatchEntryType_Read:
+            result = ServerReadOperation_NewRequest(entry->Operation, request);
+            break;
+        case BatchEntryType_Write:
+            result = ServerWriteOperation_NewRequest(entry->Operation, entry->ClientID, request);
+            break;
+        default:
+            result = LogErrorWithEnum(AwaError_Internal, "Unknown batch entry type %d", entry->Type);
+            break;
+    }
+    return result;
+}
+
+static AwaError ServerBatchOperation_ProcessResponse(const BatchEntry * entry, IPCMessage * response)
+{
+    AwaError result = AwaError_Unspecified;
+    switch (entry->Type)
+    {
+        case BatchEntryType_Read:
+            result = ServerReadOperation_ProcessResponse(entry->Operation, response);
+            break;
+        case BatchEntryType_Write:
+            result = ServerWriteOperation_ProcessResponse(entry->Operation, response);
+            break;
+        default:
+            result = LogErrorWithEnum(AwaError_Internal, "Unknown batch entry type %d", entry->Type);
+            break;
+    }
+    return result;
+}
+
+AwaError AwaServerBatchOperation_Perform(AwaServerBatchOperation * batch, AwaTimeout timeout)
+{
+    AwaError result = AwaError_Unspecified;
+
+    if (timeout >= 0)
+    {
+        if (batch != NULL)
+        {
+            if (ServerSession_IsConnected(batch->Session))
+            {
+                size_t numEntries = List_Length(batch->Entries);
+                if (numEntries > 0)
+                {
+                    IPCSessionID sessionID = SessionCommon_GetSessionID(ServerSession_GetSessionCommon(batch->Session));
+                    IPCMessage * request = IPCMessage_NewPlus(IPC_MESSAGE_TYPE_REQUEST, IPC_MESSAGE_SUB_TYPE_BATCH, sessionID);
+                    TreeNode requestsNode = Xml_CreateNode("Requests");
+                    IPCMessage_AddContent(request, requestsNode);
+                    Tree_Delete(requestsNode);
+
+                    result = AwaError_Success;
+                    size_t index;
+                    for (index = 0; (index < numEntries) && (result == AwaError_Success); ++index)
+                    {
+                        BatchEntry * entry = NULL;
+                        List_Get(batch->Entries, index, (void **)&entry);
+
+                        IPCMessage * subRequest = NULL;
+                        result = ServerBatchOperation_NewRequest(entry, &subRequest);
+                        if (result == AwaError_Success)
+                        {
+                            result = IPCMessage_AddBatchedMessage(request, subRequest);
+                        }
+                        IPCMessage_Free(&subRequest);
+                    }
+
+                    if (result == AwaError_Success)
+                    {
+                        // Send via IPC
+                        IPCMessage * response = NULL;
+                        result = IPC_SendAndReceive(ServerSession_GetChannel(batch->Session), request, &response, timeout);
+
+                        // Process each operation's response, reporting the first failure
+                        if (result == AwaError_Success)
+                        {
+                            IPCResponseCode responseCode = IPCMessage_GetResponseCode(response);
+                            if (responseCode == IPCResponseCode_Success)
+                            {
+                                for (index = 0; index < numEntries; ++index)
+                                {
+                                    BatchEntry * entry = NULL;
+                                    List_Get(batch->Entries, index, (void **)&entry);
+
+                                    AwaError entryResult = AwaError_IPCError;
+                                    IPCMessage * subResponse = IPCMessage_NewBatchedMessage(response, index);
+                                    if (subResponse != NULL)
+                                    {
+                                        entryResult = ServerBatchOperation_ProcessResponse(entry, subResponse);
+                                        IPCMessage_Free(&subResponse);
+                                    }
+
+                                    if ((result == AwaError_Success) && (entryResult != AwaError_Success))
+                                    {
+                                        result = entryResult;
+                                    }
+                                }
+                                LogDebug("Perform Batch Operation complete");
+                            }
+                            else if (responseCode == IPCResponseCode_FailureBadRequest)
+                            {
+                                result = LogErrorWithEnum(AwaError_IPCError, "Unable to perform Batch operation: Bad Request");
+                            }
+                            else
+                            {
+                                result = LogErrorWithEnum(AwaError_IPCError, "Unexpected IPC response code: %d", responseCode);
+                            }
+                        }
+                        IPCMessage_Free(&response);
+                    }
+                    IPCMessage_Free(&request);
+                }
+                else
+                {
+                    result = LogErrorWithEnum(AwaError_OperationInvalid, "No operations specified");
+                }
+            }
+            else
+            {
+                result = LogErrorWithEnum(AwaError_SessionNotConnected, "session is not connected");
+            }
+        }
+        else
+        {
+            result = LogErrorWithEnum(AwaError_OperationInvalid, "Batch is NULL");
+        }
+    }
+    else
+    {
+        result = LogErrorWithEnum(AwaError_OperationInvalid, "Invalid timeout specified");
+    }
+    return result;
+}
+
+static void ServerBatchOperation_FreeEntry(size_t index, void * value, void * context)
+{
+    BatchEntry * entry = (BatchEntry *)value;
+    Awa_MemSafeFree(entry->ClientID);
+    Awa_MemSafeFree(entry);
+}
+
+AwaError AwaServerBatchOperation_Free(AwaServerBatchOperation ** batch)
+{
+    AwaError result = AwaError_OperationInvalid;
+    if ((batch != NULL) && (*batch != NULL))
+    {
+        List_ForEach((*batch)->Entries, ServerBatchOperation_FreeEntry, NULL);
+        List_Free(&(*batch)->Entries);
+        LogFree("AwaServerBatchOperation", *batch);
+        Awa_MemSafeFree(*batch);
+        *batch = NULL;
+        result = AwaError_Success;
+    }
+    return result;
+}
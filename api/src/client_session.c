@@ -348,9 +348,14 @@ AwaError AwaClientSession_DispatchCallbacks(AwaClientSession * session)
 
         while (Queue_Pop(session->NotificationQueue, (void **)&notification))
         {
-            ClientNotification_Process(session, notification);
+            // responses to asynchronous requests share the notification queue
+            if (!SessionCommon_DispatchAsyncResponse(session->SessionCommon, notification))
+            {
+                ClientNotification_Process(session, notification);
+            }
             IPCMessage_Free(&notification);
         }
+        SessionCommon_ExpireAsyncRequests(session->SessionCommon);
         result = AwaError_Success;
     }
     else
@@ -360,6 +365,20 @@ AwaError AwaClientSession_DispatchCallbacks(AwaClientSession * session)
     return result;
 }
 
+int AwaClientSession_GetFileDescriptor(const AwaClientSession * session)
+{
+    int fd = -1;
+    if (session != NULL)
+    {
+        fd = SessionCommon_GetFileDescriptor(session->SessionCommon);
+    }
+    else
+    {
+        LogErrorWithEnum(AwaError_SessionInvalid, "session is NULL");
+    }
+    return fd;
+}
+
 // For testing purposes only:
 IPCSessionID AwaClientSession_GetSessionID(const AwaClientSession * session)
 {
@@ -122,6 +122,29 @@ AwaError AwaClientGetOperation_AddPath(AwaClientGetOperation * operation, const
     return result;
 }
 
+AwaError AwaClientGetOperation_AddPathByID(AwaClientGetOperation * operation, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID)
+{
+    AwaError result = AwaError_Unspecified;
+
+    if (operation != NULL)
+    {
+        PathKey key;
+        if (PathKey_Make(&key, objectID, objectInstanceID, resourceID))
+        {
+            result = OperationCommon_AddPathByKey(operation->Common, &key, NULL);
+        }
+        else
+        {
+            result = LogErrorWithEnum(AwaError_PathInvalid, "IDs %d/%d/%d do not form a valid path", objectID, objectInstanceID, resourceID);
+        }
+    }
+    else
+    {
+        result = LogErrorWithEnum(AwaError_OperationInvalid, "Operation is NULL");
+    }
+    return result;
+}
+
 AwaError AwaClientGetOperation_AddPathWithArrayRange(AwaClientGetOperation * operation, const char * path, AwaArrayIndex startIndex, AwaArrayLength indexCount)
 {
     AwaError result = AwaError_Unspecified;
@@ -137,76 +160,120 @@ AwaError AwaClientGetOperation_AddPathWithArrayRange(AwaClientGetOperation * ope
     return result;
 }
 
-AwaError AwaClientGetOperation_Perform(AwaClientGetOperation * operation, AwaTimeout timeout)
+static AwaError ClientGetOperation_NewRequest(const AwaClientGetOperation * operation, IPCMessage ** request)
 {
     AwaError result = AwaError_Unspecified;
 
-    if (timeout >= 0)
+    if (operation != NULL)
     {
-        if (operation != NULL)
+        const AwaClientSession * session = ClientGetOperation_GetSession(operation);
+        if (session != NULL)
         {
-            const AwaClientSession * session = ClientGetOperation_GetSession(operation);
-            if (session != NULL)
+            if (ClientSession_IsConnected(session))
             {
-                if (ClientSession_IsConnected(session))
+                TreeNode objectsTree = OperationCommon_GetObjectsTree(operation->Common);
+                if (objectsTree != NULL)
                 {
-                    TreeNode objectsTree = OperationCommon_GetObjectsTree(operation->Common);
-                    if (objectsTree != NULL)
+                    if (TreeNode_GetChildCount(objectsTree) > 0)
                     {
-                        if (TreeNode_GetChildCount(objectsTree) > 0)
-                        {
-                            // build an IPC message and inject our content (object paths) into it
-                            IPCMessage * getRequest = IPCMessage_NewPlus(IPC_MESSAGE_TYPE_REQUEST, IPC_MESSAGE_SUB_TYPE_GET, OperationCommon_GetSessionID(operation->Common));
-                            IPCMessage_AddContent(getRequest, objectsTree);
-
-                            IPCMessage * getResponse = NULL;
-                            result = IPC_SendAndReceive(ClientSession_GetChannel(session), getRequest, &getResponse, timeout);
-
-                            // Process the response
-                            if (result == AwaError_Success)
-                            {
-                                // Free an old response if it exists
-                                if (operation->Response != NULL)
-                                {
-                                    ResponseCommon_Free(&operation->Response);
-                                }
-
-                                // Detach the response content and store it in the operation's ClientGetResponse
-                                TreeNode contentNode = IPCMessage_GetContentNode(getResponse);
-
-                                TreeNode objectsNode = Xml_Find(contentNode, "Objects");
-                                operation->Response = ResponseCommon_New(operation->Common, objectsNode);
-
-                                result = ResponseCommon_CheckForErrors(operation->Response);
-                                LogDebug("Perform Get Operation successful");
-                            }
-
-                            IPCMessage_Free(&getRequest);
-                            IPCMessage_Free(&getResponse);
-                        }
-                        else
-                        {
-                            result = LogErrorWithEnum(AwaError_OperationInvalid, "No paths specified");
-                        }
+                        // build an IPC message and inject our content (object paths) into it
+                        *request = IPCMessage_NewPlus(IPC_MESSAGE_TYPE_REQUEST, IPC_MESSAGE_SUB_TYPE_GET, OperationCommon_GetSessionID(operation->Common));
+                        IPCMessage_AddContent(*request, objectsTree);
+                        result = AwaError_Success;
                     }
                     else
                     {
-                        result = LogErrorWithEnum(AwaError_Internal, "ObjectsTree is NULL");
+                        result = LogErrorWithEnum(AwaError_OperationInvalid, "No paths specified");
                     }
                 }
                 else
                 {
-                    result = LogErrorWithEnum(AwaError_SessionNotConnected, "session is not connected");
+                    result = LogErrorWithEnum(AwaError_Internal, "ObjectsTree is NULL");
                 }
             }
             else
             {
-                result = LogErrorWithEnum(AwaError_SessionInvalid, "session is NULL");
+                result = LogErrorWithEnum(AwaError_SessionNotConnected, "session is not connected");
             }
         }
         else
         {
-            result = LogErrorWithEnum(AwaError_OperationInvalid, "operation is NULL");
+            result = LogErrorWithEnum(AwaError_SessionInvalid, "session is NULL");
+        }
+    }
+    else
+    {
+        result = LogErrorWithEnum(AwaError_OperationInvalid, "operation is NULL");
+    }
+    return result;
+}
+
+static AwaError ClientGetOperation_ProcessResponse(AwaClientGetOperation * operation, IPCMessage * response)
+{
+    // Free an old response if it exists
+    if (operation->Response != NULL)
+    {
+        ResponseCommon_Free(&operation->Response);
+    }
+
+    // Detach the response content and store it in the operation's ClientGetResponse
+    TreeNode contentNode = IPCMessage_GetContentNode(response);
+
+    TreeNode objectsNode = Xml_Find(contentNode, "Objects");
+    operation->Response = ResponseCommon_New(operation->Common, objectsNode);
+
+    LogDebug("Perform Get Operation successful");
+    return ResponseCommon_CheckForErrors(operation->Response);
+}
+
+static AwaError ClientGetOperation_AsyncResponseHandler(void * operation, IPCMessage * response)
+{
+    return ClientGetOperation_ProcessResponse((AwaClientGetOperation *)operation, response);
+}
+
+AwaError AwaClientGetOperation_Perform(AwaClientGetOperation * operation, AwaTimeout timeout)
+{
+    AwaError result = AwaError_Unspecified;
+
+    if (timeout >= 0)
+    {
+        IPCMessage * getRequest = NULL;
+        result = ClientGetOperation_NewRequest(operation, &getRequest);
+        if (result == AwaError_Success)
+        {
+            IPCMessage * getResponse = NULL;
+            result = IPC_SendAndReceive(ClientSession_GetChannel(ClientGetOperation_GetSession(operation)), getRequest, &getResponse, timeout);
+
+            // Process the response
+            if (result == AwaError_Success)
+            {
+                result = ClientGetOperation_ProcessResponse(operation, getResponse);
+            }
+
+            IPCMessage_Free(&getRequest);
+            IPCMessage_Free(&getResponse);
+        }
+    }
+    else
+    {
+        result = LogErrorWithEnum(AwaError_OperationInvalid, "Invalid timeout specified");
+    }
+    return result;
+}
+
+AwaError AwaClientGetOperation_PerformAsync(AwaClientGetOperation * operation, AwaTimeout timeout, AwaOperationCompleteCallback callback, void * context, AwaRequestID * requestID)
+{
+    AwaError result = AwaError_Unspecified;
+
+    if (timeout >= 0)
+    {
+        IPCMessage * getRequest = NULL;
+        result = ClientGetOperation_NewRequest(operation, &getRequest);
+        if (result == AwaError_Success)
+        {
+            SessionCommon * sessionCommon = ClientSession_GetSessionCommon(ClientGetOperation_GetSession(operation));
+            result = SessionCommon_SendAsyncRequest(sessionCommon, getRequest, timeout, ClientGetOperation_AsyncResponseHandler, operation, callback, context, requestID);
+            IPCMessage_Free(&getRequest);
         }
     }
     else
@@ -48,6 +48,26 @@ bool AwaClientGetResponse_HasValue(const AwaClientGetResponse * response, const
     return hasValue;
 }
 
+bool AwaClientGetResponse_HasValueByID(const AwaClientGetResponse * response, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID)
+{
+    bool hasValue = false;
+
+    if (response != NULL)
+    {
+        PathKey key;
+        if (PathKey_Make(&key, objectID, objectInstanceID, resourceID))
+        {
+            // AwaClientGetResponse is an alias for ResponseCommon
+            hasValue = ResponseCommon_HasValueByKey((const ResponseCommon *)response, &key);
+        }
+    }
+    else
+    {
+        LogErrorWithEnum(AwaError_OperationInvalid, "Get Response is NULL");
+    }
+    return hasValue;
+}
+
 bool AwaClientGetResponse_ContainsPath(const AwaClientGetResponse * response, const char * path)
 {
     bool containsPath = false;
@@ -127,6 +147,63 @@ AwaError AwaClientGetResponse_GetValueAsOpaquePointer    (const AwaClientGetResp
     return ResponseCommon_GetValuePointer((const ResponseCommon *)response, path, (const void **)value, NULL, AwaResourceType_Opaque, sizeof(AwaOpaque));
 }
 
+static AwaError GetValuePointerByID(const AwaClientGetResponse * response, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID,
+                                   const void ** value, AwaResourceType resourceType, int resourceSize, bool withNull)
+{
+    AwaError result = AwaError_Unspecified;
+    PathKey key;
+    if (PathKey_Make(&key, objectID, objectInstanceID, resourceID))
+    {
+        // AwaClientGetResponse is an alias for ResponseCommon
+        result = withNull ? ResponseCommon_GetValuePointerWithNullByKey((const ResponseCommon *)response, &key, value, NULL, resourceType, resourceSize)
+                          : ResponseCommon_GetValuePointerByKey((const ResponseCommon *)response, &key, value, NULL, resourceType, resourceSize);
+    }
+    else
+    {
+        if (value != NULL)
+        {
+            *value = NULL;
+        }
+        result = LogErrorWithEnum(AwaError_PathInvalid, "IDs %d/%d/%d do not identify a resource", objectID, objectInstanceID, resourceID);
+    }
+    return result;
+}
+
+AwaError AwaClientGetResponse_GetValueAsCStringPointerByID(const AwaClientGetResponse * response, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, const char ** value)
+{
+    return GetValuePointerByID(response, objectID, objectInstanceID, resourceID, (const void **)value, AwaResourceType_String, -1, true);
+}
+
+AwaError AwaClientGetResponse_GetValueAsIntegerPointerByID(const AwaClientGetResponse * response, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, const AwaInteger ** value)
+{
+    return GetValuePointerByID(response, objectID, objectInstanceID, resourceID, (const void **)value, AwaResourceType_Integer, sizeof(AwaInteger), false);
+}
+
+AwaError AwaClientGetResponse_GetValueAsFloatPointerByID(const AwaClientGetResponse * response, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, const AwaFloat ** value)
+{
+    return GetValuePointerByID(response, objectID, objectInstanceID, resourceID, (const void **)value, AwaResourceType_Float, sizeof(AwaFloat), false);
+}
+
+AwaError AwaClientGetResponse_GetValueAsBooleanPointerByID(const AwaClientGetResponse * response, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, const AwaBoolean ** value)
+{
+    return GetValuePointerByID(response, objectID, objectInstanceID, resourceID, (const void **)value, AwaResourceType_Boolean, sizeof(AwaBoolean), false);
+}
+
+AwaError AwaClientGetResponse_GetValueAsTimePointerByID(const AwaClientGetResponse * response, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, const AwaTime ** value)
+{
+    return GetValuePointerByID(response, objectID, objectInstanceID, resourceID, (const void **)value, AwaResourceType_Time, sizeof(AwaTime), false);
+}
+
+AwaError AwaClientGetResponse_GetValueAsObjectLinkPointerByID(const AwaClientGetResponse * response, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, const AwaObjectLink ** value)
+{
+    return GetValuePointerByID(response, objectID, objectInstanceID, resourceID, (const void **)value, AwaResourceType_ObjectLink, sizeof(AwaObjectLink), false);
+}
+
+AwaError AwaClientGetResponse_GetValueAsOpaquePointerByID(const AwaClientGetResponse * response, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, const AwaOpaque ** value)
+{
+    return GetValuePointerByID(response, objectID, objectInstanceID, resourceID, (const void **)value, AwaResourceType_Opaque, sizeof(AwaOpaque), false);
+}
+
 AwaError AwaClientGetResponse_GetValuesAsStringArrayPointer(const AwaClientGetResponse * response, const char * path, const AwaStringArray ** valueArray)
 {
     // AwaClientGetResponse is an alias for ResponseCommon
@@ -29,10 +29,12 @@
 #include <inttypes.h>
 #include <sys/types.h>
 #include <sys/socket.h>
-#include <sys/timeb.h>
+#include <sys/uio.h>
+#include <sys/un.h>
 #include <netdb.h>
 #include <errno.h>
 #include <poll.h>
+#include <time.h>
 
 #include "ipc.h"
 #include "memalloc.h"
@@ -41,10 +43,12 @@
 #include "utils.h"
 
 #define MAX_XML_BUFFER (65536)  // Should match core/src/common/lwm2m_xml_interface.c
+#define IPC_NOTIFICATION_FRAME_TIMEOUT (10 * 1000)  // longest wait for the rest of a notification once it has started to arrive
 
 struct _IPCInfo
 {
     struct addrinfo * AddressInfo;
+    char * UnixPath;
 };
 
 struct _IPCChannel
@@ -53,6 +57,8 @@ struct _IPCChannel
     int NotifySocket;
     struct sockaddr_storage DestinationAddress;
     socklen_t DestinationAddressLength;
+    IPCEncoding Encoding;
+    bool Stream;                // messages are framed on connected stream sockets
 };
 
 struct _IPCMessage
@@ -118,6 +124,39 @@ IPCInfo * IPCInfo_NewUDP(const char * address, unsigned short port)
     return ipcInfo;
 }
 
+IPCInfo * IPCInfo_NewUnix(const char * path)
+{
+    IPCInfo * ipcInfo = NULL;
+    struct sockaddr_un addr;
+
+    if ((path != NULL) && (strlen(path) > 0) && (strlen(path) < sizeof(addr.sun_path)))
+    {
+        ipcInfo = Awa_MemAlloc(sizeof(*ipcInfo));
+        if (ipcInfo != NULL)
+        {
+            memset(ipcInfo, 0, sizeof(*ipcInfo));
+            ipcInfo->UnixPath = Awa_MemAlloc(strlen(path) + 1);
+            if (ipcInfo->UnixPath != NULL)
+            {
+                strcpy(ipcInfo->UnixPath, path);
+                LogDebug("New Unix IPCInfo: path %s", path);
+                LogNew("IPCInfo", ipcInfo);
+            }
+            else
+            {
+                Awa_MemSafeFree(ipcInfo);
+                ipcInfo = NULL;
+                LogErrorWithEnum(AwaError_OutOfMemory);
+            }
+        }
+        else
+        {
+            LogErrorWithEnum(AwaError_OutOfMemory);
+        }
+    }
+    return ipcInfo;
+}
+
 void IPCInfo_Free(IPCInfo ** ipcInfo)
 {
     if (ipcInfo != NULL && *ipcInfo != NULL)
@@ -126,6 +165,7 @@ void IPCInfo_Free(IPCInfo ** ipcInfo)
         {
             freeaddrinfo((*ipcInfo)->AddressInfo);
         }
+        Awa_MemSafeFree((*ipcInfo)->UnixPath);
         LogFree("IPCInfo", ipcInfo);
         Awa_MemSafeFree(*ipcInfo);
         *ipcInfo = NULL;
@@ -161,6 +201,57 @@ static InternalError CreateUDPSockets(IPCChannel * channel, const IPCInfo * ipcI
     return result;
 }
 
+static int ConnectUnixSocket(const char * path)
+{
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+
+    int sock = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (sock > 0)
+    {
+        if (connect(sock, (struct sockaddr *)&addr, sizeof(addr)) != 0)
+        {
+            LogPError("Could not connect to %s", path);
+            close(sock);
+            sock = -1;
+        }
+    }
+    else
+    {
+        LogPError("Could not create Unix Socket");
+    }
+    return sock;
+}
+
+static InternalError CreateUnixSockets(IPCChannel * channel, const IPCInfo * ipcInfo)
+{
+    InternalError result = InternalError_IPCChannel;
+
+    // each socket is a separate connection, so requests and notifications are never interleaved
+    if ((channel->Socket = ConnectUnixSocket(ipcInfo->UnixPath)) > 0)
+    {
+        if ((channel->NotifySocket = ConnectUnixSocket(ipcInfo->UnixPath)) > 0)
+        {
+            channel->Stream = true;
+            result = InternalError_Success;
+            LogDebug("Unix sockets connected");
+        }
+        else
+        {
+            close(channel->Socket);
+            channel->Socket = 0;
+            channel->NotifySocket = 0;
+        }
+    }
+    else
+    {
+        channel->Socket = 0;
+    }
+    return result;
+}
+
 IPCChannel * IPCChannel_New(const IPCInfo * ipcInfo)
 {
     IPCChannel * channel = NULL;
@@ -185,6 +276,18 @@ IPCChannel * IPCChannel_New(const IPCInfo * ipcInfo)
                     channel = NULL;
                 }
             }
+            else if (ipcInfo->UnixPath != NULL)
+            {
+                if (CreateUnixSockets(channel, ipcInfo) == InternalError_Success)
+                {
+                    LogNew("IPCChannel", channel);
+                }
+                else
+                {
+                    Awa_MemSafeFree(channel);
+                    channel = NULL;
+                }
+            }
         }
         else
         {
@@ -214,6 +317,24 @@ void IPCChannel_Free(IPCChannel ** channel)
     }
 }
 
+int IPCChannel_GetNotifySocket(const IPCChannel * channel)
+{
+    return channel != NULL ? channel->NotifySocket : -1;
+}
+
+void IPCChannel_SetEncoding(IPCChannel * channel, IPCEncoding encoding)
+{
+    if (channel != NULL)
+    {
+        channel->Encoding = encoding;
+    }
+}
+
+IPCEncoding IPCChannel_GetEncoding(const IPCChannel * channel)
+{
+    return channel != NULL ? channel->Encoding : IPCEncoding_XML;
+}
+
 IPCMessage * IPCMessage_New(void)
 {
     IPCMessage * message = Awa_MemAlloc(sizeof(*message));
@@ -560,6 +681,85 @@ IPCSessionID IPCMessage_GetSessionID(const IPCMessage * message)
     return sessionID;
 }
 
+InternalError IPCMessage_SetRequestID(IPCMessage * message, IPCRequestID requestID)
+{
+    InternalError result = InternalError_ParameterInvalid;
+
+    if ((message != NULL) && (message->RootNode != NULL))
+    {
+        TreeNode requestIDNode = Xml_CreateNodeWithValue(IPC_MESSAGE_TAG_REQUEST_ID, "%d", requestID);
+        if ((requestIDNode != NULL) && TreeNode_AddChild(message->RootNode, requestIDNode))
+        {
+            result = InternalError_Success;
+        }
+        else
+        {
+            Tree_Delete(requestIDNode);
+            result = InternalError_Tree;
+        }
+    }
+    else
+    {
+        LogError("message is NULL");
+    }
+    return result;
+}
+
+IPCRequestID IPCMessage_GetRequestID(const IPCMessage * message)
+{
+    IPCRequestID requestID = 0;
+
+    if ((message != NULL) && (message->RootNode != NULL))
+    {
+        TreeNode requestIDNode = Xml_Find(message->RootNode, IPC_MESSAGE_TAG_REQUEST_ID);
+        const char * requestIDStr = NULL;
+        if ((requestIDStr = (const char *)TreeNode_GetValue(requestIDNode)) != NULL)
+        {
+            requestID = atoi(requestIDStr);
+        }
+    }
+    return requestID;
+}
+
+InternalError IPCMessage_SetEncoding(IPCMessage * message, IPCEncoding encoding)
+{
+    InternalError result = InternalError_ParameterInvalid;
+
+    if ((message != NULL) && (message->RootNode != NULL))
+    {
+        TreeNode encodingNode = Xml_CreateNodeWithValue(IPC_MESSAGE_TAG_ENCODING, "%s", encoding == IPCEncoding_Binary ? IPC_ENCODING_BINARY : IPC_ENCODING_XML);
+        if ((encodingNode != NULL) && TreeNode_AddChild(message->RootNode, encodingNode))
+        {
+            result = InternalError_Success;
+        }
+        else
+        {
+            Tree_Delete(encodingNode);
+            result = InternalError_Tree;
+        }
+    }
+    else
+    {
+        LogError("message is NULL");
+    }
+    return result;
+}
+
+IPCEncoding IPCMessage_GetEncoding(const IPCMessage * message)
+{
+    IPCEncoding encoding = IPCEncoding_XML;
+
+    if ((message != NULL) && (message->RootNode != NULL))
+    {
+        const char * encodingStr = (const char *)TreeNode_GetValue(Xml_Find(message->RootNode, IPC_MESSAGE_TAG_ENCODING));
+        if ((encodingStr != NULL) && (strcmp(encodingStr, IPC_ENCODING_BINARY) == 0))
+        {
+            encoding = IPCEncoding_Binary;
+        }
+    }
+    return encoding;
+}
+
 IPCResponseCode IPCMessage_GetResponseCode(const IPCMessage * message)
 {
     IPCResponseCode code = IPCResponseCode_NotSet;
@@ -689,23 +889,247 @@ AwaError IPCMessage_AddContent(IPCMessage * message, TreeNode content)
     return result;
 }
 
-static AwaError IPC_SendAndReceiveUsingSocket(int socket, struct sockaddr_storage * destinationAddress,  socklen_t destinationAddressLength, const IPCMessage * request, IPCMessage ** response, int32_t timeout)
+AwaError IPCMessage_AddBatchedMessage(IPCMessage * batch, const IPCMessage * message)
+{
+    AwaError result = AwaError_IPCError;
+
+    if ((batch != NULL) && (message != NULL) && (message->RootNode != NULL))
+    {
+        TreeNode contentNode = IPCMessage_GetContentNode(batch);
+        if (contentNode != NULL)
+        {
+            TreeNode requestsNode = Xml_Find(contentNode, "Requests");
+            if (requestsNode == NULL)
+            {
+                requestsNode = Xml_CreateNode("Requests");
+                TreeNode_AddChild(contentNode, requestsNode);
+            }
+
+            TreeNode messageCopy = Tree_Copy(message->RootNode);
+            if (messageCopy != NULL)
+            {
+                TreeNode_AddChild(requestsNode, messageCopy);
+                result = AwaError_Success;
+            }
+            else
+            {
+                result = AwaError_OutOfMemory;
+            }
+        }
+    }
+    else
+    {
+        LogError("batch or message is NULL");
+    }
+    return result;
+}
+
+IPCMessage * IPCMessage_NewBatchedMessage(IPCMessage * batch, size_t index)
+{
+    IPCMessage * message = NULL;
+    TreeNode responsesNode = Xml_Find(IPCMessage_GetContentNode(batch), "Responses");
+    TreeNode responseNode = TreeNode_GetChild(responsesNode, index);
+    if (responseNode != NULL)
+    {
+        message = IPCMessage_New();
+        if (message != NULL)
+        {
+            message->RootNode = Tree_Copy(responseNode);
+        }
+    }
+    else
+    {
+        LogError("No batched message at index %zu", index);
+    }
+    return message;
+}
+
+// Send a message, framed by its length if the channel is a stream. The header and message are gathered by
+// sendmsg, so the message is never copied into a framing buffer.
+static ssize_t IPC_SendMessage(const IPCChannel * channel, int socket, const char * buffer, size_t length)
+{
+    if (!channel->Stream)
+    {
+        return sendto(socket, buffer, length, 0, (const struct sockaddr *)&channel->DestinationAddress, channel->DestinationAddressLength);
+    }
+
+    uint8_t header[IPC_STREAM_HEADER_LEN] = { (length >> 24) & 0xff, (length >> 16) & 0xff, (length >> 8) & 0xff, length & 0xff };
+    struct iovec iov[2] = { { header, sizeof(header) }, { (void *)buffer, length } };
+    struct msghdr msg;
+    size_t remaining = sizeof(header) + length;
+
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = 2;
+
+    while (remaining > 0)
+    {
+        ssize_t sent = sendmsg(socket, &msg, MSG_NOSIGNAL);
+        if (sent < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return -1;
+        }
+        remaining -= sent;
+
+        // skip over whatever was sent by a partial write
+        while ((msg.msg_iovlen > 0) && (sent >= msg.msg_iov[0].iov_len))
+        {
+            sent -= msg.msg_iov[0].iov_len;
+            msg.msg_iov++;
+            msg.msg_iovlen--;
+        }
+        if (msg.msg_iovlen > 0)
+        {
+            msg.msg_iov[0].iov_base = (uint8_t *)msg.msg_iov[0].iov_base + sent;
+            msg.msg_iov[0].iov_len -= sent;
+        }
+    }
+    return length;
+}
+
+static int64_t IPC_GetTimeMs(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((int64_t)now.tv_sec * 1000) + (now.tv_nsec / 1000000);
+}
+
+// Receive exactly length bytes from a stream, waiting until deadline (in IPC_GetTimeMs time, 0 to wait forever) for
+// them to arrive. Returns length, or -1 on error, with errno set to ETIMEDOUT if the daemon stopped sending.
+static ssize_t IPC_ReceiveAll(int socket, void * buffer, size_t length, int64_t deadline)
+{
+    size_t received = 0;
+
+    while (received < length)
+    {
+        ssize_t rc = recv(socket, (uint8_t *)buffer + received, length - received, MSG_DONTWAIT);
+        if (rc > 0)
+        {
+            received += rc;
+            continue;
+        }
+        if (rc == 0)
+        {
+            errno = ECONNRESET;
+            return -1;
+        }
+        if (errno == EINTR)
+        {
+            continue;
+        }
+        if ((errno != EAGAIN) && (errno != EWOULDBLOCK))
+        {
+            return -1;
+        }
+
+        int wait = -1;
+        if (deadline > 0)
+        {
+            int64_t remaining = deadline - IPC_GetTimeMs();
+            if (remaining <= 0)
+            {
+                errno = ETIMEDOUT;
+                return -1;
+            }
+            wait = remaining < INT32_MAX ? (int)remaining : INT32_MAX;
+        }
+
+        struct pollfd fd = {
+                .fd = socket,
+                .events = POLLIN,
+        };
+        if ((poll(&fd, 1, wait) < 0) && (errno != EINTR))
+        {
+            return -1;
+        }
+    }
+    return length;
+}
+
+// Receive a message and deserialise it. Returns the number of bytes received, or -1 on error. On a stream,
+// the whole frame is read, so messages are not limited to the size of a single datagram, but a daemon that
+// stops part way through a frame is only waited for until deadline (0 to wait forever).
+static int IPC_ReceiveMessage(const IPCChannel * channel, int socket, IPCMessage ** message, int64_t deadline)
+{
+    int length = -1;
+    *message = NULL;
+
+    if (!channel->Stream)
+    {
+        char recvBuffer[MAX_XML_BUFFER] = {0};
+        struct sockaddr_storage recvAddr = {0};
+        socklen_t recvAddrLen = 0;
+
+        if ((length = recvfrom(socket, recvBuffer, sizeof(recvBuffer), 0, (struct sockaddr *)&recvAddr, &recvAddrLen)) > 0)
+        {
+            *message = IPC_DeserialiseMessage(recvBuffer, length);
+        }
+        return length;
+    }
+
+    uint8_t header[IPC_STREAM_HEADER_LEN];
+    if (IPC_ReceiveAll(socket, header, sizeof(header), deadline) == sizeof(header))
+    {
+        uint32_t frameLength = ((uint32_t)header[0] << 24) | ((uint32_t)header[1] << 16) | ((uint32_t)header[2] << 8) | header[3];
+        if ((frameLength > 0) && (frameLength <= IPC_MAX_STREAM_MESSAGE_LEN))
+        {
+            char * recvBuffer = Awa_MemAlloc(frameLength + 1);
+            if (recvBuffer != NULL)
+            {
+                if (IPC_ReceiveAll(socket, recvBuffer, frameLength, deadline) == frameLength)
+                {
+                    recvBuffer[frameLength] = '\0';
+                    *message = IPC_DeserialiseMessage(recvBuffer, frameLength);
+                    length = frameLength;
+                }
+                Awa_MemSafeFree(recvBuffer);
+            }
+            else
+            {
+                LogErrorWithEnum(AwaError_OutOfMemory);
+            }
+        }
+        else
+        {
+            LogError("Invalid IPC message length %" PRIu32, frameLength);
+        }
+    }
+
+    if (length < 0)
+    {
+        // part of a frame may have been consumed, so later messages on this stream can't be found
+        int error = errno;
+        shutdown(socket, SHUT_RDWR);
+        errno = error;
+    }
+    return length;
+}
+
+static AwaError IPC_SendAndReceiveUsingSocket(const IPCChannel * channel, int socket, const IPCMessage * request, IPCMessage ** response, int32_t timeout)
 {
     AwaError result = AwaError_Success;
 
-    char * requestBuffer = IPC_SerialiseMessageToXML(request);
+    IPCEncoding encoding = channel->Encoding;
+    size_t requestLength = 0;
+    char * requestBuffer = IPC_SerialiseMessage(request, encoding, &requestLength);
 
     if (response != NULL)
     {
         *response = NULL;
     }
-    struct timeb start, end;
-    ftime(&start);
+    int64_t start = IPC_GetTimeMs();
 
-    if ((requestBuffer != NULL) && (strlen(requestBuffer) > 0))
+    if ((requestBuffer != NULL) && (requestLength > 0))
     {
-        LogDebug("IPC send:\n%s", requestBuffer);
-        if (sendto(socket, requestBuffer, strlen(requestBuffer), 0, (struct sockaddr *)destinationAddress, destinationAddressLength) > 0)
+        if (encoding == IPCEncoding_XML)
+        {
+            LogDebug("IPC send:\n%s", requestBuffer);
+        }
+        if (IPC_SendMessage(channel, socket, requestBuffer, requestLength) > 0)
         {
             if (response != NULL)
             {
@@ -727,16 +1151,8 @@ static AwaError IPC_SendAndReceiveUsingSocket(int socket, struct sockaddr_storag
                 {
                     if (fd.revents == POLLIN)
                     {
-                        char recvBuffer[MAX_XML_BUFFER] = {0};
-                        int recvBufferLen = 0;
-                        struct sockaddr_storage recvAddr = {0};
-                        socklen_t recvAddrLen = 0;
-
-                        if ((recvBufferLen = recvfrom(socket, recvBuffer, sizeof(recvBuffer), 0, (struct sockaddr *)&recvAddr, &recvAddrLen)) > 0)
+                        if (IPC_ReceiveMessage(channel, socket, response, timeout > 0 ? start + timeout : 0) > 0)
                         {
-                            LogDebug("IPC receive:\n%s", recvBuffer);
-                            *response = IPC_DeserialiseMessageFromXML(recvBuffer, recvBufferLen);
-
                             if (*response != NULL)
                             {
                                 //TODO: check response code
@@ -744,9 +1160,13 @@ static AwaError IPC_SendAndReceiveUsingSocket(int socket, struct sockaddr_storag
                             }
                             else
                             {
-                                result = LogErrorWithEnum(AwaError_IPCError, "Failed to deserialise XML");
+                                result = LogErrorWithEnum(AwaError_IPCError, "Failed to deserialise message");
                             }
                         }
+                        else if (errno == ETIMEDOUT)
+                        {
+                            result = LogErrorWithEnum(AwaError_Timeout, "Timed out receiving response on IPC (timeout %d ms)", timeout);
+                        }
                         else
                         {
                             LogPError("Could not receive response on IPC");
@@ -760,8 +1180,7 @@ static AwaError IPC_SendAndReceiveUsingSocket(int socket, struct sockaddr_storag
                 }
                 else
                 {
-                    ftime(&end);
-                    int diff = (int) (1000.0 * (end.time - start.time) + (end.millitm - start.millitm));
+                    int diff = (int)(IPC_GetTimeMs() - start);
 
                     LogError("Timed out receiving response on IPC (timeout %d ms, wait time %d ms)", timeout, diff);
                     result = AwaError_Timeout;
@@ -795,7 +1214,7 @@ AwaError IPC_SendAndReceive(IPCChannel * channel, const IPCMessage * request, IP
     AwaError result = AwaError_Success;
     if (channel != NULL)
     {
-        result = IPC_SendAndReceiveUsingSocket(channel->Socket, &channel->DestinationAddress, channel->DestinationAddressLength, request, response, timeout);
+        result = IPC_SendAndReceiveUsingSocket(channel, channel->Socket, request, response, timeout);
     }
     else
     {
@@ -809,7 +1228,7 @@ AwaError IPC_SendAndReceiveOnNotifySocket(IPCChannel * channel, const IPCMessage
     AwaError result = AwaError_Success;
     if (channel != NULL)
     {
-        result = IPC_SendAndReceiveUsingSocket(channel->NotifySocket, &channel->DestinationAddress, channel->DestinationAddressLength, request, response, timeout);
+        result = IPC_SendAndReceiveUsingSocket(channel, channel->NotifySocket, request, response, timeout);
     }
     else
     {
@@ -865,19 +1284,11 @@ AwaError IPC_ReceiveNotification(IPCChannel * channel, IPCMessage ** notificatio
 
     if (channel != NULL && notification != NULL)
     {
-        char recvBuffer[MAX_XML_BUFFER] = {0};
-        int recvBufferLen = 0;
-        struct sockaddr_storage recvAddr = {0};
-        socklen_t recvAddrLen = 0;
-
-        if ((recvBufferLen = recvfrom(channel->NotifySocket, recvBuffer, sizeof(recvBuffer), 0, (struct sockaddr *)&recvAddr, &recvAddrLen)) > 0)
+        if (IPC_ReceiveMessage(channel, channel->NotifySocket, notification, IPC_GetTimeMs() + IPC_NOTIFICATION_FRAME_TIMEOUT) > 0)
         {
-            LogDebug("IPC notify:\n%s", recvBuffer);
-            *notification = IPC_DeserialiseMessageFromXML(recvBuffer, recvBufferLen);
-
             const char * type = NULL;
             IPCMessage_GetType(*notification, &type, NULL);
-            if (strcmp(IPC_MESSAGE_TYPE_NOTIFICATION, type) == 0)
+            if ((type != NULL) && ((strcmp(IPC_MESSAGE_TYPE_NOTIFICATION, type) == 0) || (strcmp(IPC_MESSAGE_TYPE_RESPONSE, type) == 0)))
             {
                 if (*notification != NULL)
                 {
@@ -896,7 +1307,7 @@ AwaError IPC_ReceiveNotification(IPCChannel * channel, IPCMessage ** notificatio
         }
         else
         {
-            if (errno == EAGAIN)
+            if ((errno == EAGAIN) || (errno == ETIMEDOUT))
             {
                 result = LogErrorWithEnum(AwaError_Timeout, "Timed out receiving notification on IPC");
             }
@@ -951,3 +1362,73 @@ char * IPC_SerialiseMessageToXML(const IPCMessage * message)
     return buffer;
 }
 
+IPCMessage * IPC_DeserialiseMessage(char * messageBuffer, size_t messageBufferLen)
+{
+    IPCMessage * message = NULL;
+
+    if (messageBuffer && messageBufferLen)
+    {
+        if (Xml_IsBinary((const uint8_t *)messageBuffer, messageBufferLen))
+        {
+            TreeNode rootNode = NULL;
+            if ((rootNode = Xml_BinaryToTree((const uint8_t *)messageBuffer, messageBufferLen)) != NULL)
+            {
+                message = IPCMessage_New();
+                message->RootNode = rootNode;
+            }
+        }
+        else
+        {
+            LogDebug("IPC receive:\n%s", messageBuffer);
+            message = IPC_DeserialiseMessageFromXML(messageBuffer, messageBufferLen);
+        }
+    }
+    return message;
+}
+
+char * IPC_SerialiseMessage(const IPCMessage * message, IPCEncoding encoding, size_t * length)
+{
+    char * buffer = NULL;
+    *length = 0;
+
+    if (message != NULL)
+    {
+        // Messages larger than a datagram can only be sent on a stream, so grow the buffer until the message fits.
+        // XML reports the exact size it needs, whereas binary only reports that it did not fit.
+        size_t bufferSize = MAX_XML_BUFFER;
+        int rc = -1;
+        while (bufferSize <= IPC_MAX_STREAM_MESSAGE_LEN)
+        {
+            Awa_MemSafeFree(buffer);
+            buffer = Awa_MemAlloc(bufferSize);
+            if (buffer == NULL)
+            {
+                LogErrorWithEnum(AwaError_OutOfMemory);
+                break;
+            }
+
+            if (encoding == IPCEncoding_Binary)
+            {
+                rc = Xml_TreeToBinary(message->RootNode, (uint8_t *)buffer, bufferSize);
+            }
+            else
+            {
+                rc = Xml_TreeToCompactString(message->RootNode, buffer, bufferSize);
+                if ((size_t)rc >= bufferSize)
+                {
+                    bufferSize = rc + 1;
+                    rc = -1;
+                    continue;
+                }
+            }
+
+            if (rc >= 0)
+            {
+                break;
+            }
+            bufferSize *= 2;
+        }
+        *length = rc > 0 ? rc : 0;
+    }
+    return buffer;
+}
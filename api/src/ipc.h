@@ -72,6 +72,15 @@ typedef enum
  */
 IPCInfo * IPCInfo_NewUDP(const char * address, unsigned short port);
 
+/**
+ * @brief Allocate a new IPC Info instance based on a Unix domain stream socket.
+ *        Messages are framed by their length, so are not limited to the size of a datagram.
+ * @param[in] path Filesystem path of the daemon's IPC socket.
+ * @return IpcInfo pointer if path is valid.
+ * @return NULL if path is invalid.
+ */
+IPCInfo * IPCInfo_NewUnix(const char * path);
+
 /**
  * @brief Free memory allocated to the specified IpcInfo instance.
  * @param[in/out] ipcInfo Address of IPC Info instance pointer to be freed. Will be set to NULL.
@@ -81,6 +90,11 @@ void IPCInfo_Free(IPCInfo ** ipcInfo);
 // IPC Channels
 IPCChannel * IPCChannel_New(const IPCInfo * ipcInfo);
 void IPCChannel_Free(IPCChannel ** channel);
+int IPCChannel_GetNotifySocket(const IPCChannel * channel);
+
+// Messages are sent in the channel's encoding, which defaults to XML. Either encoding is accepted when receiving.
+void IPCChannel_SetEncoding(IPCChannel * channel, IPCEncoding encoding);
+IPCEncoding IPCChannel_GetEncoding(const IPCChannel * channel);
 
 // IPC Messages
 IPCMessage * IPCMessage_New(void);
@@ -93,20 +107,36 @@ InternalError IPCMessage_GetType(const IPCMessage * message, const char ** type,
 InternalError IPCMessage_SetSessionID(IPCMessage * message, IPCSessionID sessionID);
 IPCSessionID IPCMessage_GetSessionID(const IPCMessage * message);
 
+InternalError IPCMessage_SetRequestID(IPCMessage * message, IPCRequestID requestID);
+IPCRequestID IPCMessage_GetRequestID(const IPCMessage * message);
+
+InternalError IPCMessage_SetEncoding(IPCMessage * message, IPCEncoding encoding);
+IPCEncoding IPCMessage_GetEncoding(const IPCMessage * message);
+
 IPCResponseCode IPCMessage_GetResponseCode(const IPCMessage * message);
 TreeNode IPCMessage_GetContentNode(IPCMessage * message);
 AwaError IPCMessage_AddContent(IPCMessage * message, TreeNode content);
 AwaError IPCMessage_RemoveContentNode(IPCMessage * message, TreeNode contentNode);
 
+// Batch messages carry a copy of each request in <Requests>, and the corresponding responses in <Responses>
+AwaError IPCMessage_AddBatchedMessage(IPCMessage * batch, const IPCMessage * message);
+IPCMessage * IPCMessage_NewBatchedMessage(IPCMessage * batch, size_t index);
+
 AwaError IPC_SendAndReceive(IPCChannel * channel, const IPCMessage * request, IPCMessage ** response, int32_t timeout);
 AwaError IPC_SendAndReceiveOnNotifySocket(IPCChannel * channel, const IPCMessage * request, IPCMessage ** response, int32_t timeout);
 
 AwaError IPC_WaitForNotification(IPCChannel * channel, int32_t timeout);
+// Receives a notification, or the response to a request sent on the notify socket
 AwaError IPC_ReceiveNotification(IPCChannel * channel, IPCMessage ** notification);
 
 IPCMessage * IPC_DeserialiseMessageFromXML(char * messageBuffer, size_t messageBufferLen);
 char * IPC_SerialiseMessageToXML(const IPCMessage * message);
 
+// Deserialise a message in either encoding
+IPCMessage * IPC_DeserialiseMessage(char * messageBuffer, size_t messageBufferLen);
+// Serialise a message in the specified encoding, setting length to the number of bytes produced
+char * IPC_SerialiseMessage(const IPCMessage * message, IPCEncoding encoding, size_t * length);
+
 #ifdef __cplusplus
 }
 #endif
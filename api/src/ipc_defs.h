@@ -29,8 +29,22 @@ extern "C" {
 
 typedef int IPCSessionID;
 
+// Requests may carry a non-zero ID, which is returned in the matching response
+typedef int IPCRequestID;
+
+// Messages are XML unless a more compact encoding is negotiated by the Connect request
+typedef enum
+{
+    IPCEncoding_XML = 0,
+    IPCEncoding_Binary,
+} IPCEncoding;
+
 #define IPC_MAX_BUFFER_LEN                          (65536)
 
+// Messages on stream (Unix domain) connections are framed by a four byte, big-endian length
+#define IPC_STREAM_HEADER_LEN                       (4)
+#define IPC_MAX_STREAM_MESSAGE_LEN                  (16 * 1024 * 1024)
+
 #define IPC_DEFAULT_ADDRESS                         "127.0.0.1"
 #define IPC_DEFAULT_CLIENT_PORT                     (12345)
 #define IPC_DEFAULT_SERVER_PORT                     (54321)
@@ -47,6 +61,7 @@ typedef int IPCSessionID;
 #define IPC_MESSAGE_SUB_TYPE_DISCONNECT             "Disconnect"
 #define IPC_MESSAGE_SUB_TYPE_DELETE                 "Delete"
 #define IPC_MESSAGE_SUB_TYPE_DEFINE                 "Define"
+#define IPC_MESSAGE_SUB_TYPE_BATCH                  "Batch"
 
 // Client request message sub-types:
 #define IPC_MESSAGE_SUB_TYPE_GET                    "Get"
@@ -70,6 +85,7 @@ typedef int IPCSessionID;
 #define IPC_MESSAGE_SUB_TYPE_CLIENT_REGISTER        "ClientRegister"
 #define IPC_MESSAGE_SUB_TYPE_CLIENT_DEREGISTER      "ClientDeregister"
 #define IPC_MESSAGE_SUB_TYPE_CLIENT_UPDATE          "ClientUpdate"
+#define IPC_MESSAGE_SUB_TYPE_FAN_OUT_RESULT         "FanOutResult"
 
 // IPC message tags:
 #define IPC_MESSAGE_TAG_CREATE                      "Create"
@@ -79,6 +95,13 @@ typedef int IPCSessionID;
 #define IPC_MESSAGE_TAG_CANCEL_SUBSCRIBE_TO_EXECUTE "CancelSubscribeToExecute"
 #define IPC_MESSAGE_TAG_OBSERVE                     "Observe"
 #define IPC_MESSAGE_TAG_CANCEL_OBSERVATION          "CancelObserve"
+#define IPC_MESSAGE_TAG_FAN_OUT                     "FanOut"
+#define IPC_MESSAGE_TAG_REQUEST_ID                  "RequestID"
+#define IPC_MESSAGE_TAG_ENCODING                    "Encoding"
+
+// Encodings
+#define IPC_ENCODING_XML                            "XML"
+#define IPC_ENCODING_BINARY                         "Binary"
 
 #ifdef __cplusplus
 }
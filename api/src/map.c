@@ -25,17 +25,23 @@
 #include "map.h"
 #include "memalloc.h"
 #include "lwm2m_list.h"
+#include "lwm2m_hash.h"
+
+// Most maps hold a handful of entries; the table doubles as it fills.
+#define MAP_INITIAL_BUCKETS (8)
 
 struct _MapType
 {
-    struct ListHead Entries;
+    struct ListHead Entries;    // Insertion order, used by Map_ForEach
+    HashTable Index;            // Keyed by Path
 };
 
 typedef struct
 {
     struct ListHead List;
+    HashEntry Index;
     void * Data;
-    const char * Path;
+    char Path[];                // Key is stored with the item, so an entry is a single allocation
 
 } MapItem;
 
@@ -45,6 +51,11 @@ MapType * Map_New(void)
     if (map)
     {
         ListInit(&map->Entries);
+        if (HashTable_Init(&map->Index, MAP_INITIAL_BUCKETS) != 0)
+        {
+            Awa_MemSafeFree(map);
+            map = NULL;
+        }
     }
     return map;
 }
@@ -54,6 +65,7 @@ void Map_Free(MapType ** map)
     if ((map != NULL) && (*map != NULL))
     {
         Map_Flush(*map);
+        HashTable_Destroy(&(*map)->Index);
         Awa_MemSafeFree(*map);
         *map = NULL;
     }
@@ -72,24 +84,40 @@ void Map_FreeValues(MapType * map)
         Map_Flush(map);
     }
 }
+
+static MapItem * Map_Find(MapType * map, const char * key, uint32_t hash)
+{
+    struct ListHead * current;
+    ListForEach(current, HashTable_GetBucket(&map->Index, hash))
+    {
+        HashEntry * hashEntry = ListEntry(current, HashEntry, list);
+        MapItem * mapItem = ListEntry(hashEntry, MapItem, Index);
+        if ((hashEntry->Hash == hash) && (strcmp(mapItem->Path, key) == 0))
+        {
+            return mapItem;
+        }
+    }
+    return NULL;
+}
+
+static void Map_RemoveItem(MapType * map, MapItem * mapItem)
+{
+    ListRemove(&mapItem->List);
+    HashTable_Remove(&map->Index, &mapItem->Index);
+    Awa_MemSafeFree(mapItem);
+}
+
 void * Map_Remove(MapType * map, const char * key)
 {
     void * removedData = NULL;
 
     if ((map != NULL) && (key != NULL))
     {
-        struct ListHead * current, * next;
-        ListForEachSafe(current, next, &map->Entries)
+        MapItem * mapItem = Map_Find(map, key, Hash_String(key));
+        if (mapItem != NULL)
         {
-            MapItem * mapItem = ListEntry(current, MapItem, List);
-            if (strcmp(mapItem->Path, key) == 0)
-            {
-                ListRemove(&mapItem->List);
-                removedData = mapItem->Data;
-                free((void *)mapItem->Path);
-                Awa_MemSafeFree(mapItem);
-                break;
-            }
+            removedData = mapItem->Data;
+            Map_RemoveItem(map, mapItem);
         }
     }
     return removedData;
@@ -101,28 +129,26 @@ bool Map_Put(MapType * map, const char * key, void * value)
 
     if ((map != NULL) && (key != NULL) && (value != NULL))
     {
+        uint32_t hash = Hash_String(key);
+
         // Replace if path already exists
-        struct ListHead * current, * next;
-        ListForEachSafe(current, next, &map->Entries)
+        MapItem * mapItem = Map_Find(map, key, hash);
+        if (mapItem != NULL)
         {
-            MapItem * mapItem = ListEntry(current, MapItem, List);
-            if (strcmp(mapItem->Path, key) == 0)
-            {
-                mapItem->Data = value;
-                result = true;
-                break;
-            }
+            mapItem->Data = value;
+            result = true;
         }
-
-        if (result == false)
+        else
         {
-            MapItem * mapItem = Awa_MemAlloc(sizeof(MapItem));
+            size_t keyLength = strlen(key);
+            mapItem = Awa_MemAlloc(sizeof(MapItem) + keyLength + 1);
             if (mapItem != NULL)
             {
-                mapItem->Path = strdup(key);
+                memcpy(mapItem->Path, key, keyLength + 1);
                 mapItem->Data = value;
 
                 ListAdd(&mapItem->List, &map->Entries);
+                HashTable_Add(&map->Index, &mapItem->Index, hash);
                 result = true;
             }
         }
@@ -142,16 +168,11 @@ bool Map_Get(MapType * map, const char * key, void ** value)
 
     if ((map != NULL) && (key != NULL) && (value != NULL))
     {
-        struct ListHead * current, * next;
-        ListForEachSafe(current, next, &map->Entries)
+        MapItem * mapItem = Map_Find(map, key, Hash_String(key));
+        if (mapItem != NULL)
         {
-            MapItem * mapItem = ListEntry(current, MapItem, List);
-            if (strcmp(mapItem->Path, key) == 0)
-            {
-                *value = mapItem->Data;
-                result = true;
-                break;
-            }
+            *value = mapItem->Data;
+            result = true;
         }
     }
     return result;
@@ -159,7 +180,7 @@ bool Map_Get(MapType * map, const char * key, void ** value)
 
 size_t Map_Length(MapType * map)
 {
-   return ListCount(&map->Entries);
+   return (map != NULL) ? HashTable_Count(&map->Index) : 0;
 }
 
 void Map_Flush(MapType * map)
@@ -170,9 +191,7 @@ void Map_Flush(MapType * map)
         ListForEachSafe(current, next, &map->Entries)
         {
             MapItem * mapItem = ListEntry(current, MapItem, List);
-            ListRemove(&mapItem->List);
-            free((void *)mapItem->Path);
-            Awa_MemSafeFree(mapItem);
+            Map_RemoveItem(map, mapItem);
         }
     }
 }
@@ -192,4 +211,3 @@ size_t Map_ForEach(MapType * map, MapForEachFunction callback, void * context)
     }
     return count;
 }
-
@@ -31,6 +31,7 @@
 extern "C" {
 #endif
 
+// Keys are hashed, so Put, Get, Contains and Remove do not depend on the size of the map.
 typedef struct _MapType MapType;
 typedef void (*MapForEachFunction)(const char * key, void * value, void * context);
 
@@ -97,14 +98,14 @@ void Map_Free(MapType ** map);
 void Map_FreeValues(MapType * map);
 
 /**
- * @brief Remove a key-value pair from the specified map.
+ * @brief Retrieve the number of key-value pairs in the specified map.
  * @param[in] map
- * @param[in] key
  * @return the number of key-value pairs in the map, or 0 if the map is invalid.
  */
 size_t Map_Length(MapType * map);
 
 /**
+ * @brief Invoke a callback for each key-value pair, in the order the keys were first put.
  * Note: callback should not modify the map
  */
 size_t Map_ForEach(MapType * map, MapForEachFunction callback, void * context);
@@ -23,16 +23,12 @@
 
 #include <stdlib.h>
 
-#include "lwm2m_xml_serdes.h"
-
 #include "path.h"
 #include "xml.h"
 #include "error.h"
 #include "log.h"
 #include "objects_tree.h"
 
-#define MAX_CLIENT_ID_NAME_LEN (64)
-
 TreeNode ObjectsTree_New(void)
 {
     TreeNode objectsTree = Xml_CreateNode("Objects");
@@ -48,47 +44,32 @@ void ObjectsTree_Free(TreeNode objectsTree)
     Tree_Delete(objectsTree);
 }
 
-static TreeNode FindNodeByID(const TreeNode parentNode, int childID, const char * childName, const char * valueName)
+static TreeNode FindNodeByID(const TreeNode parentNode, int childID, const char * childName)
 {
-    // search for a child node that has the specified ID
-    uint32_t index = 0;
-    TreeNode childNode = NULL;
-
-    while ((childNode = Xml_FindFrom(parentNode, childName, &index)) != NULL)
-    {
-        int ID = xmlif_GetInteger(childNode, valueName);
-        if (ID == childID)
-        {
-            break;
-        }
-    }
-    return childNode;
+    // search for a child node that has the specified ID; large parents are indexed by ID
+    return TreeNode_FindChildByID(parentNode, childName, "ID", childID);
 }
 
 static TreeNode FindObjectNode(const TreeNode objectsTree, int objectID)
 {
     // <Objects> contains several <Object> nodes
-    return FindNodeByID(objectsTree, objectID, "Object", "Object/ID");
+    return FindNodeByID(objectsTree, objectID, "Object");
 }
 
 static TreeNode FindInstanceNode(const TreeNode objectNode, int instanceID)
 {
     // <Object> contains one <Instance> or <Instances> node
-    return FindNodeByID(objectNode, instanceID, "ObjectInstance", "ObjectInstance/ID");
+    return FindNodeByID(objectNode, instanceID, "ObjectInstance");
 }
 
 static TreeNode FindResourceNode(const TreeNode instanceNode, int propertyID)
 {
-    return FindNodeByID(instanceNode, propertyID, "Resource", "Resource/ID");
+    return FindNodeByID(instanceNode, propertyID, "Resource");
 }
 
 TreeNode ObjectsTree_FindOrCreateChildNode(const TreeNode parent, const char * childName, int childID)
 {
-    char childIDname[MAX_CLIENT_ID_NAME_LEN] = {0};
-
-    sprintf(childIDname, "%s/ID", childName);
-
-    TreeNode child = FindNodeByID(parent, childID, childName, childIDname);
+    TreeNode child = FindNodeByID(parent, childID, childName);
     if (child == NULL)
     {
         child = Xml_CreateNode(childName);
@@ -110,7 +91,15 @@ size_t ObjectsTree_GetNumChildrenWithName(const TreeNode parentNode, const char
     return childCount;
 }
 
-InternalError ObjectsTree_FindPathNode(const TreeNode objectsTree, const char * path, TreeNode * _resultNode)
+InternalError ObjectsTree_FindPathNode(const TreeNode objectsTree, const char * path, TreeNode * resultNode)
+{
+    // an invalid path gives an empty key, which is rejected
+    PathKey key;
+    PathKey_Parse(&key, path);
+    return ObjectsTree_FindPathNodeByKey(objectsTree, &key, resultNode);
+}
+
+InternalError ObjectsTree_FindPathNodeByKey(const TreeNode objectsTree, const PathKey * key, TreeNode * _resultNode)
 {
     InternalError result = InternalError_Unspecified;
     TreeNode resultNode = NULL;
@@ -119,11 +108,11 @@ InternalError ObjectsTree_FindPathNode(const TreeNode objectsTree, const char *
     {
         if ((TreeNode_GetName(objectsTree) != NULL) && (strcmp("Objects", TreeNode_GetName(objectsTree)) == 0))
         {
-            if (path != NULL)
+            if (key != NULL)
             {
-                AwaObjectID objectID = Path_GetObjectID(path);
-                AwaObjectInstanceID objectInstanceID = Path_GetObjectInstanceID(path);
-                AwaResourceID resourceID = Path_GetResourceID(path);
+                AwaObjectID objectID = PathKey_GetObjectID(key);
+                AwaObjectInstanceID objectInstanceID = PathKey_GetObjectInstanceID(key);
+                AwaResourceID resourceID = PathKey_GetResourceID(key);
 
                 if (Path_IsIDValid(objectID))
                 {
@@ -178,7 +167,7 @@ InternalError ObjectsTree_FindPathNode(const TreeNode objectsTree, const char *
                 }
                 else
                 {
-                    LogError("path %s is invalid", path);
+                    LogError("path is invalid");
                     result = InternalError_ParameterInvalid;
                 }
             }
@@ -269,7 +258,18 @@ static TreeNode AddResourceToTree(TreeNode instanceNode, int resourceID)
 }
 
 // Using the specified path, build up new nodes in an existing tree to match.
-InternalError ObjectsTree_AddPath(TreeNode objectsTree, const char * path, TreeNode * _resultNode)
+InternalError ObjectsTree_AddPath(TreeNode objectsTree, const char * path, TreeNode * resultNode)
+{
+    PathKey key;
+    if ((path != NULL) && !PathKey_Parse(&key, path))
+    {
+        LogError("path %s is invalid", path);
+        return InternalError_ParameterInvalid;
+    }
+    return ObjectsTree_AddPathByKey(objectsTree, (path != NULL) ? &key : NULL, resultNode);
+}
+
+InternalError ObjectsTree_AddPathByKey(TreeNode objectsTree, const PathKey * key, TreeNode * _resultNode)
 {
     InternalError result = InternalError_Unspecified;
     TreeNode resultNode = NULL;
@@ -278,13 +278,13 @@ InternalError ObjectsTree_AddPath(TreeNode objectsTree, const char * path, TreeN
     {
         if (strcmp("Objects", TreeNode_GetName(objectsTree)) == 0)
         {
-            if (path != NULL)
+            if (key != NULL)
             {
-                if (Path_IsValid(path))
+                if (key->Depth > 0)
                 {
-                    AwaObjectID objectID = Path_GetObjectID(path);
-                    AwaObjectInstanceID objectInstanceID = Path_GetObjectInstanceID(path);
-                    AwaResourceID resourceID = Path_GetResourceID(path);
+                    AwaObjectID objectID = PathKey_GetObjectID(key);
+                    AwaObjectInstanceID objectInstanceID = PathKey_GetObjectInstanceID(key);
+                    AwaResourceID resourceID = PathKey_GetResourceID(key);
 
                     // does path specify an Object ID?
                     if (Path_IsIDValid(objectID))
@@ -329,7 +329,7 @@ InternalError ObjectsTree_AddPath(TreeNode objectsTree, const char * path, TreeN
                 }
                 else
                 {
-                    LogError("path %s is invalid", path);
+                    LogError("path is invalid");
                     result = InternalError_ParameterInvalid;
                 }
             }
@@ -363,22 +363,33 @@ static bool HasChildNamed(const TreeNode node, const char * name)
 }
 
 bool ObjectsTree_IsPathCovered(const TreeNode objectsTree, const char * path, TreeNode * resultNode)
+{
+    PathKey key;
+    if ((path != NULL) && !PathKey_Parse(&key, path))
+    {
+        LogError("path %s is invalid", path);
+        return false;
+    }
+    return ObjectsTree_IsPathCoveredByKey(objectsTree, (path != NULL) ? &key : NULL, resultNode);
+}
+
+bool ObjectsTree_IsPathCoveredByKey(const TreeNode objectsTree, const PathKey * key, TreeNode * resultNode)
 {
     bool result = false;
     if (objectsTree != NULL)
     {
         if (strcmp("Objects", TreeNode_GetName(objectsTree)) == 0)
         {
-            if (path != NULL)
+            if (key != NULL)
             {
-                if (Path_IsValid(path))
+                if (key->Depth > 0)
                 {
                     // Search down the tree, looking for a terminal node that matches the path.
                     // If a terminal node is encountered, the node is considered "already added"
                     // find a matching path
-                    AwaObjectID objectID = Path_GetObjectID(path);
-                    AwaObjectInstanceID objectInstanceID = Path_GetObjectInstanceID(path);
-                    AwaResourceID resourceID = Path_GetResourceID(path);
+                    AwaObjectID objectID = PathKey_GetObjectID(key);
+                    AwaObjectInstanceID objectInstanceID = PathKey_GetObjectInstanceID(key);
+                    AwaResourceID resourceID = PathKey_GetResourceID(key);
 
                     if (Path_IsIDValid(objectID))
                     {
@@ -457,7 +468,7 @@ bool ObjectsTree_IsPathCovered(const TreeNode objectsTree, const char * path, Tr
                 }
                 else
                 {
-                    LogError("path %s is invalid", path);
+                    LogError("path is invalid");
                 }
             }
             else
@@ -568,6 +579,15 @@ void ObjectsTree_GetIDsFromLeafNode(TreeNode node, ObjectIDType * objectID, Obje
     }
 }
 
+bool ObjectsTree_GetPathKey(TreeNode node, PathKey * key)
+{
+    ObjectIDType objectID;
+    ObjectInstanceIDType objectInstanceID;
+    ResourceIDType resourceID;
+    ObjectsTree_GetIDsFromLeafNode(node, &objectID, &objectInstanceID, &resourceID);
+    return PathKey_Make(key, objectID, objectInstanceID, resourceID);
+}
+
 const char * ObjectsTree_GetPath(TreeNode node, char * path, size_t pathLen)
 {
     ObjectIDType objectID;
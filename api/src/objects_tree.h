@@ -27,6 +27,7 @@
 #include "error.h"
 #include "xmltree.h"
 #include "lwm2m_types.h"
+#include "path.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -45,6 +46,7 @@ void ObjectsTree_Free(TreeNode objectsNode);
  * @return InternalError_Tree if the path node is not located, resultNode will point to NULL.
  */
 InternalError ObjectsTree_FindPathNode(const TreeNode objectsNode, const char * path, TreeNode * resultNode);
+InternalError ObjectsTree_FindPathNodeByKey(const TreeNode objectsNode, const PathKey * key, TreeNode * resultNode);
 
 /**
  * @brief Check if a path exists in an object tree.
@@ -63,6 +65,7 @@ bool ObjectsTree_ContainsPath(const TreeNode objectsNode, const char * path);
  * @return InternalError_Tree if the path node cannot be located or created, resultNode will point to NULL.
  */
 InternalError ObjectsTree_AddPath(TreeNode objectsNode, const char * path, TreeNode * resultNode);
+InternalError ObjectsTree_AddPathByKey(TreeNode objectsNode, const PathKey * key, TreeNode * resultNode);
 
 /**
  * @brief Check if a new path is already covered by an existing path in the Objects
@@ -73,6 +76,7 @@ InternalError ObjectsTree_AddPath(TreeNode objectsNode, const char * path, TreeN
  * @return true if path is already covered by an existing tree node.
  */
 bool ObjectsTree_IsPathCovered(const TreeNode objectsNode, const char * path, TreeNode * resultNode);
+bool ObjectsTree_IsPathCoveredByKey(const TreeNode objectsNode, const PathKey * key, TreeNode * resultNode);
 
 /**
  * @brief Remove any child path nodes (Instance, Instances, Property, Properties) from the node.
@@ -144,6 +148,12 @@ void ObjectsTree_GetIDsFromLeafNode(TreeNode node, ObjectIDType * objectID, Obje
  */
 const char * ObjectsTree_GetPath(TreeNode node, char * path, size_t pathLen);
 
+/**
+ * @brief Retrieve the path of an Object, Object instance or Resource node as a key, without formatting a string.
+ * @return true if the node represents a valid path.
+ */
+bool ObjectsTree_GetPathKey(TreeNode node, PathKey * key);
+
 /**
  * @brief Retreive The number of children inside a parent node with the specified name.
  * @param[in] parentNode the name of the parent node.
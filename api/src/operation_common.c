@@ -179,55 +179,76 @@ TreeNode OperationCommon_GetObjectsTree(const OperationCommon * operation)
 AwaError OperationCommon_AddPathToObjectsTree(TreeNode objectsTree, const char * path, TreeNode * resultNode)
 {
     AwaError result = AwaError_Unspecified;
-
     if (objectsTree != NULL)
     {
         if (path != NULL)
         {
-            if (Path_IsValid(path))
+            PathKey key;
+            if (PathKey_Parse(&key, path))
+            {
+                result = OperationCommon_AddPathKeyToObjectsTree(objectsTree, &key, resultNode);
+            }
+            else
             {
-                // Drop paths that are already represented
-                // E.g. /3/0/0 should be dropped if /3/0 is already present
-                if (ObjectsTree_IsPathCovered(objectsTree, path, resultNode) == false)
+                result = LogErrorWithEnum(AwaError_PathInvalid, "Path %s is not valid", path);
+            }
+        }
+        else
+        {
+            result = LogErrorWithEnum(AwaError_PathInvalid, "Path is NULL");
+        }
+    }
+    else
+    {
+        result = LogErrorWithEnum(AwaError_OperationInvalid, "Objects Tree is NULL");
+    }
+    return result;
+}
+
+AwaError OperationCommon_AddPathKeyToObjectsTree(TreeNode objectsTree, const PathKey * key, TreeNode * resultNode)
+{
+    AwaError result = AwaError_Unspecified;
+    if (objectsTree != NULL)
+    {
+        if ((key != NULL) && (key->Depth > 0))
+        {
+            // Drop paths that are already represented
+            // E.g. /3/0/0 should be dropped if /3/0 is already present
+            if (ObjectsTree_IsPathCoveredByKey(objectsTree, key, resultNode) == false)
+            {
+                // if a new path that covers existing paths is added, remove any existing path nodes
+                TreeNode existing = NULL;
+                if (ObjectsTree_FindPathNodeByKey(objectsTree, key, &existing) == InternalError_Success)
                 {
-                    // if a new path that covers existing paths is added, remove any existing path nodes
-                    TreeNode existing = NULL;
-                    if (ObjectsTree_FindPathNode(objectsTree, path, &existing) == InternalError_Success)
+                    if (resultNode != NULL)
+                    {
+                        *resultNode = existing;
+                    }
+                    ObjectsTree_RemovePathNodes(existing);
+                    LogDebug("Removing nodes below existing path node");
+                    result = AwaError_Success;
+                }
+                else
+                {
+                    if (ObjectsTree_AddPathByKey(objectsTree, key, resultNode) == InternalError_Success)
                     {
-                        if (resultNode != NULL)
-                        {
-                            *resultNode = existing;
-                        }
-                        ObjectsTree_RemovePathNodes(existing);
-                        LogDebug("Removing nodes below %s", path);
                         result = AwaError_Success;
                     }
                     else
                     {
-                        if (ObjectsTree_AddPath(objectsTree, path, resultNode) == InternalError_Success)
-                        {
-                            result = AwaError_Success;
-                        }
-                        else
-                        {
-                            result = LogErrorWithEnum(AwaError_Internal, "AddPath failed");
-                        }
+                        result = LogErrorWithEnum(AwaError_Internal, "AddPath failed");
                     }
                 }
-                else
-                {
-                    LogDebug("Dropping path %s", path);
-                    result = AwaError_Success;
-                }
             }
             else
             {
-                result = LogErrorWithEnum(AwaError_PathInvalid, "Path %s is not valid", path);
+                LogDebug("Dropping path already covered by the tree");
+                result = AwaError_Success;
             }
         }
         else
         {
-            result = LogErrorWithEnum(AwaError_PathInvalid, "Path is NULL");
+            result = LogErrorWithEnum(AwaError_PathInvalid, "Path is not valid");
         }
     }
     else
@@ -240,7 +261,6 @@ AwaError OperationCommon_AddPathToObjectsTree(TreeNode objectsTree, const char *
 AwaError OperationCommon_AddPathV2(OperationCommon * operation, const char * path, TreeNode * resultNode)
 {
     AwaError result = AwaError_Unspecified;
-
     if (operation != NULL)
     {
         result = OperationCommon_AddPathToObjectsTree(operation->ObjectsTree, path, resultNode);
@@ -252,6 +272,20 @@ AwaError OperationCommon_AddPathV2(OperationCommon * operation, const char * pat
     return result;
 }
 
+AwaError OperationCommon_AddPathByKey(OperationCommon * operation, const PathKey * key, TreeNode * resultNode)
+{
+    AwaError result = AwaError_Unspecified;
+    if (operation != NULL)
+    {
+        result = OperationCommon_AddPathKeyToObjectsTree(operation->ObjectsTree, key, resultNode);
+    }
+    else
+    {
+        result = LogErrorWithEnum(AwaError_OperationInvalid, "Operation is NULL");
+    }
+    return result;
+}
+
 static TreeNode AddIDRange(TreeNode resourceNode, AwaArrayIndex startIndex, AwaArrayIndex endIndexExclusive)
 {
     TreeNode rangeNode = NULL;
@@ -32,6 +32,7 @@
 #include "lwm2m_definition.h"
 #include "xml.h"
 #include "error.h"
+#include "path.h"
 #include "client_session.h"
 #include "server_session.h"
 
@@ -72,6 +73,10 @@ TreeNode OperationCommon_GetObjectsTree(const OperationCommon * operation);
 
 AwaError OperationCommon_AddPathToObjectsTree(TreeNode objectsTree, const char * path, TreeNode * resultNode);
 AwaError OperationCommon_AddPathV2(OperationCommon * operation, const char * path, TreeNode * resultNode);
+
+// As above, for a path that has already been parsed or built from IDs.
+AwaError OperationCommon_AddPathKeyToObjectsTree(TreeNode objectsTree, const PathKey * key, TreeNode * resultNode);
+AwaError OperationCommon_AddPathByKey(OperationCommon * operation, const PathKey * key, TreeNode * resultNode);
 AwaError OperationCommon_AddPathWithArrayRange(OperationCommon * operation, const char * path, AwaArrayIndex startIndex, AwaArrayLength indexCount);
 
 IPCSessionID OperationCommon_GetSessionID(const OperationCommon * operation);
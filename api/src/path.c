@@ -22,12 +22,14 @@
 
 
 #include <stdio.h>
+#include <string.h>
 
 #include "awa/common.h"
 #include "path.h"
 #include "log.h"
 #include "utils.h"
 #include "memalloc.h"
+#include "lwm2m_hash.h"
 
 #define OBJECT_MATCH 1
 #define OBJECT_INSTANCE_MATCH 2
@@ -40,75 +42,24 @@ bool Path_IsIDValid(int ID)
 
 bool Path_Parse(const char * path, int * _matches, AwaObjectID * _objectID, AwaObjectInstanceID * _objectInstanceID, AwaResourceID * _resourceID)
 {
-    bool result = false;
-
-    int matches = 0;
-    AwaObjectID objectID = AWA_INVALID_ID;
-    AwaObjectInstanceID objectInstanceID = AWA_INVALID_ID;
-    AwaResourceID resourceID = AWA_INVALID_ID;
-
-    if (path != NULL)
-    {
-        matches = sscanf(path, "/%10d/%10d/%10d", &objectID, &objectInstanceID, &resourceID);
-
-        char * compare = NULL;
-        switch (matches)
-        {
-        case OBJECT_MATCH:
-            if (Path_IsIDValid(objectID))
-            {
-                msprintf(&compare, "/%d", objectID);
-            }
-            break;
-        case OBJECT_INSTANCE_MATCH:
-            if (Path_IsIDValid(objectID) && Path_IsIDValid(objectInstanceID))
-            {
-                msprintf(&compare, "/%d/%d", objectID, objectInstanceID);
-            }
-            break;
-        case RESOURCE_MATCH:
-            if (Path_IsIDValid(objectID) && Path_IsIDValid(objectInstanceID) && Path_IsIDValid(resourceID))
-            {
-                msprintf(&compare, "/%d/%d/%d", objectID, objectInstanceID, resourceID);
-            }
-            break;
-        case EOF:  // no-break
-        default:
-            break;
-        }
-
-        if (compare != NULL)
-        {
-            // compare a rebuilt string with the original. Path is valid if they match.
-            result = (strcmp(path, compare) == 0);
-            Awa_MemSafeFree(compare);
-        }
-
-        if (result == false)
-        {
-            // clear results on failure
-            matches = 0;
-            objectID = AWA_INVALID_ID;
-            objectInstanceID = AWA_INVALID_ID;
-            resourceID = AWA_INVALID_ID;
-        }
-    }
+    PathKey key;
+    bool result = PathKey_Parse(&key, path);
 
     if (_matches != NULL)
     {
-        *_matches = matches;
+        *_matches = key.Depth;
     }
     if (_objectID != NULL)
     {
-        *_objectID = objectID;
+        *_objectID = PathKey_GetObjectID(&key);
     }
     if (_objectInstanceID != NULL)
     {
-        *_objectInstanceID = objectInstanceID;
+        *_objectInstanceID = PathKey_GetObjectInstanceID(&key);
     }
     if (_resourceID != NULL)
     {
-        *_resourceID = resourceID;
+        *_resourceID = PathKey_GetResourceID(&key);
     }
 
     return result;
@@ -282,6 +233,114 @@ AwaError Path_MakePath(char * path, size_t pathSize, AwaObjectID objectID, AwaOb
     return result;
 }
 
+bool PathKey_Make(PathKey * key, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID)
+{
+    int ids[] = { objectID, objectInstanceID, resourceID };
+    int depth = 0;
+    int i;
+
+    memset(key, 0, sizeof(*key));
+
+    // valid IDs must come first: "/O", "/O/I" or "/O/I/R"
+    while ((depth < RESOURCE_MATCH) && Path_IsIDValid(ids[depth]))
+    {
+        key->IDs[depth] = ids[depth];
+        ++depth;
+    }
+    for (i = depth; i < RESOURCE_MATCH; i++)
+    {
+        if (ids[i] != AWA_INVALID_ID)
+        {
+            depth = 0;
+        }
+    }
+
+    if (depth > 0)
+    {
+        key->Depth = depth;
+    }
+    else
+    {
+        memset(key, 0, sizeof(*key));
+    }
+    return key->Depth > 0;
+}
+
+bool PathKey_Parse(PathKey * key, const char * path)
+{
+    const char * current = path;
+    bool valid = (path != NULL) && (*path == '/');
+
+    memset(key, 0, sizeof(*key));
+
+    // Path must be strictly of the form "/X", "/X/X" or "/X/X/X",
+    // where X is numerical between 0 and 65535, without sign or leading zeros.
+    while (valid && (*current == '/'))
+    {
+        long ID = 0;
+
+        ++current;
+        if ((key->Depth == RESOURCE_MATCH) || (*current < '0') || (*current > '9') ||
+            ((current[0] == '0') && (current[1] >= '0') && (current[1] <= '9')))
+        {
+            valid = false;
+            break;
+        }
+        while ((*current >= '0') && (*current <= '9') && (ID <= AWA_MAX_ID))
+        {
+            ID = (ID * 10) + (*current++ - '0');
+        }
+        if (ID > AWA_MAX_ID)
+        {
+            valid = false;
+            break;
+        }
+        key->IDs[key->Depth++] = ID;
+    }
+
+    if (!valid || (*current != '\0'))
+    {
+        memset(key, 0, sizeof(*key));
+    }
+    return key->Depth > 0;
+}
+
+AwaError PathKey_Format(const PathKey * key, char * path, size_t pathSize)
+{
+    return Path_MakePath(path, pathSize, PathKey_GetObjectID(key), PathKey_GetObjectInstanceID(key), PathKey_GetResourceID(key));
+}
+
+AwaObjectID PathKey_GetObjectID(const PathKey * key)
+{
+    return (key->Depth >= OBJECT_MATCH) ? key->IDs[0] : AWA_INVALID_ID;
+}
+
+AwaObjectInstanceID PathKey_GetObjectInstanceID(const PathKey * key)
+{
+    return (key->Depth >= OBJECT_INSTANCE_MATCH) ? key->IDs[1] : AWA_INVALID_ID;
+}
+
+AwaResourceID PathKey_GetResourceID(const PathKey * key)
+{
+    return (key->Depth >= RESOURCE_MATCH) ? key->IDs[2] : AWA_INVALID_ID;
+}
+
+bool PathKey_IsResource(const PathKey * key)
+{
+    return key->Depth == RESOURCE_MATCH;
+}
+
+bool PathKey_Equals(const PathKey * key, const PathKey * other)
+{
+    // unused IDs are always zero, so the whole array can be compared
+    return (key->Depth == other->Depth) && (memcmp(key->IDs, other->IDs, sizeof(key->IDs)) == 0);
+}
+
+uint32_t PathKey_Hash(const PathKey * key)
+{
+    return Hash_Bytes(key->IDs, sizeof(key->IDs)) ^ key->Depth;
+}
+
 AwaError AwaAPI_MakeObjectPath(char * path, size_t pathSize, AwaObjectID objectID)
 {
     AwaError result = AwaError_Unspecified;
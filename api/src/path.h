@@ -25,6 +25,8 @@
 #define PATH_H
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
 #include "awa/common.h"
 
@@ -34,6 +36,20 @@ extern "C" {
 
 #define MAX_PATH_LENGTH (256)
 
+#define PATH_MAX_DEPTH (4)
+
+/**
+ * @brief A path held as packed integer IDs rather than a "/O/I/R" string, so that it
+ *        can be compared, hashed and looked up without being formatted or parsed.
+ *        Keys are built with PathKey_Make or PathKey_Parse; IDs beyond Depth are zero.
+ */
+typedef struct
+{
+    uint16_t IDs[PATH_MAX_DEPTH];   // Object, Object Instance, Resource and Resource Instance IDs
+    uint8_t Depth;                  // Number of IDs in use: 1 for "/O", 2 for "/O/I", 3 for "/O/I/R"
+
+} PathKey;
+
 bool Path_IsIDValid(int ID);
 
 bool Path_IsValid(const char * path);
@@ -80,6 +96,37 @@ AwaResourceID Path_GetResourceID(const char * path);
 
 AwaError Path_MakePath(char * path, size_t pathSize, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID);
 
+/**
+ * @brief Build a path key from IDs. Trailing IDs may be AWA_INVALID_ID, as with Path_MakePath.
+ * @param[out] key Key to populate.
+ * @return true if the IDs form a valid object, object instance or resource path
+ * @return false if they do not, in which case key has a Depth of zero.
+ */
+bool PathKey_Make(PathKey * key, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID);
+
+/**
+ * @brief Parse a "/O", "/O/I" or "/O/I/R" path into a key, accepting exactly the paths Path_IsValid accepts.
+ * @param[out] key Key to populate.
+ * @param[in] path Path to parse.
+ * @return true if path is valid
+ * @return false if path is not valid, in which case key has a Depth of zero.
+ */
+bool PathKey_Parse(PathKey * key, const char * path);
+
+/**
+ * @brief Format a key as a "/O/I/R" path, e.g. for log messages.
+ * @return AwaError_Success on success, AwaError_PathInvalid if the key is empty or AwaError_Overrun if pathSize is too small.
+ */
+AwaError PathKey_Format(const PathKey * key, char * path, size_t pathSize);
+
+AwaObjectID PathKey_GetObjectID(const PathKey * key);
+AwaObjectInstanceID PathKey_GetObjectInstanceID(const PathKey * key);
+AwaResourceID PathKey_GetResourceID(const PathKey * key);
+
+bool PathKey_IsResource(const PathKey * key);
+bool PathKey_Equals(const PathKey * key, const PathKey * other);
+uint32_t PathKey_Hash(const PathKey * key);
+
 #ifdef __cplusplus
 }
 #endif
@@ -38,11 +38,13 @@
 #include "server_response.h"
 #include "server_operation.h"
 #include "client_iterator.h"
+#include "read_operation.h"
 
 struct _AwaServerReadOperation
 {
     ServerOperation * ServerOperation;
     ServerResponse * Response;
+    size_t FanOutWindow;
 };
 
 // This struct is used for API type safety and is never instantiated.
@@ -123,89 +125,170 @@ AwaError AwaServerReadOperation_AddPath(AwaServerReadOperation * operation, cons
     return result;
 }
 
-AwaError AwaServerReadOperation_Perform(AwaServerReadOperation * operation, AwaTimeout timeout)
+AwaError AwaServerReadOperation_AddPathByID(AwaServerReadOperation * operation, const char * clientID, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID)
 {
     AwaError result = AwaError_Unspecified;
 
-    if (timeout >= 0)
+    if (operation != NULL)
     {
-        if (operation != NULL)
+        PathKey key;
+        if (PathKey_Make(&key, objectID, objectInstanceID, resourceID))
         {
-            const AwaServerSession * session = ServerOperation_GetSession(operation->ServerOperation);
-            if (session != NULL)
+            result = ServerOperation_AddPathByKey(operation->ServerOperation, clientID, &key, NULL);
+        }
+        else
+        {
+            result = LogErrorWithEnum(AwaError_PathInvalid, "IDs %d/%d/%d do not form a valid path", objectID, objectInstanceID, resourceID);
+        }
+    }
+    else
+    {
+        result = LogErrorWithEnum(AwaError_OperationInvalid, "Operation is NULL");
+    }
+    return result;
+}
+
+AwaError ServerReadOperation_NewRequest(const AwaServerReadOperation * operation, IPCMessage ** request)
+{
+    AwaError result = AwaError_Unspecified;
+
+    if (operation != NULL)
+    {
+        const AwaServerSession * session = ServerOperation_GetSession(operation->ServerOperation);
+        if (session != NULL)
+        {
+            if (ServerSession_IsConnected(session))
             {
-                if (ServerSession_IsConnected(session))
+                TreeNode clientsTree = ServerOperation_GetClientsTree(operation->ServerOperation);
+                if (clientsTree != NULL)
                 {
-                    TreeNode clientsTree = ServerOperation_GetClientsTree(operation->ServerOperation);
-                    if (clientsTree != NULL)
+                    if (TreeNode_GetChildCount(clientsTree) > 0)
                     {
-                        if (TreeNode_GetChildCount(clientsTree) > 0)
+                        // build an IPC message and inject our content into it
+                        *request = IPCMessage_NewPlus(IPC_MESSAGE_TYPE_REQUEST, IPC_MESSAGE_SUB_TYPE_READ, ServerOperation_GetSessionID(operation->ServerOperation));
+                        IPCMessage_AddContent(*request, clientsTree);
+                        if (operation->FanOutWindow > 0)
                         {
-                            // build an IPC message and inject our content into it
-                            IPCMessage * request = IPCMessage_NewPlus(IPC_MESSAGE_TYPE_REQUEST, IPC_MESSAGE_SUB_TYPE_READ, ServerOperation_GetSessionID(operation->ServerOperation));
-                            IPCMessage_AddContent(request, clientsTree);
-
-                            // Send via IPC
-                            IPCMessage * response = NULL;
-                            result = IPC_SendAndReceive(ServerSession_GetChannel(session), request, &response, timeout);
-
-                            // Process the response
-                            if (result == AwaError_Success)
-                            {
-                                IPCResponseCode responseCode = IPCMessage_GetResponseCode(response);
-                                if (responseCode == IPCResponseCode_Success)
-                                {
-                                    // Free an old Read response record if it exists
-                                    if (operation->Response != NULL)
-                                    {
-                                        ServerResponse_Free(&operation->Response);
-                                    }
-
-                                    // Detach the response's content and add it to the Server Response
-                                    TreeNode contentNode = IPCMessage_GetContentNode(response);
-                                    TreeNode clientsNode = Xml_Find(contentNode, "Clients");
-                                    operation->Response = ServerResponse_NewFromServerOperation(operation->ServerOperation, clientsNode);
-
-                                    LogDebug("Perform Read Operation successful");
-
-                                    result = ServerResponse_CheckForErrors(operation->Response);
-                                }
-                                else if (responseCode == IPCResponseCode_FailureBadRequest)
-                                {
-                                    result = LogErrorWithEnum(AwaError_IPCError, "Unable to perform Read operation: Bad Request");
-                                }
-                                else
-                                {
-                                    result = LogErrorWithEnum(AwaError_IPCError, "Unexpected IPC response code: %d", responseCode);
-                                }
-                            }
-                            // Free allocated memory
-                            IPCMessage_Free(&request);
-                            IPCMessage_Free(&response);
-                        }
-                        else
-                        {
-                            result = LogErrorWithEnum(AwaError_OperationInvalid, "No paths specified");
+                            TreeNode fanOutNode = Xml_CreateNode(IPC_MESSAGE_TAG_FAN_OUT);
+                            TreeNode_AddChild(fanOutNode, Xml_CreateNodeWithValue("Window", "%zu", operation->FanOutWindow));
+                            IPCMessage_AddContent(*request, fanOutNode);
+                            Tree_Delete(fanOutNode);
                         }
+                        result = AwaError_Success;
                     }
                     else
                     {
-                        result = LogErrorWithEnum(AwaError_Internal, "objectsTree is NULL");
+                        result = LogErrorWithEnum(AwaError_OperationInvalid, "No paths specified");
                     }
                 }
                 else
                 {
-                    result = LogErrorWithEnum(AwaError_SessionNotConnected, "session is not connected");
+                    result = LogErrorWithEnum(AwaError_Internal, "objectsTree is NULL");
                 }
             }
             else
             {
-                result = LogErrorWithEnum(AwaError_SessionInvalid, "session is NULL");
+                result = LogErrorWithEnum(AwaError_SessionNotConnected, "session is not connected");
             }
         }
         else
         {
-            result = LogErrorWithEnum(AwaError_OperationInvalid, "Operation is NULL");
+            result = LogErrorWithEnum(AwaError_SessionInvalid, "session is NULL");
+        }
+    }
+    else
+    {
+        result = LogErrorWithEnum(AwaError_OperationInvalid, "Operation is NULL");
+    }
+    return result;
+}
+
+AwaError ServerReadOperation_ProcessResponse(AwaServerReadOperation * operation, IPCMessage * response)
+{
+    AwaError result = AwaError_Unspecified;
+
+    IPCResponseCode responseCode = IPCMessage_GetResponseCode(response);
+    if (responseCode == IPCResponseCode_Success)
+    {
+        // Free an old Read response record if it exists
+        if (operation->Response != NULL)
+        {
+            ServerResponse_Free(&operation->Response);
+        }
+
+        // Detach the response's content and add it to the Server Response
+        TreeNode contentNode = IPCMessage_GetContentNode(response);
+        TreeNode clientsNode = Xml_Find(contentNode, "Clients");
+        operation->Response = ServerResponse_NewFromServerOperation(operation->ServerOperation, clientsNode);
+
+        LogDebug("Perform Read Operation successful");
+
+        result = ServerResponse_CheckForErrors(operation->Response);
+    }
+    else if (responseCode == IPCResponseCode_FailureBadRequest)
+    {
+        result = LogErrorWithEnum(AwaError_IPCError, "Unable to perform Read operation: Bad Request");
+    }
+    else
+    {
+        result = LogErrorWithEnum(AwaError_IPCError, "Unexpected IPC response code: %d", responseCode);
+    }
+    return result;
+}
+
+static AwaError ServerReadOperation_AsyncResponseHandler(void * operation, IPCMessage * response)
+{
+    return ServerReadOperation_ProcessResponse((AwaServerReadOperation *)operation, response);
+}
+
+AwaError AwaServerReadOperation_Perform(AwaServerReadOperation * operation, AwaTimeout timeout)
+{
+    AwaError result = AwaError_Unspecified;
+
+    if (timeout >= 0)
+    {
+        IPCMessage * request = NULL;
+        result = ServerReadOperation_NewRequest(operation, &request);
+        if (result == AwaError_Success)
+        {
+            // Send via IPC
+            IPCMessage * response = NULL;
+            const AwaServerSession * session = ServerOperation_GetSession(operation->ServerOperation);
+            result = IPC_SendAndReceive(ServerSession_GetChannel(session), request, &response, timeout);
+
+            // Process the response
+            if (result == AwaError_Success)
+            {
+                result = ServerReadOperation_ProcessResponse(operation, response);
+            }
+
+            // Free allocated memory
+            IPCMessage_Free(&request);
+            IPCMessage_Free(&response);
+        }
+    }
+    else
+    {
+        result = LogErrorWithEnum(AwaError_OperationInvalid, "Invalid timeout specified");
+    }
+    return result;
+}
+
+AwaError AwaServerReadOperation_PerformAsync(AwaServerReadOperation * operation, AwaTimeout timeout,
+                                            AwaOperationCompleteCallback callback, void * context, AwaRequestID * requestID)
+{
+    AwaError result = AwaError_Unspecified;
+
+    if (timeout >= 0)
+    {
+        IPCMessage * request = NULL;
+        result = ServerReadOperation_NewRequest(operation, &request);
+        if (result == AwaError_Success)
+        {
+            const AwaServerSession * session = ServerOperation_GetSession(operation->ServerOperation);
+            result = SessionCommon_SendAsyncRequest(ServerSession_GetSessionCommon(session), request, timeout,
+                                                    ServerReadOperation_AsyncResponseHandler, operation, callback, context, requestID);
+            IPCMessage_Free(&request);
         }
     }
     else
@@ -240,6 +323,35 @@ const AwaServerReadResponse * AwaServerReadOperation_GetResponse(const AwaServer
     return (const AwaServerReadResponse *)response;
 }
 
+AwaError AwaServerReadOperation_SetFanOutWindow(AwaServerReadOperation * operation, size_t window)
+{
+    AwaError result = AwaError_Unspecified;
+    if (operation != NULL)
+    {
+        operation->FanOutWindow = window;
+        result = AwaError_Success;
+    }
+    else
+    {
+        result = LogErrorWithEnum(AwaError_OperationInvalid, "operation is NULL");
+    }
+    return result;
+}
+
+AwaError AwaServerReadOperation_GetClientLatency(const AwaServerReadOperation * operation, const char * clientID, AwaInteger * latency)
+{
+    AwaError result = AwaError_Unspecified;
+    if (operation != NULL)
+    {
+        result = ServerResponse_GetClientLatency(operation->Response, clientID, latency);
+    }
+    else
+    {
+        result = LogErrorWithEnum(AwaError_OperationInvalid, "operation is NULL");
+    }
+    return result;
+}
+
 AwaPathIterator * AwaServerReadResponse_NewPathIterator(const AwaServerReadResponse * response)
 {
     // AwaServerReadResponse is an alias for ResponseCommon
@@ -268,6 +380,70 @@ bool AwaServerReadResponse_HasValue(const AwaServerReadResponse * response, cons
     return ResponseCommon_HasValue((const ResponseCommon *)response, path);
 }
 
+bool AwaServerReadResponse_HasValueByID(const AwaServerReadResponse * response, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID)
+{
+    PathKey key;
+    // AwaServerReadResponse is an alias for ResponseCommon
+    return PathKey_Make(&key, objectID, objectInstanceID, resourceID) && ResponseCommon_HasValueByKey((const ResponseCommon *)response, &key);
+}
+
+static AwaError GetValuePointerByID(const AwaServerReadResponse * response, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID,
+                                   const void ** value, AwaResourceType resourceType, int resourceSize, bool withNull)
+{
+    AwaError result = AwaError_Unspecified;
+    PathKey key;
+    if (PathKey_Make(&key, objectID, objectInstanceID, resourceID))
+    {
+        // AwaServerReadResponse is an alias for ResponseCommon
+        result = withNull ? ResponseCommon_GetValuePointerWithNullByKey((const ResponseCommon *)response, &key, value, NULL, resourceType, resourceSize)
+                          : ResponseCommon_GetValuePointerByKey((const ResponseCommon *)response, &key, value, NULL, resourceType, resourceSize);
+    }
+    else
+    {
+        if (value != NULL)
+        {
+            *value = NULL;
+        }
+        result = LogErrorWithEnum(AwaError_PathInvalid, "IDs %d/%d/%d do not identify a resource", objectID, objectInstanceID, resourceID);
+    }
+    return result;
+}
+
+AwaError AwaServerReadResponse_GetValueAsCStringPointerByID(const AwaServerReadResponse * response, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, const char ** value)
+{
+    return GetValuePointerByID(response, objectID, objectInstanceID, resourceID, (const void **)value, AwaResourceType_String, -1, true);
+}
+
+AwaError AwaServerReadResponse_GetValueAsIntegerPointerByID(const AwaServerReadResponse * response, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, const AwaInteger ** value)
+{
+    return GetValuePointerByID(response, objectID, objectInstanceID, resourceID, (const void **)value, AwaResourceType_Integer, sizeof(AwaInteger), false);
+}
+
+AwaError AwaServerReadResponse_GetValueAsFloatPointerByID(const AwaServerReadResponse * response, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, const AwaFloat ** value)
+{
+    return GetValuePointerByID(response, objectID, objectInstanceID, resourceID, (const void **)value, AwaResourceType_Float, sizeof(AwaFloat), false);
+}
+
+AwaError AwaServerReadResponse_GetValueAsBooleanPointerByID(const AwaServerReadResponse * response, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, const AwaBoolean ** value)
+{
+    return GetValuePointerByID(response, objectID, objectInstanceID, resourceID, (const void **)value, AwaResourceType_Boolean, sizeof(AwaBoolean), false);
+}
+
+AwaError AwaServerReadResponse_GetValueAsTimePointerByID(const AwaServerReadResponse * response, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, const AwaTime ** value)
+{
+    return GetValuePointerByID(response, objectID, objectInstanceID, resourceID, (const void **)value, AwaResourceType_Time, sizeof(AwaTime), false);
+}
+
+AwaError AwaServerReadResponse_GetValueAsObjectLinkPointerByID(const AwaServerReadResponse * response, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, const AwaObjectLink ** value)
+{
+    return GetValuePointerByID(response, objectID, objectInstanceID, resourceID, (const void **)value, AwaResourceType_ObjectLink, sizeof(AwaObjectLink), false);
+}
+
+AwaError AwaServerReadResponse_GetValueAsOpaquePointerByID(const AwaServerReadResponse * response, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, const AwaOpaque ** value)
+{
+    return GetValuePointerByID(response, objectID, objectInstanceID, resourceID, (const void **)value, AwaResourceType_Opaque, sizeof(AwaOpaque), false);
+}
+
 AwaError AwaServerReadResponse_GetValueAsCStringPointer(const AwaServerReadResponse * response, const char * path, const char ** value)
 {
     // AwaServerReadResponse is an alias for ResponseCommon
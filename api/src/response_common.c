@@ -31,23 +31,91 @@
 #include "log.h"
 #include "memalloc.h"
 #include "arrays.h"
-#include "map.h"
+#include "lwm2m_list.h"
+#include "lwm2m_hash.h"
 #include "objects_tree.h"
 #include "path_result.h"
 #include "path_iterator.h"
 #include "value.h"
 #include "utils.h"
 
+// Most responses hold a handful of paths; the index doubles as it fills.
+#define RESPONSE_INITIAL_BUCKETS (8)
+
+// Everything the response knows about one path, found with a single lookup by key.
+typedef struct
+{
+    struct ListHead List;       // All entries, in the order they were added
+    HashEntry Index;
+    PathKey Key;
+    Value * Value;
+    PathResult * PathResult;
+    char * NulledValue;         // NUL-terminated copy of Value, made on request
+
+} ResponseEntry;
+
 struct _ResponseCommon
 {
     const OperationCommon * OperationCommon;   // pointer to parent operation
     TreeNode ObjectsNode;
 
-    MapType * Values;
-    MapType * PathResults;
-    MapType * NulledValues;
+    struct ListHead Entries;
+    HashTable Index;            // ResponseEntry, keyed by PathKey
 };
 
+static ResponseCommon * AllocateResponse(const OperationCommon * operation, TreeNode objectsNode)
+{
+    ResponseCommon * response = Awa_MemAlloc(sizeof(*response));
+    if (response != NULL)
+    {
+        memset(response, 0, sizeof(*response));
+        ListInit(&response->Entries);
+        if (HashTable_Init(&response->Index, RESPONSE_INITIAL_BUCKETS) == 0)
+        {
+            response->OperationCommon = operation;
+            response->ObjectsNode = Tree_Copy(objectsNode);
+        }
+        else
+        {
+            Awa_MemSafeFree(response);
+            response = NULL;
+        }
+    }
+    return response;
+}
+
+static ResponseEntry * FindEntry(const ResponseCommon * response, const PathKey * key)
+{
+    uint32_t hash = PathKey_Hash(key);
+    struct ListHead * current;
+    ListForEach(current, HashTable_GetBucket(&response->Index, hash))
+    {
+        HashEntry * hashEntry = ListEntry(current, HashEntry, list);
+        ResponseEntry * entry = ListEntry(hashEntry, ResponseEntry, Index);
+        if ((hashEntry->Hash == hash) && PathKey_Equals(&entry->Key, key))
+        {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static ResponseEntry * FindOrAddEntry(ResponseCommon * response, const PathKey * key)
+{
+    ResponseEntry * entry = FindEntry(response, key);
+    if (entry == NULL)
+    {
+        entry = Awa_MemCalloc(1, sizeof(*entry));
+        if (entry != NULL)
+        {
+            entry->Key = *key;
+            ListAdd(&entry->List, &response->Entries);
+            HashTable_Add(&response->Index, &entry->Index, PathKey_Hash(key));
+        }
+    }
+    return entry;
+}
+
 ResponseCommon * ResponseCommon_New(const OperationCommon * operation, TreeNode objectsNode)
 {
     ResponseCommon * response = NULL;
@@ -56,13 +124,9 @@ ResponseCommon * ResponseCommon_New(const OperationCommon * operation, TreeNode
     {
         if (objectsNode != NULL)
         {
-            response = Awa_MemAlloc(sizeof(*response));
+            response = AllocateResponse(operation, objectsNode);
             if (response != NULL)
             {
-                memset(response, 0, sizeof(*response));
-                response->OperationCommon = operation;
-                response->ObjectsNode = Tree_Copy(objectsNode);
-
                 // build the Values data structure
                 if (ResponseCommon_BuildValues(response) == AwaError_Success)
                 {
@@ -84,8 +148,6 @@ ResponseCommon * ResponseCommon_New(const OperationCommon * operation, TreeNode
                     LogErrorWithEnum(AwaError_ResponseInvalid, "Failed to build path results - continuing");
                 }
 
-                response->NulledValues = Map_New();
-
                 LogNew("ResponseCommon", response);
 
             }
@@ -116,12 +178,9 @@ ResponseCommon * ResponseCommon_NewClient(const OperationCommon * operation, Tre
     {
         if (objectsNode != NULL)
         {
-            response = Awa_MemAlloc(sizeof(*response));
+            response = AllocateResponse(operation, objectsNode);
             if (response != NULL)
             {
-                memset(response, 0, sizeof(*response));
-                response->OperationCommon = operation;
-                response->ObjectsNode = Tree_Copy(objectsNode);
                 LogNew("ResponseCommon", response);
             }
             else
@@ -141,27 +200,19 @@ ResponseCommon * ResponseCommon_NewClient(const OperationCommon * operation, Tre
     return response;
 }
 
-static void FreeSimpleMap(MapType ** map)
+static void FreeEntries(ResponseCommon * response)
 {
-    if ((map != NULL) && (*map != NULL))
+    struct ListHead * current, * next;
+    ListForEachSafe(current, next, &response->Entries)
     {
-        Map_FreeValues(*map);
-        Map_Free(map);
-    }
-}
-
-static void FreeValue(const char * key, void * value, void * context)
-{
-    Value_Free((Value **)(&value));
-}
-
-static void FreeValues(MapType ** valuesMap)
-{
-    if ((valuesMap != NULL) && (*valuesMap != NULL))
-    {
-        Map_ForEach(*valuesMap, FreeValue, NULL);
-        Map_Free(valuesMap);
+        ResponseEntry * entry = ListEntry(current, ResponseEntry, List);
+        Value_Free(&entry->Value);
+        PathResult_Free(&entry->PathResult);
+        Awa_MemSafeFree(entry->NulledValue);
+        Awa_MemSafeFree(entry);
     }
+    ListInit(&response->Entries);
+    HashTable_Destroy(&response->Index);
 }
 
 AwaError ResponseCommon_Free(ResponseCommon ** response)
@@ -170,9 +221,7 @@ AwaError ResponseCommon_Free(ResponseCommon ** response)
     if ((response != NULL) && (*response != NULL))
     {
         LogFree("ResponseCommon", *response);
-        FreeSimpleMap(&((*response)->PathResults));
-        FreeSimpleMap(&((*response)->NulledValues));
-        FreeValues(&((*response)->Values));
+        FreeEntries(*response);
         Tree_Delete((*response)->ObjectsNode);
         Awa_MemSafeFree(*response);
         *response = NULL;
@@ -268,79 +317,83 @@ AwaError ResponseCommon_BuildValues(ResponseCommon * response)
     AwaError result = AwaError_Success;  // success if no values are found
     if (response != NULL)
     {
-        FreeValues(&response->Values);
-        response->Values = Map_New();
-        if (response->Values != NULL)
+        struct ListHead * current;
+        ListForEach(current, &response->Entries)
         {
-            // get the resource type for the path
-            const OperationCommon * operation = ResponseCommon_GetOperation(response);
-            if (operation != NULL)
+            ResponseEntry * entry = ListEntry(current, ResponseEntry, List);
+            Value_Free(&entry->Value);
+        }
+
+        // get the resource type for the path
+        const OperationCommon * operation = ResponseCommon_GetOperation(response);
+        if (operation != NULL)
+        {
+            const SessionCommon * sessionCommon = OperationCommon_GetSessionCommon(operation);
+            if (sessionCommon != NULL)
             {
-                const SessionCommon * sessionCommon = OperationCommon_GetSessionCommon(operation);
-                if (sessionCommon != NULL)
+                TreeNode currentNode = response->ObjectsNode;
+                while ((currentNode = ObjectsTree_GetNextLeafNode(currentNode)) != NULL)
                 {
-                    TreeNode currentNode = response->ObjectsNode;
-                    while ((currentNode = ObjectsTree_GetNextLeafNode(currentNode)) != NULL)
+                    PathKey key;
+                    if (ObjectsTree_GetPathKey(currentNode, &key) && PathKey_IsResource(&key))
                     {
+                        const AwaResourceDefinition * resourceDefinition = SessionCommon_GetResourceDefinitionFromIDs(sessionCommon,
+                                PathKey_GetObjectID(&key), PathKey_GetResourceID(&key));
                         char path[MAX_PATH_LENGTH] = { 0 };
-                        ObjectsTree_GetPath(currentNode, path, sizeof(path));
-
-                        if (Path_IsValidForResource(path))
+                        if (resourceDefinition != NULL)
                         {
-                            LogDebug("Build values path: %s", path);
-
-                            const AwaResourceDefinition * resourceDefinition = SessionCommon_GetResourceDefinitionFromPath(sessionCommon, path);
-                            if (resourceDefinition != NULL)
+                            AwaResourceType resourceType = AwaResourceDefinition_GetType(resourceDefinition);
+                            if (resourceType != AwaResourceType_Invalid)
                             {
-                                AwaResourceType resourceType = AwaResourceDefinition_GetType(resourceDefinition);
-                                if (resourceType != AwaResourceType_Invalid)
-                                {
-                                    Value * value = Value_New(currentNode, resourceType);
+                                Value * value = Value_New(currentNode, resourceType);
 
-                                    if (value != NULL)
+                                if (value != NULL)
+                                {
+                                    ResponseEntry * entry = FindOrAddEntry(response, &key);
+                                    if (entry == NULL)
                                     {
-                                        if (!Map_Contains(response->Values, path))
-                                        {
-                                            LogDebug("MAP item path: %s", path);
-                                            Map_Put(response->Values, path, value);
-                                            result = AwaError_Success;
-                                        }
-                                        else
-                                        {
-                                            result = LogErrorWithEnum(AwaError_Internal, "A value already exists for %s", path);
-                                        }
+                                        Value_Free(&value);
+                                        result = LogErrorWithEnum(AwaError_OutOfMemory);
+                                    }
+                                    else if (entry->Value == NULL)
+                                    {
+                                        entry->Value = value;
+                                        result = AwaError_Success;
                                     }
                                     else
                                     {
-                                        // No value is fine - occurs in operations where we only expect path results in the response.
+                                        Value_Free(&value);
+                                        PathKey_Format(&key, path, sizeof(path));
+                                        result = LogErrorWithEnum(AwaError_Internal, "A value already exists for %s", path);
                                     }
-
                                 }
                                 else
                                 {
-                                    result = LogErrorWithEnum(AwaError_DefinitionInvalid, "resourceDefinition for %s has invalid type", path);
+                                    // No value is fine - occurs in operations where we only expect path results in the response.
                                 }
                             }
                             else
                             {
-                                result = LogErrorWithEnum(AwaError_DefinitionInvalid, "resourceDefinition for %s is NULL", path);
+                                PathKey_Format(&key, path, sizeof(path));
+                                result = LogErrorWithEnum(AwaError_DefinitionInvalid, "resourceDefinition for %s has invalid type", path);
                             }
                         }
+                        else
+                        {
+                            PathKey_Format(&key, path, sizeof(path));
+                            result = LogErrorWithEnum(AwaError_DefinitionInvalid, "resourceDefinition for %s is NULL", path);
+                        }
                     }
                 }
-                else
-                {
-                    result = LogErrorWithEnum(AwaError_SessionInvalid, "session is NULL");
-                }
             }
             else
             {
-                result = LogErrorWithEnum(AwaError_OperationInvalid, "operation is NULL");
+                result = LogErrorWithEnum(AwaError_SessionInvalid, "session is NULL");
             }
         }
         else
         {
-            result = LogErrorWithEnum(AwaError_OutOfMemory);
+            result = LogErrorWithEnum(AwaError_OperationInvalid, "operation is NULL");
         }
     }
     else
@@ -350,64 +403,89 @@ AwaError ResponseCommon_BuildValues(ResponseCommon * response)
     return result;
 }
 
+static bool IsAncestorOf(TreeNode node, TreeNode descendant)
+{
+    TreeNode parent = (descendant != NULL) ? TreeNode_GetParent(descendant) : NULL;
+    while ((parent != NULL) && (parent != node))
+    {
+        parent = TreeNode_GetParent(parent);
+    }
+    return parent != NULL;
+}
+
 AwaError ResponseCommon_BuildPathResults(ResponseCommon * response)
 {
     AwaError result = AwaError_Success;  // success if no path results are found
     if (response != NULL)
     {
-        FreeSimpleMap(&response->PathResults);
-        response->PathResults = Map_New();
-        if (response->PathResults != NULL)
+        struct ListHead * current;
+        ListForEach(current, &response->Entries)
+        {
+            ResponseEntry * entry = ListEntry(current, ResponseEntry, List);
+            PathResult_Free(&entry->PathResult);
+        }
+
+        TreeNode previousLeafNode = NULL;
+        TreeNode currentLeafNode = response->ObjectsNode;
+        while ((currentLeafNode = ObjectsTree_GetNextLeafNode(currentLeafNode)) != NULL)
         {
-            TreeNode currentLeafNode = response->ObjectsNode;
-            while ((currentLeafNode = ObjectsTree_GetNextLeafNode(currentLeafNode)) != NULL)
+            TreeNode currentNode = currentLeafNode;  // start at leaf and add path results for parents as well
+            while (currentNode != NULL)
             {
-                TreeNode currentNode = currentLeafNode;  // start at leaf and add path results for parents as well
-                while (currentNode != NULL)
+                // Leaves are visited in order, so a parent shared with the previous leaf has already been
+                // handled, along with all of its own parents. Searching it again would make this quadratic.
+                if ((currentNode != currentLeafNode) && IsAncestorOf(currentNode, previousLeafNode))
                 {
-                    char path[MAX_PATH_LENGTH] = { 0 };
-                    ObjectsTree_GetPath(currentNode, path, sizeof(path));
+                    break;
+                }
 
-                    TreeNode resultNode = Xml_Find(currentNode, "Result");
-                    if (resultNode != NULL)
+                TreeNode resultNode = Xml_Find(currentNode, "Result");
+                PathKey key;
+                if ((resultNode != NULL) && ObjectsTree_GetPathKey(currentNode, &key))
+                {
+                    char path[MAX_PATH_LENGTH] = { 0 };
+                    PathResult * pathResult = PathResult_New(resultNode);
+                    if (pathResult != NULL)
                     {
-                        PathResult * pathResult = PathResult_New(resultNode);
-                        if (pathResult != NULL)
+                        ResponseEntry * entry = FindOrAddEntry(response, &key);
+                        if (entry == NULL)
                         {
-                            if (!Map_Contains(response->PathResults, path))
-                            {
-                                Map_Put(response->PathResults, path, pathResult);
-                                result = AwaError_Success;
-                            }
-                            else if (currentNode == currentLeafNode)
-                            {
-                                PathResult_Free(&pathResult);
-                                result = LogErrorWithEnum(AwaError_Internal, "A pathResult already exists for %s\n", path);
-                                goto error;
-                            }
-                            else
-                            {
-                                // Already added parent node
-                                PathResult_Free(&pathResult);
-                            }
+                            PathResult_Free(&pathResult);
+                            result = LogErrorWithEnum(AwaError_OutOfMemory);
+                            goto error;
                         }
-                        else
+                        else if (entry->PathResult == NULL)
+                        {
+                            entry->PathResult = pathResult;
+                            result = AwaError_Success;
+                        }
+                        else if (currentNode == currentLeafNode)
                         {
-                            result = LogErrorWithEnum(AwaError_Internal, "Could not create pathResult for %s", path);
+                            PathResult_Free(&pathResult);
+                            PathKey_Format(&key, path, sizeof(path));
+                            result = LogErrorWithEnum(AwaError_Internal, "A pathResult already exists for %s\n", path);
                             goto error;
                         }
+                        else
+                        {
+                            // Already added parent node
+                            PathResult_Free(&pathResult);
+                        }
                     }
                     else
                     {
-                        // not all leaves or responses have PathResults, so skip
+                        PathKey_Format(&key, path, sizeof(path));
+                        result = LogErrorWithEnum(AwaError_Internal, "Could not create pathResult for %s", path);
+                        goto error;
                     }
-                    currentNode = ObjectsTree_IsObjectNode(currentNode)? NULL : TreeNode_GetParent(currentNode);
                 }
+                else
+                {
+                    // not all leaves or responses have PathResults, so skip
+                }
+                currentNode = ObjectsTree_IsObjectNode(currentNode)? NULL : TreeNode_GetParent(currentNode);
             }
-        }
-        else
-        {
-            result = LogErrorWithEnum(AwaError_OutOfMemory);
+            previousLeafNode = currentLeafNode;
         }
     }
     else
@@ -419,14 +497,22 @@ error:
 }
 
 bool ResponseCommon_HasValue(const ResponseCommon * response, const char * path)
+{
+    PathKey key;
+    return (path != NULL) && PathKey_Parse(&key, path) && ResponseCommon_HasValueByKey(response, &key);
+}
+
+bool ResponseCommon_HasValueByKey(const ResponseCommon * response, const PathKey * key)
 {
     bool hasValue = false;
-    if ((response != NULL) && (path != NULL))
+    if ((response != NULL) && (key != NULL))
     {
-        hasValue = Map_Contains(response->Values, path);
+        const ResponseEntry * entry = FindEntry(response, key);
+        hasValue = (entry != NULL) && (entry->Value != NULL);
     }
     return hasValue;
 }
+
 bool ResponseCommon_ContainsPath(const ResponseCommon * response, const char * path)
 {
     bool containsPath = false;
@@ -447,12 +533,54 @@ AwaError ResponseCommon_GetPathResult(const ResponseCommon * response, const cha
         {
             if (result)
             {
-                if (Map_Get(response->PathResults, path, (void**)result))
+                PathKey key;
+                if (PathKey_Parse(&key, path))
                 {
+                    error = ResponseCommon_GetPathResultByKey(response, &key, result);
+                }
+                else
+                {
+                    *result = NULL;
+                    error = LogErrorWithEnum(AwaError_PathNotFound, "path %s not found", path);
+                }
+            }
+            else
+            {
+                error = LogErrorWithEnum(AwaError_Internal, "Result is null");
+            }
+        }
+        else
+        {
+            error = LogErrorWithEnum(AwaError_PathInvalid, "Path is null");
+        }
+    }
+    else
+    {
+        error = LogErrorWithEnum(AwaError_ResponseInvalid, "Response is null");
+    }
+    return error;
+}
+
+AwaError ResponseCommon_GetPathResultByKey(const ResponseCommon * response, const PathKey * key, const PathResult ** result)
+{
+    AwaError error = AwaError_Unspecified;
+
+    if (response != NULL)
+    {
+        if (key != NULL)
+        {
+            if (result)
+            {
+                const ResponseEntry * entry = FindEntry(response, key);
+                if ((entry != NULL) && (entry->PathResult != NULL))
+                {
+                    *result = entry->PathResult;
                     error = AwaError_Success;
                 }
                 else
                 {
+                    char path[MAX_PATH_LENGTH] = { 0 };
+                    PathKey_Format(key, path, sizeof(path));
                     *result = NULL;
                     error = LogErrorWithEnum(AwaError_PathNotFound, "path %s not found", path);
                 }
@@ -524,33 +652,21 @@ error:
     return NULL;
 }
 
-static const Value * ResponseCommon_GetValue(const ResponseCommon * response, const char * path)
-{
-    const Value * storedValue = NULL;
-    if (Map_Get(response->Values, path, (void **)&storedValue))
-    {
-        // success
-    }
-    else
-    {
-        LogErrorWithEnum(AwaError_PathNotFound, "path %s not found", path);
-    }
-    return storedValue;
-}
-
-AwaError GetValuePointer(const ResponseCommon * response, const char * path, const void ** value, size_t * valueSize, AwaResourceType resourceType, int resourceSize, bool withNull)
+static AwaError GetValuePointerByKey(const ResponseCommon * response, const PathKey * key, const void ** value, size_t * valueSize, AwaResourceType resourceType, int resourceSize, bool withNull)
 {
     AwaError result = AwaError_Unspecified;
+    char path[MAX_PATH_LENGTH] = { 0 };
     if (value != NULL)
     {
         *value = NULL;
-        if (path != NULL)
+        if (key != NULL)
         {
-            if (Path_IsValidForResource(path))
+            if (PathKey_IsResource(key))
             {
                 if (response != NULL)
                 {
-                    const Value * storedValue = ResponseCommon_GetValue(response, path);
+                    ResponseEntry * entry = FindEntry(response, key);
+                    const Value * storedValue = (entry != NULL) ? entry->Value : NULL;
                     if (storedValue != NULL)
                     {
                         AwaResourceType type = Value_GetType(storedValue);
@@ -567,20 +683,24 @@ AwaError GetValuePointer(const ResponseCommon * response, const char * path, con
                             {
                                 if (withNull)
                                 {
-                                    char * nulledValue = (char *)malloc(length+1);
+                                    // the stored value does not change, so one copy serves every caller
+                                    if (entry->NulledValue == NULL)
+                                    {
+                                        entry->NulledValue = (char *)Awa_MemAlloc(length + 1);
+                                        if (entry->NulledValue != NULL)
+                                        {
+                                            memcpy(entry->NulledValue, data, length);
+                                            entry->NulledValue[length] = '\0';
+                                        }
+                                    }
 
-                                    if ((nulledValue != NULL))
+                                    if (entry->NulledValue != NULL)
                                     {
-                                        memcpy(nulledValue, data, length);
-                                        nulledValue[length] = '\0';
                                         if (valueSize != NULL)
                                         {
                                             *valueSize = length + 1;
                                         }
-
-                                        Map_Put(response->NulledValues, path, nulledValue);
-
-                                        *value = nulledValue;
+                                        *value = entry->NulledValue;
                                         result = AwaError_Success;
                                     }
                                     else
@@ -602,12 +722,14 @@ AwaError GetValuePointer(const ResponseCommon * response, const char * path, con
                         }
                         else
                         {
+                            PathKey_Format(key, path, sizeof(path));
                             result = LogErrorWithEnum(AwaError_TypeMismatch, "Resource %s is not of type %s", path, Utils_ResourceTypeToString(resourceType));
                         }
                     }
                     else
                     {
                         // no value stored for this path
+                        PathKey_Format(key, path, sizeof(path));
                         result = LogErrorWithEnum(AwaError_PathNotFound, "No value for path %s", path);
                     }
                 }
@@ -618,6 +740,7 @@ AwaError GetValuePointer(const ResponseCommon * response, const char * path, con
             }
             else
             {
+                PathKey_Format(key, path, sizeof(path));
                 result = LogErrorWithEnum(AwaError_PathInvalid, "%s is not a resource path", path);
             }
         }
@@ -633,18 +756,56 @@ AwaError GetValuePointer(const ResponseCommon * response, const char * path, con
     return result;
 }
 
+static AwaError GetValuePointer(const ResponseCommon * response, const char * path, const void ** value, size_t * valueSize, AwaResourceType resourceType, int resourceSize, bool withNull)
+{
+    AwaError result = AwaError_Unspecified;
+    if (value != NULL)
+    {
+        *value = NULL;
+        if (path != NULL)
+        {
+            PathKey key;
+            if (PathKey_Parse(&key, path) && PathKey_IsResource(&key))
+            {
+                result = GetValuePointerByKey(response, &key, value, valueSize, resourceType, resourceSize, withNull);
+            }
+            else
+            {
+                result = LogErrorWithEnum(AwaError_PathInvalid, "%s is not a resource path", path);
+            }
+        }
+        else
+        {
+            result = LogErrorWithEnum(AwaError_PathInvalid, "No path specified");
+        }
+    }
+    else
+    {
+        result = LogErrorWithEnum(AwaError_OperationInvalid, "Value is null");
+    }
+    return result;
+}
 
 AwaError ResponseCommon_GetValuePointer(const ResponseCommon * response, const char * path, const void ** value, size_t * valueSize, AwaResourceType resourceType, int resourceSize)
 {
     return GetValuePointer(response, path, value, valueSize, resourceType, resourceSize, false);
 }
 
-
 AwaError ResponseCommon_GetValuePointerWithNull(const ResponseCommon * response, const char * path, const void ** value, size_t * valueSize, AwaResourceType resourceType, int resourceSize)
 {
     return GetValuePointer(response, path, value, valueSize, resourceType, resourceSize, true);
 }
 
+AwaError ResponseCommon_GetValuePointerByKey(const ResponseCommon * response, const PathKey * key, const void ** value, size_t * valueSize, AwaResourceType resourceType, int resourceSize)
+{
+    return GetValuePointerByKey(response, key, value, valueSize, resourceType, resourceSize, false);
+}
+
+AwaError ResponseCommon_GetValuePointerWithNullByKey(const ResponseCommon * response, const PathKey * key, const void ** value, size_t * valueSize, AwaResourceType resourceType, int resourceSize)
+{
+    return GetValuePointerByKey(response, key, value, valueSize, resourceType, resourceSize, true);
+}
+
 AwaError ResponseCommon_GetValueAsObjectLink(const ResponseCommon * response, const char * path, AwaObjectLink * value)
 {
     AwaObjectLink * storedObjectLink;
@@ -36,6 +36,7 @@
 #include "operation_common.h"
 #include "path_result.h"
 #include "path_iterator.h"
+#include "path.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -62,15 +63,19 @@ AwaError ResponseCommon_BuildValues(ResponseCommon * response);
 AwaError ResponseCommon_BuildPathResults(ResponseCommon * response);
 
 AwaError ResponseCommon_GetPathResult(const ResponseCommon * response, const char * path, const PathResult ** result);
+AwaError ResponseCommon_GetPathResultByKey(const ResponseCommon * response, const PathKey * key, const PathResult ** result);
 
 PathIterator * ResponseCommon_NewPathIterator(const ResponseCommon * response);
 
 AwaError ResponseCommon_GetValuePointer(const ResponseCommon * response, const char * path, const void ** value, size_t * valueSize, AwaResourceType resourceType, int resourceSize);
 AwaError ResponseCommon_GetValuePointerWithNull(const ResponseCommon * response, const char * path, const void ** value, size_t * valueSize, AwaResourceType resourceType, int resourceSize);
+AwaError ResponseCommon_GetValuePointerByKey(const ResponseCommon * response, const PathKey * key, const void ** value, size_t * valueSize, AwaResourceType resourceType, int resourceSize);
+AwaError ResponseCommon_GetValuePointerWithNullByKey(const ResponseCommon * response, const PathKey * key, const void ** value, size_t * valueSize, AwaResourceType resourceType, int resourceSize);
 AwaError ResponseCommon_GetValueAsObjectLink(const ResponseCommon * response, const char * path, AwaObjectLink * value);
 AwaError ResponseCommon_GetValueAsOpaque(const ResponseCommon * response, const char * path, AwaOpaque * value);
 
 bool ResponseCommon_HasValue(const ResponseCommon * response, const char * path);
+bool ResponseCommon_HasValueByKey(const ResponseCommon * response, const PathKey * key);
 bool ResponseCommon_ContainsPath(const ResponseCommon * response, const char * path);
 
 #ifdef __cplusplus
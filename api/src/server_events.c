@@ -38,6 +38,9 @@ struct _ServerEventsCallbackInfo
 
     AwaServerClientUpdateEventCallback ClientUpdateEventCallback;
     void * ClientUpdateEventContext;
+
+    AwaServerFanOutResultCallback FanOutResultCallback;
+    void * FanOutResultContext;
 };
 
 
@@ -570,6 +573,24 @@ int ServerEventsCallbackInfo_SetClientUpdateCallback(ServerEventsCallbackInfo *
     return result;
 }
 
+int ServerEventsCallbackInfo_SetFanOutResultCallback(ServerEventsCallbackInfo * info, AwaServerFanOutResultCallback callback, void * context)
+{
+    int result = -1;
+    if (info != NULL)
+    {
+        // callback may be NULL
+        info->FanOutResultCallback = callback;
+        info->FanOutResultContext = context;
+        result = 0;
+    }
+    else
+    {
+        LogError("info is NULL");
+        result = -1;
+    }
+    return result;
+}
+
 int ServerEventsCallbackInfo_InvokeClientRegisterCallback(ServerEventsCallbackInfo * info, const ClientRegisterEvent * event)
 {
     int result = -1;
@@ -662,3 +683,34 @@ int ServerEventsCallbackInfo_InvokeClientUpdateCallback(ServerEventsCallbackInfo
     }
     return result;
 }
+
+int ServerEventsCallbackInfo_InvokeFanOutResultCallback(ServerEventsCallbackInfo * info, const char * clientID, AwaInteger latency, AwaError error)
+{
+    int result = -1;
+    if (info != NULL)
+    {
+        if (clientID != NULL)
+        {
+            if (info->FanOutResultCallback != NULL)
+            {
+                info->FanOutResultCallback(clientID, latency, error, info->FanOutResultContext);
+            }
+            else
+            {
+                LogDebug("No FanOutResultCallback set");
+            }
+            result = 0;
+        }
+        else
+        {
+            LogError("clientID is NULL");
+            result = -1;
+        }
+    }
+    else
+    {
+        LogError("info is NULL");
+        result = -1;
+    }
+    return result;
+}
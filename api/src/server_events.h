@@ -87,12 +87,16 @@ int ServerEventsCallbackInfo_SetClientDeregisterCallback(ServerEventsCallbackInf
 
 int ServerEventsCallbackInfo_SetClientUpdateCallback(ServerEventsCallbackInfo * info, AwaServerClientUpdateEventCallback callback, void * context);
 
+int ServerEventsCallbackInfo_SetFanOutResultCallback(ServerEventsCallbackInfo * info, AwaServerFanOutResultCallback callback, void * context);
+
 int ServerEventsCallbackInfo_InvokeClientRegisterCallback(ServerEventsCallbackInfo * info, const ClientRegisterEvent * event);
 
 int ServerEventsCallbackInfo_InvokeClientDeregisterCallback(ServerEventsCallbackInfo * info, const ClientDeregisterEvent * event);
 
 int ServerEventsCallbackInfo_InvokeClientUpdateCallback(ServerEventsCallbackInfo * info, const ClientUpdateEvent * event);
 
+int ServerEventsCallbackInfo_InvokeFanOutResultCallback(ServerEventsCallbackInfo * info, const char * clientID, AwaInteger latency, AwaError error);
+
 
 #ifdef __cplusplus
 }
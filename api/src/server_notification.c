@@ -37,6 +37,7 @@
 #include "xml.h"
 #include "observe_operation.h"
 #include "server_events.h"
+#include "lwm2m_xml_serdes.h"
 
 static AwaError HandleObserveNotification(AwaServerSession * session, IPCMessage * notification)
 {
@@ -182,6 +183,60 @@ static AwaError HandleClientUpdateNotification(AwaServerSession * session, IPCMe
     return result;
 }
 
+// Find the first error reported anywhere in a client's result tree
+static AwaError GetFirstResultError(TreeNode node)
+{
+    AwaError result = AwaError_Success;
+    if (strcmp(TreeNode_GetName(node), "Result") == 0)
+    {
+        const char * errorValue = (const char *)xmlif_GetOpaque(node, "Result/Error");
+        if (errorValue != NULL)
+        {
+            result = AwaError_FromString(errorValue);
+        }
+    }
+
+    uint32_t index;
+    TreeNode child;
+    for (index = 0; (result == AwaError_Success) && ((child = TreeNode_GetChild(node, index)) != NULL); index++)
+    {
+        result = GetFirstResultError(child);
+    }
+    return result;
+}
+
+static AwaError HandleFanOutResultNotification(AwaServerSession * session, IPCMessage * notification)
+{
+    AwaError result = AwaError_Unspecified;
+    ServerEventsCallbackInfo * info = ServerSession_GetServerEventsCallbackInfo(session);
+    if (info != NULL)
+    {
+        TreeNode clientNode = TreeNode_Navigate(IPCMessage_GetContentNode(notification), "Content/Clients/Client");
+        if (clientNode != NULL)
+        {
+            const char * clientID = (const char *)xmlif_GetOpaque(clientNode, "Client/ID");
+            const char * latency = (const char *)xmlif_GetOpaque(clientNode, "Client/Latency");
+            if (ServerEventsCallbackInfo_InvokeFanOutResultCallback(info, clientID, latency != NULL ? atoll(latency) : 0, GetFirstResultError(clientNode)) == 0)
+            {
+                result = AwaError_Success;
+            }
+            else
+            {
+                result = LogErrorWithEnum(AwaError_IPCError, "Cannot invoke fan-out result callback");
+            }
+        }
+        else
+        {
+            result = LogErrorWithEnum(AwaError_IPCError, "Client node not found");
+        }
+    }
+    else
+    {
+        result = LogErrorWithEnum(AwaError_IPCError, "info is NULL");
+    }
+    return result;
+}
+
 AwaError ServerNotification_Process(AwaServerSession * session, IPCMessage * notification)
 {
     AwaError result = AwaError_Unspecified;
@@ -213,6 +268,10 @@ AwaError ServerNotification_Process(AwaServerSession * session, IPCMessage * not
                         {
                             result = HandleClientUpdateNotification(session, notification);
                         }
+                        else if (strcmp(subType, IPC_MESSAGE_SUB_TYPE_FAN_OUT_RESULT) == 0)
+                        {
+                            result = HandleFanOutResultNotification(session, notification);
+                        }
                         else
                         {
                             result = LogErrorWithEnum(AwaError_IPCError, "Unexpected notification sub-type '%s'", subType);
@@ -238,6 +238,18 @@ AwaError ServerOperation_AddPath(ServerOperation * operation, const char * clien
     return result;
 }
 
+AwaError ServerOperation_AddPathByKey(ServerOperation * operation, const char * clientID, const PathKey * key, TreeNode * resultNode)
+{
+    AwaError result = AwaError_Unspecified;
+    OperationCommon * operationCommon = ServerOperation_GetOperationCommon(operation, clientID);
+    if (operationCommon == NULL)
+    {
+        operationCommon = ServerOperation_CreateOperationCommon(operation, clientID);
+    }
+    result = OperationCommon_AddPathKeyToObjectsTree(OperationCommon_GetObjectsTree(operationCommon), key, resultNode);
+    return result;
+}
+
 OperationCommon * ServerOperation_GetOperationCommon(const ServerOperation * operation, const char * clientID)
 {
     OperationCommon * clientOperation = NULL;
@@ -52,6 +52,7 @@ TreeNode ServerOperation_GetObjectsTree(const ServerOperation * operation, const
 OperationCommon * ServerOperation_CreateOperationCommon(const ServerOperation * operation, const char * clientID);
 
 AwaError ServerOperation_AddPath(ServerOperation * operation, const char * clientID, const char * path, TreeNode * resultNode);
+AwaError ServerOperation_AddPathByKey(ServerOperation * operation, const char * clientID, const PathKey * key, TreeNode * resultNode);
 
 OperationCommon * ServerOperation_GetOperationCommon(const ServerOperation * operation, const char * clientID);
 OperationCommon * ServerOperation_GetDefaultClientOperation(const ServerOperation * operation);
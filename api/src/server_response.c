@@ -193,15 +193,46 @@ const ResponseCommon * ServerResponse_GetClientResponse(const ServerResponse * r
     return clientResponse;
 }
 
+AwaError ServerResponse_GetClientLatency(const ServerResponse * response, const char * clientID, AwaInteger * latency)
+{
+    AwaError result = AwaError_ClientNotFound;
+    if ((response != NULL) && (clientID != NULL) && (latency != NULL))
+    {
+        uint32_t index = 0;
+        TreeNode clientNode = NULL;
+        while ((clientNode = Xml_FindFrom(response->Clients, "Client", &index)) != NULL)
+        {
+            const char * value = xmlif_GetOpaque(clientNode, "Client/ID");
+            if ((value != NULL) && (strcmp(clientID, value) == 0))
+            {
+                value = xmlif_GetOpaque(clientNode, "Client/Latency");
+                if (value != NULL)
+                {
+                    *latency = atoll(value);
+                    result = AwaError_Success;
+                }
+                break;
+            }
+        }
+    }
+    else
+    {
+        result = LogErrorWithEnum(AwaError_ResponseInvalid, "response, clientID or latency is NULL");
+    }
+    return result;
+}
+
 AwaError ServerResponse_CheckForErrors(const ServerResponse * response)
 {
     AwaError error = AwaError_Success;
     if (response != NULL)
     {
         // check each client for errors in its response
-        const char * clientID = NULL;
-        while ((clientID = ServerResponse_GetNextClientID(response, clientID)) != NULL)
+        uint32_t index = 0;
+        TreeNode clientNode = NULL;
+        while ((clientNode = Xml_FindFrom(response->Clients, "Client", &index)) != NULL)
         {
+            const char * clientID = ServerOperation_GetClientIDFromClientNode(clientNode);
             const ResponseCommon * clientResponse = ServerResponse_GetClientResponse(response, clientID);
             if (ResponseCommon_CheckForErrors(clientResponse) != AwaError_Success)
             {
@@ -224,9 +255,12 @@ ClientIterator * ServerResponse_NewClientIterator(const ServerResponse * respons
         iterator = ClientIterator_New();
         if (iterator != NULL)
         {
-            const char * clientID = NULL;
-            while ((clientID = ServerResponse_GetNextClientID(response, clientID)) != NULL)
+            // walk the Clients tree once rather than searching it for each previous client ID
+            uint32_t index = 0;
+            TreeNode clientNode = NULL;
+            while ((clientNode = Xml_FindFrom(response->Clients, "Client", &index)) != NULL)
             {
+                const char * clientID = ServerOperation_GetClientIDFromClientNode(clientNode);
                 LogDebug("Iterator add ClientID: %s", clientID);
                 ClientIterator_Add(iterator, clientID);
             }
@@ -58,6 +58,11 @@ const ResponseCommon * ServerResponse_GetClientResponse(const ServerResponse * r
 
 AwaError ServerResponse_CheckForErrors(const ServerResponse * response);
 
+/**
+ * @brief Retrieve the latency in ms the server reported for a client of a fanned-out operation.
+ */
+AwaError ServerResponse_GetClientLatency(const ServerResponse * response, const char * clientID, AwaInteger * latency);
+
 ClientIterator * ServerResponse_NewClientIterator(const ServerResponse * response);
 
 
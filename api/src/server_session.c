@@ -149,6 +149,20 @@ AwaError AwaServerSession_SetIPCAsUDP(AwaServerSession * session, const char * a
     return result;
 }
 
+AwaError AwaServerSession_SetIPCAsUnix(AwaServerSession * session, const char * path)
+{
+    AwaError result = AwaError_Unspecified;
+    if (session != NULL)
+    {
+        result = SessionCommon_SetIPCAsUnix(session->SessionCommon, path);
+    }
+    else
+    {
+        result = LogErrorWithEnum(AwaError_SessionInvalid, "session is NULL");
+    }
+    return result;
+}
+
 AwaError AwaServerSession_SetDefaultTimeout(AwaServerSession * session, AwaTimeout timeout)
 {
     AwaError result = AwaError_Unspecified;
@@ -374,9 +388,14 @@ AwaError AwaServerSession_DispatchCallbacks(AwaServerSession * session)
         IPCMessage * notification;
         while (Queue_Pop(session->NotificationQueue, (void **)&notification))
         {
-            ServerNotification_Process(session, notification);
+            // responses to asynchronous requests share the notification queue
+            if (!SessionCommon_DispatchAsyncResponse(session->SessionCommon, notification))
+            {
+                ServerNotification_Process(session, notification);
+            }
             IPCMessage_Free(&notification);
         }
+        SessionCommon_ExpireAsyncRequests(session->SessionCommon);
         result = AwaError_Success;
     }
     else
@@ -386,6 +405,20 @@ AwaError AwaServerSession_DispatchCallbacks(AwaServerSession * session)
     return result;
 }
 
+int AwaServerSession_GetFileDescriptor(const AwaServerSession * session)
+{
+    int fd = -1;
+    if (session != NULL)
+    {
+        fd = SessionCommon_GetFileDescriptor(session->SessionCommon);
+    }
+    else
+    {
+        LogErrorWithEnum(AwaError_SessionInvalid, "session is NULL");
+    }
+    return fd;
+}
+
 // For testing purposes only:
 IPCSessionID AwaServerSession_GetSessionID(const AwaServerSession * session)
 {
@@ -492,6 +525,27 @@ AwaError AwaServerSession_SetClientUpdateEventCallback(AwaServerSession * sessio
     return result;
 }
 
+AwaError AwaServerSession_SetFanOutResultCallback(AwaServerSession * session, AwaServerFanOutResultCallback callback, void * context)
+{
+    AwaError result = AwaError_Unspecified;
+    if (session != NULL)
+    {
+        if (ServerEventsCallbackInfo_SetFanOutResultCallback(session->ServerEventsCallbackInfo, callback, context) == 0)
+        {
+            result = AwaError_Success;
+        }
+        else
+        {
+            result = LogErrorWithEnum(AwaError_Internal, "session->ServerEventsCallbackInfo is NULL");
+        }
+    }
+    else
+    {
+        result = LogErrorWithEnum(AwaError_SessionInvalid, "session is NULL");
+    }
+    return result;
+}
+
 ServerEventsCallbackInfo * ServerSession_GetServerEventsCallbackInfo(const AwaServerSession * session)
 {
     ServerEventsCallbackInfo * info = NULL;
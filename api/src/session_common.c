@@ -23,6 +23,7 @@
 
 #include <stdbool.h>
 #include <string.h>
+#include <time.h>
 
 #include "session_common.h"
 #include "ipc.h"
@@ -36,6 +37,7 @@
 #include "xml.h"
 #include "xmltree.h"
 #include "lwm2m_xml_serdes.h"
+#include "lwm2m_list.h"
 
 /* Notes:
  *  - a Session is considered 'connected' if it has a non-NULL IPCChannel.
@@ -49,8 +51,40 @@ struct _SessionCommon
     SessionType SessionType;
     IPCSessionID SessionID;
     AwaTimeout DefaultTimeout;
+    struct ListHead AsyncRequests;
+    AwaRequestID LastRequestID;
 };
 
+// An asynchronous request, sent on the notify channel and awaiting its response
+typedef struct
+{
+    struct ListHead List;
+    AwaRequestID ID;
+    int64_t Deadline;           // zero if the request never times out
+    SessionCommonResponseHandler Handler;
+    void * Operation;
+    AwaOperationCompleteCallback Callback;
+    void * Context;
+} AsyncRequest;
+
+static int64_t SessionCommon_GetTimeMs(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((int64_t)now.tv_sec * 1000) + (now.tv_nsec / 1000000);
+}
+
+static void SessionCommon_FlushAsyncRequests(SessionCommon * session)
+{
+    struct ListHead * current, * next;
+    ListForEachSafe(current, next, &session->AsyncRequests)
+    {
+        AsyncRequest * asyncRequest = ListEntry(current, AsyncRequest, List);
+        ListRemove(&asyncRequest->List);
+        Awa_MemSafeFree(asyncRequest);
+    }
+}
+
 static bool SessionType_IsValid(SessionType type)
 {
     return type == SessionType_Client || type == SessionType_Server;
@@ -69,6 +103,7 @@ SessionCommon * SessionCommon_New(SessionType sessionType)
             session->SessionType = sessionType;
             session->SessionID = 0;
             session->DefaultTimeout = SESSION_DEFAULT_TIMEOUT;
+            ListInit(&session->AsyncRequests);
             session->DefinitionRegistry = DefinitionRegistry_Create();
             if (session->DefinitionRegistry != NULL)
             {
@@ -109,6 +144,7 @@ AwaError SessionCommon_Free(SessionCommon ** session)
         }
 
         // Free any memory owned by a session
+        SessionCommon_FlushAsyncRequests(*session);
         IPCInfo_Free(&((*session)->IPCInfo));
         IPCChannel_Free(&((*session)->IPCChannel));
         DefinitionRegistry_Destroy((*session)->DefinitionRegistry);
@@ -151,6 +187,32 @@ AwaError SessionCommon_SetIPCAsUDP(SessionCommon * session, const char * address
     return result;
 }
 
+AwaError SessionCommon_SetIPCAsUnix(SessionCommon * session, const char * path)
+{
+    AwaError result = AwaError_Success;
+    if (session != NULL)
+    {
+        // Free existing record, if present
+        IPCInfo_Free(&session->IPCInfo);
+
+        IPCInfo * ipcInfo = IPCInfo_NewUnix(path);
+        if (ipcInfo != NULL)
+        {
+            session->IPCInfo = ipcInfo;
+            LogVerbose("Session IPC configured for Unix domain socket: path %s", path);
+        }
+        else
+        {
+            result = LogErrorWithEnum(AwaError_IPCError, "IPC not configured");
+        }
+    }
+    else
+    {
+        result = LogErrorWithEnum(AwaError_SessionInvalid, "Session is NULL");
+    }
+    return result;
+}
+
 bool SessionCommon_HasIPCInfo(const SessionCommon * session)
 {
     return (session->IPCInfo != NULL);
@@ -370,8 +432,10 @@ static AwaError ConnectChannel(SessionCommon * session)
     AwaError result = AwaError_Unspecified;
     if (session != NULL)
     {
-        // no SessionID to be specified
+        // no SessionID to be specified. The Connect request itself is always XML, but offers the binary
+        // encoding for subsequent messages - daemons that do not support it will not confirm it.
         IPCMessage * connectRequest = IPCMessage_NewPlus(IPC_MESSAGE_TYPE_REQUEST, IPC_MESSAGE_SUB_TYPE_CONNECT, -1);
+        IPCMessage_SetEncoding(connectRequest, IPCEncoding_Binary);
         IPCMessage * connectResponse = NULL;
         result = IPC_SendAndReceive(session->IPCChannel, connectRequest, &connectResponse, session->DefaultTimeout);
 
@@ -383,6 +447,8 @@ static AwaError ConnectChannel(SessionCommon * session)
                 session->SessionID = IPCMessage_GetSessionID(connectResponse);
                 if (session->SessionID > 0)
                 {
+                    IPCChannel_SetEncoding(session->IPCChannel, IPCMessage_GetEncoding(connectResponse));
+
                     // populate object definition registry
                     TreeNode content = IPCMessage_GetContentNode(connectResponse);
 
@@ -596,6 +662,9 @@ AwaError SessionCommon_DisconnectSession(SessionCommon * session)
                 }
 
                 IPCChannel_Free(&session->IPCChannel);
+
+                // responses to outstanding asynchronous requests can no longer be received
+                SessionCommon_FlushAsyncRequests(session);
             }
             else
             {
@@ -768,21 +837,26 @@ AwaError SessionCommon_CheckResourceTypeFromPath(const SessionCommon * session,
 }
 
 const AwaResourceDefinition * SessionCommon_GetResourceDefinitionFromPath(const SessionCommon * session, const char * path)
+{
+    PathKey key;
+    PathKey_Parse(&key, path);
+    return SessionCommon_GetResourceDefinitionFromIDs(session, PathKey_GetObjectID(&key), PathKey_GetResourceID(&key));
+}
+
+const AwaResourceDefinition * SessionCommon_GetResourceDefinitionFromIDs(const SessionCommon * session, AwaObjectID objectID, AwaResourceID resourceID)
 {
     const AwaResourceDefinition * result = NULL;
     if (session != NULL)
     {
-        AwaObjectID objectID = Path_GetObjectID(path);
         const AwaObjectDefinition * objectDefinition = SessionCommon_GetObjectDefinition(session, objectID);
 
         if (objectDefinition != NULL)
         {
-            AwaResourceID resourceID = Path_GetResourceID(path);
             result = AwaObjectDefinition_GetResourceDefinition(objectDefinition, resourceID);
         }
         else
         {
-            LogErrorWithEnum(AwaError_NotDefined, "%s is not defined", path);
+            LogErrorWithEnum(AwaError_NotDefined, "Object %d is not defined", objectID);
             result = NULL;
         }
     }
@@ -890,4 +964,141 @@ AwaError SessionCommon_SetDefaultTimeout(SessionCommon * session, AwaTimeout tim
     return result;
 }
 
+int SessionCommon_GetFileDescriptor(const SessionCommon * session)
+{
+    int fd = -1;
+    if (session != NULL)
+    {
+        if (SessionCommon_IsConnected(session))
+        {
+            fd = IPCChannel_GetNotifySocket(session->IPCChannel);
+        }
+        else
+        {
+            LogErrorWithEnum(AwaError_SessionNotConnected, "Session not connected");
+        }
+    }
+    else
+    {
+        LogErrorWithEnum(AwaError_SessionInvalid, "Session is NULL");
+    }
+    return fd;
+}
 
+AwaError SessionCommon_SendAsyncRequest(SessionCommon * session, IPCMessage * request, AwaTimeout timeout,
+                                        SessionCommonResponseHandler handler, void * operation,
+                                        AwaOperationCompleteCallback callback, void * context, AwaRequestID * requestID)
+{
+    AwaError result = AwaError_Unspecified;
+    if ((session != NULL) && (request != NULL) && (handler != NULL))
+    {
+        if (SessionCommon_IsConnected(session))
+        {
+            AsyncRequest * asyncRequest = Awa_MemAlloc(sizeof(*asyncRequest));
+            if (asyncRequest != NULL)
+            {
+                memset(asyncRequest, 0, sizeof(*asyncRequest));
+                session->LastRequestID = session->LastRequestID < INT32_MAX ? session->LastRequestID + 1 : 1;
+                asyncRequest->ID = session->LastRequestID;
+                // an API timeout of zero means infinite wait
+                asyncRequest->Deadline = timeout > 0 ? SessionCommon_GetTimeMs() + timeout : 0;
+                asyncRequest->Handler = handler;
+                asyncRequest->Operation = operation;
+                asyncRequest->Callback = callback;
+                asyncRequest->Context = context;
+
+                // Responses to requests sent on the notify channel are received by the session's Process function
+                if (IPCMessage_SetRequestID(request, asyncRequest->ID) == InternalError_Success)
+                {
+                    result = IPC_SendAndReceiveOnNotifySocket(session->IPCChannel, request, NULL, 0);
+                }
+                else
+                {
+                    result = LogErrorWithEnum(AwaError_Internal, "Failed to set request ID");
+                }
+
+                if (result == AwaError_Success)
+                {
+                    ListAdd(&asyncRequest->List, &session->AsyncRequests);
+                    if (requestID != NULL)
+                    {
+                        *requestID = asyncRequest->ID;
+                    }
+                    LogDebug("Sent asynchronous request %d", asyncRequest->ID);
+                }
+                else
+                {
+                    Awa_MemSafeFree(asyncRequest);
+                }
+            }
+            else
+            {
+                result = LogErrorWithEnum(AwaError_OutOfMemory);
+            }
+        }
+        else
+        {
+            result = LogErrorWithEnum(AwaError_SessionNotConnected, "Session not connected");
+        }
+    }
+    else
+    {
+        result = LogErrorWithEnum(AwaError_SessionInvalid, "Session or request is NULL");
+    }
+    return result;
+}
+
+bool SessionCommon_DispatchAsyncResponse(SessionCommon * session, IPCMessage * message)
+{
+    const char * type = NULL;
+    if ((session == NULL) || (IPCMessage_GetType(message, &type, NULL) != InternalError_Success) ||
+        (type == NULL) || (strcmp(type, IPC_MESSAGE_TYPE_RESPONSE) != 0))
+    {
+        return false;
+    }
+
+    AwaRequestID requestID = IPCMessage_GetRequestID(message);
+    struct ListHead * current;
+    ListForEach(current, &session->AsyncRequests)
+    {
+        AsyncRequest * asyncRequest = ListEntry(current, AsyncRequest, List);
+        if (asyncRequest->ID == requestID)
+        {
+            ListRemove(&asyncRequest->List);
+            AwaError result = asyncRequest->Handler(asyncRequest->Operation, message);
+            if (asyncRequest->Callback != NULL)
+            {
+                asyncRequest->Callback(asyncRequest->ID, result, asyncRequest->Context);
+            }
+            Awa_MemSafeFree(asyncRequest);
+            return true;
+        }
+    }
+
+    // the request may have already timed out
+    LogDebug("Discarding response to unknown request %d", requestID);
+    return true;
+}
+
+void SessionCommon_ExpireAsyncRequests(SessionCommon * session)
+{
+    if (session != NULL)
+    {
+        int64_t now = SessionCommon_GetTimeMs();
+        struct ListHead * current, * next;
+        ListForEachSafe(current, next, &session->AsyncRequests)
+        {
+            AsyncRequest * asyncRequest = ListEntry(current, AsyncRequest, List);
+            if ((asyncRequest->Deadline != 0) && (asyncRequest->Deadline <= now))
+            {
+                ListRemove(&asyncRequest->List);
+                LogError("Timed out waiting for response to asynchronous request %d", asyncRequest->ID);
+                if (asyncRequest->Callback != NULL)
+                {
+                    asyncRequest->Callback(asyncRequest->ID, AwaError_Timeout, asyncRequest->Context);
+                }
+                Awa_MemSafeFree(asyncRequest);
+            }
+        }
+    }
+}
@@ -50,6 +50,8 @@ AwaError SessionCommon_Free(SessionCommon ** operation);
 
 AwaError SessionCommon_SetIPCAsUDP(SessionCommon * session, const char * address, unsigned short port);
 
+AwaError SessionCommon_SetIPCAsUnix(SessionCommon * session, const char * path);
+
 bool SessionCommon_HasIPCInfo(const SessionCommon * session);
 
 AwaError SessionCommon_ConnectSession(SessionCommon * session);
@@ -71,6 +73,7 @@ AwaError SessionCommon_PathToIDs(const SessionCommon * session, const char * pat
 AwaError SessionCommon_CheckResourceTypeFromPath(const SessionCommon * session, const char * path, AwaResourceType expected);
 
 const AwaResourceDefinition * SessionCommon_GetResourceDefinitionFromPath(const SessionCommon * session, const char * path);
+const AwaResourceDefinition * SessionCommon_GetResourceDefinitionFromIDs(const SessionCommon * session, AwaObjectID objectID, AwaResourceID resourceID);
 
 bool SessionCommon_IsObjectDefined(const SessionCommon * session, AwaObjectID objectID);
 
@@ -82,6 +85,21 @@ IPCSessionID SessionCommon_GetSessionID(const SessionCommon * session);
 
 AwaError SessionCommon_SetDefaultTimeout(SessionCommon * session, AwaTimeout timeout);
 
+// Asynchronous requests are sent on the notify channel. Their responses are received by the session's Process
+// function, and passed to the request's handler, then callback, by its DispatchCallbacks function.
+typedef AwaError (*SessionCommonResponseHandler)(void * operation, IPCMessage * response);
+
+int SessionCommon_GetFileDescriptor(const SessionCommon * session);
+
+AwaError SessionCommon_SendAsyncRequest(SessionCommon * session, IPCMessage * request, AwaTimeout timeout,
+                                        SessionCommonResponseHandler handler, void * operation,
+                                        AwaOperationCompleteCallback callback, void * context, AwaRequestID * requestID);
+
+// Returns true if the message is a response, in which case it has been consumed
+bool SessionCommon_DispatchAsyncResponse(SessionCommon * session, IPCMessage * message);
+
+void SessionCommon_ExpireAsyncRequests(SessionCommon * session);
+
 
 #ifdef __cplusplus
 }
@@ -267,6 +267,29 @@ static AwaError ClientSetOperation_AddValue(AwaClientSetOperation * operation, c
     return result;
 }
 
+static AwaError ClientSetOperation_AddValueByID(AwaClientSetOperation * operation, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID,
+                                               void * value, size_t size, AwaResourceType type)
+{
+    AwaError result = AwaError_Unspecified;
+    if (operation != NULL)
+    {
+        PathKey key;
+        if (PathKey_Make(&key, objectID, objectInstanceID, resourceID) && PathKey_IsResource(&key))
+        {
+            result = SetWriteCommon_AddValueByKey(operation->Common, SessionType_Client, &key, 0, value, size, type, SetArrayMode_Unspecified);
+        }
+        else
+        {
+            result = LogErrorWithEnum(AwaError_PathInvalid, "IDs %d/%d/%d do not identify a resource", objectID, objectInstanceID, resourceID);
+        }
+    }
+    else
+    {
+        result = LogErrorWithEnum(AwaError_OperationInvalid, "operation is NULL");
+    }
+    return result;
+}
+
 static AwaError ClientSetOperation_AddValues(AwaClientSetOperation * operation, const char * path, const AwaArray * array, AwaResourceType type)
 {
     AwaError result = AwaError_Unspecified;
@@ -360,6 +383,50 @@ AwaError AwaClientSetOperation_AddValueAsObjectLink(AwaClientSetOperation * oper
     return ClientSetOperation_AddValue(operation, path, 0, (void *)&value, sizeof(AwaObjectLink), AwaResourceType_ObjectLink, SetArrayMode_Unspecified);
 }
 
+AwaError AwaClientSetOperation_AddValueAsCStringByID(AwaClientSetOperation * operation, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, const char * value)
+{
+    AwaError result = AwaError_Unspecified;
+    if (value != NULL)
+    {
+        result = ClientSetOperation_AddValueByID(operation, objectID, objectInstanceID, resourceID, (void *)value, strlen(value), AwaResourceType_String);
+    }
+    else
+    {
+        result = LogErrorWithEnum(AwaError_TypeMismatch, "value is NULL");
+    }
+    return result;
+}
+
+AwaError AwaClientSetOperation_AddValueAsIntegerByID(AwaClientSetOperation * operation, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, AwaInteger value)
+{
+    return ClientSetOperation_AddValueByID(operation, objectID, objectInstanceID, resourceID, (void *)&value, sizeof(AwaInteger), AwaResourceType_Integer);
+}
+
+AwaError AwaClientSetOperation_AddValueAsFloatByID(AwaClientSetOperation * operation, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, AwaFloat value)
+{
+    return ClientSetOperation_AddValueByID(operation, objectID, objectInstanceID, resourceID, (void *)&value, sizeof(AwaFloat), AwaResourceType_Float);
+}
+
+AwaError AwaClientSetOperation_AddValueAsBooleanByID(AwaClientSetOperation * operation, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, AwaBoolean value)
+{
+    return ClientSetOperation_AddValueByID(operation, objectID, objectInstanceID, resourceID, (void *)&value, sizeof(AwaBoolean), AwaResourceType_Boolean);
+}
+
+AwaError AwaClientSetOperation_AddValueAsTimeByID(AwaClientSetOperation * operation, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, AwaTime value)
+{
+    return ClientSetOperation_AddValueByID(operation, objectID, objectInstanceID, resourceID, (void *)&value, sizeof(AwaTime), AwaResourceType_Time);
+}
+
+AwaError AwaClientSetOperation_AddValueAsOpaqueByID(AwaClientSetOperation * operation, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, AwaOpaque value)
+{
+    return ClientSetOperation_AddValueByID(operation, objectID, objectInstanceID, resourceID, value.Data, value.Size, AwaResourceType_Opaque);
+}
+
+AwaError AwaClientSetOperation_AddValueAsObjectLinkByID(AwaClientSetOperation * operation, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, AwaObjectLink value)
+{
+    return ClientSetOperation_AddValueByID(operation, objectID, objectInstanceID, resourceID, (void *)&value, sizeof(AwaObjectLink), AwaResourceType_ObjectLink);
+}
+
 AwaError AwaClientSetOperation_AddValueAsIntegerArray(AwaClientSetOperation * operation, const char * path, const AwaIntegerArray * array)
 {
     return ClientSetOperation_AddValues(operation, path, (const AwaArray *)array, AwaResourceType_IntegerArray);
@@ -430,79 +497,119 @@ AwaError AwaClientSetOperation_AddArrayValueAsObjectLink(AwaClientSetOperation *
     return ClientSetOperation_AddValue(operation, path, resourceInstanceID, (void *)&value, sizeof(AwaObjectLink), AwaResourceType_ObjectLinkArray, SetArrayMode_Update);
 }
 
-AwaError AwaClientSetOperation_Perform(AwaClientSetOperation * operation, AwaTimeout timeout)
+static AwaError ClientSetOperation_NewRequest(const AwaClientSetOperation * operation, IPCMessage ** request)
 {
     AwaError result = AwaError_Unspecified;
 
-    if (timeout >= 0)
+    if (operation != NULL)
     {
-        if (operation != NULL)
+        const AwaClientSession * session = OperationCommon_GetSession(operation->Common, NULL);
+        if (session != NULL)
         {
-            const AwaClientSession * session = OperationCommon_GetSession(operation->Common, NULL);
-            if (session != NULL)
+            if (ClientSession_IsConnected(session))
             {
-                if (ClientSession_IsConnected(session))
+                TreeNode objectsTree = OperationCommon_GetObjectsTree(operation->Common);
+                if (objectsTree != NULL)
                 {
-                    TreeNode objectsTree = OperationCommon_GetObjectsTree(operation->Common);
-                    if (objectsTree != NULL)
+                    if (TreeNode_GetChildCount(objectsTree) > 0)
                     {
-                        if (TreeNode_GetChildCount(objectsTree) > 0)
-                        {
-                            IPCMessage * setRequest = IPCMessage_NewPlus(IPC_MESSAGE_TYPE_REQUEST, IPC_MESSAGE_SUB_TYPE_SET, OperationCommon_GetSessionID(operation->Common));
-                            IPCMessage_AddContent(setRequest, objectsTree);
-
-                            // Serialise message
-                            char * requestBuffer = IPC_SerialiseMessageToXML(setRequest);
-                            Awa_MemSafeFree(requestBuffer);
-
-                            // Send via IPC
-                            IPCMessage * setResponse = NULL;
-                            result = IPC_SendAndReceive(ClientSession_GetChannel(session), setRequest, &setResponse, timeout);
-
-                            // Process the response
-                            if (result == AwaError_Success)
-                            {
-                                // Free an old Read response record if it exists
-                                if (operation->Response != NULL)
-                                {
-                                    ResponseCommon_Free(&operation->Response);
-                                }
-
-                                TreeNode contentNode = IPCMessage_GetContentNode(setResponse);
-                                TreeNode objectsNode = Xml_Find(contentNode, "Objects");
-                                operation->Response = ResponseCommon_New(operation->Common, objectsNode);
-
-                                result = ResponseCommon_CheckForErrors(operation->Response);
-
-                                LogDebug("Perform Set Operation successful");
-                            }
-                            // Free allocated memory
-                            IPCMessage_Free(&setRequest);
-                            IPCMessage_Free(&setResponse);
-                        }
-                        else
-                        {
-                            result = LogErrorWithEnum(AwaError_OperationInvalid, "No paths specified");
-                        }
+                        *request = IPCMessage_NewPlus(IPC_MESSAGE_TYPE_REQUEST, IPC_MESSAGE_SUB_TYPE_SET, OperationCommon_GetSessionID(operation->Common));
+                        IPCMessage_AddContent(*request, objectsTree);
+                        result = AwaError_Success;
                     }
                     else
                     {
-                        result = LogErrorWithEnum(AwaError_Internal, "objectsTree is NULL");
+                        result = LogErrorWithEnum(AwaError_OperationInvalid, "No paths specified");
                     }
                 }
                 else
                 {
-                    result = LogErrorWithEnum(AwaError_SessionNotConnected, "session is not connected");
+                    result = LogErrorWithEnum(AwaError_Internal, "objectsTree is NULL");
                 }
             }
             else
             {
-                result = LogErrorWithEnum(AwaError_SessionInvalid, "session is NULL");
+                result = LogErrorWithEnum(AwaError_SessionNotConnected, "session is not connected");
             }
         }
         else
         {
-            result = LogErrorWithEnum(AwaError_OperationInvalid, "operation is NULL");
+            result = LogErrorWithEnum(AwaError_SessionInvalid, "session is NULL");
+        }
+    }
+    else
+    {
+        result = LogErrorWithEnum(AwaError_OperationInvalid, "operation is NULL");
+    }
+    return result;
+}
+
+static AwaError ClientSetOperation_ProcessResponse(AwaClientSetOperation * operation, IPCMessage * response)
+{
+    // Free an old Read response record if it exists
+    if (operation->Response != NULL)
+    {
+        ResponseCommon_Free(&operation->Response);
+    }
+
+    TreeNode contentNode = IPCMessage_GetContentNode(response);
+    TreeNode objectsNode = Xml_Find(contentNode, "Objects");
+    operation->Response = ResponseCommon_New(operation->Common, objectsNode);
+
+    LogDebug("Perform Set Operation successful");
+    return ResponseCommon_CheckForErrors(operation->Response);
+}
+
+static AwaError ClientSetOperation_AsyncResponseHandler(void * operation, IPCMessage * response)
+{
+    return ClientSetOperation_ProcessResponse((AwaClientSetOperation *)operation, response);
+}
+
+AwaError AwaClientSetOperation_Perform(AwaClientSetOperation * operation, AwaTimeout timeout)
+{
+    AwaError result = AwaError_Unspecified;
+
+    if (timeout >= 0)
+    {
+        IPCMessage * setRequest = NULL;
+        result = ClientSetOperation_NewRequest(operation, &setRequest);
+        if (result == AwaError_Success)
+        {
+            // Send via IPC
+            IPCMessage * setResponse = NULL;
+            const AwaClientSession * session = OperationCommon_GetSession(operation->Common, NULL);
+            result = IPC_SendAndReceive(ClientSession_GetChannel(session), setRequest, &setResponse, timeout);
+
+            // Process the response
+            if (result == AwaError_Success)
+            {
+                result = ClientSetOperation_ProcessResponse(operation, setResponse);
+            }
+            // Free allocated memory
+            IPCMessage_Free(&setRequest);
+            IPCMessage_Free(&setResponse);
+        }
+    }
+    else
+    {
+        result = LogErrorWithEnum(AwaError_OperationInvalid, "Invalid timeout specified");
+    }
+    return result;
+}
+
+AwaError AwaClientSetOperation_PerformAsync(AwaClientSetOperation * operation, AwaTimeout timeout, AwaOperationCompleteCallback callback, void * context, AwaRequestID * requestID)
+{
+    AwaError result = AwaError_Unspecified;
+
+    if (timeout >= 0)
+    {
+        IPCMessage * setRequest = NULL;
+        result = ClientSetOperation_NewRequest(operation, &setRequest);
+        if (result == AwaError_Success)
+        {
+            SessionCommon * sessionCommon = ClientSession_GetSessionCommon(OperationCommon_GetSession(operation->Common, NULL));
+            result = SessionCommon_SendAsyncRequest(sessionCommon, setRequest, timeout, ClientSetOperation_AsyncResponseHandler, operation, callback, context, requestID);
+            IPCMessage_Free(&setRequest);
         }
     }
     else
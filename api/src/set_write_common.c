@@ -85,7 +85,38 @@ AwaError SetWriteCommon_AddValue(OperationCommon * operation, SessionType sessio
     {
         if (path != NULL)
         {
-            if (Path_IsValidForResource(path))
+            PathKey key;
+            if (PathKey_Parse(&key, path) && PathKey_IsResource(&key))
+            {
+                result = SetWriteCommon_AddValueByKey(operation, sessionType, &key, resourceInstanceID, value, size, type, setArrayMode);
+            }
+            else
+            {
+                result = LogErrorWithEnum(AwaError_PathInvalid, "%s is not a resource path", path);
+            }
+        }
+        else
+        {
+            result = LogErrorWithEnum(AwaError_PathInvalid, "Path is NULL");
+        }
+    }
+    else
+    {
+        result = LogErrorWithEnum(AwaError_OperationInvalid, "Operation is NULL");
+    }
+    return result;
+}
+
+AwaError SetWriteCommon_AddValueByKey(OperationCommon * operation, SessionType sessionType, const PathKey * key, int resourceInstanceID, void * value, size_t size, AwaResourceType type, SetArrayMode setArrayMode)
+{
+    AwaError result = AwaError_Unspecified;
+    char path[MAX_PATH_LENGTH];     // only formatted for error messages
+
+    if (operation != NULL)
+    {
+        if (key != NULL)
+        {
+            if (PathKey_IsResource(key))
             {
                 const Session * session = OperationCommon_GetSession(operation, NULL);
                 if (session != NULL)
@@ -105,19 +136,7 @@ AwaError SetWriteCommon_AddValue(OperationCommon * operation, SessionType sessio
                     }
                     if (SessionCommon_IsConnected(sessionCommon))
                     {
-                        const AwaResourceDefinition * resourceDefinition = NULL;
-                        switch(sessionType)
-                        {
-                            case SessionType_Client:
-                                resourceDefinition = ClientSession_GetResourceDefinitionFromPath((AwaClientSession*)session, path);
-                                break;
-                            case SessionType_Server:
-                                resourceDefinition = ServerSession_GetResourceDefinitionFromPath((AwaServerSession*)session, path);
-                                break;
-                            default:
-                                result = LogErrorWithEnum(AwaError_Internal, "SessionType is invalid: %d\n", sessionType);
-                                goto error;
-                        }
+                        const AwaResourceDefinition * resourceDefinition = SessionCommon_GetResourceDefinitionFromIDs(sessionCommon, PathKey_GetObjectID(key), PathKey_GetResourceID(key));
                         if (resourceDefinition != NULL)
                         {
                             // ensure the type matches:
@@ -127,13 +146,13 @@ AwaError SetWriteCommon_AddValue(OperationCommon * operation, SessionType sessio
                                 if (objectsTree != NULL)
                                 {
                                     TreeNode resultNode;
-                                    ObjectsTree_FindPathNode(objectsTree, path, &resultNode);
+                                    ObjectsTree_FindPathNodeByKey(objectsTree, key, &resultNode);
 
                                     if (ObjectsTree_GetNumChildrenWithName(resultNode, "ResourceInstance") < resourceDefinition->MaximumInstances)
                                     {
                                         char * encodedValue = xmlif_EncodeValue(Utils_GetPrimativeResourceType(type), value, size);
 
-                                        if (ObjectsTree_AddPath(objectsTree, path, &resultNode) == InternalError_Success && resultNode != NULL)
+                                        if (ObjectsTree_AddPathByKey(objectsTree, key, &resultNode) == InternalError_Success && resultNode != NULL)
                                         {
                                             if (resourceDefinition->MaximumInstances == 1) // single instance resource
                                             {
@@ -204,11 +223,13 @@ AwaError SetWriteCommon_AddValue(OperationCommon * operation, SessionType sessio
                             }
                             else
                             {
+                                PathKey_Format(key, path, sizeof(path));
                                 result = LogErrorWithEnum(AwaError_TypeMismatch, "%s is not of type %s, received %s", path, Utils_ResourceTypeToString(type), Utils_ResourceTypeToString(AwaResourceDefinition_GetType(resourceDefinition)));
                             }
                         }
                         else
                         {
+                            PathKey_Format(key, path, sizeof(path));
                             result = LogErrorWithEnum(AwaError_NotDefined, "%s is not defined", path);
                         }
                     }
@@ -224,7 +245,7 @@ AwaError SetWriteCommon_AddValue(OperationCommon * operation, SessionType sessio
             }
             else
             {
-                result = LogErrorWithEnum(AwaError_PathInvalid, "%s is not a resource path", path);
+                result = LogErrorWithEnum(AwaError_PathInvalid, "Path is not a resource path");
             }
         }
         else
@@ -71,6 +71,7 @@ InternalError SetWriteCommon_AddValueToResourceNode(TreeNode propertyNode, int r
 InternalError SetWriteCommon_SetResourceNodeValue(TreeNode resourceNode, const char * value);
 
 AwaError SetWriteCommon_AddValue(OperationCommon * operation, SessionType sessionType, const char * path, int resourceInstanceID, void * value, size_t size, AwaResourceType type, SetArrayMode setArrayMode);
+AwaError SetWriteCommon_AddValueByKey(OperationCommon * operation, SessionType sessionType, const PathKey * key, int resourceInstanceID, void * value, size_t size, AwaResourceType type, SetArrayMode setArrayMode);
 
 // Encode a value into a string to be copied into a LWM2M Tree Node.
 // The encoded value that is returned must be explicitly freed by the caller.
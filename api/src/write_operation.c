@@ -40,6 +40,7 @@
 #include "client_iterator.h"
 #include "response_common.h"
 #include "write_mode.h"
+#include "write_operation.h"
 
 // The server write operation does NOT use a ServerOperation due to being able to only write to one client at a time.
 // ClientID is specified at the time the operation is performed, rather than per-path. This is due to Write being a
@@ -127,127 +128,179 @@ AwaError AwaServerWriteOperation_Free(AwaServerWriteOperation ** operation)
     return result;
 }
 
-AwaError AwaServerWriteOperation_Perform(AwaServerWriteOperation * operation, const char * clientID, AwaTimeout timeout)
+AwaError ServerWriteOperation_NewRequest(const AwaServerWriteOperation * operation, const char * clientID, IPCMessage ** request)
 {
     AwaError result = AwaError_Unspecified;
 
-    if (timeout >= 0)
+    if (operation != NULL)
     {
-        if (operation != NULL)
+        const Session * session = ServerOperation_GetSession(operation->ServerOperation);
+        if (session != NULL)
         {
-            const Session * session = ServerOperation_GetSession(operation->ServerOperation);
-            if (session != NULL)
+            const AwaServerSession * serverSession = (AwaServerSession * )session;
+            if (ServerSession_IsConnected(serverSession))
             {
-                const AwaServerSession * serverSession = (AwaServerSession * )session;
-                if (ServerSession_IsConnected(serverSession))
+                if (clientID != NULL)
                 {
-                    if (clientID != NULL)
+                    OperationCommon * defaultClientOperation = ServerOperation_GetDefaultClientOperation(operation->ServerOperation);
+                    if (defaultClientOperation != NULL)
                     {
-                        OperationCommon * defaultClientOperation = ServerOperation_GetDefaultClientOperation(operation->ServerOperation);
-                        if (defaultClientOperation != NULL)
-                        {
-                            TreeNode objectsTree = OperationCommon_GetObjectsTree(defaultClientOperation);
+                        TreeNode objectsTree = OperationCommon_GetObjectsTree(defaultClientOperation);
 
-                            if (objectsTree != NULL)
+                        if (objectsTree != NULL)
+                        {
+                            if (TreeNode_GetChildCount(objectsTree) > 0)
                             {
-                                if (TreeNode_GetChildCount(objectsTree) > 0)
-                                {
-                                    // build an IPC message and inject our content into it
-                                    IPCMessage * request = IPCMessage_NewPlus(IPC_MESSAGE_TYPE_REQUEST, IPC_MESSAGE_SUB_TYPE_WRITE, ServerOperation_GetSessionID(operation->ServerOperation));
-
-                                    // Add client node
-                                    TreeNode clientsNode = Xml_CreateNode("Clients");
-                                    TreeNode clientNode = Xml_CreateNode("Client");
-                                    TreeNode_AddChild(clientsNode, clientNode);
-
-                                    // Add client ID
-                                    TreeNode clientIDnode = Xml_CreateNodeWithValue("ID", "%s",clientID);
-                                    TreeNode_AddChild(clientNode, clientIDnode);
-
-                                    // Add default write mode
-                                    TreeNode defaultWriteModeNode = Xml_CreateNodeWithValue("DefaultWriteMode", "%s", WriteMode_ToString(operation->DefaultWriteMode));
-                                    TreeNode_AddChild(clientNode, defaultWriteModeNode);
-
-                                    //Add objects tree
-                                    TreeNode_AddChild(clientNode, objectsTree);
-
-                                    // Add Content to message
-                                    IPCMessage_AddContent(request, clientsNode);
-
-                                    // Send via IPC
-                                    IPCMessage * response = NULL;
-                                    result = IPC_SendAndReceive(ServerSession_GetChannel(serverSession), request, &response, timeout);
-
-                                    // Process the response
-                                    if (result == AwaError_Success)
-                                    {
-                                        IPCResponseCode responseCode = IPCMessage_GetResponseCode(response);
-                                        if (responseCode == IPCResponseCode_Success)
-                                        {
-                                            // Free an old Write response record if it exists
-                                            if (operation->Response != NULL)
-                                            {
-                                                ServerResponse_Free(&operation->Response);
-                                            }
-
-                                            // Detach the response's content and add it to the Server Response
-                                            TreeNode contentNode = IPCMessage_GetContentNode(response);
-                                            TreeNode clientsNode = Xml_Find(contentNode, "Clients");
-                                            operation->Response = ServerResponse_NewFromServerOperation(operation->ServerOperation, clientsNode);
-
-                                            LogDebug("Perform Write Operation successful");
-
-                                            result = ServerResponse_CheckForErrors(operation->Response);
-                                        }
-                                        else if (responseCode == IPCResponseCode_FailureBadRequest)
-                                        {
-                                            result = LogErrorWithEnum(AwaError_IPCError, "Unable to perform Write operation: Bad Request");
-                                        }
-                                        else
-                                        {
-                                            result = LogErrorWithEnum(AwaError_IPCError, "Unexpected IPC response code: %d", responseCode);
-                                        }
-                                    }
-                                    // Free allocated memory
-                                    Tree_DetachNode(objectsTree);
-                                    Tree_Delete(clientsNode);
-
-                                    IPCMessage_Free(&request);
-                                    IPCMessage_Free(&response);
-                                }
-                                else
-                                {
-                                    result = LogErrorWithEnum(AwaError_OperationInvalid, "No paths specified");
-                                }
+                                // build an IPC message and inject our content into it
+                                *request = IPCMessage_NewPlus(IPC_MESSAGE_TYPE_REQUEST, IPC_MESSAGE_SUB_TYPE_WRITE, ServerOperation_GetSessionID(operation->ServerOperation));
+
+                                // Add client node
+                                TreeNode clientsNode = Xml_CreateNode("Clients");
+                                TreeNode clientNode = Xml_CreateNode("Client");
+                                TreeNode_AddChild(clientsNode, clientNode);
+
+                                // Add client ID
+                                TreeNode clientIDnode = Xml_CreateNodeWithValue("ID", "%s",clientID);
+                                TreeNode_AddChild(clientNode, clientIDnode);
+
+                                // Add default write mode
+                                TreeNode defaultWriteModeNode = Xml_CreateNodeWithValue("DefaultWriteMode", "%s", WriteMode_ToString(operation->DefaultWriteMode));
+                                TreeNode_AddChild(clientNode, defaultWriteModeNode);
+
+                                //Add objects tree
+                                TreeNode_AddChild(clientNode, objectsTree);
+
+                                // Add Content to message
+                                IPCMessage_AddContent(*request, clientsNode);
+
+                                // Free allocated memory
+                                Tree_DetachNode(objectsTree);
+                                Tree_Delete(clientsNode);
+                                result = AwaError_Success;
                             }
                             else
                             {
-                                result = LogErrorWithEnum(AwaError_Internal, "objectsTree is NULL");
+                                result = LogErrorWithEnum(AwaError_OperationInvalid, "No paths specified");
                             }
                         }
                         else
                         {
-                            result = LogErrorWithEnum(AwaError_Internal, "default client operation is NULL");
+                            result = LogErrorWithEnum(AwaError_Internal, "objectsTree is NULL");
                         }
                     }
                     else
                     {
-                        result = LogErrorWithEnum(AwaError_SessionNotConnected, "session is not connected");
+                        result = LogErrorWithEnum(AwaError_Internal, "default client operation is NULL");
                     }
                 }
                 else
                 {
-                    result = LogErrorWithEnum(AwaError_SessionInvalid, "session is NULL");
+                    result = LogErrorWithEnum(AwaError_SessionNotConnected, "session is not connected");
                 }
             }
             else
             {
-                result = LogErrorWithEnum(AwaError_OperationInvalid, "ClientID is NULL");
+                result = LogErrorWithEnum(AwaError_SessionInvalid, "session is NULL");
             }
         }
         else
         {
-            result = LogErrorWithEnum(AwaError_OperationInvalid, "Operation is NULL");
+            result = LogErrorWithEnum(AwaError_OperationInvalid, "ClientID is NULL");
+        }
+    }
+    else
+    {
+        result = LogErrorWithEnum(AwaError_OperationInvalid, "Operation is NULL");
+    }
+    return result;
+}
+
+AwaError ServerWriteOperation_ProcessResponse(AwaServerWriteOperation * operation, IPCMessage * response)
+{
+    AwaError result = AwaError_Unspecified;
+
+    IPCResponseCode responseCode = IPCMessage_GetResponseCode(response);
+    if (responseCode == IPCResponseCode_Success)
+    {
+        // Free an old Write response record if it exists
+        if (operation->Response != NULL)
+        {
+            ServerResponse_Free(&operation->Response);
+        }
+
+        // Detach the response's content and add it to the Server Response
+        TreeNode contentNode = IPCMessage_GetContentNode(response);
+        TreeNode clientsNode = Xml_Find(contentNode, "Clients");
+        operation->Response = ServerResponse_NewFromServerOperation(operation->ServerOperation, clientsNode);
+
+        LogDebug("Perform Write Operation successful");
+
+        result = ServerResponse_CheckForErrors(operation->Response);
+    }
+    else if (responseCode == IPCResponseCode_FailureBadRequest)
+    {
+        result = LogErrorWithEnum(AwaError_IPCError, "Unable to perform Write operation: Bad Request");
+    }
+    else
+    {
+        result = LogErrorWithEnum(AwaError_IPCError, "Unexpected IPC response code: %d", responseCode);
+    }
+    return result;
+}
+
+static AwaError ServerWriteOperation_AsyncResponseHandler(void * operation, IPCMessage * response)
+{
+    return ServerWriteOperation_ProcessResponse((AwaServerWriteOperation *)operation, response);
+}
+
+AwaError AwaServerWriteOperation_Perform(AwaServerWriteOperation * operation, const char * clientID, AwaTimeout timeout)
+{
+    AwaError result = AwaError_Unspecified;
+
+    if (timeout >= 0)
+    {
+        IPCMessage * request = NULL;
+        result = ServerWriteOperation_NewRequest(operation, clientID, &request);
+        if (result == AwaError_Success)
+        {
+            // Send via IPC
+            IPCMessage * response = NULL;
+            const AwaServerSession * session = (const AwaServerSession *)ServerOperation_GetSession(operation->ServerOperation);
+            result = IPC_SendAndReceive(ServerSession_GetChannel(session), request, &response, timeout);
+
+            // Process the response
+            if (result == AwaError_Success)
+            {
+                result = ServerWriteOperation_ProcessResponse(operation, response);
+            }
+
+            // Free allocated memory
+            IPCMessage_Free(&request);
+            IPCMessage_Free(&response);
+        }
+    }
+    else
+    {
+        result = LogErrorWithEnum(AwaError_OperationInvalid, "Invalid timeout specified");
+    }
+    return result;
+}
+
+AwaError AwaServerWriteOperation_PerformAsync(AwaServerWriteOperation * operation, const char * clientID, AwaTimeout timeout,
+                                             AwaOperationCompleteCallback callback, void * context, AwaRequestID * requestID)
+{
+    AwaError result = AwaError_Unspecified;
+
+    if (timeout >= 0)
+    {
+        IPCMessage * request = NULL;
+        result = ServerWriteOperation_NewRequest(operation, clientID, &request);
+        if (result == AwaError_Success)
+        {
+            const AwaServerSession * session = (const AwaServerSession *)ServerOperation_GetSession(operation->ServerOperation);
+            result = SessionCommon_SendAsyncRequest(ServerSession_GetSessionCommon(session), request, timeout,
+                                                    ServerWriteOperation_AsyncResponseHandler, operation, callback, context, requestID);
+            IPCMessage_Free(&request);
         }
     }
     else
@@ -364,6 +417,28 @@ static AwaError ServerWriteOperation_AddValue(AwaServerWriteOperation * operatio
     return result;
 }
 
+static AwaError ServerWriteOperation_AddValueByID(AwaServerWriteOperation * operation, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, void * value, size_t size, AwaResourceType type)
+{
+    AwaError result = AwaError_Unspecified;
+    if (operation != NULL)
+    {
+        PathKey key;
+        if (PathKey_Make(&key, objectID, objectInstanceID, resourceID) && PathKey_IsResource(&key))
+        {
+            result = SetWriteCommon_AddValueByKey(ServerOperation_GetDefaultClientOperation(operation->ServerOperation), SessionType_Server, &key, 0, value, size, type, SetArrayMode_Unspecified);
+        }
+        else
+        {
+            result = LogErrorWithEnum(AwaError_PathInvalid, "IDs %d/%d/%d do not identify a resource", objectID, objectInstanceID, resourceID);
+        }
+    }
+    else
+    {
+        result = LogErrorWithEnum(AwaError_OperationInvalid, "operation is NULL");
+    }
+    return result;
+}
+
 static AwaError ServerWriteOperation_AddValues(AwaServerWriteOperation * operation, const char * path, const AwaArray * array, AwaResourceType type)
 {
     AwaError result = AwaError_Unspecified;
@@ -428,6 +503,50 @@ AwaError AwaServerWriteOperation_AddValueAsCString(AwaServerWriteOperation * ope
     return result;
 }
 
+AwaError AwaServerWriteOperation_AddValueAsCStringByID(AwaServerWriteOperation * operation, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, const char * value)
+{
+    AwaError result = AwaError_Unspecified;
+    if (value != NULL)
+    {
+        result = ServerWriteOperation_AddValueByID(operation, objectID, objectInstanceID, resourceID, (void *)value, strlen(value), AwaResourceType_String);
+    }
+    else
+    {
+        result = LogErrorWithEnum(AwaError_TypeMismatch, "value is NULL");
+    }
+    return result;
+}
+
+AwaError AwaServerWriteOperation_AddValueAsIntegerByID(AwaServerWriteOperation * operation, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, AwaInteger value)
+{
+    return ServerWriteOperation_AddValueByID(operation, objectID, objectInstanceID, resourceID, (void *)&value, sizeof(AwaInteger), AwaResourceType_Integer);
+}
+
+AwaError AwaServerWriteOperation_AddValueAsFloatByID(AwaServerWriteOperation * operation, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, AwaFloat value)
+{
+    return ServerWriteOperation_AddValueByID(operation, objectID, objectInstanceID, resourceID, (void *)&value, sizeof(AwaFloat), AwaResourceType_Float);
+}
+
+AwaError AwaServerWriteOperation_AddValueAsBooleanByID(AwaServerWriteOperation * operation, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, AwaBoolean value)
+{
+    return ServerWriteOperation_AddValueByID(operation, objectID, objectInstanceID, resourceID, (void *)&value, sizeof(AwaBoolean), AwaResourceType_Boolean);
+}
+
+AwaError AwaServerWriteOperation_AddValueAsTimeByID(AwaServerWriteOperation * operation, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, AwaTime value)
+{
+    return ServerWriteOperation_AddValueByID(operation, objectID, objectInstanceID, resourceID, (void *)&value, sizeof(AwaTime), AwaResourceType_Time);
+}
+
+AwaError AwaServerWriteOperation_AddValueAsOpaqueByID(AwaServerWriteOperation * operation, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, AwaOpaque value)
+{
+    return ServerWriteOperation_AddValueByID(operation, objectID, objectInstanceID, resourceID, value.Data, value.Size, AwaResourceType_Opaque);
+}
+
+AwaError AwaServerWriteOperation_AddValueAsObjectLinkByID(AwaServerWriteOperation * operation, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, AwaObjectLink value)
+{
+    return ServerWriteOperation_AddValueByID(operation, objectID, objectInstanceID, resourceID, (void *)&value, sizeof(AwaObjectLink), AwaResourceType_ObjectLink);
+}
+
 AwaError AwaServerWriteOperation_AddValueAsStringArray(AwaServerWriteOperation * operation, const char * path, const AwaStringArray * array)
 {
     return ServerWriteOperation_AddValues(operation, path, (const AwaArray *)array, AwaResourceType_StringArray);
@@ -21,6 +21,7 @@
 ************************************************************************************************************************/
 
 #include <gtest/gtest.h>
+#include <poll.h>
 
 #include <lwm2m_tree_node.h>
 
@@ -258,6 +259,49 @@ TEST_F(TestGetOperationWithConnectedSession, AwaClientGetOperation_Perform_handl
     ASSERT_EQ(AwaError_OperationInvalid, AwaClientGetOperation_Perform(NULL, global::timeout));
 }
 
+static void AsyncGetCallback(AwaRequestID requestID, AwaError result, void * context)
+{
+    *static_cast<AwaError *>(context) = result;
+}
+
+TEST_F(TestGetOperationWithConnectedSession, AwaClientGetOperation_PerformAsync_handles_valid_operation)
+{
+    AwaClientGetOperation * getOperation = AwaClientGetOperation_New(session_);
+    ASSERT_TRUE(NULL != getOperation);
+    ASSERT_EQ(AwaError_Success, AwaClientGetOperation_AddPath(getOperation, "/3/0/1"));
+
+    AwaError result = AwaError_Unspecified;
+    ASSERT_EQ(AwaError_Success, AwaClientGetOperation_PerformAsync(getOperation, global::timeout, AsyncGetCallback, &result, NULL));
+
+    // the session's file descriptor becomes readable when the response arrives
+    int fd = AwaClientSession_GetFileDescriptor(session_);
+    ASSERT_GE(fd, 0);
+    struct pollfd pollFd = { fd, POLLIN, 0 };
+    ASSERT_EQ(1, poll(&pollFd, 1, global::timeout));
+
+    ASSERT_EQ(AwaError_Success, AwaClientSession_Process(session_, 0));
+    ASSERT_EQ(AwaError_Success, AwaClientSession_DispatchCallbacks(session_));
+    EXPECT_EQ(AwaError_Success, result);
+
+    const AwaClientGetResponse * getResponse = AwaClientGetOperation_GetResponse(getOperation);
+    ASSERT_TRUE(NULL != getResponse);
+    EXPECT_TRUE(AwaClientGetResponse_ContainsPath(getResponse, "/3/0/1"));
+    AwaClientGetOperation_Free(&getOperation);
+}
+
+TEST_F(TestGetOperationWithConnectedSession, AwaClientGetOperation_PerformAsync_handles_null_operation)
+{
+    ASSERT_EQ(AwaError_OperationInvalid, AwaClientGetOperation_PerformAsync(NULL, global::timeout, NULL, NULL, NULL));
+}
+
+TEST_F(TestGetOperation, AwaClientSession_GetFileDescriptor_handles_unconnected_session)
+{
+    EXPECT_EQ(-1, AwaClientSession_GetFileDescriptor(NULL));
+    AwaClientSession * session = AwaClientSession_New();
+    EXPECT_EQ(-1, AwaClientSession_GetFileDescriptor(session));
+    AwaClientSession_Free(&session);
+}
+
 TEST_F(TestGetOperationWithConnectedSession, AwaClientGetOperation_Perform_handles_negative_timeout)
 {
     AwaClientGetOperation * getOperation = AwaClientGetOperation_New(session_);
@@ -797,6 +841,44 @@ TEST_F(TestGetOperationWithConnectedSession, AwaClientGetResponse_HasValue_handl
     AwaClientGetOperation_Free(&getOperation);
 }
 
+TEST_F(TestGetOperationWithConnectedSession, AwaClientGetOperation_AddPathByID_handles_invalid_IDs)
+{
+    AwaClientGetOperation * getOperation = AwaClientGetOperation_New(session_);
+    ASSERT_TRUE(NULL != getOperation);
+    EXPECT_EQ(AwaError_PathInvalid, AwaClientGetOperation_AddPathByID(getOperation, AWA_INVALID_ID, 0, 0));
+    EXPECT_EQ(AwaError_PathInvalid, AwaClientGetOperation_AddPathByID(getOperation, 3, AWA_INVALID_ID, 1));
+    EXPECT_EQ(AwaError_OperationInvalid, AwaClientGetOperation_AddPathByID(NULL, 3, 0, 1));
+    AwaClientGetOperation_Free(&getOperation);
+}
+
+TEST_F(TestGetOperationWithConnectedSession, AwaClientGetResponse_ByID_matches_path_lookup)
+{
+    AwaClientGetOperation * getOperation = AwaClientGetOperation_New(session_);
+    ASSERT_TRUE(NULL != getOperation);
+    ASSERT_EQ(AwaError_Success, AwaClientGetOperation_AddPathByID(getOperation, 3, 0, AWA_INVALID_ID));
+    ASSERT_EQ(AwaError_Success, AwaClientGetOperation_Perform(getOperation, global::timeout));
+    const AwaClientGetResponse * getResponse = AwaClientGetOperation_GetResponse(getOperation);
+    ASSERT_TRUE(NULL != getResponse);
+
+    EXPECT_TRUE(AwaClientGetResponse_HasValueByID(getResponse, 3, 0, 1));
+    EXPECT_FALSE(AwaClientGetResponse_HasValueByID(getResponse, 3, 0, AWA_INVALID_ID));
+    EXPECT_FALSE(AwaClientGetResponse_HasValueByID(getResponse, 3, 1, 1));
+
+    const char * byPath = NULL;
+    const char * byID = NULL;
+    ASSERT_EQ(AwaError_Success, AwaClientGetResponse_GetValueAsCStringPointer(getResponse, "/3/0/1", &byPath));
+    ASSERT_EQ(AwaError_Success, AwaClientGetResponse_GetValueAsCStringPointerByID(getResponse, 3, 0, 1, &byID));
+    EXPECT_STREQ(byPath, byID);
+
+    const AwaInteger * integer = NULL;
+    EXPECT_EQ(AwaError_TypeMismatch, AwaClientGetResponse_GetValueAsIntegerPointerByID(getResponse, 3, 0, 1, &integer));
+    EXPECT_EQ(AwaError_PathNotFound, AwaClientGetResponse_GetValueAsIntegerPointerByID(getResponse, 3, 1, 9, &integer));
+    EXPECT_EQ(AwaError_PathInvalid, AwaClientGetResponse_GetValueAsIntegerPointerByID(getResponse, 3, 0, AWA_INVALID_ID, &integer));
+    EXPECT_TRUE(NULL == integer);
+
+    AwaClientGetOperation_Free(&getOperation);
+}
+
 TEST_F(TestGetOperationWithConnectedSession, AwaClientGetResponse_ContainsPath_handles_null_response)
 {
     ASSERT_FALSE(AwaClientGetResponse_ContainsPath(NULL, "/3/0/1"));
@@ -273,6 +273,36 @@ TEST_F(TestSetOperationWithConnectedSession, AwaClientSetOperation_AddValueAsInt
 }
 
 
+TEST_F(TestSetOperationWithConnectedSession, AwaClientSetOperation_AddValueAsIntegerByID_handles_resources)
+{
+    AwaClientSetOperation * setOperation = AwaClientSetOperation_New(session_); ASSERT_TRUE(NULL != setOperation);
+    AwaInteger value = 123456789;
+    EXPECT_EQ(AwaError_Success, AwaClientSetOperation_AddValueAsIntegerByID(setOperation, 3, 0, 9, value));
+    EXPECT_EQ(AwaError_NotDefined, AwaClientSetOperation_AddValueAsIntegerByID(setOperation, 99, 0, 9, value));
+    EXPECT_EQ(AwaError_TypeMismatch, AwaClientSetOperation_AddValueAsIntegerByID(setOperation, 3, 0, 0, value));
+    EXPECT_EQ(AwaError_PathInvalid, AwaClientSetOperation_AddValueAsIntegerByID(setOperation, 1, 12, AWA_INVALID_ID, value));
+    EXPECT_EQ(AwaError_OperationInvalid, AwaClientSetOperation_AddValueAsIntegerByID(NULL, 3, 0, 9, value));
+    AwaClientSetOperation_Free(&setOperation);
+}
+
+TEST_F(TestSetOperationWithConnectedSession, AwaClientSetOperation_AddValueAsCStringByID_round_trips)
+{
+    AwaClientSetOperation * setOperation = AwaClientSetOperation_New(session_); ASSERT_TRUE(NULL != setOperation);
+    EXPECT_EQ(AwaError_Success, AwaClientSetOperation_AddValueAsCStringByID(setOperation, 3, 0, 0, "Imagination"));
+    EXPECT_EQ(AwaError_TypeMismatch, AwaClientSetOperation_AddValueAsCStringByID(setOperation, 3, 0, 1, NULL));
+    ASSERT_EQ(AwaError_Success, AwaClientSetOperation_Perform(setOperation, global::timeout));
+    AwaClientSetOperation_Free(&setOperation);
+
+    AwaClientGetOperation * getOperation = AwaClientGetOperation_New(session_); ASSERT_TRUE(NULL != getOperation);
+    ASSERT_EQ(AwaError_Success, AwaClientGetOperation_AddPathByID(getOperation, 3, 0, 0));
+    ASSERT_EQ(AwaError_Success, AwaClientGetOperation_Perform(getOperation, global::timeout));
+    const AwaClientGetResponse * getResponse = AwaClientGetOperation_GetResponse(getOperation); ASSERT_TRUE(NULL != getResponse);
+    const char * value = NULL;
+    ASSERT_EQ(AwaError_Success, AwaClientGetResponse_GetValueAsCStringPointerByID(getResponse, 3, 0, 0, &value));
+    EXPECT_STREQ("Imagination", value);
+    AwaClientGetOperation_Free(&getOperation);
+}
+
 TEST_F(TestSetOperationWithConnectedSession, AwaClientSetOperation_AddValueAsCString_handles_null_value)
 {
     AwaClientSetOperation * setOperation = AwaClientSetOperation_New(session_); ASSERT_TRUE(NULL != setOperation);
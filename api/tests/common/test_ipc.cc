@@ -296,6 +296,56 @@ TEST_F(TestIPC, IPC_SerialiseMessageToXML_called_twice)
 #undef EXPECTED_XML_PATH
 }
 
+TEST_F(TestIPC, IPC_SerialiseMessage_handles_binary_encoding)
+{
+    IPCMessage * message = IPCMessage_NewPlus(IPC_MESSAGE_TYPE_REQUEST, IPC_MESSAGE_SUB_TYPE_GET, 1234);
+    EXPECT_EQ(InternalError_Success, IPCMessage_SetRequestID(message, 7));
+
+    size_t length = 0;
+    char * buffer = IPC_SerialiseMessage(message, IPCEncoding_Binary, &length);
+    ASSERT_TRUE(NULL != buffer);
+    ASSERT_GT(length, 0u);
+
+    size_t xmlLength = 0;
+    char * xmlBuffer = IPC_SerialiseMessage(message, IPCEncoding_XML, &xmlLength);
+    ASSERT_TRUE(NULL != xmlBuffer);
+    EXPECT_EQ(strlen(xmlBuffer), xmlLength);
+    EXPECT_LT(length, xmlLength);
+
+    // either encoding is accepted
+    IPCMessage * binaryMessage = IPC_DeserialiseMessage(buffer, length);
+    IPCMessage * xmlMessage = IPC_DeserialiseMessage(xmlBuffer, xmlLength);
+    ASSERT_TRUE(NULL != binaryMessage);
+    ASSERT_TRUE(NULL != xmlMessage);
+    for (IPCMessage * received : { binaryMessage, xmlMessage })
+    {
+        const char * type = NULL;
+        const char * subType = NULL;
+        EXPECT_EQ(InternalError_Success, IPCMessage_GetType(received, &type, &subType));
+        EXPECT_STREQ(IPC_MESSAGE_TYPE_REQUEST, type);
+        EXPECT_STREQ(IPC_MESSAGE_SUB_TYPE_GET, subType);
+        EXPECT_EQ(1234, IPCMessage_GetSessionID(received));
+        EXPECT_EQ(7, IPCMessage_GetRequestID(received));
+    }
+
+    IPCMessage_Free(&binaryMessage);
+    IPCMessage_Free(&xmlMessage);
+    Awa_MemSafeFree(buffer);
+    Awa_MemSafeFree(xmlBuffer);
+    IPCMessage_Free(&message);
+}
+
+TEST_F(TestIPC, IPC_DeserialiseMessage_handles_truncated_binary_message)
+{
+    IPCMessage * message = IPCMessage_NewPlus(IPC_MESSAGE_TYPE_REQUEST, IPC_MESSAGE_SUB_TYPE_GET, 1234);
+    size_t length = 0;
+    char * buffer = IPC_SerialiseMessage(message, IPCEncoding_Binary, &length);
+    ASSERT_TRUE(NULL != buffer);
+    EXPECT_EQ(NULL, IPC_DeserialiseMessage(buffer, length - 1));
+    Awa_MemSafeFree(buffer);
+    IPCMessage_Free(&message);
+}
+
 TEST_F(TestIPC, IPC_SendAndReceive_handles_null_channel)
 {
     IPCMessage * request = IPCMessage_New();
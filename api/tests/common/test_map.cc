@@ -26,6 +26,8 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <chrono>
+#include <cstdio>
 
 #include "memalloc.h"
 #include "map.h"
@@ -223,4 +225,114 @@ TEST_F(TestMap, Map_ForEach_handles_null)
     Map_Free(&map);
 }
 
+TEST_F(TestMap, Map_ForEach_visits_in_insertion_order)
+{
+    MapType * map = Map_New();
+    std::vector<int> items(100);
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < items.size(); ++i)
+    {
+        // descending keys, so neither the key nor the hash order matches insertion order
+        keys.push_back("/3/0/" + std::to_string(items.size() - i));
+        ASSERT_TRUE(Map_Put(map, keys.back().c_str(), &items[i]));
+    }
+
+    // replacing a value keeps the original position, removing and re-adding moves it to the end
+    EXPECT_TRUE(Map_Put(map, keys[10].c_str(), &items[10]));
+    EXPECT_EQ(&items[20], Map_Remove(map, keys[20].c_str()));
+    EXPECT_TRUE(Map_Put(map, keys[20].c_str(), &items[20]));
+
+    std::vector<detail::TestItem> expectedItems;
+    for (size_t i = 0; i < items.size(); ++i)
+    {
+        if (i != 20)
+            expectedItems.push_back(detail::TestItem { keys[i], &items[i] });
+    }
+    expectedItems.push_back(detail::TestItem { keys[20], &items[20] });
+
+    detail::gActualItems.clear();
+    EXPECT_EQ(items.size(), Map_ForEach(map, detail::TestForEach, NULL));
+    EXPECT_EQ(expectedItems, detail::gActualItems);
+
+    Map_Free(&map);
+}
+
+TEST_F(TestMap, Map_handles_many_keys)
+{
+    MapType * map = Map_New();
+    const int count = 10000;
+    std::vector<int> items(count);
+    char key[32];
+
+    for (int i = 0; i < count; ++i)
+    {
+        sprintf(key, "/%d/%d/%d", i % 7, i / 7, i);
+        ASSERT_TRUE(Map_Put(map, key, &items[i]));
+    }
+    EXPECT_EQ(static_cast<size_t>(count), Map_Length(map));
+
+    for (int i = 0; i < count; ++i)
+    {
+        sprintf(key, "/%d/%d/%d", i % 7, i / 7, i);
+        int * value = NULL;
+        ASSERT_TRUE(Map_Get(map, key, (void **)&value));
+        EXPECT_EQ(&items[i], value);
+    }
+    EXPECT_FALSE(Map_Contains(map, "/0/0/1"));
+
+    for (int i = 0; i < count; i += 2)
+    {
+        sprintf(key, "/%d/%d/%d", i % 7, i / 7, i);
+        EXPECT_EQ(&items[i], Map_Remove(map, key));
+    }
+    EXPECT_EQ(static_cast<size_t>(count / 2), Map_Length(map));
+    for (int i = 0; i < count; ++i)
+    {
+        sprintf(key, "/%d/%d/%d", i % 7, i / 7, i);
+        EXPECT_EQ(i % 2 != 0, Map_Contains(map, key));
+    }
+
+    Map_Free(&map);
+}
+
+// Builds a map of paths the way ResponseCommon does (Contains then Put), then reads every value back.
+static double MeasureBuildAndLookupNs(int count)
+{
+    std::vector<std::string> keys;
+    for (int i = 0; i < count; ++i)
+    {
+        keys.push_back("/3/" + std::to_string(i / 10) + "/" + std::to_string(i % 10));
+    }
+    int item = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    MapType * map = Map_New();
+    for (const auto & key : keys)
+    {
+        if (!Map_Contains(map, key.c_str()))
+        {
+            Map_Put(map, key.c_str(), &item);
+        }
+    }
+    int found = 0;
+    for (const auto & key : keys)
+    {
+        void * value = NULL;
+        found += Map_Get(map, key.c_str(), &value) ? 1 : 0;
+    }
+    Map_Free(&map);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(count, found);
+    return std::chrono::duration<double, std::nano>(elapsed).count() / count;
+}
+
+TEST_F(TestMap, Benchmark_put_and_get_cost_is_flat)
+{
+    double small = MeasureBuildAndLookupNs(100);
+    double medium = MeasureBuildAndLookupNs(10000);
+    double large = MeasureBuildAndLookupNs(100000);
+    printf("Map build and lookup per path: 100 paths %.1f ns, 10k paths %.1f ns, 100k paths %.1f ns\n", small, medium, large);
+}
+
 } // namespace Awa
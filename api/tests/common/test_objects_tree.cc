@@ -21,6 +21,8 @@
 ************************************************************************************************************************/
 
 #include <gtest/gtest.h>
+#include <chrono>
+#include <vector>
 #include "../src/objects_tree.h"
 
 #include "support/support.h"
@@ -1350,4 +1352,54 @@ TEST_F(TestObjectsTree, ObjectsTree_ObjectsTree_GetNumChildrenWithName_handles_v
     Tree_Delete(objectsNode);
 }
 
+// Build an object with numInstances instances, serialise it, parse it back and find every instance.
+static double MeasureRoundTripNs(int numInstances)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    TreeNode objectsNode = ObjectsTree_New();
+    for (int i = 0; i < numInstances; ++i)
+    {
+        char path[32];
+        sprintf(path, "/3/%d/9", i);
+        EXPECT_EQ(InternalError_Success, ObjectsTree_AddPath(objectsNode, path, NULL));
+    }
+
+    std::vector<char> buffer(numInstances * 128 + 1024);
+    Xml_TreeToString(objectsNode, buffer.data(), buffer.size());
+    TreeNode parsedNode = TreeNode_ParseXML((uint8_t *)buffer.data(), strlen(buffer.data()), true);
+    EXPECT_TRUE(NULL != parsedNode);
+
+    TreeNode objectNode = NULL;
+    EXPECT_EQ(InternalError_Success, ObjectsTree_FindPathNode(parsedNode, "/3", &objectNode));
+    EXPECT_EQ(static_cast<size_t>(numInstances), ObjectsTree_GetNumChildrenWithName(objectNode, "ObjectInstance"));
+    for (int i = numInstances - 1; i >= 0; --i)
+    {
+        char path[32];
+        sprintf(path, "/3/%d/9", i);
+        TreeNode resourceNode = NULL;
+        EXPECT_EQ(InternalError_Success, ObjectsTree_FindPathNode(parsedNode, path, &resourceNode)) << path;
+        ObjectIDType objectID = -1;
+        ObjectInstanceIDType objectInstanceID = -1;
+        ResourceIDType resourceID = -1;
+        ObjectsTree_GetIDsFromLeafNode(resourceNode, &objectID, &objectInstanceID, &resourceID);
+        EXPECT_EQ(3, objectID);
+        EXPECT_EQ(i, objectInstanceID);
+        EXPECT_EQ(9, resourceID);
+    }
+
+    Tree_Delete(parsedNode);
+    Tree_Delete(objectsNode);
+
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / numInstances;
+}
+
+TEST_F(TestObjectsTree, ObjectsTree_handles_object_with_many_instances)
+{
+    double small = MeasureRoundTripNs(100);
+    double large = MeasureRoundTripNs(10000);
+    printf("Objects tree round trip per instance: 100 instances %.0f ns, 10k instances %.0f ns\n", small, large);
+}
+
 } // namespace Awa
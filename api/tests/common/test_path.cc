@@ -451,6 +451,48 @@ TEST_F(TestPath, AwaAPI_IsPathValid_handles_invalid_path)
     EXPECT_FALSE(AwaAPI_IsPathValid("root/Device/0/Manufacturer"));
 }
 
+TEST_F(TestPath, PathKey_Parse_accepts_exactly_the_valid_paths)
+{
+    const char * paths[] = { "/0", "/0/0", "/0/0/0", "/65535/65535/65535", "", "/", "0", "/0/", "//0/1/2", "/0/1/2/3",
+                             "/a/b/c", "/3/0/d", "/70000/0/0", "/0/0/-1", "/+3/0/0", "/03/0/0", "root/0/1/2" };
+    for (size_t i = 0; i < sizeof(paths) / sizeof(paths[0]); ++i)
+    {
+        PathKey key;
+        EXPECT_EQ(Path_IsValid(paths[i]), PathKey_Parse(&key, paths[i])) << paths[i];
+    }
+}
+
+TEST_F(TestPath, PathKey_Parse_and_Make_agree)
+{
+    PathKey parsed, made;
+    ASSERT_TRUE(PathKey_Parse(&parsed, "/3/0/9"));
+    ASSERT_TRUE(PathKey_Make(&made, 3, 0, 9));
+    EXPECT_TRUE(PathKey_Equals(&parsed, &made));
+    EXPECT_EQ(PathKey_Hash(&parsed), PathKey_Hash(&made));
+    EXPECT_TRUE(PathKey_IsResource(&made));
+    EXPECT_EQ(3, PathKey_GetObjectID(&made));
+    EXPECT_EQ(0, PathKey_GetObjectInstanceID(&made));
+    EXPECT_EQ(9, PathKey_GetResourceID(&made));
+
+    char path[MAX_PATH_LENGTH];
+    EXPECT_EQ(AwaError_Success, PathKey_Format(&made, path, sizeof(path)));
+    EXPECT_STREQ("/3/0/9", path);
+
+    ASSERT_TRUE(PathKey_Make(&made, 3, 0, AWA_INVALID_ID));
+    EXPECT_FALSE(PathKey_Equals(&parsed, &made));
+    EXPECT_FALSE(PathKey_IsResource(&made));
+    EXPECT_EQ(AWA_INVALID_ID, PathKey_GetResourceID(&made));
+}
+
+TEST_F(TestPath, PathKey_Make_handles_invalid_IDs)
+{
+    PathKey key;
+    EXPECT_FALSE(PathKey_Make(&key, AWA_INVALID_ID, 0, 0));
+    EXPECT_FALSE(PathKey_Make(&key, 3, AWA_INVALID_ID, 0));
+    EXPECT_FALSE(PathKey_Make(&key, 70000, 0, 0));
+    EXPECT_FALSE(PathKey_Make(&key, 3, 0, -2));
+    EXPECT_EQ(0, key.Depth);
+}
 
 
 } // namespace Awa
@@ -21,6 +21,8 @@
 ************************************************************************************************************************/
 
 #include <gtest/gtest.h>
+#include <chrono>
+#include <string>
 #include "../src/objects_tree.h"
 
 #include "response_common.h"
@@ -154,6 +156,51 @@ TEST_F(TestResponseCommonWithConnectedSession, ResponseCommon_GetPathResult_vali
     ASSERT_TRUE(Tree_Delete(objectsNode));
 }
 
+TEST_F(TestResponseCommonWithConnectedSession, ResponseCommon_GetPathResult_for_parents_of_several_leaves)
+{
+    OperationCommon * operation = OperationCommon_New(session_, SessionType_Client);
+
+    const char * xml =
+            "<Objects>"
+            "  <Object>"
+            "    <ID>3</ID>"
+            "    <Result><Error>AwaError_Success</Error></Result>"
+            "    <ObjectInstance>"
+            "      <ID>0</ID>"
+            "      <Result><Error>AwaError_PathNotFound</Error></Result>"
+            "      <Resource><ID>1</ID><Result><Error>AwaError_Success</Error></Result></Resource>"
+            "      <Resource><ID>2</ID><Result><Error>AwaError_DefinitionInvalid</Error></Result></Resource>"
+            "    </ObjectInstance>"
+            "    <ObjectInstance>"
+            "      <ID>1</ID>"
+            "      <Result><Error>AwaError_Success</Error></Result>"
+            "      <Resource><ID>1</ID></Resource>"
+            "    </ObjectInstance>"
+            "  </Object>"
+            "</Objects>";
+
+    TreeNode objectsNode = TreeNode_ParseXML((uint8_t*)xml, strlen(xml), true);
+    ASSERT_TRUE(NULL != objectsNode);
+
+    ResponseCommon * response = ResponseCommon_New(operation, objectsNode);
+    ASSERT_TRUE(NULL != response);
+
+    const PathResult * result;
+    ASSERT_EQ(AwaError_Success, ResponseCommon_GetPathResult(response, "/3", &result));
+    EXPECT_EQ(AwaError_Success, PathResult_GetError(result));
+    ASSERT_EQ(AwaError_Success, ResponseCommon_GetPathResult(response, "/3/0", &result));
+    EXPECT_EQ(AwaError_PathNotFound, PathResult_GetError(result));
+    ASSERT_EQ(AwaError_Success, ResponseCommon_GetPathResult(response, "/3/0/2", &result));
+    EXPECT_EQ(AwaError_DefinitionInvalid, PathResult_GetError(result));
+    ASSERT_EQ(AwaError_Success, ResponseCommon_GetPathResult(response, "/3/1", &result));
+    EXPECT_EQ(AwaError_Success, PathResult_GetError(result));
+    EXPECT_NE(AwaError_Success, ResponseCommon_GetPathResult(response, "/3/1/1", &result));
+
+    OperationCommon_Free(&operation);
+    ResponseCommon_Free(&response);
+    Tree_Delete(objectsNode);
+}
+
 TEST_F(TestResponseCommonWithConnectedSession, ResponseCommon_NewPathIterator_invalid_input)
 {
     ASSERT_TRUE(NULL == ResponseCommon_NewPathIterator(NULL));
@@ -493,4 +540,77 @@ TEST_F(TestResponseCommonWithConnectedSession, ResponseCommon_ContainsPath_handl
 }
 
 
+// Build a response with one integer resource per instance of the Device object, each with a value and a path result.
+static double MeasureResponseBuildNs(AwaClientSession * session, int numPaths)
+{
+    std::string xml = "<Objects><Object><ID>3</ID>";
+    for (int i = 0; i < numPaths; ++i)
+    {
+        xml += "<ObjectInstance><ID>" + std::to_string(i) + "</ID><Resource><ID>9</ID><Value>42</Value>"
+               "<Result><Error>AwaError_Success</Error></Result></Resource></ObjectInstance>";
+    }
+    xml += "</Object></Objects>";
+    TreeNode objectsNode = TreeNode_ParseXML((uint8_t*)xml.c_str(), xml.length(), true);
+    OperationCommon * operation = OperationCommon_New(session, SessionType_Client);
+
+    auto start = std::chrono::steady_clock::now();
+    ResponseCommon * response = ResponseCommon_New(operation, objectsNode);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    char path[32];
+    sprintf(path, "/3/%d/9", numPaths - 1);
+    EXPECT_TRUE(ResponseCommon_HasValue(response, path));
+
+    OperationCommon_Free(&operation);
+    ResponseCommon_Free(&response);
+    Tree_Delete(objectsNode);
+    return std::chrono::duration<double, std::nano>(elapsed).count() / numPaths;
+}
+
+TEST_F(TestResponseCommonWithConnectedSession, Benchmark_large_response_build_cost_per_path)
+{
+    double small = MeasureResponseBuildNs(session_, 100);
+    double large = MeasureResponseBuildNs(session_, 10000);
+    printf("ResponseCommon_New per path: 100 paths %.0f ns, 10k paths %.0f ns\n", small, large);
+}
+
+TEST_F(TestResponseCommonWithConnectedSession, Benchmark_lookup_by_key_skips_path_formatting)
+{
+    const int numPaths = 1000;
+    std::string xml = "<Objects><Object><ID>3</ID>";
+    for (int i = 0; i < numPaths; ++i)
+    {
+        xml += "<ObjectInstance><ID>" + std::to_string(i) + "</ID><Resource><ID>9</ID><Value>42</Value></Resource></ObjectInstance>";
+    }
+    xml += "</Object></Objects>";
+    TreeNode objectsNode = TreeNode_ParseXML((uint8_t*)xml.c_str(), xml.length(), true);
+    OperationCommon * operation = OperationCommon_New(session_, SessionType_Client);
+    ResponseCommon * response = ResponseCommon_New(operation, objectsNode);
+    const AwaInteger * value = NULL;
+
+    // callers iterating instances must build each path string before looking it up
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < numPaths; ++i)
+    {
+        char path[MAX_PATH_LENGTH];
+        Path_MakePath(path, sizeof(path), 3, i, 9);
+        ASSERT_EQ(AwaError_Success, ResponseCommon_GetValuePointer(response, path, (const void **)&value, NULL, AwaResourceType_Integer, sizeof(AwaInteger)));
+    }
+    double byPath = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / numPaths;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < numPaths; ++i)
+    {
+        PathKey key;
+        PathKey_Make(&key, 3, i, 9);
+        ASSERT_EQ(AwaError_Success, ResponseCommon_GetValuePointerByKey(response, &key, (const void **)&value, NULL, AwaResourceType_Integer, sizeof(AwaInteger)));
+    }
+    double byKey = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / numPaths;
+    printf("ResponseCommon value lookup: by path %.0f ns, by key %.0f ns\n", byPath, byKey);
+
+    OperationCommon_Free(&operation);
+    ResponseCommon_Free(&response);
+    Tree_Delete(objectsNode);
+}
+
 } // namespace Awa
@@ -572,6 +572,11 @@ TEST_F(TestSessionCommonWithConnectedSession, SessionCommon_IsObjectDefined_hand
     EXPECT_FALSE(SessionCommon_IsObjectDefined(session_, 444));
 }
 
+TEST_F(TestSessionCommonWithConnectedSession, SessionCommon_ConnectSession_negotiates_binary_encoding)
+{
+    EXPECT_EQ(IPCEncoding_Binary, IPCChannel_GetEncoding(SessionCommon_GetChannel(session_)));
+}
+
 // difficult to unit test SessionCommon_GetSessionType
 
 // difficult to unit test SessionCommon_GetSessionID
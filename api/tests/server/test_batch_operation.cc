@@ -0,0 +1,156 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE 
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "awa/server.h"
+#include "awa/common.h"
+#include "support/support.h"
+#include "support/definition.h"
+
+namespace Awa {
+
+class TestBatchOperation : public TestServerBase {};
+
+class TestBatchOperationWithConnectedSession : public TestServerAndClientWithConnectedSession {};
+
+TEST_F(TestBatchOperation, AwaServerBatchOperation_New_handles_null_session)
+{
+    ASSERT_EQ(NULL, AwaServerBatchOperation_New(NULL));
+}
+
+TEST_F(TestBatchOperation, AwaServerBatchOperation_New_handles_invalid_session)
+{
+    // An invalid session is one that is not connected
+    AwaServerSession * session = AwaServerSession_New();
+    ASSERT_EQ(NULL, AwaServerBatchOperation_New(session));
+    AwaServerSession_Free(&session);
+}
+
+TEST_F(TestBatchOperation, AwaServerBatchOperation_functions_handle_null_batch)
+{
+    EXPECT_EQ(AwaError_OperationInvalid, AwaServerBatchOperation_AddReadOperation(NULL, NULL));
+    EXPECT_EQ(AwaError_OperationInvalid, AwaServerBatchOperation_AddWriteOperation(NULL, NULL, global::clientEndpointName));
+    EXPECT_EQ(AwaError_OperationInvalid, AwaServerBatchOperation_Perform(NULL, global::timeout));
+    EXPECT_EQ(AwaError_OperationInvalid, AwaServerBatchOperation_Free(NULL));
+}
+
+TEST_F(TestBatchOperationWithConnectedSession, AwaServerBatchOperation_handles_invalid_operations)
+{
+    AwaServerBatchOperation * batch = AwaServerBatchOperation_New(server_session_);
+    ASSERT_TRUE(NULL != batch);
+    AwaServerWriteOperation * writeOperation = AwaServerWriteOperation_New(server_session_, AwaWriteMode_Update);
+    ASSERT_TRUE(NULL != writeOperation);
+
+    EXPECT_EQ(AwaError_OperationInvalid, AwaServerBatchOperation_AddReadOperation(batch, NULL));
+    EXPECT_EQ(AwaError_OperationInvalid, AwaServerBatchOperation_AddWriteOperation(batch, NULL, global::clientEndpointName));
+    EXPECT_EQ(AwaError_OperationInvalid, AwaServerBatchOperation_AddWriteOperation(batch, writeOperation, NULL));
+    EXPECT_EQ(AwaError_OperationInvalid, AwaServerBatchOperation_Perform(batch, global::timeout));
+    EXPECT_EQ(AwaError_OperationInvalid, AwaServerBatchOperation_Perform(batch, -1));
+
+    AwaServerWriteOperation_Free(&writeOperation);
+    EXPECT_EQ(AwaError_Success, AwaServerBatchOperation_Free(&batch));
+    EXPECT_EQ(NULL, batch);
+}
+
+TEST_F(TestBatchOperationWithConnectedSession, AwaServerBatchOperation_Perform_handles_multiple_reads)
+{
+    const char * paths[] = { "/3/0/0", "/3/0/1", "/3/0/9" };
+    const size_t numPaths = sizeof(paths) / sizeof(paths[0]);
+    AwaServerReadOperation * readOperations[numPaths];
+
+    AwaServerBatchOperation * batch = AwaServerBatchOperation_New(server_session_);
+    ASSERT_TRUE(NULL != batch);
+    for (size_t i = 0; i < numPaths; ++i)
+    {
+        readOperations[i] = AwaServerReadOperation_New(server_session_);
+        ASSERT_TRUE(NULL != readOperations[i]);
+        EXPECT_EQ(AwaError_Success, AwaServerReadOperation_AddPath(readOperations[i], global::clientEndpointName, paths[i]));
+        EXPECT_EQ(AwaError_Success, AwaServerBatchOperation_AddReadOperation(batch, readOperations[i]));
+    }
+
+    EXPECT_EQ(AwaError_Success, AwaServerBatchOperation_Perform(batch, global::timeout));
+
+    for (size_t i = 0; i < numPaths; ++i)
+    {
+        const AwaServerReadResponse * readResponse = AwaServerReadOperation_GetResponse(readOperations[i], global::clientEndpointName);
+        ASSERT_TRUE(NULL != readResponse);
+        EXPECT_TRUE(AwaServerReadResponse_ContainsPath(readResponse, paths[i]));
+        EXPECT_TRUE(AwaServerReadResponse_HasValue(readResponse, paths[i]));
+        AwaServerReadOperation_Free(&readOperations[i]);
+    }
+    AwaServerBatchOperation_Free(&batch);
+}
+
+TEST_F(TestBatchOperationWithConnectedSession, AwaServerBatchOperation_Perform_handles_writes_then_read)
+{
+    ObjectDescription object = { 1000, "Object1000", 0, 2, {
+            ResourceDescription(0, "Resource0", AwaResourceType_Integer, 0, 1, AwaResourceOperations_ReadWrite),
+        }};
+    EXPECT_EQ(AwaError_Success, Define(client_session_, object));
+    EXPECT_EQ(AwaError_Success, Define(server_session_, object));
+
+    WaitForClientDefinition(AwaObjectDefinition_GetID(object.GetDefinition()));
+
+    AwaClientSetOperation * setOperation = AwaClientSetOperation_New(client_session_);
+    ASSERT_TRUE(NULL != setOperation);
+    EXPECT_EQ(AwaError_Success, AwaClientSetOperation_CreateObjectInstance(setOperation, "/1000/0"));
+    EXPECT_EQ(AwaError_Success, AwaClientSetOperation_CreateObjectInstance(setOperation, "/1000/1"));
+    EXPECT_EQ(AwaError_Success, AwaClientSetOperation_Perform(setOperation, global::timeout));
+    AwaClientSetOperation_Free(&setOperation);
+
+    // a single Write cannot span object instances, but a batch of Writes can
+    AwaServerWriteOperation * writeOperation0 = AwaServerWriteOperation_New(server_session_, AwaWriteMode_Update);
+    AwaServerWriteOperation * writeOperation1 = AwaServerWriteOperation_New(server_session_, AwaWriteMode_Update);
+    AwaServerReadOperation * readOperation = AwaServerReadOperation_New(server_session_);
+    ASSERT_TRUE(NULL != writeOperation0);
+    ASSERT_TRUE(NULL != writeOperation1);
+    ASSERT_TRUE(NULL != readOperation);
+    EXPECT_EQ(AwaError_Success, AwaServerWriteOperation_AddValueAsInteger(writeOperation0, "/1000/0/0", 1234));
+    EXPECT_EQ(AwaError_Success, AwaServerWriteOperation_AddValueAsInteger(writeOperation1, "/1000/1/0", 5678));
+    EXPECT_EQ(AwaError_Success, AwaServerReadOperation_AddPath(readOperation, global::clientEndpointName, "/1000/1/0"));
+
+    AwaServerBatchOperation * batch = AwaServerBatchOperation_New(server_session_);
+    ASSERT_TRUE(NULL != batch);
+    EXPECT_EQ(AwaError_Success, AwaServerBatchOperation_AddWriteOperation(batch, writeOperation0, global::clientEndpointName));
+    EXPECT_EQ(AwaError_Success, AwaServerBatchOperation_AddWriteOperation(batch, writeOperation1, global::clientEndpointName));
+    EXPECT_EQ(AwaError_Success, AwaServerBatchOperation_AddReadOperation(batch, readOperation));
+    EXPECT_EQ(AwaError_Success, AwaServerBatchOperation_Perform(batch, global::timeout));
+
+    EXPECT_TRUE(NULL != AwaServerWriteOperation_GetResponse(writeOperation0, global::clientEndpointName));
+    EXPECT_TRUE(NULL != AwaServerWriteOperation_GetResponse(writeOperation1, global::clientEndpointName));
+
+    // the read is performed after both writes
+    const AwaServerReadResponse * readResponse = AwaServerReadOperation_GetResponse(readOperation, global::clientEndpointName);
+    ASSERT_TRUE(NULL != readResponse);
+    const AwaInteger * value = NULL;
+    EXPECT_EQ(AwaError_Success, AwaServerReadResponse_GetValueAsIntegerPointer(readResponse, "/1000/1/0", &value));
+    ASSERT_TRUE(NULL != value);
+    EXPECT_EQ(5678, *value);
+
+    AwaServerBatchOperation_Free(&batch);
+    AwaServerReadOperation_Free(&readOperation);
+    AwaServerWriteOperation_Free(&writeOperation1);
+    AwaServerWriteOperation_Free(&writeOperation0);
+}
+
+} // namespace Awa
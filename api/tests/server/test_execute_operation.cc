@@ -605,18 +605,16 @@ TEST_F(TestExecuteOperationWithConnectedSessionNoClient, AwaServerExecuteOperati
     AwaServerExecuteOperation_Free(&operation);
 }
 
-TEST_F(TestExecuteOperationWithConnectedSessionNoClient, DISABLED_AwaServerExecuteOperation_handles_multiple_clients)
+TEST_F(TestExecuteOperationWithConnectedSessionNoClient, AwaServerExecuteOperation_handles_multiple_clients)
 {
-    // DISABLED because we don't support multiple ClientIDs in a single Execute operation at present.
-
     // start a client and wait for them to register with the server
     AwaClientDaemonHorde horde( { "TestClient1", "TestClient2", "TestClient3" }, 61000);
     ASSERT_TRUE(WaitForRegistration(session_, horde.GetClientIDs(), 1000));
 
     AwaServerExecuteOperation * operation = AwaServerExecuteOperation_New(session_);
-    EXPECT_EQ(AwaError_Success, AwaServerExecuteOperation_AddPath(operation, "TestClient1", "/3/0/0", NULL));
-    EXPECT_EQ(AwaError_Success, AwaServerExecuteOperation_AddPath(operation, "TestClient2", "/3/0/0", NULL));
-    EXPECT_EQ(AwaError_Success, AwaServerExecuteOperation_AddPath(operation, "TestClient3", "/3/0/0", NULL));
+    EXPECT_EQ(AwaError_Success, AwaServerExecuteOperation_AddPath(operation, "TestClient1", "/3/0/4", NULL));
+    EXPECT_EQ(AwaError_Success, AwaServerExecuteOperation_AddPath(operation, "TestClient2", "/3/0/4", NULL));
+    EXPECT_EQ(AwaError_Success, AwaServerExecuteOperation_AddPath(operation, "TestClient3", "/3/0/4", NULL));
     EXPECT_EQ(AwaError_Success, AwaServerExecuteOperation_Perform(operation, global::timeout));
 
     AwaClientIterator * iterator = AwaServerExecuteOperation_NewClientIterator(operation);
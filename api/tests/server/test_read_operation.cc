@@ -286,6 +286,74 @@ TEST_F(TestReadOperationWithConnectedSession, AwaServerReadOperation_Perform_han
     AwaServerReadOperation_Free(&readOperation);
 }
 
+namespace readDetail
+{
+
+struct AsyncResults
+{
+    int Completed;
+    AwaRequestID RequestIDs[2];
+    AwaError Results[2];
+};
+
+static void AsyncReadCallback(AwaRequestID requestID, AwaError result, void * context)
+{
+    AsyncResults * results = static_cast<AsyncResults *>(context);
+    if (results->Completed < 2)
+    {
+        results->RequestIDs[results->Completed] = requestID;
+        results->Results[results->Completed] = result;
+    }
+    results->Completed++;
+}
+
+} // namespace readDetail
+
+TEST_F(TestReadOperationWithConnectedSession, AwaServerReadOperation_PerformAsync_handles_null_operation)
+{
+    ASSERT_EQ(AwaError_OperationInvalid, AwaServerReadOperation_PerformAsync(NULL, global::timeout, NULL, NULL, NULL));
+}
+
+TEST_F(TestReadOperationWithConnectedSession, AwaServerReadOperation_PerformAsync_handles_concurrent_operations)
+{
+    AwaServerReadOperation * readOperation1 = AwaServerReadOperation_New(server_session_);
+    AwaServerReadOperation * readOperation2 = AwaServerReadOperation_New(server_session_);
+    ASSERT_TRUE(NULL != readOperation1);
+    ASSERT_TRUE(NULL != readOperation2);
+    ASSERT_EQ(AwaError_Success, AwaServerReadOperation_AddPath(readOperation1, global::clientEndpointName, "/3/0/1"));
+    ASSERT_EQ(AwaError_Success, AwaServerReadOperation_AddPath(readOperation2, global::clientEndpointName, "/3/0/2"));
+
+    readDetail::AsyncResults results = {};
+    AwaRequestID requestID1 = 0, requestID2 = 0;
+    ASSERT_EQ(AwaError_Success, AwaServerReadOperation_PerformAsync(readOperation1, global::timeout, readDetail::AsyncReadCallback, &results, &requestID1));
+    ASSERT_EQ(AwaError_Success, AwaServerReadOperation_PerformAsync(readOperation2, global::timeout, readDetail::AsyncReadCallback, &results, &requestID2));
+    EXPECT_GT(requestID1, 0);
+    EXPECT_GT(requestID2, 0);
+    EXPECT_NE(requestID1, requestID2);
+    EXPECT_EQ(0, results.Completed);
+
+    for (int i = 0; (i < 50) && (results.Completed < 2); ++i)
+    {
+        AwaServerSession_Process(server_session_, 100);
+        AwaServerSession_DispatchCallbacks(server_session_);
+    }
+    ASSERT_EQ(2, results.Completed);
+    EXPECT_EQ(AwaError_Success, results.Results[0]);
+    EXPECT_EQ(AwaError_Success, results.Results[1]);
+    EXPECT_TRUE((results.RequestIDs[0] == requestID1 && results.RequestIDs[1] == requestID2) ||
+                (results.RequestIDs[0] == requestID2 && results.RequestIDs[1] == requestID1));
+
+    const AwaServerReadResponse * readResponse1 = AwaServerReadOperation_GetResponse(readOperation1, global::clientEndpointName);
+    const AwaServerReadResponse * readResponse2 = AwaServerReadOperation_GetResponse(readOperation2, global::clientEndpointName);
+    ASSERT_TRUE(NULL != readResponse1);
+    ASSERT_TRUE(NULL != readResponse2);
+    EXPECT_TRUE(AwaServerReadResponse_ContainsPath(readResponse1, "/3/0/1"));
+    EXPECT_TRUE(AwaServerReadResponse_ContainsPath(readResponse2, "/3/0/2"));
+
+    AwaServerReadOperation_Free(&readOperation1);
+    AwaServerReadOperation_Free(&readOperation2);
+}
+
 TEST_F(TestReadOperationWithConnectedServerAndClientSession, AwaServerReadOperation_Perform_handles_Read_only_resource)
 {
     // should fail - resource is write only.
@@ -322,6 +390,77 @@ TEST_F(TestReadOperationWithConnectedServerAndClientSession, AwaServerReadOperat
     AwaServerReadOperation_Free(&readOperation);
 }
 
+TEST_F(TestReadOperationWithConnectedServerAndClientSession, AwaServerReadOperation_Perform_handles_resource_spanning_several_blocks)
+{
+    ObjectDescription object = { 1000, "Object1000", 0, 1, {
+            ResourceDescription(0, "Resource0", AwaResourceType_Opaque, 0, 1, AwaResourceOperations_ReadWrite),
+        }};
+    EXPECT_EQ(AwaError_Success, Define(client_session_, object));
+    EXPECT_EQ(AwaError_Success, Define(server_session_, object));
+
+    WaitForClientDefinition(AwaObjectDefinition_GetID(object.GetDefinition()));
+
+    // Larger than a single CoAP block, so the server must request the remaining blocks
+    std::vector<uint8_t> data(3000);
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = i % 251;
+    }
+    AwaOpaque value = { &data[0], data.size() };
+
+    AwaClientSetOperation * clientSet = AwaClientSetOperation_New(client_session_);
+    EXPECT_TRUE(clientSet != NULL);
+    EXPECT_EQ(AwaError_Success, AwaClientSetOperation_CreateObjectInstance(clientSet, "/1000/0"));
+    EXPECT_EQ(AwaError_Success, AwaClientSetOperation_CreateOptionalResource(clientSet, "/1000/0/0"));
+    EXPECT_EQ(AwaError_Success, AwaClientSetOperation_AddValueAsOpaque(clientSet, "/1000/0/0", value));
+    EXPECT_EQ(AwaError_Success, AwaClientSetOperation_Perform(clientSet, global::timeout));
+    AwaClientSetOperation_Free(&clientSet);
+
+    AwaServerReadOperation * readOperation = AwaServerReadOperation_New(server_session_);
+    ASSERT_TRUE(NULL != readOperation);
+
+    EXPECT_EQ(AwaError_Success, AwaServerReadOperation_AddPath(readOperation, global::clientEndpointName, "/1000/0/0"));
+    EXPECT_EQ(AwaError_Success, AwaServerReadOperation_Perform(readOperation, global::timeout));
+
+    const AwaServerReadResponse * readResponse = AwaServerReadOperation_GetResponse(readOperation, global::clientEndpointName);
+    ASSERT_TRUE(NULL != readResponse);
+
+    AwaOpaque readValue = { NULL, 0 };
+    EXPECT_EQ(AwaError_Success, AwaServerReadResponse_GetValueAsOpaque(readResponse, "/1000/0/0", &readValue));
+    ASSERT_EQ(data.size(), readValue.Size);
+    EXPECT_EQ(0, memcmp(&data[0], readValue.Data, data.size()));
+    AwaServerReadOperation_Free(&readOperation);
+}
+
+TEST_F(TestReadOperationWithConnectedServerAndClientSession, AwaServerReadResponse_ByID_matches_path_lookup)
+{
+    AwaServerReadOperation * readOperation = AwaServerReadOperation_New(server_session_);
+    ASSERT_TRUE(NULL != readOperation);
+
+    EXPECT_EQ(AwaError_PathInvalid, AwaServerReadOperation_AddPathByID(readOperation, global::clientEndpointName, 3, AWA_INVALID_ID, 0));
+    ASSERT_EQ(AwaError_Success, AwaServerReadOperation_AddPathByID(readOperation, global::clientEndpointName, 3, 0, AWA_INVALID_ID));
+    ASSERT_EQ(AwaError_Success, AwaServerReadOperation_Perform(readOperation, global::timeout));
+
+    const AwaServerReadResponse * readResponse = AwaServerReadOperation_GetResponse(readOperation, global::clientEndpointName);
+    ASSERT_TRUE(NULL != readResponse);
+
+    EXPECT_TRUE(AwaServerReadResponse_HasValueByID(readResponse, 3, 0, 0));
+    EXPECT_FALSE(AwaServerReadResponse_HasValueByID(readResponse, 3, 0, AWA_INVALID_ID));
+
+    const char * byPath = NULL;
+    const char * byID = NULL;
+    ASSERT_EQ(AwaError_Success, AwaServerReadResponse_GetValueAsCStringPointer(readResponse, "/3/0/0", &byPath));
+    ASSERT_EQ(AwaError_Success, AwaServerReadResponse_GetValueAsCStringPointerByID(readResponse, 3, 0, 0, &byID));
+    EXPECT_STREQ(byPath, byID);
+
+    const AwaInteger * integer = NULL;
+    EXPECT_EQ(AwaError_TypeMismatch, AwaServerReadResponse_GetValueAsIntegerPointerByID(readResponse, 3, 0, 0, &integer));
+    EXPECT_EQ(AwaError_PathNotFound, AwaServerReadResponse_GetValueAsIntegerPointerByID(readResponse, 3, 1, 9, &integer));
+    EXPECT_TRUE(NULL == integer);
+
+    AwaServerReadOperation_Free(&readOperation);
+}
+
 TEST_F(TestReadOperationWithConnectedSession, AwaServerReadOperation_Perform_handles_object_instance)
 {
     AwaServerReadOperation * readOperation = AwaServerReadOperation_New(server_session_);
@@ -1372,10 +1511,8 @@ TEST_F(TestReadOperationWithConnectedSessionNoClient, AwaServerReadOperation_han
     AwaServerReadOperation_Free(&operation);
 }
 
-TEST_F(TestReadOperationWithConnectedSessionNoClient, DISABLED_AwaServerReadOperation_handles_multiple_clients)
+TEST_F(TestReadOperationWithConnectedSessionNoClient, AwaServerReadOperation_handles_multiple_clients)
 {
-    // DISABLED because we don't support multiple ClientIDs in a single Read operation at present.
-
     // start a client and wait for them to register with the server
     AwaClientDaemonHorde horde( { "TestClient1", "TestClient2", "TestClient3" }, 61000);
     ASSERT_TRUE(WaitForRegistration(session_, horde.GetClientIDs(), 1000));
@@ -1407,6 +1544,84 @@ TEST_F(TestReadOperationWithConnectedSessionNoClient, DISABLED_AwaServerReadOper
     AwaServerReadOperation_Free(&operation);
 }
 
+namespace detail
+{
+
+struct FanOutResults
+{
+    std::vector<std::string> ClientIDs;
+    AwaError Error;
+};
+
+void FanOutResultCallback(const char * clientID, AwaInteger latency, AwaError result, void * context)
+{
+    FanOutResults * results = static_cast<FanOutResults *>(context);
+    results->ClientIDs.push_back(clientID);
+    EXPECT_LE(0, latency);
+    if (result != AwaError_Success)
+    {
+        results->Error = result;
+    }
+}
+
+} // namespace detail
+
+TEST_F(TestReadOperationWithConnectedSessionNoClient, AwaServerReadOperation_streams_results_from_multiple_clients)
+{
+    // start some clients and wait for them to register with the server
+    AwaClientDaemonHorde horde( { "TestClient1", "TestClient2", "TestClient3" }, 61000);
+    ASSERT_TRUE(WaitForRegistration(session_, horde.GetClientIDs(), 1000));
+
+    detail::FanOutResults results = { {}, AwaError_Success };
+    EXPECT_EQ(AwaError_Success, AwaServerSession_SetFanOutResultCallback(session_, detail::FanOutResultCallback, &results));
+
+    AwaServerReadOperation * operation = AwaServerReadOperation_New(session_);
+    EXPECT_EQ(AwaError_Success, AwaServerReadOperation_AddPath(operation, "TestClient1", "/3/0/0"));
+    EXPECT_EQ(AwaError_Success, AwaServerReadOperation_AddPath(operation, "TestClient2", "/3/0/0"));
+    EXPECT_EQ(AwaError_Success, AwaServerReadOperation_AddPath(operation, "TestClient3", "/3/0/0"));
+    EXPECT_EQ(AwaError_Success, AwaServerReadOperation_SetFanOutWindow(operation, 2));
+    EXPECT_EQ(AwaError_Success, AwaServerReadOperation_Perform(operation, global::timeout));
+
+    // each client's result was sent as a notification before the response
+    for (int i = 0; (i < 10) && (results.ClientIDs.size() < horde.GetClientIDs().size()); ++i)
+    {
+        AwaServerSession_Process(session_, 100);
+        AwaServerSession_DispatchCallbacks(session_);
+    }
+    const std::vector<std::string> &expectedClientIDs = horde.GetClientIDs();
+    EXPECT_EQ(AwaError_Success, results.Error);
+    ASSERT_EQ(expectedClientIDs.size(), results.ClientIDs.size());
+    EXPECT_TRUE(std::is_permutation(expectedClientIDs.begin(), expectedClientIDs.end(), results.ClientIDs.begin()));
+
+    for (const auto & clientID : expectedClientIDs)
+    {
+        AwaInteger latency = -1;
+        EXPECT_EQ(AwaError_Success, AwaServerReadOperation_GetClientLatency(operation, clientID.c_str(), &latency));
+        EXPECT_LE(0, latency);
+        EXPECT_TRUE(NULL != AwaServerReadOperation_GetResponse(operation, clientID.c_str()));
+    }
+
+    AwaInteger latency = -1;
+    EXPECT_EQ(AwaError_ClientNotFound, AwaServerReadOperation_GetClientLatency(operation, "ClientDoesNotExist", &latency));
+    EXPECT_EQ(AwaError_ResponseInvalid, AwaServerReadOperation_GetClientLatency(operation, NULL, &latency));
+
+    EXPECT_EQ(AwaError_Success, AwaServerSession_SetFanOutResultCallback(session_, NULL, NULL));
+    AwaServerReadOperation_Free(&operation);
+}
+
+TEST_F(TestReadOperationWithConnectedSessionNoClient, AwaServerReadOperation_GetClientLatency_handles_unprocessed_operation)
+{
+    AwaServerReadOperation * operation = AwaServerReadOperation_New(session_);
+    AwaInteger latency = -1;
+    EXPECT_EQ(AwaError_ResponseInvalid, AwaServerReadOperation_GetClientLatency(operation, "TestClient1", &latency));
+    AwaServerReadOperation_Free(&operation);
+}
+
+TEST_F(TestReadOperationWithConnectedSessionNoClient, AwaServerReadOperation_SetFanOutWindow_handles_null_operation)
+{
+    EXPECT_EQ(AwaError_OperationInvalid, AwaServerReadOperation_SetFanOutWindow(NULL, 2));
+}
+
 TEST_F(TestReadOperationWithConnectedSessionNoClient, AwaServerReadOperation_GetResponse_handles_null_operation)
 {
     EXPECT_EQ(NULL, AwaServerReadOperation_GetResponse(NULL, "TestClient1"));
@@ -21,6 +21,10 @@
 ************************************************************************************************************************/
 
 #include <gtest/gtest.h>
+#include <thread>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
 
 #include "awa/server.h"
 #include "server_session.h"
@@ -116,6 +120,28 @@ TEST_F(TestServerSession, AwaServerSession_SetIPCAsUDP_handles_unresolvable_host
     AwaServerSession_Free(&session);
 }
 
+TEST_F(TestServerSession, AwaServerSession_SetIPCAsUnix_handles_null_session)
+{
+    EXPECT_EQ(AwaError_SessionInvalid, AwaServerSession_SetIPCAsUnix(NULL, "/tmp/awa_serverd.sock"));
+}
+
+TEST_F(TestServerSession, AwaServerSession_SetIPCAsUnix_handles_invalid_path)
+{
+    AwaServerSession * session = AwaServerSession_New();
+    EXPECT_EQ(AwaError_IPCError, AwaServerSession_SetIPCAsUnix(session, NULL));
+    EXPECT_EQ(AwaError_IPCError, AwaServerSession_SetIPCAsUnix(session, ""));
+    EXPECT_EQ(AwaError_IPCError, AwaServerSession_SetIPCAsUnix(session, std::string(256, 'a').c_str()));
+    AwaServerSession_Free(&session);
+}
+
+TEST_F(TestServerSession, AwaServerSession_Connect_handles_missing_unix_socket)
+{
+    AwaServerSession * session = AwaServerSession_New();
+    EXPECT_EQ(AwaError_Success, AwaServerSession_SetIPCAsUnix(session, "/tmp/awa_serverd_does_not_exist.sock"));
+    EXPECT_EQ(AwaError_IPCError, AwaServerSession_Connect(session));
+    AwaServerSession_Free(&session);
+}
+
 TEST_F(TestServerSession, AwaServerSession_Connect_handles_null_session)
 {
     AwaServerSession * session = NULL;
@@ -288,6 +314,151 @@ TEST_F(TestServerSessionWithDaemon, ServerSession_IsConnected_returns_false_for_
     AwaServerSession_Free(&session);
 }
 
+class TestServerSessionWithUnixDaemon : public TestServerWithDaemonBase
+{
+protected:
+    virtual void SetUp() {
+        path_ = "/tmp/awa_serverd_" + std::to_string(global::serverIpcPort) + ".sock";
+        daemon_.SetAdditionalOptions({ "--ipcUnix", path_ });
+        TestServerWithDaemonBase::SetUp();
+    }
+    std::string path_;
+};
+
+TEST_F(TestServerSessionWithUnixDaemon, AwaServerSession_Connect_and_Disconnect_handles_valid_unix_session)
+{
+    if (!global::spawnServerDaemon)
+    {
+        // The daemon must be started with --ipcUnix
+        std::cout << " *** SKIPPED ***" << std::endl;
+        return;
+    }
+
+    AwaServerSession * session = AwaServerSession_New();
+    EXPECT_EQ(AwaError_Success, AwaServerSession_SetIPCAsUnix(session, path_.c_str()));
+    EXPECT_EQ(AwaError_Success, AwaServerSession_Connect(session));
+    EXPECT_TRUE(ServerSession_IsConnected(session));
+    EXPECT_EQ(AwaError_Success, AwaServerSession_Disconnect(session));
+    AwaServerSession_Free(&session);
+}
+
+TEST_F(TestServerSessionWithUnixDaemon, AwaServerSession_handles_messages_larger_than_a_datagram)
+{
+    if (!global::spawnServerDaemon)
+    {
+        // The daemon must be started with --ipcUnix
+        std::cout << " *** SKIPPED ***" << std::endl;
+        return;
+    }
+
+    AwaServerSession * session = AwaServerSession_New();
+    EXPECT_EQ(AwaError_Success, AwaServerSession_SetIPCAsUnix(session, path_.c_str()));
+    ASSERT_EQ(AwaError_Success, AwaServerSession_Connect(session));
+
+    // Define enough objects that both the Define request and the next Connect response exceed 64KB
+    const int numObjects = 200;
+    const int numResources = 20;
+    AwaServerDefineOperation * defineOperation = AwaServerDefineOperation_New(session);
+    ASSERT_TRUE(defineOperation != NULL);
+    for (int objectID = 20000; objectID < 20000 + numObjects; objectID++)
+    {
+        AwaObjectDefinition * definition = AwaObjectDefinition_New(objectID, ("Large Test Object " + std::to_string(objectID)).c_str(), 0, 1);
+        for (int resourceID = 0; resourceID < numResources; resourceID++)
+        {
+            EXPECT_EQ(AwaError_Success, AwaObjectDefinition_AddResourceDefinitionAsString(definition, resourceID, "Large Test Resource", false, AwaResourceOperations_ReadWrite, "Large Test Default Value"));
+        }
+        EXPECT_EQ(AwaError_Success, AwaServerDefineOperation_Add(defineOperation, definition));
+        AwaObjectDefinition_Free(&definition);
+    }
+    EXPECT_EQ(AwaError_Success, AwaServerDefineOperation_Perform(defineOperation, global::timeout));
+    AwaServerDefineOperation_Free(&defineOperation);
+
+    AwaServerSession * session2 = AwaServerSession_New();
+    EXPECT_EQ(AwaError_Success, AwaServerSession_SetIPCAsUnix(session2, path_.c_str()));
+    ASSERT_EQ(AwaError_Success, AwaServerSession_Connect(session2));
+    EXPECT_TRUE(AwaServerSession_IsObjectDefined(session2, 20000 + numObjects - 1));
+
+    AwaServerSession_Free(&session2);
+    AwaServerSession_Free(&session);
+}
+
+TEST_F(TestServerSessionWithUnixDaemon, AwaServerSession_is_served_while_another_connection_stops_reading)
+{
+    if (!global::spawnServerDaemon)
+    {
+        // The daemon must be started with --ipcUnix
+        std::cout << " *** SKIPPED ***" << std::endl;
+        return;
+    }
+
+    // send many requests on a connection that never reads the responses
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path_.c_str(), sizeof(addr.sun_path) - 1);
+    int sockfd = socket(AF_UNIX, SOCK_STREAM, 0);
+    ASSERT_NE(-1, sockfd);
+    ASSERT_EQ(0, connect(sockfd, (struct sockaddr *)&addr, sizeof(addr)));
+
+    const std::string request = "<Request><Type>Connect</Type></Request>";
+    const uint8_t header[] = { 0, 0, 0, (uint8_t)request.length() };
+    for (int i = 0; i < 1000; i++)
+    {
+        ASSERT_EQ((ssize_t)sizeof(header), send(sockfd, header, sizeof(header), MSG_NOSIGNAL));
+        ASSERT_EQ((ssize_t)request.length(), send(sockfd, request.c_str(), request.length(), MSG_NOSIGNAL));
+    }
+
+    AwaServerSession * session = AwaServerSession_New();
+    EXPECT_EQ(AwaError_Success, AwaServerSession_SetIPCAsUnix(session, path_.c_str()));
+    EXPECT_EQ(AwaError_Success, AwaServerSession_Connect(session));
+    EXPECT_EQ(AwaError_Success, AwaServerSession_Disconnect(session));
+    AwaServerSession_Free(&session);
+
+    close(sockfd);
+}
+
+TEST_F(TestServerSession, AwaServerSession_Connect_times_out_if_daemon_stalls_within_a_message)
+{
+    // stand in for a daemon that starts a response but never finishes it
+    std::string path = "/tmp/awa_stalled_" + std::to_string(getpid()) + ".sock";
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    ASSERT_NE(-1, listener);
+    unlink(path.c_str());
+    ASSERT_EQ(0, bind(listener, (struct sockaddr *)&addr, sizeof(addr)));
+    ASSERT_EQ(0, listen(listener, 2));
+
+    std::thread daemon([listener]() {
+        char buffer[4096];
+        int sockfd = accept(listener, NULL, NULL);
+        if ((sockfd >= 0) && (recv(sockfd, buffer, sizeof(buffer), 0) > 0))
+        {
+            // the header promises 256 bytes, but only a few follow
+            const uint8_t partial[] = { 0, 0, 1, 0, '<', 'R', 'e', 's' };
+            send(sockfd, partial, sizeof(partial), MSG_NOSIGNAL);
+
+            // hold the connection open until the session gives up on it
+            while (recv(sockfd, buffer, sizeof(buffer), 0) > 0)
+            {
+            }
+        }
+        close(sockfd);
+    });
+
+    AwaServerSession * session = AwaServerSession_New();
+    AwaServerSession_SetDefaultTimeout(session, 500);
+    EXPECT_EQ(AwaError_Success, AwaServerSession_SetIPCAsUnix(session, path.c_str()));
+    EXPECT_EQ(AwaError_Timeout, AwaServerSession_Connect(session));
+    AwaServerSession_Free(&session);
+
+    daemon.join();
+    close(listener);
+    unlink(path.c_str());
+}
+
 TEST_F(TestServerSessionWithDaemon, AwaServerSession_Connect_handles_call_twice)
 {
     // Attempt to connect twice daemon on IPv4 address
@@ -528,10 +528,8 @@ TEST_F(TestWriteAttributesOperationWithConnectedSessionNoClient, AwaServerWriteA
     AwaServerWriteAttributesOperation_Free(&operation);
 }
 
-TEST_F(TestWriteAttributesOperationWithConnectedSessionNoClient, DISABLED_AwaServerWriteAttributesOperation_handles_multiple_clients)
+TEST_F(TestWriteAttributesOperationWithConnectedSessionNoClient, AwaServerWriteAttributesOperation_handles_multiple_clients)
 {
-    // DISABLED because we don't support multiple ClientIDs in a single WriteAttributes operation at present.
-
     // start a client and wait for them to register with the server
     AwaClientDaemonHorde horde( { "TestClient1", "TestClient2", "TestClient3" }, 61000);
     ASSERT_TRUE(WaitForRegistration(session_, horde.GetClientIDs(), global::timeout));
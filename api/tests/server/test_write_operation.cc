@@ -190,6 +190,18 @@ TEST_F(TestWriteOperationWithConnectedSession, AwaServerWriteOperation_AddValueA
     AwaServerWriteOperation_Free(&writeOperation);
 }
 
+TEST_F(TestWriteOperationWithConnectedSession, AwaServerWriteOperation_AddValueAsIntegerByID_handles_resources)
+{
+    AwaServerWriteOperation * writeOperation = AwaServerWriteOperation_New(session_, AwaWriteMode_Update); ASSERT_TRUE(NULL != writeOperation);
+    AwaInteger value = 123456789;
+    EXPECT_EQ(AwaError_Success, AwaServerWriteOperation_AddValueAsIntegerByID(writeOperation, 3, 0, 9, value));
+    EXPECT_EQ(AwaError_NotDefined, AwaServerWriteOperation_AddValueAsIntegerByID(writeOperation, 99, 0, 9, value));
+    EXPECT_EQ(AwaError_TypeMismatch, AwaServerWriteOperation_AddValueAsIntegerByID(writeOperation, 3, 0, 0, value));
+    EXPECT_EQ(AwaError_PathInvalid, AwaServerWriteOperation_AddValueAsIntegerByID(writeOperation, 1, 12, AWA_INVALID_ID, value));
+    EXPECT_EQ(AwaError_OperationInvalid, AwaServerWriteOperation_AddValueAsIntegerByID(NULL, 3, 0, 9, value));
+    AwaServerWriteOperation_Free(&writeOperation);
+}
+
 TEST_F(TestWriteOperationWithConnectedSession, AwaServerWriteOperation_AddValueAsCString_handles_null_value)
 {
     AwaServerWriteOperation * writeOperation = AwaServerWriteOperation_New(session_, AwaWriteMode_Update); ASSERT_TRUE(NULL != writeOperation);
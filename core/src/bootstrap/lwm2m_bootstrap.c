@@ -118,7 +118,7 @@ static bool Lwm2mBootstrap_AddServerValues(Lwm2mContextType * context, const cha
 static int EndpointHandler(int type, void * ctxt, AddressType * addr, const char * path, const char * query,
                            const char * token, int tokenLength, ContentType contentType, const char * requestContent,
                            size_t requestContentLen, ContentType * responseContentType, char * responseContent,
-                           size_t * responseContentLen, int * responseCode)
+                           size_t * responseContentLen, int * responseCode, int32_t * responseOffset)
 {
     *responseContentType = ContentType_None;
     *responseContentLen = 0;
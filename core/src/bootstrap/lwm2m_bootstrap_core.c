@@ -162,7 +162,7 @@ static int Lwm2mCore_HandleRequest(CoapRequest * request, CoapResponse * respons
     return endPoint->Handler(request->type, request->ctxt, &request->addr, request->path, request->query,
                              request->token, request->tokenLength, request->contentType, request->requestContent,
                              request->requestContentLen, &response->responseContentType, response->responseContent,
-                             &response->responseContentLen, &response->responseCode);
+                             &response->responseContentLen, &response->responseCode, &response->responseOffset);
 }
 
 // Initialise the LWM2M core, setup any callbacks, initialise CoAP etc
@@ -229,6 +229,7 @@ static int Bootstrap_Start(Options * options)
         fds[0].events = POLLIN;
 
         timeout = Lwm2mCore_Process(context);
+        timeout = coap_GetTimeout(timeout);
 
         loop_result = poll(fds, nfds, timeout);
 
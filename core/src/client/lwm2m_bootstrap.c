@@ -144,7 +144,8 @@ static int BootStrapPost(void * ctxt, AddressType * addr, const char * path, con
 static int BootstrapEndpointHandler(int type, void * ctxt, AddressType * addr,
                                               const char * path, const char * query, const char * token, int tokenLength,
                                               ContentType contentType, const char * requestContent, size_t requestContentLen,
-                                              ContentType * responseContentType, char * responseContent, size_t * responseContentLen, int * responseCode)
+                                              ContentType * responseContentType, char * responseContent, size_t * responseContentLen, int * responseCode,
+                                              int32_t * responseOffset)
 {
     switch (type)
     {
@@ -321,6 +321,7 @@ static int Lwm2mClient_Start(Options * options)
         fds[1].events = POLLIN;
 
         timeout = Lwm2mCore_Process(context);
+        timeout = coap_GetTimeout(timeout);
 
         loop_result = poll(fds, nfds, timeout);
         if (loop_result < 0)
@@ -62,6 +62,8 @@ struct _Lwm2mContextType
     char EndPointName[MAX_ENDPOINT_NAME_LENGTH];  // Client EndPoint name
     bool UseFactoryBootstrap;                 // Factory bootstrap information has been loaded from file.
     struct ListHead ObserverList;
+    HashTable ObserverIndex;                  // Observers in ObserverList, indexed by observed path
+    DeadlineQueue ObserverQueue;              // Observers in ObserverList, ordered by when they are next due
     void * ApplicationContext;
 };
 
@@ -82,7 +84,8 @@ static int ObjectStoreCreateOptionalResourceHandler(void * context, ObjectIDType
 static int DeviceManagmentEndpointHandler(int type, void * ctxt, AddressType * addr,
                                           const char * path, const char * query, const char * token, int tokenLength,
                                           ContentType contentType, const char * requestContent, size_t requestContentLen,
-                                          ContentType * responseContentType, char * responseContent, size_t * responseContentLen, int * responseCode);
+                                          ContentType * responseContentType, char * responseContent, size_t * responseContentLen, int * responseCode,
+                                          int32_t * responseOffset);
 
 ObjectOperationHandlers defaultObjectOperationHandlers =
 {
@@ -99,10 +102,14 @@ ResourceOperationHandlers defaultResourceOperationHandlers =
 };
 
 
-// Serialise the Object referenced by OIR into the provided buffer. Return number of bytes serialised, negative on failure
-static int SerialiseOIR(Lwm2mTreeNode * root, ContentType acceptContentType, int oir[], int oirLength, ContentType * responseContentType, char * buffer, size_t size)
+// Encode the Object referenced by OIR straight from the object store. Only the bytes of the encoding from offset
+// onwards are kept, up to size bytes; more is set if the encoding continues beyond them.
+// Return number of bytes written to buffer, negative on failure
+static int StreamOIR(Lwm2mContextType * context, ContentType acceptContentType, int oir[], int oirLength, ContentType * responseContentType,
+                     char * buffer, size_t size, int offset, bool * more)
 {
     int len = -1;
+    SerdesStream stream;
 
     if (acceptContentType == ContentType_None)
     {
@@ -113,29 +120,32 @@ static int SerialiseOIR(Lwm2mTreeNode * root, ContentType acceptContentType, int
         acceptContentType = ContentType_ApplicationPlainText;
     }
 
+    SerdesStream_Init(&stream, (uint8_t *)buffer, size, offset);
+
     if (oirLength == 1)
     {
-        len = SerialiseObject(acceptContentType, root, oir[0], buffer, size);
+        len = StreamObject(acceptContentType, &stream, context, oir[0]);
     }
     else if (oirLength == 2)
     {
-        len = SerialiseObjectInstance(acceptContentType, root, oir[0], oir[1], buffer, size);
+        len = StreamObjectInstance(acceptContentType, &stream, context, oir[0], oir[1]);
     }
     else if (oirLength == 3)
     {
-        len = SerialiseResource(acceptContentType, root, oir[0], oir[1], oir[2], buffer, size);
+        len = StreamResource(acceptContentType, &stream, context, oir[0], oir[1], oir[2]);
     }
     else
     {
         Lwm2m_Error("Invalid OIR, length %d\n", oirLength);
     }
 
+    *more = stream.More;
     *responseContentType = acceptContentType;
     return len;
 }
 
 // Deserialise the encoded buffer provided into the Object references by OIR. Return number of bytes deserialised, negative on failure
-static int DeserialiseOIR(Lwm2mTreeNode ** dest, ContentType contentType, Lwm2mContextType * context, int oir[], int oirLength, const char * buffer, size_t len)
+static int DeserialiseOIR(Lwm2mTreeNode ** dest, Lwm2mTreeArena * arena, ContentType contentType, Lwm2mContextType * context, int oir[], int oirLength, const char * buffer, size_t len)
 {
     /* If the content type is not specified in the payload of a response message,
      * the default content type (text/plain) is assumed; otherwise the content type
@@ -149,17 +159,17 @@ static int DeserialiseOIR(Lwm2mTreeNode ** dest, ContentType contentType, Lwm2mC
     if (oirLength == 1)
     {
         Lwm2m_Debug("Deserialise object %d:\n", oir[0]);
-        len = DeserialiseObject(contentType, dest, context->Definitions, oir[0], buffer, len);
+        len = DeserialiseObjectInArena(contentType, dest, arena, context->Definitions, oir[0], buffer, len);
     }
     else if (oirLength == 2)
     {
         Lwm2m_Debug("Deserialise object instance %d/%d:\n", oir[0], oir[1]);
-        len = DeserialiseObjectInstance(contentType, dest, context->Definitions, oir[0], oir[1], buffer, len);
+        len = DeserialiseObjectInstanceInArena(contentType, dest, arena, context->Definitions, oir[0], oir[1], buffer, len);
     }
     else if (oirLength == 3)
     {
         Lwm2m_Debug("Deserialise resource %d/%d/%d:\n", oir[0], oir[1], oir[2]);
-        len = DeserialiseResource(contentType, dest, context->Definitions, oir[0], oir[1], oir[2], buffer, len);
+        len = DeserialiseResourceInArena(contentType, dest, arena, context->Definitions, oir[0], oir[1], oir[2], buffer, len);
     }
 
     return len;
@@ -1325,18 +1335,21 @@ static int HandleNotification(void * ctxt, AddressType * addr, int sequence, con
 
     matches = sscanf(OirToUri(key), "%5d/%5d/%5d", &oir[0], &oir[1], &oir[2]);
 
-    Lwm2mTreeNode * dest;
-    if (TreeBuilder_CreateTreeFromOIR(&dest, context, origin, oir, matches) == AwaResult_Success)
+    if (TreeBuilder_CheckReadableOIR(context, origin, oir, matches) == AwaResult_Success)
     {
         char payload[1024];
-        int payloadLen = SerialiseOIR(dest, contentType, oir, matches, &payloadContentType, payload, sizeof(payload));
-        if (payloadLen >= 0)
+        bool more;
+        int payloadLen = StreamOIR(context, contentType, oir, matches, &payloadContentType, payload, sizeof(payload), 0, &more);
+        if (more)
+        {
+            Lwm2m_Error("Notification for %s does not fit in %zu bytes\n", path, sizeof(payload));
+        }
+        else if (payloadLen >= 0)
         {
             Lwm2m_Debug("Send Notify to %s\n", path);
             coap_SendNotify(addr, path, token, tokenLength, payloadContentType, payload, payloadLen, sequence);
         }
     }
-    Lwm2mTreeNode_DeleteRecursive(dest);
     return 0;
 }
 
@@ -1367,12 +1380,17 @@ static int HandleObserveRequest(void * ctxt, AddressType * addr, const char * pa
         int len = 0;
         if (Lwm2mCore_Observe(context, addr, token, tokenLength, oir[0], oir[1], oir[2], contentType, HandleNotification, NULL) != -1)
         {
-            Lwm2mTreeNode * root;
-            if ((result = TreeBuilder_CreateTreeFromOIR(&root, context, origin, oir, matches)) == AwaResult_Success)
+            if ((result = TreeBuilder_CheckReadableOIR(context, origin, oir, matches)) == AwaResult_Success)
             {
-                len = SerialiseOIR(root, contentType, oir, matches, responseContentType, responseContent, *responseContentLen);
+                bool more;
+                len = StreamOIR(context, contentType, oir, matches, responseContentType, responseContent, *responseContentLen, 0, &more);
+                if (len < 0)
+                {
+                    // A value could not be read from the object store
+                    result = AwaResult_NotFound;
+                }
+                len = more ? -1 : len;
             }
-            Lwm2mTreeNode_DeleteRecursive(root);
         }
 
         *responseContentLen = (len >= 0) ? len : 0;
@@ -1405,12 +1423,17 @@ static int HandleCancelObserveRequest(void * ctxt, AddressType * addr, const cha
         Lwm2mCore_CancelObserve(context, addr, oir[0], oir[1], oir[2]);
 
         // Perform "GET", to return clientID in content.
-        Lwm2mTreeNode * root;
-        if ((result = TreeBuilder_CreateTreeFromOIR(&root, context, origin, oir, matches)) == AwaResult_Success)
+        if ((result = TreeBuilder_CheckReadableOIR(context, origin, oir, matches)) == AwaResult_Success)
         {
-            len = SerialiseOIR(root, contentType, oir, matches, responseContentType, responseContent, *responseContentLen);
+            bool more;
+            len = StreamOIR(context, contentType, oir, matches, responseContentType, responseContent, *responseContentLen, 0, &more);
+            if (len < 0)
+            {
+                // A value could not be read from the object store
+                result = AwaResult_NotFound;
+            }
+            len = more ? -1 : len;
         }
-        Lwm2mTreeNode_DeleteRecursive(root);
 
         if (len >= 0)
         {
@@ -1434,7 +1457,8 @@ static int HandleCancelObserveRequest(void * ctxt, AddressType * addr, const cha
 // Handler CoAP GET Requests, maps onto LWM2M READ and DISCOVER operations. Return 0 on success, non-zero on error.
 static int HandleGetRequest(void * ctxt, AddressType * addr, const char * path, const char * query,
                             ContentType acceptContentType, const char * requestContent, size_t requestContentLen,
-                            ContentType * responseContentType, char * responseContent, size_t * responseContentLen, int * responseCode)
+                            ContentType * responseContentType, char * responseContent, size_t * responseContentLen, int * responseCode,
+                            int32_t * responseOffset)
 {
     Lwm2mContextType * context = (Lwm2mContextType *)ctxt;
     int len = 0;
@@ -1453,17 +1477,34 @@ static int HandleGetRequest(void * ctxt, AddressType * addr, const char * path,
     else
     {
         Lwm2m_Debug("Read\n");
-        Lwm2mTreeNode * root;
-        if ((result = TreeBuilder_CreateTreeFromOIR(&root, context, origin, oir, matches)) == AwaResult_Success)
+        if ((result = TreeBuilder_CheckReadableOIR(context, origin, oir, matches)) == AwaResult_Success)
         {
-            len = SerialiseOIR(root, acceptContentType, oir, matches, responseContentType, responseContent, *responseContentLen);
+            // Encode only the block requested, straight from the object store.
+            bool more;
+            int32_t offset = *responseOffset;
+            len = StreamOIR(context, acceptContentType, oir, matches, responseContentType, responseContent, *responseContentLen, offset, &more);
+            if (len >= 0)
+            {
+                if (more)
+                {
+                    *responseOffset = offset + len;
+                }
+                else if (offset > 0)
+                {
+                    *responseOffset = -1;
+                }
+            }
+            else
+            {
+                // A value could not be read from the object store
+                result = AwaResult_NotFound;
+            }
         }
         else
         {
             // Not found or some other failure.
             len = -1;
         }
-        Lwm2mTreeNode_DeleteRecursive(root);
     }
 
     *responseContentLen = (len < 0) ? 0 : len;
@@ -1519,8 +1560,9 @@ static int HandlePostRequest(void * ctxt, AddressType * addr, const char * path,
     else
     {
         // Handle WRITE and CREATE
+        Lwm2mTreeArena * arena = Lwm2mTreeArena_New();
         Lwm2mTreeNode * root = NULL;
-        len = DeserialiseOIR(&root, contentType, context, oir, matches, requestContent, requestContentLen);
+        len = DeserialiseOIR(&root, arena, contentType, context, oir, matches, requestContent, requestContentLen);
 
         if (len >= 0)
         {
@@ -1540,7 +1582,7 @@ static int HandlePostRequest(void * ctxt, AddressType * addr, const char * path,
 
                     // This is an object node with resource values but no object instance.
                     // Treat it as an object instance node and add it to an object node.
-                    Lwm2mTreeNode * object = Lwm2mTreeNode_Create();
+                    Lwm2mTreeNode * object = Lwm2mTreeNode_CreateInArena(arena);
                     Lwm2mTreeNode_SetID(object, oir[0]);
                     Lwm2mTreeNode_SetType(object, Lwm2mTreeNodeType_Object);
                     Lwm2mTreeNode_AddChild(object, root);
@@ -1595,6 +1637,7 @@ static int HandlePostRequest(void * ctxt, AddressType * addr, const char * path,
             *responseCode = AwaResult_BadRequest;
         }
         Lwm2mTreeNode_DeleteRecursive(root);
+        Lwm2mTreeArena_Free(arena);
     }
     return 0;
 }
@@ -1622,12 +1665,19 @@ static int HandleWriteAttributesRequest(void * ctxt, AddressType * addr, const c
         goto error;
     }
 
-    NotificationAttributes * attributes = AttributeStore_LookupNotificationAttributes(context->AttributeStore, Lwm2mSecurity_GetShortServerID(context, addr), oir[0], oir[1], oir[2]);
-    if (attributes != NULL)
+    if (context->AttributeStore != NULL)
     {
         // Store changes in a temporary object and only write them on success.
         NotificationAttributes temp;
-        memcpy(&temp, attributes, sizeof(NotificationAttributes));
+        const NotificationAttributes * attributes = AttributeStore_LookupNotificationAttributes(context->AttributeStore, Lwm2mSecurity_GetShortServerID(context, addr), oir[0], oir[1], oir[2]);
+        if (attributes != NULL)
+        {
+            memcpy(&temp, attributes, sizeof(NotificationAttributes));
+        }
+        else
+        {
+            memset(&temp, 0, sizeof(NotificationAttributes));
+        }
 
         int numPairs = 0;
         QueryPair * pairs = Lwm2mCore_SplitQuery(query, &numPairs);
@@ -1752,8 +1802,16 @@ static int HandleWriteAttributesRequest(void * ctxt, AddressType * addr, const c
             else
             {
                 // Query was fully checked - copy attributes
-                memcpy(attributes, &temp, sizeof(NotificationAttributes));
-                *responseCode = AwaResult_SuccessChanged;
+                if (AttributeStore_SetNotificationAttributes(context->AttributeStore, shortServerID, oir[0], oir[1], oir[2], &temp) == 0)
+                {
+                    Lwm2m_RescheduleObservers(context);
+                    *responseCode = AwaResult_SuccessChanged;
+                }
+                else
+                {
+                    Lwm2m_Error("Failed to store attributes\n");
+                    *responseCode = AwaResult_InternalError;
+                }
             }
             Lwm2mCore_FreeQueryPairs(pairs, numPairs);
             pairs = NULL;
@@ -1792,11 +1850,12 @@ static int HandlePutRequest(void * ctxt, AddressType * addr, const char * path,
     // Replace operation: must be O/I or O/I/R
     if ((oir[0] != -1) && (oir[1] != -1))
     {
+        Lwm2mTreeArena * arena = Lwm2mTreeArena_New();
         Lwm2mTreeNode * root;
         int len;
 
         // Create new resource instance with the values provided.
-        len = DeserialiseOIR(&root, contentType, context, oir, matches, requestContent, requestContentLen);
+        len = DeserialiseOIR(&root, arena, contentType, context, oir, matches, requestContent, requestContentLen);
 
         if (len >= 0)
         {
@@ -1845,6 +1904,7 @@ static int HandlePutRequest(void * ctxt, AddressType * addr, const char * path,
             *responseCode = AwaResult_BadRequest;
         }
         Lwm2mTreeNode_DeleteRecursive(root);
+        Lwm2mTreeArena_Free(arena);
     }
     else
     {
@@ -1876,10 +1936,11 @@ static int HandleBootstrapPutRequest(void * ctxt, AddressType * addr, const char
     *responseCode = AwaResult_BadRequest;
 
     matches = sscanf(path, "/%5d/%5d/%5d", &oir[0], &oir[1], &oir[2]);
+    Lwm2mTreeArena * arena = Lwm2mTreeArena_New();
     Lwm2mTreeNode * root;
 
     // Create new resource instance with the values provided.
-    int len = DeserialiseOIR(&root, contentType, context, oir, matches, requestContent, requestContentLen);
+    int len = DeserialiseOIR(&root, arena, contentType, context, oir, matches, requestContent, requestContentLen);
     if (len >= 0)
     {
         switch (Lwm2mTreeNode_GetType(root))
@@ -1910,6 +1971,7 @@ static int HandleBootstrapPutRequest(void * ctxt, AddressType * addr, const char
         }
     }
     Lwm2mTreeNode_DeleteRecursive(root);
+    Lwm2mTreeArena_Free(arena);
     return result;
 }
 
@@ -1931,12 +1993,13 @@ static int HandleDeleteRequest(void * ctxt, AddressType * addr, const char * pat
 static int DeviceManagmentEndpointHandler(int type, void * ctxt, AddressType * addr,
                                                     const char * path, const char * query, const char * token, int tokenLength,
                                                     ContentType contentType, const char * requestContent, size_t requestContentLen,
-                                                    ContentType * responseContentType, char * responseContent, size_t * responseContentLen, int * responseCode)
+                                                    ContentType * responseContentType, char * responseContent, size_t * responseContentLen, int * responseCode,
+                                                    int32_t * responseOffset)
 {
     switch (type)
     {
         case COAP_GET_REQUEST:
-            return HandleGetRequest(ctxt, addr, path, query, contentType,requestContent, requestContentLen, responseContentType, responseContent, responseContentLen, responseCode);
+            return HandleGetRequest(ctxt, addr, path, query, contentType,requestContent, requestContentLen, responseContentType, responseContent, responseContentLen, responseCode, responseOffset);
 
         case COAP_POST_REQUEST:
             return HandlePostRequest(ctxt, addr, path, query, contentType, requestContent, requestContentLen, responseContent, responseContentLen, responseCode);
@@ -2002,7 +2065,7 @@ static int Lwm2mCore_HandleRequest(CoapRequest * request, CoapResponse * respons
     return endPoint->Handler(request->type, request->ctxt, &request->addr, request->path, request->query,
                              request->token, request->tokenLength, request->contentType, request->requestContent,
                              request->requestContentLen, &response->responseContentType, response->responseContent,
-                             &response->responseContentLen, &response->responseCode);
+                             &response->responseContentLen, &response->responseCode, &response->responseOffset);
 }
 
 
@@ -2058,7 +2121,7 @@ int Lwm2mCore_Process(Lwm2mContextType * context)
         Lwm2m_UpdateBootStrapState(context);
     }
 
-    Lwm2m_UpdateObservers(context);
+    nextTick = Lwm2m_UpdateObservers(context, nextTick);
     return nextTick;
 }
 
@@ -2089,6 +2152,16 @@ struct ListHead * Lwm2mCore_GetObserverList(Lwm2mContextType * context)
     return &context->ObserverList;
 }
 
+HashTable * Lwm2mCore_GetObserverIndex(Lwm2mContextType * context)
+{
+    return &context->ObserverIndex;
+}
+
+DeadlineQueue * Lwm2mCore_GetObserverQueue(Lwm2mContextType * context)
+{
+    return &context->ObserverQueue;
+}
+
 AttributeStore * Lwm2mCore_GetAttributes(Lwm2mContextType * context)
 {
     return context->AttributeStore;
@@ -2134,6 +2207,8 @@ Lwm2mContextType * Lwm2mCore_New()
     Lwm2mContextType * context = &Lwm2mContext;
 
     ListInit(&context->ObserverList);
+    HashTable_Init(&context->ObserverIndex, HASH_TABLE_DEFAULT_BUCKETS);
+    DeadlineQueue_Init(&context->ObserverQueue);
     ListInit(&context->ServerList);
     Lwm2mObjectTree_Init(&context->ObjectTree);
 
@@ -2197,6 +2272,8 @@ Lwm2mContextType * Lwm2mCore_Init(CoapInfo * coap, char * endPointName)
     Lwm2mContextType * context = &Lwm2mContext;
 
     ListInit(&context->ObserverList);
+    HashTable_Init(&context->ObserverIndex, HASH_TABLE_DEFAULT_BUCKETS);
+    DeadlineQueue_Init(&context->ObserverQueue);
     ListInit(&context->ServerList);
     Lwm2mObjectTree_Init(&context->ObjectTree);
 
@@ -2240,4 +2317,6 @@ void Lwm2mCore_Destroy(Lwm2mContextType * context)
     AttributeStore_Destroy(context->AttributeStore);
     DefinitionRegistry_Destroy(context->Definitions);
     Lwm2m_FreeObservers(context);
+    HashTable_Destroy(&context->ObserverIndex);
+    DeadlineQueue_Destroy(&context->ObserverQueue);
 }
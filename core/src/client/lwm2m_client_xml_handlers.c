@@ -276,14 +276,15 @@ static int xmlif_HandlerConnectRequest(RequestInfoType * request, TreeNode conte
 #ifndef CONTIKI
         Lwm2m_Info("IPC connected from %s - allocated session ID %d\n", Lwm2mCore_DebugPrintSockAddr(&request->FromAddr), request->SessionID);
 #endif
-        IPC_SendResponse(response, request->Sockfd, &request->FromAddr, request->AddrLen);
+        xmlif_NegotiateEncoding(request, response);
+        xmlif_SendResponse(request, response);
         Tree_Delete(response);
     }
     else
     {
         Lwm2m_Error("Bad IPC Connect request\n");
         TreeNode response = IPC_NewResponseNode(IPC_MESSAGE_SUB_TYPE_CONNECT, AwaResult_BadRequest, request->SessionID);
-        IPC_SendResponse(response, request->Sockfd, &request->FromAddr, request->AddrLen);
+        xmlif_SendResponse(request, response);
         Tree_Delete(response);
     }
     free(request);
@@ -298,14 +299,14 @@ static int xmlif_HandlerEstablishNotifyRequest(RequestInfoType * request, TreeNo
         Lwm2m_Info("IPC Notify session %d connected from %s\n", request->SessionID, Lwm2mCore_DebugPrintSockAddr(&request->FromAddr));
 #endif
         TreeNode response = IPC_NewResponseNode(IPC_MESSAGE_SUB_TYPE_ESTABLISH_NOTIFY, AwaResult_Success, request->SessionID);
-        IPC_SendResponse(response, request->Sockfd, &request->FromAddr, request->AddrLen);
+        xmlif_SendResponse(request, response);
         Tree_Delete(response);
     }
     else
     {
         Lwm2m_Error("Bad IPC ConnectNotify request\n");
         TreeNode response = IPC_NewResponseNode(IPC_MESSAGE_SUB_TYPE_ESTABLISH_NOTIFY, AwaResult_BadRequest, request->SessionID);
-        IPC_SendResponse(response, request->Sockfd, &request->FromAddr, request->AddrLen);
+        xmlif_SendResponse(request, response);
         Tree_Delete(response);
     }
     free(request);
@@ -322,7 +323,7 @@ static int xmlif_HandlerDisconnectRequest(RequestInfoType * request, TreeNode co
     //TODO: cleanup for notify channel
 
     TreeNode response = IPC_NewResponseNode(IPC_MESSAGE_SUB_TYPE_DISCONNECT, AwaResult_Success, request->SessionID);
-    IPC_SendResponse(response, request->Sockfd, &request->FromAddr, request->AddrLen);
+    xmlif_SendResponse(request, response);
     Tree_Delete(response);
 
     free(request);
@@ -353,7 +354,7 @@ static int xmlif_HandlerDefineRequest(RequestInfoType * request, TreeNode conten
     }
 
     TreeNode response = IPC_NewResponseNode(IPC_MESSAGE_SUB_TYPE_DEFINE, AwaResult_Success, request->SessionID);
-    IPC_SendResponse(response, request->Sockfd, &request->FromAddr, request->AddrLen);
+    xmlif_SendResponse(request, response);
     Tree_Delete(response);
 
     // Send an update so that all servers this client is connected to know that the client has this object defined.
@@ -376,7 +377,7 @@ static void xmlif_GenerateResponse(void * ctxt, AddressType* address, const char
         TreeNode_AddChild(response, content);
     }
 
-    IPC_SendResponse(response, request->Sockfd, &request->FromAddr, request->AddrLen);
+    xmlif_SendResponse(request, response);
     Tree_Delete(response);
 
     free(request);
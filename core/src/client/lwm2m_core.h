@@ -141,6 +141,8 @@ AwaObjectInstanceID Lwm2mCore_AddSeverObjects(Lwm2mContextType * context);
 struct ListHead * Lwm2mCore_GetServerList(Lwm2mContextType * context);
 struct ListHead * Lwm2mCore_GetSecurityObjectList(Lwm2mContextType * context);
 struct ListHead * Lwm2mCore_GetObserverList(Lwm2mContextType * context);
+HashTable * Lwm2mCore_GetObserverIndex(Lwm2mContextType * context);
+DeadlineQueue * Lwm2mCore_GetObserverQueue(Lwm2mContextType * context);
 AttributeStore * Lwm2mCore_GetAttributes(Lwm2mContextType * context);
 
 Lwm2mBootStrapState Lwm2mCore_GetBootstrapState(Lwm2mContextType * context);
@@ -242,6 +242,7 @@ static int Lwm2mServer_ResourceWriteHandler(void * context, ObjectIDType objectI
                 else
                 {
                     server->DefaultMinimumPeriod = temp;
+                    Lwm2m_RescheduleObservers(context);
                     result = sizeof(server->DefaultMinimumPeriod);
                     WarnOfInsufficientData(result, srcBufferLen);
                 }
@@ -259,6 +260,7 @@ static int Lwm2mServer_ResourceWriteHandler(void * context, ObjectIDType objectI
                 else
                 {
                     server->DefaultMaximumPeriod = temp;
+                    Lwm2m_RescheduleObservers(context);
                     result = sizeof(server->DefaultMaximumPeriod);
                     WarnOfInsufficientData(result, srcBufferLen);
                 }
@@ -360,6 +360,7 @@ int AwaStaticClient_Process(AwaStaticClient * client)
 
         int timeout;
         timeout = Lwm2mCore_Process(client->Context);
+        timeout = coap_GetTimeout(timeout);
         result = coap_WaitMessage(timeout, client->CoAPInfo->fd);
     }
     return result;
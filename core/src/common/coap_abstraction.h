@@ -61,6 +61,7 @@ typedef struct
     char * responseLocation;
     size_t responseLocationLen;
     int responseCode;
+    int32_t responseOffset;     // Block2 offset requested; set by the handler to the next offset (-1 after the last block), or left unchanged if responseContent holds the whole content
 
 } CoapResponse;
 
@@ -83,6 +84,8 @@ void coap_SetPSK(const char * identity, const uint8_t * key, int keyLength);
 
 int coap_Destroy(void);
 void coap_Process(void);
+// Milliseconds until coap_Process() next has retransmissions or timeouts to handle, at most maxTimeout.
+int coap_GetTimeout(int maxTimeout);
 void coap_HandleMessage(void);
 
 void coap_SetLogLevel(int logLevel);
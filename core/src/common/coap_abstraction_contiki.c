@@ -512,6 +512,11 @@ void coap_Process(void)
 
 }
 
+int coap_GetTimeout(int maxTimeout)
+{
+    return maxTimeout;
+}
+
 void coap_HandleMessage(void)
 {
 
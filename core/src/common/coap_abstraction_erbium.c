@@ -24,6 +24,11 @@
 #include <stdlib.h>
 #include "coap_abstraction.h"
 #include "lwm2m_debug.h"
+#include "lwm2m_hash.h"
+#include "lwm2m_list.h"
+#include "lwm2m_util.h"
+#include "lwm2m_deadline_queue.h"
+#include "coap_block_cache.h"
 #include "network_abstraction.h"
 #include "dtls_abstraction.h"
 
@@ -35,14 +40,69 @@
 #define MAX_COAP_PATH 64
 #endif
 
+// Maximum number of simultaneous outstanding requests to a single peer (NSTART, RFC 7252 section 4.7).
+// Further requests to that peer are queued until an outstanding one completes. The RFC default of 1
+// would serialise the server's requests to each client, so allow a few in flight.
+#ifndef COAP_NSTART
+#define COAP_NSTART (8)
+#endif
+
+// Limits on block-wise transfers held between blocks (see coap_block_cache.h)
+#ifndef COAP_BLOCK_CACHE_TRANSFERS
+#define COAP_BLOCK_CACHE_TRANSFERS (8)
+#endif
+#ifndef COAP_BLOCK_CACHE_BYTES
+#define COAP_BLOCK_CACHE_BYTES (256 * 1024)
+#endif
+#ifndef COAP_BLOCK_CACHE_TRANSFER_SIZE
+#define COAP_BLOCK_CACHE_TRANSFER_SIZE (64 * 1024)
+#endif
+#ifndef COAP_BLOCK_CACHE_LIFETIME_MS
+#define COAP_BLOCK_CACHE_LIFETIME_MS (60 * 1000)
+#endif
+
+// Largest block requested when following up a Block2 response from a peer; the peer may choose a smaller one
+#ifndef COAP_BLOCK2_MAX_SIZE
+#define COAP_BLOCK2_MAX_SIZE (1024)
+#endif
+#if (COAP_BLOCK2_MAX_SIZE + COAP_MAX_HEADER_SIZE) > COAP_BUFFER_LENGTH
+#error "COAP_BUFFER_LENGTH too small for COAP_BLOCK2_MAX_SIZE"
+#endif
+
+typedef struct
+{
+    HashEntry AddressIndex;
+    NetworkAddress * Address;
+    int Outstanding;
+    struct ListHead PendingList;
+} PeerType;
+
 typedef struct
 {
+    struct ListHead PendingList;
+    HashEntry TokenIndex;
+    PeerType * Peer;                        // NULL once the request no longer counts against the peer's NSTART
+    NetworkAddress * RemoteAddress;
     AddressType Address;
     char Path[MAX_COAP_PATH];
+    char Query[128];
+    coap_method_t Method;
+    ContentType Accept;
     TransactionCallback Callback;
     void * Context;
-    bool TransactionUsed;
+    int Token;
+    uint16_t Mid;
+    DeadlineEntry Expiry;                   // Scheduled while waiting for a separate response
     coap_transaction_t * TransactionPtr;
+    uint8_t * Packet;                       // serialised request, held while queued
+    uint16_t PacketLen;
+    uint8_t * Content;                      // Block2 response reassembled so far
+    size_t ContentLength;
+    size_t ContentCapacity;
+    uint32_t BlockNum;                      // Next Block2 block to request
+    uint16_t BlockSize;
+    uint8_t ETag[COAP_ETAG_LEN];
+    int ETagLength;
 } TransactionType;
 
 #define COAP_OPTION_TO_RESPONSE_CODE(N) (((N >> 5) * 100) | (N & 0x1f))
@@ -55,12 +115,11 @@ static RequestHandler requestHandler = NULL;
 
 const char * coap_LibraryName = "Erbium";
 
-#ifndef MAX_COAP_TRANSACTIONS
-#define MAX_COAP_TRANSACTIONS (2)
-#endif
-
-int CurrentTransactionIndex = 0;
-TransactionType CurrentTransaction[MAX_COAP_TRANSACTIONS];
+// Requests are indexed by token so separate responses can be matched, and peers by address for NSTART accounting
+static HashTable transactionTokenIndex;
+static HashTable peerIndex;
+static DeadlineQueue separateResponseQueue;
+static int lastToken = 0;
 
 static NetworkSocket * networkSocket = NULL;
 extern NetworkAddress * sourceAddress;
@@ -72,6 +131,8 @@ typedef enum
 
 typedef struct
 {
+    struct ListHead list;
+    HashEntry TokenIndex;
     NetworkAddress * Address;
     char Path[MAX_COAP_PATH];
     int Token;
@@ -79,21 +140,32 @@ typedef struct
     void * Context;
 } Observation;
 
-#ifndef MAX_COAP_OBSERVATIONS
-#define MAX_COAP_OBSERVATIONS (10)
-#endif
+static struct ListHead observationList;
+static HashTable observationTokenIndex;
 
-Observation Observations[MAX_COAP_OBSERVATIONS];
+// Block2 responses are encoded into blockContent, and kept in blockCache if they span several blocks
+static BlockCache blockCache;
+static uint8_t blockContent[COAP_BLOCK_CACHE_TRANSFER_SIZE];
 
 static int coap_HandleRequest(void *packet, void *response, uint8_t *buffer, uint16_t preferred_size, int32_t *offset);
 static int addObserve(NetworkAddress * remoteAddress, char * path, TransactionCallback callback, void * context);
 static int removeObserve(NetworkAddress * remoteAddress, char * path);
+static void releasePeer(PeerType * peer);
+void coap_CoapRequestCallback(void *callback_data, void *response);
 
 CoapInfo * coap_Init(const char * ipAddress, int port, bool secure, int logLevel)
 {
     Lwm2m_Info("Bind port: %d\n", port);
-    memset(CurrentTransaction, 0, sizeof(CurrentTransaction));
-    memset(Observations, 0, sizeof(Observations));
+    if (transactionTokenIndex.Buckets == NULL)
+    {
+        HashTable_Init(&transactionTokenIndex, HASH_TABLE_DEFAULT_BUCKETS);
+        HashTable_Init(&peerIndex, HASH_TABLE_DEFAULT_BUCKETS);
+        HashTable_Init(&observationTokenIndex, HASH_TABLE_DEFAULT_BUCKETS);
+        DeadlineQueue_Init(&separateResponseQueue);
+        ListInit(&observationList);
+        BlockCache_Init(&blockCache, COAP_BLOCK_CACHE_TRANSFERS, COAP_BLOCK_CACHE_BYTES, COAP_BLOCK_CACHE_TRANSFER_SIZE, COAP_BLOCK_CACHE_LIFETIME_MS);
+        lastToken = rand();
+    }
     coap_init_connection(port);
     coap_init_transactions();
     coap_set_service_callback(coap_HandleRequest);
@@ -144,6 +216,135 @@ int coap_WaitMessage(int timeout, int fd)
     return timeout;
 }
 
+// Copy the block of a cached Block2 transfer at offset into the response, and set offset to the next block (-1 after the last)
+static void serveBlock(BlockCache * cache, BlockTransfer * transfer, void * response, CoapResponse * coapResponse, size_t blockSize, int32_t * offset)
+{
+    size_t start = *offset;
+    size_t length = 0;
+
+    if (start < transfer->Length)
+    {
+        length = (transfer->Length - start < blockSize) ? transfer->Length - start : blockSize;
+        memcpy(coapResponse->responseContent, &transfer->Data[start], length);
+        *offset = (start + length < transfer->Length) ? (int32_t)(start + length) : -1;
+    }
+    coap_set_header_etag(response, transfer->ETag, BLOCK_CACHE_ETAG_LEN);
+    coap_set_header_size2(response, transfer->Length);
+
+    coapResponse->responseContentType = transfer->DataContentType;
+    coapResponse->responseContentLen = length;
+    coapResponse->responseCode = 205;
+
+    if (*offset == -1)
+    {
+        BlockCache_Remove(cache, transfer);
+    }
+}
+
+// Handle a GET. A representation larger than one block is held in the block cache, so later Block2
+// requests are sliced from it rather than re-encoding the resource for every block.
+static void handleGet(CoapRequest * coapRequest, CoapResponse * coapResponse, void * response, const char * uri, int32_t * offset)
+{
+    char * buffer = coapResponse->responseContent;
+    size_t blockSize = coapResponse->responseContentLen;
+    uint64_t now = Lwm2mCore_GetTickCountMs();
+    BlockTransfer * transfer = NULL;
+
+    if (*offset > 0)
+    {
+        transfer = BlockCache_Find(&blockCache, sourceAddress, BlockDirection_Download, uri, coapRequest->contentType, now);
+        if (transfer == NULL)
+        {
+            // Not cached, so have the handler encode just the requested block
+            coapResponse->responseOffset = *offset;
+            requestHandler(coapRequest, coapResponse);
+            *offset = coapResponse->responseOffset;
+            return;
+        }
+        serveBlock(&blockCache, transfer, response, coapResponse, blockSize, offset);
+        return;
+    }
+
+    coapResponse->responseContent = (char *)blockContent;
+    coapResponse->responseContentLen = sizeof(blockContent);
+    coapResponse->responseOffset = 0;
+    requestHandler(coapRequest, coapResponse);
+    coapResponse->responseContent = buffer;
+
+    bool complete = (coapResponse->responseOffset == 0);
+    if ((coapResponse->responseCode != 205) || (complete && (coapResponse->responseContentLen <= blockSize)))
+    {
+        coapResponse->responseContentLen = (coapResponse->responseContentLen < blockSize) ? coapResponse->responseContentLen : blockSize;
+        memcpy(buffer, blockContent, coapResponse->responseContentLen);
+        return;
+    }
+
+    if (complete && ((transfer = BlockCache_Add(&blockCache, sourceAddress, BlockDirection_Download, uri, coapRequest->contentType, now)) != NULL))
+    {
+        transfer->DataContentType = coapResponse->responseContentType;
+        if (BlockCache_Append(&blockCache, transfer, blockContent, coapResponse->responseContentLen) == 0)
+        {
+            serveBlock(&blockCache, transfer, response, coapResponse, blockSize, offset);
+            return;
+        }
+        BlockCache_Remove(&blockCache, transfer);
+    }
+
+    // Too large to hold: send the first block, and encode later blocks on demand
+    memcpy(buffer, blockContent, blockSize);
+    coapResponse->responseContentLen = blockSize;
+    *offset = blockSize;
+}
+
+// Collect the blocks of a Block1 upload. Returns true once the whole payload is available to the handler through
+// coapRequest, with the transfer holding it in upload. Otherwise the response is complete: 2.31 Continue for an
+// intermediate block, or an error.
+static bool collectBlock1(void * request, void * response, CoapRequest * coapRequest, CoapResponse * coapResponse, const char * uri, BlockTransfer ** upload)
+{
+    uint32_t num;
+    uint8_t more;
+    uint16_t size;
+    uint32_t blockOffset;
+    uint64_t now = Lwm2mCore_GetTickCountMs();
+
+    *upload = NULL;
+    if (!coap_get_header_block1(request, &num, &more, &size, &blockOffset))
+    {
+        return true;
+    }
+
+    BlockTransfer * transfer = (num == 0) ? BlockCache_Add(&blockCache, sourceAddress, BlockDirection_Upload, uri, coapRequest->contentType, now)
+                                          : BlockCache_Find(&blockCache, sourceAddress, BlockDirection_Upload, uri, coapRequest->contentType, now);
+    coapResponse->responseContentLen = 0;
+
+    if ((transfer == NULL) || (transfer->Length != blockOffset))
+    {
+        Lwm2m_Error("Block1 %u for %s is out of sequence\n", num, uri);
+        BlockCache_Remove(&blockCache, transfer);
+        coapResponse->responseCode = 408;   // Request Entity Incomplete
+        return false;
+    }
+
+    if (BlockCache_Append(&blockCache, transfer, coapRequest->requestContent, coapRequest->requestContentLen) != 0)
+    {
+        BlockCache_Remove(&blockCache, transfer);
+        coapResponse->responseCode = 413;   // Request Entity Too Large
+        return false;
+    }
+
+    coap_set_header_block1(response, num, more, size);
+    if (more)
+    {
+        coapResponse->responseCode = 231;   // Continue
+        return false;
+    }
+
+    coapRequest->requestContent = (const char *)transfer->Data;
+    coapRequest->requestContentLen = transfer->Length;
+    *upload = transfer;
+    return true;
+}
+
 static int coap_HandleRequest(void *packet, void *response, uint8_t *buffer, uint16_t preferred_size, int32_t *offset)
 {
     int result = 1;
@@ -177,6 +378,11 @@ static int coap_HandleRequest(void *packet, void *response, uint8_t *buffer, uin
 
         queryBuf[queryLength+1] = '\0';
 
+        // Block-wise transfers are identified by the full request URI
+        char uriKey[MAX_COAP_PATH + sizeof(queryBuf)];
+        snprintf(uriKey, sizeof(uriKey), "%s%s", uriBuf, (queryLength > 0) ? queryBuf : "");
+        BlockTransfer * upload = NULL;
+
         CoapRequest coapRequest =
         { .ctxt = context, .addr =
         { 0 }, .path = uriBuf, .query = queryBuf, .token = request->token, .tokenLength = request->token_len, .requestContent = payload,
@@ -201,7 +407,7 @@ static int coap_HandleRequest(void *packet, void *response, uint8_t *buffer, uin
             case -1:
                 Lwm2m_Debug("Coap GET for %s\n", uriBuf);
                 coapRequest.type = COAP_GET_REQUEST;
-                requestHandler(&coapRequest, &coapResponse);
+                handleGet(&coapRequest, &coapResponse, response, uriKey, offset);
                 break;
             case 0:
                 Lwm2m_Debug("Coap OBSERVE for %s\n", uriBuf);
@@ -227,10 +433,13 @@ static int coap_HandleRequest(void *packet, void *response, uint8_t *buffer, uin
             coapRequest.contentType = content;
             coapRequest.type = COAP_POST_REQUEST;
             Lwm2m_Debug("Coap POST for %s\n", uriBuf);
-            requestHandler(&coapRequest, &coapResponse);
-            if (coapResponse.responseContentLen > 0 && coapResponse.responseCode == 201)
+            if (collectBlock1(request, response, &coapRequest, &coapResponse, uriKey, &upload))
             {
-                coap_set_header_location_path(response, coapResponse.responseContent);
+                requestHandler(&coapRequest, &coapResponse);
+                if (coapResponse.responseContentLen > 0 && coapResponse.responseCode == 201)
+                {
+                    coap_set_header_location_path(response, coapResponse.responseContent);
+                }
             }
             break;
 
@@ -240,7 +449,10 @@ static int coap_HandleRequest(void *packet, void *response, uint8_t *buffer, uin
             coapRequest.type = COAP_PUT_REQUEST;
 
             Lwm2m_Debug("Coap PUT for %s\n", uriBuf);
-            requestHandler(&coapRequest, &coapResponse);
+            if (collectBlock1(request, response, &coapRequest, &coapResponse, uriKey, &upload))
+            {
+                requestHandler(&coapRequest, &coapResponse);
+            }
             break;
 
         case METHOD_DELETE:
@@ -259,6 +471,9 @@ static int coap_HandleRequest(void *packet, void *response, uint8_t *buffer, uin
         {
             coap_set_payload(response, coapResponse.responseContent, coapResponse.responseContentLen);
         }
+
+        // A completed upload is no longer needed once the handler has consumed it
+        BlockCache_Remove(&blockCache, upload);
     }
 
     coap_set_status_code(response, COAP_RESPONSE_CODE(coapResponse.responseCode));
@@ -310,10 +525,261 @@ int coap_ResolveAddressByURI(unsigned char * address, AddressType * addr)
     return result;
 }
 
+static int newToken(void)
+{
+    do
+    {
+        lastToken++;
+    } while (lastToken == 0);
+    return lastToken;
+}
+
+static PeerType * getPeer(NetworkAddress * address)
+{
+    PeerType * result = NULL;
+    struct ListHead * i;
+    uint32_t hash = Hash_Bytes(&address, sizeof(address));
+    ListForEach(i, HashTable_GetBucket(&peerIndex, hash))
+    {
+        HashEntry * entry = ListEntry(i, HashEntry, list);
+        PeerType * peer = ListEntry(entry, PeerType, AddressIndex);
+        if ((entry->Hash == hash) && (peer->Address == address))
+        {
+            result = peer;
+            break;
+        }
+    }
+    if (result == NULL)
+    {
+        result = (PeerType *)malloc(sizeof(PeerType));
+        if (result)
+        {
+            memset(result, 0, sizeof(PeerType));
+            result->Address = address;
+            ListInit(&result->PendingList);
+            HashTable_Add(&peerIndex, &result->AddressIndex, hash);
+        }
+    }
+    return result;
+}
+
+static void freeTransaction(TransactionType * transaction)
+{
+    HashTable_Remove(&transactionTokenIndex, &transaction->TokenIndex);
+    DeadlineQueue_Cancel(&separateResponseQueue, &transaction->Expiry);
+    ListRemove(&transaction->PendingList);
+    free(transaction->Packet);
+    free(transaction->Content);
+    free(transaction);
+}
+
+static bool sendTransaction(TransactionType * transaction, const uint8_t * packet, uint16_t packetLen)
+{
+    bool result = false;
+    coap_transaction_t * coapTransaction = coap_new_transaction(networkSocket, transaction->Mid, transaction->RemoteAddress);
+    if (coapTransaction)
+    {
+        coapTransaction->callback = coap_CoapRequestCallback;
+        coapTransaction->callback_data = transaction;
+        memcpy(coapTransaction->packet, packet, packetLen);
+        coapTransaction->packet_len = packetLen;
+
+        transaction->TransactionPtr = coapTransaction;
+        transaction->Peer->Outstanding++;
+
+        Lwm2m_Debug("Sending transaction [%d]: %p\n", transaction->Mid, coapTransaction);
+        coap_send_transaction(coapTransaction);
+        result = true;
+    }
+    else
+    {
+        Lwm2m_Error("Failed to allocate CoAP transaction for %s\n", transaction->Path);
+    }
+    return result;
+}
+
+// Sends the request now if the peer is below NSTART, otherwise queues it behind the outstanding ones
+static bool startTransaction(TransactionType * transaction, const uint8_t * packet, uint16_t packetLen)
+{
+    bool result = false;
+    transaction->Peer = getPeer(transaction->RemoteAddress);
+    if (transaction->Peer == NULL)
+    {
+        Lwm2m_Error("Failed to allocate peer for %s\n", transaction->Path);
+    }
+    else if (transaction->Peer->Outstanding < COAP_NSTART)
+    {
+        result = sendTransaction(transaction, packet, packetLen);
+    }
+    else if ((transaction->Packet = (uint8_t *)malloc(packetLen)) != NULL)
+    {
+        Lwm2m_Debug("Queueing transaction [%d] behind %d outstanding\n", transaction->Mid, transaction->Peer->Outstanding);
+        memcpy(transaction->Packet, packet, packetLen);
+        transaction->PacketLen = packetLen;
+        ListAdd(&transaction->PendingList, &transaction->Peer->PendingList);
+        result = true;
+    }
+    else
+    {
+        Lwm2m_Error("Failed to queue transaction for %s\n", transaction->Path);
+    }
+    return result;
+}
+
+// Called when a request to the peer completes - sends queued requests while the peer is below NSTART.
+static void releasePeer(PeerType * peer)
+{
+    peer->Outstanding--;
+    while ((peer->Outstanding < COAP_NSTART) && (peer->PendingList.Next != &peer->PendingList))
+    {
+        TransactionType * transaction = ListEntry(peer->PendingList.Next, TransactionType, PendingList);
+        ListRemove(&transaction->PendingList);
+        if (sendTransaction(transaction, transaction->Packet, transaction->PacketLen))
+        {
+            free(transaction->Packet);
+            transaction->Packet = NULL;
+        }
+        else
+        {
+            freeTransaction(transaction);
+        }
+    }
+    if ((peer->Outstanding == 0) && (peer->PendingList.Next == &peer->PendingList))
+    {
+        HashTable_Remove(&peerIndex, &peer->AddressIndex);
+        free(peer);
+    }
+}
+
+// Appends a Block2 response to the transaction's content. Returns false if another block must be
+// requested, or true once the representation is complete (or the transfer failed) and can be delivered.
+static bool collectBlock2(TransactionType * transaction, coap_packet_t * response, int * responseCode, char ** payload, int * payloadLength)
+{
+    bool result = true;
+    uint32_t num = 0;
+    uint8_t more = 0;
+    uint16_t size = 0;
+    uint32_t offset = 0;
+    uint32_t total = 0;
+    const uint8_t * etag = NULL;
+    int etagLength = coap_get_header_etag(response, &etag);
+
+    coap_get_header_block2(response, &num, &more, &size, &offset);
+    coap_get_header_size2(response, &total);
+
+    if ((num == 0) && !more)
+    {
+        // Whole representation in one block - deliver it in place
+    }
+    else if ((offset != transaction->ContentLength) || ((num > 0) &&
+             ((etagLength != transaction->ETagLength) || ((etagLength > 0) && (memcmp(etag, transaction->ETag, etagLength) != 0)))))
+    {
+        Lwm2m_Error("Block2 transfer of %s interrupted at block %u\n", transaction->Path, num);
+        *responseCode = 408;
+    }
+    else
+    {
+        size_t length = transaction->ContentLength + *payloadLength;
+        if (length > COAP_BLOCK_CACHE_TRANSFER_SIZE)
+        {
+            Lwm2m_Error("Block2 transfer of %s exceeds %d bytes\n", transaction->Path, COAP_BLOCK_CACHE_TRANSFER_SIZE);
+            *responseCode = 413;
+        }
+        else
+        {
+            if (length > transaction->ContentCapacity)
+            {
+                // Size2 gives the total up front; otherwise grow geometrically
+                size_t capacity = (total >= length) ? total : transaction->ContentCapacity * 2;
+                if (capacity < length)
+                    capacity = length;
+                if (capacity > COAP_BLOCK_CACHE_TRANSFER_SIZE)
+                    capacity = COAP_BLOCK_CACHE_TRANSFER_SIZE;
+                uint8_t * content = (uint8_t *)realloc(transaction->Content, capacity);
+                if (content == NULL)
+                {
+                    Lwm2m_Error("Failed to allocate %zu bytes for Block2 transfer of %s\n", capacity, transaction->Path);
+                    *responseCode = 500;
+                    length = 0;
+                }
+                else
+                {
+                    transaction->Content = content;
+                    transaction->ContentCapacity = capacity;
+                }
+            }
+            if (length > 0)
+            {
+                memcpy(&transaction->Content[transaction->ContentLength], *payload, *payloadLength);
+                transaction->ContentLength = length;
+                if (num == 0)
+                {
+                    transaction->ETagLength = etagLength;
+                    memcpy(transaction->ETag, etag, etagLength);
+                }
+                if (more)
+                {
+                    if (total > 0)
+                    {
+                        Lwm2m_Debug("Block2 transfer of %s: %zu of %u bytes\n", transaction->Path, transaction->ContentLength, total);
+                    }
+                    else
+                    {
+                        Lwm2m_Debug("Block2 transfer of %s: %zu bytes\n", transaction->Path, transaction->ContentLength);
+                    }
+                    transaction->BlockSize = MIN(size, COAP_BLOCK2_MAX_SIZE);
+                    transaction->BlockNum = transaction->ContentLength / transaction->BlockSize;
+                    result = false;
+                }
+                else
+                {
+                    *payload = (char *)transaction->Content;
+                    *payloadLength = transaction->ContentLength;
+                }
+            }
+        }
+    }
+
+    if (*responseCode != COAP_OPTION_TO_RESPONSE_CODE(CONTENT_2_05))
+    {
+        *payload = NULL;
+        *payloadLength = 0;
+    }
+    return result;
+}
+
+// Requests the next block of a Block2 response, reusing the transaction and its token
+static void requestNextBlock(TransactionType * transaction)
+{
+    coap_packet_t request;
+    uint8_t packet[COAP_MAX_PACKET_SIZE + 1];
+
+    coap_init_message(&request, COAP_TYPE_CON, COAP_GET, coap_get_mid());
+    coap_set_header_uri_path(&request, transaction->Path);
+    if (strlen(transaction->Query) > 0)
+        coap_set_header_uri_query(&request, transaction->Query);
+    if (transaction->Accept != ContentType_None)
+        coap_set_header_accept(&request, transaction->Accept);
+    coap_set_header_block2(&request, transaction->BlockNum, 0, transaction->BlockSize);
+    coap_set_token(&request, (const uint8_t *) &transaction->Token, sizeof(transaction->Token));
+
+    transaction->Mid = request.mid;
+    DeadlineQueue_Cancel(&separateResponseQueue, &transaction->Expiry);
+    if (!startTransaction(transaction, packet, coap_serialize_message(&request, packet)))
+    {
+        if (transaction->Callback)
+        {
+            transaction->Callback(transaction->Context, NULL, NULL, 0, 0, NULL, 0);
+        }
+        freeTransaction(transaction);
+    }
+}
+
 void coap_CoapRequestCallback(void *callback_data, void *response)
 {
     TransactionType * transaction = (TransactionType *) callback_data;
     coap_packet_t * coap_response = (coap_packet_t *) response;
+    bool complete = true;
     int ContentType = 0;
     const char *url = NULL;
     char * payload = NULL;
@@ -322,37 +788,101 @@ void coap_CoapRequestCallback(void *callback_data, void *response)
 
     if (transaction != NULL)
     {
-        if (transaction->Callback)
+        PeerType * peer = transaction->Peer;
+        transaction->Peer = NULL;
+        transaction->TransactionPtr = NULL;
+
+        if ((coap_response != NULL) && (coap_response->type == COAP_TYPE_ACK) && (coap_response->code == 0))
+        {
+            // Empty ACK - the response will follow separately and is matched by token
+            Lwm2m_Debug("Transaction [%d] acknowledged, waiting for separate response\n", transaction->Mid);
+            DeadlineQueue_Schedule(&separateResponseQueue, &transaction->Expiry, Lwm2mCore_GetTickCountMs() + COAP_EXCHANGE_LIFETIME_MS);
+        }
+        else
         {
-            if (response != NULL )
+            if (transaction->Callback)
             {
-                int urlLen = 0;
-                if ((urlLen = coap_get_header_location_path(response, &url)))
+                if (response != NULL )
                 {
-                    uriBuf[0] = '/';
-                    memcpy(&uriBuf[1], url, urlLen);
+                    int urlLen = 0;
+                    if ((urlLen = coap_get_header_location_path(response, &url)))
+                    {
+                        uriBuf[0] = '/';
+                        memcpy(&uriBuf[1], url, urlLen);
+                    }
+                    else
+                    {
+                        uriBuf[0] = '/';
+                        urlLen = strlen(transaction->Path);
+                        memcpy(&uriBuf[1], transaction->Path, urlLen);
+                    }
+                    coap_get_header_content_format(response, &ContentType);
+                    int payloadLen = coap_get_payload(response, (const uint8_t **) &payload);
+                    int responseCode = COAP_OPTION_TO_RESPONSE_CODE(coap_response->code);
+
+                    if ((transaction->Method == COAP_GET) && (coap_response->code == CONTENT_2_05) &&
+                        coap_get_header_block2(response, NULL, NULL, NULL, NULL))
+                    {
+                        complete = collectBlock2(transaction, coap_response, &responseCode, &payload, &payloadLen);
+                    }
+                    if (complete)
+                    {
+                        transaction->Callback(transaction->Context, &transaction->Address, uriBuf, responseCode, ContentType, payload, payloadLen);
+                    }
                 }
                 else
                 {
-                    uriBuf[0] = '/';
-                    urlLen = strlen(transaction->Path);
-                    memcpy(&uriBuf[1], transaction->Path, urlLen);
+                    transaction->Callback(transaction->Context, NULL, NULL, 0, 0, NULL, 0);
                 }
-                coap_get_header_content_format(response, &ContentType);
-                int payloadLen = coap_get_payload(response, (const uint8_t **) &payload);
-
-                transaction->Callback(transaction->Context, &transaction->Address, uriBuf, COAP_OPTION_TO_RESPONSE_CODE(coap_response->code),
-                        ContentType, payload, payloadLen);
             }
-            else
+            if (complete)
             {
-                transaction->Callback(transaction->Context, NULL, NULL, 0, 0, NULL, 0);
+                freeTransaction(transaction);
             }
         }
-        transaction->TransactionUsed = false;
+
+        if (peer)
+        {
+            releasePeer(peer);
+        }
+        if (!complete)
+        {
+            // Released first so the follow-up request is subject to NSTART like any other
+            requestNextBlock(transaction);
+        }
     }
 }
 
+int coap_handle_separate_response(NetworkAddress * sourceAddress, coap_packet_t * message)
+{
+    int result = 0;
+    if (message->token_len == sizeof(int))
+    {
+        int token;
+        struct ListHead * i;
+        memcpy(&token, message->token, sizeof(int));
+        uint32_t hash = Hash_Integer(token);
+        ListForEach(i, HashTable_GetBucket(&transactionTokenIndex, hash))
+        {
+            HashEntry * entry = ListEntry(i, HashEntry, list);
+            TransactionType * transaction = ListEntry(entry, TransactionType, TokenIndex);
+            if ((entry->Hash == hash) && (transaction->Token == token) && (transaction->Packet == NULL) &&
+                (NetworkAddress_Compare(transaction->RemoteAddress, sourceAddress) == 0))
+            {
+                // The separate response also ends the exchange if our ACK was lost
+                if (transaction->TransactionPtr)
+                {
+                    coap_clear_transaction(&transaction->TransactionPtr);
+                }
+                coap_CoapRequestCallback(transaction, message);
+                result = 1;
+                break;
+            }
+        }
+    }
+    return result;
+}
+
 void coap_createCoapRequest(coap_method_t method, const char * uri, ContentType contentType, ObserveState observeState,
         const char * payload, int payloadLen, TransactionCallback callback, void * context)
 {
@@ -361,7 +891,9 @@ void coap_createCoapRequest(coap_method_t method, const char * uri, ContentType
     { 0 };
     char query[128] =
     { 0 };
-    coap_transaction_t *transaction;
+    uint8_t packet[COAP_MAX_PACKET_SIZE + 1];
+    int token = 0;
+    TransactionType * transaction;
     NetworkAddress * remoteAddress = NetworkAddress_New(uri, strlen(uri));
 
     if ((strcmp(DTLS_LibraryName, "None") == 0) && NetworkAddress_IsSecure(remoteAddress))
@@ -402,57 +934,87 @@ void coap_createCoapRequest(coap_method_t method, const char * uri, ContentType
         if (observeState == ObserveState_Establish)
         {
             coap_set_header_observe(&request, 0);
-            int token = addObserve(remoteAddress, path, callback, context);
-            if (token != 0)
-                coap_set_token(&request, (const uint8_t *) &token, sizeof(token));
-
+            token = addObserve(remoteAddress, path, callback, context);
         }
         else if (observeState == ObserveState_Cancel)
         {
             coap_set_header_observe(&request, 1);
-            int token = removeObserve(remoteAddress, path);
-            if (token != 0)
-                coap_set_token(&request, (const uint8_t *) &token, sizeof(token));
+            token = removeObserve(remoteAddress, path);
         }
     }
 
-    if (CurrentTransaction[CurrentTransactionIndex].TransactionUsed && CurrentTransaction[CurrentTransactionIndex].TransactionPtr)
+    if (token == 0)
+        token = newToken();
+    coap_set_token(&request, (const uint8_t *) &token, sizeof(token));
+
+    transaction = (TransactionType *)malloc(sizeof(TransactionType));
+    if (transaction == NULL)
     {
-        Lwm2m_Warning("Canceled previous transaction [%d]: %p\n", CurrentTransactionIndex,
-                CurrentTransaction[CurrentTransactionIndex].TransactionPtr);
-        coap_clear_transaction(&CurrentTransaction[CurrentTransactionIndex].TransactionPtr);
+        Lwm2m_Error("Failed to allocate transaction for %s\n", uri);
+        return;
     }
-
-    //if ((transaction = coap_new_transaction(request.mid, remote_ipaddr, uip_htons(remote_port))))
-    if ((transaction = coap_new_transaction(networkSocket, request.mid, remoteAddress)))
+    memset(transaction, 0, sizeof(TransactionType));
+    ListInit(&transaction->PendingList);
+    DeadlineQueue_InitEntry(&transaction->Expiry);
+    transaction->RemoteAddress = remoteAddress;
+    NetworkAddress_SetAddressType(remoteAddress, &transaction->Address);
+    memcpy(transaction->Path, path, MAX_COAP_PATH);
+    memcpy(transaction->Query, query, sizeof(transaction->Query));
+    transaction->Method = method;
+    transaction->Accept = ((method == COAP_POST) || (method == COAP_PUT)) ? ContentType_None : contentType;
+    transaction->Callback = callback;
+    transaction->Context = context;
+    transaction->Token = token;
+    transaction->Mid = request.mid;
+    HashTable_Add(&transactionTokenIndex, &transaction->TokenIndex, Hash_Integer(token));
+
+    uint16_t packetLen = coap_serialize_message(&request, packet);
+
+    if (!startTransaction(transaction, packet, packetLen))
     {
-        transaction->callback = coap_CoapRequestCallback;
-        memcpy(CurrentTransaction[CurrentTransactionIndex].Path, path, MAX_COAP_PATH);
-        CurrentTransaction[CurrentTransactionIndex].Callback = callback;
-        CurrentTransaction[CurrentTransactionIndex].Context = context;
-        CurrentTransaction[CurrentTransactionIndex].TransactionUsed = true;
-        CurrentTransaction[CurrentTransactionIndex].TransactionPtr = transaction;
-        NetworkAddress_SetAddressType(remoteAddress, &CurrentTransaction[CurrentTransactionIndex].Address);
-
-        transaction->callback_data = &CurrentTransaction[CurrentTransactionIndex];
-
-        transaction->packet_len = coap_serialize_message(&request, transaction->packet);
-
-        Lwm2m_Debug("Sending transaction [%d]: %p\n", CurrentTransactionIndex, CurrentTransaction[CurrentTransactionIndex].TransactionPtr);
-        coap_send_transaction(transaction);
-
-        CurrentTransactionIndex++;
+        freeTransaction(transaction);
+    }
+}
 
-        if (CurrentTransactionIndex >= MAX_COAP_TRANSACTIONS)
+static void destroyTransactions(void)
+{
+    size_t index;
+    struct ListHead * i, * next;
+    for (index = 0; index < transactionTokenIndex.NumBuckets; index++)
+    {
+        ListForEachSafe(i, next, &transactionTokenIndex.Buckets[index])
+        {
+            TransactionType * transaction = ListEntry(ListEntry(i, HashEntry, list), TransactionType, TokenIndex);
+            if (transaction->TransactionPtr)
+            {
+                coap_clear_transaction(&transaction->TransactionPtr);
+            }
+            freeTransaction(transaction);
+        }
+    }
+    for (index = 0; index < peerIndex.NumBuckets; index++)
+    {
+        ListForEachSafe(i, next, &peerIndex.Buckets[index])
         {
-            CurrentTransactionIndex = 0;
+            free(ListEntry(ListEntry(i, HashEntry, list), PeerType, AddressIndex));
         }
     }
+    ListForEachSafe(i, next, &observationList)
+    {
+        free(ListEntry(i, Observation, list));
+    }
+    HashTable_Destroy(&transactionTokenIndex);
+    HashTable_Destroy(&peerIndex);
+    HashTable_Destroy(&observationTokenIndex);
+    DeadlineQueue_Destroy(&separateResponseQueue);
+    coap_destroy_transactions();
 }
 
 int coap_Destroy(void)
 {
     Lwm2m_Info("Close port: \n");     //  TODO - remove
+    destroyTransactions();
+    BlockCache_Destroy(&blockCache);
     if (networkSocket)
         NetworkSocket_Free(&networkSocket);
     // TODO - close any open sessions
@@ -463,7 +1025,22 @@ int coap_Destroy(void)
 
 void coap_Process(void)
 {
+    DeadlineEntry * entry;
     coap_check_transactions();
+
+    // Give up on requests whose separate response never arrived
+    while ((entry = DeadlineQueue_PopExpired(&separateResponseQueue, Lwm2mCore_GetTickCountMs())) != NULL)
+    {
+        TransactionType * transaction = ListEntry(entry, TransactionType, Expiry);
+        Lwm2m_Warning("Timed out waiting for separate response to transaction [%d]\n", transaction->Mid);
+        coap_CoapRequestCallback(transaction, NULL);
+    }
+}
+
+int coap_GetTimeout(int maxTimeout)
+{
+    int timeout = coap_get_transactions_timeout(maxTimeout);
+    return DeadlineQueue_GetTimeout(&separateResponseQueue, Lwm2mCore_GetTickCountMs(), timeout);
 }
 
 void coap_HandleMessage(void)
@@ -563,44 +1140,20 @@ int coap_DeregisterUri(const char * path)
 static int addObserve(NetworkAddress * remoteAddress, char * path, TransactionCallback callback, void * context)
 {
     int result = 0;
-    int index;
-    Observation * observation = NULL;
-    for (index = 0; index < MAX_COAP_OBSERVATIONS; index++)
-    {
-        if (Observations[index].Token == 0)
-        {
-            observation = &Observations[index];
-            break;
-        }
-    }
+    Observation * observation = (Observation *)malloc(sizeof(Observation));
     if (observation)
     {
+        memset(observation, 0, sizeof(Observation));
         observation->Address = remoteAddress;
         int length = strlen(path);
         memcpy(observation->Path, path, length);
         observation->Path[length] = '\0';
-        bool found;
-        do
-        {
-            result = rand();
-            if (result == 0)
-                found = true;
-            else
-            {
-                found = false;
-                for (index = 0; index < MAX_COAP_OBSERVATIONS; index++)
-                {
-                    if (Observations[index].Token == result)
-                    {
-                        found = true;
-                        break;
-                    }
-                }
-            }
-        } while (found);
+        result = newToken();
         observation->Token = result;
         observation->Callback =  callback;
         observation->Context = context;
+        ListAdd(&observation->list, &observationList);
+        HashTable_Add(&observationTokenIndex, &observation->TokenIndex, Hash_Integer(result));
     }
     return result;
 }
@@ -608,13 +1161,16 @@ static int addObserve(NetworkAddress * remoteAddress, char * path, TransactionCa
 static int removeObserve(NetworkAddress * remoteAddress, char * path)
 {
     int result = 0;
-    int index;
-    for (index = 0; index < MAX_COAP_OBSERVATIONS; index++)
+    struct ListHead * i;
+    ListForEach(i, &observationList)
     {
-        if ((NetworkAddress_Compare(Observations[index].Address, sourceAddress) == 0) && (strcmp(Observations[index].Path,path) == 0))
+        Observation * observation = ListEntry(i, Observation, list);
+        if ((NetworkAddress_Compare(observation->Address, remoteAddress) == 0) && (strcmp(observation->Path, path) == 0))
         {
-            result = Observations[index].Token;
-            memset(&Observations[index],0, sizeof(Observation));
+            result = observation->Token;
+            ListRemove(&observation->list);
+            HashTable_Remove(&observationTokenIndex, &observation->TokenIndex);
+            free(observation);
             break;
         }
     }
@@ -629,12 +1185,15 @@ void coap_handle_notification(NetworkAddress * sourceAddress, coap_packet_t * me
         int token;
         memcpy(&token, message->token, sizeof(int));
         Observation * observation = NULL;
-        int index;
-        for (index = 0; index < MAX_COAP_OBSERVATIONS; index++)
+        struct ListHead * i;
+        uint32_t hash = Hash_Integer(token);
+        ListForEach(i, HashTable_GetBucket(&observationTokenIndex, hash))
         {
-            if ((Observations[index].Token == token) && (NetworkAddress_Compare(Observations[index].Address, sourceAddress) == 0))
+            HashEntry * entry = ListEntry(i, HashEntry, list);
+            Observation * candidate = ListEntry(entry, Observation, TokenIndex);
+            if ((entry->Hash == hash) && (candidate->Token == token) && (NetworkAddress_Compare(candidate->Address, sourceAddress) == 0))
             {
-                observation = &Observations[index];
+                observation = candidate;
                 break;
             }
         }
@@ -301,15 +301,25 @@ static void HandleGetRequest(void * context, coap_address_t * addr, const char *
 
     if (requestHandler(&coapRequest, &coapResponse) == 0)
     {
-        unsigned char optbuf[2];
+        if (coapResponse.responseOffset != 0)
+        {
+            // Block2 is not supported with libcoap, so the content did not fit into responseContent
+            Lwm2m_Error("COAP_REQUEST_GET: content for %s exceeds %zu bytes\n", path, sizeof(responseContent));
+            coapResponse.responseContentLen = 0;
+            coapResponse.responseCode = 500;
+        }
+        else
+        {
+            unsigned char optbuf[2];
 
-        coap_add_option(response, COAP_OPTION_CONTENT_TYPE,
-                coap_encode_var_bytes(optbuf, coapResponse.responseContentType), optbuf);
+            coap_add_option(response, COAP_OPTION_CONTENT_TYPE,
+                    coap_encode_var_bytes(optbuf, coapResponse.responseContentType), optbuf);
 
-        coap_add_option(response, COAP_OPTION_MAXAGE,
-                coap_encode_var_bytes(optbuf, 86400), optbuf);
+            coap_add_option(response, COAP_OPTION_MAXAGE,
+                    coap_encode_var_bytes(optbuf, 86400), optbuf);
 
-        coap_add_data(response, coapResponse.responseContentLen, coapResponse.responseContent);
+            coap_add_data(response, coapResponse.responseContentLen, coapResponse.responseContent);
+        }
     }
 
     response->hdr->code = COAP_RESPONSE_CODE(coapResponse.responseCode);
@@ -917,6 +927,28 @@ void coap_Process(void)
     }
 }
 
+int coap_GetTimeout(int maxTimeout)
+{
+    int result = maxTimeout;
+    coap_queue_t * nextpdu = coap_peek_next(coapContext);
+
+    if (nextpdu)
+    {
+        coap_tick_t now;
+        coap_ticks(&now);
+        coap_tick_t due = nextpdu->t + coapContext->sendqueue_basetime;
+        if (due <= now)
+        {
+            result = 0;
+        }
+        else if (((due - now) * 1000 / COAP_TICKS_PER_SECOND) < (coap_tick_t)maxTimeout)
+        {
+            result = (int)((due - now) * 1000 / COAP_TICKS_PER_SECOND);
+        }
+    }
+    return result;
+}
+
 static void coap_SendRequest(int messageType, void * context, char * token, int tokenSize, const char * path, ContentType contentType,
                              const char * payload, int payloadLen, TransactionCallback transactionCallback, NotificationFreeCallback notificationFreeCallback)
 {
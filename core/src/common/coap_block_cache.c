@@ -0,0 +1,201 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE 
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "coap_block_cache.h"
+#include "lwm2m_debug.h"
+
+static void FreeTransfer(BlockCache * cache, BlockTransfer * transfer)
+{
+    ListRemove(&transfer->List);
+    cache->Count--;
+    cache->Bytes -= transfer->Capacity;
+    free(transfer->Data);
+    free(transfer->Uri);
+    free(transfer);
+}
+
+static void RemoveExpired(BlockCache * cache, uint64_t now)
+{
+    struct ListHead * current, * next;
+    ListForEachSafe(current, next, &cache->Transfers)
+    {
+        BlockTransfer * transfer = ListEntry(current, BlockTransfer, List);
+        if (transfer->Expiry <= now)
+        {
+            FreeTransfer(cache, transfer);
+        }
+    }
+}
+
+// Evict the least recently used transfer other than keep. Returns false if there is none.
+static bool EvictLeastRecentlyUsed(BlockCache * cache, const BlockTransfer * keep)
+{
+    struct ListHead * current;
+    ListForEach(current, &cache->Transfers)
+    {
+        BlockTransfer * transfer = ListEntry(current, BlockTransfer, List);
+        if (transfer != keep)
+        {
+            Lwm2m_Debug("Evicting block transfer for %s\n", transfer->Uri);
+            FreeTransfer(cache, transfer);
+            return true;
+        }
+    }
+    return false;
+}
+
+static void Touch(BlockCache * cache, BlockTransfer * transfer, uint64_t now)
+{
+    transfer->Expiry = now + cache->Lifetime;
+    ListRemove(&transfer->List);
+    ListAdd(&transfer->List, &cache->Transfers);
+}
+
+void BlockCache_Init(BlockCache * cache, size_t maxTransfers, size_t maxBytes, size_t maxTransferSize, uint32_t lifetime)
+{
+    memset(cache, 0, sizeof(*cache));
+    ListInit(&cache->Transfers);
+    cache->MaxTransfers = maxTransfers;
+    cache->MaxBytes = maxBytes;
+    cache->MaxTransferSize = maxTransferSize;
+    cache->Lifetime = lifetime;
+}
+
+void BlockCache_Destroy(BlockCache * cache)
+{
+    while (EvictLeastRecentlyUsed(cache, NULL))
+    {
+    }
+}
+
+BlockTransfer * BlockCache_Find(BlockCache * cache, NetworkAddress * peer, BlockDirection direction, const char * uri, int contentType, uint64_t now)
+{
+    RemoveExpired(cache, now);
+
+    struct ListHead * current;
+    ListForEach(current, &cache->Transfers)
+    {
+        BlockTransfer * transfer = ListEntry(current, BlockTransfer, List);
+        if ((transfer->Direction == direction) && (transfer->ContentType == contentType) &&
+            (NetworkAddress_Compare(transfer->Peer, peer) == 0) && (strcmp(transfer->Uri, uri) == 0))
+        {
+            Touch(cache, transfer, now);
+            return transfer;
+        }
+    }
+    return NULL;
+}
+
+BlockTransfer * BlockCache_Add(BlockCache * cache, NetworkAddress * peer, BlockDirection direction, const char * uri, int contentType, uint64_t now)
+{
+    BlockTransfer * transfer = BlockCache_Find(cache, peer, direction, uri, contentType, now);
+    if (transfer != NULL)
+    {
+        FreeTransfer(cache, transfer);
+    }
+
+    while (cache->Count >= cache->MaxTransfers)
+    {
+        if (!EvictLeastRecentlyUsed(cache, NULL))
+        {
+            return NULL;
+        }
+    }
+
+    transfer = (BlockTransfer *)malloc(sizeof(*transfer));
+    if (transfer == NULL)
+    {
+        return NULL;
+    }
+    memset(transfer, 0, sizeof(*transfer));
+
+    transfer->Uri = strdup(uri);
+    if (transfer->Uri == NULL)
+    {
+        free(transfer);
+        return NULL;
+    }
+
+    transfer->Peer = peer;
+    transfer->Direction = direction;
+    transfer->ContentType = contentType;
+    transfer->DataContentType = contentType;
+    transfer->Expiry = now + cache->Lifetime;
+
+    uint32_t etag = ++cache->NextETag;
+    memcpy(transfer->ETag, &etag, BLOCK_CACHE_ETAG_LEN);
+
+    ListAdd(&transfer->List, &cache->Transfers);
+    cache->Count++;
+    return transfer;
+}
+
+int BlockCache_Append(BlockCache * cache, BlockTransfer * transfer, const void * data, size_t length)
+{
+    size_t required = transfer->Length + length;
+    if (required > cache->MaxTransferSize)
+    {
+        Lwm2m_Error("Block transfer for %s exceeds %zu bytes\n", transfer->Uri, cache->MaxTransferSize);
+        return -1;
+    }
+
+    if (required > transfer->Capacity)
+    {
+        // Grow geometrically so a Block1 upload is not reallocated for every block
+        size_t capacity = (transfer->Capacity * 2 > required) ? transfer->Capacity * 2 : required;
+        capacity = (capacity > cache->MaxTransferSize) ? cache->MaxTransferSize : capacity;
+
+        while (cache->Bytes - transfer->Capacity + capacity > cache->MaxBytes)
+        {
+            if (!EvictLeastRecentlyUsed(cache, transfer))
+            {
+                Lwm2m_Error("Block cache is full\n");
+                return -1;
+            }
+        }
+
+        uint8_t * buffer = (uint8_t *)realloc(transfer->Data, capacity);
+        if (buffer == NULL)
+        {
+            return -1;
+        }
+        cache->Bytes += capacity - transfer->Capacity;
+        transfer->Data = buffer;
+        transfer->Capacity = capacity;
+    }
+
+    memcpy(&transfer->Data[transfer->Length], data, length);
+    transfer->Length = required;
+    return 0;
+}
+
+void BlockCache_Remove(BlockCache * cache, BlockTransfer * transfer)
+{
+    if (transfer != NULL)
+    {
+        FreeTransfer(cache, transfer);
+    }
+}
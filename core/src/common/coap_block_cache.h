@@ -0,0 +1,102 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE 
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+
+#ifndef COAP_BLOCK_CACHE_H
+#define COAP_BLOCK_CACHE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "lwm2m_list.h"
+#include "network_abstraction.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ *  Holds the representation of a CoAP block-wise transfer (RFC 7959) between blocks: the encoded
+ *  response of a Block2 download, so later blocks are sliced from it rather than re-encoded, or the
+ *  payload of a Block1 upload being reassembled. Transfers are keyed by peer, direction, request
+ *  URI and content format, expire after a lifetime of inactivity, and the least recently used
+ *  transfer is evicted when the count or byte limit would be exceeded.
+ */
+
+#define BLOCK_CACHE_ETAG_LEN (4)
+
+typedef enum
+{
+    BlockDirection_Download,    // Block2: response payload sent to the peer
+    BlockDirection_Upload,      // Block1: request payload received from the peer
+
+} BlockDirection;
+
+typedef struct
+{
+    struct ListHead List;       // Position in least recently used order
+    NetworkAddress * Peer;
+    BlockDirection Direction;
+    char * Uri;                 // Request path and query
+    int ContentType;            // Content-Format of an upload, or Accept of a download
+    int DataContentType;        // Content-Format of Data
+    uint8_t ETag[BLOCK_CACHE_ETAG_LEN];
+    uint8_t * Data;
+    size_t Length;
+    size_t Capacity;
+    uint64_t Expiry;            // Absolute time in ms, as returned by Lwm2mCore_GetTickCountMs()
+
+} BlockTransfer;
+
+typedef struct
+{
+    struct ListHead Transfers;  // Least recently used first
+    size_t Count;
+    size_t Bytes;
+    size_t MaxTransfers;
+    size_t MaxBytes;
+    size_t MaxTransferSize;
+    uint32_t Lifetime;          // ms
+    uint32_t NextETag;
+
+} BlockCache;
+
+void BlockCache_Init(BlockCache * cache, size_t maxTransfers, size_t maxBytes, size_t maxTransferSize, uint32_t lifetime);
+void BlockCache_Destroy(BlockCache * cache);
+
+// Return the live transfer matching the key, or NULL. A transfer that is found is marked as recently used.
+BlockTransfer * BlockCache_Find(BlockCache * cache, NetworkAddress * peer, BlockDirection direction, const char * uri, int contentType, uint64_t now);
+
+// Start a new, empty transfer with a fresh ETag, replacing any transfer with the same key. Returns NULL if no slot can be freed.
+BlockTransfer * BlockCache_Add(BlockCache * cache, NetworkAddress * peer, BlockDirection direction, const char * uri, int contentType, uint64_t now);
+
+// Append data to a transfer, evicting other transfers if the byte limit requires it. Returns -1 if the data cannot be held.
+int BlockCache_Append(BlockCache * cache, BlockTransfer * transfer, const void * data, size_t length);
+
+void BlockCache_Remove(BlockCache * cache, BlockTransfer * transfer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // COAP_BLOCK_CACHE_H
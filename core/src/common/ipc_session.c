@@ -49,6 +49,7 @@ struct _IPCSession
     IPCSessionID SessionID;
     IPCChannel RequestChannel;
     IPCChannel NotifyChannel;
+    IPCEncoding Encoding;
 };
 
 static struct ListHead sessionList;
@@ -229,6 +230,46 @@ IPCSessionID IPCSession_AssignSessionID(void)
     return sessionID;
 }
 
+int IPCSession_SetEncoding(IPCSessionID sessionID, IPCEncoding encoding)
+{
+    int result = -1;
+    IPCSession * session = NULL;
+    if ((session = FindSessionByID(sessionID)) != NULL)
+    {
+        session->Encoding = encoding;
+        result = 0;
+    }
+    else
+    {
+        Lwm2m_Error("No session with ID %d found\n", sessionID);
+        result = -1;
+    }
+    return result;
+}
+
+IPCEncoding IPCSession_GetEncoding(IPCSessionID sessionID)
+{
+    IPCSession * session = FindSessionByID(sessionID);
+    return (session != NULL) ? session->Encoding : IPCEncoding_XML;
+}
+
+void IPCSession_CloseChannels(int sockfd)
+{
+    struct ListHead * i;
+    ListForEach(i, &sessionList)
+    {
+        IPCSession * session = ListEntry(i, IPCSession, list);
+        if (session->RequestChannel.Sockfd == sockfd)
+        {
+            session->RequestChannel.Sockfd = -1;
+        }
+        if (session->NotifyChannel.Sockfd == sockfd)
+        {
+            session->NotifyChannel.Sockfd = -1;
+        }
+    }
+}
+
 bool IPCSession_IsValid(IPCSessionID sessionID)
 {
     return FindSessionByID(sessionID);
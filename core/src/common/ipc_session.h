@@ -53,6 +53,14 @@ int IPCSession_GetRequestChannel(IPCSessionID sessionID, int * sockfd, const str
 int IPCSession_AddNotifyChannel(IPCSessionID sessionID, int sockfd, const struct sockaddr * fromAddr, int addrLen);
 int IPCSession_GetNotifyChannel(IPCSessionID sessionID, int * sockfd, const struct sockaddr ** fromAddr, int * addrLen);
 
+// Return 0 on success, -1 on error
+int IPCSession_SetEncoding(IPCSessionID sessionID, IPCEncoding encoding);
+// Messages for an unknown session are always XML
+IPCEncoding IPCSession_GetEncoding(IPCSessionID sessionID);
+
+// Invalidate any channels using a socket that has been closed
+void IPCSession_CloseChannels(int sockfd);
+
 IPCSessionID IPCSession_AssignSessionID(void);
 
 bool IPCSession_IsValid(IPCSessionID sessionID);
@@ -58,56 +58,48 @@ const AttributeCharacteristics * Lwm2mAttributes_GetAttributeCharacteristics(cha
     return characteristics;
 }
 
-static NotificationAttributes * LookupNotificationAttributes(struct ListHead * attributesList, int shortServerID, ObjectIDType objectID,
+static uint32_t HashAttributesPath(int shortServerID, ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID)
+{
+    int32_t key[] = { shortServerID, objectID, objectInstanceID, resourceID };
+    return Hash_Bytes(key, sizeof(key));
+}
+
+static NotificationAttributes * LookupNotificationAttributes(const HashTable * attributesTable, int shortServerID, ObjectIDType objectID,
                                                              ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID)
 {
     NotificationAttributes * result = NULL;
-    if (attributesList != NULL)
+    uint32_t hash = HashAttributesPath(shortServerID, objectID, objectInstanceID, resourceID);
+    struct ListHead * i;
+    ListForEach(i, HashTable_GetBucket(attributesTable, hash))
     {
-        struct ListHead * i;
-        ListForEach(i, attributesList)
+        HashEntry * entry = ListEntry(i, HashEntry, list);
+        NotificationAttributes * attributes = ListEntry(entry, NotificationAttributes, PathIndex);
+        if ((entry->Hash == hash) &&
+            (attributes->ShortServerID == shortServerID) &&
+            (attributes->ObjectID == objectID) &&
+            (attributes->ObjectInstanceID == objectInstanceID) &&
+            (attributes->ResourceID == resourceID))
         {
-            NotificationAttributes * attributes = ListEntry(i, NotificationAttributes, list);
-            if ((attributes != NULL) &&
-                (attributes->ShortServerID == shortServerID) &&
-                (attributes->ObjectID == objectID) &&
-                (attributes->ObjectInstanceID == objectInstanceID) &&
-                (attributes->ResourceID == resourceID))
-            {
-                result = attributes;
-                break;
-            }
-        }
-        if (result == NULL)
-        {
-            // doesn't exist yet, so create
-            result = malloc(sizeof(NotificationAttributes));
-            memset(result, 0, sizeof(NotificationAttributes));
-            memset(result->Valid, 0, sizeof(result->Valid));
-            result->ObjectID = objectID;
-            result->ObjectInstanceID = objectInstanceID;
-            result->ResourceID = resourceID;
-            result->ShortServerID = shortServerID;
-            ListAdd(&result->list, attributesList);
+            result = attributes;
+            break;
         }
     }
     return result;
 }
 
-static void DestroyAttributesList(struct ListHead * serverNotificationAttributesList)
+static void DestroyAttributesTable(HashTable * attributesTable)
 {
-    if (serverNotificationAttributesList != NULL)
+    size_t bucket;
+    for (bucket = 0; bucket < attributesTable->NumBuckets; bucket++)
     {
         struct ListHead * i, * n;
-        ListForEachSafe(i, n, serverNotificationAttributesList)
+        ListForEachSafe(i, n, &attributesTable->Buckets[bucket])
         {
-            NotificationAttributes * attributes = ListEntry(i, NotificationAttributes, list);
-            if (attributes != NULL)
-            {
-                free(attributes);
-            }
+            HashEntry * entry = ListEntry(i, HashEntry, list);
+            free(ListEntry(entry, NotificationAttributes, PathIndex));
         }
     }
+    HashTable_Destroy(attributesTable);
 }
 
 AttributeStore * AttributeStore_Create(void)
@@ -121,7 +113,13 @@ AttributeStore * AttributeStore_Create(void)
 
     memset(store, 0, sizeof(AttributeStore));
 
-    ListInit(&store->ServerNotificationAttributes);
+    if (HashTable_Init(&store->ServerNotificationAttributes, HASH_TABLE_DEFAULT_BUCKETS) != 0)
+    {
+        free(store);
+        AwaResult_SetResult(AwaResult_OutOfMemory);
+        return NULL;
+    }
+    store->Generation = 1;
 
     AwaResult_SetResult(AwaResult_Success);
     return store;
@@ -132,18 +130,142 @@ void AttributeStore_Destroy(AttributeStore * store)
     if (store != NULL)
     {
         // loop through all objects and free them
-        DestroyAttributesList(&store->ServerNotificationAttributes);
+        DestroyAttributesTable(&store->ServerNotificationAttributes);
         free(store);
     }
 }
 
-NotificationAttributes * AttributeStore_LookupNotificationAttributes(AttributeStore * store, int shortServerID, ObjectIDType objectID,
-                                                                     ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID)
+const NotificationAttributes * AttributeStore_LookupNotificationAttributes(const AttributeStore * store, int shortServerID, ObjectIDType objectID,
+                                                                           ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID)
 {
-    NotificationAttributes * attributes = NULL;
+    const NotificationAttributes * attributes = NULL;
     if (store != NULL)
     {
         attributes = LookupNotificationAttributes(&store->ServerNotificationAttributes, shortServerID, objectID, objectInstanceID, resourceID);
     }
     return attributes;
 }
+
+int AttributeStore_SetNotificationAttributes(AttributeStore * store, int shortServerID, ObjectIDType objectID,
+                                             ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID, const NotificationAttributes * attributes)
+{
+    if (store == NULL)
+    {
+        return -1;
+    }
+
+    bool anyValid = false;
+    int type;
+    for (type = 0; type < AttributeTypeEnum_LAST; type++)
+    {
+        anyValid |= attributes->Valid[type];
+    }
+
+    NotificationAttributes * existing = LookupNotificationAttributes(&store->ServerNotificationAttributes, shortServerID, objectID, objectInstanceID, resourceID);
+    if (!anyValid)
+    {
+        if (existing != NULL)
+        {
+            HashTable_Remove(&store->ServerNotificationAttributes, &existing->PathIndex);
+            free(existing);
+        }
+    }
+    else
+    {
+        if (existing == NULL)
+        {
+            existing = malloc(sizeof(NotificationAttributes));
+            if (existing == NULL)
+            {
+                return -1;
+            }
+            memset(existing, 0, sizeof(NotificationAttributes));
+            existing->ObjectID = objectID;
+            existing->ObjectInstanceID = objectInstanceID;
+            existing->ResourceID = resourceID;
+            existing->ShortServerID = shortServerID;
+            HashTable_Add(&store->ServerNotificationAttributes, &existing->PathIndex, HashAttributesPath(shortServerID, objectID, objectInstanceID, resourceID));
+        }
+
+        existing->MinimumPeriod = attributes->MinimumPeriod;
+        existing->MaximumPeriod = attributes->MaximumPeriod;
+        existing->GreaterThan = attributes->GreaterThan;
+        existing->LessThan = attributes->LessThan;
+        existing->Step = attributes->Step;
+        memcpy(existing->Valid, attributes->Valid, sizeof(existing->Valid));
+    }
+
+    store->Generation++;
+    if (store->Generation == 0)
+    {
+        // 0 marks resolved attributes that have never been resolved
+        store->Generation = 1;
+    }
+    return 0;
+}
+
+static void InheritAttribute(NotificationAttributes * resolved, const NotificationAttributes * attributes, AttributeTypeEnum type)
+{
+    if ((attributes == NULL) || resolved->Valid[type] || !attributes->Valid[type])
+    {
+        return;
+    }
+
+    switch (type)
+    {
+        case AttributeTypeEnum_MinimumPeriod:
+            resolved->MinimumPeriod = attributes->MinimumPeriod;
+            break;
+        case AttributeTypeEnum_MaximumPeriod:
+            resolved->MaximumPeriod = attributes->MaximumPeriod;
+            break;
+        case AttributeTypeEnum_GreaterThan:
+            resolved->GreaterThan = attributes->GreaterThan;
+            break;
+        case AttributeTypeEnum_LessThan:
+            resolved->LessThan = attributes->LessThan;
+            break;
+        case AttributeTypeEnum_Step:
+            resolved->Step = attributes->Step;
+            break;
+        default:
+            break;
+    }
+    resolved->Valid[type] = true;
+}
+
+const NotificationAttributes * AttributeStore_ResolveNotificationAttributes(const AttributeStore * store, ResolvedNotificationAttributes * resolved, int shortServerID,
+                                                                            ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID)
+{
+    NotificationAttributes * result = &resolved->Attributes;
+    if ((store == NULL) ||
+        (resolved->Generation != store->Generation) ||
+        (result->ShortServerID != shortServerID) ||
+        (result->ObjectID != objectID) ||
+        (result->ObjectInstanceID != objectInstanceID) ||
+        (result->ResourceID != resourceID))
+    {
+        const NotificationAttributes * inherited[] = {
+            (resourceID == -1) ? NULL : AttributeStore_LookupNotificationAttributes(store, shortServerID, objectID, objectInstanceID, resourceID),
+            (objectInstanceID == -1) ? NULL : AttributeStore_LookupNotificationAttributes(store, shortServerID, objectID, objectInstanceID, -1),
+            AttributeStore_LookupNotificationAttributes(store, shortServerID, objectID, -1, -1),
+        };
+
+        memset(result, 0, sizeof(*result));
+        result->ShortServerID = shortServerID;
+        result->ObjectID = objectID;
+        result->ObjectInstanceID = objectInstanceID;
+        result->ResourceID = resourceID;
+
+        int level, type;
+        for (level = 0; level < sizeof(inherited) / sizeof(inherited[0]); level++)
+        {
+            for (type = 0; type < AttributeTypeEnum_LAST; type++)
+            {
+                InheritAttribute(result, inherited[level], type);
+            }
+        }
+        resolved->Generation = (store != NULL) ? store->Generation : 0;
+    }
+    return result;
+}
@@ -27,6 +27,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "lwm2m_list.h"
+#include "lwm2m_hash.h"
 #include "lwm2m_types.h"
 
 #ifdef __cplusplus
@@ -47,7 +48,7 @@ typedef enum
 
 typedef struct
 {
-    struct ListHead list; // prev/next pointers
+    HashEntry PathIndex;  // Entry in the store, keyed on server and path
 
     int MinimumPeriod;  // CoRE param "pmin", default: 1 second, restarted for each notification
     int MaximumPeriod;  // CoRE param "pmax"
@@ -80,15 +81,35 @@ typedef struct
 
 typedef struct
 {
-    struct ListHead ServerNotificationAttributes;
+    HashTable ServerNotificationAttributes;
+    uint32_t Generation;  // Incremented on every change, to invalidate resolved attributes
 } AttributeStore;
 
+// The attributes in effect for a path, each taken from the most specific of the resource, object instance and object on which it is set.
+typedef struct
+{
+    NotificationAttributes Attributes;
+    uint32_t Generation;  // Store generation the attributes were resolved at, or 0 if never resolved
+} ResolvedNotificationAttributes;
+
 const AttributeCharacteristics * Lwm2mAttributes_GetAttributeCharacteristics(char * coreLinkParam);
 
 AttributeStore * AttributeStore_Create(void);
 void AttributeStore_Destroy(AttributeStore * store);
-NotificationAttributes * AttributeStore_LookupNotificationAttributes(AttributeStore * store, int shortServerID, ObjectIDType objectID,
-                                                                     ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID);
+
+// Return the attributes set on exactly this path, or NULL if none are set. Never allocates.
+const NotificationAttributes * AttributeStore_LookupNotificationAttributes(const AttributeStore * store, int shortServerID, ObjectIDType objectID,
+                                                                           ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID);
+
+// Replace the attributes set on a path with the valid values in attributes. The entry is created on first write,
+// and removed once no attributes are valid. Returns 0 on success, or -1 if memory could not be allocated.
+int AttributeStore_SetNotificationAttributes(AttributeStore * store, int shortServerID, ObjectIDType objectID,
+                                             ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID, const NotificationAttributes * attributes);
+
+// Return the attributes in effect for a path, resolving them into resolved only if the store has changed since it was last used
+// for this path. resolved must be zeroed before first use.
+const NotificationAttributes * AttributeStore_ResolveNotificationAttributes(const AttributeStore * store, ResolvedNotificationAttributes * resolved, int shortServerID,
+                                                                            ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,214 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE 
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "lwm2m_deadline_queue.h"
+
+#define DEADLINE_QUEUE_INITIAL_CAPACITY (16)
+
+static void Place(DeadlineQueue * queue, DeadlineEntry * entry, size_t index)
+{
+    queue->Entries[index] = entry;
+    entry->Index = index;
+}
+
+static void SiftUp(DeadlineQueue * queue, size_t index)
+{
+    DeadlineEntry * entry = queue->Entries[index];
+    while (index > 0)
+    {
+        size_t parent = (index - 1) / 2;
+        if (queue->Entries[parent]->Deadline <= entry->Deadline)
+        {
+            break;
+        }
+        Place(queue, queue->Entries[parent], index);
+        index = parent;
+    }
+    Place(queue, entry, index);
+}
+
+static void SiftDown(DeadlineQueue * queue, size_t index)
+{
+    DeadlineEntry * entry = queue->Entries[index];
+    while (true)
+    {
+        size_t child = (index * 2) + 1;
+        if (child >= queue->Count)
+        {
+            break;
+        }
+        if ((child + 1 < queue->Count) && (queue->Entries[child + 1]->Deadline < queue->Entries[child]->Deadline))
+        {
+            child++;
+        }
+        if (entry->Deadline <= queue->Entries[child]->Deadline)
+        {
+            break;
+        }
+        Place(queue, queue->Entries[child], index);
+        index = child;
+    }
+    Place(queue, entry, index);
+}
+
+int DeadlineQueue_Init(DeadlineQueue * queue)
+{
+    int result = -1;
+    if (queue != NULL)
+    {
+        memset(queue, 0, sizeof(*queue));
+        result = 0;
+    }
+    return result;
+}
+
+void DeadlineQueue_Destroy(DeadlineQueue * queue)
+{
+    if (queue != NULL)
+    {
+        size_t i;
+        for (i = 0; i < queue->Count; i++)
+        {
+            queue->Entries[i]->Index = DEADLINE_NOT_QUEUED;
+        }
+        free(queue->Entries);
+        memset(queue, 0, sizeof(*queue));
+    }
+}
+
+void DeadlineQueue_InitEntry(DeadlineEntry * entry)
+{
+    entry->Deadline = 0;
+    entry->Index = DEADLINE_NOT_QUEUED;
+}
+
+bool DeadlineQueue_IsScheduled(const DeadlineEntry * entry)
+{
+    return entry->Index != DEADLINE_NOT_QUEUED;
+}
+
+int DeadlineQueue_Schedule(DeadlineQueue * queue, DeadlineEntry * entry, uint64_t deadline)
+{
+    int result = 0;
+    if (DeadlineQueue_IsScheduled(entry))
+    {
+        uint64_t previous = entry->Deadline;
+        entry->Deadline = deadline;
+        if (deadline < previous)
+        {
+            SiftUp(queue, entry->Index);
+        }
+        else
+        {
+            SiftDown(queue, entry->Index);
+        }
+    }
+    else
+    {
+        if (queue->Count == queue->Capacity)
+        {
+            size_t capacity = (queue->Capacity > 0) ? queue->Capacity * 2 : DEADLINE_QUEUE_INITIAL_CAPACITY;
+            DeadlineEntry ** entries = realloc(queue->Entries, capacity * sizeof(*entries));
+            if (entries == NULL)
+            {
+                result = -1;
+                goto error;
+            }
+            queue->Entries = entries;
+            queue->Capacity = capacity;
+        }
+        entry->Deadline = deadline;
+        Place(queue, entry, queue->Count++);
+        SiftUp(queue, entry->Index);
+    }
+error:
+    return result;
+}
+
+void DeadlineQueue_Cancel(DeadlineQueue * queue, DeadlineEntry * entry)
+{
+    if (DeadlineQueue_IsScheduled(entry))
+    {
+        size_t index = entry->Index;
+        DeadlineEntry * last = queue->Entries[--queue->Count];
+        entry->Index = DEADLINE_NOT_QUEUED;
+
+        if (last != entry)
+        {
+            Place(queue, last, index);
+            if ((index > 0) && (last->Deadline < queue->Entries[(index - 1) / 2]->Deadline))
+            {
+                SiftUp(queue, index);
+            }
+            else
+            {
+                SiftDown(queue, index);
+            }
+        }
+    }
+}
+
+DeadlineEntry * DeadlineQueue_Peek(const DeadlineQueue * queue)
+{
+    return (queue->Count > 0) ? queue->Entries[0] : NULL;
+}
+
+DeadlineEntry * DeadlineQueue_PopExpired(DeadlineQueue * queue, uint64_t now)
+{
+    DeadlineEntry * entry = DeadlineQueue_Peek(queue);
+    if ((entry != NULL) && (entry->Deadline <= now))
+    {
+        DeadlineQueue_Cancel(queue, entry);
+    }
+    else
+    {
+        entry = NULL;
+    }
+    return entry;
+}
+
+int DeadlineQueue_GetTimeout(const DeadlineQueue * queue, uint64_t now, int maxTimeout)
+{
+    int timeout = maxTimeout;
+    DeadlineEntry * entry = DeadlineQueue_Peek(queue);
+    if (entry != NULL)
+    {
+        if (entry->Deadline <= now)
+        {
+            timeout = 0;
+        }
+        else if (entry->Deadline - now < (uint64_t)maxTimeout)
+        {
+            timeout = (int)(entry->Deadline - now);
+        }
+    }
+    return timeout;
+}
+
+size_t DeadlineQueue_Count(const DeadlineQueue * queue)
+{
+    return queue->Count;
+}
@@ -0,0 +1,85 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE 
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+
+#ifndef LWM2M_DEADLINE_QUEUE_H
+#define LWM2M_DEADLINE_QUEUE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ *  Intrusive min-heap of deadlines. Embed a DeadlineEntry in the scheduled structure and
+ *  use ListEntry() to get back to it from an entry returned by DeadlineQueue_PopExpired.
+ *  Scheduling, rescheduling and cancelling are O(log n); finding the next deadline is O(1).
+ */
+
+#define DEADLINE_NOT_QUEUED ((size_t)-1)
+
+typedef struct
+{
+    uint64_t Deadline;          // Absolute time in ms, as returned by Lwm2mCore_GetTickCountMs()
+    size_t Index;               // Position in the heap, or DEADLINE_NOT_QUEUED
+
+} DeadlineEntry;
+
+typedef struct
+{
+    DeadlineEntry ** Entries;
+    size_t Count;
+    size_t Capacity;
+
+} DeadlineQueue;
+
+int DeadlineQueue_Init(DeadlineQueue * queue);
+
+// Release the heap storage. Entries are owned by the caller and are not freed.
+void DeadlineQueue_Destroy(DeadlineQueue * queue);
+
+void DeadlineQueue_InitEntry(DeadlineEntry * entry);
+bool DeadlineQueue_IsScheduled(const DeadlineEntry * entry);
+
+// Schedule an entry, or move it if it is already scheduled.
+int DeadlineQueue_Schedule(DeadlineQueue * queue, DeadlineEntry * entry, uint64_t deadline);
+void DeadlineQueue_Cancel(DeadlineQueue * queue, DeadlineEntry * entry);
+
+// Return the entry with the earliest deadline without removing it, or NULL if the queue is empty.
+DeadlineEntry * DeadlineQueue_Peek(const DeadlineQueue * queue);
+
+// Remove and return an entry whose deadline is at or before now, or NULL if none have expired.
+DeadlineEntry * DeadlineQueue_PopExpired(DeadlineQueue * queue, uint64_t now);
+
+// Milliseconds until the earliest deadline, clamped to maxTimeout. Returns maxTimeout if the queue is empty.
+int DeadlineQueue_GetTimeout(const DeadlineQueue * queue, uint64_t now, int maxTimeout);
+
+size_t DeadlineQueue_Count(const DeadlineQueue * queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LWM2M_DEADLINE_QUEUE_H
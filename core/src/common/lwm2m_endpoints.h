@@ -39,7 +39,8 @@ extern "C" {
 
 typedef int (*EndpointHandlerFunction)(int type, void * ctxt, AddressType * addr, const char * path, const char * query, const char * token,
                                        int tokenLength, ContentType contentType, const char * requestContent, size_t requestContentLen,
-                                       ContentType * responseContentType, char * responseContent, size_t * responseContentLen, int * responseCode);
+                                       ContentType * responseContentType, char * responseContent, size_t * responseContentLen, int * responseCode,
+                                       int32_t * responseOffset);
 typedef struct
 {
     struct ListHead     list;  // Next/Prev pointers
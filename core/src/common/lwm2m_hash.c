@@ -0,0 +1,161 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE 
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "lwm2m_hash.h"
+
+#define FNV_OFFSET_BASIS (2166136261u)
+#define FNV_PRIME        (16777619u)
+
+static size_t RoundUpToPowerOfTwo(size_t value)
+{
+    size_t result = 1;
+    while (result < value)
+    {
+        result <<= 1;
+    }
+    return result;
+}
+
+static struct ListHead * AllocateBuckets(size_t numBuckets)
+{
+    struct ListHead * buckets = malloc(numBuckets * sizeof(struct ListHead));
+    if (buckets != NULL)
+    {
+        size_t i;
+        for (i = 0; i < numBuckets; i++)
+        {
+            ListInit(&buckets[i]);
+        }
+    }
+    return buckets;
+}
+
+int HashTable_Init(HashTable * table, size_t numBuckets)
+{
+    int result = -1;
+    if (table != NULL)
+    {
+        table->NumBuckets = RoundUpToPowerOfTwo(numBuckets > 0 ? numBuckets : HASH_TABLE_DEFAULT_BUCKETS);
+        table->Count = 0;
+        table->Buckets = AllocateBuckets(table->NumBuckets);
+        result = (table->Buckets != NULL) ? 0 : -1;
+    }
+    return result;
+}
+
+void HashTable_Destroy(HashTable * table)
+{
+    if (table != NULL)
+    {
+        free(table->Buckets);
+        table->Buckets = NULL;
+        table->NumBuckets = 0;
+        table->Count = 0;
+    }
+}
+
+struct ListHead * HashTable_GetBucket(const HashTable * table, uint32_t hash)
+{
+    return &table->Buckets[hash & (table->NumBuckets - 1)];
+}
+
+// If the larger bucket array can't be allocated the table keeps working with longer chains.
+static void Grow(HashTable * table)
+{
+    size_t numBuckets = table->NumBuckets * 2;
+    struct ListHead * buckets = AllocateBuckets(numBuckets);
+    if (buckets != NULL)
+    {
+        size_t i;
+        for (i = 0; i < table->NumBuckets; i++)
+        {
+            struct ListHead * entry, * next;
+            ListForEachSafe(entry, next, &table->Buckets[i])
+            {
+                HashEntry * hashEntry = ListEntry(entry, HashEntry, list);
+                ListAdd(&hashEntry->list, &buckets[hashEntry->Hash & (numBuckets - 1)]);
+            }
+        }
+        free(table->Buckets);
+        table->Buckets = buckets;
+        table->NumBuckets = numBuckets;
+    }
+}
+
+void HashTable_Add(HashTable * table, HashEntry * entry, uint32_t hash)
+{
+    if (table->Count >= table->NumBuckets)
+    {
+        Grow(table);
+    }
+    entry->Hash = hash;
+    ListAdd(&entry->list, HashTable_GetBucket(table, hash));
+    table->Count++;
+}
+
+void HashTable_Remove(HashTable * table, HashEntry * entry)
+{
+    // ListRemove leaves a removed entry pointing at itself, so removing twice is harmless
+    if (entry->list.Next != &entry->list)
+    {
+        ListRemove(&entry->list);
+        table->Count--;
+    }
+}
+
+size_t HashTable_Count(const HashTable * table)
+{
+    return table->Count;
+}
+
+uint32_t Hash_Bytes(const void * data, size_t length)
+{
+    const uint8_t * bytes = data;
+    uint32_t hash = FNV_OFFSET_BASIS;
+    size_t i;
+    for (i = 0; i < length; i++)
+    {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+uint32_t Hash_String(const char * string)
+{
+    uint32_t hash = FNV_OFFSET_BASIS;
+    while (*string != '\0')
+    {
+        hash ^= (uint8_t)*string++;
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+uint32_t Hash_Integer(uint32_t value)
+{
+    return Hash_Bytes(&value, sizeof(value));
+}
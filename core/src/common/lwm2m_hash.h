@@ -0,0 +1,99 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE 
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+
+#ifndef LWM2M_HASH_H
+#define LWM2M_HASH_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "lwm2m_list.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ *  Intrusive chained hash table. Like ListHead, the HashEntry is embedded in the
+ *  indexed structure, so an item can be indexed by several tables at once without
+ *  extra allocations. The caller computes the hash and compares keys:
+ *
+ *     struct {
+ *         HashEntry NameIndex;
+ *         char * Name;
+ *     } Entry;
+ *
+ *     HashTable_Add(&table, &entry->NameIndex, Hash_String(entry->Name));
+ *
+ *     struct ListHead * i;
+ *     uint32_t hash = Hash_String(name);
+ *     ListForEach(i, HashTable_GetBucket(&table, hash))
+ *     {
+ *         HashEntry * hashEntry = ListEntry(i, HashEntry, list);
+ *         Entry * entry = ListEntry(hashEntry, Entry, NameIndex);
+ *         if ((hashEntry->Hash == hash) && (strcmp(entry->Name, name) == 0))
+ *             ... found ...
+ */
+
+typedef struct
+{
+    struct ListHead list;       // Bucket chain
+    uint32_t Hash;              // Cached hash, used when the table grows
+
+} HashEntry;
+
+typedef struct
+{
+    struct ListHead * Buckets;
+    size_t NumBuckets;          // Always a power of two
+    size_t Count;
+
+} HashTable;
+
+#define HASH_TABLE_DEFAULT_BUCKETS (64)
+
+int HashTable_Init(HashTable * table, size_t numBuckets);
+
+// Release the bucket array. Entries are owned by the caller and are not freed.
+void HashTable_Destroy(HashTable * table);
+
+// Add an entry, doubling the number of buckets if the load factor exceeds 1.
+void HashTable_Add(HashTable * table, HashEntry * entry, uint32_t hash);
+void HashTable_Remove(HashTable * table, HashEntry * entry);
+
+// Return the chain that may contain entries with the specified hash.
+struct ListHead * HashTable_GetBucket(const HashTable * table, uint32_t hash);
+
+size_t HashTable_Count(const HashTable * table);
+
+// FNV-1a hash functions
+uint32_t Hash_Bytes(const void * data, size_t length);
+uint32_t Hash_String(const char * string);
+uint32_t Hash_Integer(uint32_t value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LWM2M_HASH_H
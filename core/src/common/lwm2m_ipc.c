@@ -21,6 +21,7 @@
 ************************************************************************************************************************/
 
 
+#include <stdlib.h>
 #include <string.h>
 
 #include "lwm2m_ipc.h"
@@ -30,9 +31,12 @@
 #include "xml.h"
 #include "lwm2m_xml_interface.h"
 #include "lwm2m_debug.h"
+#include "ipc_session.h"
 
 #include <awa/static.h>
 
+static IPCResponseFilter responseFilter = NULL;
+
 static TreeNode IPC_NewNode(const char * type, const char * subType, IPCSessionID sessionID)
 {
     TreeNode responseNode = Xml_CreateNode(type);
@@ -66,9 +70,9 @@ void IPC_SetSessionID(TreeNode message, IPCSessionID sessionID)
     TreeNode_AddChild(message, sessionIDNode);
 }
 
-IPCSessionID IPC_GetSessionID(const TreeNode content)
+static const char * IPC_GetHeaderValue(const TreeNode content, const char * tag)
 {
-    IPCSessionID sessionID = -1;
+    const char * value = NULL;
     if (content != NULL)
     {
         const char * type = NULL;
@@ -76,15 +80,9 @@ IPCSessionID IPC_GetSessionID(const TreeNode content)
         {
             enum { PATH_LEN = 128 };
             char path[PATH_LEN] = { 0 };
-            if (snprintf(path, PATH_LEN, "%s/SessionID", type) > 0)
+            if (snprintf(path, PATH_LEN, "%s/%s", type, tag) > 0)
             {
-                TreeNode sessionIDNode = TreeNode_Navigate(content, path);
-                const char * sessionIDStr = NULL;
-
-                if ((sessionIDStr = (const char *)TreeNode_GetValue(sessionIDNode)) != NULL)
-                {
-                    sessionID = atoi(sessionIDStr);
-                }
+                value = (const char *)TreeNode_GetValue(TreeNode_Navigate(content, path));
             }
         }
     }
@@ -92,7 +90,37 @@ IPCSessionID IPC_GetSessionID(const TreeNode content)
     {
         Lwm2m_Error("content is NULL");
     }
-    return sessionID;
+    return value;
+}
+
+IPCSessionID IPC_GetSessionID(const TreeNode content)
+{
+    const char * sessionIDStr = IPC_GetHeaderValue(content, "SessionID");
+    return sessionIDStr != NULL ? atoi(sessionIDStr) : -1;
+}
+
+void IPC_SetRequestID(TreeNode message, IPCRequestID requestID)
+{
+    TreeNode requestIDNode = Xml_CreateNodeWithValue(IPC_MESSAGE_TAG_REQUEST_ID, "%d", requestID);
+    TreeNode_AddChild(message, requestIDNode);
+}
+
+IPCRequestID IPC_GetRequestID(const TreeNode content)
+{
+    const char * requestIDStr = IPC_GetHeaderValue(content, IPC_MESSAGE_TAG_REQUEST_ID);
+    return requestIDStr != NULL ? atoi(requestIDStr) : 0;
+}
+
+void IPC_SetEncoding(TreeNode message, IPCEncoding encoding)
+{
+    TreeNode encodingNode = Xml_CreateNodeWithValue(IPC_MESSAGE_TAG_ENCODING, "%s", encoding == IPCEncoding_Binary ? IPC_ENCODING_BINARY : IPC_ENCODING_XML);
+    TreeNode_AddChild(message, encodingNode);
+}
+
+IPCEncoding IPC_GetEncoding(const TreeNode content)
+{
+    const char * encoding = IPC_GetHeaderValue(content, IPC_MESSAGE_TAG_ENCODING);
+    return (encoding != NULL) && (strcmp(encoding, IPC_ENCODING_BINARY) == 0) ? IPCEncoding_Binary : IPCEncoding_XML;
 }
 
 TreeNode IPC_NewClientsNode()
@@ -114,19 +142,67 @@ TreeNode IPC_AddClientNode(TreeNode clientsNode, const char * clientID)
     return clientNode;
 }
 
+void IPC_SetResponseFilter(IPCResponseFilter filter)
+{
+    responseFilter = filter;
+}
+
+static int SerialiseResponse(TreeNode responseNode, IPCEncoding encoding, char * buffer, size_t bufferSize)
+{
+    if (encoding == IPCEncoding_Binary)
+    {
+        return Xml_TreeToBinary(responseNode, (uint8_t *)buffer, bufferSize);
+    }
+    return Xml_TreeToCompactString(responseNode, buffer, bufferSize);
+}
+
 int IPC_SendResponse(TreeNode responseNode, int sockfd, const struct sockaddr * fromAddr, int addrLen)
 {
     int rc = 0;
-    // Serialise response
-    char buffer[IPC_MAX_BUFFER_LEN] = { 0 };
-    if (Xml_TreeToString(responseNode, buffer, sizeof(buffer)) > 0)
+
+    if ((responseFilter != NULL) && responseFilter(responseNode))
+    {
+        return rc;
+    }
+
+    // Serialise response in the encoding negotiated by the session
+    IPCEncoding encoding = IPCSession_GetEncoding(IPC_GetSessionID(responseNode));
+    char buffer[IPC_MAX_BUFFER_LEN];
+    int length = SerialiseResponse(responseNode, encoding, buffer, sizeof(buffer));
+
+    if ((length > 0) && ((size_t)length < sizeof(buffer)))
     {
-        xmlif_SendTo(sockfd, buffer, strlen(buffer), 0, fromAddr, addrLen);
+        xmlif_SendTo(sockfd, buffer, length, 0, fromAddr, addrLen);
     }
     else
     {
-        Lwm2m_Error("Xml_TreeToString failed\n");
-        rc = -1;
+        // Responses too large for a datagram can still be sent on a stream connection.
+        // XML reports the exact size it needs, whereas binary only reports that it did not fit.
+        size_t bufferSize = sizeof(buffer);
+        char * largeBuffer = NULL;
+        while ((length < 0) || ((size_t)length >= bufferSize))
+        {
+            size_t newSize = (length < 0) ? bufferSize * 2 : (size_t)length + 1;
+            char * newBuffer = (newSize <= IPC_MAX_STREAM_MESSAGE_LEN) ? realloc(largeBuffer, newSize) : NULL;
+            if (newBuffer == NULL)
+            {
+                break;
+            }
+            largeBuffer = newBuffer;
+            bufferSize = newSize;
+            length = SerialiseResponse(responseNode, encoding, largeBuffer, bufferSize);
+        }
+
+        if ((largeBuffer != NULL) && (length > 0) && ((size_t)length < bufferSize))
+        {
+            xmlif_SendTo(sockfd, largeBuffer, length, 0, fromAddr, addrLen);
+        }
+        else
+        {
+            Lwm2m_Error("Failed to serialise response\n");
+            rc = -1;
+        }
+        free(largeBuffer);
     }
     return rc;
 }
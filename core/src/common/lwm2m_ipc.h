@@ -24,6 +24,8 @@
 #ifndef LWM2M_IPC_H
 #define LWM2M_IPC_H
 
+#include <stdbool.h>
+
 #include "lwm2m_result.h"
 #include "xmltree.h"
 #include "../../api/src/ipc_defs.h"
@@ -42,6 +44,12 @@ TreeNode IPC_NewNotificationNode(const char * subType, IPCSessionID sessionID);
 void IPC_SetSessionID(TreeNode message, IPCSessionID sessionID);
 IPCSessionID IPC_GetSessionID(const TreeNode content);
 
+void IPC_SetRequestID(TreeNode message, IPCRequestID requestID);
+IPCRequestID IPC_GetRequestID(const TreeNode content);
+
+void IPC_SetEncoding(TreeNode message, IPCEncoding encoding);
+IPCEncoding IPC_GetEncoding(const TreeNode content);
+
 TreeNode IPC_NewClientsNode();
 TreeNode IPC_NewContentNode();
 TreeNode IPC_AddClientNode(TreeNode clientsNode, const char * clientID);
@@ -49,6 +57,10 @@ TreeNode IPC_AddClientNode(TreeNode clientsNode, const char * clientID);
 // Serialise and send the IPC response back to the originator
 int IPC_SendResponse(TreeNode responseNode, int sockfd, const struct sockaddr * fromAddr, int addrLen);
 
+// A response filter may claim a response instead of it being sent, by returning true
+typedef bool (*IPCResponseFilter)(TreeNode responseNode);
+void IPC_SetResponseFilter(IPCResponseFilter filter);
+
 TreeNode IPC_AddResultTag(TreeNode leafNode, int error);
 TreeNode IPC_AddServerResultTag(TreeNode leafNode, int error, int serverError);
 void IPC_AddResultTagToAllLeafNodes(TreeNode objectInstanceNode, int error);
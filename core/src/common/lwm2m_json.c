@@ -21,10 +21,6 @@
 ************************************************************************************************************************/
 
 
-#ifndef JSMN_FIRST_CHILD_NEXT_SIBLING
-    #define JSMN_FIRST_CHILD_NEXT_SIBLING
-#endif
-
 #include <stdio.h>
 #include <string.h>
 #include <stdbool.h>
@@ -32,7 +28,7 @@
 #include <inttypes.h>
 #include <stdlib.h>
 #include <float.h>
-#include <jsmn.h>
+#include <math.h>
 
 #include "lwm2m_json.h"
 #include "lwm2m_serdes.h"
@@ -40,7 +36,15 @@
 #include "b64.h"
 #include "lwm2m_debug.h"
 
-#define MAX_JSON_TOKENS 128
+// Framing of an encoding: elements are separated by ",\n" and enclosed by these
+#define JSON_STREAM_START "{\"e\":[\n"
+#define JSON_STREAM_END   "]\n}\n"
+
+#define JSON_MAX_DEPTH      (16)            // Nesting allowed in members that are skipped
+#define JSON_MAX_PATH_IDS   (4)             // Object, Object Instance, Resource and Resource Instance IDs
+#define JSON_OPAQUE_CHUNK   (48)            // Opaque bytes base64 encoded at a time, a multiple of 3
+#define JSON_SCRATCH_SIZE   (256)           // Decoded values up to this size don't need an allocation
+#define JSON_FLOAT_LENGTH   (DBL_MAX_10_EXP + 32)   // Large enough for any %f formatted double
 
 typedef enum
 {
@@ -60,357 +64,381 @@ typedef enum
 
 } UriLevelType;
 
+// A string or primitive value, left in the buffer being deserialised
 typedef struct
 {
-    UriLevelType uriLevel;
-    bool lastInstance;
-    bool lastResource;
-} JsonSerdesContext;
+    const char * Start;                 // First character, after the opening quote of a string
+    int Length;
+    bool Quoted;
+    bool Escaped;                       // The string contains escape sequences
 
-static void JsonInitSerdesContext(SerdesContext * serdesContext, UriLevelType level)
-{
-    JsonSerdesContext * context = (JsonSerdesContext *)malloc(sizeof(JsonSerdesContext));
+} JsonValue;
 
-    context->uriLevel = level;
-    context->lastInstance = true;
-    context->lastResource = true;
+typedef struct
+{
+    const char * Buffer;
+    int Length;
+    int Position;
 
-    *serdesContext = context;
-}
+} JsonReader;
 
-static void JsonDestroySerdesContext(SerdesContext * serdesContext)
+typedef struct
 {
-    free(*serdesContext);
-    *serdesContext = NULL;
-}
-
-static int JsonTokenStrcmp(const char * buffer, jsmntok_t * t, const char * string)
+    Lwm2mTreeNode ** Dest;
+    Lwm2mTreeArena * Arena;
+    const DefinitionRegistry * Registry;
+    int RequestIDs[JSON_MAX_PATH_IDS];  // IDs in the request path, -1 where absent
+    JsonValue Basename;                 // Start is NULL if the payload has no base name
+    int64_t Basetime;
+    Lwm2mTreeNode * Resource;           // Resource of the previous element, reused by the elements that follow it
+    int ResourceIDs[3];
+    Lwm2mTreeNode * Instance;           // Object instance resources were last added to
+    int MaxResourceID;                  // Highest resource ID in Instance, or LWM2M_MAX_ID if unknown
+
+} JsonDeserialiseState;
+
+// Write value in decimal to text, which must hold at least 20 characters. Return the number of characters written
+static int JsonFormatInteger(char * text, int64_t value)
 {
-    return (strlen(string) == (size_t)(t->end - t->start)) && (strncmp(&(buffer[t->start]), string, strlen(string)) == 0);
-}
+    char digits[20];
+    int count = 0;
+    int length = 0;
+    uint64_t magnitude = (value < 0) ? -(uint64_t)value : (uint64_t)value;
 
-static int JsonTokenFind(jsmntok_t tokens[], const char * buffer, jsmntok_t * t, const char * string)
-{
-    if (t->size <= 0)
+    if (value < 0)
     {
-        return -1;
+        text[length++] = '-';
     }
 
-    int child = t->first_child;
     do
     {
-        if (JsonTokenStrcmp(buffer, &tokens[child], string))
-        {
-            return child;
-        }
+        digits[count++] = '0' + (magnitude % 10);
+        magnitude /= 10;
     }
-    while ((child = tokens[child].next_sibling) != -1);
-
-    return -1;
-}
+    while (magnitude != 0);
 
-static char * JsonTokenToString(const char *buffer, jsmntok_t *t)
-{
-    static char buf[256];
-    memset(buf, 0, 256);
-    memcpy(buf, buffer + t->start, t->end - t->start);
-    return buf;
+    while (count > 0)
+    {
+        text[length++] = digits[--count];
+    }
+    return length;
 }
 
-static int JsonStartElement(char * buffer, int bufferLen)
+// Write value to text as %f would, without the cost of printf for most values. Return the number of characters written
+static int JsonFormatFloat(char * text, double value)
 {
-    strcpy(buffer, "{\"e\":[\n");
+    double magnitude = signbit(value) ? -value : value;
 
-    return strlen(buffer);
-}
+    // Below 1e9 a double scaled to millionths is held to within 0.0625, so unless it lies close to
+    // halfway between two integers the nearest integer is the one %f rounds to.
+    if (magnitude < 1e9)
+    {
+        double scaled = magnitude * 1000000.0;
+        int64_t millionths = (int64_t)(scaled + 0.5);
+        double error = scaled - (double)millionths;
 
-static int JsonEndElement(char * buffer, int bufferLen)
-{
-    strcat(buffer, "}\n");
+        if ((error > -0.4) && (error < 0.4))
+        {
+            int length = 0;
+            int64_t fraction = millionths % 1000000;
+            int i;
 
-    return strlen(buffer);
+            if (signbit(value))
+            {
+                text[length++] = '-';
+            }
+            length += JsonFormatInteger(&text[length], millionths / 1000000);
+            text[length++] = '.';
+            for (i = 5; i >= 0; i--)
+            {
+                text[length + i] = '0' + (fraction % 10);
+                fraction /= 10;
+            }
+            return length + 6;
+        }
+    }
+    return sprintf(text, "%f", value);
 }
 
-// Write a base64 encoded opaque value to the buffer provided
-static int JsonEncodeOpaque(char * buffer, int bufferLen, char * id, char * value, int len, bool last)
+// Write the name of a resource instance, relative to the URI being serialised, to id. Return the length of the name
+static int JsonResourceInstanceName(char * id, UriLevelType uriLevel, ResourceDefinition * definition,
+                                    ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID, ResourceInstanceIDType resourceInstanceID)
 {
-    char * buf;
-    int outLength;
+    //uri = /O      id = I/R or I/R/Ri
+    //uri = /O/I    id = R or R/Ri
+    //uri = /O/I/R  id = 0 or Ri
+    int length = 0;
 
-    if ((buffer == NULL) || (value == NULL))
+    if (uriLevel == OBJECT_URI)
     {
-        Lwm2m_Error("ERROR: input or output buffers cannot be NULL\n");
-        return -1;
+        length += JsonFormatInteger(&id[length], objectInstanceID);
+        id[length++] = '/';
     }
 
-    outLength = (((len + 2) * 4) / 3);
-    buf = (char * )malloc(outLength);
-    if (buf == NULL)
+    if (uriLevel == RESOURCE_URI)
+    {
+        length += JsonFormatInteger(&id[length], IS_MULTIPLE_INSTANCE(definition) ? resourceInstanceID : 0);
+    }
+    else
     {
-        return 0;
+        length += JsonFormatInteger(&id[length], resourceID);
+        if (IS_MULTIPLE_INSTANCE(definition))
+        {
+            id[length++] = '/';
+            length += JsonFormatInteger(&id[length], resourceInstanceID);
+        }
     }
+    id[length] = '\0';
+    return length;
+}
 
-    b64Encode(buf, outLength, value, len);
+// Write the start of a JSON element, {"n":"<id>","<name>":, to the stream provided
+static void JsonWriteElementStart(SerdesStream * stream, bool * first, const char * id, const char * name, bool quoted)
+{
+    char prefix[64];
+    int prefixLength = 0;
+    int length;
 
-    sprintf(buffer, "{\"n\":\"%s\",\"sv\":\"%s\"}", id, buf);
-    if (!last)
+    if (!*first)
     {
-        strcat(buffer,",\n");
+        prefix[prefixLength++] = ',';
+        prefix[prefixLength++] = '\n';
     }
-    else
+    memcpy(&prefix[prefixLength], "{\"n\":\"", 6);
+    prefixLength += 6;
+    length = strlen(id);
+    memcpy(&prefix[prefixLength], id, length);
+    prefixLength += length;
+    memcpy(&prefix[prefixLength], "\",\"", 3);
+    prefixLength += 3;
+    length = strlen(name);
+    memcpy(&prefix[prefixLength], name, length);
+    prefixLength += length;
+    prefix[prefixLength++] = '"';
+    prefix[prefixLength++] = ':';
+    if (quoted)
     {
-        strcat(buffer,"]\n");
+        prefix[prefixLength++] = '"';
     }
 
-    free(buf);
-    return strlen(buffer);
+    SerdesStream_Write(stream, prefix, prefixLength);
+    *first = false;
 }
 
-// Write a JSON encoded string to the buffer provided
-static int JsonEncodeString(char * buffer, int bufferLen, char * id, char * value, size_t size, bool last)
+static void JsonWriteElementEnd(SerdesStream * stream, bool quoted)
 {
-    int result = 0;
+    SerdesStream_Write(stream, quoted ? "\"}" : "}", quoted ? 2 : 1);
+}
 
-    char * temp = (char *)malloc(size + 1);
-    if (temp != NULL)
-    {
-        memcpy(temp, value, size);
-        temp[size] = '\0';
+// Write a string value to the stream provided, escaping any characters JSON doesn't allow in a string
+static void JsonWriteEscaped(SerdesStream * stream, const char * value, int length)
+{
+    int start = 0;
+    int i;
 
-        sprintf(buffer, "{\"n\":\"%s\",\"sv\":\"%s\"}", id, temp);
-        if (!last)
+    for (i = 0; i < length; i++)
+    {
+        uint8_t c = (uint8_t)value[i];
+        if ((c >= 0x20) && (c != '"') && (c != '\\'))
         {
-            strcat(buffer,",\n");
+            continue;
         }
-        else
+
+        char escape[8] = { '\\', (char)c };
+        int escapeLength = 2;
+        switch (c)
         {
-            strcat(buffer,"]\n");
+            case '"':
+            case '\\':
+                break;
+            case '\b':
+                escape[1] = 'b';
+                break;
+            case '\f':
+                escape[1] = 'f';
+                break;
+            case '\n':
+                escape[1] = 'n';
+                break;
+            case '\r':
+                escape[1] = 'r';
+                break;
+            case '\t':
+                escape[1] = 't';
+                break;
+            default:
+                escapeLength = sprintf(escape, "\\u%04x", c);
+                break;
         }
-        free(temp);
-        result = strlen(buffer);
-    }
-
-    return result;
-}
 
-// Write a JSON encoded integer to the buffer provided
-static int JsonEncodeInteger(char * buffer, int bufferLen, char * id, int64_t value, bool last)
-{
-    sprintf(buffer, "{\"n\":\"%s\",\"v\":%" PRIu64"}", id, value);
-    if (!last)
-    {
-        strcat(buffer,",\n");
-    }
-    else
-    {
-        strcat(buffer,"]\n");
+        SerdesStream_Write(stream, &value[start], i - start);
+        SerdesStream_Write(stream, escape, escapeLength);
+        start = i + 1;
     }
-
-    return strlen(buffer);
+    SerdesStream_Write(stream, &value[start], length - start);
 }
 
-// Write a JSON encoded float to the buffer provided
-static int JsonEncodeFloat(char * buffer, int bufferLen, char * id, double value, bool last)
+// Write one JSON element, {"n":"<id>","<name>":<value>}, to the stream provided
+static void JsonWriteElement(SerdesStream * stream, bool * first, const char * id, const char * name, const char * value, int length, bool quoted)
 {
-    sprintf(buffer, "{\"n\":\"%s\",\"v\":%f}", id, value);
-    if (!last)
+    JsonWriteElementStart(stream, first, id, name, quoted);
+    if (quoted)
     {
-        strcat(buffer,",\n");
+        JsonWriteEscaped(stream, value, length);
     }
     else
     {
-        strcat(buffer,"]\n");
+        SerdesStream_Write(stream, value, length);
     }
-    return strlen(buffer);
+    JsonWriteElementEnd(stream, quoted);
 }
 
-// Write a JSON encoded boolean to the buffer provided
-static int JsonEncodeBoolean(char * buffer, int bufferLen, char * id, bool value, bool last)
+// Write a base64 encoded opaque value to the stream provided, a chunk at a time
+static void JsonWriteOpaque(SerdesStream * stream, bool * first, const char * id, const uint8_t * value, int size)
 {
-    sprintf(buffer, "{\"n\":\"%s\",\"bv\":\"%s\"}", id, value ? "true" : "false");
-    if (!last)
-    {
-        strcat(buffer,",\n");
-    }
-    else
-    {
-        strcat(buffer,"]\n");
-    }
-    return strlen(buffer);
-}
+    char encoded[(JSON_OPAQUE_CHUNK + 2) * 4 / 3 + 1];
+    int offset;
 
-// Write a JSON encoded object-link to the buffer provided
-static int JsonEncodeObjectLink(char * buffer, int bufferLen, char * id, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, bool last)
-{
-    sprintf(buffer, "{\"n\":\"%s\",\"sv\":\"%d:%d\"}", id, objectID, objectInstanceID);
-    if (!last)
-    {
-        strcat(buffer,",\n");
-    }
-    else
+    JsonWriteElementStart(stream, first, id, "sv", true);
+    for (offset = 0; offset < size; offset += JSON_OPAQUE_CHUNK)
     {
-        strcat(buffer,"]\n");
+        int length = (size - offset < JSON_OPAQUE_CHUNK) ? size - offset : JSON_OPAQUE_CHUNK;
+        b64Encode(encoded, sizeof(encoded), (char *)&value[offset], length);
+        SerdesStream_Write(stream, encoded, ((length + 2) / 3) * 4);
     }
-    return strlen(buffer);
+    JsonWriteElementEnd(stream, true);
 }
 
-// Write a JSON encoded resource instance to the buffer provided
-static int JsonSerialiseResourceInstance(Lwm2mTreeNode * node, ResourceDefinition * definition, char * id, uint8_t * buffer, int len, bool last)
+// Write a JSON encoded resource instance, held in a tree node or the object store, to the stream provided
+static int JsonWriteResourceInstance(SerdesStream * stream, bool * first, ResourceDefinition * definition, const char * id, const void * value, size_t size)
 {
-    int valueLength = -1;
-    uint16_t size;
-    uint8_t * value;
+    char text[JSON_FLOAT_LENGTH];
+    int result = 0;
 
-    if (Lwm2mTreeNode_GetType(node) != Lwm2mTreeNodeType_ResourceInstance)
+    if ((value == NULL) && (definition->Type != AwaResourceType_String) && (definition->Type != AwaResourceType_Opaque))
     {
-       Lwm2m_Error("ERROR: Resource Instance node type expected. Received %d\n", Lwm2mTreeNode_GetType(node));
-       return -1;
+        Lwm2m_Error("ERROR: JSON - no value for resource instance %s\n", id);
+        return -1;
     }
 
-    value = (uint8_t * )Lwm2mTreeNode_GetValue(node, &size);
     switch (definition->Type)
     {
         case AwaResourceType_String:
-            valueLength = JsonEncodeString((char *)buffer, len, id, (char *)value, size, last);
+            JsonWriteElement(stream, first, id, "sv", (const char *)value, (value != NULL) ? strnlen((const char *)value, size) : 0, true);
             break;
         case AwaResourceType_Boolean:
-            valueLength = JsonEncodeBoolean((char *)buffer, len, id, *(bool*)value, last);
+            JsonWriteElement(stream, first, id, "bv", *(bool*)value ? "true" : "false", *(bool*)value ? 4 : 5, true);
             break;
         case AwaResourceType_Time:  // no break
         case AwaResourceType_Integer:
             switch (size)
             {
                case sizeof(int8_t):
-                   valueLength = JsonEncodeInteger((char *)buffer, len, id, ptrToInt8(value), last);
+                   result = JsonFormatInteger(text, ptrToInt8((void *)value));
                    break;
                case sizeof(int16_t):
-                   valueLength = JsonEncodeInteger((char *)buffer, len, id, ptrToInt16(value), last);
+                   result = JsonFormatInteger(text, ptrToInt16((void *)value));
                    break;
                case sizeof(int32_t):
-                   valueLength = JsonEncodeInteger((char *)buffer, len, id, ptrToInt32(value), last);
+                   result = JsonFormatInteger(text, ptrToInt32((void *)value));
                    break;
                case sizeof(int64_t):
-                   valueLength = JsonEncodeInteger((char *)buffer, len, id, ptrToInt64(value), last);
+                   result = JsonFormatInteger(text, ptrToInt64((void *)value));
                    break;
                default:
-                   break;
+                   Lwm2m_Error("ERROR: JSON - invalid length for integer\n");
+                   return -1;
             }
+            JsonWriteElement(stream, first, id, "v", text, result, false);
+            result = 0;
             break;
         case AwaResourceType_Float:
             switch (size)
             {
                 case sizeof(float):
-                    valueLength = JsonEncodeFloat((char *)buffer, len, id, *(float*)value, last);
+                    result = JsonFormatFloat(text, *(float*)value);
                     break;
                 case sizeof(double):
-                    valueLength = JsonEncodeFloat((char *)buffer, len, id, *(double*)value, last);
+                    result = JsonFormatFloat(text, *(double*)value);
                     break;
                 default:
                     Lwm2m_Error("ERROR: JSON - invalid length for float\n");
-                    break;
+                    return -1;
             }
+            JsonWriteElement(stream, first, id, "v", text, result, false);
+            result = 0;
             break;
         case AwaResourceType_Opaque:
-            valueLength = JsonEncodeOpaque((char *)buffer, len, id, (char *)value, size, last);
+            JsonWriteOpaque(stream, first, id, (const uint8_t *)value, size);
             break;
         case AwaResourceType_ObjectLink:
-           {
-               AwaObjectLink * objectLink = (AwaObjectLink *) value;
-               valueLength = JsonEncodeObjectLink((char *)buffer, len, id, objectLink->ObjectID, objectLink->ObjectInstanceID, last);
-               break;
-           }
+            {
+                AwaObjectLink * objectLink = (AwaObjectLink *) value;
+                int length = JsonFormatInteger(text, objectLink->ObjectID);
+                text[length++] = ':';
+                length += JsonFormatInteger(&text[length], objectLink->ObjectInstanceID);
+                JsonWriteElement(stream, first, id, "ov", text, length, true);
+            }
+            break;
         default:
-            printf("Unknown type\n");
+            Lwm2m_Error("ERROR: Unknown type %d\n", definition->Type);
+            result = -1;
             break;
     }
-
-    return valueLength;
+    return result;
 }
 
-// Write a JSON encoded resource to the buffer provided
-static int JsonSerialiseResource(SerdesContext * serdesContext, Lwm2mTreeNode * node, ObjectIDType objectID,
-                                 ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID, uint8_t * buffer, int len)
+// Write the JSON encoded instances of a resource to the stream provided. Return the number of elements written, or -1 on error
+static int JsonWriteResource(SerdesStream * stream, bool * first, UriLevelType uriLevel, Lwm2mTreeNode * node,
+                             ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID)
 {
+    int count = 0;
+
     if (Lwm2mTreeNode_GetType(node) != Lwm2mTreeNodeType_Resource)
     {
         Lwm2m_Error("ERROR: Resource node type expected. Received %d\n", Lwm2mTreeNode_GetType(node));
         return -1;
     }
 
-    int resourceLength = 0;
     ResourceDefinition * definition = (ResourceDefinition *)Lwm2mTreeNode_GetDefinition(node);
-
-    if (*serdesContext == NULL)
+    if (definition == NULL)
     {
-        JsonInitSerdesContext(serdesContext, RESOURCE_URI);
-        resourceLength += JsonStartElement((char *)buffer, len);
+        Lwm2m_Error("ERROR: No resource definition for Resource %d\n", resourceID);
+        return -1;
     }
-    JsonSerdesContext * context = (JsonSerdesContext *)*serdesContext;
 
     Lwm2mTreeNode * child = Lwm2mTreeNode_GetFirstChild(node);
     while (child != NULL)
     {
-        Lwm2mTreeNode * nextChild = Lwm2mTreeNode_GetNextChild(node, child);
-        bool last = context->lastResource && (nextChild == NULL);
         char id[32];
-
         int resourceInstanceID;
-        Lwm2mTreeNode_GetID(child, &resourceInstanceID);
+        uint16_t size;
 
-        //uri = /O      id = I/R or I/R/Ri
-        //uri = /O/I    id = R or R/Ri
-        //uri = /O/I/R  id = 0 or Ri
-        if (context->uriLevel == RESOURCE_URI)
-        {
-            sprintf(id, "%d", IS_MULTIPLE_INSTANCE(definition) ? resourceInstanceID : 0);
-        }
-        else if (context->uriLevel == INSTANCE_URI)
-        {
-            if (IS_MULTIPLE_INSTANCE(definition))
-            {
-                sprintf(id, "%d/%d", resourceID, resourceInstanceID);
-            }
-            else
-            {
-                sprintf(id, "%d", resourceID);
-            }
-        }
-        else  // OBJECT_URI
+        if (Lwm2mTreeNode_GetType(child) != Lwm2mTreeNodeType_ResourceInstance)
         {
-            if (IS_MULTIPLE_INSTANCE(definition))
-            {
-                sprintf(id, "%d/%d/%d", objectInstanceID, resourceID, resourceInstanceID);
-            }
-            else
-            {
-                sprintf(id, "%d/%d", objectInstanceID, resourceID);
-            }
+           Lwm2m_Error("ERROR: Resource Instance node type expected. Received %d\n", Lwm2mTreeNode_GetType(child));
+           return -1;
         }
 
-        int valueLength = JsonSerialiseResourceInstance(child, definition, id, &buffer[resourceLength], len - resourceLength, last);
-        if (valueLength <= 0)
+        Lwm2mTreeNode_GetID(child, &resourceInstanceID);
+        JsonResourceInstanceName(id, uriLevel, definition, objectInstanceID, resourceID, resourceInstanceID);
+
+        const uint8_t * value = Lwm2mTreeNode_GetValue(child, &size);
+        if (JsonWriteResourceInstance(stream, first, definition, id, value, size) < 0)
         {
            Lwm2m_Error("ERROR: Failed to serialise resource instance\n");
-           JsonDestroySerdesContext(serdesContext);
            return -1;
         }
-        resourceLength += valueLength;
-        child = nextChild;
-    }
-
-    if (context->uriLevel == RESOURCE_URI)
-    {
-        resourceLength += JsonEndElement((char *)&buffer[resourceLength], len - resourceLength);
-        JsonDestroySerdesContext(serdesContext);
+        count++;
+        child = Lwm2mTreeNode_GetNextChild(node, child);
     }
-
-    return resourceLength;
+    return count;
 }
 
-// Write a Json encoded instance to the buffer provided
-static int JsonSerialiseObjectInstance(SerdesContext * serdesContext, Lwm2mTreeNode * node, ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, uint8_t * buffer, int len)
+// Write the JSON encoded resources of an object instance to the stream provided. Return the number of resources written, or -1 on error
+static int JsonWriteObjectInstance(SerdesStream * stream, bool * first, UriLevelType uriLevel, Lwm2mTreeNode * node, ObjectInstanceIDType objectInstanceID)
 {
-    int instanceLength = 0;
+    int count = 0;
 
     if (Lwm2mTreeNode_GetType(node) != Lwm2mTreeNodeType_ObjectInstance)
     {
@@ -418,46 +446,71 @@ static int JsonSerialiseObjectInstance(SerdesContext * serdesContext, Lwm2mTreeN
         return -1;
     }
 
-    if (*serdesContext == NULL)
-    {
-        JsonInitSerdesContext(serdesContext, INSTANCE_URI);
-        instanceLength += JsonStartElement((char *)buffer, len);
-    }
-    JsonSerdesContext * context = (JsonSerdesContext *)*serdesContext;
-
     Lwm2mTreeNode * child = Lwm2mTreeNode_GetFirstChild(node);
     while (child != NULL)
     {
-        Lwm2mTreeNode * nextChild = Lwm2mTreeNode_GetNextChild(node, child);
         int resourceID;
         Lwm2mTreeNode_GetID(child, &resourceID);
-        context->lastResource = context->lastInstance && (nextChild == NULL);
 
-        int resourceLength = JsonSerialiseResource(serdesContext, child, objectID, objectInstanceID, resourceID, &buffer[instanceLength], len - instanceLength);
-        if (resourceLength <= 0)
+        if (JsonWriteResource(stream, first, uriLevel, child, objectInstanceID, resourceID) <= 0)
         {
             Lwm2m_Error("Failed to serialise resource\n");
-            JsonDestroySerdesContext(serdesContext);
             return -1;
         }
-        instanceLength += resourceLength;
+        count++;
+        child = Lwm2mTreeNode_GetNextChild(node, child);
+    }
+    return count;
+}
 
-        child = nextChild;
+// Close an encoding written to stream. Return its length, or -1 if it didn't fit in the buffer
+static int JsonEndEncoding(SerdesStream * stream)
+{
+    SerdesStream_Write(stream, JSON_STREAM_END, strlen(JSON_STREAM_END));
+    if (stream->More)
+    {
+        Lwm2m_Error("ERROR: Output buffer is too small to encode data\n");
+        return -1;
     }
+    return SerdesStream_GetLength(stream);
+}
+
+// Write a JSON encoded resource to the buffer provided
+static int JsonSerialiseResource(SerdesContext * serdesContext, Lwm2mTreeNode * node, ObjectIDType objectID,
+                                 ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID, uint8_t * buffer, int len)
+{
+    SerdesStream stream;
+    bool first = true;
 
-    if (context->uriLevel == INSTANCE_URI)
+    SerdesStream_Init(&stream, buffer, len, 0);
+    SerdesStream_Write(&stream, JSON_STREAM_START, strlen(JSON_STREAM_START));
+    if (JsonWriteResource(&stream, &first, RESOURCE_URI, node, objectInstanceID, resourceID) < 0)
     {
-        instanceLength += JsonEndElement((char *)&buffer[instanceLength], len - instanceLength);
-        JsonDestroySerdesContext(serdesContext);
+        return -1;
     }
+    return JsonEndEncoding(&stream);
+}
+
+// Write a Json encoded instance to the buffer provided
+static int JsonSerialiseObjectInstance(SerdesContext * serdesContext, Lwm2mTreeNode * node, ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, uint8_t * buffer, int len)
+{
+    SerdesStream stream;
+    bool first = true;
 
-    return instanceLength;
+    SerdesStream_Init(&stream, buffer, len, 0);
+    SerdesStream_Write(&stream, JSON_STREAM_START, strlen(JSON_STREAM_START));
+    if (JsonWriteObjectInstance(&stream, &first, INSTANCE_URI, node, objectInstanceID) < 0)
+    {
+        return -1;
+    }
+    return JsonEndEncoding(&stream);
 }
 
 // Write a Json encoded object to the buffer provided
 static int JsonSerialiseObject(SerdesContext * serdesContext, Lwm2mTreeNode * node, ObjectIDType objectID, uint8_t * buffer, int len)
 {
-    int pos = 0;
+    SerdesStream stream;
+    bool first = true;
 
     if (Lwm2mTreeNode_GetType(node) != Lwm2mTreeNodeType_Object)
     {
@@ -465,38 +518,150 @@ static int JsonSerialiseObject(SerdesContext * serdesContext, Lwm2mTreeNode * no
         return -1;
     }
 
-    JsonInitSerdesContext(serdesContext, OBJECT_URI);
-    JsonSerdesContext * context = (JsonSerdesContext *)*serdesContext;
-    pos += JsonStartElement((char *)buffer, len);
+    SerdesStream_Init(&stream, buffer, len, 0);
+    SerdesStream_Write(&stream, JSON_STREAM_START, strlen(JSON_STREAM_START));
 
     Lwm2mTreeNode * child = Lwm2mTreeNode_GetFirstChild(node);
     while (child != NULL)
     {
-        Lwm2mTreeNode * nextChild = Lwm2mTreeNode_GetNextChild(node, child);
-        context->lastInstance = nextChild == NULL;
         int objectInstanceID;
         Lwm2mTreeNode_GetID(child, &objectInstanceID);
 
-        int instanceLength = JsonSerialiseObjectInstance(serdesContext, child, objectID, objectInstanceID, &buffer[pos], len - pos);
-        if (instanceLength <= 0)
+        if (JsonWriteObjectInstance(&stream, &first, OBJECT_URI, child, objectInstanceID) <= 0)
         {
             Lwm2m_Error("Failed to serialise object instance\n");
-            JsonDestroySerdesContext(serdesContext);
             return -1;
         }
+        child = Lwm2mTreeNode_GetNextChild(node, child);
+    }
+    return JsonEndEncoding(&stream);
+}
+
+// Write a JSON encoded resource instance, read from the object store, to the stream provided
+static int JsonStreamResourceInstance(SerdesStream * stream, bool * first, Lwm2mContextType * context, ResourceDefinition * definition, const char * id,
+                                      ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID, ResourceInstanceIDType resourceInstanceID)
+{
+    const void * value = NULL;
+    size_t size = 0;
+
+    if (Lwm2mCore_GetResourceInstanceValue(context, objectID, objectInstanceID, resourceID, resourceInstanceID, &value, &size) < 0)
+    {
+        Lwm2m_Error("ERROR: Failed to retrieve resource instance /%d/%d/%d/%d from object store\n", objectID, objectInstanceID, resourceID, resourceInstanceID);
+        return -1;
+    }
+    return JsonWriteResourceInstance(stream, first, definition, id, value, size);
+}
+
+// Write a JSON encoded resource, read from the object store, to the stream provided
+static int JsonStreamResourceFromStore(SerdesStream * stream, bool * first, UriLevelType uriLevel, Lwm2mContextType * context,
+                                       ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID)
+{
+    char id[32];
+    ResourceDefinition * definition = Definition_LookupResourceDefinition(Lwm2mCore_GetDefinitions(context), objectID, resourceID);
+    if (definition == NULL)
+    {
+        Lwm2m_Error("ERROR: No resource definition for Object %d Resource %d\n", objectID, resourceID);
+        return -1;
+    }
+
+    if (!IS_MULTIPLE_INSTANCE(definition))
+    {
+        JsonResourceInstanceName(id, uriLevel, definition, objectInstanceID, resourceID, 0);
+        return JsonStreamResourceInstance(stream, first, context, definition, id, objectID, objectInstanceID, resourceID, 0);
+    }
+
+    ResourceInstanceIDType resourceInstanceID = -1;
+    while ((resourceInstanceID = Lwm2mCore_GetNextResourceInstanceID(context, objectID, objectInstanceID, resourceID, resourceInstanceID)) != -1)
+    {
+        JsonResourceInstanceName(id, uriLevel, definition, objectInstanceID, resourceID, resourceInstanceID);
+        if (JsonStreamResourceInstance(stream, first, context, definition, id, objectID, objectInstanceID, resourceID, resourceInstanceID) < 0)
+        {
+            Lwm2m_Error("ERROR: Failed to serialise resource instance\n");
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// Write the JSON encoded resources of an object instance, read from the object store, to the stream provided
+static int JsonStreamObjectInstanceFromStore(SerdesStream * stream, bool * first, UriLevelType uriLevel, Lwm2mContextType * context,
+                                             ObjectIDType objectID, ObjectInstanceIDType objectInstanceID)
+{
+    ResourceIDType resourceID = -1;
+    while ((resourceID = Lwm2mCore_GetNextResourceID(context, objectID, objectInstanceID, resourceID)) != -1)
+    {
+        // Executable resources have no value to read
+        if (Definition_IsResourceTypeExecutable(Lwm2mCore_GetDefinitions(context), objectID, resourceID) != 0)
+        {
+            continue;
+        }
+
+        if (JsonStreamResourceFromStore(stream, first, uriLevel, context, objectID, objectInstanceID, resourceID) < 0)
+        {
+            Lwm2m_Error("Failed to serialise resource\n");
+            return -1;
+        }
+
+        if (stream->More)
+        {
+            // The window is full, so the rest of the encoding isn't needed
+            break;
+        }
+    }
+    return 0;
+}
 
-        pos += instanceLength;
+static int JsonStreamResource(SerdesContext * serdesContext, SerdesStream * stream, Lwm2mContextType * context,
+                              ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID)
+{
+    bool first = true;
+    SerdesStream_Write(stream, JSON_STREAM_START, strlen(JSON_STREAM_START));
+    if (JsonStreamResourceFromStore(stream, &first, RESOURCE_URI, context, objectID, objectInstanceID, resourceID) < 0)
+    {
+        return -1;
+    }
+    SerdesStream_Write(stream, JSON_STREAM_END, strlen(JSON_STREAM_END));
+    return 0;
+}
 
-        child = nextChild;
+static int JsonStreamObjectInstance(SerdesContext * serdesContext, SerdesStream * stream, Lwm2mContextType * context,
+                                    ObjectIDType objectID, ObjectInstanceIDType objectInstanceID)
+{
+    bool first = true;
+    SerdesStream_Write(stream, JSON_STREAM_START, strlen(JSON_STREAM_START));
+    if (JsonStreamObjectInstanceFromStore(stream, &first, INSTANCE_URI, context, objectID, objectInstanceID) < 0)
+    {
+        return -1;
     }
+    SerdesStream_Write(stream, JSON_STREAM_END, strlen(JSON_STREAM_END));
+    return 0;
+}
+
+static int JsonStreamObject(SerdesContext * serdesContext, SerdesStream * stream, Lwm2mContextType * context, ObjectIDType objectID)
+{
+    bool first = true;
+    SerdesStream_Write(stream, JSON_STREAM_START, strlen(JSON_STREAM_START));
+
+    ObjectInstanceIDType objectInstanceID = -1;
+    while ((objectInstanceID = Lwm2mCore_GetNextObjectInstanceID(context, objectID, objectInstanceID)) != -1)
+    {
+        if (JsonStreamObjectInstanceFromStore(stream, &first, OBJECT_URI, context, objectID, objectInstanceID) < 0)
+        {
+            Lwm2m_Error("Failed to serialise object instance\n");
+            return -1;
+        }
 
-    pos += JsonEndElement((char *)&buffer[pos], len - pos);
-    JsonDestroySerdesContext(serdesContext);
+        if (stream->More)
+        {
+            break;
+        }
+    }
 
-    return pos;
+    SerdesStream_Write(stream, JSON_STREAM_END, strlen(JSON_STREAM_END));
+    return 0;
 }
 
-static Lwm2mTreeNode * AddObjectNode(Lwm2mTreeNode * root, const DefinitionRegistry * registry, ObjectIDType objectID)
+static Lwm2mTreeNode * AddObjectNode(Lwm2mTreeArena * arena, Lwm2mTreeNode * root, const DefinitionRegistry * registry, ObjectIDType objectID)
 {
     Lwm2mTreeNode * objectNode = (root != NULL) ? Lwm2mTreeNode_FindNode(root, objectID) : NULL;
     if (objectNode == NULL)
@@ -509,7 +674,7 @@ static Lwm2mTreeNode * AddObjectNode(Lwm2mTreeNode * root, const DefinitionRegis
             return NULL;
         }
 
-        objectNode = Lwm2mTreeNode_Create();
+        objectNode = Lwm2mTreeNode_CreateInArena(arena);
         Lwm2mTreeNode_SetID(objectNode, objectID);
         Lwm2mTreeNode_SetType(objectNode, Lwm2mTreeNodeType_Object);
 
@@ -529,13 +694,13 @@ static Lwm2mTreeNode * AddObjectNode(Lwm2mTreeNode * root, const DefinitionRegis
     return objectNode;
 }
 
-static Lwm2mTreeNode * AddObjectInstanceNode(Lwm2mTreeNode * objectNode, const DefinitionRegistry * registry, ObjectIDType instanceID)
+static Lwm2mTreeNode * AddObjectInstanceNode(Lwm2mTreeArena * arena, Lwm2mTreeNode * objectNode, const DefinitionRegistry * registry, ObjectIDType instanceID)
 {
     // Lookup instance node and create it if it doesn't exist.
     Lwm2mTreeNode * instanceNode = (objectNode != NULL) ? Lwm2mTreeNode_FindNode(objectNode, instanceID) : NULL;
     if (instanceNode == NULL)
     {
-        instanceNode = Lwm2mTreeNode_Create();
+        instanceNode = Lwm2mTreeNode_CreateInArena(arena);
         Lwm2mTreeNode_SetID(instanceNode, instanceID);
         Lwm2mTreeNode_SetType(instanceNode, Lwm2mTreeNodeType_ObjectInstance);
         Lwm2mTreeNode_SetDefinition(instanceNode, Lwm2mTreeNode_GetDefinition(objectNode));
@@ -548,7 +713,7 @@ static Lwm2mTreeNode * AddObjectInstanceNode(Lwm2mTreeNode * objectNode, const D
     return instanceNode;
 }
 
-static Lwm2mTreeNode * AddResourceNode(Lwm2mTreeNode * instanceNode, const DefinitionRegistry * registry, ObjectIDType objectID, ResourceIDType resourceID)
+static Lwm2mTreeNode * AddResourceNode(Lwm2mTreeArena * arena, Lwm2mTreeNode * instanceNode, const DefinitionRegistry * registry, ObjectIDType objectID, ResourceIDType resourceID)
 {
     Lwm2mTreeNode * resourceNode = (instanceNode != NULL) ? Lwm2mTreeNode_FindNode(instanceNode, resourceID) : NULL;
     if (resourceNode == NULL)
@@ -561,7 +726,7 @@ static Lwm2mTreeNode * AddResourceNode(Lwm2mTreeNode * instanceNode, const Defin
             return NULL;
         }
 
-        resourceNode = Lwm2mTreeNode_Create();
+        resourceNode = Lwm2mTreeNode_CreateInArena(arena);
         Lwm2mTreeNode_SetID(resourceNode, resourceID);
         Lwm2mTreeNode_SetType(resourceNode, Lwm2mTreeNodeType_Resource);
 
@@ -581,356 +746,799 @@ static Lwm2mTreeNode * AddResourceNode(Lwm2mTreeNode * instanceNode, const Defin
     return resourceNode;
 }
 
-static int JsonDeserialise(Lwm2mTreeNode ** dest, const DefinitionRegistry * registry, ObjectIDType objectID,
-                           ObjectInstanceIDType instanceID, ResourceIDType resourceID, const uint8_t * buf, int bufferLen)
+static void JsonSkipWhitespace(JsonReader * reader)
 {
-    int result;
-    int index;
-    jsmn_parser p;
-    jsmntok_t tokens[MAX_JSON_TOKENS];
-    enum { BASENAME_SIZE = 128 };
-    char basename[BASENAME_SIZE];
-    uint64_t basetime = 0;
-    const char * buffer = (const char *)buf;
-
-    jsmn_init(&p);
-
-    result = jsmn_parse(&p, buffer, bufferLen, tokens, (sizeof(tokens) / sizeof(*tokens)));
-    if (result < 0)
+    while (reader->Position < reader->Length)
     {
-        Lwm2m_Error("ERROR: deserialising JSON, malformed!\n");
-        return -1;
+        char c = reader->Buffer[reader->Position];
+        if ((c != ' ') && (c != '\t') && (c != '\n') && (c != '\r'))
+        {
+            break;
+        }
+        reader->Position++;
     }
+}
 
-
-    jsmntok_t *root = &tokens[0]; // {
-    if (root->type != JSMN_OBJECT)
+// Consume c, after any whitespace. Return false, consuming nothing but the whitespace, if the next character is something else
+static bool JsonConsume(JsonReader * reader, char c)
+{
+    JsonSkipWhitespace(reader);
+    if ((reader->Position < reader->Length) && (reader->Buffer[reader->Position] == c))
     {
-        return -1;
+        reader->Position++;
+        return true;
     }
+    return false;
+}
 
-    jsmntok_t * t;
-    // First lookup the basename
-    if ((index = JsonTokenFind(tokens, buffer, root, "bn")) != -1)
-    {
-        t = &tokens[tokens[index].first_child];
-        if (t->type != JSMN_STRING)
-        {
-            return -1;
-        }
-        strncpy(basename, JsonTokenToString(buffer, t), BASENAME_SIZE);
-        basename[BASENAME_SIZE - 1] = '\0'; // Defensive
+static bool JsonIsPrimitiveCharacter(char c)
+{
+    return ((c >= '0') && (c <= '9')) || ((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')) || (c == '+') || (c == '-') || (c == '.');
+}
+
+// Read a string or primitive value, leaving it in the input buffer
+static bool JsonReadValue(JsonReader * reader, JsonValue * value)
+{
+    const char * buffer = reader->Buffer;
+    int position;
+
+    JsonSkipWhitespace(reader);
+    position = reader->Position;
+    memset(value, 0, sizeof(*value));
 
-        *dest = Lwm2mTreeNode_Create();
-        Lwm2mTreeNode_SetType(*dest, Lwm2mTreeNodeType_Root);
+    if (position >= reader->Length)
+    {
+        return false;
     }
-    else
+
+    if (buffer[position] == '"')
     {
-        if (resourceID != -1)
-        {
-            sprintf(basename, "/%d/%d/%d/", objectID, instanceID, resourceID);
-            *dest = AddResourceNode(NULL, registry, objectID, resourceID);
-        }
-        else
+        value->Quoted = true;
+        value->Start = &buffer[++position];
+        while ((position < reader->Length) && (buffer[position] != '"'))
         {
-            if (instanceID != -1)
+            if ((uint8_t)buffer[position] < 0x20)
             {
-                sprintf(basename, "/%d/%d/", objectID, instanceID);
-                *dest = AddObjectInstanceNode(NULL, registry, objectID);
+                return false;
             }
-            else
+            if (buffer[position] == '\\')
             {
-                sprintf(basename, "/%d/", objectID);
-                *dest = AddObjectNode(NULL, registry, objectID);
+                // the escaped character can't end the string
+                value->Escaped = true;
+                position++;
             }
+            position++;
+        }
+        if (position >= reader->Length)
+        {
+            return false;
         }
+        value->Length = &buffer[position] - value->Start;
+        reader->Position = position + 1;
     }
-
-    // Lookup base time
-    if ((index = JsonTokenFind(tokens, buffer, root, "bt")) != -1)
+    else
     {
-        t = &tokens[tokens[index].first_child];
-        if (t->type != JSMN_PRIMITIVE)
+        value->Start = &buffer[position];
+        while ((position < reader->Length) && JsonIsPrimitiveCharacter(buffer[position]))
         {
-            return -1;
+            position++;
         }
+        value->Length = &buffer[position] - value->Start;
+        reader->Position = position;
+    }
+    return (value->Length > 0) || value->Quoted;
+}
+
+// Read the name of an object member and the colon that follows it
+static bool JsonReadKey(JsonReader * reader, JsonValue * key)
+{
+    return JsonReadValue(reader, key) && key->Quoted && JsonConsume(reader, ':');
+}
+
+// Skip a value of any kind, including objects and arrays nested up to JSON_MAX_DEPTH deep
+static bool JsonSkipValue(JsonReader * reader, int depth)
+{
+    JsonValue value;
 
-        char * string = JsonTokenToString(buffer, t);
-        sscanf(string, "%24" SCNu64, &basetime);
+    if (depth > JSON_MAX_DEPTH)
+    {
+        return false;
     }
 
-    // Lookup resource array
-    if ((index = JsonTokenFind(tokens, buffer, root, "e")) != -1)
+    if (JsonConsume(reader, '{'))
     {
-        jsmntok_t * resourceArray = &tokens[tokens[index].first_child];
-        if (resourceArray->type != JSMN_ARRAY)
+        if (JsonConsume(reader, '}'))
         {
-            return -1;
+            return true;
         }
-
-        // Add Resource nodes
-        if (resourceArray->size <= 0)
+        do
         {
-            return -1;
+            if (!JsonReadKey(reader, &value) || !JsonSkipValue(reader, depth + 1))
+            {
+                return false;
+            }
         }
+        while (JsonConsume(reader, ','));
+        return JsonConsume(reader, '}');
+    }
 
-        index = resourceArray->first_child;
+    if (JsonConsume(reader, '['))
+    {
+        if (JsonConsume(reader, ']'))
+        {
+            return true;
+        }
         do
         {
-            // {"n":"<name>","<type>":"<data>"},
-            t = &tokens[index];
-            if (t->type != JSMN_OBJECT)
+            if (!JsonSkipValue(reader, depth + 1))
             {
-                return -1;
+                return false;
             }
+        }
+        while (JsonConsume(reader, ','));
+        return JsonConsume(reader, ']');
+    }
 
-            // "n"
-            t = &tokens[t->first_child];
-            if (t->type != JSMN_STRING)
-            {
-                return -1;
-            }
+    return JsonReadValue(reader, &value);
+}
 
-            if (!JsonTokenStrcmp(buffer, t, "n"))
-            {
-                return -1;
-            }
+static bool JsonValueEquals(const JsonValue * value, const char * string)
+{
+    int length = strlen(string);
+    return !value->Escaped && (value->Length == length) && (memcmp(value->Start, string, length) == 0);
+}
 
-            // resource name
-            jsmntok_t * key = &tokens[t->first_child];
-            if (key->type != JSMN_STRING)
-            {
-                return -1;
-            }
+static bool JsonParseInteger(const char * text, int length, int64_t * result)
+{
+    uint64_t magnitude = 0;
+    bool negative = (length > 0) && (text[0] == '-');
+    uint64_t limit = (uint64_t)INT64_MAX + (negative ? 1 : 0);
+    int i = negative ? 1 : 0;
+
+    if (i == length)
+    {
+        return false;
+    }
+
+    for (; i < length; i++)
+    {
+        if ((text[i] < '0') || (text[i] > '9'))
+        {
+            return false;
+        }
+        int digit = text[i] - '0';
+        // Check before multiplying, as the magnitude could otherwise wrap back into range
+        if (magnitude > (limit - digit) / 10)
+        {
+            return false;
+        }
+        magnitude = (magnitude * 10) + digit;
+    }
+
+    *result = negative ? (int64_t)(0 - magnitude) : (int64_t)magnitude;
+    return true;
+}
+
+static bool JsonParseFloat(const char * text, int length, double * result)
+{
+    char copy[64];
+    char * end;
+
+    if ((length <= 0) || (length >= (int)sizeof(copy)))
+    {
+        return false;
+    }
+
+    memcpy(copy, text, length);
+    copy[length] = '\0';
+    *result = strtod(copy, &end);
+    return end == &copy[length];
+}
+
+static int JsonParseHex(const char * text)
+{
+    int result = 0;
+    int i;
+
+    for (i = 0; i < 4; i++)
+    {
+        char c = text[i];
+        int digit = ((c >= '0') && (c <= '9')) ? c - '0' :
+                    ((c >= 'a') && (c <= 'f')) ? c - 'a' + 10 :
+                    ((c >= 'A') && (c <= 'F')) ? c - 'A' + 10 : -1;
+        if (digit < 0)
+        {
+            return -1;
+        }
+        result = (result << 4) | digit;
+    }
+    return result;
+}
 
-            char * name = JsonTokenToString(buffer, key);
+// Decode the escape sequences in a string into out, which must hold value->Length bytes. Return the decoded length, or -1 if an escape is invalid
+static int JsonUnescape(const JsonValue * value, char * out)
+{
+    const char * in = value->Start;
+    const char * end = value->Start + value->Length;
+    int length = 0;
 
-            // append the basename and then parse the O/I/R/Ri
-            int resourceInstanceID = 0;
-            char base[256];
-            snprintf(base, 256, "%s%s", basename, name);
-            sscanf(base, "/%5d/%5d/%5d/%5d", &objectID, &instanceID, &resourceID, &resourceInstanceID);
+    while (in < end)
+    {
+        if (*in != '\\')
+        {
+            out[length++] = *in++;
+            continue;
+        }
 
-            Lwm2mTreeNode * resourceNode;
-            Lwm2mTreeNode * resourceValueNode;
+        in++;   // JsonReadValue ensures a character follows the backslash
+        switch (*in++)
+        {
+            case '"':  out[length++] = '"';  break;
+            case '\\': out[length++] = '\\'; break;
+            case '/':  out[length++] = '/';  break;
+            case 'b':  out[length++] = '\b'; break;
+            case 'f':  out[length++] = '\f'; break;
+            case 'n':  out[length++] = '\n'; break;
+            case 'r':  out[length++] = '\r'; break;
+            case 't':  out[length++] = '\t'; break;
+            case 'u':
+                {
+                    int codePoint = (end - in >= 4) ? JsonParseHex(in) : -1;
+                    if (codePoint < 0)
+                    {
+                        return -1;
+                    }
+                    in += 4;
 
-            if (Lwm2mTreeNode_GetType(*dest) == Lwm2mTreeNodeType_Root)
+                    if ((codePoint >= 0xd800) && (codePoint <= 0xdbff))
+                    {
+                        // a high surrogate must be followed by an escaped low surrogate
+                        int low = ((end - in >= 6) && (in[0] == '\\') && (in[1] == 'u')) ? JsonParseHex(&in[2]) : -1;
+                        if ((low < 0xdc00) || (low > 0xdfff))
+                        {
+                            return -1;
+                        }
+                        in += 6;
+                        codePoint = 0x10000 + ((codePoint - 0xd800) << 10) + (low - 0xdc00);
+                    }
+                    else if ((codePoint >= 0xdc00) && (codePoint <= 0xdfff))
+                    {
+                        return -1;
+                    }
+
+                    // encode as UTF-8, which is never longer than the escape sequence
+                    if (codePoint < 0x80)
+                    {
+                        out[length++] = codePoint;
+                    }
+                    else if (codePoint < 0x800)
+                    {
+                        out[length++] = 0xc0 | (codePoint >> 6);
+                        out[length++] = 0x80 | (codePoint & 0x3f);
+                    }
+                    else if (codePoint < 0x10000)
+                    {
+                        out[length++] = 0xe0 | (codePoint >> 12);
+                        out[length++] = 0x80 | ((codePoint >> 6) & 0x3f);
+                        out[length++] = 0x80 | (codePoint & 0x3f);
+                    }
+                    else
+                    {
+                        out[length++] = 0xf0 | (codePoint >> 18);
+                        out[length++] = 0x80 | ((codePoint >> 12) & 0x3f);
+                        out[length++] = 0x80 | ((codePoint >> 6) & 0x3f);
+                        out[length++] = 0x80 | (codePoint & 0x3f);
+                    }
+                }
+                break;
+            default:
+                return -1;
+        }
+    }
+    return length;
+}
+
+// Append the IDs in a path made of the concatenated parts, such as "/3/0/" and "1", to ids. Return the number of IDs, or -1 if the path is invalid
+static int JsonParsePath(const JsonValue * parts[], int numParts, int ids[], int count)
+{
+    int id = -1;    // -1 until a digit of the next ID is read
+    int i;
+    int j;
+
+    for (i = 0; i < numParts; i++)
+    {
+        if (parts[i]->Escaped)
+        {
+            return -1;
+        }
+
+        for (j = 0; j < parts[i]->Length; j++)
+        {
+            char c = parts[i]->Start[j];
+            if ((c >= '0') && (c <= '9'))
             {
-                Lwm2mTreeNode * objectNode = AddObjectNode(*dest, registry, objectID);
-                Lwm2mTreeNode * instanceNode = AddObjectInstanceNode(objectNode, registry, instanceID);
-                resourceNode = AddResourceNode(instanceNode, registry, objectID, resourceID);
+                id = ((id < 0) ? 0 : id * 10) + (c - '0');
+                if (id > LWM2M_MAX_ID)
+                {
+                    return -1;
+                }
             }
-            else if (Lwm2mTreeNode_GetType(*dest) == Lwm2mTreeNodeType_Object)
+            else if (c != '/')
             {
-                Lwm2mTreeNode * instanceNode = AddObjectInstanceNode(*dest, registry, instanceID);
-                resourceNode = AddResourceNode(instanceNode, registry, objectID, resourceID);
+                return -1;
             }
-            else if (Lwm2mTreeNode_GetType(*dest) == Lwm2mTreeNodeType_ObjectInstance)
+            else if (id >= 0)
             {
-                // lookup resource node, create if doesn't exist.
-                resourceNode = AddResourceNode(*dest, registry, objectID, resourceID);
+                if (count == JSON_MAX_PATH_IDS)
+                {
+                    return -1;
+                }
+                ids[count++] = id;
+                id = -1;
             }
-            else
+        }
+    }
+
+    if (id >= 0)
+    {
+        if (count == JSON_MAX_PATH_IDS)
+        {
+            return -1;
+        }
+        ids[count++] = id;
+    }
+    return count;
+}
+
+static bool JsonGetDataType(const JsonValue * key, JsonDataType * type)
+{
+    bool result = true;
+    if (JsonValueEquals(key, "sv"))
+    {
+        *type = JSON_TYPE_STRING;
+    }
+    else if (JsonValueEquals(key, "v"))
+    {
+        *type = JSON_TYPE_FLOAT;
+    }
+    else if (JsonValueEquals(key, "bv"))
+    {
+        *type = JSON_TYPE_BOOLEAN;
+    }
+    else if (JsonValueEquals(key, "ov"))
+    {
+        *type = JSON_TYPE_OBJECT_LINK;
+    }
+    else
+    {
+        result = false;
+    }
+    return result;
+}
+
+// Set the value of a resource instance node from the value of a JSON element
+static int JsonSetValue(Lwm2mTreeNode * node, const ResourceDefinition * definition, JsonDataType jsonDataType, const JsonValue * value, int64_t basetime)
+{
+    int result = -1;
+    char scratch[JSON_SCRATCH_SIZE];
+
+    if (value->Length > 0xffff)
+    {
+        Lwm2m_Error("ERROR: JSON - value too long\n");
+        return -1;
+    }
+
+    switch (definition->Type)
+    {
+        case AwaResourceType_Time:  // no break
+        case AwaResourceType_Integer:
             {
-                // Deserialise a single resource.
-                resourceNode = *dest;
+                int64_t temp = 0;
+                if ((jsonDataType == JSON_TYPE_FLOAT) && !value->Quoted && JsonParseInteger(value->Start, value->Length, &temp))
+                {
+                    if (definition->Type == AwaResourceType_Time)
+                    {
+                        // adjust time based on the basetime.
+                        temp -= basetime;
+                    }
+                    result = Lwm2mTreeNode_SetValue(node, (const uint8_t *)&temp, sizeof(temp));
+                }
             }
+            break;
 
-            // Data type, "sv", "v", "bv" etc
-            JsonDataType jsonDataType;
-            t = &tokens[t->next_sibling];
-            if (t->type != JSMN_STRING)
+        case AwaResourceType_Float:
             {
-                return -1;
+                double temp = 0;
+                if ((jsonDataType == JSON_TYPE_FLOAT) && !value->Quoted && JsonParseFloat(value->Start, value->Length, &temp))
+                {
+                    result = Lwm2mTreeNode_SetValue(node, (const uint8_t *)&temp, sizeof(temp));
+                }
             }
+            break;
 
-            if (JsonTokenStrcmp(buffer, t, "sv"))
+        case AwaResourceType_Boolean:
+            if (jsonDataType == JSON_TYPE_BOOLEAN)
             {
-                jsonDataType = JSON_TYPE_STRING;
+                // accept both the JSON literal and the quoted form the serialiser writes
+                bool temp = JsonValueEquals(value, "true");
+                if (temp || JsonValueEquals(value, "false"))
+                {
+                    result = Lwm2mTreeNode_SetValue(node, (const uint8_t *)&temp, sizeof(temp));
+                }
             }
-            else if (JsonTokenStrcmp(buffer, t, "v"))
+            break;
+
+        case AwaResourceType_Opaque:
+            if ((jsonDataType == JSON_TYPE_STRING) && value->Quoted)
             {
-                jsonDataType = JSON_TYPE_FLOAT;
+                // every 4 base64 encoded bytes are decoded to 3 bytes
+                int outLength = ((value->Length * 3) / 4) + 3;
+                char * decoded = (outLength <= (int)sizeof(scratch)) ? scratch : (char *)malloc(outLength);
+                if (decoded != NULL)
+                {
+                    int decodedLength = b64Decode(decoded, outLength, (char *)value->Start, value->Length);
+                    if (decodedLength >= 0)
+                    {
+                        result = Lwm2mTreeNode_SetValue(node, (const uint8_t *)decoded, decodedLength);
+                    }
+                    if (decoded != scratch)
+                    {
+                        free(decoded);
+                    }
+                }
             }
-            else if (JsonTokenStrcmp(buffer, t, "bv"))
+            break;
+
+        case AwaResourceType_String:
+            if ((jsonDataType == JSON_TYPE_STRING) && value->Quoted)
             {
-                jsonDataType = JSON_TYPE_BOOLEAN;
+                if (!value->Escaped)
+                {
+                    // Arena trees refer to strings in the input buffer rather than copying them
+                    result = Lwm2mTreeNode_SetValueReference(node, (const uint8_t *)value->Start, value->Length);
+                }
+                else
+                {
+                    char * unescaped = (value->Length <= (int)sizeof(scratch)) ? scratch : (char *)malloc(value->Length);
+                    if (unescaped != NULL)
+                    {
+                        int unescapedLength = JsonUnescape(value, unescaped);
+                        if (unescapedLength >= 0)
+                        {
+                            result = Lwm2mTreeNode_SetValue(node, (const uint8_t *)unescaped, unescapedLength);
+                        }
+                        if (unescaped != scratch)
+                        {
+                            free(unescaped);
+                        }
+                    }
+                }
             }
-            else if (JsonTokenStrcmp(buffer, t, "ov"))
+            break;
+
+        case AwaResourceType_ObjectLink:
+            // earlier versions wrote object links as string values
+            if (((jsonDataType == JSON_TYPE_OBJECT_LINK) || (jsonDataType == JSON_TYPE_STRING)) && value->Quoted)
             {
-                jsonDataType = JSON_TYPE_OBJECT_LINK;
+                const char * colon = (const char *)memchr(value->Start, ':', value->Length);
+                int64_t objectID;
+                int64_t objectInstanceID;
+
+                if ((colon != NULL) &&
+                    JsonParseInteger(value->Start, colon - value->Start, &objectID) &&
+                    JsonParseInteger(colon + 1, value->Start + value->Length - (colon + 1), &objectInstanceID) &&
+                    (objectID >= 0) && (objectID <= 0xffff) && (objectInstanceID >= 0) && (objectInstanceID <= 0xffff))
+                {
+                    AwaObjectLink objectLink = { (AwaObjectID)objectID, (AwaObjectInstanceID)objectInstanceID };
+                    result = Lwm2mTreeNode_SetValue(node, (const uint8_t *)&objectLink, sizeof(objectLink));
+                }
             }
-            else
+            break;
+
+        default:
+            break;
+    }
+
+    if (result < 0)
+    {
+        Lwm2m_Error("ERROR: JSON - invalid value for resource type %d\n", definition->Type);
+    }
+    return result;
+}
+
+// Create the node the payload is deserialised into
+static bool JsonCreateDestination(JsonDeserialiseState * state)
+{
+    int * ids = state->RequestIDs;
+
+    if (state->Basename.Start != NULL)
+    {
+        *state->Dest = Lwm2mTreeNode_CreateInArena(state->Arena);
+        Lwm2mTreeNode_SetType(*state->Dest, Lwm2mTreeNodeType_Root);
+    }
+    else if (ids[2] != -1)
+    {
+        *state->Dest = AddResourceNode(state->Arena, NULL, state->Registry, ids[0], ids[2]);
+    }
+    else if (ids[1] != -1)
+    {
+        *state->Dest = AddObjectInstanceNode(state->Arena, NULL, state->Registry, ids[1]);
+    }
+    else
+    {
+        *state->Dest = AddObjectNode(state->Arena, NULL, state->Registry, ids[0]);
+    }
+    return *state->Dest != NULL;
+}
+
+// Find the resource node an element refers to, creating any nodes missing on the way to it
+static Lwm2mTreeNode * JsonGetResourceNode(JsonDeserialiseState * state, const int ids[])
+{
+    Lwm2mTreeNode * dest = *state->Dest;
+    Lwm2mTreeNode * instanceNode = NULL;
+    Lwm2mTreeNode * resourceNode = NULL;
+
+    // elements for the same resource usually follow one another
+    if ((state->Resource != NULL) && (memcmp(state->ResourceIDs, ids, sizeof(state->ResourceIDs)) == 0))
+    {
+        return state->Resource;
+    }
+
+    switch (Lwm2mTreeNode_GetType(dest))
+    {
+        case Lwm2mTreeNodeType_Root:
             {
-                return -1;
+                Lwm2mTreeNode * objectNode = AddObjectNode(state->Arena, dest, state->Registry, ids[0]);
+                instanceNode = (objectNode != NULL) ? AddObjectInstanceNode(state->Arena, objectNode, state->Registry, ids[1]) : NULL;
             }
+            break;
+        case Lwm2mTreeNodeType_Object:
+            instanceNode = AddObjectInstanceNode(state->Arena, dest, state->Registry, ids[1]);
+            break;
+        case Lwm2mTreeNodeType_ObjectInstance:
+            instanceNode = dest;
+            break;
+        default:
+            // Deserialise a single resource.
+            resourceNode = dest;
+            break;
+    }
+
+    if (instanceNode != NULL)
+    {
+        if (instanceNode != state->Instance)
+        {
+            // a new instance has no resources yet, but one seen before could hold any
+            state->Instance = instanceNode;
+            state->MaxResourceID = (Lwm2mTreeNode_GetFirstChild(instanceNode) == NULL) ? -1 : LWM2M_MAX_ID;
+        }
 
-            // Process value
-            t = &tokens[t->first_child];
-            if ((t->type != JSMN_STRING) && (t->type != JSMN_PRIMITIVE))
+        if (ids[2] > state->MaxResourceID)
+        {
+            // resources are usually in ascending order, and a higher ID than any so far can't already have a node
+            resourceNode = AddResourceNode(state->Arena, NULL, state->Registry, ids[0], ids[2]);
+            if (resourceNode != NULL)
             {
-                return -1;
+                Lwm2mTreeNode_AddChild(instanceNode, resourceNode);
+                state->MaxResourceID = ids[2];
             }
-            char * value = JsonTokenToString(buffer, t);
+        }
+        else
+        {
+            resourceNode = AddResourceNode(state->Arena, instanceNode, state->Registry, ids[0], ids[2]);
+        }
+    }
+
+    state->Resource = resourceNode;
+    memcpy(state->ResourceIDs, ids, sizeof(state->ResourceIDs));
+    return resourceNode;
+}
 
-            resourceValueNode = Lwm2mTreeNode_Create();
-            Lwm2mTreeNode_SetID(resourceValueNode, resourceInstanceID);
-            Lwm2mTreeNode_SetType(resourceValueNode, Lwm2mTreeNodeType_ResourceInstance);
+// Read one element, {"n":"<name>","<type>":<value>}, and add it to the tree
+static bool JsonReadElement(JsonReader * reader, JsonDeserialiseState * state)
+{
+    JsonValue key;
+    JsonValue name = { 0 };
+    JsonValue value = { 0 };
+    JsonDataType jsonDataType = JSON_TYPE_FLOAT;
+    bool haveValue = false;
 
-            int resourceType = Definition_GetResourceType(registry, objectID, resourceID);
-            switch (resourceType)
+    if (!JsonConsume(reader, '{'))
+    {
+        return false;
+    }
+
+    if (!JsonConsume(reader, '}'))
+    {
+        do
+        {
+            if (!JsonReadKey(reader, &key))
             {
-                case AwaResourceType_Time:
-                    if (jsonDataType == JSON_TYPE_FLOAT)
-                    {
-                        int64_t temp = 0;
-                        result = sscanf((char *)value, "%24" SCNu64, &temp);
-                        if (result > 0)
-                        {
-                            // adjust time based on the basetime.
-                            temp -= basetime;
-                            result = Lwm2mTreeNode_SetValue(resourceValueNode, (const uint8_t *)&temp, sizeof(temp));
-                        }
-                    }
-                    else
-                    {
-                        Lwm2mTreeNode_DeleteRecursive(resourceValueNode);
-                        return -1;
-                    }
-                    break;
+                return false;
+            }
 
-                case AwaResourceType_Float:  // no break
-                case AwaResourceType_Integer:
+            if (JsonValueEquals(&key, "n"))
+            {
+                if (!JsonReadValue(reader, &name) || !name.Quoted)
+                {
+                    return false;
+                }
+            }
+            else if (JsonGetDataType(&key, &jsonDataType))
+            {
+                if (haveValue || !JsonReadValue(reader, &value))
+                {
+                    return false;
+                }
+                haveValue = true;
+            }
+            else if (!JsonSkipValue(reader, 1))
+            {
+                return false;
+            }
+        }
+        while (JsonConsume(reader, ','));
 
-                    if (jsonDataType != JSON_TYPE_FLOAT)
-                    {
-                        Lwm2mTreeNode_DeleteRecursive(resourceValueNode);
-                        return -1;
-                    }
+        if (!JsonConsume(reader, '}'))
+        {
+            return false;
+        }
+    }
 
-                    if (resourceType == AwaResourceType_Float)
-                    {
-                        double temp = 0;
-                        result = sscanf((char *)value, "%24lf", &temp);
-                        if (result > 0)
-                        {
-                            result = Lwm2mTreeNode_SetValue(resourceValueNode, (const uint8_t *)&temp, sizeof(temp));
-                        }
-                    }
-                    else
-                    {
-                        int64_t temp = 0;
-                        result = sscanf((char *)value, "%24" SCNu64, &temp);
-                        if (result > 0)
-                        {
-                            result = Lwm2mTreeNode_SetValue(resourceValueNode, (const uint8_t *)&temp, sizeof(temp));
-                        }
-                    }
-                    break;
+    if (!haveValue)
+    {
+        return false;
+    }
 
-                case AwaResourceType_Boolean:
-                    if (jsonDataType == JSON_TYPE_BOOLEAN)
-                    {
-                        int64_t temp = (strcmp(value, "true")) ? 1: 0;
-                        result = Lwm2mTreeNode_SetValue(resourceValueNode, (const uint8_t *)&temp, sizeof(temp));
-                    }
-                    else
-                    {
-                        Lwm2mTreeNode_DeleteRecursive(resourceValueNode);
-                        return -1;
-                    }
-                    break;
+    // the name is relative to the base name, or to the request path if there is none
+    int ids[JSON_MAX_PATH_IDS] = { 0 };
+    int count = 0;
+    if (state->Basename.Start != NULL)
+    {
+        const JsonValue * parts[] = { &state->Basename, &name };
+        count = JsonParsePath(parts, 2, ids, 0);
+    }
+    else
+    {
+        const JsonValue * parts[] = { &name };
+        while ((count < 3) && (state->RequestIDs[count] != -1))
+        {
+            ids[count] = state->RequestIDs[count];
+            count++;
+        }
+        count = JsonParsePath(parts, 1, ids, count);
+    }
 
-                case AwaResourceType_Opaque:
-                    {
-                        if (jsonDataType != JSON_TYPE_STRING)
-                        {
-                            Lwm2mTreeNode_DeleteRecursive(resourceValueNode);
-                            return -1;
-                        }
+    if (count < 3)
+    {
+        Lwm2m_Error("ERROR: JSON - invalid resource name\n");
+        return false;
+    }
 
-                        int outLength = ((strlen(value) * 3) / 4);  // every 4 base encoded bytes are decoded to 3 bytes,
-                        char * decodedValue = (char *)malloc(outLength);
-                        if (decodedValue == NULL)
-                        {
-                            Lwm2mTreeNode_DeleteRecursive(resourceValueNode);
-                            return -1;
-                        }
-                        int decodedLength = b64Decode(decodedValue, outLength, value, strlen(value));
-                        if (decodedLength >= 0)
-                        {
-                            result = Lwm2mTreeNode_SetValue(resourceValueNode, (const uint8_t *)decodedValue, decodedLength);
-                        }
-                        else
-                        {
-                            result = -1;
-                        }
-                        free(decodedValue);
-                    }
-                    break;
+    Lwm2mTreeNode * resourceNode = JsonGetResourceNode(state, ids);
+    ResourceDefinition * definition = (ResourceDefinition *)Lwm2mTreeNode_GetDefinition(resourceNode);
+    if (definition == NULL)
+    {
+        return false;
+    }
 
-                case AwaResourceType_String:
-                    if (jsonDataType != JSON_TYPE_STRING)
-                    {
-                        Lwm2mTreeNode_DeleteRecursive(resourceValueNode);
-                        return -1;
-                    }
+    Lwm2mTreeNode * resourceValueNode = Lwm2mTreeNode_CreateInArena(state->Arena);
+    Lwm2mTreeNode_SetID(resourceValueNode, ids[3]);
+    Lwm2mTreeNode_SetType(resourceValueNode, Lwm2mTreeNodeType_ResourceInstance);
 
-                    result = Lwm2mTreeNode_SetValue(resourceValueNode, (const uint8_t *)&value[0], strlen(value) + 1);
-                    break;
+    if (JsonSetValue(resourceValueNode, definition, jsonDataType, &value, state->Basetime) < 0)
+    {
+        Lwm2mTreeNode_DeleteRecursive(resourceValueNode);
+        return false;
+    }
 
-                case AwaResourceType_ObjectLink:
-                    {
-                        if (jsonDataType != JSON_TYPE_OBJECT_LINK)
-                        {
-                            Lwm2mTreeNode_DeleteRecursive(resourceValueNode);
-                            return -1;
-                        }
+    Lwm2mTreeNode_AddChild(resourceNode, resourceValueNode);
+    return true;
+}
 
-                        AwaObjectLink objectLink;
-                        result = sscanf(value, "%10d:%10d", &objectLink.ObjectID, &objectLink.ObjectInstanceID);
-                        if (result > 0)
-                        {
-                            result = Lwm2mTreeNode_SetValue(resourceValueNode, (const uint8_t *)&objectLink, sizeof(objectLink));
-                        }
-                    }
-                    break;
+// Read the array of elements, adding each to the tree as it is read
+static bool JsonReadElements(JsonReader * reader, JsonDeserialiseState * state)
+{
+    if (!JsonConsume(reader, '[') || JsonConsume(reader, ']'))
+    {
+        return false;
+    }
 
-                default:
-                    break;
+    if ((*state->Dest == NULL) && !JsonCreateDestination(state))
+    {
+        return false;
+    }
+
+    do
+    {
+        if (!JsonReadElement(reader, state))
+        {
+            return false;
+        }
+    }
+    while (JsonConsume(reader, ','));
+
+    return JsonConsume(reader, ']');
+}
+
+// Deserialise in a single pass over the payload. Names and values are used where they lie in the buffer,
+// so the base name and base time must precede the elements that use them, as they do in every encoder's output.
+static int JsonDeserialise(Lwm2mTreeNode ** dest, Lwm2mTreeArena * arena, const DefinitionRegistry * registry, ObjectIDType objectID,
+                           ObjectInstanceIDType instanceID, ResourceIDType resourceID, const uint8_t * buf, int bufferLen)
+{
+    JsonReader reader = { (const char *)buf, bufferLen, 0 };
+    JsonDeserialiseState state = { dest, arena, registry, { objectID, instanceID, resourceID, -1 } };
+    bool elementsRead = false;
+    bool valid = (buf != NULL) && JsonConsume(&reader, '{');
+    JsonValue key;
+
+    *dest = NULL;
+
+    if (valid && !JsonConsume(&reader, '}'))
+    {
+        do
+        {
+            valid = JsonReadKey(&reader, &key);
+            if (!valid)
+            {
+                break;
             }
 
-            if (result >= 0)
+            if (JsonValueEquals(&key, "bn"))
+            {
+                valid = !elementsRead && JsonReadValue(&reader, &state.Basename) && state.Basename.Quoted;
+            }
+            else if (JsonValueEquals(&key, "bt"))
+            {
+                JsonValue basetime;
+                valid = !elementsRead && JsonReadValue(&reader, &basetime) && !basetime.Quoted &&
+                        JsonParseInteger(basetime.Start, basetime.Length, &state.Basetime);
+            }
+            else if (JsonValueEquals(&key, "e"))
             {
-                Lwm2mTreeNode_AddChild(resourceNode, resourceValueNode);
+                valid = !elementsRead && JsonReadElements(&reader, &state);
+                elementsRead = true;
             }
             else
             {
-                Lwm2mTreeNode_DeleteRecursive(resourceValueNode);
+                valid = JsonSkipValue(&reader, 1);
             }
+        }
+        while (valid && JsonConsume(&reader, ','));
 
-        } while((index = tokens[index].next_sibling) != -1);
-    } // "e"
+        valid = valid && JsonConsume(&reader, '}');
+    }
 
-    return result;
+    JsonSkipWhitespace(&reader);
+    if (!valid || (reader.Position != reader.Length))
+    {
+        Lwm2m_Error("ERROR: deserialising JSON, malformed!\n");
+        return -1;
+    }
+
+    if ((*dest == NULL) && !JsonCreateDestination(&state))
+    {
+        return -1;
+    }
+    return bufferLen;
 }
 
-static int JsonDeserialiseResource(SerdesContext * serdesContext, Lwm2mTreeNode ** dest, const DefinitionRegistry * registry, ObjectIDType objectID,
+static int JsonDeserialiseResource(SerdesContext * serdesContext, Lwm2mTreeNode ** dest, Lwm2mTreeArena * arena, const DefinitionRegistry * registry, ObjectIDType objectID,
                                    ObjectInstanceIDType instanceID, ResourceIDType resourceID, const uint8_t * buf, int bufferLen)
 {
-    return JsonDeserialise(dest, registry, objectID, instanceID, resourceID, buf, bufferLen);
+    return JsonDeserialise(dest, arena, registry, objectID, instanceID, resourceID, buf, bufferLen);
 }
 
-static int JsonDeserialiseObjectInstance(SerdesContext * serdesContext, Lwm2mTreeNode ** dest, const DefinitionRegistry * registry,
+static int JsonDeserialiseObjectInstance(SerdesContext * serdesContext, Lwm2mTreeNode ** dest, Lwm2mTreeArena * arena, const DefinitionRegistry * registry,
                                          ObjectIDType objectID, ObjectInstanceIDType instanceID, const uint8_t * buf, int bufferLen)
 {
-    return JsonDeserialise(dest, registry, objectID, instanceID, -1, buf, bufferLen);
+    return JsonDeserialise(dest, arena, registry, objectID, instanceID, -1, buf, bufferLen);
 }
 
-static int JsonDeserialiseObject(SerdesContext * serdesContext, Lwm2mTreeNode ** dest, const DefinitionRegistry * registry,
+static int JsonDeserialiseObject(SerdesContext * serdesContext, Lwm2mTreeNode ** dest, Lwm2mTreeArena * arena, const DefinitionRegistry * registry,
                                  ObjectIDType objectID, const uint8_t * buf, int bufferLen)
 {
-    return JsonDeserialise(dest, registry, objectID, -1, -1, buf, bufferLen);
+    return JsonDeserialise(dest, arena, registry, objectID, -1, -1, buf, bufferLen);
 }
 
 // Map JSON serdes function delegates
@@ -942,4 +1550,7 @@ const SerialiserDeserialiser jsonSerDes =
     .DeserialiseObject         = JsonDeserialiseObject,
     .DeserialiseObjectInstance = JsonDeserialiseObjectInstance,
     .DeserialiseResource       = JsonDeserialiseResource,
+    .StreamObject              = JsonStreamObject,
+    .StreamObjectInstance      = JsonStreamObjectInstance,
+    .StreamResource            = JsonStreamResource,
 };
@@ -23,20 +23,15 @@
 
 #include "lwm2m_list.h"
 
+// Add to the tail of the list. Prev of the head always points at the tail, so this is O(1).
 void ListAdd(struct ListHead * newEntry, struct ListHead * head)
 {
-    struct ListHead * pos;
-    struct ListHead * next = head;
-
-    ListForEach(pos, head)
-    {
-        next = pos;
-    }
+    struct ListHead * tail = head->Prev;
 
-    //next->Prev     = newEntry;
     newEntry->Next = head;
-    newEntry->Prev = next;
-    next->Next     = newEntry;
+    newEntry->Prev = tail;
+    tail->Next     = newEntry;
+    head->Prev     = newEntry;
 }
 
 void ListRemove(struct ListHead * entry)
@@ -32,67 +32,92 @@
 #include "lwm2m_limits.h"
 #include "lwm2m_object_store.h"
 #include "lwm2m_list.h"
+#include "lwm2m_hash.h"
 #include "lwm2m_debug.h"
 #include "lwm2m_util.h"
 #include "lwm2m_result.h"
 
+// Every node is indexed in the store's hash table by its parent node and its ID, so a path is found
+// with one hash lookup per level. The per-level lists keep nodes in creation order for the GetNext functions.
+typedef struct
+{
+    HashEntry Index;
+    const void * Parent;               // Containing node, or NULL for an object
+    int ID;
+} NodeKey;
+
 typedef struct
 {
     struct ListHead list;             // prev/next pointers
+    NodeKey Key;
 
     void * Value;
     int Size;
-    int ID;
 } ResourceInstance;
 
 typedef struct
 {
     struct ListHead list;             // prev/next pointers
+    NodeKey Key;
     struct ListHead Instance;
-    int ID;
+    int NumInstances;
 } Resource;
 
 typedef struct
 {
     struct ListHead list;              // prev/next pointers
+    NodeKey Key;                       // Instance ID
     struct ListHead Resource;
-    int ID;                            // Instance ID
+    int NumResources;
 } ObjectInstance;
 
 typedef struct
 {
     struct ListHead list;              // prev/next pointers
+    NodeKey Key;
     struct ListHead Instance;          // Linked list of object instances
-    int ID;
+    int NumInstances;
 } Object;
 
-static Object * LookupObject(const ObjectStore * store, ObjectIDType objectID)
+static uint32_t HashNodeKey(const void * parent, int id)
+{
+    uintptr_t key[] = { (uintptr_t)parent, (uintptr_t)id };
+    return Hash_Bytes(key, sizeof(key));
+}
+
+static NodeKey * LookupNode(const ObjectStore * store, const void * parent, int id)
 {
+    uint32_t hash = HashNodeKey(parent, id);
     struct ListHead * i;
-    ListForEach(i, &store->objectList)
+    ListForEach(i, HashTable_GetBucket(&store->Index, hash))
     {
-        Object * object = ListEntry(i, Object, list);
-        if (object->ID == objectID)
+        HashEntry * entry = ListEntry(i, HashEntry, list);
+        NodeKey * key = ListEntry(entry, NodeKey, Index);
+        if ((entry->Hash == hash) && (key->Parent == parent) && (key->ID == id))
         {
-            return object;
+            return key;
         }
     }
     return NULL;
 }
 
-static ObjectInstance * GetObjectInstance(Object * object, ObjectInstanceIDType objectInstanceID)
+static void AddNode(ObjectStore * store, NodeKey * key, const void * parent, int id)
 {
-    struct ListHead * i;
-    ListForEach(i, &object->Instance)
-    {
-        ObjectInstance * instance = ListEntry(i, ObjectInstance, list);
-        if (instance->ID == objectInstanceID)
-        {
-            return instance;
-        }
-    }
+    key->Parent = parent;
+    key->ID = id;
+    HashTable_Add(&store->Index, &key->Index, HashNodeKey(parent, id));
+}
 
-    return NULL;
+static Object * LookupObject(const ObjectStore * store, ObjectIDType objectID)
+{
+    NodeKey * key = LookupNode(store, NULL, objectID);
+    return (key != NULL) ? ListEntry(key, Object, Key) : NULL;
+}
+
+static ObjectInstance * GetObjectInstance(const ObjectStore * store, Object * object, ObjectInstanceIDType objectInstanceID)
+{
+    NodeKey * key = LookupNode(store, object, objectInstanceID);
+    return (key != NULL) ? ListEntry(key, ObjectInstance, Key) : NULL;
 }
 
 static ObjectInstance * LookupObjectInstance(const ObjectStore * store, ObjectIDType objectID, ObjectInstanceIDType objectInstanceID)
@@ -100,24 +125,16 @@ static ObjectInstance * LookupObjectInstance(const ObjectStore * store, ObjectID
     Object * object = LookupObject(store, objectID);
     if (object != NULL)
     {
-        return GetObjectInstance(object, objectInstanceID);
+        return GetObjectInstance(store, object, objectInstanceID);
     }
     return NULL;
 }
 
 // Retrieve a pointer to a Resource from an Object instance
-static Resource * GetResource(ObjectInstance * instance, ResourceIDType resourceID)
+static Resource * GetResource(const ObjectStore * store, ObjectInstance * instance, ResourceIDType resourceID)
 {
-    struct ListHead * i;
-    ListForEach(i, &instance->Resource)
-    {
-        Resource * resource = ListEntry(i, Resource, list);
-        if (resource->ID == resourceID)
-        {
-            return resource;
-        }
-    }
-    return NULL;
+    NodeKey * key = LookupNode(store, instance, resourceID);
+    return (key != NULL) ? ListEntry(key, Resource, Key) : NULL;
 }
 
 static Resource * LookupResource(const ObjectStore * store, ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID)
@@ -125,14 +142,14 @@ static Resource * LookupResource(const ObjectStore * store, ObjectIDType objectI
     ObjectInstance * instance = LookupObjectInstance(store, objectID, objectInstanceID);
     if (instance != NULL)
     {
-        return GetResource(instance, resourceID);
+        return GetResource(store, instance, resourceID);
     }
     return NULL;
 }
 
-static Resource * CreateResource(const ObjectStore * store, ObjectInstance * instance, ObjectIDType objectID, ResourceIDType resourceID)
+static Resource * CreateResource(ObjectStore * store, ObjectInstance * instance, ObjectIDType objectID, ResourceIDType resourceID)
 {
-    Resource * resource = GetResource(instance, resourceID);
+    Resource * resource = GetResource(store, instance, resourceID);
     if (resource)
     {
         // already exists
@@ -148,30 +165,28 @@ static Resource * CreateResource(const ObjectStore * store, ObjectInstance * ins
         return NULL;
     }
 
-    resource->ID = resourceID;
+    AddNode(store, &resource->Key, instance, resourceID);
     ListInit(&resource->Instance);
+    resource->NumInstances = 0;
 
     // Add to instance.
     ListAdd(&resource->list, &instance->Resource);
+    instance->NumResources++;
 
     AwaResult_SetResult(AwaResult_Success);
     return resource;
 }
 
-static ResourceInstance * GetResourceInstance(Resource * resource, ResourceInstanceIDType resourceInstanceID)
+static ResourceInstance * GetResourceInstance(const ObjectStore * store, Resource * resource, ResourceInstanceIDType resourceInstanceID)
 {
-    int count = 0;
-    struct ListHead * i;
-    ListForEach(i, &resource->Instance)
-    {
-        ResourceInstance * resource = ListEntry(i, ResourceInstance, list);
-        if (resource->ID == resourceInstanceID)
-        {
-            return resource;
-        }
-        count++;
-    }
-    return NULL;
+    NodeKey * key = LookupNode(store, resource, resourceInstanceID);
+    return (key != NULL) ? ListEntry(key, ResourceInstance, Key) : NULL;
+}
+
+// Return the entry after current in a list of siblings, where current may be the list head. Returns NULL at the end of the list.
+static struct ListHead * GetNextSibling(const struct ListHead * siblings, const struct ListHead * current)
+{
+    return ((current != NULL) && (current->Next != siblings)) ? current->Next : NULL;
 }
 
 ResourceIDType ObjectStore_GetNextResourceID(ObjectStore * store, ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID)
@@ -179,21 +194,12 @@ ResourceIDType ObjectStore_GetNextResourceID(ObjectStore * store, ObjectIDType o
     ObjectInstance * instance = LookupObjectInstance(store, objectID, objectInstanceID);
     if (instance != NULL)
     {
-        bool found = (resourceID == -1) ? true : false;
-        struct ListHead * i;
-        ListForEach(i, &instance->Resource)
+        Resource * current = (resourceID == -1) ? NULL : GetResource(store, instance, resourceID);
+        struct ListHead * next = GetNextSibling(&instance->Resource, (resourceID == -1) ? &instance->Resource : (current != NULL) ? &current->list : NULL);
+        if (next != NULL)
         {
-            Resource * resource = ListEntry(i, Resource, list);
-            if (found)
-            {
-                AwaResult_SetResult(AwaResult_Success);
-                return resource->ID;
-            }
-
-            if (resource->ID == resourceID)
-            {
-                found = true;
-            }
+            AwaResult_SetResult(AwaResult_Success);
+            return ListEntry(next, Resource, list)->Key.ID;
         }
     }
     AwaResult_SetResult(AwaResult_NotFound);
@@ -217,8 +223,9 @@ Object * CreateObject(ObjectStore * store, ObjectIDType objectID)
         return NULL;
     }
 
-    object->ID = objectID;
+    AddNode(store, &object->Key, NULL, objectID);
     ListInit(&object->Instance);
+    object->NumInstances = 0;
 
     ListAdd(&object->list, &store->objectList);
 
@@ -228,7 +235,7 @@ Object * CreateObject(ObjectStore * store, ObjectIDType objectID)
 
 static ObjectInstance * CreateObjectInstance(ObjectStore * store, Object * object, ObjectInstanceIDType objectInstanceID)
 {
-    ObjectInstance * instance = GetObjectInstance(object, objectInstanceID);
+    ObjectInstance * instance = GetObjectInstance(store, object, objectInstanceID);
     if (instance != NULL)
     {
         AwaResult_SetResult(AwaResult_AlreadyCreated);
@@ -243,59 +250,76 @@ static ObjectInstance * CreateObjectInstance(ObjectStore * store, Object * objec
         return NULL;
     }
 
-    instance->ID = objectInstanceID;
+    AddNode(store, &instance->Key, object, objectInstanceID);
     ListInit(&instance->Resource);
+    instance->NumResources = 0;
 
     // Add instance to object
     ListAdd(&instance->list, &object->Instance);
+    object->NumInstances++;
 
-    Lwm2m_Debug("CreateObjectInstance %d %d\n", object->ID, objectInstanceID);
+    Lwm2m_Debug("CreateObjectInstance %d %d\n", object->Key.ID, objectInstanceID);
 
     AwaResult_SetResult(AwaResult_Success);
     return instance;
 }
 
-static int DeleteResource(ObjectStore * store, ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID)
+static void FreeResource(ObjectStore * store, ObjectInstance * instance, Resource * resource)
 {
-    Resource * resource = LookupResource(store, objectID, objectInstanceID, resourceID);
-
-    if (resource == NULL)
-    {
-        return -1;
-    }
-
     struct ListHead * pos, *n;
     ListForEachSafe(pos, n, &resource->Instance)
     {
         ResourceInstance * rInst = ListEntry(pos, ResourceInstance, list);
         free(rInst->Value);
         ListRemove(pos);
+        HashTable_Remove(&store->Index, &rInst->Key.Index);
         free(rInst);
     }
     ListRemove(&resource->list);
+    HashTable_Remove(&store->Index, &resource->Key.Index);
+    instance->NumResources--;
     free(resource);
+}
 
-    return 0;
+static void FreeInstance(ObjectStore * store, Object * object, ObjectInstance * instance)
+{
+    struct ListHead * pos, *n;
+    ListForEachSafe(pos, n, &instance->Resource)
+    {
+        Resource * resource = ListEntry(pos, Resource, list);
+        FreeResource(store, instance, resource);
+    }
+    ListRemove(&instance->list);
+    HashTable_Remove(&store->Index, &instance->Key.Index);
+    object->NumInstances--;
+    free(instance);
 }
 
-static int DeleteInstance(ObjectStore * store, ObjectIDType objectID, ObjectInstanceIDType objectInstanceID)
+static int DeleteResource(ObjectStore * store, ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID)
 {
     ObjectInstance * instance = LookupObjectInstance(store, objectID, objectInstanceID);
+    Resource * resource = (instance != NULL) ? GetResource(store, instance, resourceID) : NULL;
 
-    if (instance == NULL)
+    if (resource == NULL)
     {
         return -1;
     }
 
-    struct ListHead * pos, *n;
-    ListForEachSafe(pos, n, &instance->Resource)
+    FreeResource(store, instance, resource);
+    return 0;
+}
+
+static int DeleteInstance(ObjectStore * store, ObjectIDType objectID, ObjectInstanceIDType objectInstanceID)
+{
+    Object * object = LookupObject(store, objectID);
+    ObjectInstance * instance = (object != NULL) ? GetObjectInstance(store, object, objectInstanceID) : NULL;
+
+    if (instance == NULL)
     {
-        Resource * resource = ListEntry(pos, Resource, list);
-        DeleteResource(store, objectID, objectInstanceID, resource->ID);
+        return -1;
     }
-    ListRemove(&instance->list);
-    free(instance);
 
+    FreeInstance(store, object, instance);
     return 0;
 }
 
@@ -312,7 +336,7 @@ static int DeleteObjectInstances(ObjectStore * store, ObjectIDType objectID)
     ListForEachSafe(pos, n, &object->Instance)
     {
         ObjectInstance * instance = ListEntry(pos, ObjectInstance, list);
-        DeleteInstance(store, objectID, instance->ID);
+        FreeInstance(store, object, instance);
     }
     return 0;
 }
@@ -324,7 +348,7 @@ int ObjectStore_GetResourceInstanceLength(ObjectStore * store, ObjectIDType obje
     Resource * resource = LookupResource(store, objectID, objectInstanceID, resourceID);
     if (resource != NULL)
     {
-        ResourceInstance * instance = GetResourceInstance(resource, resourceInstanceID);
+        ResourceInstance * instance = GetResourceInstance(store, resource, resourceInstanceID);
         if (instance != NULL)
         {
             result = instance->Size;
@@ -339,7 +363,7 @@ int ObjectStore_GetResourceInstanceValue(ObjectStore * store, ObjectIDType objec
     Resource * resource = LookupResource(store, objectID, objectInstanceID, resourceID);
     if (resource != NULL)
     {
-        ResourceInstance * instance = GetResourceInstance(resource, resourceInstanceID);
+        ResourceInstance * instance = GetResourceInstance(store, resource, resourceInstanceID);
         if (instance == NULL)
         {
             AwaResult_SetResult(AwaResult_NotFound);
@@ -379,14 +403,14 @@ int ObjectStore_SetResourceInstanceValue(ObjectStore * store, ObjectIDType objec
         return -1;
     }
 
-    inst = LookupObjectInstance(store, objectID, objectInstanceID);
+    inst = GetObjectInstance(store, obj, objectInstanceID);
     if (inst == NULL)
     {
         Lwm2m_Error("Failed to lookup object %d instance %d\n", objectID, objectInstanceID);
         return -1;
     }
 
-    r = LookupResource(store, objectID, objectInstanceID, resourceID);
+    r = GetResource(store, inst, resourceID);
     if (r == NULL)
     {
         Lwm2m_Error("Failed to lookup object %d instance %d resource %d\n", objectID, objectInstanceID, resourceID);
@@ -394,7 +418,7 @@ int ObjectStore_SetResourceInstanceValue(ObjectStore * store, ObjectIDType objec
     }
 
     // create a new resource instance, or resize the existing one.
-    rInst = GetResourceInstance(r, resourceInstanceID);
+    rInst = GetResourceInstance(store, r, resourceInstanceID);
     if (rInst == NULL)
     {
         rInst = (ResourceInstance*)malloc(sizeof(ResourceInstance));
@@ -405,8 +429,6 @@ int ObjectStore_SetResourceInstanceValue(ObjectStore * store, ObjectIDType objec
             return -1;
         }
 
-        rInst->ID = resourceInstanceID;
-
         rInst->Value = malloc(valueSize);
 
         if (rInst->Value == NULL)
@@ -421,7 +443,9 @@ int ObjectStore_SetResourceInstanceValue(ObjectStore * store, ObjectIDType objec
 
         rInst->Size = valueSize;
 
+        AddNode(store, &rInst->Key, r, resourceInstanceID);
         ListAdd(&rInst->list, &r->Instance);
+        r->NumInstances++;
     }
     else
     {
@@ -472,6 +496,12 @@ ObjectStore * ObjectStore_Create(void)
     memset(store, 0, sizeof(ObjectStore));
 
     ListInit(&store->objectList);
+    if (HashTable_Init(&store->Index, HASH_TABLE_DEFAULT_BUCKETS) != 0)
+    {
+        free(store);
+        AwaResult_SetResult(AwaResult_OutOfMemory);
+        return NULL;
+    }
 
     AwaResult_SetResult(AwaResult_Success);
     return store;
@@ -551,6 +581,7 @@ void ObjectStore_Destroy(ObjectStore * store)
     {
         // loop through all objects and free them
         DestroyObjectList(&store->objectList);
+        HashTable_Destroy(&store->Index);
         free(store);
     }
 }
@@ -560,7 +591,7 @@ int ObjectStore_GetObjectNumInstances(ObjectStore * store, ObjectIDType objectID
     Object * object = LookupObject(store, objectID);
     if (object != NULL)
     {
-        return ListCount(&object->Instance);
+        return object->NumInstances;
     }
     return 0;
 }
@@ -570,7 +601,7 @@ int ObjectStore_GetInstanceNumResources(ObjectStore * store, ObjectIDType object
     ObjectInstance * instance = LookupObjectInstance(store, objectID, objectInstanceID);
     if (instance != NULL)
     {
-        return ListCount(&instance->Resource);
+        return instance->NumResources;
     }
     return 0;
 }
@@ -580,7 +611,7 @@ int ObjectStore_GetResourceNumInstances(ObjectStore * store, ObjectIDType object
     Resource * resource = LookupResource(store, objectID, objectInstanceID, resourceID);
     if (resource != NULL)
     {
-        return ListCount(&resource->Instance);
+        return resource->NumInstances;
     }
     return 0;
 }
@@ -610,21 +641,12 @@ ObjectInstanceIDType ObjectStore_GetNextObjectInstanceID(ObjectStore * store, Ob
     Object * object = LookupObject(store, objectID);
     if (object != NULL)
     {
-        bool found = (objectInstanceID == -1);
-        struct ListHead * i;
-        ListForEach(i, &object->Instance)
+        ObjectInstance * current = (objectInstanceID == -1) ? NULL : GetObjectInstance(store, object, objectInstanceID);
+        struct ListHead * next = GetNextSibling(&object->Instance, (objectInstanceID == -1) ? &object->Instance : (current != NULL) ? &current->list : NULL);
+        if (next != NULL)
         {
-            ObjectInstance * instance = ListEntry(i, ObjectInstance, list);
-            if (found)
-            {
-                AwaResult_SetResult(AwaResult_Success);
-                return instance->ID;
-            }
-
-            if (instance->ID == objectInstanceID)
-            {
-                found = true;
-            }
+            AwaResult_SetResult(AwaResult_Success);
+            return ListEntry(next, ObjectInstance, list)->Key.ID;
         }
     }
     AwaResult_SetResult(AwaResult_NotFound);
@@ -637,21 +659,12 @@ ResourceInstanceIDType ObjectStore_GetNextResourceInstanceID(ObjectStore * store
     Resource * resource = LookupResource(store, objectID, objectInstanceID, resourceID);
     if (resource != NULL)
     {
-        bool found = (resourceInstanceID == -1);
-        struct ListHead * i;
-        ListForEach(i, &resource->Instance)
+        ResourceInstance * current = (resourceInstanceID == -1) ? NULL : GetResourceInstance(store, resource, resourceInstanceID);
+        struct ListHead * next = GetNextSibling(&resource->Instance, (resourceInstanceID == -1) ? &resource->Instance : (current != NULL) ? &current->list : NULL);
+        if (next != NULL)
         {
-            ResourceInstance * instance = ListEntry(i, ResourceInstance, list);
-            if (found)
-            {
-                AwaResult_SetResult(AwaResult_Success);
-                return instance->ID;
-            }
-
-            if (instance->ID == resourceInstanceID)
-            {
-                found = true;
-            }
+            AwaResult_SetResult(AwaResult_Success);
+            return ListEntry(next, ResourceInstance, list)->Key.ID;
         }
     }
     AwaResult_SetResult(AwaResult_NotFound);
@@ -688,8 +701,8 @@ ResourceIDType ObjectStore_CreateResource(ObjectStore * store, ObjectIDType obje
     Resource * resource = CreateResource(store, instance, objectID, resourceID);
     if (resource != NULL)
     {
-        Lwm2m_Debug("Created new resource ID: %d for object %d instance %d\n", resource->ID, objectID, objectInstanceID);
-        return resource->ID;
+        Lwm2m_Debug("Created new resource ID: %d for object %d instance %d\n", resource->Key.ID, objectID, objectInstanceID);
+        return resource->Key.ID;
     }
 error:
     return -1;
@@ -29,6 +29,7 @@
 
 #include "lwm2m_types.h"
 #include "lwm2m_list.h"
+#include "lwm2m_hash.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -37,6 +38,7 @@ extern "C" {
 typedef struct
 {
     struct ListHead objectList;
+    HashTable Index;                   // Objects, object instances, resources and resource instances, keyed on parent and ID
 } ObjectStore;
 
 ObjectStore * ObjectStore_Create(void);
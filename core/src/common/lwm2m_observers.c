@@ -41,17 +41,30 @@
 #include "lwm2m_security_object.h"
 #include "lwm2m_server_object.h"
 
+static uint32_t HashObserverPath(ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID)
+{
+    int32_t path[] = { objectID, objectInstanceID, resourceID };
+    return Hash_Bytes(path, sizeof(path));
+}
+
+static bool ObserverHasPath(const Lwm2mObserverType * observer, ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID)
+{
+    return (observer->ObjectID == objectID) &&
+           (observer->ObjectInstanceID == objectInstanceID) &&
+           (observer->ResourceID == resourceID);
+}
+
 static Lwm2mObserverType * LookupObserver(void * ctxt, AddressType * addr, ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID)
 {
     Lwm2mContextType * context = (Lwm2mContextType *) ctxt;
-    struct ListHead * i, *n;
-    ListForEachSafe(i, n, Lwm2mCore_GetObserverList(context))
+    uint32_t hash = HashObserverPath(objectID, objectInstanceID, resourceID);
+    struct ListHead * i;
+    ListForEach(i, HashTable_GetBucket(Lwm2mCore_GetObserverIndex(context), hash))
     {
-        Lwm2mObserverType * observer = ListEntry(i, Lwm2mObserverType, list);
+        HashEntry * entry = ListEntry(i, HashEntry, list);
+        Lwm2mObserverType * observer = ListEntry(entry, Lwm2mObserverType, PathIndex);
 
-        if ((observer->ObjectID == objectID) &&
-            (observer->ObjectInstanceID == objectInstanceID) &&
-            (observer->ResourceID == resourceID) &&
+        if ((entry->Hash == hash) && ObserverHasPath(observer, objectID, objectInstanceID, resourceID) &&
             (memcmp(&observer->Address, addr, sizeof(AddressType)) == 0))
         {
             return observer;
@@ -60,190 +73,249 @@ static Lwm2mObserverType * LookupObserver(void * ctxt, AddressType * addr, Objec
     return NULL;
 }
 
-static bool NotificationAttributesValid(AttributeTypeEnum attributeType, NotificationAttributes * attributes)
+static void FreeObserver(Lwm2mContextType * context, Lwm2mObserverType * observer)
+{
+    ListRemove(&observer->list);
+    HashTable_Remove(Lwm2mCore_GetObserverIndex(context), &observer->PathIndex);
+    DeadlineQueue_Cancel(Lwm2mCore_GetObserverQueue(context), &observer->Due);
+    free(observer->OldValue);
+    free(observer->ContextData);
+    free(observer);
+}
+
+static const NotificationAttributes * GetValidAttributesForType(AttributeTypeEnum attributeType, const NotificationAttributes * attributes)
+{
+    return attributes->Valid[attributeType] ? attributes : NULL;
+}
+
+static const NotificationAttributes * ResolveObserverAttributes(Lwm2mContextType * context, Lwm2mObserverType * observer)
 {
-    return (attributes != NULL) && attributes->Valid[attributeType];
+    return AttributeStore_ResolveNotificationAttributes(Lwm2mCore_GetAttributes(context), &observer->Attributes, observer->ShortServerID,
+                                                        observer->ObjectID, observer->ObjectInstanceID, observer->ResourceID);
 }
 
-static NotificationAttributes * GetHighestValidAttributesForType(AttributeTypeEnum attributeType, NotificationAttributes * resourceAttributes,
-                                                                 NotificationAttributes * objectInstanceAttributes, NotificationAttributes * objectAttributes)
+// Queue the observer for when its next notification is due: pmin after the last notification if it has changed,
+// and pmax after the last notification regardless. An unchanged observer with no pmax is never due.
+static void ScheduleObserver(Lwm2mContextType * context, Lwm2mObserverType * observer)
 {
-    if (NotificationAttributesValid(attributeType, resourceAttributes))
+    const NotificationAttributes * attributes = ResolveObserverAttributes(context, observer);
+
+    int minimumPeriod = attributes->Valid[AttributeTypeEnum_MinimumPeriod] ? attributes->MinimumPeriod : Lwm2mServerObject_GetDefaultMinimumPeriod(context, observer->ShortServerID);
+    int maximumPeriod = attributes->Valid[AttributeTypeEnum_MaximumPeriod] ? attributes->MaximumPeriod : Lwm2mServerObject_GetDefaultMaximumPeriod(context, observer->ShortServerID);
+
+    // A notification is sent once the period has been exceeded, hence the extra millisecond
+    uint64_t deadline = UINT64_MAX;
+    if (observer->Changed)
     {
-        return resourceAttributes;
+        deadline = observer->LastUpdate + ((uint32_t)minimumPeriod * 1000) + 1;
     }
-    else if (NotificationAttributesValid(attributeType, objectInstanceAttributes))
+    if ((maximumPeriod != -1) && (observer->LastUpdate + ((uint32_t)maximumPeriod * 1000) + 1 < deadline))
     {
-        return objectInstanceAttributes;
+        deadline = observer->LastUpdate + ((uint32_t)maximumPeriod * 1000) + 1;
     }
-    else if (NotificationAttributesValid(attributeType, objectAttributes))
+
+    if (deadline == UINT64_MAX)
     {
-        return objectAttributes;
+        DeadlineQueue_Cancel(Lwm2mCore_GetObserverQueue(context), &observer->Due);
     }
-    else
+    else if (DeadlineQueue_Schedule(Lwm2mCore_GetObserverQueue(context), &observer->Due, deadline) != 0)
     {
-        return NULL;
+        Lwm2m_Error("Failed to schedule notification for /%d/%d/%d\n", observer->ObjectID, observer->ObjectInstanceID, observer->ResourceID);
     }
 }
 
-void Lwm2m_MarkObserversChanged(void * ctxt, ObjectIDType objectID, ObjectInstanceIDType objectInstanceID,
+static void MarkObserverChanged(Lwm2mContextType * context, Lwm2mObserverType * observer, ObjectIDType objectID, ObjectInstanceIDType objectInstanceID,
                                 ResourceIDType resourceID, const void * newValue, size_t newValueLength)
 {
-    Lwm2mContextType * context = (Lwm2mContextType *) ctxt;
-    struct ListHead * observerItem;
-    ListForEach(observerItem, Lwm2mCore_GetObserverList(context))
+    int shortServerID = observer->ShortServerID;
+    const NotificationAttributes * attributes;
+    ResourceDefinition * definition = observer->Definition;
+
+    if (ObserverHasPath(observer, objectID, objectInstanceID, resourceID))
     {
-        Lwm2mObserverType * observer = ListEntry(observerItem, Lwm2mObserverType, list);
+        attributes = ResolveObserverAttributes(context, observer);
+    }
+    else
+    {
+        // A change within an observed object or object instance is checked against the attributes of the changed path
+        ResolvedNotificationAttributes changedPathAttributes;
+        memset(&changedPathAttributes, 0, sizeof(changedPathAttributes));
+        attributes = AttributeStore_ResolveNotificationAttributes(Lwm2mCore_GetAttributes(context), &changedPathAttributes, shortServerID,
+                                                                  objectID, objectInstanceID, resourceID);
+        definition = Definition_LookupResourceDefinition(Lwm2mCore_GetDefinitions(context), objectID, resourceID);
+    }
 
-        if ((observer->ObjectID == objectID) &&
-            ((observer->ObjectInstanceID == objectInstanceID) || (observer->ObjectInstanceID == -1)) &&
-            ((observer->ResourceID == resourceID) || (observer->ResourceID == -1)))
+    bool passedAttributeChecks = false;
+    if ((definition != NULL) && (!IS_MULTIPLE_INSTANCE(definition)) && (observer->OldValue != NULL) && (newValue != NULL))
+    {
+        switch (definition->Type)
         {
-
-            int shortServerID = Lwm2mSecurity_GetShortServerID(context, &observer->Address);
-
-            NotificationAttributes * resourceAttributes = (resourceID == -1) ? NULL :
-                    AttributeStore_LookupNotificationAttributes(Lwm2mCore_GetAttributes(context), shortServerID, objectID, objectInstanceID, resourceID);
-            NotificationAttributes * objectInstanceAttributes = (objectInstanceID == -1) ? NULL :
-                    AttributeStore_LookupNotificationAttributes(Lwm2mCore_GetAttributes(context), shortServerID, objectID, objectInstanceID, -1);
-            NotificationAttributes * objectAttributes = AttributeStore_LookupNotificationAttributes(Lwm2mCore_GetAttributes(context), shortServerID, objectID, -1, -1);
-
-            ResourceDefinition * definition = Definition_LookupResourceDefinition(Lwm2mCore_GetDefinitions(context), objectID, resourceID);
-
-            bool passedAttributeChecks = false;
-            if ((definition != NULL) && (!IS_MULTIPLE_INSTANCE(definition)) && (observer->OldValue != NULL) && (newValue != NULL))
+            case AwaResourceType_Integer: // no-break
+            case AwaResourceType_Float:   // no-break
+            case AwaResourceType_Time:
             {
+                const NotificationAttributes * greaterThanAttributes = GetValidAttributesForType(AttributeTypeEnum_GreaterThan, attributes);
+                const NotificationAttributes * lessThanAttributes = GetValidAttributesForType(AttributeTypeEnum_LessThan, attributes);
+                const NotificationAttributes * stepAttributes = GetValidAttributesForType(AttributeTypeEnum_Step, attributes);
+
                 switch (definition->Type)
                 {
+                    // FIXME: Remove duplication if possible
                     case AwaResourceType_Integer: // no-break
-                    case AwaResourceType_Float:   // no-break
                     case AwaResourceType_Time:
                     {
-                        NotificationAttributes * greaterThanAttributes = GetHighestValidAttributesForType(AttributeTypeEnum_GreaterThan, resourceAttributes,
-                                                                                                          objectInstanceAttributes, objectAttributes);
-                        NotificationAttributes * lessThanAttributes = GetHighestValidAttributesForType(AttributeTypeEnum_LessThan, resourceAttributes,
-                                                                                                       objectInstanceAttributes, objectAttributes);
-                        NotificationAttributes * stepAttributes = GetHighestValidAttributesForType(AttributeTypeEnum_Step, resourceAttributes,
-                                                                                                   objectInstanceAttributes, objectAttributes);
-
-                        switch (definition->Type)
+                        AwaInteger oldValueAsInteger = observer->OldValueLength == sizeof(AwaInteger) ? *((AwaInteger *)observer->OldValue) : 0;
+                        AwaInteger newValueAsInteger = newValueLength == sizeof(AwaInteger) ? *((AwaInteger *)newValue) : 0;
+
+                        if ((greaterThanAttributes != NULL) &&
+                                ((oldValueAsInteger > greaterThanAttributes->GreaterThan) == (newValueAsInteger > greaterThanAttributes->GreaterThan)))
+                        {
+                            Lwm2m_Error("/%d/%d/%d changed but did not cross over threshold high value; not notifying observer for server %d", objectID, objectInstanceID, resourceID, shortServerID);
+                        }
+                        else if ((lessThanAttributes != NULL) &&
+                                ((oldValueAsInteger > lessThanAttributes->LessThan) == (newValueAsInteger > lessThanAttributes->LessThan)))
+                        {
+                            Lwm2m_Error("/%d/%d/%d changed but did not cross over threshold low value; not notifying observer for server %d", objectID, objectInstanceID, resourceID, shortServerID);
+                        }
+                        else if ((stepAttributes != NULL) && stepAttributes->Step > labs(oldValueAsInteger - newValueAsInteger))
+                        {
+                            Lwm2m_Error("/%d/%d/%d changed but not by the step amount (Old value = %" PRId64 ", new value = %" PRId64 "); not notifying observer for server %d", objectID, objectInstanceID, resourceID, oldValueAsInteger, newValueAsInteger, shortServerID);
+                        }
+                        else
                         {
-                            // FIXME: Remove duplication if possible
-                            case AwaResourceType_Integer: // no-break
-                            case AwaResourceType_Time:
-                            {
-                                AwaInteger oldValueAsInteger = observer->OldValueLength == sizeof(AwaInteger) ? *((AwaInteger *)observer->OldValue) : 0;
-                                AwaInteger newValueAsInteger = newValueLength == sizeof(AwaInteger) ? *((AwaInteger *)newValue) : 0;
-
-                                if ((greaterThanAttributes != NULL) &&
-                                        ((oldValueAsInteger > greaterThanAttributes->GreaterThan) == (newValueAsInteger > greaterThanAttributes->GreaterThan)))
-                                {
-                                    Lwm2m_Error("/%d/%d/%d changed but did not cross over threshold high value; not notifying observer for server %d", objectID, objectInstanceID, resourceID, shortServerID);
-                                }
-                                else if ((lessThanAttributes != NULL) &&
-                                        ((oldValueAsInteger > lessThanAttributes->LessThan) == (newValueAsInteger > lessThanAttributes->LessThan)))
-                                {
-                                    Lwm2m_Error("/%d/%d/%d changed but did not cross over threshold low value; not notifying observer for server %d", objectID, objectInstanceID, resourceID, shortServerID);
-                                }
-                                else if ((stepAttributes != NULL) && stepAttributes->Step > labs(oldValueAsInteger - newValueAsInteger))
-                                {
-                                    Lwm2m_Error("/%d/%d/%d changed but not by the step amount (Old value = %" PRId64 ", new value = %" PRId64 "); not notifying observer for server %d", objectID, objectInstanceID, resourceID, oldValueAsInteger, newValueAsInteger, shortServerID);
-                                }
-                                else
-                                {
-                                    passedAttributeChecks = true;
-                                }
-                                break;
-                            }
-                            case AwaResourceType_Float:
-                            {
-                                AwaFloat oldValueAsFloat = observer->OldValueLength == sizeof(AwaInteger) ? *((AwaFloat *)observer->OldValue) : 0;
-                                AwaFloat newValueAsFloat = newValueLength == sizeof(AwaInteger) ? *((AwaFloat *)newValue) : 0;
-
-                                if ((greaterThanAttributes != NULL) &&
-                                        ((oldValueAsFloat > greaterThanAttributes->GreaterThan) == (newValueAsFloat > greaterThanAttributes->GreaterThan)))
-                                {
-                                    Lwm2m_Error("/%d/%d/%d changed but did not cross over threshold high value; not notifying observer for server %d", objectID, objectInstanceID, resourceID, shortServerID);
-                                }
-                                else if ((lessThanAttributes != NULL) &&
-                                        ((oldValueAsFloat > lessThanAttributes->LessThan) == (newValueAsFloat > lessThanAttributes->LessThan)))
-                                {
-                                    Lwm2m_Error("/%d/%d/%d changed but did not cross over threshold low value; not notifying observer for server %d", objectID, objectInstanceID, resourceID, shortServerID);
-                                }
-                                else if ((stepAttributes != NULL) && stepAttributes->Step > labs(oldValueAsFloat - newValueAsFloat))
-                                {
-                                    Lwm2m_Error("/%d/%d/%d changed but not by the step amount (Old value = %f, new value = %f); not notifying observer for server %d", objectID, objectInstanceID, resourceID, oldValueAsFloat, newValueAsFloat, shortServerID);
-                                }
-                                else
-                                {
-                                    passedAttributeChecks = true;
-                                }
-                                break;
-                            }
-                            default:
-                                Lwm2m_Error("Unsupported resource type for checking gt/lt/stp attributes: %d\n", definition->Type);
-                                break;
+                            passedAttributeChecks = true;
                         }
                         break;
                     }
-                    default:
-                        // Other resource types do not support stp/gt/lt attributes
-                        passedAttributeChecks = true;
+                    case AwaResourceType_Float:
+                    {
+                        AwaFloat oldValueAsFloat = observer->OldValueLength == sizeof(AwaInteger) ? *((AwaFloat *)observer->OldValue) : 0;
+                        AwaFloat newValueAsFloat = newValueLength == sizeof(AwaInteger) ? *((AwaFloat *)newValue) : 0;
+
+                        if ((greaterThanAttributes != NULL) &&
+                                ((oldValueAsFloat > greaterThanAttributes->GreaterThan) == (newValueAsFloat > greaterThanAttributes->GreaterThan)))
+                        {
+                            Lwm2m_Error("/%d/%d/%d changed but did not cross over threshold high value; not notifying observer for server %d", objectID, objectInstanceID, resourceID, shortServerID);
+                        }
+                        else if ((lessThanAttributes != NULL) &&
+                                ((oldValueAsFloat > lessThanAttributes->LessThan) == (newValueAsFloat > lessThanAttributes->LessThan)))
+                        {
+                            Lwm2m_Error("/%d/%d/%d changed but did not cross over threshold low value; not notifying observer for server %d", objectID, objectInstanceID, resourceID, shortServerID);
+                        }
+                        else if ((stepAttributes != NULL) && stepAttributes->Step > labs(oldValueAsFloat - newValueAsFloat))
+                        {
+                            Lwm2m_Error("/%d/%d/%d changed but not by the step amount (Old value = %f, new value = %f); not notifying observer for server %d", objectID, objectInstanceID, resourceID, oldValueAsFloat, newValueAsFloat, shortServerID);
+                        }
+                        else
+                        {
+                            passedAttributeChecks = true;
+                        }
                         break;
                     }
-            }
-            else
-            {
-                if (observer->OldValue != NULL && resourceID != -1)
-                {
-                    Lwm2m_Error("No resource definition for /%d/%d/%d\n", objectID, objectInstanceID, resourceID);
-                }
-                else
-                {
-                    passedAttributeChecks = true;
+                    default:
+                        Lwm2m_Error("Unsupported resource type for checking gt/lt/stp attributes: %d\n", definition->Type);
+                        break;
                 }
+                break;
+            }
+            default:
+                // Other resource types do not support stp/gt/lt attributes
+                passedAttributeChecks = true;
+                break;
             }
+    }
+    else
+    {
+        if (observer->OldValue != NULL && resourceID != -1)
+        {
+            Lwm2m_Error("No resource definition for /%d/%d/%d\n", objectID, objectInstanceID, resourceID);
+        }
+        else
+        {
+            passedAttributeChecks = true;
+        }
+    }
 
-            if (passedAttributeChecks)
-            {
-                Lwm2m_Debug("All attributes checked out for server %d, Will notify change to /%d/%d/%d when possible.\n", shortServerID, objectID, objectInstanceID, resourceID);
-                observer->Changed = true;
+    if (passedAttributeChecks)
+    {
+        Lwm2m_Debug("All attributes checked out for server %d, Will notify change to /%d/%d/%d when possible.\n", shortServerID, objectID, objectInstanceID, resourceID);
+        observer->Changed = true;
+        ScheduleObserver(context, observer);
 
-                if (observer->OldValue != NULL)
-                {
-                    free(observer->OldValue);
-                    observer->OldValue = NULL;
-                }
+        if (observer->OldValue != NULL)
+        {
+            free(observer->OldValue);
+            observer->OldValue = NULL;
+        }
 
-                if (newValue != NULL)
-                {
-                    observer->OldValue = malloc(newValueLength);
-                    observer->OldValueLength = newValueLength;
-                    memcpy(observer->OldValue, newValue, newValueLength);
-                }
-            }
+        if (newValue != NULL)
+        {
+            observer->OldValue = malloc(newValueLength);
+            observer->OldValueLength = newValueLength;
+            memcpy(observer->OldValue, newValue, newValueLength);
         }
     }
 }
 
-int Lwm2m_RemoveAllObserversForOIR(void * ctxt, ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID)
+void Lwm2m_MarkObserversChanged(void * ctxt, ObjectIDType objectID, ObjectInstanceIDType objectInstanceID,
+                                ResourceIDType resourceID, const void * newValue, size_t newValueLength)
 {
     Lwm2mContextType * context = (Lwm2mContextType *) ctxt;
-    struct ListHead * observerItem, *next;
-    ListForEachSafe(observerItem, next, Lwm2mCore_GetObserverList(context))
+
+    // A change is seen by observers of the changed path, and of the object and object instance that contain it
+    const struct
     {
-        Lwm2mObserverType * observer = ListEntry(observerItem, Lwm2mObserverType, list);
+        ObjectInstanceIDType ObjectInstanceID;
+        ResourceIDType ResourceID;
+    } paths[] = {
+        { objectInstanceID, resourceID },
+        { objectInstanceID, -1 },
+        { -1, resourceID },
+        { -1, -1 },
+    };
+
+    int path;
+    for (path = 0; path < sizeof(paths) / sizeof(paths[0]); path++)
+    {
+        // skip paths already visited when the change is to an object or object instance
+        bool visited = false;
+        int previous;
+        for (previous = 0; previous < path; previous++)
+        {
+            visited |= (paths[previous].ObjectInstanceID == paths[path].ObjectInstanceID) && (paths[previous].ResourceID == paths[path].ResourceID);
+        }
+        if (visited)
+        {
+            continue;
+        }
 
-        if (observer->ObjectID == objectID &&
-            observer->ObjectInstanceID == objectInstanceID &&
-            observer->ResourceID == resourceID)
+        uint32_t hash = HashObserverPath(objectID, paths[path].ObjectInstanceID, paths[path].ResourceID);
+        struct ListHead * observerItem;
+        ListForEach(observerItem, HashTable_GetBucket(Lwm2mCore_GetObserverIndex(context), hash))
         {
+            HashEntry * entry = ListEntry(observerItem, HashEntry, list);
+            Lwm2mObserverType * observer = ListEntry(entry, Lwm2mObserverType, PathIndex);
+            if ((entry->Hash == hash) && ObserverHasPath(observer, objectID, paths[path].ObjectInstanceID, paths[path].ResourceID))
+            {
+                MarkObserverChanged(context, observer, objectID, objectInstanceID, resourceID, newValue, newValueLength);
+            }
+        }
+    }
+}
 
-           ListRemove(&observer->list);
+int Lwm2m_RemoveAllObserversForOIR(void * ctxt, ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID)
+{
+    Lwm2mContextType * context = (Lwm2mContextType *) ctxt;
+    uint32_t hash = HashObserverPath(objectID, objectInstanceID, resourceID);
+    struct ListHead * observerItem;
+    ListForEach(observerItem, HashTable_GetBucket(Lwm2mCore_GetObserverIndex(context), hash))
+    {
+        HashEntry * entry = ListEntry(observerItem, HashEntry, list);
+        Lwm2mObserverType * observer = ListEntry(entry, Lwm2mObserverType, PathIndex);
 
-           free(observer->OldValue);
-           free(observer->ContextData);
-           free(observer);
+        if ((entry->Hash == hash) && ObserverHasPath(observer, objectID, objectInstanceID, resourceID))
+        {
+           FreeObserver(context, observer);
            return 0;
         }
     }
@@ -257,11 +329,7 @@ void Lwm2m_FreeObservers(void * ctxt)
     ListForEachSafe(observerItem, n, Lwm2mCore_GetObserverList(context))
     {
         Lwm2mObserverType * observer = ListEntry(observerItem, Lwm2mObserverType, list);
-
-        ListRemove(observerItem);
-        free(observer->OldValue);
-        free(observer->ContextData);
-        free(observer);
+        FreeObserver(context, observer);
     }
 }
 
@@ -287,7 +355,9 @@ int Lwm2m_Observe(void * ctxt, AddressType * addr, const char * token, int token
         }
 
         memset(observer, 0, sizeof(*observer));
+        DeadlineQueue_InitEntry(&observer->Due);
         ListAdd(&observer->list, Lwm2mCore_GetObserverList(context));
+        HashTable_Add(Lwm2mCore_GetObserverIndex(context), &observer->PathIndex, HashObserverPath(objectID, objectInstanceID, resourceID));
     }
     else
     {
@@ -310,11 +380,17 @@ int Lwm2m_Observe(void * ctxt, AddressType * addr, const char * token, int token
     memcpy(&observer->Token, token, tokenLength);
     memcpy(&observer->Address, addr, sizeof(AddressType));
 
+    // Resolve the server and definition once, rather than each time the observed path changes.
+    // Attributes are resolved on first use, and again only when the attribute store changes.
+    observer->ShortServerID = Lwm2mSecurity_GetShortServerID(context, addr);
+    memset(&observer->Attributes, 0, sizeof(observer->Attributes));
+    observer->Definition = (resourceID == -1) ? NULL : Definition_LookupResourceDefinition(Lwm2mCore_GetDefinitions(context), objectID, resourceID);
+
     // The old value buffer must be created when the observation begins,
     // otherwise attributes can't be checked on the first modification of a resource value.
     if (resourceID != -1)
     {
-        ResourceDefinition * resourceDefinition = Definition_LookupResourceDefinition(Lwm2mCore_GetDefinitions(context), objectID, resourceID);
+        ResourceDefinition * resourceDefinition = observer->Definition;
 
         if ((resourceDefinition != NULL) && (!IS_MULTIPLE_INSTANCE(resourceDefinition)))
         {
@@ -332,6 +408,8 @@ int Lwm2m_Observe(void * ctxt, AddressType * addr, const char * token, int token
         }
     }
 
+    ScheduleObserver(context, observer);
+
 error:
     return result;
 }
@@ -342,47 +420,42 @@ int Lwm2m_CancelObserve(void * ctxt, AddressType * addr, ObjectIDType objectID,
     Lwm2mObserverType * observer = LookupObserver(context, addr, objectID, objectInstanceID, resourceID);
     if (observer != NULL)
     {
-        ListRemove(&observer->list);
-        free(observer->OldValue);
-        free(observer->ContextData);
-        free(observer);
+        FreeObserver(context, observer);
         return 0;
     }
     return -1;
 }
 
-void Lwm2m_UpdateObservers(void * ctxt)
+int Lwm2m_UpdateObservers(void * ctxt, int maxTimeout)
 {
     Lwm2mContextType * context = (Lwm2mContextType *) ctxt;
-    uint32_t now = Lwm2mCore_GetTickCountMs();
+    DeadlineQueue * queue = Lwm2mCore_GetObserverQueue(context);
+    uint64_t now = Lwm2mCore_GetTickCountMs();
 
-    struct ListHead * observerItem, *n;
-    ListForEachSafe(observerItem, n, Lwm2mCore_GetObserverList(context))
+    // Only observers whose pmin or pmax has elapsed are visited
+    DeadlineEntry * expired;
+    while ((expired = DeadlineQueue_PopExpired(queue, now)) != NULL)
     {
-        Lwm2mObserverType * observer = ListEntry(observerItem, Lwm2mObserverType, list);
-
-        int shortServerID = Lwm2mSecurity_GetShortServerID(context, &observer->Address);
-
-        NotificationAttributes * resourceAttributes = observer->ResourceID == -1? NULL : AttributeStore_LookupNotificationAttributes(Lwm2mCore_GetAttributes(context), shortServerID, observer->ObjectID, observer->ObjectInstanceID, observer->ResourceID);
-        NotificationAttributes * objectInstanceAttributes = observer->ObjectInstanceID == -1? NULL : AttributeStore_LookupNotificationAttributes(Lwm2mCore_GetAttributes(context), shortServerID, observer->ObjectID, observer->ObjectInstanceID, -1);
-        NotificationAttributes * objectAttributes = AttributeStore_LookupNotificationAttributes(Lwm2mCore_GetAttributes(context), shortServerID, observer->ObjectID, -1, -1);
-
-        NotificationAttributes * minimumPeriodAttributes = GetHighestValidAttributesForType(AttributeTypeEnum_MinimumPeriod, resourceAttributes, objectInstanceAttributes, objectAttributes);
-        int minimumPeriod = minimumPeriodAttributes != NULL? minimumPeriodAttributes->MinimumPeriod : Lwm2mServerObject_GetDefaultMinimumPeriod(context, shortServerID);
-
-        NotificationAttributes * maximumPeriodAttributes = GetHighestValidAttributesForType(AttributeTypeEnum_MaximumPeriod, resourceAttributes, objectInstanceAttributes, objectAttributes);
-        int maximumPeriod = maximumPeriodAttributes != NULL? maximumPeriodAttributes->MaximumPeriod : Lwm2mServerObject_GetDefaultMaximumPeriod(context, shortServerID);
+        Lwm2mObserverType * observer = ListEntry(expired, Lwm2mObserverType, Due);
+
+        observer->Sequence ++;
+        observer->Callback(context, &observer->Address, observer->Sequence, (const char*)&observer->Token, observer->TokenLength,
+                           observer->ObjectID, observer->ObjectInstanceID, observer->ResourceID, observer->ContentType, observer->ContextData);
+        observer->Changed = false;
+        observer->LastUpdate = now;
+        ScheduleObserver(context, observer);
+    }
 
-        uint32_t elapsed = now - observer->LastUpdate;
+    return DeadlineQueue_GetTimeout(queue, now, maxTimeout);
+}
 
-        if ((observer->Changed && (elapsed > ((uint32_t)minimumPeriod * 1000))) ||
-            ((maximumPeriod != -1) && (elapsed > ((uint32_t)maximumPeriod * 1000))))
-        {
-            observer->Sequence ++;
-            observer->Callback(context, &observer->Address, observer->Sequence, (const char*)&observer->Token, observer->TokenLength, 
-                               observer->ObjectID, observer->ObjectInstanceID, observer->ResourceID, observer->ContentType, observer->ContextData);
-            observer->Changed = false;
-            observer->LastUpdate = now;
-        }
+void Lwm2m_RescheduleObservers(void * ctxt)
+{
+    Lwm2mContextType * context = (Lwm2mContextType *) ctxt;
+    struct ListHead * observerItem;
+    ListForEach(observerItem, Lwm2mCore_GetObserverList(context))
+    {
+        Lwm2mObserverType * observer = ListEntry(observerItem, Lwm2mObserverType, list);
+        ScheduleObserver(context, observer);
     }
 }
@@ -31,13 +31,17 @@ extern "C" {
 #include "lwm2m_types.h"
 #include "lwm2m_attributes.h"
 #include "lwm2m_list.h"
+#include "lwm2m_hash.h"
+#include "lwm2m_deadline_queue.h"
 
 typedef int (*Lwm2mNotificationCallback)(void * context, AddressType *, int, const char *, int, ObjectIDType, ObjectInstanceIDType, ResourceIDType, ContentType, void * ContextData);
 
 typedef struct
 {
     struct ListHead list;
-    uint32_t LastUpdate;
+    HashEntry PathIndex;                   // Observers are indexed by path, so a change only visits the observers of that path and its parents
+    DeadlineEntry Due;                     // Next time a notification may be sent: pmin after a change, otherwise pmax
+    uint64_t LastUpdate;
     ObjectIDType ObjectID;
     ObjectInstanceIDType ObjectInstanceID;
     ResourceIDType ResourceID;
@@ -51,10 +55,17 @@ typedef struct
     int Sequence;
     void * OldValue;                       // For Integer and Float datatypes only, used for notification attributes.
     size_t OldValueLength;
+    int ShortServerID;                     // Server that owns the observation, resolved when the observation begins
+    ResolvedNotificationAttributes Attributes;  // Attributes in effect for the observed path
+    struct _ResourceDefinition * Definition;  // Definition of an observed resource
 } Lwm2mObserverType;
 
 // Send out pending notifications to any observers of objects, object instances and resources.
-void Lwm2m_UpdateObservers(void * ctxt);
+// Returns the time in ms until the next notification is due, clamped to maxTimeout.
+int Lwm2m_UpdateObservers(void * ctxt, int maxTimeout);
+
+// Recalculate when each observer is next due, after a change to notification attributes or default periods.
+void Lwm2m_RescheduleObservers(void * ctxt);
 
 void Lwm2m_FreeObservers(void * ctxt);
 
@@ -83,13 +83,41 @@ static int OpaqueSerialiseResource(SerdesContext * serdesContext, Lwm2mTreeNode
     return resourceLength;
 }
 
-static int OpaqueDeserialiseResource(SerdesContext * serdesContext, Lwm2mTreeNode ** dest, const DefinitionRegistry * registry, ObjectIDType objectID,
+static int OpaqueStreamResource(SerdesContext * serdesContext, SerdesStream * stream, Lwm2mContextType * context,
+                                ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID)
+{
+    ResourceDefinition * definition = Definition_LookupResourceDefinition(Lwm2mCore_GetDefinitions(context), objectID, resourceID);
+    if ((definition == NULL) || (definition->Type != AwaResourceType_Opaque))
+    {
+        Lwm2m_Error("ERROR: opaque data format requested, but the requested resource is not of opaque type\n");
+        return -1;
+    }
+
+    if (IS_MULTIPLE_INSTANCE(definition))
+    {
+        Lwm2m_Error("ERROR: opaque only works on singular resources!!\n");
+        return -1;
+    }
+
+    const void * value = NULL;
+    size_t size = 0;
+    if (Lwm2mCore_GetResourceInstanceValue(context, objectID, objectInstanceID, resourceID, 0, &value, &size) < 0)
+    {
+        Lwm2m_Error("ERROR: Failed to retrieve resource /%d/%d/%d from object store\n", objectID, objectInstanceID, resourceID);
+        return -1;
+    }
+
+    SerdesStream_Write(stream, value, size);
+    return size;
+}
+
+static int OpaqueDeserialiseResource(SerdesContext * serdesContext, Lwm2mTreeNode ** dest, Lwm2mTreeArena * arena, const DefinitionRegistry * registry, ObjectIDType objectID,
                                      ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID, const uint8_t * buffer, int bufferLen)
 {
     int result = -1;
     ResourceDefinition * definition;
 
-    *dest = Lwm2mTreeNode_Create();
+    *dest = Lwm2mTreeNode_CreateInArena(arena);
     Lwm2mTreeNode_SetID(*dest, resourceID);
     Lwm2mTreeNode_SetType(*dest, Lwm2mTreeNodeType_Resource);
 
@@ -140,5 +168,8 @@ const SerialiserDeserialiser opaqueSerDes =
     .DeserialiseObject = NULL,
     .DeserialiseObjectInstance = NULL,
     .DeserialiseResource = OpaqueDeserialiseResource,
+    .StreamObject = NULL,
+    .StreamObjectInstance = NULL,
+    .StreamResource = OpaqueStreamResource,
 };
 
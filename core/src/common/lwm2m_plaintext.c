@@ -35,21 +35,10 @@
 #include "lwm2m_plaintext.h"
 #include "lwm2m_debug.h"
 
-static int PTSerialiseResourceInstance(Lwm2mTreeNode * node, ResourceDefinition * definition, int objectID,
-                                       int instanceID, int resourceID, int resID, uint8_t * buffer, int len)
+static int PTEncodeResourceInstanceValue(ResourceDefinition * definition, uint8_t * value, uint16_t size, uint8_t * buffer, int len)
 {
-    if (Lwm2mTreeNode_GetType(node) != Lwm2mTreeNodeType_ResourceInstance)
-    {
-       Lwm2m_Error("ERROR: Resource Instance node type expected. Received %d\n", Lwm2mTreeNode_GetType(node));
-       return -1;
-    }
-
     char * buf = (char*)buffer;
     int valueLength = -1;
-    uint16_t size;
-    uint8_t * value;
-
-    value = (uint8_t * )Lwm2mTreeNode_GetValue(node, &size);
 
     switch (definition->Type)
     {
@@ -119,6 +108,20 @@ static int PTSerialiseResourceInstance(Lwm2mTreeNode * node, ResourceDefinition
     return valueLength;
 }
 
+static int PTSerialiseResourceInstance(Lwm2mTreeNode * node, ResourceDefinition * definition, int objectID,
+                                       int instanceID, int resourceID, int resID, uint8_t * buffer, int len)
+{
+    if (Lwm2mTreeNode_GetType(node) != Lwm2mTreeNodeType_ResourceInstance)
+    {
+       Lwm2m_Error("ERROR: Resource Instance node type expected. Received %d\n", Lwm2mTreeNode_GetType(node));
+       return -1;
+    }
+
+    uint16_t size;
+    uint8_t * value = (uint8_t * )Lwm2mTreeNode_GetValue(node, &size);
+    return PTEncodeResourceInstanceValue(definition, value, size, buffer, len);
+}
+
 static int PTSerialiseResource(SerdesContext * serdesContext, Lwm2mTreeNode * node, ObjectIDType objectID,
                                ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID, uint8_t * buffer, int len)
 {
@@ -153,13 +156,56 @@ static int PTSerialiseResource(SerdesContext * serdesContext, Lwm2mTreeNode * no
     return resourceLength;
 }
 
-static int PTDeserialiseResource(SerdesContext * serdesContext, Lwm2mTreeNode ** dest, const DefinitionRegistry * registry, ObjectIDType objectID,
+static int PTStreamResource(SerdesContext * serdesContext, SerdesStream * stream, Lwm2mContextType * context,
+                            ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID)
+{
+    ResourceDefinition * definition = Definition_LookupResourceDefinition(Lwm2mCore_GetDefinitions(context), objectID, resourceID);
+    if (definition == NULL)
+    {
+        Lwm2m_Error("ERROR: No resource definition for Object %d Resource %d\n", objectID, resourceID);
+        return -1;
+    }
+
+    if (IS_MULTIPLE_INSTANCE(definition))
+    {
+        Lwm2m_Error("ERROR: plain text only works on singular resources!!\n");
+        return -1;
+    }
+
+    const void * value = NULL;
+    size_t size = 0;
+    if (Lwm2mCore_GetResourceInstanceValue(context, objectID, objectInstanceID, resourceID, 0, &value, &size) < 0)
+    {
+        Lwm2m_Error("ERROR: Failed to retrieve resource /%d/%d/%d from object store\n", objectID, objectInstanceID, resourceID);
+        return -1;
+    }
+
+    int valueLength;
+    if (definition->Type == AwaResourceType_String)
+    {
+        // Strings are written straight from the store
+        valueLength = (value != NULL) ? strnlen((const char *)value, size) : 0;
+        SerdesStream_Write(stream, value, valueLength);
+    }
+    else
+    {
+        char text[DBL_MAX_10_EXP + 32];   // large enough for any %f formatted double
+        valueLength = PTEncodeResourceInstanceValue(definition, (uint8_t *)value, size, (uint8_t *)text, sizeof(text));
+        if (valueLength > 0)
+        {
+            SerdesStream_Write(stream, text, valueLength);
+        }
+    }
+    return valueLength;
+}
+
+static int PTDeserialiseResource(SerdesContext * serdesContext, Lwm2mTreeNode ** dest, Lwm2mTreeArena * arena, const DefinitionRegistry * registry, ObjectIDType objectID,
                                  ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID, const uint8_t * buffer, int bufferLen)
 {
     int result = -1;
     ResourceDefinition * definition;
 
-    *dest = Lwm2mTreeNode_Create();
+    *dest = Lwm2mTreeNode_CreateInArena(arena);
     Lwm2mTreeNode_SetID(*dest, resourceID);
     Lwm2mTreeNode_SetType(*dest, Lwm2mTreeNodeType_Resource);
 
@@ -276,4 +322,7 @@ const SerialiserDeserialiser plainTextSerDes =
     .DeserialiseObject = NULL,
     .DeserialiseObjectInstance = NULL,
     .DeserialiseResource = PTDeserialiseResource,
+    .StreamObject = NULL,
+    .StreamObjectInstance = NULL,
+    .StreamResource = PTStreamResource,
 };
@@ -140,7 +140,7 @@ static int PPSerialiseResourceInstance(Lwm2mTreeNode * node, ResourceDefinition
 
     headerLen += snprintf((char*)buffer, len, "\t%s[%d/%d/%d/%d]: ", definition->ResourceName, objectID, objectInstanceID, resourceID, resourceInstanceID);
 
-    if (headerLen <= 0)
+    if ((headerLen <= 0) || (headerLen >= len))
     {
         return -1;
     }
@@ -201,6 +201,12 @@ static int PPSerialiseResourceInstance(Lwm2mTreeNode * node, ResourceDefinition
             break;
     }
 
+    // snprintf reports the untruncated length, so check there is room for the value and its newline
+    if (headerLen + valueLength + 1 >= len)
+    {
+        return -1;
+    }
+
     strcat((char*)valueBuffer, "\n");
 
     return valueLength + headerLen + 1;
@@ -257,6 +263,10 @@ static int PPSerialiseObjectInstance(SerdesContext * serdesContext, Lwm2mTreeNod
         return -1;
     }
     instanceLength += snprintf((char*)buffer, len, "%s[%d/%d]:\n", definition->ObjectName, objectID, objectInstanceID);
+    if (instanceLength >= len)
+    {
+        return -1;
+    }
 
     Lwm2mTreeNode * child = Lwm2mTreeNode_GetFirstChild(node);
     while (child != NULL)
@@ -23,6 +23,7 @@
 
 #include <stddef.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "lwm2m_debug.h"
 #include "lwm2m_serdes.h"
@@ -33,6 +34,7 @@
   #include "lwm2m_json.h"
 #endif
 #include "lwm2m_opaque.h"
+#include "lwm2m_tree_builder.h"
 
 typedef struct
 {
@@ -67,6 +69,9 @@ const static SerdesMapEntry serdesList[] =
 };
 #define NUM_SERIALISERS (sizeof(serdesList)/sizeof(SerdesMapEntry))
 
+// Largest encoding produced for a serialiser without a stream variant
+#define STREAM_FROM_TREE_MAX_SIZE (1024 * 1024)
+
 static SerialiserDeserialiser * GetSerialiserDeserialiser(ContentType type)
 {
     int i;
@@ -118,12 +123,18 @@ int SerialiseResource(ContentType type, Lwm2mTreeNode * node, ObjectIDType objec
 
 int DeserialiseObject(ContentType type, Lwm2mTreeNode ** dest, const DefinitionRegistry * registry,
                       ObjectIDType objectID, const char * buffer, int bufferLen)
+{
+    return DeserialiseObjectInArena(type, dest, NULL, registry, objectID, buffer, bufferLen);
+}
+
+int DeserialiseObjectInArena(ContentType type, Lwm2mTreeNode ** dest, Lwm2mTreeArena * arena, const DefinitionRegistry * registry,
+                             ObjectIDType objectID, const char * buffer, int bufferLen)
 {
     SerialiserDeserialiser * serdes = GetSerialiserDeserialiser(type);
     if ((serdes != NULL) && serdes->DeserialiseObject)
     {
         SerdesContext serdesContext = NULL;
-        return serdes->DeserialiseObject(&serdesContext, dest, registry, objectID, (const uint8_t*)buffer, bufferLen);
+        return serdes->DeserialiseObject(&serdesContext, dest, arena, registry, objectID, (const uint8_t*)buffer, bufferLen);
     }
     Lwm2m_Error("Deserialiser not found for type %d\n", type);
     return -1;
@@ -131,12 +142,18 @@ int DeserialiseObject(ContentType type, Lwm2mTreeNode ** dest, const DefinitionR
 
 int DeserialiseObjectInstance(int type, Lwm2mTreeNode ** dest, const DefinitionRegistry * registry, ObjectIDType objectID,
                               ObjectInstanceIDType objectInstanceID, const char * buffer, int bufferLen)
+{
+    return DeserialiseObjectInstanceInArena(type, dest, NULL, registry, objectID, objectInstanceID, buffer, bufferLen);
+}
+
+int DeserialiseObjectInstanceInArena(ContentType type, Lwm2mTreeNode ** dest, Lwm2mTreeArena * arena, const DefinitionRegistry * registry,
+                                     ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, const char * buffer, int bufferLen)
 {
     SerialiserDeserialiser * serdes = GetSerialiserDeserialiser(type);
     if ((serdes != NULL) && serdes->DeserialiseObjectInstance)
     {
         SerdesContext serdesContext = NULL;
-        return serdes->DeserialiseObjectInstance(&serdesContext, dest, registry, objectID, objectInstanceID, (const uint8_t*)buffer, bufferLen);
+        return serdes->DeserialiseObjectInstance(&serdesContext, dest, arena, registry, objectID, objectInstanceID, (const uint8_t*)buffer, bufferLen);
     }
     Lwm2m_Error("Deserialiser not found for type %d\n", type);
     return -1;
@@ -144,14 +161,179 @@ int DeserialiseObjectInstance(int type, Lwm2mTreeNode ** dest, const DefinitionR
 
 int DeserialiseResource(int type, Lwm2mTreeNode ** dest, const DefinitionRegistry * registry, ObjectIDType objectID,
                         ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID, const char * buffer, int bufferLen)
+{
+    return DeserialiseResourceInArena(type, dest, NULL, registry, objectID, objectInstanceID, resourceID, buffer, bufferLen);
+}
+
+int DeserialiseResourceInArena(ContentType type, Lwm2mTreeNode ** dest, Lwm2mTreeArena * arena, const DefinitionRegistry * registry,
+                               ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID, const char * buffer, int bufferLen)
 {
     SerialiserDeserialiser * serdes = GetSerialiserDeserialiser(type);
     if ((serdes != NULL) && serdes->DeserialiseResource)
     {
         SerdesContext serdesContext = NULL;
-        return serdes->DeserialiseResource(&serdesContext, dest, registry, objectID, objectInstanceID, resourceID, (const uint8_t*)buffer, bufferLen);
+        return serdes->DeserialiseResource(&serdesContext, dest, arena, registry, objectID, objectInstanceID, resourceID, (const uint8_t*)buffer, bufferLen);
     }
     Lwm2m_Error("Deserialiser not found for type %d\n", type);
     return -1;
 }
 
+void SerdesStream_Init(SerdesStream * stream, uint8_t * buffer, int size, int offset)
+{
+    stream->Buffer = buffer;
+    stream->Size = size;
+    stream->Offset = offset;
+    stream->Position = 0;
+    stream->More = false;
+    stream->Growable = false;
+}
+
+void SerdesStream_InitGrowable(SerdesStream * stream)
+{
+    SerdesStream_Init(stream, NULL, 0, 0);
+    stream->Growable = true;
+}
+
+void SerdesStream_Free(SerdesStream * stream)
+{
+    if (stream->Growable)
+    {
+        free(stream->Buffer);
+        stream->Buffer = NULL;
+        stream->Size = 0;
+    }
+}
+
+void SerdesStream_Write(SerdesStream * stream, const void * data, int length)
+{
+    if (stream->Growable && (stream->Position + length > stream->Size))
+    {
+        int size = (stream->Size > 0) ? stream->Size : 64;
+        while (size < stream->Position + length)
+        {
+            size *= 2;
+        }
+        uint8_t * buffer = realloc(stream->Buffer, size);
+        if (buffer != NULL)
+        {
+            stream->Buffer = buffer;
+            stream->Size = size;
+        }
+    }
+
+    int windowEnd = stream->Offset + stream->Size;
+    int start = (stream->Position > stream->Offset) ? stream->Position : stream->Offset;
+    int end = (stream->Position + length < windowEnd) ? stream->Position + length : windowEnd;
+
+    if (end > start)
+    {
+        memcpy(&stream->Buffer[start - stream->Offset], (const uint8_t *)data + (start - stream->Position), end - start);
+    }
+    if (stream->Position + length > windowEnd)
+    {
+        stream->More = true;
+    }
+    stream->Position += length;
+}
+
+int SerdesStream_GetLength(const SerdesStream * stream)
+{
+    int end = (stream->Position < stream->Offset + stream->Size) ? stream->Position : stream->Offset + stream->Size;
+    return (end > stream->Offset) ? end - stream->Offset : 0;
+}
+
+// Serialisers without a stream variant encode a tree built from the store. They fail rather than truncate when
+// the buffer is too small, so the whole encoding is produced in a temporary buffer, grown until it fits, and
+// the stream keeps just its window of it.
+static int StreamFromTree(const SerialiserDeserialiser * serdes, SerdesStream * stream, Lwm2mContextType * context, int OIR[], int OIRLength)
+{
+    int len = -1;
+    int size = (stream->Offset + stream->Size > 64) ? stream->Offset + stream->Size : 64;
+    uint8_t * buffer = NULL;
+    Lwm2mTreeNode * root = NULL;
+
+    if (TreeBuilder_CreateTreeFromOIR(&root, context, Lwm2mRequestOrigin_Client, OIR, OIRLength) == AwaResult_Success)
+    {
+        do
+        {
+            uint8_t * newBuffer = realloc(buffer, size);
+            if (newBuffer == NULL)
+            {
+                break;
+            }
+            buffer = newBuffer;
+
+            SerdesContext serdesContext = NULL;
+            if ((OIRLength == 1) && serdes->SerialiseObject)
+            {
+                len = serdes->SerialiseObject(&serdesContext, root, OIR[0], buffer, size);
+            }
+            else if ((OIRLength == 2) && serdes->SerialiseObjectInstance)
+            {
+                len = serdes->SerialiseObjectInstance(&serdesContext, root, OIR[0], OIR[1], buffer, size);
+            }
+            else if ((OIRLength == 3) && serdes->SerialiseResource)
+            {
+                len = serdes->SerialiseResource(&serdesContext, root, OIR[0], OIR[1], OIR[2], buffer, size);
+            }
+            else
+            {
+                break;
+            }
+            size *= 2;
+        } while ((len < 0) && (size <= STREAM_FROM_TREE_MAX_SIZE));
+    }
+
+    if (len >= 0)
+    {
+        SerdesStream_Write(stream, buffer, len);
+    }
+    Lwm2mTreeNode_DeleteRecursive(root);
+    free(buffer);
+    return len;
+}
+
+int StreamObject(ContentType type, SerdesStream * stream, Lwm2mContextType * context, ObjectIDType objectID)
+{
+    SerialiserDeserialiser * serdes = GetSerialiserDeserialiser(type);
+    if (serdes != NULL)
+    {
+        SerdesContext serdesContext = NULL;
+        int OIR[] = { objectID };
+        int len = serdes->StreamObject ? serdes->StreamObject(&serdesContext, stream, context, objectID) : StreamFromTree(serdes, stream, context, OIR, 1);
+        return (len < 0) ? -1 : SerdesStream_GetLength(stream);
+    }
+    Lwm2m_Error("Serialiser not found for type %d\n", type);
+    return -1;
+}
+
+int StreamObjectInstance(ContentType type, SerdesStream * stream, Lwm2mContextType * context, ObjectIDType objectID, ObjectInstanceIDType objectInstanceID)
+{
+    SerialiserDeserialiser * serdes = GetSerialiserDeserialiser(type);
+    if (serdes != NULL)
+    {
+        SerdesContext serdesContext = NULL;
+        int OIR[] = { objectID, objectInstanceID };
+        int len = serdes->StreamObjectInstance ? serdes->StreamObjectInstance(&serdesContext, stream, context, objectID, objectInstanceID)
+                                               : StreamFromTree(serdes, stream, context, OIR, 2);
+        return (len < 0) ? -1 : SerdesStream_GetLength(stream);
+    }
+    Lwm2m_Error("Serialiser not found for type %d\n", type);
+    return -1;
+}
+
+int StreamResource(ContentType type, SerdesStream * stream, Lwm2mContextType * context, ObjectIDType objectID,
+                   ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID)
+{
+    SerialiserDeserialiser * serdes = GetSerialiserDeserialiser(type);
+    if (serdes != NULL)
+    {
+        SerdesContext serdesContext = NULL;
+        int OIR[] = { objectID, objectInstanceID, resourceID };
+        int len = serdes->StreamResource ? serdes->StreamResource(&serdesContext, stream, context, objectID, objectInstanceID, resourceID)
+                                         : StreamFromTree(serdes, stream, context, OIR, 3);
+        return (len < 0) ? -1 : SerdesStream_GetLength(stream);
+    }
+    Lwm2m_Error("Serialiser not found for type %d\n", type);
+    return -1;
+}
@@ -29,6 +29,7 @@ extern "C" {
 #endif
 
 #include <stdint.h>
+#include <stdbool.h>
 
 #include "lwm2m_core.h"
 #include "lwm2m_definition.h"
@@ -37,6 +38,19 @@ extern "C" {
 
 typedef void * SerdesContext;
 
+// Output of a streaming serialiser. The whole encoding is written through the stream, but only the window
+// of Size bytes starting Offset bytes into it is kept in Buffer, so a Block2 transfer can resume part way through.
+typedef struct
+{
+    uint8_t * Buffer;
+    int Size;
+    int Offset;                         // Offset of Buffer[0] within the encoding
+    int Position;                       // Length of the encoding written so far
+    bool More;                          // The encoding continues past the end of the window
+    bool Growable;                      // Buffer is reallocated to hold the whole encoding
+
+} SerdesStream;
+
 typedef struct
 {
     int (*SerialiseObject)(SerdesContext * serdesContext, Lwm2mTreeNode * node, ObjectIDType objectID, uint8_t * buffer, int len);
@@ -45,12 +59,21 @@ typedef struct
     int (*SerialiseResource)(SerdesContext * serdesContext, Lwm2mTreeNode * node, ObjectIDType objectID,
                              ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID, uint8_t * buffer, int len);
 
-    int (*DeserialiseObject)(SerdesContext * serdesContext, Lwm2mTreeNode ** dest, const DefinitionRegistry * registry, ObjectIDType objectID, const uint8_t * buffer, int len);
-    int (*DeserialiseObjectInstance)(SerdesContext * serdesContext, Lwm2mTreeNode ** dest, const DefinitionRegistry * registry,
+    // Deserialised trees are allocated from arena, or with malloc if arena is NULL.
+    int (*DeserialiseObject)(SerdesContext * serdesContext, Lwm2mTreeNode ** dest, Lwm2mTreeArena * arena, const DefinitionRegistry * registry,
+                             ObjectIDType objectID, const uint8_t * buffer, int len);
+    int (*DeserialiseObjectInstance)(SerdesContext * serdesContext, Lwm2mTreeNode ** dest, Lwm2mTreeArena * arena, const DefinitionRegistry * registry,
                                      ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, const uint8_t * buffer, int len);
-    int (*DeserialiseResource)(SerdesContext * serdesContext, Lwm2mTreeNode ** dest,  const DefinitionRegistry * registry,
+    int (*DeserialiseResource)(SerdesContext * serdesContext, Lwm2mTreeNode ** dest, Lwm2mTreeArena * arena, const DefinitionRegistry * registry,
                                ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID, const uint8_t * buffer, int len);
 
+    // Stream serialisers read values from the store as they encode them, rather than from a tree. Return -1 on error.
+    int (*StreamObject)(SerdesContext * serdesContext, SerdesStream * stream, Lwm2mContextType * context, ObjectIDType objectID);
+    int (*StreamObjectInstance)(SerdesContext * serdesContext, SerdesStream * stream, Lwm2mContextType * context,
+                                ObjectIDType objectID, ObjectInstanceIDType objectInstanceID);
+    int (*StreamResource)(SerdesContext * serdesContext, SerdesStream * stream, Lwm2mContextType * context,
+                          ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID);
+
 } SerialiserDeserialiser;
 
 int SerialiseObject(ContentType type, Lwm2mTreeNode * node, ObjectIDType objectID, char * buffer, int len);
@@ -63,6 +86,29 @@ int DeserialiseObjectInstance(ContentType type, Lwm2mTreeNode ** dest, const Def
 int DeserialiseResource(ContentType type, Lwm2mTreeNode ** dest, const DefinitionRegistry * registry, ObjectIDType objectID,
                         ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID, const char * buffer, int bufferLen);
 
+// As above, but the tree is allocated from arena so it can be released with the arena at the end of the request.
+// Deserialisers may leave string and opaque values referring to buffer, so it must outlive the arena.
+int DeserialiseObjectInArena(ContentType type, Lwm2mTreeNode ** dest, Lwm2mTreeArena * arena, const DefinitionRegistry * registry,
+                             ObjectIDType objectID, const char * buffer, int bufferLen);
+int DeserialiseObjectInstanceInArena(ContentType type, Lwm2mTreeNode ** dest, Lwm2mTreeArena * arena, const DefinitionRegistry * registry,
+                                     ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, const char * buffer, int bufferLen);
+int DeserialiseResourceInArena(ContentType type, Lwm2mTreeNode ** dest, Lwm2mTreeArena * arena, const DefinitionRegistry * registry,
+                               ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID, const char * buffer, int bufferLen);
+
+void SerdesStream_Init(SerdesStream * stream, uint8_t * buffer, int size, int offset);
+// Initialise a stream that keeps the whole encoding in a buffer it allocates. More is set if the buffer cannot grow.
+void SerdesStream_InitGrowable(SerdesStream * stream);
+void SerdesStream_Free(SerdesStream * stream);
+void SerdesStream_Write(SerdesStream * stream, const void * data, int length);
+// Return the number of bytes held in the window.
+int SerdesStream_GetLength(const SerdesStream * stream);
+
+// Serialise straight from the store into stream. Return the number of bytes held in the window, negative on failure.
+int StreamObject(ContentType type, SerdesStream * stream, Lwm2mContextType * context, ObjectIDType objectID);
+int StreamObjectInstance(ContentType type, SerdesStream * stream, Lwm2mContextType * context, ObjectIDType objectID, ObjectInstanceIDType objectInstanceID);
+int StreamResource(ContentType type, SerdesStream * stream, Lwm2mContextType * context, ObjectIDType objectID,
+                   ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID);
+
 #ifdef __cplusplus
 }
 #endif
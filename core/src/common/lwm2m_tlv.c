@@ -107,96 +107,232 @@
 #define TLV_TYPE_LENGTH_BITS_MASK       (BIT0|BIT1|BIT2)
 
 /**
- * @brief write a TLV encoded header to the provided buffer
+ * @brief determine the length of a TLV header
  *
- * @param[out] buffer pointer to buffer to write encoded tlv header
- * @param[in] type TLV identifier type, one of: TLV_TYPE_IDENT_OBJECT_INSTANCE,
- *                                              TLV_TYPE_IDENT_MULTI_RESOURCE_VALUE,
- *                                              TLV_TYPE_IDENT_MULTIPLE_RESOURCE,
- *                                              TLV_TYPE_IDENT_RESOURCE_VALUE
  * @param[in] identifier identifier value 0-65535
- * @param[in] length length of data in data section that is to follow the header
- * @return int length of header/index of value
+ * @param[in] length length of data in data section that is to follow the header, 0 - 0xffffff
+ * @return int length of header
  */
-static int TlvEncodeHeader(uint8_t * buffer, int type, uint16_t identifier, int length)
+static int TlvGetHeaderLength(uint16_t identifier, int length)
 {
-    int lengthIndex, valueIndex;
+    int headerLength = (identifier <= 0xff) ? 2 : 3;
 
-    if (buffer == NULL)
+    if (length > 0xffff)
     {
-        Lwm2m_Error("Output buffer cannot be NULL\n");
-        return -1;
+        headerLength += 3;
+    }
+    else if (length > 0xff)
+    {
+        headerLength += 2;
+    }
+    else if (length > TLV_TYPE_LENGTH_BITS_MASK)
+    {
+        headerLength += 1;
     }
+    return headerLength;
+}
+
+/**
+ * @brief write a TLV header without any checks - the caller must have validated the length
+ * and ensured there is room in the buffer for it (see TlvGetHeaderLength)
+ *
+ * @param[out] buffer pointer to buffer to write encoded tlv header
+ * @param[in] type TLV identifier type
+ * @param[in] identifier identifier value 0-65535
+ * @param[in] length length of data in data section that is to follow the header, 0 - 0xffffff
+ * @return pointer to the byte following the header
+ */
+static uint8_t * TlvWriteHeader(uint8_t * buffer, int type, uint16_t identifier, int length)
+{
+    uint8_t * typeByte = buffer++;
 
     // set type bits 7-6
-    buffer[0] = type & TLV_TYPE_IDENT_MASK;
+    *typeByte = type & TLV_TYPE_IDENT_MASK;
 
-    // determine identifier length and pack it into the output buffer
+    // identifier in big endian, 8 or 16 bits
     if (identifier <= 0xff)
     {
-        buffer[0] |= TLV_TYPE_IDENT_LENGTH_8BIT;
-        buffer[1] = identifier;
-        lengthIndex = 2;
+        *typeByte |= TLV_TYPE_IDENT_LENGTH_8BIT;
     }
     else
     {
-        buffer[0] |= TLV_TYPE_IDENT_LENGTH_16BIT;
-        // 16 bit identifier in big endian
-        buffer[1] = (identifier >> 8);
-        buffer[2] = identifier;
-        lengthIndex = 3;
+        *typeByte |= TLV_TYPE_IDENT_LENGTH_16BIT;
+        *buffer++ = identifier >> 8;
     }
+    *buffer++ = identifier;
 
-    // determine type of length
-    if (length > 0xffffff)
+    // length in big endian, or in bits 0-2 of the type if it fits
+    if (length > 0xffff)
     {
-        // ERROR: length exceeds 24 bits
-        Lwm2m_Error("Length exceeds 24 bits\n");
-        return -1;
+        *typeByte |= TLV_TYPE_LENGTH_24BIT;
+        *buffer++ = (length >> 16) & 0xff;
+        *buffer++ = (length >> 8) & 0xff;
+        *buffer++ = length & 0xff;
     }
-    else if (length > 0xffff)
+    else if (length > 0xff)
     {
-        buffer[0] |= TLV_TYPE_LENGTH_24BIT;
-        // 24 bit length in big endian (network byte order)
-        buffer[lengthIndex] = (length >> 16) & 0xff;
-        buffer[lengthIndex + 1] = (length >> 8) & 0xff;
-        buffer[lengthIndex + 2] = length & 0xff;
-
-        valueIndex = lengthIndex + 3;
+        *typeByte |= TLV_TYPE_LENGTH_16BIT;
+        *buffer++ = (length >> 8) & 0xff;
+        *buffer++ = length & 0xff;
     }
-    else if (length > 0xff)
+    else if (length > TLV_TYPE_LENGTH_BITS_MASK)
+    {
+        *typeByte |= TLV_TYPE_LENGTH_8BIT;
+        *buffer++ = length;
+    }
+    else
     {
-        buffer[0] |= TLV_TYPE_LENGTH_16BIT;
-        // 16 bit length in big endian
-        buffer[lengthIndex] = (length >> 8) & 0xff;
-        buffer[lengthIndex + 1] = length & 0xff;
+        *typeByte |= TLV_TYPE_LENGTH_NONE | (length & TLV_TYPE_LENGTH_BITS_MASK);
+    }
+    return buffer;
+}
 
-        valueIndex = lengthIndex + 2;
+/**
+ * @brief determine the minimum number of bytes required to encode an integer: 1, 2, 4 or 8
+ */
+static int TlvGetIntegerLength(int64_t value)
+{
+    int intSize;
+
+    if (value >= -128 && value <= 127)
+    {
+        intSize = 1;
     }
-    else if (length > TLV_TYPE_LENGTH_BITS_MASK)
+    else if (value >= -32768 && value <= 32767)
+    {
+        intSize = 2;
+    }
+    else if (value >= -2147483647 && value <= 2147483647)
     {
-        // 8 bit length
-        buffer[0] |= TLV_TYPE_LENGTH_8BIT;
-        buffer[lengthIndex] = length;
+        intSize = 4;
+    }
+    else
+    {
+        intSize = 8;
+    }
+    return intSize;
+}
 
-        valueIndex = lengthIndex + 1;
+/**
+ * @brief write an integer value (excluding the header) in network byte order
+ *
+ * @param[out] buffer pointer to buffer to write the value
+ * @param[in] value integer 8-64 bit
+ * @param[in] intSize number of bytes to write, from TlvGetIntegerLength
+ * @return pointer to the byte following the value
+ */
+static uint8_t * TlvWriteInteger(uint8_t * buffer, int64_t value, int intSize)
+{
+    int i;
+
+#ifdef LWM2M_V1_0
+    bool negative = (value < 0);
+
+    // remove any sign extension from value
+    uint64_t uValue = (negative) ? -value : value;
+
+    for (i = 0; i < intSize; i++)
+    {
+        buffer[(intSize - 1) - i] = (uValue >> (8 * i)) & 0xff;
+    }
+
+    if (negative)
+    {
+        // as per the LWM2M spec, set the most significant bit to 1 for negative
+        // integers
+        buffer[0] |= 0x80;
     }
-    else if (length >= 0)
+#else
+    for (i = 0; i < intSize; i++)
     {
-        // in the case where the length will fit in 3 bits, use bits 0-2
-        buffer[0] |= TLV_TYPE_LENGTH_NONE;
-        buffer[0] |= (length & TLV_TYPE_LENGTH_BITS_MASK);
+        buffer[(intSize - 1) - i] = (value >> (8 * i)) & 0xff;
+    }
+#endif
+    return buffer + intSize;
+}
 
-        valueIndex = lengthIndex;
+/**
+ * @brief determine the number of bytes required to encode a float: 4 if it can be held
+ * as a binary32 without losing precision, otherwise 8
+ */
+static int TlvGetFloatLength(double value)
+{
+    return (float)value != value ? 8 : 4;
+}
+
+/**
+ * @brief write a float value (excluding the header) as an IEEE 754 binary32 or binary64
+ *
+ * @param[out] buffer pointer to buffer to write the value
+ * @param[in] value float/double 32 or 64 bit
+ * @param[in] floatSize number of bytes to write, from TlvGetFloatLength
+ * @return pointer to the byte following the value
+ */
+static uint8_t * TlvWriteFloat(uint8_t * buffer, double value, int floatSize)
+{
+    if (floatSize == 4)
+    {
+        float f = value;
+        int32_t temp = htonl(*(uint32_t*)&f);
+        memcpy(buffer, &temp, floatSize);
     }
     else
+    {
+        int64_t temp = htonll(*(uint64_t*)&value);
+        memcpy(buffer, &temp, floatSize);
+    }
+    return buffer + floatSize;
+}
+
+/**
+ * @brief write an object link value (excluding the header): ObjectID then ObjectInstanceID, 16 bits each
+ *
+ * @return pointer to the byte following the value
+ */
+static uint8_t * TlvWriteObjectLink(uint8_t * buffer, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID)
+{
+    buffer[0] = (objectID >> 8) & 0xff;
+    buffer[1] = objectID & 0xff;
+    buffer[2] = (objectInstanceID >> 8) & 0xff;
+    buffer[3] = objectInstanceID & 0xff;
+    return buffer + 4;
+}
+
+/**
+ * @brief write a TLV encoded header to the provided buffer
+ *
+ * @param[out] buffer pointer to buffer to write encoded tlv header
+ * @param[in] type TLV identifier type, one of: TLV_TYPE_IDENT_OBJECT_INSTANCE,
+ *                                              TLV_TYPE_IDENT_MULTI_RESOURCE_VALUE,
+ *                                              TLV_TYPE_IDENT_MULTIPLE_RESOURCE,
+ *                                              TLV_TYPE_IDENT_RESOURCE_VALUE
+ * @param[in] identifier identifier value 0-65535
+ * @param[in] length length of data in data section that is to follow the header
+ * @return int length of header/index of value
+ */
+static int TlvEncodeHeader(uint8_t * buffer, int type, uint16_t identifier, int length)
+{
+    if (buffer == NULL)
+    {
+        Lwm2m_Error("Output buffer cannot be NULL\n");
+        return -1;
+    }
+
+    if (length > 0xffffff)
+    {
+        // ERROR: length exceeds 24 bits
+        Lwm2m_Error("Length exceeds 24 bits\n");
+        return -1;
+    }
+
+    if (length < 0)
     {
         // ERROR: negative length
         Lwm2m_Error("Length is negative\n");
         return -1;
     }
 
-    return valueIndex;
+    return TlvWriteHeader(buffer, type, identifier, length) - buffer;
 }
 
 /**
@@ -215,30 +351,28 @@ static int TlvEncodeHeader(uint8_t * buffer, int type, uint16_t identifier, int
  */
 static int TlvEncodeOpaque(uint8_t * buffer, int bufferLen, int type, int id, uint8_t * value, int len)
 {
-    uint8_t header[TLV_MAX_HEADER_SIZE];
-    int headerLen;
-
     if ((buffer == NULL) || (len > 0 && value == NULL))
     {
         Lwm2m_Error("Input or output buffers cannot be NULL\n");
         return -1;
     }
 
-    headerLen = TlvEncodeHeader(&header[0], type, id, len);
-    if (headerLen == -1)
+    if ((len < 0) || (len > 0xffffff))
     {
         Lwm2m_Error("Failed to encode TLV header\n");
         return -1;
     }
 
+    int headerLen = TlvGetHeaderLength(id, len);
     if (bufferLen < (headerLen + len))
     {
         Lwm2m_Error("Output buffer is too small to encode data\n");
         return -1;
     }
 
+    // the value may already be in the buffer, so move it before writing the header over it
     memmove(buffer + headerLen, value, len);
-    memcpy(buffer, header, headerLen);
+    TlvWriteHeader(buffer, type, id, len);
     return headerLen + len;
 }
 
@@ -261,54 +395,10 @@ static int TlvEncodeOpaque(uint8_t * buffer, int bufferLen, int type, int id, ui
  */
 static int TlvEncodeInteger(uint8_t * buffer, int bufferLen, int type, int id, int64_t value)
 {
-    uint8_t valueBuffer[sizeof(int64_t)] = {0};  // allow up to 64bit ints
-    int intSize, i;
- 
-#ifdef LWM2M_V1_0   
-    bool negative = (value < 0);
-
-    // remove any sign extension from value
-    uint64_t uValue = (negative) ? -value : value;
-#endif
-
-    // determine minimum number of bytes required to encode the provided value
-    if (value >= -128 && value <= 127)
-    {
-        intSize = 1;
-    }
-    else if (value >= -32768 && value <= 32767)
-    {
-        intSize = 2;
-    }
-    else if (value >= -2147483647 && value <= 2147483647)
-    {
-        intSize = 4;
-    }
-    else
-    {
-        intSize = 8;
-    }
-
-#ifdef LWM2M_V1_0
-    // serialise the integer value, in network byte order
-    for (i = 0; i < intSize; i++)
-    {
-        valueBuffer[(intSize - 1) - i] = (uValue >> (8 * i)) & 0xff;
-    }
+    uint8_t valueBuffer[sizeof(int64_t)];
+    int intSize = TlvGetIntegerLength(value);
 
-    if (negative)
-    {
-        // as per the LWM2M spec, set the most significant bit to 1 for negative
-        // integers
-        valueBuffer[0] |= 0x80;
-    }
-#else
-    // serialise the integer value, in network byte order
-    for (i = 0; i < intSize; i++)
-    {
-        valueBuffer[(intSize - 1) - i] = (value >> (8 * i)) & 0xff;
-    }
-#endif
+    TlvWriteInteger(valueBuffer, value, intSize);
 
     // once encoded, we can just treat this as opaque
     return TlvEncodeOpaque(buffer, bufferLen, type, id, valueBuffer, intSize);
@@ -336,19 +426,10 @@ static int TlvEncodeFloat(uint8_t * buffer, int bufferLen, int type, int id, dou
     uint8_t valueBuffer[sizeof(uint64_t)];
 
     // decision to use float or double depends on magnitude and precision.
-    int floatSize = (float)value != value ? 8 : 4;
+    int floatSize = TlvGetFloatLength(value);
+
+    TlvWriteFloat(valueBuffer, value, floatSize);
 
-    if (floatSize == 4)
-    {
-        float f = value;
-        int32_t temp = htonl(*(uint32_t*)&f);
-        memcpy(valueBuffer, &temp, floatSize);
-    }
-    else if (floatSize == 8)
-    {
-        int64_t temp = htonll(*(uint64_t*)&value);
-        memcpy(valueBuffer, &temp, floatSize);
-    }
     // once encoded, we can just treat this as opaque
     return TlvEncodeOpaque(buffer, bufferLen, type, id, valueBuffer, floatSize);
 }
@@ -397,10 +478,7 @@ static int TlvEncodeObjectLink(uint8_t * buffer, int bufferLen, int type, int id
 {
     uint8_t valueBuffer[4];
 
-    valueBuffer[0] = (objectID >> 8) & 0xff;
-    valueBuffer[1] = objectID & 0xff;
-    valueBuffer[2] = (objectInstanceID >> 8) & 0xff;
-    valueBuffer[3] = objectInstanceID & 0xff;
+    TlvWriteObjectLink(valueBuffer, objectID, objectInstanceID);
 
     return TlvEncodeOpaque(buffer, bufferLen, type, id, valueBuffer, sizeof(valueBuffer));
 }
@@ -623,34 +701,83 @@ static int TlvDecodeObjectLink(AwaObjectID * objectID, AwaObjectInstanceID * obj
 }
 
 /**
- * @brief write a TLV encoded resource instance to the buffer provided
+ * @brief read an integer or time resource instance value from the object store or a tree node
+ *
+ * @param[in] value resource instance value
+ * @param[in] size length of value, 1, 2, 4 or 8 bytes
+ * @param[out] result value read
+ * @return true on success, false if size is invalid
+ */
+static bool TlvGetIntegerValue(uint8_t * value, uint16_t size, int64_t * result)
+{
+    switch (size)
+    {
+        case sizeof(int8_t):
+            *result = ptrToInt8(value);
+            break;
+        case sizeof(int16_t):
+            *result = ptrToInt16(value);
+            break;
+        case sizeof(int32_t):
+            *result = ptrToInt32(value);
+            break;
+        case sizeof(int64_t):
+            *result = ptrToInt64(value);
+            break;
+        default:
+            Lwm2m_Error("Invalid length for integer: %d\n", size);
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief read a float resource instance value from the object store or a tree node
+ *
+ * @param[in] value resource instance value
+ * @param[in] size length of value, 4 or 8 bytes
+ * @param[out] result value read
+ * @return true on success, false if size is invalid
+ */
+static bool TlvGetFloatValue(uint8_t * value, uint16_t size, double * result)
+{
+    switch (size)
+    {
+        case sizeof(float):
+            *result = *(float*)value;
+            break;
+        case sizeof(double):
+            *result = *(double*)value;
+            break;
+        default:
+            Lwm2m_Error("Invalid length for float: %d\n", size);
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief write a TLV encoded resource instance value to the buffer provided
  *
- * @param[in] node tree node containing resource instance value from the object store
  * @param[in] definition format of the resource containing this resource instance
  * @param[in] objectID
  * @param[in] objectInstanceID
  * @param[in] resourceID
  * @param[in] resourceInstanceID
+ * @param[in] value resource instance value from the object store
+ * @param[in] size length of value
  * @param[out] buffer pointer to buffer to store resulting data
  * @param[in] len length of buffer
  * @return int length of serialised data, or -1 on error
  */
-static int TlvSerialiseResourceInstance(Lwm2mTreeNode * node, ResourceDefinition * definition, ObjectIDType objectID,
-                                        ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID, ResourceInstanceIDType resourceInstanceID, uint8_t * buffer, int len)
+static int TlvEncodeResourceInstanceValue(ResourceDefinition * definition, ObjectIDType objectID, ObjectInstanceIDType objectInstanceID,
+                                          ResourceIDType resourceID, ResourceInstanceIDType resourceInstanceID, uint8_t * value, uint16_t size,
+                                          uint8_t * buffer, int len)
 {
-    if (Lwm2mTreeNode_GetType(node) != Lwm2mTreeNodeType_ResourceInstance)
-    {
-       Lwm2m_Error("Resource Instance node type expected. Received %d\n", Lwm2mTreeNode_GetType(node));
-       return -1;
-    }
-
     int valueLength = -1;
     int id;
     int type;
-    uint16_t size;
-    uint8_t * value;
 
-    value = (uint8_t *)Lwm2mTreeNode_GetValue(node, &size);
     if (value == NULL)
     {
         switch (definition->Type)
@@ -686,37 +813,22 @@ static int TlvSerialiseResourceInstance(Lwm2mTreeNode * node, ResourceDefinition
 
         case AwaResourceType_Time: // no break
         case AwaResourceType_Integer:
-            switch (size)
             {
-                case sizeof(int8_t):
-                    valueLength = TlvEncodeInteger(buffer, len, type, id, ptrToInt8(value));
-                    break;
-                case sizeof(int16_t):
-                    valueLength = TlvEncodeInteger(buffer, len, type, id, ptrToInt16(value));
-                    break;
-                case sizeof(int32_t):
-                    valueLength = TlvEncodeInteger(buffer, len, type, id, ptrToInt32(value));
-                    break;
-                case sizeof(int64_t):
-                    valueLength = TlvEncodeInteger(buffer, len, type, id, ptrToInt64(value));
-                    break;
-                default:
-                    break;
+                int64_t temp;
+                if (TlvGetIntegerValue(value, size, &temp))
+                {
+                    valueLength = TlvEncodeInteger(buffer, len, type, id, temp);
+                }
             }
             break;
 
         case AwaResourceType_Float:
-            switch (size)
             {
-                case sizeof(float):
-                    valueLength = TlvEncodeFloat(buffer, len, type, id, *(float*)value);
-                    break;
-                case sizeof(double):
-                    valueLength = TlvEncodeFloat(buffer, len, type, id, *(double*)value);
-                    break;
-                default:
-                    Lwm2m_Error("Invalid length for float: %d\n", size);
-                    break;
+                double temp;
+                if (TlvGetFloatValue(value, size, &temp))
+                {
+                    valueLength = TlvEncodeFloat(buffer, len, type, id, temp);
+                }
             }
             break;
 
@@ -740,83 +852,196 @@ static int TlvSerialiseResourceInstance(Lwm2mTreeNode * node, ResourceDefinition
     return valueLength;
 }
 
+/*
+ * Trees are serialised straight into the output buffer. Headers that hold the length of
+ * nested content (object instances and multiple resources) are written after measuring that
+ * content, so nothing has to be moved once it is written.
+ */
+
 /**
- * @brief write a TLV encoded resource to the buffer provided
+ * @brief determine the TLV encoded length of a resource instance value, excluding its header
  *
- * @param[in] tree node containing resource from the object store
- * @param[in] objectID
- * @param[in] objectInstanceID
- * @param[in] resourceID
- * @param[out] buffer pointer to buffer to store resulting data
- * @param[in] len length of buffer
- * @return int length of serialised data, or -1 on error
+ * @param[in] definition format of the resource containing this resource instance
+ * @param[in] value resource instance value, may be NULL for an empty string or opaque value
+ * @param[in] size length of value
+ * @return int length of encoded value, or -1 if it cannot be encoded
  */
-static int TlvSerialiseResource(SerdesContext * serdesContext, Lwm2mTreeNode * node, const ObjectIDType objectID,
-                                ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID, uint8_t * buffer, int len)
+static int TlvGetValueLength(ResourceDefinition * definition, uint8_t * value, uint16_t size)
 {
-    int resourceLength = 0;
-
-    if (Lwm2mTreeNode_GetType(node) != Lwm2mTreeNodeType_Resource)
-    {
-       Lwm2m_Error("Resource node type expected. Received %d\n", Lwm2mTreeNode_GetType(node));
-       return -1;
-    }
-
-    ResourceDefinition * definition = (ResourceDefinition*)Lwm2mTreeNode_GetDefinition(node);
+    int valueLength = -1;
 
-    if (definition == NULL)
+    if (value == NULL)
     {
-        Lwm2m_Error("No resource definition for Object %d Instance %d Resource %d\n", objectID, objectInstanceID, resourceID);
-        return -1;
+        return ((definition->Type == AwaResourceType_String) || (definition->Type == AwaResourceType_Opaque)) ? 0 : -1;
     }
 
-    Lwm2mTreeNode * child = Lwm2mTreeNode_GetFirstChild(node);
-    while (child != NULL)
+    switch (definition->Type)
     {
-       int resourceInstanceID;
-       Lwm2mTreeNode_GetID(child, &resourceInstanceID);
+        case AwaResourceType_Boolean:
+            valueLength = TlvGetIntegerLength(*(bool*)value);
+            break;
 
-       int valueLength = TlvSerialiseResourceInstance(child, definition, objectID, objectInstanceID, resourceID, resourceInstanceID, &buffer[resourceLength], len - resourceLength);
-       if (valueLength <= 0)
-       {
-           Lwm2m_Error("Failed to serialise resource instance /%d/%d/%d/%d valueLength = %d\n", objectID, objectInstanceID, resourceID, resourceInstanceID, valueLength);
-           return -1;
-       }
-       resourceLength += valueLength;
-       child = Lwm2mTreeNode_GetNextChild(node, child);
+        case AwaResourceType_Time: // no break
+        case AwaResourceType_Integer:
+            {
+                int64_t temp;
+                if (TlvGetIntegerValue(value, size, &temp))
+                {
+                    valueLength = TlvGetIntegerLength(temp);
+                }
+            }
+            break;
+
+        case AwaResourceType_Float:
+            {
+                double temp;
+                if (TlvGetFloatValue(value, size, &temp))
+                {
+                    valueLength = TlvGetFloatLength(temp);
+                }
+            }
+            break;
+
+        case AwaResourceType_String:
+        case AwaResourceType_Opaque:
+            valueLength = size;
+            break;
+
+        case AwaResourceType_ObjectLink:
+            valueLength = 4;
+            break;
+
+        default:
+            Lwm2m_Error("Unknown type: %d\n", definition->Type);
+            break;
     }
+    return valueLength;
+}
+
+/**
+ * @brief write a resource instance value measured by TlvGetValueLength, excluding its header
+ *
+ * @param[out] buffer pointer to buffer to write the value
+ * @param[in] definition format of the resource containing this resource instance
+ * @param[in] value resource instance value
+ * @param[in] size length of value
+ * @param[in] valueLength encoded length from TlvGetValueLength
+ * @return pointer to the byte following the value
+ */
+static uint8_t * TlvWriteValue(uint8_t * buffer, ResourceDefinition * definition, uint8_t * value, uint16_t size, int valueLength)
+{
+    switch (definition->Type)
+    {
+        case AwaResourceType_Boolean:
+            buffer = TlvWriteInteger(buffer, *(bool*)value, valueLength);
+            break;
 
+        case AwaResourceType_Time: // no break
+        case AwaResourceType_Integer:
+            {
+                int64_t temp = 0;
+                TlvGetIntegerValue(value, size, &temp);
+                buffer = TlvWriteInteger(buffer, temp, valueLength);
+            }
+            break;
+
+        case AwaResourceType_Float:
+            {
+                double temp = 0;
+                TlvGetFloatValue(value, size, &temp);
+                buffer = TlvWriteFloat(buffer, temp, valueLength);
+            }
+            break;
+
+        case AwaResourceType_ObjectLink:
+            buffer = TlvWriteObjectLink(buffer, ((AwaObjectLink *)value)->ObjectID, ((AwaObjectLink *)value)->ObjectInstanceID);
+            break;
+
+        default:
+            if (valueLength > 0)
+            {
+                memcpy(buffer, value, valueLength);
+                buffer += valueLength;
+            }
+            break;
+    }
+    return buffer;
+}
+
+/**
+ * @brief determine the TLV encoded length of a resource
+ *
+ * @param[in] node tree node containing resource from the object store
+ * @param[in] objectID
+ * @param[in] objectInstanceID
+ * @param[in] resourceID
+ * @param[out] contentLength length of the resource instances, excluding any multiple resource header
+ * @return int length of serialised data, or -1 on error
+ */
+static int TlvMeasureResource(Lwm2mTreeNode * node, ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID, int * contentLength)
+{
+    int resourceLength = 0;
+
+    if (Lwm2mTreeNode_GetType(node) != Lwm2mTreeNodeType_Resource)
+    {
+       Lwm2m_Error("Resource node type expected. Received %d\n", Lwm2mTreeNode_GetType(node));
+       return -1;
+    }
+
+    ResourceDefinition * definition = (ResourceDefinition*)Lwm2mTreeNode_GetDefinition(node);
+
+    if (definition == NULL)
+    {
+        Lwm2m_Error("No resource definition for Object %d Instance %d Resource %d\n", objectID, objectInstanceID, resourceID);
+        return -1;
+    }
+
+    Lwm2mTreeNode * child = Lwm2mTreeNode_GetFirstChild(node);
+    while (child != NULL)
+    {
+        int resourceInstanceID;
+        uint16_t size;
+        Lwm2mTreeNode_GetID(child, &resourceInstanceID);
+
+        if (Lwm2mTreeNode_GetType(child) != Lwm2mTreeNodeType_ResourceInstance)
+        {
+            Lwm2m_Error("Resource Instance node type expected. Received %d\n", Lwm2mTreeNode_GetType(child));
+            return -1;
+        }
+
+        uint8_t * value = (uint8_t *)Lwm2mTreeNode_GetValue(child, &size);
+        int valueLength = TlvGetValueLength(definition, value, size);
+        if (valueLength < 0)
+        {
+            Lwm2m_Error("Failed to serialise resource instance /%d/%d/%d/%d valueLength = %d\n", objectID, objectInstanceID, resourceID, resourceInstanceID, valueLength);
+            return -1;
+        }
+        resourceLength += TlvGetHeaderLength(IS_MULTIPLE_INSTANCE(definition) ? resourceInstanceID : resourceID, valueLength) + valueLength;
+        child = Lwm2mTreeNode_GetNextChild(node, child);
+    }
+
+    *contentLength = resourceLength;
     if (IS_MULTIPLE_INSTANCE(definition))
     {
-       uint8_t header[TLV_MAX_HEADER_SIZE];
-       int headerLen;
-       // Add Mutliple resource instance header
-       headerLen = TlvEncodeHeader(&header[0], TLV_TYPE_IDENT_MULTIPLE_RESOURCE, resourceID, resourceLength);
-       if (headerLen == -1)
-       {
-           Lwm2m_Error("Failed to encode TLV header\n");
-           return -1;
-       }
-       memmove(buffer + headerLen, buffer, resourceLength);
-       memcpy(buffer, header, headerLen);
-       resourceLength += headerLen;
+        if (resourceLength > 0xffffff)
+        {
+            Lwm2m_Error("Length exceeds 24 bits\n");
+            return -1;
+        }
+        resourceLength += TlvGetHeaderLength(resourceID, resourceLength);
     }
     return resourceLength;
 }
 
 /**
- * @brief write a TLV encoded instance to the buffer provided, 
- * this function should be used to encode single instances only
+ * @brief determine the TLV encoded length of the resources of an object instance
  *
  * @param[in] node tree node containing object instance from the object store
  * @param[in] objectID
  * @param[in] objectInstanceID
- * @param[out] buffer pointer to buffer to store resulting data
- * @param[in] len length of buffer
  * @return int length of serialised data, or -1 on error
  */
-static int TlvSerialiseObjectInstance(SerdesContext * serdesContext, Lwm2mTreeNode * node, const ObjectIDType objectID,
-                                      ObjectInstanceIDType objectInstanceID, uint8_t * buffer, int len)
+static int TlvMeasureObjectInstance(Lwm2mTreeNode * node, ObjectIDType objectID, ObjectInstanceIDType objectInstanceID)
 {
     int instanceLength = 0;
 
@@ -830,9 +1055,10 @@ static int TlvSerialiseObjectInstance(SerdesContext * serdesContext, Lwm2mTreeNo
     while (child != NULL)
     {
         int resourceID;
+        int contentLength;
         Lwm2mTreeNode_GetID(child, &resourceID);
 
-        int resourceLength = TlvSerialiseResource(serdesContext, child, objectID, objectInstanceID, resourceID, &buffer[instanceLength], len - instanceLength);
+        int resourceLength = TlvMeasureResource(child, objectID, objectInstanceID, resourceID, &contentLength);
         if (resourceLength <= 0)
         {
             Lwm2m_Error("Failed to serialise resource\n");
@@ -845,6 +1071,173 @@ static int TlvSerialiseObjectInstance(SerdesContext * serdesContext, Lwm2mTreeNo
     return instanceLength;
 }
 
+/**
+ * @brief write a TLV encoded resource, stopping at end
+ *
+ * @param[out] buffer pointer to buffer to write the resource
+ * @param[in] end pointer to the byte following the output buffer
+ * @param[in] node tree node containing resource from the object store
+ * @param[in] objectID
+ * @param[in] objectInstanceID
+ * @param[in] resourceID
+ * @return pointer to the byte following the resource, or NULL on error
+ */
+static uint8_t * TlvWriteResource(uint8_t * buffer, uint8_t * end, Lwm2mTreeNode * node, ObjectIDType objectID,
+                                  ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID)
+{
+    int type = TLV_TYPE_IDENT_RESOURCE_VALUE;
+
+    if (Lwm2mTreeNode_GetType(node) != Lwm2mTreeNodeType_Resource)
+    {
+       Lwm2m_Error("Resource node type expected. Received %d\n", Lwm2mTreeNode_GetType(node));
+       return NULL;
+    }
+
+    ResourceDefinition * definition = (ResourceDefinition*)Lwm2mTreeNode_GetDefinition(node);
+
+    if (definition == NULL)
+    {
+        Lwm2m_Error("No resource definition for Object %d Instance %d Resource %d\n", objectID, objectInstanceID, resourceID);
+        return NULL;
+    }
+
+    if (IS_MULTIPLE_INSTANCE(definition))
+    {
+        // The multiple resource header holds the length of every instance, so measure them first
+        int contentLength;
+        int resourceLength = TlvMeasureResource(node, objectID, objectInstanceID, resourceID, &contentLength);
+        if (resourceLength < 0)
+        {
+            return NULL;
+        }
+        if (resourceLength > end - buffer)
+        {
+            Lwm2m_Error("Output buffer is too small to encode data\n");
+            return NULL;
+        }
+        buffer = TlvWriteHeader(buffer, TLV_TYPE_IDENT_MULTIPLE_RESOURCE, resourceID, contentLength);
+        type = TLV_TYPE_IDENT_MULTI_RESOURCE_VALUE;
+    }
+
+    Lwm2mTreeNode * child = Lwm2mTreeNode_GetFirstChild(node);
+    while (child != NULL)
+    {
+        int resourceInstanceID;
+        uint16_t size;
+        Lwm2mTreeNode_GetID(child, &resourceInstanceID);
+
+        if (Lwm2mTreeNode_GetType(child) != Lwm2mTreeNodeType_ResourceInstance)
+        {
+            Lwm2m_Error("Resource Instance node type expected. Received %d\n", Lwm2mTreeNode_GetType(child));
+            return NULL;
+        }
+
+        uint8_t * value = (uint8_t *)Lwm2mTreeNode_GetValue(child, &size);
+        int valueLength = TlvGetValueLength(definition, value, size);
+        if (valueLength < 0)
+        {
+            Lwm2m_Error("Failed to serialise resource instance /%d/%d/%d/%d valueLength = %d\n", objectID, objectInstanceID, resourceID, resourceInstanceID, valueLength);
+            return NULL;
+        }
+
+        int id = IS_MULTIPLE_INSTANCE(definition) ? resourceInstanceID : resourceID;
+        if (TlvGetHeaderLength(id, valueLength) + valueLength > end - buffer)
+        {
+            Lwm2m_Error("Output buffer is too small to encode data\n");
+            return NULL;
+        }
+        buffer = TlvWriteHeader(buffer, type, id, valueLength);
+        buffer = TlvWriteValue(buffer, definition, value, size, valueLength);
+        child = Lwm2mTreeNode_GetNextChild(node, child);
+    }
+    return buffer;
+}
+
+/**
+ * @brief write the TLV encoded resources of an object instance, stopping at end
+ *
+ * @param[out] buffer pointer to buffer to write the resources
+ * @param[in] end pointer to the byte following the output buffer
+ * @param[in] node tree node containing object instance from the object store
+ * @param[in] objectID
+ * @param[in] objectInstanceID
+ * @return pointer to the byte following the object instance, or NULL on error
+ */
+static uint8_t * TlvWriteObjectInstance(uint8_t * buffer, uint8_t * end, Lwm2mTreeNode * node, ObjectIDType objectID, ObjectInstanceIDType objectInstanceID)
+{
+    if (Lwm2mTreeNode_GetType(node) != Lwm2mTreeNodeType_ObjectInstance)
+    {
+        Lwm2m_Error("Object instance node type expected. Received %d\n", Lwm2mTreeNode_GetType(node));
+        return NULL;
+    }
+
+    Lwm2mTreeNode * child = Lwm2mTreeNode_GetFirstChild(node);
+    while (child != NULL)
+    {
+        int resourceID;
+        Lwm2mTreeNode_GetID(child, &resourceID);
+
+        uint8_t * next = TlvWriteResource(buffer, end, child, objectID, objectInstanceID, resourceID);
+        if ((next == NULL) || (next == buffer))
+        {
+            Lwm2m_Error("Failed to serialise resource\n");
+            return NULL;
+        }
+        buffer = next;
+
+        child = Lwm2mTreeNode_GetNextChild(node, child);
+    }
+    return buffer;
+}
+
+/**
+ * @brief write a TLV encoded resource to the buffer provided
+ *
+ * @param[in] tree node containing resource from the object store
+ * @param[in] objectID
+ * @param[in] objectInstanceID
+ * @param[in] resourceID
+ * @param[out] buffer pointer to buffer to store resulting data
+ * @param[in] len length of buffer
+ * @return int length of serialised data, or -1 on error
+ */
+static int TlvSerialiseResource(SerdesContext * serdesContext, Lwm2mTreeNode * node, const ObjectIDType objectID,
+                                ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID, uint8_t * buffer, int len)
+{
+    if (buffer == NULL)
+    {
+        Lwm2m_Error("Output buffer cannot be NULL\n");
+        return -1;
+    }
+
+    uint8_t * end = TlvWriteResource(buffer, buffer + len, node, objectID, objectInstanceID, resourceID);
+    return (end != NULL) ? (end - buffer) : -1;
+}
+
+/**
+ * @brief write a TLV encoded instance to the buffer provided, 
+ * this function should be used to encode single instances only
+ *
+ * @param[in] node tree node containing object instance from the object store
+ * @param[in] objectID
+ * @param[in] objectInstanceID
+ * @param[out] buffer pointer to buffer to store resulting data
+ * @param[in] len length of buffer
+ * @return int length of serialised data, or -1 on error
+ */
+static int TlvSerialiseObjectInstance(SerdesContext * serdesContext, Lwm2mTreeNode * node, const ObjectIDType objectID,
+                                      ObjectInstanceIDType objectInstanceID, uint8_t * buffer, int len)
+{
+    if (buffer == NULL)
+    {
+        Lwm2m_Error("Output buffer cannot be NULL\n");
+        return -1;
+    }
+
+    uint8_t * end = TlvWriteObjectInstance(buffer, buffer + len, node, objectID, objectInstanceID);
+    return (end != NULL) ? (end - buffer) : -1;
+}
+
 /**
  * @brief write a TLV encoded object to the buffer provided
  *
@@ -856,47 +1249,293 @@ static int TlvSerialiseObjectInstance(SerdesContext * serdesContext, Lwm2mTreeNo
  */
 static int TlvSerialiseObject(SerdesContext * serdesContext, Lwm2mTreeNode * node, const ObjectIDType objectID, uint8_t * buffer, int len)
 {
-    int pos = 0;
-
     if (Lwm2mTreeNode_GetType(node) != Lwm2mTreeNodeType_Object)
     {
         Lwm2m_Error("Object node type expected. Received %d\n", Lwm2mTreeNode_GetType(node));
         return -1;
     }
 
+    if (buffer == NULL)
+    {
+        Lwm2m_Error("Output buffer cannot be NULL\n");
+        return -1;
+    }
+
+    uint8_t * out = buffer;
+    uint8_t * end = buffer + len;
     Lwm2mTreeNode * child = Lwm2mTreeNode_GetFirstChild(node);
     while (child != NULL)
     {
         int objectInstanceID;
-        uint8_t header[TLV_MAX_HEADER_SIZE];
-        int headerLen;
-
         Lwm2mTreeNode_GetID(child, &objectInstanceID);
 
-        int instanceLength = TlvSerialiseObjectInstance(serdesContext, child, objectID, objectInstanceID, &buffer[pos], len - pos);
-        if (instanceLength <= 0)
+        // The object instance header holds the length of the instance, so measure it first
+        int instanceLength = TlvMeasureObjectInstance(child, objectID, objectInstanceID);
+        if ((instanceLength <= 0) || (instanceLength > 0xffffff))
         {
             Lwm2m_Error("Failed to serialise object instance\n");
             return -1;
         }
+        if (TlvGetHeaderLength(objectInstanceID, instanceLength) + instanceLength > end - out)
+        {
+            Lwm2m_Error("Output buffer is too small to encode data\n");
+            return -1;
+        }
+
+        out = TlvWriteHeader(out, TLV_TYPE_IDENT_OBJECT_INSTANCE, objectInstanceID, instanceLength);
+        out = TlvWriteObjectInstance(out, end, child, objectID, objectInstanceID);
+        if (out == NULL)
+        {
+            return -1;
+        }
 
-        // if there are multiple object instances, then we need to add an object instance header.
-        // For single object instances we can skip this step, and exit from the object instance loop.
-        headerLen = TlvEncodeHeader(&header[0], TLV_TYPE_IDENT_OBJECT_INSTANCE, objectInstanceID, instanceLength);
+        child = Lwm2mTreeNode_GetNextChild(node, child);
+    }
+    return out - buffer;
+}
+
+/**
+ * @brief write a TLV encoded resource instance, read from the object store, to the stream provided
+ *
+ * @param[out] stream stream to write to
+ * @param[in] context context holding the object store
+ * @param[in] definition format of the resource containing this resource instance
+ * @param[in] objectID
+ * @param[in] objectInstanceID
+ * @param[in] resourceID
+ * @param[in] resourceInstanceID
+ * @return int length of serialised data, or -1 on error
+ */
+static int TlvStreamResourceInstance(SerdesStream * stream, Lwm2mContextType * context, ResourceDefinition * definition, ObjectIDType objectID,
+                                     ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID, ResourceInstanceIDType resourceInstanceID)
+{
+    const void * value = NULL;
+    size_t size = 0;
+    int valueLength;
+
+    if (Lwm2mCore_GetResourceInstanceValue(context, objectID, objectInstanceID, resourceID, resourceInstanceID, &value, &size) < 0)
+    {
+        Lwm2m_Error("Failed to retrieve resource instance /%d/%d/%d/%d from object store\n", objectID, objectInstanceID, resourceID, resourceInstanceID);
+        return -1;
+    }
+
+    if ((definition->Type == AwaResourceType_String) || (definition->Type == AwaResourceType_Opaque))
+    {
+        // Strings and opaque values are written straight from the store, behind their header
+        uint8_t header[TLV_MAX_HEADER_SIZE];
+        int type = IS_MULTIPLE_INSTANCE(definition) ? TLV_TYPE_IDENT_MULTI_RESOURCE_VALUE : TLV_TYPE_IDENT_RESOURCE_VALUE;
+        int id = IS_MULTIPLE_INSTANCE(definition) ? resourceInstanceID : resourceID;
+
+        int headerLen = TlvEncodeHeader(&header[0], type, id, size);
         if (headerLen == -1)
         {
             Lwm2m_Error("Failed to encode TLV header\n");
             return -1;
         }
 
-        memmove(&buffer[pos] + headerLen, &buffer[pos], instanceLength);
-        memcpy(&buffer[pos], header, headerLen);
+        SerdesStream_Write(stream, header, headerLen);
+        SerdesStream_Write(stream, value, size);
+        valueLength = headerLen + size;
+    }
+    else
+    {
+        uint8_t encoded[TLV_MAX_HEADER_SIZE + sizeof(int64_t)];
+
+        valueLength = TlvEncodeResourceInstanceValue(definition, objectID, objectInstanceID, resourceID, resourceInstanceID,
+                                                     (uint8_t *)value, size, encoded, sizeof(encoded));
+        if (valueLength > 0)
+        {
+            SerdesStream_Write(stream, encoded, valueLength);
+        }
+    }
+    return valueLength;
+}
 
-        pos += (instanceLength + headerLen);
+/**
+ * @brief write the TLV encoded resource instances of a resource, read from the object store, to the stream provided
+ *
+ * @param[out] stream stream to write to
+ * @param[in] context context holding the object store
+ * @param[in] definition format of the resource
+ * @param[in] objectID
+ * @param[in] objectInstanceID
+ * @param[in] resourceID
+ * @return int length of serialised data, or -1 on error
+ */
+static int TlvStreamResourceInstances(SerdesStream * stream, Lwm2mContextType * context, ResourceDefinition * definition, ObjectIDType objectID,
+                                      ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID)
+{
+    if (!IS_MULTIPLE_INSTANCE(definition))
+    {
+        return TlvStreamResourceInstance(stream, context, definition, objectID, objectInstanceID, resourceID, 0);
+    }
 
-        child = Lwm2mTreeNode_GetNextChild(node, child);
+    int resourceLength = 0;
+    ResourceInstanceIDType resourceInstanceID = -1;
+    while ((resourceInstanceID = Lwm2mCore_GetNextResourceInstanceID(context, objectID, objectInstanceID, resourceID, resourceInstanceID)) != -1)
+    {
+        int valueLength = TlvStreamResourceInstance(stream, context, definition, objectID, objectInstanceID, resourceID, resourceInstanceID);
+        if (valueLength <= 0)
+        {
+            Lwm2m_Error("Failed to serialise resource instance /%d/%d/%d/%d valueLength = %d\n", objectID, objectInstanceID, resourceID, resourceInstanceID, valueLength);
+            return -1;
+        }
+        resourceLength += valueLength;
     }
+    return resourceLength;
+}
 
+/**
+ * @brief write a TLV encoded resource, read from the object store, to the stream provided
+ *
+ * @param[out] stream stream to write to
+ * @param[in] context context holding the object store
+ * @param[in] objectID
+ * @param[in] objectInstanceID
+ * @param[in] resourceID
+ * @return int length of serialised data, or -1 on error
+ */
+static int TlvStreamResourceFromStore(SerdesStream * stream, Lwm2mContextType * context, ObjectIDType objectID,
+                                      ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID)
+{
+    ResourceDefinition * definition = Definition_LookupResourceDefinition(Lwm2mCore_GetDefinitions(context), objectID, resourceID);
+    if (definition == NULL)
+    {
+        Lwm2m_Error("No resource definition for Object %d Instance %d Resource %d\n", objectID, objectInstanceID, resourceID);
+        return -1;
+    }
+
+    if (!IS_MULTIPLE_INSTANCE(definition))
+    {
+        return TlvStreamResourceInstances(stream, context, definition, objectID, objectInstanceID, resourceID);
+    }
+
+    // The multiple resource header holds the length of the resource instances, so encode them before writing the
+    // header. Each value is then read only once.
+    SerdesStream instances;
+    SerdesStream_InitGrowable(&instances);
+    int resourceLength = TlvStreamResourceInstances(&instances, context, definition, objectID, objectInstanceID, resourceID);
+
+    uint8_t header[TLV_MAX_HEADER_SIZE];
+    int headerLen = -1;
+    if ((resourceLength >= 0) && !instances.More)
+    {
+        headerLen = TlvEncodeHeader(&header[0], TLV_TYPE_IDENT_MULTIPLE_RESOURCE, resourceID, resourceLength);
+        if (headerLen == -1)
+        {
+            Lwm2m_Error("Failed to encode TLV header\n");
+        }
+        else
+        {
+            SerdesStream_Write(stream, header, headerLen);
+            SerdesStream_Write(stream, instances.Buffer, resourceLength);
+        }
+    }
+    SerdesStream_Free(&instances);
+
+    if (headerLen == -1)
+    {
+        return -1;
+    }
+    return headerLen + resourceLength;
+}
+
+/**
+ * @brief write the TLV encoded resources of an object instance, read from the object store, to the stream provided
+ *
+ * @param[out] stream stream to write to
+ * @param[in] context context holding the object store
+ * @param[in] objectID
+ * @param[in] objectInstanceID
+ * @return int length of serialised data, or -1 on error
+ */
+static int TlvStreamObjectInstanceFromStore(SerdesStream * stream, Lwm2mContextType * context, ObjectIDType objectID, ObjectInstanceIDType objectInstanceID)
+{
+    int instanceLength = 0;
+    ResourceIDType resourceID = -1;
+
+    while ((resourceID = Lwm2mCore_GetNextResourceID(context, objectID, objectInstanceID, resourceID)) != -1)
+    {
+        // Executable resources have no value to read
+        if (Definition_IsResourceTypeExecutable(Lwm2mCore_GetDefinitions(context), objectID, resourceID) != 0)
+        {
+            continue;
+        }
+
+        int resourceLength = TlvStreamResourceFromStore(stream, context, objectID, objectInstanceID, resourceID);
+        if (resourceLength <= 0)
+        {
+            Lwm2m_Error("Failed to serialise resource\n");
+            return -1;
+        }
+        instanceLength += resourceLength;
+
+        if (stream->More)
+        {
+            // The window is full, so the rest of the encoding isn't needed
+            break;
+        }
+    }
+    return instanceLength;
+}
+
+static int TlvStreamResource(SerdesContext * serdesContext, SerdesStream * stream, Lwm2mContextType * context,
+                             ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID)
+{
+    return TlvStreamResourceFromStore(stream, context, objectID, objectInstanceID, resourceID);
+}
+
+static int TlvStreamObjectInstance(SerdesContext * serdesContext, SerdesStream * stream, Lwm2mContextType * context,
+                                   ObjectIDType objectID, ObjectInstanceIDType objectInstanceID)
+{
+    return TlvStreamObjectInstanceFromStore(stream, context, objectID, objectInstanceID);
+}
+
+/**
+ * @brief write a TLV encoded object, read from the object store, to the stream provided
+ *
+ * @param[out] stream stream to write to
+ * @param[in] context context holding the object store
+ * @param[in] objectID
+ * @return int length of serialised data, or -1 on error
+ */
+static int TlvStreamObject(SerdesContext * serdesContext, SerdesStream * stream, Lwm2mContextType * context, ObjectIDType objectID)
+{
+    int pos = 0;
+    ObjectInstanceIDType objectInstanceID = -1;
+
+    while ((objectInstanceID = Lwm2mCore_GetNextObjectInstanceID(context, objectID, objectInstanceID)) != -1)
+    {
+        // The object instance header holds the length of its resources, so encode them before writing the header
+        SerdesStream resources;
+        SerdesStream_InitGrowable(&resources);
+        int instanceLength = TlvStreamObjectInstanceFromStore(&resources, context, objectID, objectInstanceID);
+        if ((instanceLength <= 0) || resources.More)
+        {
+            Lwm2m_Error("Failed to serialise object instance\n");
+            SerdesStream_Free(&resources);
+            return -1;
+        }
+
+        uint8_t header[TLV_MAX_HEADER_SIZE];
+        int headerLen = TlvEncodeHeader(&header[0], TLV_TYPE_IDENT_OBJECT_INSTANCE, objectInstanceID, instanceLength);
+        if (headerLen == -1)
+        {
+            Lwm2m_Error("Failed to encode TLV header\n");
+            SerdesStream_Free(&resources);
+            return -1;
+        }
+
+        SerdesStream_Write(stream, header, headerLen);
+        SerdesStream_Write(stream, resources.Buffer, instanceLength);
+        SerdesStream_Free(&resources);
+        pos += headerLen + instanceLength;
+
+        if (stream->More)
+        {
+            break;
+        }
+    }
     return pos;
 }
 
@@ -907,16 +1546,15 @@ static int TlvSerialiseObject(SerdesContext * serdesContext, Lwm2mTreeNode * nod
  * @param[in] length length of buffer
  * @return int -1 on error
  */
-static int TlvDeserialiseResourceInstance(Lwm2mTreeNode ** dest, const DefinitionRegistry * registry, ObjectIDType objectID,
-                                          ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID, int resID, const uint8_t * buffer, int len)
+static int TlvDeserialiseResourceInstance(Lwm2mTreeNode ** dest, Lwm2mTreeArena * arena, const ResourceDefinition * definition, int resID, const uint8_t * buffer, int len)
 {
     int result = -1;
 
-    *dest = Lwm2mTreeNode_Create();
+    *dest = Lwm2mTreeNode_CreateInArena(arena);
     Lwm2mTreeNode_SetID(*dest, resID);
     Lwm2mTreeNode_SetType(*dest, Lwm2mTreeNodeType_ResourceInstance);
 
-    AwaResourceType resourceType = Definition_GetResourceType(registry, objectID, resourceID);
+    AwaResourceType resourceType = definition->Type;
     switch (resourceType)
     {
         case AwaResourceType_Integer:
@@ -950,13 +1588,9 @@ static int TlvDeserialiseResourceInstance(Lwm2mTreeNode ** dest, const Definitio
             }
             break;
         case AwaResourceType_String:
-            {
-                Lwm2mTreeNode_SetValue(*dest, buffer, len);
-                result = 0;
-            }
-            break;
         case AwaResourceType_Opaque:
-            Lwm2mTreeNode_SetValue(*dest, buffer, len);
+            // Arena trees refer to strings and opaque values in the input buffer rather than copying them
+            Lwm2mTreeNode_SetValueReference(*dest, buffer, len);
             result = 0;
             break;
         case AwaResourceType_ObjectLink:
@@ -985,14 +1619,14 @@ static int TlvDeserialiseResourceInstance(Lwm2mTreeNode ** dest, const Definitio
  * @param[in] length length of buffer
  * @return int -1 on error
  */
-static int TlvDeserialiseResource(SerdesContext * serdesContext, Lwm2mTreeNode ** dest, const DefinitionRegistry * registry,
+static int TlvDeserialiseResource(SerdesContext * serdesContext, Lwm2mTreeNode ** dest, Lwm2mTreeArena * arena, const DefinitionRegistry * registry,
                                   ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID, const uint8_t * buffer, int bufferLen)
 {
     int type, resourceLen, headerLen;
     uint16_t identifier;
     ResourceDefinition * definition;
 
-    *dest = Lwm2mTreeNode_Create();
+    *dest = Lwm2mTreeNode_CreateInArena(arena);
     Lwm2mTreeNode_SetID(*dest, resourceID);
     Lwm2mTreeNode_SetType(*dest, Lwm2mTreeNodeType_Resource);
 
@@ -1022,7 +1656,7 @@ static int TlvDeserialiseResource(SerdesContext * serdesContext, Lwm2mTreeNode *
     if (type == TLV_TYPE_IDENT_RESOURCE_VALUE)
     {
         Lwm2mTreeNode * resourceValueNode;
-        int result = TlvDeserialiseResourceInstance(&resourceValueNode, registry, objectID, objectInstanceID, resourceID, 0, &buffer[headerLen], resourceLen);
+        int result = TlvDeserialiseResourceInstance(&resourceValueNode, arena, definition, 0, &buffer[headerLen], resourceLen);
         if (result != -1)
         {
             Lwm2mTreeNode_AddChild(*dest, resourceValueNode);
@@ -1073,7 +1707,7 @@ static int TlvDeserialiseResource(SerdesContext * serdesContext, Lwm2mTreeNode *
 
             pos += valueIndex;
 
-            result = TlvDeserialiseResourceInstance(&resourceValueNode, registry, objectID, objectInstanceID, resourceID, identifier, &resourceBuffer[pos], length);
+            result = TlvDeserialiseResourceInstance(&resourceValueNode, arena, definition, identifier, &resourceBuffer[pos], length);
 
             if (result == -1)
             {
@@ -1101,12 +1735,12 @@ static int TlvDeserialiseResource(SerdesContext * serdesContext, Lwm2mTreeNode *
  * @param[in] length length of buffer
  * @return int -1 on error
  */
-static int TlvDeserialiseObjectInstance(SerdesContext * serdesContext, Lwm2mTreeNode ** dest, const DefinitionRegistry * registry,
+static int TlvDeserialiseObjectInstance(SerdesContext * serdesContext, Lwm2mTreeNode ** dest, Lwm2mTreeArena * arena, const DefinitionRegistry * registry,
                                         ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, const uint8_t * buffer, int bufferLen)
 {
     int pos = 0;
 
-    *dest = Lwm2mTreeNode_Create();
+    *dest = Lwm2mTreeNode_CreateInArena(arena);
     Lwm2mTreeNode_SetID(*dest, objectInstanceID);
     Lwm2mTreeNode_SetType(*dest, Lwm2mTreeNodeType_ObjectInstance);
 
@@ -1153,7 +1787,7 @@ static int TlvDeserialiseObjectInstance(SerdesContext * serdesContext, Lwm2mTree
         {
             int result;
             Lwm2mTreeNode * resourceNode;
-            result = TlvDeserialiseResource(serdesContext, &resourceNode, registry, objectID, objectInstanceID, identifier, &buffer[pos], bufferLen - pos);
+            result = TlvDeserialiseResource(serdesContext, &resourceNode, arena, registry, objectID, objectInstanceID, identifier, &buffer[pos], bufferLen - pos);
             if (result < 0)
             {
                 Lwm2mTreeNode_DeleteRecursive(resourceNode);
@@ -1180,12 +1814,12 @@ static int TlvDeserialiseObjectInstance(SerdesContext * serdesContext, Lwm2mTree
  * @param[in] length length of buffer
  * @return int -1 on error
  */
-static int TlvDeserialiseObject(SerdesContext * serdesContext, Lwm2mTreeNode ** dest,
+static int TlvDeserialiseObject(SerdesContext * serdesContext, Lwm2mTreeNode ** dest, Lwm2mTreeArena * arena,
         const DefinitionRegistry * registry, ObjectIDType objectID, const uint8_t * buffer, int bufferLen)
 {
     int pos = 0;
     ObjectDefinition * definition;
-    *dest = Lwm2mTreeNode_Create();
+    *dest = Lwm2mTreeNode_CreateInArena(arena);
     Lwm2mTreeNode_SetID(*dest, objectID);
     Lwm2mTreeNode_SetType(*dest, Lwm2mTreeNodeType_Object);
 
@@ -1224,7 +1858,7 @@ static int TlvDeserialiseObject(SerdesContext * serdesContext, Lwm2mTreeNode **
 
             // strip off the object instance header, pass instanceID into function.
             pos += headerLen;
-            result = TlvDeserialiseObjectInstance(serdesContext, &instanceNode, registry, objectID, identifier, &buffer[pos], length);
+            result = TlvDeserialiseObjectInstance(serdesContext, &instanceNode, arena, registry, objectID, identifier, &buffer[pos], length);
 
             if(result > 0)
             {
@@ -1245,7 +1879,7 @@ static int TlvDeserialiseObject(SerdesContext * serdesContext, Lwm2mTreeNode **
                 // case where we receive a "CREATE" with no object instance ID (client should generate it)
                 Lwm2mTreeNode * instanceNode;
                 ObjectInstanceIDType objectInstanceID = -1;  // instance ID will be generated
-                result = TlvDeserialiseObjectInstance(serdesContext, &instanceNode, registry, objectID, objectInstanceID, buffer, bufferLen);
+                result = TlvDeserialiseObjectInstance(serdesContext, &instanceNode, arena, registry, objectID, objectInstanceID, buffer, bufferLen);
                 if (result > 0)
                 {
                     Lwm2mTreeNode_AddChild(*dest, instanceNode);
@@ -1276,5 +1910,8 @@ const SerialiserDeserialiser tlvSerDes =
     .DeserialiseObject         = TlvDeserialiseObject,
     .DeserialiseObjectInstance = TlvDeserialiseObjectInstance,
     .DeserialiseResource       = TlvDeserialiseResource,
+    .StreamObject              = TlvStreamObject,
+    .StreamObjectInstance      = TlvStreamObjectInstance,
+    .StreamResource            = TlvStreamResource,
 };
 
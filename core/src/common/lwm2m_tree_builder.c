@@ -41,11 +41,11 @@
 #include "lwm2m_result.h"
 #include "lwm2m_request_origin.h"
 
-static AwaResult ReadResourceInstanceFromStoreAndCreateTree(Lwm2mTreeNode ** dest, Lwm2mContextType * context, ObjectIDType objectID,
+static AwaResult ReadResourceInstanceFromStoreAndCreateTree(Lwm2mTreeNode ** dest, Lwm2mTreeArena * arena, Lwm2mContextType * context, ObjectIDType objectID,
                                                             ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID, ResourceInstanceIDType resourceInstanceID)
 {
     AwaResult result = AwaResult_Unspecified;
-    *dest = Lwm2mTreeNode_Create();
+    *dest = Lwm2mTreeNode_CreateInArena(arena);
     const void * value = NULL;
     size_t valueLength = 0;
 
@@ -72,11 +72,11 @@ error:
     return result;
 }
 
-AwaResult TreeBuilder_CreateTreeFromResource(Lwm2mTreeNode ** dest, Lwm2mContextType * context, Lwm2mRequestOrigin requestOrigin,
-                                       ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID)
+static AwaResult CreateTreeFromResource(Lwm2mTreeNode ** dest, Lwm2mTreeArena * arena, Lwm2mContextType * context, Lwm2mRequestOrigin requestOrigin,
+                                        ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID)
 {
     AwaResult result = AwaResult_Unspecified;
-    *dest = Lwm2mTreeNode_Create();
+    *dest = Lwm2mTreeNode_CreateInArena(arena);
     Lwm2mTreeNode_SetID(*dest, resourceID);
     Lwm2mTreeNode_SetType(*dest, Lwm2mTreeNodeType_Resource);
     ResourceDefinition * definition = Definition_LookupResourceDefinition(Lwm2mCore_GetDefinitions(context), objectID, resourceID);
@@ -109,7 +109,7 @@ AwaResult TreeBuilder_CreateTreeFromResource(Lwm2mTreeNode ** dest, Lwm2mContext
         {
             Lwm2mTreeNode * resourceValueNode;
 
-            if ((result = ReadResourceInstanceFromStoreAndCreateTree(&resourceValueNode, context, objectID, objectInstanceID, resourceID, resourceInstanceID)) == AwaResult_Success)
+            if ((result = ReadResourceInstanceFromStoreAndCreateTree(&resourceValueNode, arena, context, objectID, objectInstanceID, resourceID, resourceInstanceID)) == AwaResult_Success)
             {
                 Lwm2mTreeNode_AddChild(*dest, resourceValueNode);
             }
@@ -125,7 +125,7 @@ AwaResult TreeBuilder_CreateTreeFromResource(Lwm2mTreeNode ** dest, Lwm2mContext
     {
         Lwm2mTreeNode * resourceValueNode;
         int resourceInstanceID = 0;
-        if ((result = ReadResourceInstanceFromStoreAndCreateTree(&resourceValueNode, context, objectID, objectInstanceID, resourceID, resourceInstanceID)) == AwaResult_Success)
+        if ((result = ReadResourceInstanceFromStoreAndCreateTree(&resourceValueNode, arena, context, objectID, objectInstanceID, resourceID, resourceInstanceID)) == AwaResult_Success)
         {
             Lwm2mTreeNode_AddChild(*dest, resourceValueNode);
         }
@@ -141,11 +141,11 @@ error:
     return result;
 }
 
-int TreeBuilder_CreateTreeFromObjectInstance(Lwm2mTreeNode ** dest, Lwm2mContextType * context, Lwm2mRequestOrigin requestOrigin,
-                                             ObjectIDType objectID, ObjectInstanceIDType objectInstanceID)
+static AwaResult CreateTreeFromObjectInstance(Lwm2mTreeNode ** dest, Lwm2mTreeArena * arena, Lwm2mContextType * context, Lwm2mRequestOrigin requestOrigin,
+                                              ObjectIDType objectID, ObjectInstanceIDType objectInstanceID)
 {
     AwaResult result = AwaResult_Success;
-    *dest = Lwm2mTreeNode_Create();
+    *dest = Lwm2mTreeNode_CreateInArena(arena);
     Lwm2mTreeNode_SetID(*dest, objectInstanceID);
     Lwm2mTreeNode_SetType(*dest, Lwm2mTreeNodeType_ObjectInstance);
 
@@ -157,7 +157,7 @@ int TreeBuilder_CreateTreeFromObjectInstance(Lwm2mTreeNode ** dest, Lwm2mContext
         {
             Lwm2mTreeNode * resourceNode;
 
-            if ((result = TreeBuilder_CreateTreeFromResource(&resourceNode, context, requestOrigin, objectID, objectInstanceID, resourceID)) == AwaResult_Success)
+            if ((result = CreateTreeFromResource(&resourceNode, arena, context, requestOrigin, objectID, objectInstanceID, resourceID)) == AwaResult_Success)
             {
                 Lwm2mTreeNode_AddChild(*dest, resourceNode);
             }
@@ -178,10 +178,10 @@ int TreeBuilder_CreateTreeFromObjectInstance(Lwm2mTreeNode ** dest, Lwm2mContext
     return result;
 }
 
-int TreeBuilder_CreateTreeFromObject(Lwm2mTreeNode ** dest, Lwm2mContextType * context, Lwm2mRequestOrigin requestOrigin, ObjectIDType objectID)
+static AwaResult CreateTreeFromObject(Lwm2mTreeNode ** dest, Lwm2mTreeArena * arena, Lwm2mContextType * context, Lwm2mRequestOrigin requestOrigin, ObjectIDType objectID)
 {
     AwaResult result = AwaResult_Success;
-    *dest = Lwm2mTreeNode_Create();
+    *dest = Lwm2mTreeNode_CreateInArena(arena);
     Lwm2mTreeNode_SetID(*dest, objectID);
     Lwm2mTreeNode_SetType(*dest, Lwm2mTreeNodeType_Object);
 
@@ -205,7 +205,7 @@ int TreeBuilder_CreateTreeFromObject(Lwm2mTreeNode ** dest, Lwm2mContextType * c
     while ((instanceID = Lwm2mCore_GetNextObjectInstanceID(context, objectID, instanceID)) != -1)
     {
         Lwm2mTreeNode * objectInstanceNode;
-        if ((result = TreeBuilder_CreateTreeFromObjectInstance(&objectInstanceNode, context, requestOrigin, objectID, instanceID)) == AwaResult_Success)
+        if ((result = CreateTreeFromObjectInstance(&objectInstanceNode, arena, context, requestOrigin, objectID, instanceID)) == AwaResult_Success)
         {
             Lwm2mTreeNode_AddChild(*dest, objectInstanceNode);
         }
@@ -226,22 +226,45 @@ error:
     return result;
 }
 
+AwaResult TreeBuilder_CreateTreeFromResource(Lwm2mTreeNode ** dest, Lwm2mContextType * context, Lwm2mRequestOrigin requestOrigin,
+                                       ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID)
+{
+    return CreateTreeFromResource(dest, NULL, context, requestOrigin, objectID, objectInstanceID, resourceID);
+}
+
+AwaResult TreeBuilder_CreateTreeFromObjectInstance(Lwm2mTreeNode ** dest, Lwm2mContextType * context, Lwm2mRequestOrigin requestOrigin,
+                                             ObjectIDType objectID, ObjectInstanceIDType objectInstanceID)
+{
+    return CreateTreeFromObjectInstance(dest, NULL, context, requestOrigin, objectID, objectInstanceID);
+}
+
+AwaResult TreeBuilder_CreateTreeFromObject(Lwm2mTreeNode ** dest, Lwm2mContextType * context, Lwm2mRequestOrigin requestOrigin, ObjectIDType objectID)
+{
+    return CreateTreeFromObject(dest, NULL, context, requestOrigin, objectID);
+}
+
 AwaResult TreeBuilder_CreateTreeFromOIR(Lwm2mTreeNode ** dest, Lwm2mContextType * context, Lwm2mRequestOrigin requestOrigin, int OIR[], int OIRLength)
+{
+    return TreeBuilder_CreateTreeFromOIRInArena(dest, NULL, context, requestOrigin, OIR, OIRLength);
+}
+
+AwaResult TreeBuilder_CreateTreeFromOIRInArena(Lwm2mTreeNode ** dest, Lwm2mTreeArena * arena, Lwm2mContextType * context, Lwm2mRequestOrigin requestOrigin,
+                                               int OIR[], int OIRLength)
 {
     AwaResult result = AwaResult_Unspecified;
     if (dest != NULL)
     {
         if (OIRLength == 1)
         {
-            result = TreeBuilder_CreateTreeFromObject(dest, context, requestOrigin, OIR[0]);
+            result = CreateTreeFromObject(dest, arena, context, requestOrigin, OIR[0]);
         }
         else if (OIRLength == 2)
         {
-            result = TreeBuilder_CreateTreeFromObjectInstance(dest, context, requestOrigin, OIR[0], OIR[1]);
+            result = CreateTreeFromObjectInstance(dest, arena, context, requestOrigin, OIR[0], OIR[1]);
         }
         else if (OIRLength == 3)
         {
-            result = TreeBuilder_CreateTreeFromResource(dest, context, requestOrigin, OIR[0], OIR[1], OIR[2]);
+            result = CreateTreeFromResource(dest, arena, context, requestOrigin, OIR[0], OIR[1], OIR[2]);
         }
         else
         {
@@ -258,3 +281,85 @@ AwaResult TreeBuilder_CreateTreeFromOIR(Lwm2mTreeNode ** dest, Lwm2mContextType
 
     return result;
 }
+
+static AwaResult CheckReadableResource(Lwm2mContextType * context, Lwm2mRequestOrigin requestOrigin,
+                                       ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID)
+{
+    AwaResult result = AwaResult_Success;
+    ResourceDefinition * definition = Definition_LookupResourceDefinition(Lwm2mCore_GetDefinitions(context), objectID, resourceID);
+
+    if (definition == NULL)
+    {
+        Lwm2m_Error("ERROR: Failed to determine resource definition Object %d Resource %d\n", objectID, resourceID);
+        result = AwaResult_NotFound;
+    }
+    else if (requestOrigin == Lwm2mRequestOrigin_Server && !Operations_IsResourceTypeReadable(definition->Operation))
+    {
+        Lwm2m_Error("ERROR: Request origin is server and resource operation is %d\n", definition->Operation);
+        result = AwaResult_MethodNotAllowed;
+    }
+    return result;
+}
+
+static AwaResult CheckReadableObjectInstance(Lwm2mContextType * context, Lwm2mRequestOrigin requestOrigin,
+                                             ObjectIDType objectID, ObjectInstanceIDType objectInstanceID)
+{
+    AwaResult result = AwaResult_NotFound;
+    int resourceID = -1;
+
+    while ((resourceID = Lwm2mCore_GetNextResourceID(context, objectID, objectInstanceID, resourceID)) != -1)
+    {
+        if (Definition_IsResourceTypeExecutable(Lwm2mCore_GetDefinitions(context), objectID, resourceID) == 0)
+        {
+            if ((result = CheckReadableResource(context, requestOrigin, objectID, objectInstanceID, resourceID)) != AwaResult_Success)
+            {
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+static AwaResult CheckReadableObject(Lwm2mContextType * context, Lwm2mRequestOrigin requestOrigin, ObjectIDType objectID)
+{
+    AwaResult result = AwaResult_NotFound;
+
+    if (Definition_LookupObjectDefinition(Lwm2mCore_GetDefinitions(context), objectID) == NULL)
+    {
+        Lwm2m_Error("ERROR: Failed to determine object definition Object %d\n", objectID);
+        return AwaResult_NotFound;
+    }
+
+    int instanceID = -1;
+    while ((instanceID = Lwm2mCore_GetNextObjectInstanceID(context, objectID, instanceID)) != -1)
+    {
+        if ((result = CheckReadableObjectInstance(context, requestOrigin, objectID, instanceID)) != AwaResult_Success)
+        {
+            break;
+        }
+    }
+    return result;
+}
+
+AwaResult TreeBuilder_CheckReadableOIR(Lwm2mContextType * context, Lwm2mRequestOrigin requestOrigin, int OIR[], int OIRLength)
+{
+    AwaResult result = AwaResult_Unspecified;
+    if (OIRLength == 1)
+    {
+        result = CheckReadableObject(context, requestOrigin, OIR[0]);
+    }
+    else if (OIRLength == 2)
+    {
+        result = CheckReadableObjectInstance(context, requestOrigin, OIR[0], OIR[1]);
+    }
+    else if (OIRLength == 3)
+    {
+        result = CheckReadableResource(context, requestOrigin, OIR[0], OIR[1], OIR[2]);
+    }
+    else
+    {
+        Lwm2m_Error("Invalid OIR, length %d\n", OIRLength);
+        result = AwaResult_BadRequest;
+    }
+    return result;
+}
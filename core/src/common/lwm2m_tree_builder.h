@@ -37,6 +37,14 @@ extern "C" {
 #include "lwm2m_result.h"
 
 AwaResult TreeBuilder_CreateTreeFromOIR(Lwm2mTreeNode ** dest, Lwm2mContextType * context, Lwm2mRequestOrigin requestOrigin, int OIR[], int OIRLength);
+
+// As TreeBuilder_CreateTreeFromOIR, but allocates the tree from arena (or with malloc if arena is NULL).
+AwaResult TreeBuilder_CreateTreeFromOIRInArena(Lwm2mTreeNode ** dest, Lwm2mTreeArena * arena, Lwm2mContextType * context, Lwm2mRequestOrigin requestOrigin,
+                                               int OIR[], int OIRLength);
+// Returns the result TreeBuilder_CreateTreeFromOIR would give for OIR from the definitions and the structure of the
+// object store alone. Values are not read, so a value that cannot be read is only reported when it is serialised.
+AwaResult TreeBuilder_CheckReadableOIR(Lwm2mContextType * context, Lwm2mRequestOrigin requestOrigin, int OIR[], int OIRLength);
+
 AwaResult TreeBuilder_CreateTreeFromObject(Lwm2mTreeNode ** dest, Lwm2mContextType * context, Lwm2mRequestOrigin requestOrigin, ObjectIDType objectID);
 AwaResult TreeBuilder_CreateTreeFromObjectInstance(Lwm2mTreeNode ** dest, Lwm2mContextType * context, Lwm2mRequestOrigin requestOrigin,
                                              ObjectIDType objectID, ObjectInstanceIDType objectInstanceID);
@@ -30,6 +30,22 @@
 #include "lwm2m_list.h"
 #include "lwm2m_tree_node.h"
 
+// Nodes are small and built in bulk, so an arena hands them out from blocks of this size.
+#define TREE_ARENA_BLOCK_SIZE (4096)
+#define TREE_ARENA_ALIGNMENT  (sizeof(void *) > sizeof(double) ? sizeof(void *) : sizeof(double))
+
+typedef struct _ArenaBlock
+{
+    struct _ArenaBlock * Next;
+    size_t Size;
+    size_t Used;
+} ArenaBlock;
+
+struct _Lwm2mTreeArena
+{
+    ArenaBlock * Blocks;                // Most recent block first
+};
+
 typedef struct
 {
     struct _Lwm2mTreeNode * Parent;
@@ -45,9 +61,66 @@ typedef struct
     uint16_t Length;                    // 0 if not a resource instance.
     bool Create;                        // create flag
     bool Replace;                       // replace flag
+    Lwm2mTreeArena * Arena;             // Arena holding the node and its value, or NULL if they are individually allocated
+    bool Reference;                     // Value points into a buffer owned by the caller (arena nodes only)
 
 } _Lwm2mTreeNode;
 
+static size_t ArenaBlockHeaderSize(void)
+{
+    return (sizeof(ArenaBlock) + TREE_ARENA_ALIGNMENT - 1) & ~(TREE_ARENA_ALIGNMENT - 1);
+}
+
+static void * Lwm2mTreeArena_Alloc(Lwm2mTreeArena * arena, size_t size)
+{
+    size = (size + TREE_ARENA_ALIGNMENT - 1) & ~(TREE_ARENA_ALIGNMENT - 1);
+
+    ArenaBlock * block = arena->Blocks;
+    if ((block == NULL) || (block->Size - block->Used < size))
+    {
+        // Allocations larger than a block get a block of their own
+        size_t blockSize = ArenaBlockHeaderSize() + ((size > TREE_ARENA_BLOCK_SIZE) ? size : TREE_ARENA_BLOCK_SIZE);
+        block = malloc(blockSize);
+        if (block == NULL)
+        {
+            return NULL;
+        }
+        block->Size = blockSize;
+        block->Used = ArenaBlockHeaderSize();
+        block->Next = arena->Blocks;
+        arena->Blocks = block;
+    }
+
+    void * result = (char *)block + block->Used;
+    block->Used += size;
+    return result;
+}
+
+Lwm2mTreeArena * Lwm2mTreeArena_New(void)
+{
+    Lwm2mTreeArena * arena = malloc(sizeof(Lwm2mTreeArena));
+    if (arena != NULL)
+    {
+        arena->Blocks = NULL;
+    }
+    return arena;
+}
+
+void Lwm2mTreeArena_Free(Lwm2mTreeArena * arena)
+{
+    if (arena != NULL)
+    {
+        ArenaBlock * block = arena->Blocks;
+        while (block != NULL)
+        {
+            ArenaBlock * next = block->Next;
+            free(block);
+            block = next;
+        }
+        free(arena);
+    }
+}
+
 static void Lwm2mTreeNode_Init(Lwm2mTreeNode * node)
 {
     _Lwm2mTreeNode * _node = (_Lwm2mTreeNode *)node;
@@ -60,22 +133,35 @@ static void Lwm2mTreeNode_Init(Lwm2mTreeNode * node)
     _node->Definition = NULL;
     _node->Create     = false;
     _node->Replace    = false;
+    _node->Arena      = NULL;
+    _node->Reference  = false;
     ListInit(&_node->Children);
 }
 
 Lwm2mTreeNode * Lwm2mTreeNode_Create(void)
 {
-    _Lwm2mTreeNode * node = malloc(sizeof(_Lwm2mTreeNode));
+    return Lwm2mTreeNode_CreateInArena(NULL);
+}
+
+Lwm2mTreeNode * Lwm2mTreeNode_CreateInArena(Lwm2mTreeArena * arena)
+{
+    _Lwm2mTreeNode * node = (arena != NULL) ? Lwm2mTreeArena_Alloc(arena, sizeof(_Lwm2mTreeNode)) : malloc(sizeof(_Lwm2mTreeNode));
     if (node == NULL)
     {
         return NULL;
     }
 
     Lwm2mTreeNode_Init((Lwm2mTreeNode*)node);
+    node->Arena = arena;
 
     return (Lwm2mTreeNode *)node;
 }
 
+Lwm2mTreeArena * Lwm2mTreeNode_GetArena(Lwm2mTreeNode * node)
+{
+    return (node != NULL) ? ((_Lwm2mTreeNode *)node)->Arena : NULL;
+}
+
 int Lwm2mTreeNode_SetType(Lwm2mTreeNode * node, Lwm2mTreeNodeType type)
 {
     _Lwm2mTreeNode * _node = (_Lwm2mTreeNode *)node;
@@ -111,7 +197,21 @@ int Lwm2mTreeNode_SetValue(Lwm2mTreeNode * node, const uint8_t * value, uint16_t
     if ((node == NULL) || (value == NULL))
         return -1;
 
-    if (_node->Length != length)
+    if (_node->Arena != NULL)
+    {
+        // The previous value stays in the arena until it is freed
+        if ((_node->Value == NULL) || (_node->Length < length) || _node->Reference)
+        {
+            void * temp = Lwm2mTreeArena_Alloc(_node->Arena, length);
+            if (temp == NULL)
+            {
+                return -1;
+            }
+            _node->Value = temp;
+            _node->Reference = false;
+        }
+    }
+    else if (_node->Length != length)
     {
         void * temp = realloc(_node->Value, length);
         if (temp == NULL)
@@ -126,6 +226,24 @@ int Lwm2mTreeNode_SetValue(Lwm2mTreeNode * node, const uint8_t * value, uint16_t
     return 0;
 }
 
+int Lwm2mTreeNode_SetValueReference(Lwm2mTreeNode * node, const uint8_t * value, uint16_t length)
+{
+    _Lwm2mTreeNode * _node = (_Lwm2mTreeNode *)node;
+    if ((node == NULL) || (value == NULL))
+        return -1;
+
+    if (_node->Arena == NULL)
+    {
+        // The node owns its value, so it needs its own copy
+        return Lwm2mTreeNode_SetValue(node, value, length);
+    }
+
+    _node->Value = (uint8_t *)value;
+    _node->Length = length;
+    _node->Reference = true;
+    return 0;
+}
+
 const uint8_t * Lwm2mTreeNode_GetValue(Lwm2mTreeNode * node, uint16_t * length)
 {
     uint8_t * result = NULL;
@@ -341,8 +459,11 @@ int Lwm2mTreeNode_Delete(Lwm2mTreeNode * node)
         ListRemove(&_node->_List);
     }
 
-    free(_node->Value);
-    free(_node);
+    if (_node->Arena == NULL)
+    {
+        free(_node->Value);
+        free(_node);
+    }
     return 0;
 }
 
@@ -367,8 +488,11 @@ int Lwm2mTreeNode_DeleteRecursive(Lwm2mTreeNode * node)
         child = next;
     }
 
-    free(_node->Value);
-    free(_node);
+    if (_node->Arena == NULL)
+    {
+        free(_node->Value);
+        free(_node);
+    }
     return 0;
 }
 
@@ -398,7 +522,7 @@ Lwm2mTreeNode * Lwm2mTreeNode_FindOrCreateChildNode(Lwm2mTreeNode * parent, int
         child = Lwm2mTreeNode_FindNode(parent, childID);
         if (child == NULL)
         {
-            child = Lwm2mTreeNode_Create();
+            child = Lwm2mTreeNode_CreateInArena(Lwm2mTreeNode_GetArena(parent));
             Lwm2mTreeNode_SetID(child, childID);
             Lwm2mTreeNode_SetType(child, childType);
             Lwm2mTreeNode_SetCreateFlag(child, create);
@@ -430,7 +554,7 @@ static void Lwm2mTreeNode_CopyChildren(Lwm2mTreeNode * parent, Lwm2mTreeNode * p
     Lwm2mTreeNode * child = Lwm2mTreeNode_GetFirstChild(parent);
     while (child != NULL)
     {
-        Lwm2mTreeNode * childCopy = Lwm2mTreeNode_Create();
+        Lwm2mTreeNode * childCopy = Lwm2mTreeNode_CreateInArena(Lwm2mTreeNode_GetArena(parentCopy));
         Lwm2mTreeNode_AddChild(parentCopy, childCopy);
 
         Lwm2mTreeNode_CopySingleNode(child, childCopy);
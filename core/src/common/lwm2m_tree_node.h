@@ -43,8 +43,19 @@ typedef enum
 
 typedef struct _Lwm2mTreeNode Lwm2mTreeNode;
 
+// An arena holds the nodes and values of short-lived trees, such as those built to handle a single request,
+// and releases them all at once. Deleting a node that belongs to an arena only unlinks it from its parent.
+typedef struct _Lwm2mTreeArena Lwm2mTreeArena;
+
+Lwm2mTreeArena * Lwm2mTreeArena_New(void);
+void Lwm2mTreeArena_Free(Lwm2mTreeArena * arena);
+
 Lwm2mTreeNode * Lwm2mTreeNode_Create(void);
 
+// Create a node in arena, or with malloc if arena is NULL, for trees that outlive the request.
+Lwm2mTreeNode * Lwm2mTreeNode_CreateInArena(Lwm2mTreeArena * arena);
+Lwm2mTreeArena * Lwm2mTreeNode_GetArena(Lwm2mTreeNode * node);
+
 int Lwm2mTreeNode_SetType(Lwm2mTreeNode * node, Lwm2mTreeNodeType type);
 Lwm2mTreeNodeType Lwm2mTreeNode_GetType(Lwm2mTreeNode * node);
 
@@ -52,6 +63,9 @@ int Lwm2mTreeNode_SetDefinition(Lwm2mTreeNode * node, void * definition);
 void * Lwm2mTreeNode_GetDefinition(Lwm2mTreeNode * node);
 
 int Lwm2mTreeNode_SetValue(Lwm2mTreeNode * node, const uint8_t * value, uint16_t length);
+
+// Point an arena node at value without copying it; value must outlive the arena. Nodes outside an arena copy it.
+int Lwm2mTreeNode_SetValueReference(Lwm2mTreeNode * node, const uint8_t * value, uint16_t length);
 const uint8_t * Lwm2mTreeNode_GetValue(Lwm2mTreeNode * node, uint16_t * length);
 
 int Lwm2mTreeNode_SetID(Lwm2mTreeNode * node, int id);
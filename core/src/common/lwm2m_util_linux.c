@@ -109,6 +109,9 @@ const char * Lwm2mCore_DebugPrintSockAddr(const struct sockaddr * sa)
             port =  ntohs(((struct sockaddr_in6 *)sa)->sin6_port);
             sprintf(out, "[%s]:%d", ip, port);
             break;
+        case AF_UNIX:
+            sprintf(out, "unix");
+            break;
         default:
             Lwm2m_Error("Unsupported address family: %d\n", sa->sa_family);
             break;
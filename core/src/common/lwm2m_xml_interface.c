@@ -29,14 +29,18 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <string.h>
 #include <float.h>
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <netdb.h>
 #include <inttypes.h>
+#include <limits.h>
 
 #include "lwm2m_xml_interface.h"
 #include "lwm2m_types.h"
@@ -61,6 +65,200 @@ static struct ListHead handlerList;
 static void * g_context = NULL;
 
 
+// A Batch request carries several requests for the same session. They are run one at a time, in order, and
+// their responses are collected into a single Batch response rather than being sent individually.
+typedef struct
+{
+    struct ListHead list;
+    RequestInfoType * Request;
+    TreeNode Requests;
+    uint32_t NextRequest;
+    TreeNode Responses;
+    IPCRequestID PendingRequestID;
+    bool Dispatching;
+} IpcBatchType;
+
+static struct ListHead batchList;
+
+// Batched requests are given negative IDs, so that their responses can't be confused with
+// those of requests from the API, which use positive IDs.
+static IPCRequestID lastBatchRequestID = 0;
+
+// Messages on a stream connection are not limited to the size of a single datagram. Partial frames
+// are accumulated in the connection's buffer until the whole message has been received.
+#define IPC_STREAM_READ_LEN (4096)
+
+// Connections are non-blocking, so a peer that stops reading can't stall the daemon. Output it hasn't read yet
+// is queued, up to this limit, after which the connection is dropped.
+#define IPC_STREAM_MAX_QUEUED_LEN (2 * IPC_MAX_STREAM_MESSAGE_LEN)
+
+typedef struct
+{
+    struct ListHead list;
+    int Sockfd;
+    char * Buffer;
+    size_t BufferSize;
+    size_t Length;
+    char * Output;
+    size_t OutputOffset;
+    size_t OutputLength;
+    bool Failed;
+} IpcConnectionType;
+
+static struct ListHead connectionList;
+static int unixSockfd = -1;
+static char * unixPath = NULL;
+
+static IpcHandlerType * xmlif_LookupHandler(const char * msgType)
+{
+    struct ListHead * i;
+    ListForEach(i, &handlerList)
+    {
+        IpcHandlerType * handler = ListEntry(i, IpcHandlerType, list);
+        if (strcmp(handler->Name, msgType) == 0)
+        {
+            return handler;
+        }
+    }
+    return NULL;
+}
+
+static bool xmlif_IsBatchable(const char * msgType)
+{
+    return (strcmp(msgType, IPC_MESSAGE_SUB_TYPE_CONNECT) != 0) &&
+           (strcmp(msgType, IPC_MESSAGE_SUB_TYPE_ESTABLISH_NOTIFY) != 0) &&
+           (strcmp(msgType, IPC_MESSAGE_SUB_TYPE_DISCONNECT) != 0) &&
+           (strcmp(msgType, IPC_MESSAGE_SUB_TYPE_BATCH) != 0);
+}
+
+static void xmlif_FreeBatch(IpcBatchType * batch)
+{
+    Tree_Delete(batch->Requests);
+    if (batch->Responses != NULL)
+    {
+        Tree_Delete(batch->Responses);
+    }
+    free(batch->Request);
+    free(batch);
+}
+
+static void xmlif_ContinueBatch(IpcBatchType * batch)
+{
+    TreeNode requestNode;
+
+    batch->Dispatching = true;
+    while ((requestNode = TreeNode_GetChild(batch->Requests, batch->NextRequest)) != NULL)
+    {
+        batch->NextRequest++;
+
+        const char * msgType = xmlif_GetOpaque(requestNode, "Request/Type");
+        IpcHandlerType * handler = (msgType != NULL) && xmlif_IsBatchable(msgType) ? xmlif_LookupHandler(msgType) : NULL;
+        RequestInfoType * request = handler != NULL ? malloc(sizeof(*request)) : NULL;
+        if (request == NULL)
+        {
+            Lwm2m_Error("Cannot handle batched request %s\n", msgType != NULL ? msgType : "(no type)");
+            TreeNode_AddChild(batch->Responses, IPC_NewResponseNode(IPC_MESSAGE_SUB_TYPE_INVALID, AwaResult_BadRequest, batch->Request->SessionID));
+            continue;
+        }
+
+        memcpy(request, batch->Request, sizeof(*request));
+        lastBatchRequestID = lastBatchRequestID > INT_MIN ? lastBatchRequestID - 1 : -1;
+        request->RequestID = lastBatchRequestID;
+        batch->PendingRequestID = lastBatchRequestID;
+        uint32_t numResponses = TreeNode_GetChildCount(batch->Responses);
+        handler->Function(request, TreeNode_Navigate(requestNode, "Request/Content"));
+
+        if (TreeNode_GetChildCount(batch->Responses) == numResponses)
+        {
+            // response will arrive later, e.g. when a CoAP transaction completes
+            batch->Dispatching = false;
+            return;
+        }
+    }
+    batch->Dispatching = false;
+
+    RequestInfoType * request = batch->Request;
+    TreeNode responseNode = IPC_NewResponseNode(IPC_MESSAGE_SUB_TYPE_BATCH, AwaResult_Success, request->SessionID);
+    TreeNode contentNode = IPC_NewContentNode();
+    TreeNode_AddChild(contentNode, batch->Responses);
+    TreeNode_AddChild(responseNode, contentNode);
+    batch->Responses = NULL;
+
+    // remove the batch before sending, so that its own response isn't collected
+    ListRemove(&batch->list);
+    xmlif_SendResponse(request, responseNode);
+    Tree_Delete(responseNode);
+    xmlif_FreeBatch(batch);
+}
+
+static bool xmlif_CollectBatchResponse(TreeNode responseNode)
+{
+    if (strcmp(TreeNode_GetName(responseNode), IPC_MESSAGE_TYPE_RESPONSE) != 0)
+    {
+        return false;
+    }
+
+    IPCSessionID sessionID = IPC_GetSessionID(responseNode);
+    IPCRequestID requestID = IPC_GetRequestID(responseNode);
+    struct ListHead * i;
+    ListForEach(i, &batchList)
+    {
+        IpcBatchType * batch = ListEntry(i, IpcBatchType, list);
+        if ((requestID != 0) && (batch->Request->SessionID == sessionID) && (batch->PendingRequestID == requestID))
+        {
+            batch->PendingRequestID = 0;
+            TreeNode_AddChild(batch->Responses, Tree_Copy(responseNode));
+            if (!batch->Dispatching)
+            {
+                xmlif_ContinueBatch(batch);
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+static int xmlif_HandleBatchRequest(RequestInfoType * request, TreeNode content)
+{
+    TreeNode requestsNode = TreeNode_Navigate(content, "Content/Requests");
+    IpcBatchType * batch = requestsNode != NULL ? malloc(sizeof(*batch)) : NULL;
+    if (batch == NULL)
+    {
+        Lwm2m_Error("Invalid batch request\n");
+        TreeNode responseNode = IPC_NewResponseNode(IPC_MESSAGE_SUB_TYPE_BATCH, AwaResult_BadRequest, request->SessionID);
+        xmlif_SendResponse(request, responseNode);
+        Tree_Delete(responseNode);
+        free(request);
+        return -1;
+    }
+
+    memset(batch, 0, sizeof(*batch));
+    batch->Request = request;
+    batch->Requests = Tree_Copy(requestsNode);
+    batch->Responses = Xml_CreateNode("Responses");
+    ListAdd(&batch->list, &batchList);
+
+    xmlif_ContinueBatch(batch);
+    return 0;
+}
+
+int xmlif_SendResponse(const RequestInfoType * request, TreeNode responseNode)
+{
+    if (request->RequestID != 0)
+    {
+        IPC_SetRequestID(responseNode, request->RequestID);
+    }
+    return IPC_SendResponse(responseNode, request->Sockfd, &request->FromAddr, request->AddrLen);
+}
+
+void xmlif_NegotiateEncoding(const RequestInfoType * request, TreeNode responseNode)
+{
+    if ((request->Encoding != IPCEncoding_XML) && (IPCSession_SetEncoding(request->SessionID, request->Encoding) == 0))
+    {
+        IPC_SetEncoding(responseNode, request->Encoding);
+    }
+}
+
 int xmlif_AddRequestHandler(const char * msgType, XmlRequestHandler handler)
 {
     IpcHandlerType * new = malloc(sizeof(IpcHandlerType));
@@ -70,10 +268,182 @@ int xmlif_AddRequestHandler(const char * msgType, XmlRequestHandler handler)
     return 0;
 }
 
+static IpcConnectionType * xmlif_LookupConnection(int sockfd)
+{
+    struct ListHead * i;
+    ListForEach(i, &connectionList)
+    {
+        IpcConnectionType * connection = ListEntry(i, IpcConnectionType, list);
+        if (connection->Sockfd == sockfd)
+        {
+            return connection;
+        }
+    }
+    return NULL;
+}
+
+// Mark a connection as failed. It is shut down rather than closed, so the descriptor isn't reused while requests
+// still refer to it, and is closed when poll next reports it.
+static void xmlif_FailConnection(IpcConnectionType * connection)
+{
+    if (!connection->Failed)
+    {
+        connection->Failed = true;
+        shutdown(connection->Sockfd, SHUT_RDWR);
+    }
+}
+
+// Append whatever sendmsg couldn't send to the connection's output queue, to be flushed when the socket is writable.
+static int xmlif_QueueOutput(IpcConnectionType * connection, const struct iovec * iov, int iovlen)
+{
+    size_t length = 0;
+    int i;
+    for (i = 0; i < iovlen; i++)
+    {
+        length += iov[i].iov_len;
+    }
+
+    if (connection->OutputLength - connection->OutputOffset + length > IPC_STREAM_MAX_QUEUED_LEN)
+    {
+        Lwm2m_Error("IPC connection %d is not reading its messages\n", connection->Sockfd);
+        return -1;
+    }
+
+    // discard the part of the queue that has already been sent
+    if (connection->OutputOffset > 0)
+    {
+        memmove(connection->Output, &connection->Output[connection->OutputOffset], connection->OutputLength - connection->OutputOffset);
+        connection->OutputLength -= connection->OutputOffset;
+        connection->OutputOffset = 0;
+    }
+
+    char * output = realloc(connection->Output, connection->OutputLength + length);
+    if (output == NULL)
+    {
+        Lwm2m_Error("Failed to allocate memory\n");
+        return -1;
+    }
+    connection->Output = output;
+
+    for (i = 0; i < iovlen; i++)
+    {
+        memcpy(&connection->Output[connection->OutputLength], iov[i].iov_base, iov[i].iov_len);
+        connection->OutputLength += iov[i].iov_len;
+    }
+    return 0;
+}
+
+// Send as much of the output queue as the socket will take. Returns -1 if the connection should be closed.
+static int xmlif_FlushConnection(IpcConnectionType * connection)
+{
+    while (connection->OutputOffset < connection->OutputLength)
+    {
+        ssize_t sent = send(connection->Sockfd, &connection->Output[connection->OutputOffset],
+                            connection->OutputLength - connection->OutputOffset, MSG_NOSIGNAL);
+        if (sent == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+            {
+                return 0;
+            }
+            perror("send");
+            return -1;
+        }
+        connection->OutputOffset += sent;
+    }
+
+    free(connection->Output);
+    connection->Output = NULL;
+    connection->OutputOffset = 0;
+    connection->OutputLength = 0;
+    return 0;
+}
+
+// Send a length-prefixed message on a stream connection. The header and message are gathered by sendmsg,
+// so the message is never copied into a framing buffer unless the peer isn't keeping up.
+static ssize_t xmlif_SendFrame(IpcConnectionType * connection, const void * buf, size_t len)
+{
+    uint8_t header[IPC_STREAM_HEADER_LEN] = { (len >> 24) & 0xff, (len >> 16) & 0xff, (len >> 8) & 0xff, len & 0xff };
+    struct iovec iov[2] = { { header, sizeof(header) }, { (void *)buf, len } };
+    struct msghdr msg;
+    size_t remaining = sizeof(header) + len;
+
+    if (connection->Failed)
+    {
+        return -1;
+    }
+
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = 2;
+
+    // earlier messages are still queued, so this one must follow them
+    if (connection->OutputLength > 0)
+    {
+        remaining = 0;
+    }
+
+    while (remaining > 0)
+    {
+        ssize_t sent = sendmsg(connection->Sockfd, &msg, MSG_NOSIGNAL);
+        if (sent == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+            {
+                break;
+            }
+            perror("sendmsg");
+            xmlif_FailConnection(connection);
+            return -1;
+        }
+        remaining -= sent;
+
+        // skip over whatever was sent by a partial write
+        while ((msg.msg_iovlen > 0) && (sent >= msg.msg_iov[0].iov_len))
+        {
+            sent -= msg.msg_iov[0].iov_len;
+            msg.msg_iov++;
+            msg.msg_iovlen--;
+        }
+        if (msg.msg_iovlen > 0)
+        {
+            msg.msg_iov[0].iov_base = (uint8_t *)msg.msg_iov[0].iov_base + sent;
+            msg.msg_iov[0].iov_len -= sent;
+        }
+    }
+
+    if ((msg.msg_iovlen > 0) && (xmlif_QueueOutput(connection, msg.msg_iov, msg.msg_iovlen) != 0))
+    {
+        xmlif_FailConnection(connection);
+        return -1;
+    }
+    return len;
+}
+
 ssize_t xmlif_SendTo(int sockfd, const void *buf, size_t len, int flags,
                      const struct sockaddr *dest_addr, socklen_t addrlen)
 {
-    Lwm2m_Debug("Send %zu bytes on IPC\n%s\n", len , (const char *)buf);
+    if (sockfd < 0)
+    {
+        // the channel's connection has been closed
+        return -1;
+    }
+
+    Lwm2m_Debug("Send %zu bytes on IPC\n%.*s\n", len, (int)len, (const char *)buf);
+    IpcConnectionType * connection = xmlif_LookupConnection(sockfd);
+    if (connection != NULL)
+    {
+        return xmlif_SendFrame(connection, buf, len);
+    }
+
     ssize_t result = sendto(sockfd, buf, len, flags, dest_addr, addrlen);
     if (result == -1)
     {
@@ -139,6 +509,11 @@ int xmlif_init(void * context, int port)
     // Keep track of context to use.
     g_context = context;
     ListInit(&handlerList);
+    ListInit(&batchList);
+    ListInit(&connectionList);
+
+    xmlif_AddRequestHandler(IPC_MESSAGE_SUB_TYPE_BATCH, xmlif_HandleBatchRequest);
+    IPC_SetResponseFilter(xmlif_CollectBatchResponse);
 
     IPCSession_Init();
 
@@ -148,31 +523,26 @@ int xmlif_init(void * context, int port)
 static void HandleInvalidRequest(const RequestInfoType * request)
 {
     TreeNode responseNode = IPC_NewResponseNode(IPC_MESSAGE_SUB_TYPE_INVALID, AwaResult_BadRequest, request->SessionID);
-    IPC_SendResponse(responseNode, request->Sockfd, &request->FromAddr, request->AddrLen);
+    xmlif_SendResponse(request, responseNode);
     Tree_Delete(responseNode);
 }
 
-int xmlif_process(int sockfd)
+// Process a single, complete request. Buf must be nul-terminated.
+static int xmlif_HandleMessage(int sockfd, const struct sockaddr_storage * fromAddr, socklen_t addrLen, char * buf, int numbytes)
 {
-    struct sockaddr_storage their_addr;
-    char buf[IPC_MAX_BUFFER_LEN] = {0};
-    socklen_t addr_len;
-    int numbytes;
     TreeNode root;
 
-    // Read data from socket. Assume the XML is all in one UDP packet.
-    addr_len = sizeof(their_addr);
-    if ((numbytes = recvfrom(sockfd, buf, IPC_MAX_BUFFER_LEN-1 , 0,
-            (struct sockaddr *)&their_addr, &addr_len)) == -1)
-    {
-        perror("recvfrom");
-        return -1;
-    }
-
     Lwm2m_Debug("Received %d bytes on IPC\n%s\n", numbytes, buf);
 
     // assuming we received a full message, process it.
-    root = TreeNode_ParseXML(buf, numbytes, true);
+    if (Xml_IsBinary((const uint8_t *)buf, numbytes))
+    {
+        root = Xml_BinaryToTree((const uint8_t *)buf, numbytes);
+    }
+    else
+    {
+        root = TreeNode_ParseXML((uint8_t *)buf, numbytes, true);
+    }
     if (root != NULL)
     {
         TreeNode node = TreeNode_Navigate(root, "Request/Type");
@@ -188,51 +558,48 @@ int xmlif_process(int sockfd)
             TreeNode content = TreeNode_Navigate(root, "Request/Content");
 
             bool handled = false;
-            struct ListHead * i;
-            ListForEach(i, &handlerList)
+            IpcHandlerType * handler = xmlif_LookupHandler(value);
+            if (handler != NULL)
             {
-                IpcHandlerType * handler = ListEntry(i, IpcHandlerType, list);
-                if (!strcmp(handler->Name, value))
+                RequestInfoType * request = malloc(sizeof(RequestInfoType));
+                if (request != NULL)
                 {
-                    RequestInfoType * request = malloc(sizeof(RequestInfoType));
-                    if (request != NULL)
+                    memset(request, 0, sizeof(*request));
+                    request->Sockfd = sockfd;
+                    memcpy(&request->FromAddr, fromAddr, addrLen);
+                    request->AddrLen = addrLen;
+                    request->Context = g_context;
+                    request->RequestID = IPC_GetRequestID(root);
+                    request->Encoding = IPC_GetEncoding(root);
+
+                    // Ensure requests have a valid SessionID
+                    if (strcmp(IPC_MESSAGE_SUB_TYPE_CONNECT, value) == 0)
+                    {
+                        // CONNECT requests should have no session ID - allocate one
+                        request->SessionID = IPCSession_AssignSessionID();
+                    }
+                    else
                     {
-                        memset(request, 0, sizeof(*request));
-                        request->Sockfd = sockfd;
-                        memcpy(&request->FromAddr, &their_addr, addr_len);
-                        request->AddrLen = addr_len;
-                        request->Context = g_context;
-
-                        // Ensure requests have a valid SessionID
-                        if (strcmp(IPC_MESSAGE_SUB_TYPE_CONNECT, value) == 0)
+                        IPCSessionID sessionID = IPC_GetSessionID(root);
+                        if (!IPCSession_IsValid(sessionID))
                         {
-                            // CONNECT requests should have no session ID - allocate one
-                            request->SessionID = IPCSession_AssignSessionID();
+                            Lwm2m_Error("Invalid Session ID %d\n", sessionID);
+                            free(request);
+                            goto error;
                         }
                         else
                         {
-                            IPCSessionID sessionID = IPC_GetSessionID(root);
-                            if (!IPCSession_IsValid(sessionID))
-                            {
-                                Lwm2m_Error("Invalid Session ID %d\n", sessionID);
-                                free(request);
-                                goto error;
-                            }
-                            else
-                            {
-                                request->SessionID = sessionID;
-                            }
+                            request->SessionID = sessionID;
                         }
-
-                        handler->Function(request, content);
-                        handled = true;
-                        break;
-                    }
-                    else
-                    {
-                        Lwm2m_Error("Failed to allocate memory\n");
-                        goto error;
                     }
+
+                    handler->Function(request, content);
+                    handled = true;
+                }
+                else
+                {
+                    Lwm2m_Error("Failed to allocate memory\n");
+                    goto error;
                 }
             }
 
@@ -267,8 +634,8 @@ error:
     {
         memset(request, 0, sizeof(*request));
         request->Sockfd = sockfd;
-        memcpy(&request->FromAddr, &their_addr, addr_len);
-        request->AddrLen = addr_len;
+        memcpy(&request->FromAddr, fromAddr, addrLen);
+        request->AddrLen = addrLen;
         request->Context = g_context;
         HandleInvalidRequest(request);
         free(request);
@@ -281,6 +648,250 @@ error:
     return 0;
 }
 
+int xmlif_process(int sockfd)
+{
+    struct sockaddr_storage their_addr;
+    char buf[IPC_MAX_BUFFER_LEN] = {0};
+    socklen_t addr_len;
+    int numbytes;
+
+    // Read data from socket. Assume the XML is all in one UDP packet.
+    addr_len = sizeof(their_addr);
+    if ((numbytes = recvfrom(sockfd, buf, IPC_MAX_BUFFER_LEN-1 , 0,
+            (struct sockaddr *)&their_addr, &addr_len)) == -1)
+    {
+        perror("recvfrom");
+        return -1;
+    }
+
+    return xmlif_HandleMessage(sockfd, &their_addr, addr_len, buf, numbytes);
+}
+
+int xmlif_InitUnix(const char * path)
+{
+    struct sockaddr_un addr;
+
+    if ((path == NULL) || (strlen(path) >= sizeof(addr.sun_path)))
+    {
+        Lwm2m_Error("Invalid IPC socket path\n");
+        return -1;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+
+    int sockfd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (sockfd == -1)
+    {
+        perror("listener: socket");
+        return -1;
+    }
+
+    // remove a socket left behind by a previous instance
+    unlink(path);
+    if ((bind(sockfd, (struct sockaddr *)&addr, sizeof(addr)) == -1) || (listen(sockfd, SOMAXCONN) == -1))
+    {
+        perror("listener: bind");
+        close(sockfd);
+        return -1;
+    }
+
+    unixSockfd = sockfd;
+    unixPath = strdup(path);
+    return sockfd;
+}
+
+int xmlif_GetNumStreamFds(void)
+{
+    int numFds = 0;
+    if (unixSockfd >= 0)
+    {
+        struct ListHead * i;
+        numFds++;
+        ListForEach(i, &connectionList)
+        {
+            numFds++;
+        }
+    }
+    return numFds;
+}
+
+int xmlif_GetStreamFds(struct pollfd * fds, int maxFds)
+{
+    int numFds = 0;
+    if ((unixSockfd >= 0) && (numFds < maxFds))
+    {
+        struct ListHead * i;
+        fds[numFds].fd = unixSockfd;
+        fds[numFds].events = POLLIN;
+        fds[numFds].revents = 0;
+        numFds++;
+
+        ListForEach(i, &connectionList)
+        {
+            if (numFds >= maxFds)
+            {
+                break;
+            }
+            IpcConnectionType * connection = ListEntry(i, IpcConnectionType, list);
+            fds[numFds].fd = connection->Sockfd;
+            fds[numFds].events = (connection->OutputLength > 0) ? POLLIN | POLLOUT : POLLIN;
+            fds[numFds].revents = 0;
+            numFds++;
+        }
+    }
+    return numFds;
+}
+
+static void xmlif_AcceptConnection(void)
+{
+    int sockfd = accept(unixSockfd, NULL, NULL);
+    if (sockfd == -1)
+    {
+        perror("accept");
+        return;
+    }
+
+    int flags = fcntl(sockfd, F_GETFL);
+    if ((flags == -1) || (fcntl(sockfd, F_SETFL, flags | O_NONBLOCK) == -1))
+    {
+        perror("fcntl");
+        close(sockfd);
+        return;
+    }
+
+    IpcConnectionType * connection = malloc(sizeof(IpcConnectionType));
+    if (connection != NULL)
+    {
+        memset(connection, 0, sizeof(*connection));
+        connection->Sockfd = sockfd;
+        ListAdd(&connection->list, &connectionList);
+        Lwm2m_Debug("Accepted IPC connection %d\n", sockfd);
+    }
+    else
+    {
+        Lwm2m_Error("Failed to allocate memory\n");
+        close(sockfd);
+    }
+}
+
+static void xmlif_CloseConnection(IpcConnectionType * connection)
+{
+    Lwm2m_Debug("Closed IPC connection %d\n", connection->Sockfd);
+
+    // sessions using this connection can no longer be sent to, and the descriptor may be reused
+    IPCSession_CloseChannels(connection->Sockfd);
+    close(connection->Sockfd);
+    ListRemove(&connection->list);
+    free(connection->Buffer);
+    free(connection->Output);
+    free(connection);
+}
+
+static uint32_t xmlif_GetFrameLength(const IpcConnectionType * connection)
+{
+    const uint8_t * header = (const uint8_t *)connection->Buffer;
+    return ((uint32_t)header[0] << 24) | ((uint32_t)header[1] << 16) | ((uint32_t)header[2] << 8) | header[3];
+}
+
+// Read whatever is available on a connection and process any complete messages. Returns -1 if the connection should be closed.
+static int xmlif_ReadConnection(IpcConnectionType * connection)
+{
+    // responses are sent on the connected socket, so there is no source address
+    struct sockaddr_storage noAddr = { .ss_family = AF_UNIX };
+
+    // make room for the rest of the current frame, and a terminator
+    size_t required = connection->Length + IPC_STREAM_READ_LEN + 1;
+    if (connection->Length >= IPC_STREAM_HEADER_LEN)
+    {
+        size_t frameSize = IPC_STREAM_HEADER_LEN + xmlif_GetFrameLength(connection) + 1;
+        required = (frameSize > required) ? frameSize : required;
+    }
+    if (required > connection->BufferSize)
+    {
+        char * buffer = realloc(connection->Buffer, required);
+        if (buffer == NULL)
+        {
+            Lwm2m_Error("Failed to allocate memory\n");
+            return -1;
+        }
+        connection->Buffer = buffer;
+        connection->BufferSize = required;
+    }
+
+    ssize_t numbytes = recv(connection->Sockfd, &connection->Buffer[connection->Length], connection->BufferSize - connection->Length - 1, MSG_DONTWAIT);
+    if (numbytes <= 0)
+    {
+        return ((numbytes == -1) && ((errno == EINTR) || (errno == EAGAIN) || (errno == EWOULDBLOCK))) ? 0 : -1;
+    }
+    connection->Length += numbytes;
+
+    while (connection->Length >= IPC_STREAM_HEADER_LEN)
+    {
+        uint32_t frameLength = xmlif_GetFrameLength(connection);
+        if (frameLength > IPC_MAX_STREAM_MESSAGE_LEN)
+        {
+            Lwm2m_Error("IPC message of %" PRIu32 " bytes is too large\n", frameLength);
+            return -1;
+        }
+
+        size_t frameSize = IPC_STREAM_HEADER_LEN + frameLength;
+        if (connection->Length < frameSize)
+        {
+            break;
+        }
+
+        // terminate the message in place, and restore the byte it displaced once it has been handled
+        char * message = &connection->Buffer[IPC_STREAM_HEADER_LEN];
+        char displaced = message[frameLength];
+        message[frameLength] = '\0';
+        xmlif_HandleMessage(connection->Sockfd, &noAddr, 0, message, frameLength);
+        message[frameLength] = displaced;
+
+        memmove(connection->Buffer, &connection->Buffer[frameSize], connection->Length - frameSize);
+        connection->Length -= frameSize;
+    }
+    return 0;
+}
+
+void xmlif_ProcessStreamFds(const struct pollfd * fds, int numFds)
+{
+    int i;
+    for (i = 0; i < numFds; i++)
+    {
+        if (fds[i].revents == 0)
+        {
+            continue;
+        }
+
+        if (fds[i].fd == unixSockfd)
+        {
+            xmlif_AcceptConnection();
+        }
+        else
+        {
+            IpcConnectionType * connection = xmlif_LookupConnection(fds[i].fd);
+            if (connection == NULL)
+            {
+                continue;
+            }
+            if (((fds[i].revents & POLLOUT) != 0) && (xmlif_FlushConnection(connection) != 0))
+            {
+                xmlif_FailConnection(connection);
+            }
+            if (!connection->Failed && ((fds[i].revents & ~POLLOUT) != 0) && (xmlif_ReadConnection(connection) != 0))
+            {
+                xmlif_FailConnection(connection);
+            }
+            if (connection->Failed)
+            {
+                xmlif_CloseConnection(connection);
+            }
+        }
+    }
+}
+
 void xmlif_destroy(int sockfd)
 {
     if (sockfd >= 0)
@@ -288,6 +899,23 @@ void xmlif_destroy(int sockfd)
         close(sockfd);
     }
 
+    // clean up stream connections and the Unix domain listener
+    {
+        struct ListHead * i, * n;
+        ListForEachSafe(i, n, &connectionList)
+        {
+            xmlif_CloseConnection(ListEntry(i, IpcConnectionType, list));
+        }
+        if (unixSockfd >= 0)
+        {
+            close(unixSockfd);
+            unixSockfd = -1;
+            unlink(unixPath);
+        }
+        free(unixPath);
+        unixPath = NULL;
+    }
+
     // clean up handlerList
     {
         struct ListHead * i, * n;
@@ -302,6 +930,18 @@ void xmlif_destroy(int sockfd)
         }
     }
 
+    // clean up batches still waiting for responses
+    {
+        struct ListHead * i, * n;
+        ListForEachSafe(i, n, &batchList)
+        {
+            IpcBatchType * batch = ListEntry(i, IpcBatchType, list);
+            ListRemove(&batch->list);
+            xmlif_FreeBatch(batch);
+        }
+    }
+    IPC_SetResponseFilter(NULL);
+
     IPCSession_Shutdown();
 }
 
@@ -27,6 +27,7 @@
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
+#include <poll.h>
 
 #include "lwm2m_object_store.h"
 #include "lwm2m_types.h"
@@ -45,6 +46,8 @@ typedef struct
     struct sockaddr FromAddr;
     int AddrLen;
     IPCSessionID SessionID;
+    IPCRequestID RequestID;
+    IPCEncoding Encoding;       // the encoding requested by a Connect request
     void * Context;
     void * Client;
 } RequestInfoType;
@@ -60,6 +63,12 @@ typedef int (*XmlRequestHandler)(RequestInfoType *, TreeNode);
 
 int xmlif_AddRequestHandler(const char * msgType, XmlRequestHandler handler);
 
+// Send a response to the originator of a request, tagged with the request's ID if it has one
+int xmlif_SendResponse(const RequestInfoType * request, TreeNode responseNode);
+
+// Adopt the encoding requested by a Connect request for the new session, and confirm it in the response
+void xmlif_NegotiateEncoding(const RequestInfoType * request, TreeNode responseNode);
+
 char * xmlif_EncodeValue(AwaResourceType dataType, const char * buffer, int bufferLength);
 int xmlif_DecodeValue(char ** dataValue, AwaResourceType dataType, const char * buffer, int bufferLength);
 
@@ -73,6 +82,19 @@ int xmlif_init(void * context, int port);
 // Blocking call to process data on the XML interface socket
 int xmlif_process(int sockfd);
 
+// Also accept IPC connections on a Unix domain stream socket. Messages on these connections are framed, so are
+// not limited to the size of a single datagram. Returns the listening socket, or -1 on error.
+int xmlif_InitUnix(const char * path);
+
+// Number of stream sockets (the Unix domain listener and its connections) to poll
+int xmlif_GetNumStreamFds(void);
+
+// Fill fds with up to maxFds stream sockets to poll for input, or for output where messages are queued, returning the number filled
+int xmlif_GetStreamFds(struct pollfd * fds, int maxFds);
+
+// Accept new connections, send queued messages, and process complete messages received on stream sockets flagged by poll
+void xmlif_ProcessStreamFds(const struct pollfd * fds, int numFds);
+
 void xmlif_destroy(int sockfd);
 
 TreeNode xmlif_GenerateConnectResponse(DefinitionRegistry * definitionRegistry, IPCSessionID sessionID);
@@ -29,6 +29,7 @@ extern "C" {
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <stddef.h>
 
 #include "lwm2m_types.h"
 
@@ -54,6 +55,15 @@ typedef enum
 
 typedef struct _NetworkAddress NetworkAddress;
 
+typedef struct
+{
+    size_t Hits;            // Lookups satisfied from the address cache
+    size_t Misses;          // Lookups that had to resolve or allocate a new address
+    size_t Entries;         // Addresses currently cached
+    size_t IdleEntries;     // Cached addresses with no references, candidates for eviction
+
+} NetworkAddressCacheStatistics;
+
 typedef struct _NetworkSocket NetworkSocket;
 
 NetworkAddress * NetworkAddress_New(const char * uri, int uriLength);
@@ -66,6 +76,8 @@ void NetworkAddress_Free(NetworkAddress ** address);
 
 bool NetworkAddress_IsSecure(const NetworkAddress * address);
 
+void NetworkAddress_GetCacheStatistics(NetworkAddressCacheStatistics * statistics);
+
 NetworkSocket * NetworkSocket_New(NetworkSocketType socketType, uint16_t port);
 
 NetworkSocketError NetworkSocket_GetError(NetworkSocket * networkSocket);
@@ -38,6 +38,7 @@ typedef int SOCKET;
 
 #include "lwm2m_debug.h"
 #include "lwm2m_util.h"
+#include "lwm2m_hash.h"
 #include "network_abstraction.h"
 #include "dtls_abstraction.h"
 
@@ -53,6 +54,11 @@ struct _NetworkAddress
     } Address;
     bool Secure;
     int useCount;
+    bool Cached;
+    char * Uri;                     // Host part of the URI the address was resolved from, if any
+    HashEntry AddressIndex;         // Entry in the cache index keyed by socket address
+    HashEntry UriIndex;             // Entry in the cache index keyed by URI
+    struct ListHead IdleList;       // Entry in the LRU list of unreferenced addresses
 };
 
 struct _NetworkSocket
@@ -66,8 +72,13 @@ struct _NetworkSocket
 
 typedef struct
 {
-    char * uri;
-    NetworkAddress * address;
+    bool Initialised;
+    HashTable AddressIndex;
+    HashTable UriIndex;
+    struct ListHead IdleList;       // Unreferenced addresses, least recently used first
+    size_t IdleCount;
+    size_t Hits;
+    size_t Misses;
 } NetworkAddressCache;
 
 typedef enum
@@ -79,19 +90,21 @@ typedef enum
 
 #define MAX_URI_LENGTH  (256)
 
+// Maximum number of unreferenced addresses kept for reuse. Addresses that are in use are never evicted.
 #ifndef MAX_NETWORK_ADDRESS_CACHE
-    #define MAX_NETWORK_ADDRESS_CACHE  (5)
+    #define MAX_NETWORK_ADDRESS_CACHE  (16384)
 #endif
 
-static NetworkAddressCache networkAddressCache[MAX_NETWORK_ADDRESS_CACHE] = {{0}};
+static NetworkAddressCache networkAddressCache = {0};
 
 static void addCachedAddress(NetworkAddress * address, const char * uri, int uriLength);
 static NetworkAddress * getCachedAddress(NetworkAddress * matchAddress, const char * uri, int uriLength);
 static NetworkAddress * getCachedAddressByUri(const char * uri, int uriLength);
+static void retainCachedAddress(NetworkAddress * address);
 static int getUriHostLength(const char * uri, int uriLength);
 
 #ifndef ENCRYPT_BUFFER_LENGTH
-#define ENCRYPT_BUFFER_LENGTH 1024
+#define ENCRYPT_BUFFER_LENGTH 1280
 #endif
 
 uint8_t encryptBuffer[ENCRYPT_BUFFER_LENGTH];
@@ -106,8 +119,13 @@ NetworkAddress * NetworkAddress_New(const char * uri, int uriLength)
         int uriHostLength = getUriHostLength(uri, uriLength);
         if (uriHostLength > 0)
             result = getCachedAddressByUri(uri, uriHostLength);
-        if (!result)
+        if (result)
         {
+            networkAddressCache.Hits++;
+        }
+        else
+        {
+            networkAddressCache.Misses++;
             bool secure = false;
             int index = 0;
             int startIndex = 0;
@@ -235,11 +253,11 @@ NetworkAddress * NetworkAddress_New(const char * uri, int uriLength)
 
         if (result)
         {
-            if (result->useCount == 0)
+            if (!result->Cached)
             {
                 addCachedAddress(result, uri, uriHostLength);
             }
-            result->useCount++;
+            retainCachedAddress(result);
         }
     }
     return result;
@@ -286,6 +304,23 @@ void NetworkAddress_SetAddressType(NetworkAddress * address, AddressType * addre
     }
 }
 
+static void removeCachedAddress(NetworkAddress * address)
+{
+    if (address->Uri)
+    {
+        Lwm2m_Debug("Address free: %s\n", address->Uri);
+        HashTable_Remove(&networkAddressCache.UriIndex, &address->UriIndex);
+        free(address->Uri);
+        address->Uri = NULL;
+    }
+    else
+    {
+        Lwm2m_Debug("Address free\n");
+    }
+    HashTable_Remove(&networkAddressCache.AddressIndex, &address->AddressIndex);
+    address->Cached = false;
+}
+
 void NetworkAddress_Free(NetworkAddress ** address)
 {
     // TODO - review when addresses are freed (e.g. after client bootstrap, or connection lost ?)
@@ -294,31 +329,40 @@ void NetworkAddress_Free(NetworkAddress ** address)
         (*address)->useCount--;
         if ((*address)->useCount == 0)
         {
-            int index;
-            for (index = 0; index < MAX_NETWORK_ADDRESS_CACHE; index++)
+            if ((*address)->Cached)
             {
-                if (networkAddressCache[index].address == *address)
+                // Keep the address for reuse, evicting the least recently used unreferenced addresses
+                ListAdd(&(*address)->IdleList, &networkAddressCache.IdleList);
+                networkAddressCache.IdleCount++;
+                while (networkAddressCache.IdleCount > MAX_NETWORK_ADDRESS_CACHE)
                 {
-                    if (networkAddressCache[index].uri)
-                    {
-                        Lwm2m_Debug("Address free: %s\n", networkAddressCache[index].uri);
-                        free(networkAddressCache[index].uri);
-                        networkAddressCache[index].uri = NULL;
-                    }
-                    else
-                    {
-                        Lwm2m_Debug("Address free\n");
-                    }
-                    networkAddressCache[index].address = NULL;
-                    break;
+                    NetworkAddress * evicted = ListEntry(networkAddressCache.IdleList.Next, NetworkAddress, IdleList);
+                    ListRemove(&evicted->IdleList);
+                    networkAddressCache.IdleCount--;
+                    removeCachedAddress(evicted);
+                    free(evicted);
                 }
             }
-            free(*address);
+            else
+            {
+                free(*address);
+            }
         }
         *address = NULL;
     }
 }
 
+void NetworkAddress_GetCacheStatistics(NetworkAddressCacheStatistics * statistics)
+{
+    if (statistics)
+    {
+        statistics->Hits = networkAddressCache.Hits;
+        statistics->Misses = networkAddressCache.Misses;
+        statistics->Entries = networkAddressCache.Initialised ? HashTable_Count(&networkAddressCache.AddressIndex) : 0;
+        statistics->IdleEntries = networkAddressCache.IdleCount;
+    }
+}
+
 bool NetworkAddress_IsSecure(const NetworkAddress * address)
 {
     bool result = false;
@@ -329,50 +373,92 @@ bool NetworkAddress_IsSecure(const NetworkAddress * address)
     return result;
 }
 
+static void initCache(void)
+{
+    if (!networkAddressCache.Initialised)
+    {
+        HashTable_Init(&networkAddressCache.AddressIndex, HASH_TABLE_DEFAULT_BUCKETS);
+        HashTable_Init(&networkAddressCache.UriIndex, HASH_TABLE_DEFAULT_BUCKETS);
+        ListInit(&networkAddressCache.IdleList);
+        networkAddressCache.Initialised = true;
+    }
+}
+
+// Hash the same fields that NetworkAddress_Compare matches on
+static uint32_t hashAddress(const NetworkAddress * address)
+{
+    uint32_t hash = 0;
+    if (address->Address.Sa.sa_family == AF_INET)
+    {
+        hash = Hash_Bytes(&address->Address.Sin.sin_addr, sizeof(address->Address.Sin.sin_addr)) ^ Hash_Integer(address->Address.Sin.sin_port);
+    }
+    else if (address->Address.Sa.sa_family == AF_INET6)
+    {
+        hash = Hash_Bytes(&address->Address.Sin6.sin6_addr, sizeof(address->Address.Sin6.sin6_addr)) ^ Hash_Integer(address->Address.Sin6.sin6_port);
+    }
+    return hash;
+}
+
+static void setCachedAddressUri(NetworkAddress * address, const char * uri, int uriLength)
+{
+    address->Uri = (char *)malloc(uriLength + 1);
+    if (address->Uri)
+    {
+        memcpy(address->Uri, uri, uriLength);
+        address->Uri[uriLength] = 0;
+        HashTable_Add(&networkAddressCache.UriIndex, &address->UriIndex, Hash_Bytes(uri, uriLength));
+    }
+}
+
 static void addCachedAddress(NetworkAddress * address, const char * uri, int uriLength)
 {
     if (address)
     {
-        int index;
-        for (index = 0; index < MAX_NETWORK_ADDRESS_CACHE; index++)
+        initCache();
+        ListInit(&address->IdleList);
+        address->Uri = NULL;
+        if (uri && uriLength > 0)
         {
-            if (networkAddressCache[index].address == NULL)
+            setCachedAddressUri(address, uri, uriLength);
+            if (address->Uri)
             {
-                if (uri && uriLength > 0)
-                {
-                    networkAddressCache[index].uri = (char *)malloc(uriLength + 1);
-                    if (networkAddressCache[index].uri)
-                    {
-                        memcpy(networkAddressCache[index].uri, uri, uriLength);
-                        networkAddressCache[index].uri[uriLength] = 0;
-                        networkAddressCache[index].address = address;
-                        Lwm2m_Debug("Address add: %s\n", networkAddressCache[index].uri);
-                    }
-                }
-                else
-                {
-                    networkAddressCache[index].address = address;
-                    networkAddressCache[index].uri = NULL;
-                    Lwm2m_Debug("Address add (received)\n");    // TODO - print remote address
-                }
-                break;
+                Lwm2m_Debug("Address add: %s\n", address->Uri);
             }
         }
+        else
+        {
+            Lwm2m_Debug("Address add (received)\n");    // TODO - print remote address
+        }
+        HashTable_Add(&networkAddressCache.AddressIndex, &address->AddressIndex, hashAddress(address));
+        address->Cached = true;
     }
 }
 
-
+// Take a reference to an address, removing it from the LRU list if it was unreferenced
+static void retainCachedAddress(NetworkAddress * address)
+{
+    if ((address->useCount == 0) && address->Cached && (address->IdleList.Next != &address->IdleList))
+    {
+        ListRemove(&address->IdleList);
+        networkAddressCache.IdleCount--;
+    }
+    address->useCount++;
+}
 
 static NetworkAddress * getCachedAddressByUri(const char * uri, int uriLength)
 {
     NetworkAddress * result = NULL;
-    int index;
-    for (index = 0; index < MAX_NETWORK_ADDRESS_CACHE; index++)
+    initCache();
+    uint32_t hash = Hash_Bytes(uri, uriLength);
+    struct ListHead * i;
+    ListForEach(i, HashTable_GetBucket(&networkAddressCache.UriIndex, hash))
     {
-        if (networkAddressCache[index].uri && (memcmp(networkAddressCache[index].uri, uri, uriLength) == 0))
+        HashEntry * entry = ListEntry(i, HashEntry, list);
+        NetworkAddress * address = ListEntry(entry, NetworkAddress, UriIndex);
+        if ((entry->Hash == hash) && (strncmp(address->Uri, uri, uriLength) == 0) && (address->Uri[uriLength] == 0))
         {
-            //Lwm2m_Debug("Address uri matched: %s\n", networkAddressCache[index].uri);
-            result = networkAddressCache[index].address;
+            //Lwm2m_Debug("Address uri matched: %s\n", address->Uri);
+            result = address;
             break;
         }
     }
@@ -382,29 +468,27 @@ static NetworkAddress * getCachedAddressByUri(const char * uri, int uriLength)
 static NetworkAddress * getCachedAddress(NetworkAddress * matchAddress, const char * uri, int uriLength)
 {
     NetworkAddress * result = NULL;
-    int index;
-    for (index = 0; index < MAX_NETWORK_ADDRESS_CACHE; index++)
+    initCache();
+    uint32_t hash = hashAddress(matchAddress);
+    struct ListHead * i;
+    ListForEach(i, HashTable_GetBucket(&networkAddressCache.AddressIndex, hash))
     {
-        NetworkAddress * address = networkAddressCache[index].address;
-        if (address)
+        HashEntry * entry = ListEntry(i, HashEntry, list);
+        NetworkAddress * address = ListEntry(entry, NetworkAddress, AddressIndex);
+        if ((entry->Hash == hash) && (NetworkAddress_Compare(matchAddress, address) == 0))
         {
-            if (NetworkAddress_Compare(matchAddress, address) == 0)
+            if (uri && uriLength > 0 && address->Uri == NULL)
             {
-                if (uri && uriLength > 0 && networkAddressCache[index].uri == NULL)
+                // Add info to cached address
+                address->Secure = matchAddress->Secure;
+                setCachedAddressUri(address, uri, uriLength);
+                if (address->Uri)
                 {
-                    // Add info to cached address
-                    address->Secure = matchAddress->Secure;
-                    networkAddressCache[index].uri = (char *)malloc(uriLength + 1);
-                    if (networkAddressCache[index].uri)
-                    {
-                        memcpy(networkAddressCache[index].uri, uri, uriLength);
-                        networkAddressCache[index].uri[uriLength] = 0;
-                        Lwm2m_Debug("Address add uri: %s\n", networkAddressCache[index].uri);
-                    }
+                    Lwm2m_Debug("Address add uri: %s\n", address->Uri);
                 }
-                result = address;
-                break;
             }
+            result = address;
+            break;
         }
     }
     return result;
@@ -579,6 +663,7 @@ bool readUDP(NetworkSocket * networkSocket, int socketHandle, uint8_t * buffer,
 
         if (networkAddress == NULL)
         {
+            networkAddressCache.Misses++;
             networkAddress = (NetworkAddress *)malloc(size);
             if (networkAddress)
             {
@@ -588,6 +673,15 @@ bool readUDP(NetworkSocket * networkSocket, int socketHandle, uint8_t * buffer,
                 networkAddress->useCount++;         // TODO - ensure addresses are freed? (after t/o or transaction or DTLS session closed)
             }
         }
+        else
+        {
+            networkAddressCache.Hits++;
+            if (networkAddress->useCount == 0)
+            {
+                // the source address may be held by transactions, so it must not be evicted
+                retainCachedAddress(networkAddress);
+            }
+        }
         if (networkAddress)
         {
             *sourceAddress = networkAddress;
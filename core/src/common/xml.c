@@ -29,21 +29,59 @@
 
 #include "xml.h"
 
-#define IPC_MAX_BUFFER_LEN (65536)
+// The binary encoding starts with a header that can never begin an XML document. The root node follows, and each
+// node is encoded as its name, value and child count followed by its children. Lengths and counts are LEB128
+// varints, and the value length is offset by one so that zero can represent a node without a value.
+static const uint8_t binaryHeader[] = { 0x00, 'A', 'W', 0x01 };
+#define BINARY_MAX_DEPTH (32)
 
-static int _TreeToString(const TreeNode node, char * buffer, size_t bufferSize, int level);
+// Text output is rendered by a writer that tracks the length the output requires, even past the end of a fixed buffer,
+// so that callers can learn the exact size of a message that does not fit. A growable writer reallocates instead.
+typedef struct
+{
+    char * Buffer;
+    size_t Capacity;    // excludes the terminator
+    size_t Length;
+    bool Growable;
+    bool Indent;
+    bool Failed;
+} XmlWriter;
+
+static void WriteTree(XmlWriter * writer, const TreeNode node, int level);
+static char * TreeToAllocatedString(const TreeNode node, bool indent, size_t * length);
 
 void Xml_TreeToStdout(const TreeNode node, const char * tag)
 {
-    static const size_t bufferSize = IPC_MAX_BUFFER_LEN;
-    char buffer[bufferSize];
-    _TreeToString(node, buffer, bufferSize, 0);
-    printf("%s:\n%s\n", tag == NULL ? "Xml_TreeToStdout" : tag, buffer);
+    char * buffer = TreeToAllocatedString(node, true, NULL);
+    printf("%s:\n%s\n", tag == NULL ? "Xml_TreeToStdout" : tag, buffer == NULL ? "" : buffer);
+    free(buffer);
 }
 
 int Xml_TreeToString(const TreeNode node, char * buffer, size_t bufferSize)
 {
-    return _TreeToString(node, buffer, bufferSize, 0);
+    XmlWriter writer = { .Buffer = buffer, .Capacity = bufferSize > 0 ? bufferSize - 1 : 0, .Indent = true };
+    WriteTree(&writer, node, 0);
+    if (bufferSize > 0)
+    {
+        buffer[writer.Length <= writer.Capacity ? writer.Length : writer.Capacity] = '\0';
+    }
+    return writer.Length <= writer.Capacity ? (int)writer.Length : -1;
+}
+
+int Xml_TreeToCompactString(const TreeNode node, char * buffer, size_t bufferSize)
+{
+    XmlWriter writer = { .Buffer = buffer, .Capacity = bufferSize > 0 ? bufferSize - 1 : 0 };
+    WriteTree(&writer, node, 0);
+    if (bufferSize > 0)
+    {
+        buffer[writer.Length <= writer.Capacity ? writer.Length : writer.Capacity] = '\0';
+    }
+    return (int)writer.Length;
+}
+
+char * Xml_TreeToAllocatedString(const TreeNode node, size_t * length)
+{
+    return TreeToAllocatedString(node, false, length);
 }
 
 TreeNode Xml_CreateNode(const char * name)
@@ -60,6 +98,30 @@ TreeNode Xml_CreateNode(const char * name)
     return node;
 }
 
+// Format a decimal integer into digits, which must hold at least 12 characters. Returns the length.
+static size_t FormatInteger(int value, char * digits)
+{
+    char reversed[12];
+    size_t length = 0;
+    unsigned int magnitude = value < 0 ? 0u - (unsigned int)value : (unsigned int)value;
+    do
+    {
+        reversed[length++] = '0' + (magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+
+    size_t pos = 0;
+    if (value < 0)
+    {
+        digits[pos++] = '-';
+    }
+    while (length > 0)
+    {
+        digits[pos++] = reversed[--length];
+    }
+    return pos;
+}
+
 TreeNode Xml_CreateNodeWithValue(const char * name, const char * format, ...)
 {
     va_list args;
@@ -69,6 +131,27 @@ TreeNode Xml_CreateNodeWithValue(const char * name, const char * format, ...)
     {
         return NULL;
     }
+
+    // Most IPC values are a single integer or string, which need no formatting buffer
+    if (strcmp(format, "%d") == 0)
+    {
+        char digits[12];
+        va_start(args, format);
+        size_t length = FormatInteger(va_arg(args, int), digits);
+        va_end(args);
+        TreeNode_SetValue(node, (const uint8_t *)digits, length);
+        return node;
+    }
+    if (strcmp(format, "%s") == 0)
+    {
+        va_start(args, format);
+        const char * string = va_arg(args, const char *);
+        va_end(args);
+        string = string ? string : "(null)";
+        TreeNode_SetValue(node, (const uint8_t *)string, strlen(string));
+        return node;
+    }
+
     va_start(args, format);
     int requiredSize = vsnprintf(NULL, 0, format, args);
     va_end(args);
@@ -144,58 +227,292 @@ TreeNode Xml_FindChildWithGrandchildValue(const TreeNode parentNode, const char
 
 void Xml_Dump(const TreeNode node)
 {
-    char buffer[65536] = { 0 };
-    Xml_TreeToString(node, buffer, sizeof(buffer));
-    printf("tree: %s\n", buffer);
+    char * buffer = TreeToAllocatedString(node, true, NULL);
+    printf("tree: %s\n", buffer == NULL ? "" : buffer);
+    free(buffer);
 }
 
-static int _TreeToString(const TreeNode node, char * buffer, size_t bufferSize, int level)
+// Return space for length more bytes of output, or NULL if they do not fit. The length is counted either way.
+static char * XmlWriter_Reserve(XmlWriter * writer, size_t length)
 {
-    const char * name = TreeNode_GetName(node);
-    int pos = 0;
-    int rc;
+    size_t required = writer->Length + length;
+    if ((required > writer->Capacity) && writer->Growable && !writer->Failed)
+    {
+        size_t capacity = writer->Capacity > 0 ? writer->Capacity : 1024;
+        while (capacity < required)
+        {
+            capacity *= 2;
+        }
+        char * buffer = realloc(writer->Buffer, capacity + 1);
+        if (buffer != NULL)
+        {
+            writer->Buffer = buffer;
+            writer->Capacity = capacity;
+        }
+        else
+        {
+            writer->Failed = true;
+        }
+    }
 
-    if (TreeNode_GetChild(node, 0) != NULL)
+    char * space = (required <= writer->Capacity) ? &writer->Buffer[writer->Length] : NULL;
+    writer->Length = required;
+    return space;
+}
+
+static void XmlWriter_Put(XmlWriter * writer, const char * bytes, size_t length)
+{
+    char * space = XmlWriter_Reserve(writer, length);
+    if (space != NULL)
     {
-        TreeNode child;
-        int idx = 0;
+        memcpy(space, bytes, length);
+    }
+}
 
-        rc = snprintf(buffer, bufferSize, "%*s<%s>\n", level, "", name);
-        if ((rc == -1) || (rc >= bufferSize))
+static void XmlWriter_PutIndent(XmlWriter * writer, int level)
+{
+    if (writer->Indent)
+    {
+        char * space = XmlWriter_Reserve(writer, level);
+        if (space != NULL)
         {
-            return -1;
+            memset(space, ' ', level);
         }
-        pos += rc;
+    }
+}
 
-        while ((child = TreeNode_GetChild(node, idx++)) != NULL)
+static void XmlWriter_PutNewline(XmlWriter * writer)
+{
+    if (writer->Indent)
+    {
+        XmlWriter_Put(writer, "\n", 1);
+    }
+}
+
+// Copy runs of ordinary characters in one go, escaping only the characters that would be parsed as markup
+static void XmlWriter_PutEscaped(XmlWriter * writer, const char * text)
+{
+    while (*text != '\0')
+    {
+        size_t run = strcspn(text, "&<>");
+        XmlWriter_Put(writer, text, run);
+        text += run;
+
+        switch (*text)
         {
-            rc = _TreeToString(child, &buffer[pos], bufferSize - pos, level + 1);
-            if (rc < 0)
-            {
-                return -1;
-            }
-            pos += rc;
+            case '&':
+                XmlWriter_Put(writer, "&amp;", 5);
+                break;
+            case '<':
+                XmlWriter_Put(writer, "&lt;", 4);
+                break;
+            case '>':
+                XmlWriter_Put(writer, "&gt;", 4);
+                break;
+            default:
+                return;
         }
+        text++;
+    }
+}
 
-        rc = snprintf(&buffer[pos], bufferSize - pos, "%*s</%s>\n", level, "", name);
-        if ((rc == -1) || (rc >= bufferSize - pos))
+static void WriteTree(XmlWriter * writer, const TreeNode node, int level)
+{
+    const char * name = TreeNode_GetName(node);
+    name = name ? name : "";
+    size_t nameLength = strlen(name);
+    int childCount = TreeNode_GetChildCount(node);
+
+    XmlWriter_PutIndent(writer, level);
+    XmlWriter_Put(writer, "<", 1);
+    XmlWriter_Put(writer, name, nameLength);
+    XmlWriter_Put(writer, ">", 1);
+
+    if (childCount > 0)
+    {
+        int index;
+        XmlWriter_PutNewline(writer);
+        for (index = 0; index < childCount; index++)
         {
-            return -1;
+            WriteTree(writer, TreeNode_GetChild(node, index), level + 1);
         }
-        pos += rc;
+        XmlWriter_PutIndent(writer, level);
     }
     else
     {
         const char * value = (const char *)TreeNode_GetValue(node);
+        if (value != NULL)
+        {
+            XmlWriter_PutEscaped(writer, value);
+        }
+    }
+
+    XmlWriter_Put(writer, "</", 2);
+    XmlWriter_Put(writer, name, nameLength);
+    XmlWriter_Put(writer, ">", 1);
+    XmlWriter_PutNewline(writer);
+}
 
-        rc = snprintf(buffer, bufferSize, "%*s<%s>%s</%s>\n", level, "", name, value ? value : "", name);
-        if ((rc == -1) || (rc >= bufferSize))
+static char * TreeToAllocatedString(const TreeNode node, bool indent, size_t * length)
+{
+    XmlWriter writer = { .Growable = true, .Indent = indent };
+    WriteTree(&writer, node, 0);
+    if (writer.Failed)
+    {
+        free(writer.Buffer);
+        writer.Buffer = NULL;
+        writer.Length = 0;
+    }
+    else
+    {
+        writer.Buffer[writer.Length] = '\0';
+    }
+
+    if (length != NULL)
+    {
+        *length = writer.Buffer != NULL ? writer.Length : 0;
+    }
+    return writer.Buffer;
+}
+
+static int PutVarint(uint8_t * buffer, size_t bufferSize, int pos, uint32_t value)
+{
+    do
+    {
+        if (pos >= bufferSize)
         {
             return -1;
         }
-        pos += rc;
+        uint8_t byte = value & 0x7f;
+        value >>= 7;
+        buffer[pos++] = value ? (byte | 0x80) : byte;
+    } while (value);
+    return pos;
+}
+
+static int PutBytes(uint8_t * buffer, size_t bufferSize, int pos, const void * bytes, size_t length)
+{
+    if ((pos < 0) || (pos + length > bufferSize))
+    {
+        return -1;
     }
+    memcpy(&buffer[pos], bytes, length);
+    return pos + length;
+}
 
+static int _TreeToBinary(const TreeNode node, uint8_t * buffer, size_t bufferSize, int pos)
+{
+    const char * name = TreeNode_GetName(node);
+    size_t nameLength = name ? strlen(name) : 0;
+    pos = PutBytes(buffer, bufferSize, PutVarint(buffer, bufferSize, pos, nameLength), name, nameLength);
+
+    const char * value = (const char *)TreeNode_GetValue(node);
+    size_t valueLength = value ? strlen(value) : 0;
+    if (pos >= 0)
+    {
+        pos = PutVarint(buffer, bufferSize, pos, value ? valueLength + 1 : 0);
+        pos = PutBytes(buffer, bufferSize, pos, value, valueLength);
+    }
+
+    int childCount = TreeNode_GetChildCount(node);
+    if (pos >= 0)
+    {
+        pos = PutVarint(buffer, bufferSize, pos, childCount);
+    }
+
+    int index;
+    for (index = 0; (index < childCount) && (pos >= 0); index++)
+    {
+        pos = _TreeToBinary(TreeNode_GetChild(node, index), buffer, bufferSize, pos);
+    }
     return pos;
 }
 
+int Xml_TreeToBinary(const TreeNode node, uint8_t * buffer, size_t bufferSize)
+{
+    int pos = PutBytes(buffer, bufferSize, 0, binaryHeader, sizeof(binaryHeader));
+    return (pos >= 0) ? _TreeToBinary(node, buffer, bufferSize, pos) : -1;
+}
+
+static bool GetVarint(const uint8_t * buffer, size_t length, size_t * pos, uint32_t * value)
+{
+    int shift;
+    *value = 0;
+    for (shift = 0; (shift < 32) && (*pos < length); shift += 7)
+    {
+        uint8_t byte = buffer[(*pos)++];
+        *value |= (uint32_t)(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static TreeNode _BinaryToTree(const uint8_t * buffer, size_t length, size_t * pos, int depth)
+{
+    uint32_t nameLength, valueLength, childCount;
+    if ((depth > BINARY_MAX_DEPTH) ||
+        !GetVarint(buffer, length, pos, &nameLength) || (nameLength > length - *pos))
+    {
+        return NULL;
+    }
+    const uint8_t * name = &buffer[*pos];
+    *pos += nameLength;
+
+    if (!GetVarint(buffer, length, pos, &valueLength) || (valueLength > length - *pos + 1))
+    {
+        return NULL;
+    }
+    const uint8_t * value = &buffer[*pos];
+    *pos += valueLength ? valueLength - 1 : 0;
+
+    // each child occupies at least three bytes
+    if (!GetVarint(buffer, length, pos, &childCount) || (childCount > (length - *pos) / 3))
+    {
+        return NULL;
+    }
+
+    TreeNode node = TreeNode_Create();
+    if ((node == NULL) || !TreeNode_SetName(node, (const char *)name, nameLength) ||
+        ((valueLength > 0) && !TreeNode_SetValue(node, value, valueLength - 1)))
+    {
+        Tree_Delete(node);
+        return NULL;
+    }
+
+    uint32_t index;
+    for (index = 0; index < childCount; index++)
+    {
+        TreeNode child = _BinaryToTree(buffer, length, pos, depth + 1);
+        if (child == NULL)
+        {
+            Tree_Delete(node);
+            return NULL;
+        }
+        TreeNode_AddChild(node, child);
+    }
+    return node;
+}
+
+TreeNode Xml_BinaryToTree(const uint8_t * buffer, size_t length)
+{
+    TreeNode node = NULL;
+    if (Xml_IsBinary(buffer, length))
+    {
+        size_t pos = sizeof(binaryHeader);
+        node = _BinaryToTree(buffer, length, &pos, 0);
+        if ((node != NULL) && (pos != length))
+        {
+            Tree_Delete(node);
+            node = NULL;
+        }
+    }
+    return node;
+}
+
+bool Xml_IsBinary(const uint8_t * buffer, size_t length)
+{
+    return (buffer != NULL) && (length >= sizeof(binaryHeader)) && (memcmp(buffer, binaryHeader, sizeof(binaryHeader)) == 0);
+}
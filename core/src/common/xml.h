@@ -38,7 +38,7 @@ extern "C" {
 void Xml_TreeToStdout(const TreeNode node, const char * tag);
 
 /**
- * @brief Render XML tree to buffer.
+ * @brief Render XML tree to buffer, indented one space per level for readability.
  * @param[in] node Root of XML tree.
  * @param[out] buffer Buffer for resultant string.
  * @param[in] bufferSize Size of buffer for resultant string.
@@ -46,6 +46,49 @@ void Xml_TreeToStdout(const TreeNode node, const char * tag);
  */
 int Xml_TreeToString(const TreeNode node, char * buffer, size_t bufferSize);
 
+/**
+ * @brief Render XML tree to buffer without indentation or line breaks, for IPC.
+ *        Like snprintf, output that does not fit is truncated and the string is always terminated.
+ * @param[in] node Root of XML tree.
+ * @param[out] buffer Buffer for resultant string, may be NULL if bufferSize is zero.
+ * @param[in] bufferSize Size of buffer for resultant string.
+ * @return Length of the complete string, excluding the terminator. The output was truncated if this is not less than bufferSize.
+ */
+int Xml_TreeToCompactString(const TreeNode node, char * buffer, size_t bufferSize);
+
+/**
+ * @brief Render XML tree without indentation or line breaks into a newly allocated string.
+ * @param[in] node Root of XML tree.
+ * @param[out] length Optional resultant string length.
+ * @return String to be released with free(), or NULL on allocation failure.
+ */
+char * Xml_TreeToAllocatedString(const TreeNode node, size_t * length);
+
+/**
+ * @brief Render tree to buffer in the compact binary encoding, an alternative to XML for IPC.
+ * @param[in] node Root of tree.
+ * @param[out] buffer Buffer for resultant encoding.
+ * @param[in] bufferSize Size of buffer for resultant encoding.
+ * @return Resultant encoding length on success, -1 if buffer overruns.
+ */
+int Xml_TreeToBinary(const TreeNode node, uint8_t * buffer, size_t bufferSize);
+
+/**
+ * @brief Parse a tree from the compact binary encoding produced by Xml_TreeToBinary.
+ * @param[in] buffer Encoded tree.
+ * @param[in] length Length of encoded tree.
+ * @return Root of tree, or NULL if the encoding is invalid.
+ */
+TreeNode Xml_BinaryToTree(const uint8_t * buffer, size_t length);
+
+/**
+ * @brief Determine whether a buffer holds a binary encoded tree, rather than XML.
+ * @param[in] buffer Buffer to test.
+ * @param[in] length Length of buffer.
+ * @return true if the buffer starts with the binary encoding header.
+ */
+bool Xml_IsBinary(const uint8_t * buffer, size_t length);
+
 /**
  * @brief Create an XML TreeNode with specified name.
  * @param[in] name Name of the node.
@@ -283,6 +283,16 @@ int coap_receive(NetworkSocket * networkSocket)
                     coap_handle_notification(sourceAddress, message);
                 }
 //#endif /* COAP_OBSERVE_CLIENT */
+                /* separate response to a request that was acknowledged earlier */
+                else if(message->code != 0 && message->token_len > 0)
+                {
+                    if(coap_handle_separate_response(sourceAddress, message) && message->type == COAP_TYPE_CON)
+                    {
+                        PRINTF("Acknowledging separate response\n");
+                        coap_init_message(response, COAP_TYPE_ACK, 0, message->mid);
+                        NetworkSocket_Send(networkSocket, sourceAddress, CoapBuffer, coap_serialize_message(response, CoapBuffer));
+                    }
+                }
             } /* request or response */
         } /* parsed correctly */
 
@@ -97,5 +97,6 @@ int coap_receive(NetworkSocket * networkSocket);
 void coap_set_service_callback(service_callback_t callback);
 
 void coap_handle_notification(NetworkAddress * sourceAddress, coap_packet_t * message);
+int coap_handle_separate_response(NetworkAddress * sourceAddress, coap_packet_t * message);
 
 #endif /* ER_COAP_ENGINE_H_ */
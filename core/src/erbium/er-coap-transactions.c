@@ -37,7 +37,9 @@
  */
 
 #include "string.h"
+#include <stdlib.h>
 #include "../common/lwm2m_list.h"
+#include "../common/lwm2m_util.h"
 #include "er-coap-transactions.h"
 
 /*---------------------------------------------------------------------------*/
@@ -47,6 +49,12 @@
 
 struct ListHead transactions_list = {0};
 
+/* open transactions hashed by MID, so responses are matched in constant time */
+static HashTable transactions_by_mid = {0};
+
+/* retransmission deadlines of open transactions */
+static DeadlineQueue transactions_timeouts = {0};
+
 //static struct process *transaction_handler_process = NULL;
 
 /*---------------------------------------------------------------------------*/
@@ -61,6 +69,22 @@ struct ListHead transactions_list = {0};
 void coap_init_transactions(void)
 {
 	ListInit(&transactions_list);
+	HashTable_Init(&transactions_by_mid, HASH_TABLE_DEFAULT_BUCKETS);
+	DeadlineQueue_Init(&transactions_timeouts);
+}
+
+void coap_destroy_transactions(void)
+{
+    struct ListHead * current = NULL;
+    struct ListHead * next = NULL;
+
+    ListForEachSafe(current, next, &transactions_list)
+    {
+        coap_transaction_t *t = ListEntry(current, struct coap_transaction, list);
+        coap_clear_transaction(&t);
+    }
+    HashTable_Destroy(&transactions_by_mid);
+    DeadlineQueue_Destroy(&transactions_timeouts);
 }
 
 coap_transaction_t * coap_new_transaction(NetworkSocket * networkSocket, uint16_t mid, NetworkAddress * remoteAddress)
@@ -73,78 +97,53 @@ coap_transaction_t * coap_new_transaction(NetworkSocket * networkSocket, uint16_
         t->retrans_counter = 0;
         t->networkSocket = networkSocket;
         t->remoteAddress = remoteAddress;
+        DeadlineQueue_InitEntry(&t->retrans_deadline);
 
         ListAdd(&t->list, &transactions_list); /* list itself makes sure same element is not added twice */
+        HashTable_Add(&transactions_by_mid, &t->mid_index, Hash_Integer(mid));
     }
 
     return t;
 }
 /*---------------------------------------------------------------------------*/
+static void coap_schedule_retransmission(coap_transaction_t *t)
+{
+    if(t->retrans_counter == 0)
+    {
+        t->retrans_timer = COAP_RESPONSE_TIMEOUT_MS + (rand() % (COAP_RESPONSE_TIMEOUT_BACKOFF_MS + 1));
+        PRINTF("Initial interval %u ms\n", t->retrans_timer);
+    }
+    else
+    {
+        t->retrans_timer <<= 1;  /* double */
+        PRINTF("Doubled (%u) interval %u ms\n", t->retrans_counter, t->retrans_timer);
+    }
+    DeadlineQueue_Schedule(&transactions_timeouts, &t->retrans_deadline, Lwm2mCore_GetTickCountMs() + t->retrans_timer);
+}
+
 void coap_send_transaction(coap_transaction_t *t)
 {
     PRINTF("Sending transaction %u\n", t->mid);
 
-
-    //coap_send_message(&t->addr, t->port, t->packet, t->packet_len);
     if (NetworkSocket_Send(t->networkSocket, t->remoteAddress, t->packet, t->packet_len))
     {
         t->sent = true;
         if(COAP_TYPE_CON ==
                 ((COAP_HEADER_TYPE_MASK & t->packet[0]) >> COAP_HEADER_TYPE_POSITION))
         {
-            if(t->retrans_counter < COAP_MAX_RETRANSMIT)
-            {
-                /* not timed out yet */
-                PRINTF("Keeping transaction %u\n", t->mid);
-
-                if(t->retrans_counter == 0)
-                {
-    //                t->retrans_timer.timer.interval =
-    //                        COAP_RESPONSE_TIMEOUT_TICKS + (random_rand()
-    //                                %
-    //                                (clock_time_t)
-    //                                COAP_RESPONSE_TIMEOUT_BACKOFF_MASK);
-    //                PRINTF("Initial interval %f\n",
-    //                        (float)t->retrans_timer.timer.interval / CLOCK_SECOND);
-                }
-                else
-                {
-    //                t->retrans_timer.timer.interval <<= 1;  /* double */
-    //                PRINTF("Doubled (%u) interval %f\n", t->retrans_counter,
-    //                        (float)t->retrans_timer.timer.interval / CLOCK_SECOND);
-                }
-
-    //            PROCESS_CONTEXT_BEGIN(transaction_handler_process);
-    //            etimer_restart(&t->retrans_timer);        /* interval updated above */
-    //            PROCESS_CONTEXT_END(transaction_handler_process);
-
-                t = NULL;
-            }
-            else
-            {
-                /* timed out */
-                PRINTF("Timeout\n");
-                restful_response_handler callback = t->callback;
-                void *callback_data = t->callback_data;
-
-                /* handle observers */
-                //coap_remove_observer_by_client(t->session);	// TODO - restore when observe supported
-
-                coap_clear_transaction(&t);
-
-                if(callback)
-                {
-                    callback(callback_data, NULL);
-                }
-            }
+            /* keep transaction until it is acknowledged or times out */
+            PRINTF("Keeping transaction %u\n", t->mid);
+            coap_schedule_retransmission(t);
         } else {
             coap_clear_transaction(&t);
         }
     }
     else
     {
-        PRINTF("Failed to sened transaciton %u\n", t->mid);
+        /* a failed send is treated like a lost message and retried with the same backoff */
+        PRINTF("Failed to send transaction %u\n", t->mid);
         t->sent = false;
+        coap_schedule_retransmission(t);
     }
 }
 /*---------------------------------------------------------------------------*/
@@ -154,8 +153,9 @@ void coap_clear_transaction(coap_transaction_t **t)
     {
         PRINTF("Freeing transaction %u: %p\n", (*t)->mid, (*t));
 
-        //etimer_stop(&t->retrans_timer);
+        DeadlineQueue_Cancel(&transactions_timeouts, &(*t)->retrans_deadline);
         ListRemove(&(*t)->list);
+        HashTable_Remove(&transactions_by_mid, &(*t)->mid_index);
         free(*t);
         *t = NULL;
     }
@@ -164,12 +164,14 @@ void coap_clear_transaction(coap_transaction_t **t)
 coap_transaction_t * coap_get_transaction_by_mid(uint16_t mid)
 {
     struct ListHead * i = NULL;
+    uint32_t hash = Hash_Integer(mid);
 
-    ListForEach(i, &transactions_list)
+    ListForEach(i, HashTable_GetBucket(&transactions_by_mid, hash))
     {
-        struct coap_transaction * t = ListEntry(i, struct coap_transaction, list);
+        HashEntry * entry = ListEntry(i, HashEntry, list);
+        struct coap_transaction * t = ListEntry(entry, struct coap_transaction, mid_index);
 
-        if(t->mid == mid) {
+        if(entry->Hash == hash && t->mid == mid) {
             PRINTF("Found transaction for MID %u: %p\n", t->mid, t);
             return t;
         }
@@ -179,22 +181,39 @@ coap_transaction_t * coap_get_transaction_by_mid(uint16_t mid)
 /*---------------------------------------------------------------------------*/
 void coap_check_transactions()
 {
-    struct ListHead * current = NULL;
-    struct ListHead * next = NULL;
+    uint64_t now = Lwm2mCore_GetTickCountMs();
+    DeadlineEntry * entry;
 
-    ListForEachSafe(current ,next, &transactions_list)
+    /* only transactions whose retransmission timer has expired are visited */
+    while ((entry = DeadlineQueue_PopExpired(&transactions_timeouts, now)) != NULL)
     {
+        coap_transaction_t *t = ListEntry(entry, struct coap_transaction, retrans_deadline);
 
-        coap_transaction_t *t = ListEntry(current, struct coap_transaction, list);
-
-        //if(t->retrans_timer == 0)
-        if (!t->sent)
+        if(t->retrans_counter < COAP_MAX_RETRANSMIT)
         {
-            //++(t->retrans_counter);
-            //PRINTF("Retransmitting %u (%u)\n", t->mid, t->retrans_counter);
+            ++(t->retrans_counter);
+            PRINTF("Retransmitting %u (%u)\n", t->mid, t->retrans_counter);
             coap_send_transaction(t);
         }
-    }
+        else
+        {
+            /* timed out */
+            PRINTF("Timeout %u\n", t->mid);
+            restful_response_handler callback = t->callback;
+            void *callback_data = t->callback_data;
+
+            coap_clear_transaction(&t);
 
+            if(callback)
+            {
+                callback(callback_data, NULL);
+            }
+        }
+    }
+}
+/*---------------------------------------------------------------------------*/
+int coap_get_transactions_timeout(int max_timeout)
+{
+    return DeadlineQueue_GetTimeout(&transactions_timeouts, Lwm2mCore_GetTickCountMs(), max_timeout);
 }
 /*---------------------------------------------------------------------------*/
@@ -40,25 +40,32 @@
 #define COAP_TRANSACTIONS_H_
 
 #include "../common/lwm2m_list.h"
+#include "../common/lwm2m_hash.h"
+#include "../common/lwm2m_deadline_queue.h"
 #include "er-coap.h"
 #include "er-resource.h"
 #include "network_abstraction.h"
 
 /*
- * Modulo mask (thus +1) for a random number to get the tick number for the random
- * retransmission time between COAP_RESPONSE_TIMEOUT and COAP_RESPONSE_TIMEOUT*COAP_RESPONSE_RANDOM_FACTOR.
+ * Transmission parameters in milliseconds (RFC 7252 section 4.8). The initial retransmission
+ * timeout is chosen at random between COAP_RESPONSE_TIMEOUT and COAP_RESPONSE_TIMEOUT*COAP_RESPONSE_RANDOM_FACTOR
+ * and doubled on every retransmission.
  */
-#define COAP_RESPONSE_TIMEOUT_TICKS         (CLOCK_SECOND * COAP_RESPONSE_TIMEOUT)
-#define COAP_RESPONSE_TIMEOUT_BACKOFF_MASK  (long)((CLOCK_SECOND * COAP_RESPONSE_TIMEOUT * ((float)COAP_RESPONSE_RANDOM_FACTOR - 1.0)) + 0.5) + 1
+#define COAP_RESPONSE_TIMEOUT_MS            (COAP_RESPONSE_TIMEOUT * 1000)
+#define COAP_RESPONSE_TIMEOUT_BACKOFF_MS    ((uint32_t)(COAP_RESPONSE_TIMEOUT_MS * (COAP_RESPONSE_RANDOM_FACTOR - 1.0)))
+#define COAP_MAX_TRANSMIT_SPAN_MS           ((uint32_t)(COAP_RESPONSE_TIMEOUT_MS * ((1 << COAP_MAX_RETRANSMIT) - 1) * COAP_RESPONSE_RANDOM_FACTOR))
+#define COAP_MAX_LATENCY_MS                 (100 * 1000)
+#define COAP_EXCHANGE_LIFETIME_MS           (COAP_MAX_TRANSMIT_SPAN_MS + (2 * COAP_MAX_LATENCY_MS) + COAP_RESPONSE_TIMEOUT_MS)
 
 /* container for transactions with message buffer and retransmission info */
 typedef struct coap_transaction
 {
     struct ListHead list;
+    HashEntry mid_index;
 
     uint16_t mid;
-    //struct etimer retrans_timer;
-    uint32_t retrans_timer;
+    DeadlineEntry retrans_deadline;
+    uint32_t retrans_timer;         /* current retransmission timeout in ms */
     uint8_t retrans_counter;
 
     NetworkSocket * networkSocket;
@@ -76,11 +83,13 @@ typedef struct coap_transaction
 void coap_register_as_transaction_handler(void);
 
 void coap_init_transactions(void);
+void coap_destroy_transactions(void);
 coap_transaction_t * coap_new_transaction(NetworkSocket * networkSocket, uint16_t mid, NetworkAddress * remoteAddress);
 void coap_send_transaction(coap_transaction_t *t);
 void coap_clear_transaction(coap_transaction_t **t);
 coap_transaction_t *coap_get_transaction_by_mid(uint16_t mid);
 
 void coap_check_transactions(void);
+int coap_get_transactions_timeout(int max_timeout);
 
 #endif /* COAP_TRANSACTIONS_H_ */
@@ -290,7 +290,10 @@ int coap_set_header_size1(void *packet, uint32_t size);
 int coap_get_payload(void *packet, const uint8_t **payload);
 int coap_set_payload(void *packet, const void *payload, size_t length);
 
-#define COAP_BUFFER_LENGTH   1024
+// Large enough to receive a 1024 byte block (SZX 6) with its header
+#ifndef COAP_BUFFER_LENGTH
+#define COAP_BUFFER_LENGTH   (COAP_MAX_HEADER_SIZE + 1024)
+#endif
 extern uint8_t CoapBuffer[COAP_BUFFER_LENGTH];
 
 
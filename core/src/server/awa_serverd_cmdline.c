@@ -39,6 +39,7 @@ const char *gengetopt_args_info_help[] = {
   "  -f, --addressFamily=AF  Address family for network interface. AF=4 for IPv4,\n                            AF=6 for IPv6  (possible values=\"4\", \"6\"\n                            default=`4')",
   "  -p, --port=PORT         Use port number PORT for CoAP communications\n                            (default=`5683')",
   "  -i, --ipcPort=PORT      Use port number PORT for IPC communications\n                            (default=`54321')",
+  "  -u, --ipcUnix=PATH      Also accept IPC connections on Unix domain socket\n                            PATH",
   "  -m, --contentType=ID    Use Content Type ID (TLV=1542, JSON=50)  (possible\n                            values=\"50\", \"1542\" default=`1542')",
   "  -s, --secure            CoAP communications are secured with DTLS\n                            (default=off)",
   "  -o, --objDefs=FILE      Load object and resource definitions from FILE",
@@ -83,6 +84,7 @@ void clear_given (struct gengetopt_args_info *args_info)
   args_info->addressFamily_given = 0 ;
   args_info->port_given = 0 ;
   args_info->ipcPort_given = 0 ;
+  args_info->ipcUnix_given = 0 ;
   args_info->contentType_given = 0 ;
   args_info->secure_given = 0 ;
   args_info->objDefs_given = 0 ;
@@ -106,6 +108,8 @@ void clear_args (struct gengetopt_args_info *args_info)
   args_info->port_orig = NULL;
   args_info->ipcPort_arg = 54321;
   args_info->ipcPort_orig = NULL;
+  args_info->ipcUnix_arg = NULL;
+  args_info->ipcUnix_orig = NULL;
   args_info->contentType_arg = 1542;
   args_info->contentType_orig = NULL;
   args_info->secure_flag = 0;
@@ -130,15 +134,16 @@ void init_args_info(struct gengetopt_args_info *args_info)
   args_info->addressFamily_help = gengetopt_args_info_help[3] ;
   args_info->port_help = gengetopt_args_info_help[4] ;
   args_info->ipcPort_help = gengetopt_args_info_help[5] ;
-  args_info->contentType_help = gengetopt_args_info_help[6] ;
-  args_info->secure_help = gengetopt_args_info_help[7] ;
-  args_info->objDefs_help = gengetopt_args_info_help[8] ;
+  args_info->ipcUnix_help = gengetopt_args_info_help[6] ;
+  args_info->contentType_help = gengetopt_args_info_help[7] ;
+  args_info->secure_help = gengetopt_args_info_help[8] ;
+  args_info->objDefs_help = gengetopt_args_info_help[9] ;
   args_info->objDefs_min = 1;
   args_info->objDefs_max = 16;
-  args_info->daemonize_help = gengetopt_args_info_help[9] ;
-  args_info->verbose_help = gengetopt_args_info_help[10] ;
-  args_info->logFile_help = gengetopt_args_info_help[11] ;
-  args_info->version_help = gengetopt_args_info_help[12] ;
+  args_info->daemonize_help = gengetopt_args_info_help[10] ;
+  args_info->verbose_help = gengetopt_args_info_help[11] ;
+  args_info->logFile_help = gengetopt_args_info_help[12] ;
+  args_info->version_help = gengetopt_args_info_help[13] ;
   
 }
 
@@ -277,6 +282,8 @@ cmdline_parser_release (struct gengetopt_args_info *args_info)
   free_string_field (&(args_info->addressFamily_orig));
   free_string_field (&(args_info->port_orig));
   free_string_field (&(args_info->ipcPort_orig));
+  free_string_field (&(args_info->ipcUnix_arg));
+  free_string_field (&(args_info->ipcUnix_orig));
   free_string_field (&(args_info->contentType_orig));
   free_multiple_string_field (args_info->objDefs_given, &(args_info->objDefs_arg), &(args_info->objDefs_orig));
   free_string_field (&(args_info->logFile_arg));
@@ -377,6 +384,8 @@ cmdline_parser_dump(FILE *outfile, struct gengetopt_args_info *args_info)
     write_into_file(outfile, "port", args_info->port_orig, 0);
   if (args_info->ipcPort_given)
     write_into_file(outfile, "ipcPort", args_info->ipcPort_orig, 0);
+  if (args_info->ipcUnix_given)
+    write_into_file(outfile, "ipcUnix", args_info->ipcUnix_orig, 0);
   if (args_info->contentType_given)
     write_into_file(outfile, "contentType", args_info->contentType_orig, cmdline_parser_contentType_values);
   if (args_info->secure_given)
@@ -1550,6 +1559,7 @@ cmdline_parser_internal (
         { "addressFamily",	1, NULL, 'f' },
         { "port",	1, NULL, 'p' },
         { "ipcPort",	1, NULL, 'i' },
+        { "ipcUnix",	1, NULL, 'u' },
         { "contentType",	1, NULL, 'm' },
         { "secure",	0, NULL, 's' },
         { "objDefs",	1, NULL, 'o' },
@@ -1565,7 +1575,7 @@ cmdline_parser_internal (
       custom_opterr = opterr;
       custom_optopt = optopt;
 
-      c = custom_getopt_long (argc, argv, "ha:e:f:p:i:m:so:dvl:V", long_options, &option_index);
+      c = custom_getopt_long (argc, argv, "ha:e:f:p:i:u:m:so:dvl:V", long_options, &option_index);
 
       optarg = custom_optarg;
       optind = custom_optind;
@@ -1640,6 +1650,18 @@ cmdline_parser_internal (
               additional_error))
             goto failure;
         
+          break;
+        case 'u':	/* Also accept IPC connections on Unix domain socket PATH.  */
+        
+        
+          if (update_arg( (void *)&(args_info->ipcUnix_arg), 
+               &(args_info->ipcUnix_orig), &(args_info->ipcUnix_given),
+              &(local_args_info.ipcUnix_given), optarg, 0, 0, ARG_STRING,
+              check_ambiguity, override, 0, 0,
+              "ipcUnix", 'u',
+              additional_error))
+            goto failure;
+        
           break;
         case 'm':	/* Use Content Type ID (TLV=1542, JSON=50).  */
         
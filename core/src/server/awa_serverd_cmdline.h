@@ -53,6 +53,9 @@ struct gengetopt_args_info
   int ipcPort_arg;	/**< @brief Use port number PORT for IPC communications (default='54321').  */
   char * ipcPort_orig;	/**< @brief Use port number PORT for IPC communications original value given at command line.  */
   const char *ipcPort_help; /**< @brief Use port number PORT for IPC communications help description.  */
+  char * ipcUnix_arg;	/**< @brief Also accept IPC connections on Unix domain socket PATH.  */
+  char * ipcUnix_orig;	/**< @brief Also accept IPC connections on Unix domain socket PATH original value given at command line.  */
+  const char *ipcUnix_help; /**< @brief Also accept IPC connections on Unix domain socket PATH help description.  */
   int contentType_arg;	/**< @brief Use Content Type ID (TLV=1542, JSON=50) (default='1542').  */
   char * contentType_orig;	/**< @brief Use Content Type ID (TLV=1542, JSON=50) original value given at command line.  */
   const char *contentType_help; /**< @brief Use Content Type ID (TLV=1542, JSON=50) help description.  */
@@ -79,6 +82,7 @@ struct gengetopt_args_info
   unsigned int addressFamily_given ;	/**< @brief Whether addressFamily was given.  */
   unsigned int port_given ;	/**< @brief Whether port was given.  */
   unsigned int ipcPort_given ;	/**< @brief Whether ipcPort was given.  */
+  unsigned int ipcUnix_given ;	/**< @brief Whether ipcUnix was given.  */
   unsigned int contentType_given ;	/**< @brief Whether contentType was given.  */
   unsigned int secure_given ;	/**< @brief Whether secure was given.  */
   unsigned int objDefs_given ;	/**< @brief Whether objDefs was given.  */
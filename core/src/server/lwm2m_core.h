@@ -29,6 +29,8 @@
 #include <stdio.h>
 #include "lwm2m_context.h"
 #include "lwm2m_list.h"
+#include "lwm2m_hash.h"
+#include "lwm2m_deadline_queue.h"
 #include "coap_abstraction.h"
 #include "lwm2m_types.h"
 #include "lwm2m_debug.h"
@@ -47,6 +49,7 @@ extern "C" {
 Lwm2mContextType * Lwm2mCore_Init(CoapInfo * coap, ContentType contentType);
 
 // Update the LWM2M state machine, process any message timeouts, registration attempts etc.
+// Returns the number of milliseconds until the next registration expires.
 int Lwm2mCore_Process(Lwm2mContextType * context);
 
 int Lwm2mCore_GetEndPointClientName(Lwm2mContextType * context, char * buffer, int len);
@@ -91,6 +94,10 @@ int Lwm2mCore_RemoveResourceEndPoint(Lwm2mContextType * context, const char * pa
 DefinitionRegistry * Lwm2mCore_GetDefinitions(Lwm2mContextType * context);
 
 struct ListHead * Lwm2mCore_GetClientList(Lwm2mContextType * context);
+HashTable * Lwm2mCore_GetClientNameIndex(Lwm2mContextType * context);
+HashTable * Lwm2mCore_GetClientLocationIndex(Lwm2mContextType * context);
+HashTable * Lwm2mCore_GetClientAddressIndex(Lwm2mContextType * context);
+DeadlineQueue * Lwm2mCore_GetClientExpiryQueue(Lwm2mContextType * context);
 ContentType Lwm2mCore_GetContentType(Lwm2mContextType * context);
 int Lwm2mCore_GetLastLocation(Lwm2mContextType * context);
 struct ListHead * Lwm2mCore_GetEventRecordList(Lwm2mContextType * context);
@@ -25,6 +25,7 @@
 #include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 
 #include "lwm2m_core.h"
 #include "lwm2m_result.h"
@@ -58,11 +59,13 @@ static void DestroyObjectList(struct ListHead * objectList);
 
 static int RegistrationEndpointHandler(int type, void * ctxt, AddressType * addr, const char * path, const char * query, const char * token,
                                        int tokenLength, ContentType contentType, const char * requestContent, size_t requestContentLen,
-                                       ContentType * responseContentType, char * responseContent, size_t * responseContentLen, int * responseCode);
+                                       ContentType * responseContentType, char * responseContent, size_t * responseContentLen, int * responseCode,
+                                       int32_t * responseOffset);
 
 static int UpdateEndpointHandler(int type, void * ctxt, AddressType * addr, const char * path, const char * query, const char * token,
                                  int tokenLength, ContentType contentType, const char * requestContent, size_t requestContentLen,
-                                 ContentType * responseContentType, char * responseContent, size_t * responseContentLen, int * responseCode);
+                                 ContentType * responseContentType, char * responseContent, size_t * responseContentLen, int * responseCode,
+                                 int32_t * responseOffset);
 
 static void Lwm2m_SplitUpQuery(const char * query, RegistrationQueryString * result)
 {
@@ -237,14 +240,21 @@ static void Lwm2m_ReleaseQueryString(RegistrationQueryString * queryString)
     }
 }
 
+static uint32_t HashAddress(const AddressType * address)
+{
+    return Hash_Bytes(address->Addr.Sa.sa_data, sizeof(address->Addr.Sa.sa_data));
+}
+
 Lwm2mClientType * Lwm2m_LookupClientByName(Lwm2mContextType * context, const char * endPointName)
 {
     Lwm2mClientType * client = NULL;
+    uint32_t hash = Hash_String(endPointName);
     struct ListHead * i;
-    ListForEach(i, Lwm2mCore_GetClientList(context))
+    ListForEach(i, HashTable_GetBucket(Lwm2mCore_GetClientNameIndex(context), hash))
     {
-        Lwm2mClientType * c = ListEntry(i, Lwm2mClientType, list);
-        if (strcmp(c->EndPointName, endPointName) == 0)
+        HashEntry * entry = ListEntry(i, HashEntry, list);
+        Lwm2mClientType * c = ListEntry(entry, Lwm2mClientType, NameIndex);
+        if ((entry->Hash == hash) && (strcmp(c->EndPointName, endPointName) == 0))
         {
             client = c;
             break;
@@ -256,10 +266,12 @@ Lwm2mClientType * Lwm2m_LookupClientByName(Lwm2mContextType * context, const cha
 static Lwm2mClientType * Lwm2m_LookupClientByLocation(Lwm2mContextType * context, int location)
 {
     Lwm2mClientType * client = NULL;
+    uint32_t hash = Hash_Integer(location);
     struct ListHead * i;
-    ListForEach(i, Lwm2mCore_GetClientList(context))
+    ListForEach(i, HashTable_GetBucket(Lwm2mCore_GetClientLocationIndex(context), hash))
     {
-        Lwm2mClientType * c = ListEntry(i, Lwm2mClientType, list);
+        HashEntry * entry = ListEntry(i, HashEntry, list);
+        Lwm2mClientType * c = ListEntry(entry, Lwm2mClientType, LocationIndex);
         if (c->Location == location)
         {
             client = c;
@@ -272,12 +284,14 @@ static Lwm2mClientType * Lwm2m_LookupClientByLocation(Lwm2mContextType * context
 Lwm2mClientType * Lwm2m_LookupClientByAddress(Lwm2mContextType * context, AddressType * address)
 {
     Lwm2mClientType * client = NULL;
+    uint32_t hash = HashAddress(address);
     struct ListHead * i;
-    ListForEach(i, Lwm2mCore_GetClientList(context))
+    ListForEach(i, HashTable_GetBucket(Lwm2mCore_GetClientAddressIndex(context), hash))
     {
-        Lwm2mClientType * c = ListEntry(i, Lwm2mClientType, list);
+        HashEntry * entry = ListEntry(i, HashEntry, list);
+        Lwm2mClientType * c = ListEntry(entry, Lwm2mClientType, AddressIndex);
 
-        if (memcmp(c->Address.Addr.Sa.sa_data, address->Addr.Sa.sa_data, sizeof(c->Address.Addr.Sa.sa_data)) == 0)
+        if ((entry->Hash == hash) && (memcmp(c->Address.Addr.Sa.sa_data, address->Addr.Sa.sa_data, sizeof(c->Address.Addr.Sa.sa_data)) == 0))
         {
             client = c;
             break;
@@ -315,7 +329,7 @@ static int Lwm2m_UpdateClient(Lwm2mContextType * context, int location, int life
     Lwm2mClientType * client = Lwm2m_LookupClientByLocation(context, location);
     if (client)
     {
-        uint32_t now = Lwm2mCore_GetTickCountMs();
+        uint64_t now = Lwm2mCore_GetTickCountMs();
 
         if (lifeTime > 0)
         {
@@ -326,7 +340,10 @@ static int Lwm2m_UpdateClient(Lwm2mContextType * context, int location, int life
             client->LifeTime = LIFETIME_DEFAULT;
         }
 
+        // the client may have moved, so re-index it under its new address
+        HashTable_Remove(Lwm2mCore_GetClientAddressIndex(context), &client->AddressIndex);
         memcpy(&client->Address, addr, sizeof(AddressType));
+        HashTable_Add(Lwm2mCore_GetClientAddressIndex(context), &client->AddressIndex, HashAddress(&client->Address));
 
         if (contentType == ContentType_ApplicationLinkFormat)
         {
@@ -334,6 +351,7 @@ static int Lwm2m_UpdateClient(Lwm2mContextType * context, int location, int life
         }
 
         client->LastUpdateTime = now;
+        DeadlineQueue_Schedule(Lwm2mCore_GetClientExpiryQueue(context), &client->Expiry, now + (client->LifeTime * 1000ULL));
 
         DispatchRegistrationEventCallbacks(context, registrationEventType, client);
 
@@ -366,8 +384,12 @@ static int Lwm2m_RegisterClient(Lwm2mContextType * context, const char * endPoin
             Lwm2mCore_SetLastLocation(context, client->Location);
 
             ListInit(&client->ObjectList);
+            ListInit(&client->AddressIndex.list);
+            DeadlineQueue_InitEntry(&client->Expiry);
 
             ListAdd(&client->list, Lwm2mCore_GetClientList(context));
+            HashTable_Add(Lwm2mCore_GetClientNameIndex(context), &client->NameIndex, Hash_String(client->EndPointName));
+            HashTable_Add(Lwm2mCore_GetClientLocationIndex(context), &client->LocationIndex, Hash_Integer(client->Location));
 
             sprintf(RegisterLocation, "/rd/%d", client->Location);
             Lwm2mCore_AddResourceEndPoint(context, RegisterLocation, UpdateEndpointHandler);
@@ -393,6 +415,10 @@ static void Lwm2m_DeregisterClient(Lwm2mContextType * context, Lwm2mClientType *
     char RegisterLocation[128] = {0};
 
     ListRemove(&client->list);
+    HashTable_Remove(Lwm2mCore_GetClientNameIndex(context), &client->NameIndex);
+    HashTable_Remove(Lwm2mCore_GetClientLocationIndex(context), &client->LocationIndex);
+    HashTable_Remove(Lwm2mCore_GetClientAddressIndex(context), &client->AddressIndex);
+    DeadlineQueue_Cancel(Lwm2mCore_GetClientExpiryQueue(context), &client->Expiry);
     DestroyObjectList(&client->ObjectList);
 
     sprintf(RegisterLocation, "/rd/%d", client->Location);
@@ -548,7 +574,8 @@ done:
  */
 static int UpdateEndpointHandler(int type, void * ctxt, AddressType * addr, const char * path, const char * query, const char * token,
                                  int tokenLength, ContentType contentType, const char * requestContent, size_t requestContentLen,
-                                 ContentType * responseContentType, char * responseContent, size_t * responseContentLen, int * responseCode)
+                                 ContentType * responseContentType, char * responseContent, size_t * responseContentLen, int * responseCode,
+                                 int32_t * responseOffset)
 {
     switch(type)
     {
@@ -575,7 +602,8 @@ static int UpdateEndpointHandler(int type, void * ctxt, AddressType * addr, cons
 // This function is called when a CoAP request is made to /rd
 static int RegistrationEndpointHandler(int type, void * ctxt, AddressType * addr, const char * path, const char * query, const char * token,
                                        int tokenLength, ContentType contentType, const char * requestContent, size_t requestContentLen,
-                                       ContentType * responseContentType, char * responseContent, size_t * responseContentLen, int * responseCode)
+                                       ContentType * responseContentType, char * responseContent, size_t * responseContentLen, int * responseCode,
+                                       int32_t * responseOffset)
 {
     switch (type)
     {
@@ -593,27 +621,29 @@ static int RegistrationEndpointHandler(int type, void * ctxt, AddressType * addr
 
 int32_t Lwm2m_AgeRegistrations(Lwm2mContextType * context)
 {
-    uint32_t now = Lwm2mCore_GetTickCountMs();
-    struct ListHead * i, *n;
+    uint64_t now = Lwm2mCore_GetTickCountMs();
+    DeadlineQueue * expiryQueue = Lwm2mCore_GetClientExpiryQueue(context);
+    DeadlineEntry * expired;
 
-    ListForEachSafe(i, n, Lwm2mCore_GetClientList(context))
+    while ((expired = DeadlineQueue_PopExpired(expiryQueue, now)) != NULL)
     {
-        Lwm2mClientType * client = ListEntry(i, Lwm2mClientType, list);
+        Lwm2mClientType * client = ListEntry(expired, Lwm2mClientType, Expiry);
 
-        if ((now - client->LastUpdateTime) > (client->LifeTime * 1000))
-        {
-            Lwm2m_Error("Client \'%s\' Lifetime Expired\n", client->EndPointName);
+        Lwm2m_Error("Client \'%s\' Lifetime Expired\n", client->EndPointName);
 
-            Lwm2m_DeregisterClient(context, client);
-        }
+        Lwm2m_DeregisterClient(context, client);
     }
-    return 0;
+    return DeadlineQueue_GetTimeout(expiryQueue, now, INT32_MAX);
 }
 
 int Lwm2m_RegistrationInit(Lwm2mContextType * context)
 {
     // Initialise client list
     ListInit(Lwm2mCore_GetClientList(context));
+    HashTable_Init(Lwm2mCore_GetClientNameIndex(context), HASH_TABLE_DEFAULT_BUCKETS);
+    HashTable_Init(Lwm2mCore_GetClientLocationIndex(context), HASH_TABLE_DEFAULT_BUCKETS);
+    HashTable_Init(Lwm2mCore_GetClientAddressIndex(context), HASH_TABLE_DEFAULT_BUCKETS);
+    DeadlineQueue_Init(Lwm2mCore_GetClientExpiryQueue(context));
     Lwm2mCore_SetLastLocation(context, 0);
 
     Lwm2mCore_AddResourceEndPoint(context, "/rd", RegistrationEndpointHandler);
@@ -678,7 +708,12 @@ static void DestroyEventList(struct ListHead * eventRecordList)
 
 void Lwm2m_RegistrationDestroy(Lwm2mContextType * context)
 {
+    // the expiry queue updates the entries embedded in each client, so it must go before the clients do
+    DeadlineQueue_Destroy(Lwm2mCore_GetClientExpiryQueue(context));
     DestroyClientList(Lwm2mCore_GetClientList(context));
+    HashTable_Destroy(Lwm2mCore_GetClientNameIndex(context));
+    HashTable_Destroy(Lwm2mCore_GetClientLocationIndex(context));
+    HashTable_Destroy(Lwm2mCore_GetClientAddressIndex(context));
     DestroyEventList(Lwm2mCore_GetEventRecordList(context));
 }
 
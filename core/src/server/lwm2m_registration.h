@@ -82,6 +82,10 @@ typedef struct
     char * ResourceType;               // RFC6690 Resource Type parameter
     bool SupportsJson;                 // The Client supports JSON for all objects
     int Location;                      // /rd/location, this should probably be a string
+    HashEntry NameIndex;               // Entry in the client endpoint name index
+    HashEntry LocationIndex;           // Entry in the client location index
+    HashEntry AddressIndex;            // Entry in the client address index
+    DeadlineEntry Expiry;              // Entry in the registration expiry queue
 
 } Lwm2mClientType;
 
@@ -89,7 +93,8 @@ int Lwm2m_RegistrationInit(Lwm2mContextType * context);
 void Lwm2m_RegistrationDestroy(Lwm2mContextType * context);
 
 /* Age the client registrations. The registration will be removed by the server if a registration or update
- * has not been received with the client lifetime.
+ * has not been received with the client lifetime. Only expired registrations are visited.
+ * Returns the number of milliseconds until the next registration expires.
  */
 int32_t Lwm2m_AgeRegistrations(Lwm2mContextType * context);
 
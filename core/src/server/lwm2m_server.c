@@ -62,6 +62,7 @@ typedef struct
     int AddressFamily;
     int CoapPort;
     int IpcPort;
+    char * IpcUnixPath;
     int ContentType;
     bool Secure;
     const char * ObjDefsFiles[MAX_OBJDEFS_FILES];
@@ -172,6 +173,10 @@ static int Lwm2mServer_Start(Options * options)
     Lwm2m_Info("  CoAP port      : %d\n", options->CoapPort);
     Lwm2m_Info("  CoAP Security  : %s\n", options->Secure ? "DTLS": "None");
     Lwm2m_Info("  IPC port       : %d\n", options->IpcPort);
+    if (options->IpcUnixPath != NULL)
+    {
+        Lwm2m_Info("  IPC socket     : %s\n", options->IpcUnixPath);
+    }
 
     if (options->InterfaceName != NULL)
     {
@@ -232,21 +237,44 @@ static int Lwm2mServer_Start(Options * options)
     }
     xmlif_RegisterHandlers();
 
+    // optionally accept stream connections on a Unix domain socket too
+    if ((options->IpcUnixPath != NULL) && (xmlif_InitUnix(options->IpcUnixPath) < 0))
+    {
+        result = 1;
+        goto error_destroy;
+    }
+
     // wait for messages on both the IPC and CoAP interfaces
+    struct pollfd * fds = NULL;
+    int maxfds = 0;
     while (!quit)
     {
         int loop_result;
-        struct pollfd fds[2];
-        int nfds = 2;
+        int nfds = 2 + xmlif_GetNumStreamFds();
         int timeout;
 
+        if (nfds > maxfds)
+        {
+            struct pollfd * newfds = realloc(fds, nfds * sizeof(*fds));
+            if (newfds == NULL)
+            {
+                Lwm2m_Error("Failed to allocate memory\n");
+                break;
+            }
+            fds = newfds;
+            maxfds = nfds;
+        }
+
         fds[0].fd = coap->fd;
         fds[0].events = POLLIN;
 
         fds[1].fd = xmlFd;
         fds[1].events = POLLIN;
 
+        nfds = 2 + xmlif_GetStreamFds(&fds[2], nfds - 2);
+
         timeout = Lwm2mCore_Process(context);
+        timeout = coap_GetTimeout(timeout);
 
         loop_result = poll(fds, nfds, timeout);
 
@@ -269,9 +297,11 @@ static int Lwm2mServer_Start(Options * options)
             {
                 xmlif_process(fds[1].fd);
             }
+            xmlif_ProcessStreamFds(&fds[2], nfds - 2);
         }
         coap_Process();
     }
+    free(fds);
     Lwm2m_Debug("Exit triggered\n");
 
 error_destroy:
@@ -297,6 +327,7 @@ static void PrintOptions(const Options * options)
     printf("  AddressFamily     (--addressFamily)  : %d\n", options->AddressFamily == AF_INET? 4 : 6);
     printf("  CoapPort          (--port)           : %d\n", options->CoapPort);
     printf("  IpcPort           (--ipcPort)        : %d\n", options->IpcPort);
+    printf("  IpcUnixPath       (--ipcUnix)        : %s\n", options->IpcUnixPath ? options->IpcUnixPath : "");
     printf("  ContentType       (--content)        : %d\n", options->ContentType);
     printf("  Secure            (--secure)         : %d\n", options->Secure);
     int i;
@@ -320,6 +351,7 @@ static int ParseOptions(int argc, char ** argv, struct gengetopt_args_info * ai,
         options->AddressFamily = ai->addressFamily_arg == 4 ? AF_INET : AF_INET6;
         options->CoapPort = ai->port_arg;
         options->IpcPort = ai->ipcPort_arg;
+        options->IpcUnixPath = ai->ipcUnix_arg;
         options->ContentType = ai->contentType_arg;
         options->Secure = ai->secure_flag;
         int i;
@@ -357,6 +389,7 @@ int main(int argc, char ** argv)
         .AddressFamily = AF_UNSPEC,
         .CoapPort = 0,
         .IpcPort = 0,
+        .IpcUnixPath = NULL,
         .ContentType = 0,
         .Secure = false,
         .ObjDefsFiles = {0},
@@ -44,6 +44,10 @@ struct _Lwm2mContextType
     ResourceEndPointList EndPointList;        // CoAP endpoints
     CoapInfo * Coap;                          // CoAP library context information
     struct ListHead ClientList;               // List of registered clients
+    HashTable ClientNameIndex;                // Registered clients indexed by endpoint name
+    HashTable ClientLocationIndex;            // Registered clients indexed by /rd/<location>
+    HashTable ClientAddressIndex;             // Registered clients indexed by socket address
+    DeadlineQueue ClientExpiryQueue;          // Registered clients ordered by registration expiry time
     int LastLocation;                         // Used for registration, creates /rd/0, /rd/1 etc
     ContentType ContentType;                  // Used to set CoAP content type
     struct ListHead EventRecordList;          // Used to dispatch event callbacks
@@ -79,6 +83,12 @@ int Lwm2mCore_RegisterResourceType(Lwm2mContextType * context, const char * resN
                                            resourceType, maximumInstances, minimumInstances, operations, handlers, NULL);
 }
 
+int Lwm2mCore_GetResourceInstanceValue(Lwm2mContextType * context, ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID,
+                                       ResourceInstanceIDType resourceInstanceID, const void ** buffer, size_t * bufferLen)
+{
+    return ObjectStore_GetResourceInstanceValue(context->Store, objectID, objectInstanceID, resourceID, resourceInstanceID, buffer, bufferLen);
+}
+
 ObjectInstanceIDType Lwm2mCore_GetNextObjectInstanceID(Lwm2mContextType * context, ObjectIDType  objectID, ObjectInstanceIDType objectInstanceID)
 {
     return ObjectStore_GetNextObjectInstanceID(context->Store, objectID, objectInstanceID);
@@ -106,7 +116,7 @@ static int Lwm2mCore_HandleRequest(CoapRequest * request, CoapResponse * respons
         result = endPoint->Handler(request->type, request->ctxt, &request->addr, request->path, request->query,
                  request->token, request->tokenLength, request->contentType, request->requestContent,
                  request->requestContentLen, &response->responseContentType, response->responseContent,
-                 &response->responseContentLen, &response->responseCode);
+                 &response->responseContentLen, &response->responseCode, &response->responseOffset);
     }
     else
     {
@@ -138,6 +148,26 @@ struct ListHead * Lwm2mCore_GetClientList(Lwm2mContextType * context)
     return &context->ClientList;
 }
 
+HashTable * Lwm2mCore_GetClientNameIndex(Lwm2mContextType * context)
+{
+    return &context->ClientNameIndex;
+}
+
+HashTable * Lwm2mCore_GetClientLocationIndex(Lwm2mContextType * context)
+{
+    return &context->ClientLocationIndex;
+}
+
+HashTable * Lwm2mCore_GetClientAddressIndex(Lwm2mContextType * context)
+{
+    return &context->ClientAddressIndex;
+}
+
+DeadlineQueue * Lwm2mCore_GetClientExpiryQueue(Lwm2mContextType * context)
+{
+    return &context->ClientExpiryQueue;
+}
+
 ContentType Lwm2mCore_GetContentType(Lwm2mContextType * context)
 {
     return context->ContentType;
@@ -190,7 +220,5 @@ bool qClientRegisterEvent = false;
 
 int Lwm2mCore_Process(Lwm2mContextType * context)
 {
-    int nextTick = 1000;
-    Lwm2m_AgeRegistrations(context);
-    return nextTick;
+    return Lwm2m_AgeRegistrations(context);
 }
@@ -70,6 +70,19 @@
 #define MAX_PAYLOAD_SIZE (10240)
 #define MAX_URI_LENGTH   (256)
 
+// Maximum number of clients a fan-out request has in flight at once, unless the request sets its own window
+#define DEFAULT_FAN_OUT_WINDOW (16)
+
+typedef struct _FanOutBatch FanOutBatch;
+
+// Per-client state of a request that is fanned out across several clients
+typedef struct
+{
+    FanOutBatch * Batch;
+    char * ClientID;
+    uint64_t StartTime;
+} FanOutClient;
+
 typedef struct
 {
     RequestInfoType * Request;
@@ -79,6 +92,7 @@ typedef struct
     bool Reusable;
     size_t ResponseCount;
     bool AddResultTags;
+    FanOutClient * FanOut;      // NULL unless this request is one client of a fan-out
 } IpcCoapRequestContext;
 
 static int xmlif_HandlerConnectRequest(RequestInfoType * request, TreeNode content);
@@ -125,6 +139,34 @@ static bool xmlif_HandlerSendCoapExecuteRequest(IpcCoapRequestContext * requestC
 static bool xmlif_HandlerSendCoapWriteAttributesRequest(IpcCoapRequestContext * requestContext, Lwm2mClientType * client,
                                                         ObjectInstanceResourceKey * key, TreeNode currentLeafNode, TreeNode currentResponsePathNode);
 
+// single-client request handlers, used directly or once per client of a fan-out
+typedef struct _ClientRequestType ClientRequestType;
+typedef int (*ClientRequestHandler)(RequestInfoType * request, TreeNode content, const ClientRequestType * requestType, FanOutClient * fanOut);
+static int xmlif_HandleClientContentRequest(RequestInfoType * request, TreeNode content, const ClientRequestType * requestType, FanOutClient * fanOut);
+static int xmlif_HandleClientWriteRequest(RequestInfoType * request, TreeNode content, const ClientRequestType * requestType, FanOutClient * fanOut);
+
+struct _ClientRequestType
+{
+    const char * SubType;
+    ClientRequestHandler Handler;
+    SendCoapRequestHandler RequestCallback;
+    TransactionCallback ResponseCallback;
+    AwaResourceOperations ValidOperations;
+};
+
+struct _FanOutBatch
+{
+    RequestInfoType * Request;              // the original IPC request
+    const ClientRequestType * Type;
+    TreeNode PendingClients;                // copy of the request's <Clients>, started in order
+    uint32_t NextClient;
+    uint32_t Window;
+    uint32_t InFlight;
+    bool Starting;
+    bool StreamResults;                     // send each client's result as a notification as it completes
+    TreeNode ResponseClients;               // <Clients> of the final response
+};
+
 // successful response callbacks
 typedef void (*IpcCoapSuccessCallback)(IpcCoapRequestContext * requestContext, const char * responsePath,
                                        int coapResponseCode, TreeNode pathNode, const char * responseType, ContentType contentType, char * payload, size_t payloadLen);
@@ -440,13 +482,14 @@ static int xmlif_HandlerConnectRequest(RequestInfoType * request, TreeNode conte
 #ifndef CONTIKI
         Lwm2m_Info("IPC connected from %s - allocated session ID %d\n", Lwm2mCore_DebugPrintSockAddr(&request->FromAddr), request->SessionID);
 #endif
-        IPC_SendResponse(response, request->Sockfd, &request->FromAddr, request->AddrLen);
+        xmlif_NegotiateEncoding(request, response);
+        xmlif_SendResponse(request, response);
         Tree_Delete(response);
     }
     else
     {
         TreeNode response = IPC_NewResponseNode(IPC_MESSAGE_SUB_TYPE_CONNECT, AwaResult_BadRequest, request->SessionID);
-        IPC_SendResponse(response, request->Sockfd, &request->FromAddr, request->AddrLen);
+        xmlif_SendResponse(request, response);
         Tree_Delete(response);
     }
 
@@ -466,14 +509,14 @@ static int xmlif_HandlerEstablishNotifyRequest(RequestInfoType * request, TreeNo
         Lwm2m_AddRegistrationEventCallback(request->Context, request->SessionID, xmlif_HandleRegistrationEvent, eventContext);
 
         TreeNode response = IPC_NewResponseNode(IPC_MESSAGE_SUB_TYPE_ESTABLISH_NOTIFY, AwaResult_Success, request->SessionID);
-        IPC_SendResponse(response, request->Sockfd, &request->FromAddr, request->AddrLen);
+        xmlif_SendResponse(request, response);
         Tree_Delete(response);
     }
     else
     {
         TreeNode response = IPC_NewResponseNode(IPC_MESSAGE_SUB_TYPE_ESTABLISH_NOTIFY, AwaResult_BadRequest, request->SessionID);
         IPC_SetSessionID(response, request->SessionID);
-        IPC_SendResponse(response, request->Sockfd, &request->FromAddr, request->AddrLen);
+        xmlif_SendResponse(request, response);
         Tree_Delete(response);
     }
 
@@ -487,7 +530,7 @@ static int xmlif_HandlerDisconnectRequest(RequestInfoType * request, TreeNode co
     Lwm2m_Info("IPC disconnected from %s\n", Lwm2mCore_DebugPrintSockAddr(&request->FromAddr));
 #endif
     TreeNode response = IPC_NewResponseNode(IPC_MESSAGE_SUB_TYPE_DISCONNECT, AwaResult_Success, request->SessionID);
-    IPC_SendResponse(response, request->Sockfd, &request->FromAddr, request->AddrLen);
+    xmlif_SendResponse(request, response);
     Lwm2m_DeleteRegistrationEventCallback(request->Context, request->SessionID);
     Tree_Delete(response);
 
@@ -525,7 +568,7 @@ static int xmlif_HandlerListClients(RequestInfoType * request, TreeNode content)
 
     TreeNode responseNode = IPC_NewResponseNode(IPC_MESSAGE_SUB_TYPE_LIST_CLIENTS, AwaResult_Success, request->SessionID);
     TreeNode_AddChild(responseNode, contentNode);
-    rc = IPC_SendResponse(responseNode, request->Sockfd, &request->FromAddr, request->AddrLen);
+    rc = xmlif_SendResponse(request, responseNode);
 
     Tree_Delete(responseNode);
     free(request);
@@ -550,7 +593,7 @@ static int xmlif_HandlerDefineRequest(RequestInfoType * request, TreeNode conten
     }
 
     TreeNode response = IPC_NewResponseNode(IPC_MESSAGE_SUB_TYPE_DEFINE, AwaResult_Success, request->SessionID);
-    IPC_SendResponse(response, request->Sockfd, &request->FromAddr, request->AddrLen);
+    xmlif_SendResponse(request, response);
     Tree_Delete(response);
 
     free(request);
@@ -576,11 +619,11 @@ static void xmlif_GenerateResponse(void * ctxt, AddressType* address, const char
         TreeNode_AddChild(response, content);
     }
 
-    IPC_SendResponse(response, request->Sockfd, &request->FromAddr, request->AddrLen);
+    xmlif_SendResponse(request, response);
     Tree_Delete(response);
 }
 
-static int xmlif_HandleRequestHeader(RequestInfoType * request, TreeNode content,
+static int xmlif_HandleRequestHeader(RequestInfoType * request, TreeNode content, FanOutClient * fanOut,
                                      IpcCoapRequestContext ** requestContext, TreeNode * requestObjectsNode, Lwm2mClientType ** client)
 {
     int rc = -1;
@@ -599,6 +642,7 @@ static int xmlif_HandleRequestHeader(RequestInfoType * request, TreeNode content
     (*requestContext)->Reusable = false;
     (*requestContext)->ResponseCount = 0;
     (*requestContext)->AddResultTags = true;
+    (*requestContext)->FanOut = fanOut;
 
     TreeNode requestClientsNode = TreeNode_Navigate(content, "Content/Clients");
     if (requestClientsNode == NULL)
@@ -673,6 +717,196 @@ static int xmlif_BackupPartiallyBuiltResponseTree(TreeNode responseContentNode,
     return 0;
 }
 
+static void xmlif_FanOutComplete(FanOutBatch * batch)
+{
+    RequestInfoType * request = batch->Request;
+
+    if (IPCSession_IsValid(request->SessionID))
+    {
+        TreeNode responseNode = IPC_NewResponseNode(batch->Type->SubType, AwaResult_Success, request->SessionID);
+        TreeNode contentNode = IPC_NewContentNode();
+        TreeNode_AddChild(contentNode, batch->ResponseClients);
+        TreeNode_AddChild(responseNode, contentNode);
+        batch->ResponseClients = NULL;
+
+        xmlif_SendResponse(request, responseNode);
+        Tree_Delete(responseNode);
+    }
+    else
+    {
+        Lwm2m_Error("Unable to get IPC Response channel for session %d", request->SessionID);
+    }
+
+    if (batch->ResponseClients != NULL)
+    {
+        Tree_Delete(batch->ResponseClients);
+    }
+    Tree_Delete(batch->PendingClients);
+    free(batch->Request);
+    free(batch);
+}
+
+// Record a client's latency in its response node, which is already in the batch's <Clients>, and send it as a
+// notification if the request asked for results as they arrive.
+static void xmlif_FanOutReportClient(FanOutBatch * batch, TreeNode responseClientNode, uint64_t latency)
+{
+    TreeNode_AddChild(responseClientNode, Xml_CreateNodeWithValue("Latency", "%" PRIu64, latency));
+
+    if (batch->StreamResults)
+    {
+        int IPCSockFd = 0;
+        const struct sockaddr * IPCAddr = NULL;
+        int IPCAddrLen = 0;
+
+        if (IPCSession_GetNotifyChannel(batch->Request->SessionID, &IPCSockFd, &IPCAddr, &IPCAddrLen) == 0)
+        {
+            TreeNode notificationNode = IPC_NewNotificationNode(IPC_MESSAGE_SUB_TYPE_FAN_OUT_RESULT, batch->Request->SessionID);
+            TreeNode contentNode = IPC_NewContentNode();
+            TreeNode clientsNode = IPC_NewClientsNode();
+            TreeNode_AddChild(clientsNode, Tree_Copy(responseClientNode));
+            TreeNode_AddChild(contentNode, clientsNode);
+            TreeNode_AddChild(notificationNode, contentNode);
+
+            IPC_SendResponse(notificationNode, IPCSockFd, IPCAddr, IPCAddrLen);
+            Tree_Delete(notificationNode);
+        }
+        else
+        {
+            Lwm2m_Error("Unable to get IPC Notify channel for session %d", batch->Request->SessionID);
+        }
+    }
+}
+
+static void xmlif_FanOutStartClients(FanOutBatch * batch)
+{
+    TreeNode requestClientNode;
+
+    // A client that fails without sending a CoAP request completes synchronously, and must not restart this loop
+    batch->Starting = true;
+    while ((batch->InFlight < batch->Window) && ((requestClientNode = TreeNode_GetChild(batch->PendingClients, batch->NextClient)) != NULL))
+    {
+        batch->NextClient++;
+
+        const char * clientID = xmlif_GetOpaque(requestClientNode, "Client/ID");
+        FanOutClient * fanOut = malloc(sizeof(*fanOut));
+        RequestInfoType * clientRequest = malloc(sizeof(*clientRequest));
+        if ((fanOut == NULL) || (clientRequest == NULL) || (clientID == NULL))
+        {
+            Lwm2m_Error("Unable to start request for client %s\n", clientID != NULL ? clientID : "(no ID)");
+            free(fanOut);
+            free(clientRequest);
+
+            // report the client as failed, as if its request had failed synchronously, so it isn't missing from the response
+            TreeNode responseClientNode = IPC_AddClientNode(batch->ResponseClients, clientID != NULL ? clientID : "(no ID)");
+            IPC_AddResultTag(responseClientNode, clientID != NULL ? AwaError_OutOfMemory : AwaError_IPCError);
+            xmlif_FanOutReportClient(batch, responseClientNode, 0);
+            continue;
+        }
+
+        // each client is handled as a request of its own, with its own copy of the IPC request info
+        memcpy(clientRequest, batch->Request, sizeof(*clientRequest));
+        fanOut->Batch = batch;
+        fanOut->ClientID = strdup(clientID);
+        fanOut->StartTime = Lwm2mCore_GetTickCountMs();
+
+        TreeNode clientContent = IPC_NewContentNode();
+        TreeNode clientsNode = IPC_NewClientsNode();
+        TreeNode_AddChild(clientsNode, Tree_Copy(requestClientNode));
+        TreeNode_AddChild(clientContent, clientsNode);
+
+        batch->InFlight++;
+        batch->Type->Handler(clientRequest, clientContent, batch->Type, fanOut);
+        Tree_Delete(clientContent);
+    }
+    batch->Starting = false;
+
+    if ((batch->InFlight == 0) && (TreeNode_GetChild(batch->PendingClients, batch->NextClient) == NULL))
+    {
+        xmlif_FanOutComplete(batch);
+    }
+}
+
+static void xmlif_FanOutClientComplete(IpcCoapRequestContext * requestContext)
+{
+    FanOutClient * fanOut = requestContext->FanOut;
+    FanOutBatch * batch = fanOut->Batch;
+    uint64_t latency = Lwm2mCore_GetTickCountMs() - fanOut->StartTime;
+
+    TreeNode responseClientNode = NULL;
+    if (requestContext->ResponseContentNode != NULL)
+    {
+        responseClientNode = TreeNode_Navigate(requestContext->ResponseContentNode, "Content/Clients/Client");
+    }
+
+    if (responseClientNode != NULL)
+    {
+        Tree_DetachNode(responseClientNode);
+        TreeNode_AddChild(batch->ResponseClients, responseClientNode);
+    }
+    else
+    {
+        // bad request for this client - report it without a result tree
+        responseClientNode = IPC_AddClientNode(batch->ResponseClients, fanOut->ClientID);
+        IPC_AddResultTag(responseClientNode, AwaError_IPCError);
+    }
+    xmlif_FanOutReportClient(batch, responseClientNode, latency);
+
+    if (requestContext->ResponseContentNode != NULL)
+    {
+        Tree_Delete(requestContext->ResponseContentNode);
+    }
+    free(requestContext->Request);
+    free(requestContext);
+    free(fanOut->ClientID);
+    free(fanOut);
+
+    batch->InFlight--;
+    if (!batch->Starting)
+    {
+        xmlif_FanOutStartClients(batch);
+    }
+}
+
+// Requests for more than one client are sent to up to Window clients concurrently. The IPC response is sent once
+// every client has completed, with each client's latency in ms. If the request asks for <FanOut>, each client's
+// result is also sent as a notification when it arrives.
+static int xmlif_HandleFanOutRequest(RequestInfoType * request, TreeNode content, const ClientRequestType * requestType)
+{
+    TreeNode requestClientsNode = TreeNode_Navigate(content, "Content/Clients");
+    TreeNode fanOutNode = TreeNode_Navigate(content, "Content/" IPC_MESSAGE_TAG_FAN_OUT);
+
+    if ((requestClientsNode == NULL) || ((TreeNode_GetChildCount(requestClientsNode) <= 1) && (fanOutNode == NULL)))
+    {
+        return requestType->Handler(request, content, requestType, NULL);
+    }
+
+    FanOutBatch * batch = malloc(sizeof(*batch));
+    if (batch == NULL)
+    {
+        Lwm2m_Error("Out of memory");
+        xmlif_GenerateResponse(request, NULL, NULL, AwaResult_OutOfMemory, requestType->SubType);
+        free(request);
+        return -1;
+    }
+
+    memset(batch, 0, sizeof(*batch));
+    batch->Request = request;
+    batch->Type = requestType;
+    batch->PendingClients = Tree_Copy(requestClientsNode);
+    batch->ResponseClients = IPC_NewClientsNode();
+    batch->Window = DEFAULT_FAN_OUT_WINDOW;
+    batch->StreamResults = (fanOutNode != NULL);
+
+    const char * window = xmlif_GetOpaque(fanOutNode, "FanOut/Window");
+    if ((window != NULL) && (atoi(window) > 0))
+    {
+        batch->Window = atoi(window);
+    }
+
+    xmlif_FanOutStartClients(batch);
+    return 0;
+}
+
 static void xmlif_HandleResponse(IpcCoapRequestContext * requestContext, const char * responsePath, int coapResponseCode,
                                  const char * type, const char * subType, ContentType contentType, char * payload, size_t payloadLen, IpcCoapSuccessCallback successCallback)
 {
@@ -750,7 +984,14 @@ static void xmlif_HandleResponse(IpcCoapRequestContext * requestContext, const c
         responseCode = AwaResult_BadRequest;
     }
 
-    int IPCSockFd = 0;
+    if (requestContext->FanOut != NULL)
+    {
+        // the response is sent once all clients of the fan-out have completed
+        xmlif_FanOutClientComplete(requestContext);
+        return;
+    }
+
+    int IPCSockFd = -1;
     const struct sockaddr * IPCAddr = NULL;
     int IPCAddrLen = 0;
 
@@ -770,7 +1011,8 @@ static void xmlif_HandleResponse(IpcCoapRequestContext * requestContext, const c
     }
     else if (strcmp(type, IPC_MESSAGE_TYPE_RESPONSE) == 0)
     {
-        if (IPCSession_GetRequestChannel(request->SessionID, &IPCSockFd, &IPCAddr, &IPCAddrLen) == 0)
+        // responses go back to wherever the request came from, which may be the notify channel for asynchronous requests
+        if (IPCSession_IsValid(request->SessionID))
         {
 
             responseNode = IPC_NewResponseNode(subType, responseCode, request->SessionID);
@@ -796,7 +1038,15 @@ static void xmlif_HandleResponse(IpcCoapRequestContext * requestContext, const c
         Lwm2m_Error("No response\n");
         responseNode = IPC_NewResponseNode(subType, AwaResult_InternalError, request->SessionID);
     }
-    IPC_SendResponse(responseNode, IPCSockFd, IPCAddr, IPCAddrLen);
+
+    if (IPCSockFd >= 0)
+    {
+        IPC_SendResponse(responseNode, IPCSockFd, IPCAddr, IPCAddrLen);
+    }
+    else
+    {
+        xmlif_SendResponse(request, responseNode);
+    }
 
     Tree_Delete(requestContext->ResponseContentNode);
 
@@ -839,8 +1089,8 @@ static int xmlif_HandleError(IpcCoapRequestContext * requestContext, Lwm2mClient
     return rc;
 }
 
-static int xmlif_HandleContentRequest(RequestInfoType * request, TreeNode content,
-                                      SendCoapRequestHandler requestCallback, TransactionCallback responseCallback, AwaResourceOperations validOperations)
+static int xmlif_HandleContentRequest(RequestInfoType * request, TreeNode content, SendCoapRequestHandler requestCallback,
+                                      TransactionCallback responseCallback, AwaResourceOperations validOperations, FanOutClient * fanOut)
 {
     int numCoapRequests = 0;
     Lwm2mContextType * context = (Lwm2mContextType * )request->Context;
@@ -848,7 +1098,7 @@ static int xmlif_HandleContentRequest(RequestInfoType * request, TreeNode conten
     IpcCoapRequestContext * requestContext;
     Lwm2mClientType * client;
 
-    if (xmlif_HandleRequestHeader(request, content, &requestContext, &requestObjectsNode, &client) != 0)
+    if (xmlif_HandleRequestHeader(request, content, fanOut, &requestContext, &requestObjectsNode, &client) != 0)
     {
         goto error;
     }
@@ -966,9 +1216,16 @@ error:
     return xmlif_HandleError(requestContext, client, responseCallback, numCoapRequests);
 }
 
+static int xmlif_HandleClientContentRequest(RequestInfoType * request, TreeNode content, const ClientRequestType * requestType, FanOutClient * fanOut)
+{
+    return xmlif_HandleContentRequest(request, content, requestType->RequestCallback, requestType->ResponseCallback, requestType->ValidOperations, fanOut);
+}
+
 static int xmlif_HandlerReadRequest(RequestInfoType * request, TreeNode content)
 {
-    return xmlif_HandleContentRequest(request, content, xmlif_HandlerSendCoapReadRequest, xmlif_HandlerReadResponse, AwaResourceOperations_ReadWrite);
+    static const ClientRequestType requestType = { IPC_MESSAGE_SUB_TYPE_READ, xmlif_HandleClientContentRequest,
+                                                   xmlif_HandlerSendCoapReadRequest, xmlif_HandlerReadResponse, AwaResourceOperations_ReadWrite };
+    return xmlif_HandleFanOutRequest(request, content, &requestType);
 }
 
 static bool xmlif_HandlerSendCoapReadRequest(IpcCoapRequestContext * requestContext, Lwm2mClientType * client,
@@ -993,21 +1250,22 @@ static void xmlif_HandlerSuccessfulReadResponse(IpcCoapRequestContext * requestC
     RequestInfoType * request = requestContext->Request;
     Lwm2mContextType * context = (Lwm2mContextType * )request->Context;
     ObjectInstanceResourceKey key = UriToOir(responsePath);
+    Lwm2mTreeArena * arena = Lwm2mTreeArena_New();
     Lwm2mTreeNode * root = NULL;
 
     int len;
 
     if (key.ResourceID != -1)
     {
-        len = DeserialiseResource(contentType, &root, Lwm2mCore_GetDefinitions(context), key.ObjectID, key.InstanceID, key.ResourceID, payload, payloadLen);
+        len = DeserialiseResourceInArena(contentType, &root, arena, Lwm2mCore_GetDefinitions(context), key.ObjectID, key.InstanceID, key.ResourceID, payload, payloadLen);
     }
     else if (key.InstanceID != -1)
     {
-        len = DeserialiseObjectInstance(contentType, &root, Lwm2mCore_GetDefinitions(context), key.ObjectID, key.InstanceID, payload, payloadLen);
+        len = DeserialiseObjectInstanceInArena(contentType, &root, arena, Lwm2mCore_GetDefinitions(context), key.ObjectID, key.InstanceID, payload, payloadLen);
     }
     else
     {
-        len = DeserialiseObject(contentType, &root, Lwm2mCore_GetDefinitions(context), key.ObjectID, payload, payloadLen);
+        len = DeserialiseObjectInArena(contentType, &root, arena, Lwm2mCore_GetDefinitions(context), key.ObjectID, payload, payloadLen);
     }
 
     if (len >= 0)
@@ -1052,11 +1310,12 @@ static void xmlif_HandlerSuccessfulReadResponse(IpcCoapRequestContext * requestC
     }
 
     Lwm2mTreeNode_DeleteRecursive(root);
+    Lwm2mTreeArena_Free(arena);
 }
 
 static int xmlif_HandlerObserveRequest(RequestInfoType * request, TreeNode content)
 {
-    return xmlif_HandleContentRequest(request, content, xmlif_HandlerSendCoapObserveRequest, xmlif_HandlerObserveResponse, AwaResourceOperations_ReadWrite);
+    return xmlif_HandleContentRequest(request, content, xmlif_HandlerSendCoapObserveRequest, xmlif_HandlerObserveResponse, AwaResourceOperations_ReadWrite, NULL);
 }
 
 static bool xmlif_HandlerSendCoapObserveRequest(IpcCoapRequestContext * requestContext, Lwm2mClientType * client,
@@ -1137,7 +1396,7 @@ static int xmlif_HandlerDeleteRequest(RequestInfoType * request, TreeNode conten
     TreeNode requestObjectsNode = NULL;
     int numCoapRequests = 0;
 
-    if (xmlif_HandleRequestHeader(request, content, &requestContext, &requestObjectsNode, &client) != 0)
+    if (xmlif_HandleRequestHeader(request, content, NULL, &requestContext, &requestObjectsNode, &client) != 0)
     {
         goto error;
     }
@@ -1476,6 +1735,12 @@ error:
 }
 
 static int xmlif_HandlerWriteRequest(RequestInfoType * request, TreeNode content)
+{
+    static const ClientRequestType requestType = { IPC_MESSAGE_SUB_TYPE_WRITE, xmlif_HandleClientWriteRequest, NULL, xmlif_HandlerWriteResponse, AwaResourceOperations_ReadWrite };
+    return xmlif_HandleFanOutRequest(request, content, &requestType);
+}
+
+static int xmlif_HandleClientWriteRequest(RequestInfoType * request, TreeNode content, const ClientRequestType * requestType, FanOutClient * fanOut)
 {
     Lwm2mContextType * context = (Lwm2mContextType * )request->Context;
     TreeNode requestObjectsNode = NULL;
@@ -1483,7 +1748,7 @@ static int xmlif_HandlerWriteRequest(RequestInfoType * request, TreeNode content
     Lwm2mClientType * client;
     int numCoapRequests = 0;
 
-    if (xmlif_HandleRequestHeader(request, content, &requestContext, &requestObjectsNode, &client) != 0)
+    if (xmlif_HandleRequestHeader(request, content, fanOut, &requestContext, &requestObjectsNode, &client) != 0)
     {
         goto error;
     }
@@ -1804,7 +2069,9 @@ static void xmlif_HandlerWriteResponse(void * ctxt, AddressType* address, const
 
 static int xmlif_HandlerWriteAttributesRequest(RequestInfoType * request, TreeNode content)
 {
-    return xmlif_HandleContentRequest(request, content, xmlif_HandlerSendCoapWriteAttributesRequest, xmlif_HandlerWriteAttributesResponse, AwaResourceOperations_ReadWrite);
+    static const ClientRequestType requestType = { IPC_MESSAGE_SUB_TYPE_WRITE_ATTRIBUTES, xmlif_HandleClientContentRequest,
+                                                   xmlif_HandlerSendCoapWriteAttributesRequest, xmlif_HandlerWriteAttributesResponse, AwaResourceOperations_ReadWrite };
+    return xmlif_HandleFanOutRequest(request, content, &requestType);
 }
 
 static bool xmlif_HandlerSendCoapWriteAttributesRequest(IpcCoapRequestContext * requestContext, Lwm2mClientType * client,
@@ -1946,7 +2213,9 @@ static void xmlif_HandlerSuccessfulWriteAttributesResponse(IpcCoapRequestContext
 
 static int xmlif_HandlerExecuteRequest(RequestInfoType * request, TreeNode content)
 {
-    return xmlif_HandleContentRequest(request, content, xmlif_HandlerSendCoapExecuteRequest, xmlif_HandlerExecuteResponse, AwaResourceOperations_Execute);
+    static const ClientRequestType requestType = { IPC_MESSAGE_SUB_TYPE_EXECUTE, xmlif_HandleClientContentRequest,
+                                                   xmlif_HandlerSendCoapExecuteRequest, xmlif_HandlerExecuteResponse, AwaResourceOperations_Execute };
+    return xmlif_HandleFanOutRequest(request, content, &requestType);
 }
 
 static bool xmlif_HandlerSendCoapExecuteRequest(IpcCoapRequestContext * requestContext, Lwm2mClientType * client,
@@ -0,0 +1,139 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE 
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+#include <gtest/gtest.h>
+#include <string.h>
+#include "coap_block_cache.h"
+#include "network_abstraction.h"
+
+class BlockCacheTestSuite : public testing::Test
+{
+protected:
+    void SetUp()
+    {
+        BlockCache_Init(&cache_, 2, 1024, 512, 1000);
+        const char * uri1 = "coap://127.0.0.1:5683";
+        const char * uri2 = "coap://127.0.0.1:5684";
+        peer1_ = NetworkAddress_New(uri1, strlen(uri1));
+        peer2_ = NetworkAddress_New(uri2, strlen(uri2));
+        ASSERT_TRUE(NULL != peer1_);
+        ASSERT_TRUE(NULL != peer2_);
+    }
+    void TearDown()
+    {
+        BlockCache_Destroy(&cache_);
+        NetworkAddress_Free(&peer1_);
+        NetworkAddress_Free(&peer2_);
+    }
+
+    BlockCache cache_;
+    NetworkAddress * peer1_;
+    NetworkAddress * peer2_;
+};
+
+TEST_F(BlockCacheTestSuite, Find_matches_peer_direction_uri_and_content_type)
+{
+    BlockTransfer * transfer = BlockCache_Add(&cache_, peer1_, BlockDirection_Download, "/3/0", 1542, 0);
+    ASSERT_TRUE(NULL != transfer);
+    ASSERT_EQ(0, BlockCache_Append(&cache_, transfer, "abc", 3));
+
+    EXPECT_EQ(transfer, BlockCache_Find(&cache_, peer1_, BlockDirection_Download, "/3/0", 1542, 10));
+    EXPECT_TRUE(NULL == BlockCache_Find(&cache_, peer2_, BlockDirection_Download, "/3/0", 1542, 10));
+    EXPECT_TRUE(NULL == BlockCache_Find(&cache_, peer1_, BlockDirection_Upload, "/3/0", 1542, 10));
+    EXPECT_TRUE(NULL == BlockCache_Find(&cache_, peer1_, BlockDirection_Download, "/3", 1542, 10));
+    EXPECT_TRUE(NULL == BlockCache_Find(&cache_, peer1_, BlockDirection_Download, "/3/0", 0, 10));
+    EXPECT_EQ(3u, transfer->Length);
+    EXPECT_EQ(0, memcmp("abc", transfer->Data, 3));
+}
+
+TEST_F(BlockCacheTestSuite, Add_replaces_transfer_with_new_etag)
+{
+    BlockTransfer * first = BlockCache_Add(&cache_, peer1_, BlockDirection_Download, "/3", 0, 0);
+    ASSERT_TRUE(NULL != first);
+    uint8_t etag[BLOCK_CACHE_ETAG_LEN];
+    memcpy(etag, first->ETag, sizeof(etag));
+
+    BlockTransfer * second = BlockCache_Add(&cache_, peer1_, BlockDirection_Download, "/3", 0, 0);
+    ASSERT_TRUE(NULL != second);
+    EXPECT_EQ(1u, cache_.Count);
+    EXPECT_NE(0, memcmp(etag, second->ETag, sizeof(etag)));
+}
+
+TEST_F(BlockCacheTestSuite, Transfers_expire_after_lifetime_without_use)
+{
+    ASSERT_TRUE(NULL != BlockCache_Add(&cache_, peer1_, BlockDirection_Upload, "/5/0/0", 42, 0));
+
+    // each use extends the lifetime
+    EXPECT_TRUE(NULL != BlockCache_Find(&cache_, peer1_, BlockDirection_Upload, "/5/0/0", 42, 900));
+    EXPECT_TRUE(NULL != BlockCache_Find(&cache_, peer1_, BlockDirection_Upload, "/5/0/0", 42, 1800));
+    EXPECT_TRUE(NULL == BlockCache_Find(&cache_, peer1_, BlockDirection_Upload, "/5/0/0", 42, 2800));
+    EXPECT_EQ(0u, cache_.Count);
+}
+
+TEST_F(BlockCacheTestSuite, Least_recently_used_transfer_is_evicted_at_count_limit)
+{
+    ASSERT_TRUE(NULL != BlockCache_Add(&cache_, peer1_, BlockDirection_Download, "/1", 0, 0));
+    ASSERT_TRUE(NULL != BlockCache_Add(&cache_, peer1_, BlockDirection_Download, "/2", 0, 1));
+    ASSERT_TRUE(NULL != BlockCache_Find(&cache_, peer1_, BlockDirection_Download, "/1", 0, 2));
+
+    ASSERT_TRUE(NULL != BlockCache_Add(&cache_, peer2_, BlockDirection_Download, "/3", 0, 3));
+    EXPECT_EQ(2u, cache_.Count);
+    EXPECT_TRUE(NULL != BlockCache_Find(&cache_, peer1_, BlockDirection_Download, "/1", 0, 4));
+    EXPECT_TRUE(NULL == BlockCache_Find(&cache_, peer1_, BlockDirection_Download, "/2", 0, 4));
+}
+
+TEST_F(BlockCacheTestSuite, Append_enforces_transfer_size_limit)
+{
+    char data[512] = { 0 };
+    BlockTransfer * transfer = BlockCache_Add(&cache_, peer1_, BlockDirection_Upload, "/1", 0, 0);
+    ASSERT_TRUE(NULL != transfer);
+    ASSERT_EQ(0, BlockCache_Append(&cache_, transfer, data, 256));
+    ASSERT_EQ(0, BlockCache_Append(&cache_, transfer, data, 256));
+    EXPECT_EQ(-1, BlockCache_Append(&cache_, transfer, data, 1));
+    EXPECT_EQ(512u, transfer->Length);
+}
+
+TEST_F(BlockCacheTestSuite, Least_recently_used_transfer_is_evicted_at_byte_limit)
+{
+    BlockCache cache;
+    BlockCache_Init(&cache, 4, 1024, 512, 1000);
+    char data[512] = { 0 };
+
+    BlockTransfer * first = BlockCache_Add(&cache, peer1_, BlockDirection_Upload, "/1", 0, 0);
+    ASSERT_TRUE(NULL != first);
+    ASSERT_EQ(0, BlockCache_Append(&cache, first, data, 512));
+    BlockTransfer * second = BlockCache_Add(&cache, peer1_, BlockDirection_Upload, "/2", 0, 1);
+    ASSERT_TRUE(NULL != second);
+    ASSERT_EQ(0, BlockCache_Append(&cache, second, data, 512));
+    EXPECT_EQ(1024u, cache.Bytes);
+
+    BlockTransfer * third = BlockCache_Add(&cache, peer2_, BlockDirection_Upload, "/3", 0, 2);
+    ASSERT_TRUE(NULL != third);
+    ASSERT_EQ(0, BlockCache_Append(&cache, third, data, 100));
+    EXPECT_EQ(2u, cache.Count);
+    EXPECT_TRUE(NULL == BlockCache_Find(&cache, peer1_, BlockDirection_Upload, "/1", 0, 3));
+    EXPECT_TRUE(NULL != BlockCache_Find(&cache, peer1_, BlockDirection_Upload, "/2", 0, 3));
+
+    BlockCache_Destroy(&cache);
+    EXPECT_EQ(0u, cache.Count);
+    EXPECT_EQ(0u, cache.Bytes);
+}
@@ -21,7 +21,11 @@
 ************************************************************************************************************************/
 
 #include <gtest/gtest.h>
+#include <chrono>
+#include <cmath>
+#include <random>
 #include <string>
+#include <vector>
 #include <stdio.h>
 #include <stdint.h>
 
@@ -37,6 +41,7 @@
 #include "common/lwm2m_tree_node.h"
 #include "common/lwm2m_tree_builder.h"
 #include "lwm2m_core.h"
+#include "lwm2m_device_object.h"
 
 class JsonTestSuite : public testing::Test
 {
@@ -235,4 +240,338 @@ TEST_F(JsonTestSuite, test_serialise_integer)
     EXPECT_EQ(0, memcmp(buffer, expected, strlen(expected)));
 }
 
+TEST_F(JsonTestSuite, test_serialise_escapes_strings)
+{
+    Definition_RegisterObjectType(Lwm2mCore_GetDefinitions(context), (char*)"Test", 0, MultipleInstancesEnum_Single, MandatoryEnum_Mandatory, &defaultObjectOperationHandlers);
+    Lwm2mCore_RegisterResourceType(context, (char*)"Res1", 0, 0, AwaResourceType_String, MultipleInstancesEnum_Single, MandatoryEnum_Mandatory, AwaResourceOperations_ReadWrite, &defaultResourceOperationHandlers);
+    Lwm2mCore_CreateObjectInstance(context, 0, 0);
+    const char * value = "say \"hi\"\\\n\x01";
+    Lwm2mCore_SetResourceInstanceValue(context, 0, 0, 0, 0, value, strlen(value));
 
+    uint8_t buffer[512];
+    const char * expected = "{\"e\":[\n"
+    "{\"n\":\"0\",\"sv\":\"say \\\"hi\\\"\\\\\\n\\u0001\"}]\n"
+    "}\n";
+
+    Lwm2mTreeNode * dest;
+    TreeBuilder_CreateTreeFromObjectInstance(&dest, context, Lwm2mRequestOrigin_Client, 0, 0);
+
+    SerdesContext serdesContext = NULL;
+    int len = JsonSerialiseObjectInstance(&serdesContext, dest, 0, 0, buffer, sizeof(buffer));
+    Lwm2mTreeNode_DeleteRecursive(dest);
+
+    ASSERT_EQ(static_cast<int>(strlen(expected)), len) << buffer;
+    EXPECT_EQ(0, memcmp(buffer, expected, len));
+}
+
+TEST_F(JsonTestSuite, test_serialise_fails_when_buffer_too_small)
+{
+    Definition_RegisterObjectType(Lwm2mCore_GetDefinitions(context), (char*)"Test", 0, MultipleInstancesEnum_Single, MandatoryEnum_Mandatory, &defaultObjectOperationHandlers);
+    Lwm2mCore_RegisterResourceType(context, (char*)"Res1", 0, 0, AwaResourceType_String, MultipleInstancesEnum_Single, MandatoryEnum_Mandatory, AwaResourceOperations_ReadWrite, &defaultResourceOperationHandlers);
+    Lwm2mCore_CreateObjectInstance(context, 0, 0);
+    Lwm2mCore_SetResourceInstanceValue(context, 0, 0, 0, 0, (char*)"Open Mobile Alliance", strlen("Open Mobile Alliance"));
+
+    uint8_t buffer[32];
+    Lwm2mTreeNode * dest;
+    TreeBuilder_CreateTreeFromObject(&dest, context, Lwm2mRequestOrigin_Client, 0);
+
+    SerdesContext serdesContext = NULL;
+    EXPECT_EQ(-1, JsonSerialiseObject(&serdesContext, dest, 0, buffer, sizeof(buffer)));
+    Lwm2mTreeNode_DeleteRecursive(dest);
+}
+
+TEST_F(JsonTestSuite, test_format_float_matches_printf)
+{
+    std::mt19937_64 random(42);
+    std::uniform_real_distribution<double> mantissa(-1.0, 1.0);
+    std::uniform_int_distribution<int> exponent(-12, 12);
+    const double special[] = { 0.0, -0.0, 5.23, 0.5e-6, -0.5e-6, 1.5e-6, 2.5e-6, 999999999.9999995, 1e9, -1e9, 1e300, 0.1 + 0.2 };
+
+    char expected[JSON_FLOAT_LENGTH];
+    char actual[JSON_FLOAT_LENGTH];
+    for (size_t i = 0; i < sizeof(special) / sizeof(special[0]) + 100000; i++)
+    {
+        double value = (i < sizeof(special) / sizeof(special[0])) ? special[i] : mantissa(random) * pow(10, exponent(random));
+        int length = JsonFormatFloat(actual, value);
+        actual[length] = '\0';
+        sprintf(expected, "%f", value);
+        ASSERT_STREQ(expected, actual) << "value " << value;
+    }
+}
+
+TEST_F(JsonTestSuite, test_deserialise_round_trip)
+{
+    Definition_RegisterObjectType(Lwm2mCore_GetDefinitions(context), (char*)"Test", 0, MultipleInstancesEnum_Single, MandatoryEnum_Mandatory, &defaultObjectOperationHandlers);
+    Lwm2mCore_RegisterResourceType(context, (char*)"String", 0, 0, AwaResourceType_String, MultipleInstancesEnum_Single, MandatoryEnum_Mandatory, AwaResourceOperations_ReadWrite, &defaultResourceOperationHandlers);
+    Lwm2mCore_RegisterResourceType(context, (char*)"Integer", 0, 1, AwaResourceType_Integer, MultipleInstancesEnum_Single, MandatoryEnum_Mandatory, AwaResourceOperations_ReadWrite, &defaultResourceOperationHandlers);
+    Lwm2mCore_RegisterResourceType(context, (char*)"Float", 0, 2, AwaResourceType_Float, MultipleInstancesEnum_Single, MandatoryEnum_Mandatory, AwaResourceOperations_ReadWrite, &defaultResourceOperationHandlers);
+    Lwm2mCore_RegisterResourceType(context, (char*)"Boolean", 0, 3, AwaResourceType_Boolean, MultipleInstancesEnum_Single, MandatoryEnum_Mandatory, AwaResourceOperations_ReadWrite, &defaultResourceOperationHandlers);
+    Lwm2mCore_RegisterResourceType(context, (char*)"Opaque", 0, 4, AwaResourceType_Opaque, MultipleInstancesEnum_Single, MandatoryEnum_Mandatory, AwaResourceOperations_ReadWrite, &defaultResourceOperationHandlers);
+    Lwm2mCore_RegisterResourceType(context, (char*)"ObjectLink", 0, 5, AwaResourceType_ObjectLink, MultipleInstancesEnum_Single, MandatoryEnum_Mandatory, AwaResourceOperations_ReadWrite, &defaultResourceOperationHandlers);
+    Lwm2mCore_RegisterResourceType(context, (char*)"Integers", 0, 6, AwaResourceType_Integer, MultipleInstancesEnum_Multiple, MandatoryEnum_Optional, AwaResourceOperations_ReadWrite, &defaultResourceOperationHandlers);
+    Lwm2mCore_CreateObjectInstance(context, 0, 0);
+
+    const char * string = "quote \" and caf\xc3\xa9";
+    int64_t integer = -9001;
+    double real = -2.5;
+    bool boolean = true;
+    uint8_t opaque[] = { 0x00, 0xff, 0x10, 0x80, 0x7f };
+    AwaObjectLink objectLink = { 3, 2 };
+    int64_t integers[] = { 1, -1, INT64_MAX };
+    Lwm2mCore_SetResourceInstanceValue(context, 0, 0, 0, 0, string, strlen(string));
+    Lwm2mCore_SetResourceInstanceValue(context, 0, 0, 1, 0, &integer, sizeof(integer));
+    Lwm2mCore_SetResourceInstanceValue(context, 0, 0, 2, 0, &real, sizeof(real));
+    Lwm2mCore_SetResourceInstanceValue(context, 0, 0, 3, 0, &boolean, sizeof(boolean));
+    Lwm2mCore_SetResourceInstanceValue(context, 0, 0, 4, 0, opaque, sizeof(opaque));
+    Lwm2mCore_SetResourceInstanceValue(context, 0, 0, 5, 0, &objectLink, sizeof(objectLink));
+    Lwm2mCore_CreateOptionalResource(context, 0, 0, 6);
+    for (int i = 0; i < 3; i++)
+    {
+        Lwm2mCore_SetResourceInstanceValue(context, 0, 0, 6, i + 4, &integers[i], sizeof(integers[i]));
+    }
+
+    Lwm2mTreeNode * instance;
+    ASSERT_EQ(AwaResult_Success, TreeBuilder_CreateTreeFromObjectInstance(&instance, context, Lwm2mRequestOrigin_Client, 0, 0));
+    uint8_t buffer[1024];
+    SerdesContext serdesContext = NULL;
+    int length = JsonSerialiseObjectInstance(&serdesContext, instance, 0, 0, buffer, sizeof(buffer));
+    ASSERT_LT(0, length);
+    Lwm2mTreeNode_DeleteRecursive(instance);
+
+    Lwm2mTreeArena * arena = Lwm2mTreeArena_New();
+    Lwm2mTreeNode * dest;
+    ASSERT_EQ(length, JsonDeserialiseObjectInstance(&serdesContext, &dest, arena, Lwm2mCore_GetDefinitions(context), 0, 0, buffer, length)) << buffer;
+    EXPECT_EQ(Lwm2mTreeNodeType_ObjectInstance, Lwm2mTreeNode_GetType(dest));
+    ASSERT_EQ(7, Lwm2mTreeNode_GetChildCount(dest));
+
+    uint16_t size;
+    const uint8_t * value = Lwm2mTreeNode_GetValue(Lwm2mTreeNode_GetFirstChild(Lwm2mTreeNode_FindNode(dest, 0)), &size);
+    EXPECT_EQ(std::string(string), std::string((const char *)value, size));
+    value = Lwm2mTreeNode_GetValue(Lwm2mTreeNode_GetFirstChild(Lwm2mTreeNode_FindNode(dest, 1)), &size);
+    EXPECT_EQ(integer, *(const int64_t *)value);
+    value = Lwm2mTreeNode_GetValue(Lwm2mTreeNode_GetFirstChild(Lwm2mTreeNode_FindNode(dest, 2)), &size);
+    EXPECT_EQ(real, *(const double *)value);
+    value = Lwm2mTreeNode_GetValue(Lwm2mTreeNode_GetFirstChild(Lwm2mTreeNode_FindNode(dest, 3)), &size);
+    ASSERT_EQ(sizeof(bool), size);
+    EXPECT_TRUE(*(const bool *)value);
+    value = Lwm2mTreeNode_GetValue(Lwm2mTreeNode_GetFirstChild(Lwm2mTreeNode_FindNode(dest, 4)), &size);
+    ASSERT_EQ(sizeof(opaque), size);
+    EXPECT_EQ(0, memcmp(opaque, value, size));
+    value = Lwm2mTreeNode_GetValue(Lwm2mTreeNode_GetFirstChild(Lwm2mTreeNode_FindNode(dest, 5)), &size);
+    EXPECT_EQ(3, ((const AwaObjectLink *)value)->ObjectID);
+    EXPECT_EQ(2, ((const AwaObjectLink *)value)->ObjectInstanceID);
+
+    Lwm2mTreeNode * resource = Lwm2mTreeNode_FindNode(dest, 6);
+    ASSERT_EQ(3, Lwm2mTreeNode_GetChildCount(resource));
+    for (int i = 0; i < 3; i++)
+    {
+        value = Lwm2mTreeNode_GetValue(Lwm2mTreeNode_FindNode(resource, i + 4), &size);
+        ASSERT_TRUE(value != NULL);
+        EXPECT_EQ(integers[i], *(const int64_t *)value);
+    }
+    Lwm2mTreeArena_Free(arena);
+}
+
+TEST_F(JsonTestSuite, test_deserialise_with_basename)
+{
+    Lwm2m_RegisterDeviceObject(context);
+
+    // members in any order, unknown members skipped, boolean literal and escaped strings
+    const char * input = " { \"bn\" : \"/3/0/\", \"x\":[{\"y\":[1,2]},null],\"e\" : [\n"
+                         "{\"sv\":\"Imagination\",\"n\":\"0\"},\n"
+                         "{\"n\":\"1\",\"t\":5,\"sv\":\"caf\\u00e9 \\ud83d\\ude00 \\/\"},\n"
+                         "{\"n\":\"6/0\",\"v\":1},\n"
+                         "{\"n\":\"6/1\",\"v\":5} ] } \r\n";
+
+    Lwm2mTreeArena * arena = Lwm2mTreeArena_New();
+    Lwm2mTreeNode * dest;
+    SerdesContext serdesContext = NULL;
+    ASSERT_EQ(static_cast<int>(strlen(input)), JsonDeserialiseObjectInstance(&serdesContext, &dest, arena, Lwm2mCore_GetDefinitions(context), 3, 0, (const uint8_t *)input, strlen(input)));
+    ASSERT_EQ(Lwm2mTreeNodeType_Root, Lwm2mTreeNode_GetType(dest));
+
+    Lwm2mTreeNode * instance = Lwm2mTreeNode_FindNode(Lwm2mTreeNode_FindNode(dest, 3), 0);
+    ASSERT_TRUE(instance != NULL);
+    ASSERT_EQ(3, Lwm2mTreeNode_GetChildCount(instance));
+
+    // strings without escapes refer to the input buffer
+    uint16_t size;
+    const uint8_t * value = Lwm2mTreeNode_GetValue(Lwm2mTreeNode_GetFirstChild(Lwm2mTreeNode_FindNode(instance, 0)), &size);
+    EXPECT_EQ((const uint8_t *)strstr(input, "Imagination"), value);
+    EXPECT_EQ(11, size);
+
+    value = Lwm2mTreeNode_GetValue(Lwm2mTreeNode_GetFirstChild(Lwm2mTreeNode_FindNode(instance, 1)), &size);
+    EXPECT_EQ(std::string("caf\xc3\xa9 \xf0\x9f\x98\x80 /"), std::string((const char *)value, size));
+
+    Lwm2mTreeNode * powerSources = Lwm2mTreeNode_FindNode(instance, 6);
+    ASSERT_EQ(2, Lwm2mTreeNode_GetChildCount(powerSources));
+    value = Lwm2mTreeNode_GetValue(Lwm2mTreeNode_FindNode(powerSources, 1), &size);
+    EXPECT_EQ(5, *(const int64_t *)value);
+    Lwm2mTreeArena_Free(arena);
+}
+
+TEST_F(JsonTestSuite, test_deserialise_rejects_malformed_input)
+{
+    Lwm2m_RegisterDeviceObject(context);
+    const char * inputs[] =
+    {
+        "",
+        "[]",
+        "{\"e\":[]}",
+        "{\"e\":[{\"n\":\"0\",\"sv\":\"x\"}]",
+        "{\"e\":[{\"n\":\"0\",\"sv\":\"x\"}]} trailing",
+        "{\"e\":[{\"n\":\"0\",\"sv\":\"x\"},]}",
+        "{\"e\":[{\"n\":\"0\"}]}",
+        "{\"e\":[{\"n\":\"0\",\"sv\":\"unterminated}]}",
+        "{\"e\":[{\"n\":\"0\",\"sv\":\"bad \\q escape\"}]}",
+        "{\"e\":[{\"n\":\"0\",\"sv\":\"lone \\ud83d surrogate\"}]}",
+        "{\"e\":[{\"n\":\"0\",\"v\":1}]}",
+        "{\"e\":[{\"n\":\"9\",\"v\":1.5}]}",
+        "{\"e\":[{\"n\":\"9\",\"v\":99999999999999999999}]}",
+        "{\"e\":[{\"n\":\"9\",\"v\":20000000000000000000}]}",
+        "{\"e\":[{\"n\":\"9\",\"v\":-9223372036854775809}]}",
+        "{\"e\":[{\"n\":\"9\",\"v\":\"1\"}]}",
+        "{\"e\":[{\"n\":\"x\",\"sv\":\"x\"}]}",
+        "{\"e\":[{\"n\":\"0/0/0\",\"sv\":\"x\"}]}",
+        "{\"e\":[{\"n\":\"70000\",\"sv\":\"x\"}]}",
+        "{\"e\":[{\"n\":\"0\",\"sv\":\"x\"}],\"bn\":\"/3/0/\"}",
+        "{\"x\":[[[[[[[[[[[[[[[[[[[[]]]]]]]]]]]]]]]]]]]],\"e\":[{\"n\":\"0\",\"sv\":\"x\"}]}",
+    };
+
+    for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++)
+    {
+        Lwm2mTreeArena * arena = Lwm2mTreeArena_New();
+        Lwm2mTreeNode * dest;
+        SerdesContext serdesContext = NULL;
+        EXPECT_EQ(-1, JsonDeserialiseObjectInstance(&serdesContext, &dest, arena, Lwm2mCore_GetDefinitions(context), 3, 0, (const uint8_t *)inputs[i], strlen(inputs[i]))) << inputs[i];
+        Lwm2mTreeArena_Free(arena);
+    }
+}
+
+// Deserialise randomly corrupted and truncated payloads; none may be read out of bounds or crash
+TEST_F(JsonTestSuite, Fuzz_deserialise_mutated_payloads)
+{
+    Lwm2m_RegisterDeviceObject(context);
+    Lwm2m_SetLogLevel(DebugLevel_Emerg);
+    const char * seed = "{\"bn\":\"/3/0/\",\"bt\":10,\"e\":[\n"
+                        "{\"n\":\"0\",\"sv\":\"Imagination \\\"\\u00e9\"},\n"
+                        "{\"n\":\"6/0\",\"v\":1},\n"
+                        "{\"n\":\"9\",\"v\":100},\n"
+                        "{\"n\":\"13\",\"v\":1400000000},\n"
+                        "{\"n\":\"x\",\"bv\":true,\"ov\":\"1:2\"}]\n"
+                        "}\n";
+    const char alphabet[] = "{}[]\":,\\/0123456789-+.eEnvbsotu ";
+    std::mt19937 random(1234);
+    int accepted = 0;
+
+    for (int n = 0; n < 20000; n++)
+    {
+        std::vector<char> input(seed, seed + strlen(seed));
+        int mutations = 1 + random() % 4;
+        for (int m = 0; m < mutations; m++)
+        {
+            size_t position = random() % input.size();
+            switch (random() % 4)
+            {
+                case 0:
+                    input[position] = alphabet[random() % (sizeof(alphabet) - 1)];
+                    break;
+                case 1:
+                    input[position] = (char)(random() & 0xff);
+                    break;
+                case 2:
+                    input.erase(input.begin() + position);
+                    break;
+                default:
+                    input.insert(input.begin() + position, alphabet[random() % (sizeof(alphabet) - 1)]);
+                    break;
+            }
+            if (input.empty())
+            {
+                input.push_back('{');
+            }
+        }
+        // truncating into a heap copy of exactly the payload's size lets tools catch reads past its end
+        size_t length = (random() % 8 == 0) ? random() % input.size() : input.size();
+        uint8_t * payload = (uint8_t *)malloc(length + 1);
+        memcpy(payload, input.data(), length);
+
+        Lwm2mTreeArena * arena = Lwm2mTreeArena_New();
+        Lwm2mTreeNode * dest = NULL;
+        SerdesContext serdesContext = NULL;
+        int result = JsonDeserialiseObjectInstance(&serdesContext, &dest, arena, Lwm2mCore_GetDefinitions(context), 3, 0, payload, length);
+        if (result >= 0)
+        {
+            EXPECT_EQ(static_cast<int>(length), result);
+            EXPECT_TRUE(dest != NULL);
+            accepted++;
+        }
+        Lwm2mTreeArena_Free(arena);
+        free(payload);
+    }
+    Lwm2m_SetLogLevel(DebugLevel_Debug);
+    EXPECT_LT(0, accepted);
+}
+
+// Microbenchmark: encode and decode an object instance with hundreds of resources.
+TEST_F(JsonTestSuite, Benchmark_encode_decode_megabytes_per_second)
+{
+    const int numResources = 300;
+    int64_t integer = 0x12345678;
+    double real = 3.14159;
+    const char * string = "urn:dev:ops:imagination-awa-lwm2m-client";
+    Lwm2m_SetLogLevel(DebugLevel_Emerg);
+    Definition_RegisterObjectType(Lwm2mCore_GetDefinitions(context), (char*)"Test", 18, 1, 0, &defaultObjectOperationHandlers);
+    for (int i = 0; i < numResources; i++)
+    {
+        AwaResourceType type = (i % 3 == 0) ? AwaResourceType_String : (i % 3 == 1) ? AwaResourceType_Integer : AwaResourceType_Float;
+        Lwm2mCore_RegisterResourceType(context, (char*)"Res", 18, i, type, 1, 1, AwaResourceOperations_ReadWrite, &defaultResourceOperationHandlers);
+    }
+    Lwm2mCore_CreateObjectInstance(context, 18, 0);
+    for (int i = 0; i < numResources; i++)
+    {
+        if (i % 3 == 0)
+            Lwm2mCore_SetResourceInstanceValue(context, 18, 0, i, 0, string, strlen(string));
+        else if (i % 3 == 1)
+            Lwm2mCore_SetResourceInstanceValue(context, 18, 0, i, 0, &integer, sizeof(integer));
+        else
+            Lwm2mCore_SetResourceInstanceValue(context, 18, 0, i, 0, &real, sizeof(real));
+    }
+
+    Lwm2mTreeNode * instance;
+    ASSERT_EQ(AwaResult_Success, TreeBuilder_CreateTreeFromObjectInstance(&instance, context, Lwm2mRequestOrigin_Client, 18, 0));
+
+    static uint8_t buffer[65536];
+    static uint8_t reencoded[65536];
+    SerdesContext serdesContext = NULL;
+    const int iterations = 500;
+    int length = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int n = 0; n < iterations; n++)
+    {
+        length = JsonSerialiseObjectInstance(&serdesContext, instance, 18, 0, buffer, sizeof(buffer));
+    }
+    double encodeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    ASSERT_LT(0, length);
+
+    start = std::chrono::steady_clock::now();
+    for (int n = 0; n < iterations; n++)
+    {
+        Lwm2mTreeArena * arena = Lwm2mTreeArena_New();
+        Lwm2mTreeNode * decoded;
+        EXPECT_EQ(length, JsonDeserialiseObjectInstance(&serdesContext, &decoded, arena, Lwm2mCore_GetDefinitions(context), 18, 0, buffer, length));
+        if (n == 0)
+        {
+            EXPECT_EQ(length, JsonSerialiseObjectInstance(&serdesContext, decoded, 18, 0, reencoded, sizeof(reencoded)));
+            EXPECT_EQ(0, memcmp(buffer, reencoded, length));
+        }
+        Lwm2mTreeArena_Free(arena);
+    }
+    double decodeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double megabytes = (double)length * iterations / (1024 * 1024);
+    printf("JSON object instance with %d resources (%d bytes): encode %.1f MB/s, decode %.1f MB/s\n",
+           numResources, length, megabytes / encodeSeconds, megabytes / decodeSeconds);
+    Lwm2mTreeNode_DeleteRecursive(instance);
+    Lwm2m_SetLogLevel(DebugLevel_Debug);
+}
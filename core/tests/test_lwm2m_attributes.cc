@@ -0,0 +1,124 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE 
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+#include <gtest/gtest.h>
+#include <string.h>
+#include "lwm2m_attributes.h"
+
+class AttributeStoreTestSuite : public testing::Test
+{
+protected:
+    void SetUp()
+    {
+        store_ = AttributeStore_Create();
+        ASSERT_TRUE(NULL != store_);
+        memset(&resolved_, 0, sizeof(resolved_));
+    }
+
+    void TearDown() { AttributeStore_Destroy(store_); }
+
+    void SetMinimumPeriod(ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID, int minimumPeriod)
+    {
+        NotificationAttributes attributes;
+        memset(&attributes, 0, sizeof(attributes));
+        attributes.MinimumPeriod = minimumPeriod;
+        attributes.Valid[AttributeTypeEnum_MinimumPeriod] = true;
+        ASSERT_EQ(0, AttributeStore_SetNotificationAttributes(store_, 1, objectID, objectInstanceID, resourceID, &attributes));
+    }
+
+    AttributeStore * store_;
+    ResolvedNotificationAttributes resolved_;
+};
+
+TEST_F(AttributeStoreTestSuite, test_lookup_missing_attributes_returns_null)
+{
+    EXPECT_EQ(NULL, AttributeStore_LookupNotificationAttributes(store_, 1, 3, 0, 1));
+    EXPECT_EQ(NULL, AttributeStore_LookupNotificationAttributes(store_, 1, 3, 0, 1));
+    EXPECT_EQ(NULL, AttributeStore_LookupNotificationAttributes(NULL, 1, 3, 0, 1));
+}
+
+TEST_F(AttributeStoreTestSuite, test_set_and_lookup_attributes)
+{
+    SetMinimumPeriod(3, 0, 1, 10);
+
+    const NotificationAttributes * attributes = AttributeStore_LookupNotificationAttributes(store_, 1, 3, 0, 1);
+    ASSERT_TRUE(NULL != attributes);
+    EXPECT_TRUE(attributes->Valid[AttributeTypeEnum_MinimumPeriod]);
+    EXPECT_FALSE(attributes->Valid[AttributeTypeEnum_MaximumPeriod]);
+    EXPECT_EQ(10, attributes->MinimumPeriod);
+
+    // Attributes are per server and per path
+    EXPECT_EQ(NULL, AttributeStore_LookupNotificationAttributes(store_, 2, 3, 0, 1));
+    EXPECT_EQ(NULL, AttributeStore_LookupNotificationAttributes(store_, 1, 3, 0, -1));
+}
+
+TEST_F(AttributeStoreTestSuite, test_set_no_valid_attributes_removes_entry)
+{
+    SetMinimumPeriod(3, 0, 1, 10);
+
+    NotificationAttributes attributes;
+    memset(&attributes, 0, sizeof(attributes));
+    EXPECT_EQ(0, AttributeStore_SetNotificationAttributes(store_, 1, 3, 0, 1, &attributes));
+    EXPECT_EQ(NULL, AttributeStore_LookupNotificationAttributes(store_, 1, 3, 0, 1));
+}
+
+TEST_F(AttributeStoreTestSuite, test_resolve_inherits_from_most_specific_path)
+{
+    SetMinimumPeriod(3, -1, -1, 30);
+
+    NotificationAttributes attributes;
+    memset(&attributes, 0, sizeof(attributes));
+    attributes.MinimumPeriod = 20;
+    attributes.MaximumPeriod = 60;
+    attributes.Valid[AttributeTypeEnum_MinimumPeriod] = true;
+    attributes.Valid[AttributeTypeEnum_MaximumPeriod] = true;
+    ASSERT_EQ(0, AttributeStore_SetNotificationAttributes(store_, 1, 3, 0, -1, &attributes));
+
+    SetMinimumPeriod(3, 0, 1, 10);
+
+    const NotificationAttributes * resolved = AttributeStore_ResolveNotificationAttributes(store_, &resolved_, 1, 3, 0, 1);
+    EXPECT_EQ(10, resolved->MinimumPeriod);
+    EXPECT_TRUE(resolved->Valid[AttributeTypeEnum_MaximumPeriod]);
+    EXPECT_EQ(60, resolved->MaximumPeriod);
+    EXPECT_FALSE(resolved->Valid[AttributeTypeEnum_GreaterThan]);
+
+    ResolvedNotificationAttributes other;
+    memset(&other, 0, sizeof(other));
+    resolved = AttributeStore_ResolveNotificationAttributes(store_, &other, 1, 3, 1, 1);
+    EXPECT_EQ(30, resolved->MinimumPeriod);
+    EXPECT_FALSE(resolved->Valid[AttributeTypeEnum_MaximumPeriod]);
+}
+
+TEST_F(AttributeStoreTestSuite, test_resolve_is_refreshed_when_store_changes)
+{
+    SetMinimumPeriod(3, -1, -1, 30);
+    EXPECT_EQ(30, AttributeStore_ResolveNotificationAttributes(store_, &resolved_, 1, 3, 0, 1)->MinimumPeriod);
+
+    // Unchanged store: the resolved attributes are reused
+    uint32_t generation = resolved_.Generation;
+    EXPECT_EQ(30, AttributeStore_ResolveNotificationAttributes(store_, &resolved_, 1, 3, 0, 1)->MinimumPeriod);
+    EXPECT_EQ(generation, resolved_.Generation);
+
+    SetMinimumPeriod(3, 0, -1, 15);
+    EXPECT_EQ(15, AttributeStore_ResolveNotificationAttributes(store_, &resolved_, 1, 3, 0, 1)->MinimumPeriod);
+    EXPECT_NE(generation, resolved_.Generation);
+}
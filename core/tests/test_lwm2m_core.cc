@@ -36,6 +36,8 @@
 
 #include "common/lwm2m_object_store.h"
 #include "common/lwm2m_object_defs.h"
+#include "common/lwm2m_observers.h"
+#include "lwm2m_security_object.h"
 
 class Lwm2mCoreTestSuite : public testing::Test
 {
@@ -75,3 +77,159 @@ TEST_F(Lwm2mCoreTestSuite, test_handle_valid_get_request)
     EXPECT_STREQ(expected, responseBuffer);
 }
 #endif
+
+static int notificationCount = 0;
+
+static int DummyNotificationCallback(void * context, AddressType * addr, int sequence, const char * token, int tokenLength, ObjectIDType objectID,
+                                     ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID, ContentType contentType, void * contextData)
+{
+    notificationCount++;
+    return 0;
+}
+
+class Lwm2mObserversTestSuite : public testing::Test
+{
+protected:
+    void SetUp()
+    {
+        context = Lwm2mCore_Init(NULL, (char *)"123456");
+        memset(&address, 0, sizeof(address));
+        notificationCount = 0;
+        Lwm2mCore_RegisterObjectType(context, "Test", 1000, 100, 0, &defaultObjectOperationHandlers);
+        Lwm2mCore_RegisterResourceType(context, "Res0", 1000, 0, AwaResourceType_Integer, 1, 0, AwaResourceOperations_ReadWrite, &defaultResourceOperationHandlers);
+        Lwm2mCore_RegisterResourceType(context, "Res1", 1000, 1, AwaResourceType_Integer, 1, 0, AwaResourceOperations_ReadWrite, &defaultResourceOperationHandlers);
+    }
+
+    void Observe(ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID)
+    {
+        ASSERT_EQ(0, Lwm2m_Observe(context, &address, "token", 5, objectID, objectInstanceID, resourceID, ContentType_ApplicationOmaLwm2mTLV, DummyNotificationCallback, NULL));
+    }
+
+    // Returns -1 if there is no observer of the path
+    int IsChanged(ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID)
+    {
+        struct ListHead * i;
+        ListForEach(i, Lwm2mCore_GetObserverList(context))
+        {
+            Lwm2mObserverType * observer = ListEntry(i, Lwm2mObserverType, list);
+            if ((observer->ObjectID == objectID) && (observer->ObjectInstanceID == objectInstanceID) && (observer->ResourceID == resourceID))
+            {
+                return observer->Changed;
+            }
+        }
+        return -1;
+    }
+
+    void TearDown() { Lwm2mCore_Destroy(context); }
+
+    Lwm2mContextType * context;
+    AddressType address;
+};
+
+TEST_F(Lwm2mObserversTestSuite, test_change_marks_observers_of_path_and_parents)
+{
+    AwaInteger value = 42;
+    for (ObjectInstanceIDType objectInstanceID = 0; objectInstanceID < 2; objectInstanceID++)
+    {
+        Lwm2mCore_CreateObjectInstance(context, 1000, objectInstanceID);
+        Lwm2mCore_SetResourceInstanceValue(context, 1000, objectInstanceID, 0, 0, &value, sizeof(value));
+        Lwm2mCore_SetResourceInstanceValue(context, 1000, objectInstanceID, 1, 0, &value, sizeof(value));
+        Observe(1000, objectInstanceID, 0);
+        Observe(1000, objectInstanceID, 1);
+        Observe(1000, objectInstanceID, -1);
+    }
+    Observe(1000, -1, -1);
+
+    value = 43;
+    Lwm2m_MarkObserversChanged(context, 1000, 0, 0, &value, sizeof(value));
+
+    EXPECT_EQ(1, IsChanged(1000, 0, 0));
+    EXPECT_EQ(1, IsChanged(1000, 0, -1));
+    EXPECT_EQ(1, IsChanged(1000, -1, -1));
+    EXPECT_EQ(0, IsChanged(1000, 0, 1));
+    EXPECT_EQ(0, IsChanged(1000, 1, 0));
+    EXPECT_EQ(0, IsChanged(1000, 1, 1));
+    EXPECT_EQ(0, IsChanged(1000, 1, -1));
+}
+
+TEST_F(Lwm2mObserversTestSuite, test_cancelled_observer_is_not_marked)
+{
+    AwaInteger value = 42;
+    Lwm2mCore_CreateObjectInstance(context, 1000, 0);
+    Lwm2mCore_SetResourceInstanceValue(context, 1000, 0, 0, 0, &value, sizeof(value));
+    Observe(1000, 0, 0);
+    Observe(1000, 0, 0);
+
+    EXPECT_EQ(0, Lwm2m_CancelObserve(context, &address, 1000, 0, 0));
+    EXPECT_EQ(-1, Lwm2m_CancelObserve(context, &address, 1000, 0, 0));
+
+    value = 43;
+    Lwm2m_MarkObserversChanged(context, 1000, 0, 0, &value, sizeof(value));
+    EXPECT_EQ(-1, IsChanged(1000, 0, 0));
+}
+
+TEST_F(Lwm2mObserversTestSuite, test_change_with_many_observers)
+{
+    AwaInteger value = 42;
+    const int numInstances = 100;
+    for (ObjectInstanceIDType objectInstanceID = 0; objectInstanceID < numInstances; objectInstanceID++)
+    {
+        Lwm2mCore_CreateObjectInstance(context, 1000, objectInstanceID);
+        Lwm2mCore_SetResourceInstanceValue(context, 1000, objectInstanceID, 0, 0, &value, sizeof(value));
+        Observe(1000, objectInstanceID, 0);
+    }
+
+    value = 43;
+    Lwm2m_MarkObserversChanged(context, 1000, numInstances - 1, 0, &value, sizeof(value));
+
+    for (ObjectInstanceIDType objectInstanceID = 0; objectInstanceID < numInstances; objectInstanceID++)
+    {
+        EXPECT_EQ(objectInstanceID == numInstances - 1 ? 1 : 0, IsChanged(1000, objectInstanceID, 0));
+    }
+}
+
+TEST_F(Lwm2mObserversTestSuite, test_unchanged_observer_without_maximum_period_is_not_due)
+{
+    Lwm2mCore_CreateObjectInstance(context, 1000, 0);
+    Observe(1000, 0, 0);
+
+    EXPECT_EQ(1000, Lwm2m_UpdateObservers(context, 1000));
+    EXPECT_EQ(0, notificationCount);
+}
+
+TEST_F(Lwm2mObserversTestSuite, test_changed_observer_is_notified_once)
+{
+    AwaInteger value = 42;
+    Lwm2mCore_CreateObjectInstance(context, 1000, 0);
+    Lwm2mCore_SetResourceInstanceValue(context, 1000, 0, 0, 0, &value, sizeof(value));
+    Observe(1000, 0, 0);
+
+    value = 43;
+    Lwm2m_MarkObserversChanged(context, 1000, 0, 0, &value, sizeof(value));
+
+    EXPECT_EQ(1000, Lwm2m_UpdateObservers(context, 1000));
+    EXPECT_EQ(1, notificationCount);
+    EXPECT_EQ(0, IsChanged(1000, 0, 0));
+
+    EXPECT_EQ(1000, Lwm2m_UpdateObservers(context, 1000));
+    EXPECT_EQ(1, notificationCount);
+}
+
+TEST_F(Lwm2mObserversTestSuite, test_maximum_period_sets_timeout)
+{
+    Lwm2mCore_CreateObjectInstance(context, 1000, 0);
+    Observe(1000, 0, 0);
+
+    NotificationAttributes attributes;
+    memset(&attributes, 0, sizeof(attributes));
+    attributes.MaximumPeriod = 5;
+    attributes.Valid[AttributeTypeEnum_MaximumPeriod] = true;
+    ASSERT_EQ(0, AttributeStore_SetNotificationAttributes(Lwm2mCore_GetAttributes(context), Lwm2mSecurity_GetShortServerID(context, &address), 1000, 0, 0, &attributes));
+    Lwm2m_RescheduleObservers(context);
+
+    // The first notification is due immediately, the next one after pmax
+    int timeout = Lwm2m_UpdateObservers(context, 60000);
+    EXPECT_EQ(1, notificationCount);
+    EXPECT_LT(4000, timeout);
+    EXPECT_GE(5001, timeout);
+}
@@ -0,0 +1,104 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE 
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+#include <gtest/gtest.h>
+#include <vector>
+#include <limits.h>
+#include "lwm2m_deadline_queue.h"
+#include "lwm2m_list.h"
+
+struct TestTimer
+{
+    DeadlineEntry Entry;
+    int ID;
+};
+
+class DeadlineQueueTestSuite : public testing::Test
+{
+protected:
+    void SetUp() { ASSERT_EQ(0, DeadlineQueue_Init(&queue_)); }
+    void TearDown() { DeadlineQueue_Destroy(&queue_); }
+
+    DeadlineQueue queue_;
+};
+
+TEST_F(DeadlineQueueTestSuite, Empty_queue_has_no_timeout)
+{
+    EXPECT_TRUE(NULL == DeadlineQueue_Peek(&queue_));
+    EXPECT_TRUE(NULL == DeadlineQueue_PopExpired(&queue_, 1000));
+    EXPECT_EQ(5000, DeadlineQueue_GetTimeout(&queue_, 0, 5000));
+}
+
+TEST_F(DeadlineQueueTestSuite, Pops_only_expired_entries_in_order)
+{
+    std::vector<TestTimer> timers(100);
+    for (size_t i = 0; i < timers.size(); i++)
+    {
+        DeadlineQueue_InitEntry(&timers[i].Entry);
+        timers[i].ID = i;
+        // scatter the deadlines so that insertion order differs from expiry order
+        ASSERT_EQ(0, DeadlineQueue_Schedule(&queue_, &timers[i].Entry, ((i * 37) % 100) * 10));
+    }
+    EXPECT_EQ(static_cast<size_t>(100), DeadlineQueue_Count(&queue_));
+
+    uint64_t previous = 0;
+    int popped = 0;
+    DeadlineEntry * entry;
+    while ((entry = DeadlineQueue_PopExpired(&queue_, 495)) != NULL)
+    {
+        EXPECT_LE(previous, entry->Deadline);
+        EXPECT_FALSE(DeadlineQueue_IsScheduled(entry));
+        previous = entry->Deadline;
+        popped++;
+    }
+    EXPECT_EQ(50, popped);
+    EXPECT_EQ(5, DeadlineQueue_GetTimeout(&queue_, 495, INT_MAX));
+}
+
+TEST_F(DeadlineQueueTestSuite, Reschedule_and_cancel)
+{
+    TestTimer a, b, c;
+    DeadlineQueue_InitEntry(&a.Entry);
+    DeadlineQueue_InitEntry(&b.Entry);
+    DeadlineQueue_InitEntry(&c.Entry);
+
+    DeadlineQueue_Schedule(&queue_, &a.Entry, 100);
+    DeadlineQueue_Schedule(&queue_, &b.Entry, 200);
+    DeadlineQueue_Schedule(&queue_, &c.Entry, 300);
+    EXPECT_EQ(&a.Entry, DeadlineQueue_Peek(&queue_));
+
+    // push a back past c
+    DeadlineQueue_Schedule(&queue_, &a.Entry, 400);
+    EXPECT_EQ(&b.Entry, DeadlineQueue_Peek(&queue_));
+    EXPECT_EQ(static_cast<size_t>(3), DeadlineQueue_Count(&queue_));
+
+    DeadlineQueue_Cancel(&queue_, &b.Entry);
+    DeadlineQueue_Cancel(&queue_, &b.Entry);
+    EXPECT_FALSE(DeadlineQueue_IsScheduled(&b.Entry));
+    EXPECT_EQ(&c.Entry, DeadlineQueue_Peek(&queue_));
+
+    TestTimer * expired = ListEntry(DeadlineQueue_PopExpired(&queue_, 300), TestTimer, Entry);
+    EXPECT_EQ(&c, expired);
+    EXPECT_TRUE(NULL == DeadlineQueue_PopExpired(&queue_, 300));
+    EXPECT_EQ(100, DeadlineQueue_GetTimeout(&queue_, 300, INT_MAX));
+    EXPECT_EQ(0, DeadlineQueue_GetTimeout(&queue_, 500, INT_MAX));
+}
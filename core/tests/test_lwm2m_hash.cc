@@ -0,0 +1,185 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE 
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <stdio.h>
+#include "lwm2m_hash.h"
+
+struct TestEntry
+{
+    HashEntry NameIndex;
+    HashEntry IDIndex;
+    std::string Name;
+    int ID;
+};
+
+class HashTableTestSuite : public testing::Test
+{
+protected:
+    void SetUp() { ASSERT_EQ(0, HashTable_Init(&table_, 4)); }
+    void TearDown() { HashTable_Destroy(&table_); }
+
+    TestEntry * LookupByName(const char * name)
+    {
+        uint32_t hash = Hash_String(name);
+        struct ListHead * i;
+        ListForEach(i, HashTable_GetBucket(&table_, hash))
+        {
+            HashEntry * entry = ListEntry(i, HashEntry, list);
+            TestEntry * testEntry = ListEntry(entry, TestEntry, NameIndex);
+            if ((entry->Hash == hash) && (testEntry->Name == name))
+            {
+                return testEntry;
+            }
+        }
+        return NULL;
+    }
+
+    HashTable table_;
+};
+
+TEST_F(HashTableTestSuite, Init_rounds_buckets_to_power_of_two)
+{
+    HashTable table;
+    ASSERT_EQ(0, HashTable_Init(&table, 100));
+    EXPECT_EQ(static_cast<size_t>(128), table.NumBuckets);
+    EXPECT_EQ(static_cast<size_t>(0), HashTable_Count(&table));
+    HashTable_Destroy(&table);
+}
+
+TEST_F(HashTableTestSuite, Add_lookup_and_remove)
+{
+    TestEntry a, b;
+    a.Name = "imagination1";
+    b.Name = "imagination2";
+
+    HashTable_Add(&table_, &a.NameIndex, Hash_String(a.Name.c_str()));
+    HashTable_Add(&table_, &b.NameIndex, Hash_String(b.Name.c_str()));
+    EXPECT_EQ(static_cast<size_t>(2), HashTable_Count(&table_));
+
+    EXPECT_EQ(&a, LookupByName("imagination1"));
+    EXPECT_EQ(&b, LookupByName("imagination2"));
+    EXPECT_TRUE(NULL == LookupByName("imagination3"));
+
+    HashTable_Remove(&table_, &a.NameIndex);
+    EXPECT_TRUE(NULL == LookupByName("imagination1"));
+    EXPECT_EQ(&b, LookupByName("imagination2"));
+    EXPECT_EQ(static_cast<size_t>(1), HashTable_Count(&table_));
+
+    // removing twice must not corrupt the count
+    HashTable_Remove(&table_, &a.NameIndex);
+    EXPECT_EQ(static_cast<size_t>(1), HashTable_Count(&table_));
+}
+
+TEST_F(HashTableTestSuite, Entries_survive_growth)
+{
+    const int count = 1000;
+    std::vector<TestEntry> entries(count);
+    for (int i = 0; i < count; i++)
+    {
+        entries[i].Name = "client" + std::to_string(i);
+        HashTable_Add(&table_, &entries[i].NameIndex, Hash_String(entries[i].Name.c_str()));
+    }
+    EXPECT_EQ(static_cast<size_t>(count), HashTable_Count(&table_));
+    EXPECT_GE(table_.NumBuckets, static_cast<size_t>(count));
+
+    for (int i = 0; i < count; i++)
+    {
+        EXPECT_EQ(&entries[i], LookupByName(entries[i].Name.c_str()));
+    }
+}
+
+TEST_F(HashTableTestSuite, Entry_can_be_in_several_tables)
+{
+    HashTable idTable;
+    ASSERT_EQ(0, HashTable_Init(&idTable, HASH_TABLE_DEFAULT_BUCKETS));
+
+    TestEntry a;
+    a.Name = "imagination1";
+    a.ID = 42;
+    HashTable_Add(&table_, &a.NameIndex, Hash_String(a.Name.c_str()));
+    HashTable_Add(&idTable, &a.IDIndex, Hash_Integer(a.ID));
+
+    EXPECT_EQ(&a, LookupByName("imagination1"));
+
+    struct ListHead * i;
+    TestEntry * found = NULL;
+    ListForEach(i, HashTable_GetBucket(&idTable, Hash_Integer(42)))
+    {
+        TestEntry * testEntry = ListEntry(ListEntry(i, HashEntry, list), TestEntry, IDIndex);
+        if (testEntry->ID == 42)
+        {
+            found = testEntry;
+        }
+    }
+    EXPECT_EQ(&a, found);
+
+    HashTable_Destroy(&idTable);
+}
+
+// Microbenchmark: the cost of a lookup by endpoint name should not depend on the number of indexed clients.
+static double MeasureLookupNs(size_t numEntries)
+{
+    HashTable table;
+    HashTable_Init(&table, HASH_TABLE_DEFAULT_BUCKETS);
+    std::vector<TestEntry> entries(numEntries);
+    for (size_t i = 0; i < numEntries; i++)
+    {
+        entries[i].Name = "urn:imei:" + std::to_string(100000000 + i);
+        HashTable_Add(&table, &entries[i].NameIndex, Hash_String(entries[i].Name.c_str()));
+    }
+
+    const size_t lookups = 200000;
+    size_t found = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t n = 0; n < lookups; n++)
+    {
+        const TestEntry & wanted = entries[(n * 7919) % numEntries];
+        uint32_t hash = Hash_String(wanted.Name.c_str());
+        struct ListHead * i;
+        ListForEach(i, HashTable_GetBucket(&table, hash))
+        {
+            HashEntry * entry = ListEntry(i, HashEntry, list);
+            if ((entry->Hash == hash) && (ListEntry(entry, TestEntry, NameIndex)->Name == wanted.Name))
+            {
+                found++;
+                break;
+            }
+        }
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_EQ(lookups, found);
+
+    HashTable_Destroy(&table);
+    return std::chrono::duration<double, std::nano>(elapsed).count() / lookups;
+}
+
+TEST_F(HashTableTestSuite, Benchmark_lookup_cost_is_flat)
+{
+    double small = MeasureLookupNs(100);
+    double medium = MeasureLookupNs(10000);
+    double large = MeasureLookupNs(100000);
+    printf("Lookup by name: 100 clients %.1f ns, 10k clients %.1f ns, 100k clients %.1f ns\n", small, medium, large);
+}
@@ -192,3 +192,57 @@ TEST_F(Lwm2mTreeNodeTestSuite, test_get_child_count)
 
 
 
+
+TEST_F(Lwm2mTreeNodeTestSuite, test_arena_create_set_value)
+{
+    const char * value = "hello world";
+    const char * larger_value = "this is a larger value";
+    uint16_t length;
+
+    Lwm2mTreeArena * arena = Lwm2mTreeArena_New();
+    ASSERT_TRUE(NULL != arena);
+
+    Lwm2mTreeNode * node = Lwm2mTreeNode_CreateInArena(arena);
+    ASSERT_TRUE(NULL != node);
+    ASSERT_EQ(arena, Lwm2mTreeNode_GetArena(node));
+
+    ASSERT_EQ(0, Lwm2mTreeNode_SetValue(node, (const uint8_t*)value, strlen(value)));
+    ASSERT_EQ(0, memcmp(value, Lwm2mTreeNode_GetValue(node, &length), strlen(value)));
+    ASSERT_EQ(strlen(value), length);
+
+    ASSERT_EQ(0, Lwm2mTreeNode_SetValue(node, (const uint8_t*)larger_value, strlen(larger_value)));
+    ASSERT_EQ(0, memcmp(larger_value, Lwm2mTreeNode_GetValue(node, &length), strlen(larger_value)));
+    ASSERT_EQ(strlen(larger_value), length);
+
+    ASSERT_EQ(0, Lwm2mTreeNode_DeleteRecursive(node));
+    Lwm2mTreeArena_Free(arena);
+}
+
+TEST_F(Lwm2mTreeNodeTestSuite, test_arena_children_and_copy)
+{
+    Lwm2mTreeArena * arena = Lwm2mTreeArena_New();
+    Lwm2mTreeNode * node = Lwm2mTreeNode_CreateInArena(arena);
+    Lwm2mTreeNode_SetType(node, Lwm2mTreeNodeType_Object);
+
+    // enough children to span several arena blocks
+    for (int i = 0; i < 1000; i++)
+    {
+        Lwm2mTreeNode * child = Lwm2mTreeNode_FindOrCreateChildNode(node, i, Lwm2mTreeNodeType_ObjectInstance, NULL, false);
+        ASSERT_TRUE(NULL != child);
+        ASSERT_EQ(arena, Lwm2mTreeNode_GetArena(child));
+    }
+    ASSERT_EQ(1000, Lwm2mTreeNode_GetChildCount(node));
+
+    // deleting a child only unlinks it
+    Lwm2mTreeNode_DeleteRecursive(Lwm2mTreeNode_FindNode(node, 0));
+    ASSERT_EQ(999, Lwm2mTreeNode_GetChildCount(node));
+
+    // a copy of an arena tree is independent of the arena
+    Lwm2mTreeNode * copy = Lwm2mTreeNode_CopyRecursive(node);
+    Lwm2mTreeNode_DeleteRecursive(node);
+    Lwm2mTreeArena_Free(arena);
+
+    ASSERT_TRUE(NULL == Lwm2mTreeNode_GetArena(copy));
+    ASSERT_EQ(999, Lwm2mTreeNode_GetChildCount(copy));
+    Lwm2mTreeNode_DeleteRecursive(copy);
+}
@@ -0,0 +1,106 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE 
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "network_abstraction.h"
+
+class NetworkAddressCacheTestSuite : public testing::Test
+{
+  void SetUp() { }
+  void TearDown() { }
+};
+
+TEST_F(NetworkAddressCacheTestSuite, New_returns_cached_address_for_same_uri)
+{
+    NetworkAddressCacheStatistics before, after;
+    NetworkAddress_GetCacheStatistics(&before);
+
+    const char * uri = "coap://127.0.0.1:15683/rd";
+    NetworkAddress * address1 = NetworkAddress_New(uri, strlen(uri));
+    ASSERT_TRUE(NULL != address1);
+    NetworkAddress * address2 = NetworkAddress_New(uri, strlen(uri));
+    EXPECT_EQ(address1, address2);
+
+    NetworkAddress_GetCacheStatistics(&after);
+    EXPECT_EQ(before.Misses + 1, after.Misses);
+    EXPECT_EQ(before.Hits + 1, after.Hits);
+
+    NetworkAddress_Free(&address1);
+    NetworkAddress_Free(&address2);
+    EXPECT_TRUE(NULL == address2);
+
+    // the unreferenced address stays cached, so resolving again is a hit
+    NetworkAddress_GetCacheStatistics(&before);
+    EXPECT_EQ(after.IdleEntries + 1, before.IdleEntries);
+    NetworkAddress * address3 = NetworkAddress_New(uri, strlen(uri));
+    ASSERT_TRUE(NULL != address3);
+    NetworkAddress_GetCacheStatistics(&after);
+    EXPECT_EQ(before.Hits + 1, after.Hits);
+    EXPECT_EQ(before.Misses, after.Misses);
+    NetworkAddress_Free(&address3);
+}
+
+TEST_F(NetworkAddressCacheTestSuite, Uri_match_is_exact)
+{
+    const char * uri1 = "coap://127.0.0.1:1568";
+    const char * uri2 = "coap://127.0.0.1:15680";
+    NetworkAddress * address1 = NetworkAddress_New(uri1, strlen(uri1));
+    NetworkAddress * address2 = NetworkAddress_New(uri2, strlen(uri2));
+    ASSERT_TRUE(NULL != address1);
+    ASSERT_TRUE(NULL != address2);
+    EXPECT_NE(address1, address2);
+    EXPECT_NE(0, NetworkAddress_Compare(address1, address2));
+    NetworkAddress_Free(&address1);
+    NetworkAddress_Free(&address2);
+}
+
+TEST_F(NetworkAddressCacheTestSuite, Caches_more_than_five_peers)
+{
+    std::vector<NetworkAddress *> addresses;
+    for (int port = 20000; port < 21000; port++)
+    {
+        std::string uri = "coap://127.0.0.1:" + std::to_string(port);
+        NetworkAddress * address = NetworkAddress_New(uri.c_str(), uri.length());
+        ASSERT_TRUE(NULL != address);
+        addresses.push_back(address);
+    }
+
+    NetworkAddressCacheStatistics before, after;
+    NetworkAddress_GetCacheStatistics(&before);
+    for (int port = 20000; port < 21000; port++)
+    {
+        std::string uri = "coap://127.0.0.1:" + std::to_string(port);
+        NetworkAddress * address = NetworkAddress_New(uri.c_str(), uri.length());
+        EXPECT_EQ(addresses[port - 20000], address);
+        NetworkAddress_Free(&address);
+    }
+    NetworkAddress_GetCacheStatistics(&after);
+    EXPECT_EQ(before.Hits + 1000, after.Hits);
+    EXPECT_EQ(before.Misses, after.Misses);
+
+    for (size_t i = 0; i < addresses.size(); i++)
+    {
+        NetworkAddress_Free(&addresses[i]);
+    }
+}
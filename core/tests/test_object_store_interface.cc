@@ -23,6 +23,9 @@
 
 #include <gtest/gtest.h>
 #include <string>
+#include <vector>
+#include <chrono>
+#include <climits>
 #include <stdio.h>
 
 // https://meekrosoft.wordpress.com/2009/11/09/unit-testing-c-code-with-the-googletest-framework/
@@ -33,6 +36,7 @@
 // 5. Define your tests
 
 #include "lwm2m_core.h"
+#include "common/lwm2m_object_store.h"
 
 class ObjectStoreInterfaceTestSuite : public testing::Test
 {
@@ -179,3 +183,145 @@ TEST_F(ObjectStoreInterfaceTestSuite, test_WriteAndReadMultipleResourcesWithSpar
         EXPECT_TRUE(memcmp(expected, buffer, len) == 0);
     }
 }
+
+class ObjectStoreTestSuite : public testing::Test
+{
+protected:
+    void SetUp() { store_ = ObjectStore_Create(); ASSERT_TRUE(NULL != store_); }
+    void TearDown() { ObjectStore_Destroy(store_); }
+
+    void Populate(int numInstances, int numResources)
+    {
+        for (int instance = 0; instance < numInstances; instance++)
+        {
+            ASSERT_EQ(instance, ObjectStore_CreateObjectInstance(store_, 1000, instance, INT_MAX));
+            for (int resource = 0; resource < numResources; resource++)
+            {
+                bool changed = false;
+                int value = instance * numResources + resource;
+                ASSERT_EQ(resource, ObjectStore_CreateResource(store_, 1000, instance, resource));
+                ASSERT_EQ(static_cast<int>(sizeof(value)), ObjectStore_SetResourceInstanceValue(store_, 1000, instance, resource, 0, sizeof(value), &value, 0, sizeof(value), &changed));
+            }
+        }
+    }
+
+    ObjectStore * store_;
+};
+
+TEST_F(ObjectStoreTestSuite, test_get_next_preserves_creation_order)
+{
+    const int ids[] = { 7, 3, 42, 0 };
+    for (int id : ids)
+    {
+        ASSERT_EQ(id, ObjectStore_CreateObjectInstance(store_, 1000, id, INT_MAX));
+        ASSERT_EQ(id, ObjectStore_CreateResource(store_, 1000, ids[0], id));
+    }
+
+    ObjectInstanceIDType objectInstanceID = -1;
+    ResourceIDType resourceID = -1;
+    for (int id : ids)
+    {
+        objectInstanceID = ObjectStore_GetNextObjectInstanceID(store_, 1000, objectInstanceID);
+        EXPECT_EQ(id, objectInstanceID);
+        resourceID = ObjectStore_GetNextResourceID(store_, 1000, ids[0], resourceID);
+        EXPECT_EQ(id, resourceID);
+    }
+    EXPECT_EQ(-1, ObjectStore_GetNextObjectInstanceID(store_, 1000, objectInstanceID));
+    EXPECT_EQ(-1, ObjectStore_GetNextResourceID(store_, 1000, ids[0], resourceID));
+
+    // Unknown IDs have no successor
+    EXPECT_EQ(-1, ObjectStore_GetNextObjectInstanceID(store_, 1000, 5));
+    EXPECT_EQ(-1, ObjectStore_GetNextObjectInstanceID(store_, 1001, -1));
+}
+
+TEST_F(ObjectStoreTestSuite, test_delete_updates_counts_and_lookups)
+{
+    Populate(3, 4);
+    EXPECT_EQ(3, ObjectStore_GetObjectNumInstances(store_, 1000));
+    EXPECT_EQ(4, ObjectStore_GetInstanceNumResources(store_, 1000, 1));
+    EXPECT_EQ(1, ObjectStore_GetResourceNumInstances(store_, 1000, 1, 2));
+
+    EXPECT_EQ(0, ObjectStore_Delete(store_, 1000, 1, 2));
+    EXPECT_EQ(3, ObjectStore_GetInstanceNumResources(store_, 1000, 1));
+    EXPECT_FALSE(ObjectStore_Exists(store_, 1000, 1, 2));
+    EXPECT_EQ(3, ObjectStore_GetNextResourceID(store_, 1000, 1, 1));
+
+    EXPECT_EQ(0, ObjectStore_Delete(store_, 1000, 1, -1));
+    EXPECT_EQ(2, ObjectStore_GetObjectNumInstances(store_, 1000));
+    EXPECT_FALSE(ObjectStore_Exists(store_, 1000, 1, -1));
+    EXPECT_FALSE(ObjectStore_Exists(store_, 1000, 1, 0));
+    EXPECT_EQ(2, ObjectStore_GetNextObjectInstanceID(store_, 1000, 0));
+
+    // Recreating a deleted instance starts with no resources
+    EXPECT_EQ(1, ObjectStore_CreateObjectInstance(store_, 1000, 1, INT_MAX));
+    EXPECT_EQ(0, ObjectStore_GetInstanceNumResources(store_, 1000, 1));
+
+    EXPECT_EQ(0, ObjectStore_Delete(store_, 1000, -1, -1));
+    EXPECT_EQ(0, ObjectStore_GetObjectNumInstances(store_, 1000));
+    EXPECT_TRUE(ObjectStore_Exists(store_, 1000, -1, -1));
+}
+
+// Microbenchmark: the cost of reading a resource and of visiting each resource should not depend on the size of the store.
+struct ObjectStoreTimings
+{
+    double LookupNs;
+    double IterateNs;
+};
+
+static ObjectStoreTimings MeasureObjectStore(ObjectStore * store, int numInstances, int numResources)
+{
+    const int lookups = 200000;
+    int found = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int n = 0; n < lookups; n++)
+    {
+        int instance = (n * 7919) % numInstances;
+        int resource = n % numResources;
+        const void * value = NULL;
+        size_t valueSize = 0;
+        if (ObjectStore_GetResourceInstanceValue(store, 1000, instance, resource, 0, &value, &valueSize) == sizeof(int))
+        {
+            found += (*static_cast<const int *>(value) == instance * numResources + resource);
+        }
+    }
+    auto lookupElapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_EQ(lookups, found);
+
+    int visited = 0;
+    start = std::chrono::steady_clock::now();
+    ObjectInstanceIDType instance = -1;
+    while ((instance = ObjectStore_GetNextObjectInstanceID(store, 1000, instance)) != -1)
+    {
+        ResourceIDType resource = -1;
+        while ((resource = ObjectStore_GetNextResourceID(store, 1000, instance, resource)) != -1)
+        {
+            visited++;
+        }
+    }
+    auto iterateElapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_EQ(numInstances * numResources, visited);
+
+    ObjectStoreTimings timings;
+    timings.LookupNs = std::chrono::duration<double, std::nano>(lookupElapsed).count() / lookups;
+    timings.IterateNs = std::chrono::duration<double, std::nano>(iterateElapsed).count() / visited;
+    return timings;
+}
+
+TEST_F(ObjectStoreTestSuite, Benchmark_lookup_and_iteration_cost_is_flat)
+{
+    const int numResources = 50;
+
+    ObjectStore * small = ObjectStore_Create();
+    ObjectStore * large = store_;
+    store_ = small;
+    Populate(100, numResources);
+    store_ = large;
+    Populate(10000, numResources);
+
+    ObjectStoreTimings smallTimings = MeasureObjectStore(small, 100, numResources);
+    ObjectStoreTimings largeTimings = MeasureObjectStore(large, 10000, numResources);
+    ObjectStore_Destroy(small);
+
+    printf("Read resource: 100 instances %.1f ns, 10k instances %.1f ns\n", smallTimings.LookupNs, largeTimings.LookupNs);
+    printf("Visit resource: 100 instances %.1f ns, 10k instances %.1f ns\n", smallTimings.IterateNs, largeTimings.IterateNs);
+}
@@ -88,7 +88,7 @@ TEST_F(PlainTextTestSuite, test_deserialise_string)
 
     Lwm2mTreeNode * dest;
     SerdesContext serdesContext;
-    int result = PTDeserialiseResource(&serdesContext, &dest, Lwm2mCore_GetDefinitions(context), 0, 0, 0, (const uint8_t * )expected, strlen(expected));
+    int result = PTDeserialiseResource(&serdesContext, &dest, NULL, Lwm2mCore_GetDefinitions(context), 0, 0, 0, (const uint8_t * )expected, strlen(expected));
 
     Lwm2mTreeNode * resourceInstanceNode = Lwm2mTreeNode_GetFirstChild(dest);
 
@@ -143,7 +143,7 @@ TEST_F(PlainTextTestSuite, test_deserialise_float)
 
     Lwm2mTreeNode * dest;
     SerdesContext serdesContext;
-    int result = PTDeserialiseResource(&serdesContext, &dest, Lwm2mCore_GetDefinitions(context), 0, 0, 0, (const uint8_t * )buffer, strlen(buffer));
+    int result = PTDeserialiseResource(&serdesContext, &dest, NULL, Lwm2mCore_GetDefinitions(context), 0, 0, 0, (const uint8_t * )buffer, strlen(buffer));
 
     Lwm2mTreeNode * resourceInstanceNode = Lwm2mTreeNode_GetFirstChild(dest);
 
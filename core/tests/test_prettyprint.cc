@@ -142,4 +142,34 @@ TEST_F(PrettyPrintTestSuite, test_multiple_object_instance)
     ASSERT_EQ(0, memcmp(buffer, expected, len));
 }
 
+TEST_F(PrettyPrintTestSuite, test_stream_object_in_blocks)
+{
+    Definition_RegisterObjectType(Lwm2mCore_GetDefinitions(context), (char*)"Test", 0, 1, 0, &defaultObjectOperationHandlers);
+    Lwm2mCore_RegisterResourceType(context, (char*)"Res1", 0, 0, AwaResourceType_String, 1, 1, AwaResourceOperations_ReadWrite, &defaultResourceOperationHandlers);
+    Lwm2mCore_RegisterResourceType(context, (char*)"Res2", 0, 1, AwaResourceType_String, 1, 1, AwaResourceOperations_ReadWrite, &defaultResourceOperationHandlers);
+    Lwm2mCore_CreateObjectInstance(context, 0, 0);
+    Lwm2mCore_SetResourceInstanceValue(context, 0, 0, 0, 0, (char*)"Open Mobile Alliance", strlen("Open Mobile Alliance"));
+    Lwm2mCore_SetResourceInstanceValue(context, 0, 0, 1, 0, (char*)"Lightweight M2M Client", strlen("Lightweight M2M Client"));
+
+    const char * expected = "Test[0/0]:\n"
+    "\tRes1[0/0/0/0]: Open Mobile Alliance\n"
+    "\tRes2[0/0/1/0]: Lightweight M2M Client\n";
+
+    // Pretty print has no stream variant, so each block is cut from the whole encoding, which is larger than any window
+    char blocks[512];
+    int offset = 0;
+    SerdesStream stream;
+    do
+    {
+        SerdesStream_Init(&stream, (uint8_t *)blocks + offset, 7, offset);
+        ASSERT_LE(0, StreamObject(ContentType_CustomPrettyPrint, &stream, context, 0));
+        int len = SerdesStream_GetLength(&stream);
+        ASSERT_GE(7, len);
+        offset += len;
+    } while (stream.More);
+
+    ASSERT_EQ(static_cast<int>(strlen(expected)), offset);
+    ASSERT_EQ(0, memcmp(blocks, expected, offset));
+}
+
 //TODO: Test other resource types (int, boolean, float etc)
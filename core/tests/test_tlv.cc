@@ -22,6 +22,7 @@
 
 
 #include <gtest/gtest.h>
+#include <chrono>
 #include <string>
 #include <stdio.h>
 #include <stdint.h>
@@ -60,7 +61,7 @@ void TlvTestSuite::test_with_without_object_instance_header_common(const uint8_t
 
     Lwm2mTreeNode * dest;
     SerdesContext serdesContext;
-    int len = TlvDeserialiseObjectInstance(&serdesContext, &dest, Lwm2mCore_GetDefinitions(context), objectID, objectInstanceID, input, inputSize);
+    int len = TlvDeserialiseObjectInstance(&serdesContext, &dest, NULL, Lwm2mCore_GetDefinitions(context), objectID, objectInstanceID, input, inputSize);
     EXPECT_EQ(static_cast<int>(inputSize), len);
     EXPECT_EQ(19, Lwm2mTreeNode_GetChildCount(dest));
     Lwm2mTreeNode * child = Lwm2mTreeNode_GetFirstChild(dest);
@@ -137,7 +138,7 @@ TEST_F(TlvTestSuite, test_deserialise_single_object_instance_with_unnecessary_ob
 
     Lwm2mTreeNode * dest; 
     SerdesContext serdesContext;
-    int len = TlvDeserialiseObjectInstance(&serdesContext, &dest, Lwm2mCore_GetDefinitions(context), objectID, objectInstanceID, input, sizeof(input));
+    int len = TlvDeserialiseObjectInstance(&serdesContext, &dest, NULL, Lwm2mCore_GetDefinitions(context), objectID, objectInstanceID, input, sizeof(input));
     EXPECT_EQ(-1, len);
     Lwm2mTreeNode_DeleteRecursive(dest);
 }
@@ -861,6 +862,150 @@ TEST_F(TlvTestSuite, test_serialise_object_with_two_resources)
     ASSERT_EQ(0, memcmp(buffer, expected, sizeof(expected)));
 }
 
+TEST_F(TlvTestSuite, test_stream_object_matches_tree)
+{
+    int64_t temp = 77;
+    int64_t temp2 = 0x1234;
+    Definition_RegisterObjectType(Lwm2mCore_GetDefinitions(context), (char*)"Test", 17, 2, 0, &defaultObjectOperationHandlers);
+    Lwm2mCore_RegisterResourceType(context, (char*)"Res1", 17, 0, AwaResourceType_String, 1, 1, AwaResourceOperations_ReadWrite, &defaultResourceOperationHandlers);
+    Lwm2mCore_RegisterResourceType(context, (char*)"Res2", 17, 1, AwaResourceType_Integer, 4, 0, AwaResourceOperations_ReadWrite, &defaultResourceOperationHandlers);
+    Lwm2mCore_RegisterResourceType(context, (char*)"Res3", 17, 2, AwaResourceType_None, 1, 0, AwaResourceOperations_Execute, &defaultResourceOperationHandlers);
+    for (int instanceID = 0; instanceID < 2; instanceID++)
+    {
+        Lwm2mCore_CreateObjectInstance(context, 17, instanceID);
+        Lwm2mCore_SetResourceInstanceValue(context, 17, instanceID, 0, 0, (char*)"coap://bootstrap.example.com:5684/", strlen("coap://bootstrap.example.com:5684/"));
+        Lwm2mCore_CreateOptionalResource(context, 17, instanceID, 1);
+        Lwm2mCore_SetResourceInstanceValue(context, 17, instanceID, 1, 0, &temp, sizeof(temp));
+        Lwm2mCore_SetResourceInstanceValue(context, 17, instanceID, 1, 3, &temp2, sizeof(temp2));
+        Lwm2mCore_CreateOptionalResource(context, 17, instanceID, 2);
+    }
+
+    Lwm2mTreeNode * dest;
+    int OIR[] = {17};
+    ASSERT_EQ(AwaResult_Success, TreeBuilder_CreateTreeFromOIR(&dest, context, Lwm2mRequestOrigin_Client, OIR, 1));
+
+    uint8_t expected[512];
+    SerdesContext serdesContext;
+    int expectedLen = TlvSerialiseObject(&serdesContext, dest, 17, expected, sizeof(expected));
+    Lwm2mTreeNode_DeleteRecursive(dest);
+    ASSERT_LT(0, expectedLen);
+
+    uint8_t buffer[512];
+    SerdesStream stream;
+    SerdesStream_Init(&stream, buffer, sizeof(buffer), 0);
+    ASSERT_EQ(expectedLen, TlvStreamObject(&serdesContext, &stream, context, 17));
+    ASSERT_FALSE(stream.More);
+    ASSERT_EQ(0, memcmp(buffer, expected, expectedLen));
+
+    // Reading the encoding in small blocks at increasing offsets reproduces it exactly
+    uint8_t blocks[512];
+    int offset = 0;
+    do
+    {
+        SerdesStream_Init(&stream, blocks + offset, 7, offset);
+        ASSERT_LE(0, TlvStreamObject(&serdesContext, &stream, context, 17));
+        int len = SerdesStream_GetLength(&stream);
+        ASSERT_GE(7, len);
+        offset += len;
+    } while (stream.More);
+
+    ASSERT_EQ(expectedLen, offset);
+    ASSERT_EQ(0, memcmp(blocks, expected, expectedLen));
+}
+
+TEST_F(TlvTestSuite, test_deserialise_in_arena_refers_to_input_buffer)
+{
+    Lwm2m_RegisterDeviceObject(context);
+    // /3/0/0 "Imagination" and /3/0/9 battery level 100
+    const uint8_t input[] = { 0xC8, 0x00, 0x0B, 'I', 'm', 'a', 'g', 'i', 'n', 'a', 't', 'i', 'o', 'n', 0xC1, 0x09, 0x64 };
+
+    Lwm2mTreeArena * arena = Lwm2mTreeArena_New();
+    Lwm2mTreeNode * dest;
+    SerdesContext serdesContext;
+    ASSERT_EQ(static_cast<int>(sizeof(input)), TlvDeserialiseObjectInstance(&serdesContext, &dest, arena, Lwm2mCore_GetDefinitions(context), 3, 0, input, sizeof(input)));
+
+    uint16_t length;
+    Lwm2mTreeNode * manufacturer = Lwm2mTreeNode_GetFirstChild(Lwm2mTreeNode_GetFirstChild(dest));
+    EXPECT_EQ(&input[3], Lwm2mTreeNode_GetValue(manufacturer, &length));
+    EXPECT_EQ(11, length);
+
+    // integers are decoded into the arena
+    Lwm2mTreeNode * battery = Lwm2mTreeNode_GetFirstChild(Lwm2mTreeNode_GetNextChild(dest, Lwm2mTreeNode_GetFirstChild(dest)));
+    const uint8_t * value = Lwm2mTreeNode_GetValue(battery, &length);
+    EXPECT_EQ(static_cast<uint16_t>(sizeof(int64_t)), length);
+    EXPECT_EQ(100, *reinterpret_cast<const int64_t *>(value));
+
+    // setting a value later must not write into the input buffer
+    Lwm2mTreeNode_SetValue(manufacturer, (const uint8_t *)"Imagine", 7);
+    EXPECT_EQ(0, memcmp(&input[3], "Imagination", 11));
+    EXPECT_NE(&input[3], Lwm2mTreeNode_GetValue(manufacturer, &length));
+    Lwm2mTreeArena_Free(arena);
+}
+
+// Microbenchmark: encode and decode an object instance with hundreds of resources.
+TEST_F(TlvTestSuite, Benchmark_encode_decode_megabytes_per_second)
+{
+    const int numResources = 300;
+    int64_t integer = 0x12345678;
+    double real = 3.14159;
+    const char * string = "urn:dev:ops:imagination-awa-lwm2m-client";
+    Definition_RegisterObjectType(Lwm2mCore_GetDefinitions(context), (char*)"Test", 18, 1, 0, &defaultObjectOperationHandlers);
+    for (int i = 0; i < numResources; i++)
+    {
+        AwaResourceType type = (i % 3 == 0) ? AwaResourceType_String : (i % 3 == 1) ? AwaResourceType_Integer : AwaResourceType_Float;
+        Lwm2mCore_RegisterResourceType(context, (char*)"Res", 18, i, type, 1, 1, AwaResourceOperations_ReadWrite, &defaultResourceOperationHandlers);
+    }
+    Lwm2mCore_CreateObjectInstance(context, 18, 0);
+    for (int i = 0; i < numResources; i++)
+    {
+        if (i % 3 == 0)
+            Lwm2mCore_SetResourceInstanceValue(context, 18, 0, i, 0, string, strlen(string));
+        else if (i % 3 == 1)
+            Lwm2mCore_SetResourceInstanceValue(context, 18, 0, i, 0, &integer, sizeof(integer));
+        else
+            Lwm2mCore_SetResourceInstanceValue(context, 18, 0, i, 0, &real, sizeof(real));
+    }
+
+    Lwm2mTreeNode * instance;
+    int OIR[] = { 18, 0 };
+    ASSERT_EQ(AwaResult_Success, TreeBuilder_CreateTreeFromOIR(&instance, context, Lwm2mRequestOrigin_Client, OIR, 2));
+
+    static uint8_t buffer[65536];
+    static uint8_t reencoded[65536];
+    SerdesContext serdesContext;
+    const int iterations = 2000;
+    int length = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int n = 0; n < iterations; n++)
+    {
+        length = TlvSerialiseObjectInstance(&serdesContext, instance, 18, 0, buffer, sizeof(buffer));
+    }
+    double encodeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    ASSERT_LT(0, length);
+
+    start = std::chrono::steady_clock::now();
+    for (int n = 0; n < iterations; n++)
+    {
+        Lwm2mTreeArena * arena = Lwm2mTreeArena_New();
+        Lwm2mTreeNode * decoded;
+        EXPECT_EQ(length, TlvDeserialiseObjectInstance(&serdesContext, &decoded, arena, Lwm2mCore_GetDefinitions(context), 18, 0, buffer, length));
+        if (n == 0)
+        {
+            // integers are decoded as 64 bit, which encode to the same bytes
+            EXPECT_EQ(length, TlvSerialiseObjectInstance(&serdesContext, decoded, 18, 0, reencoded, sizeof(reencoded)));
+            EXPECT_EQ(0, memcmp(buffer, reencoded, length));
+        }
+        Lwm2mTreeArena_Free(arena);
+    }
+    double decodeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double megabytes = (double)length * iterations / (1024 * 1024);
+    printf("TLV object instance with %d resources (%d bytes): encode %.1f MB/s, decode %.1f MB/s\n",
+           numResources, length, megabytes / encodeSeconds, megabytes / decodeSeconds);
+    Lwm2mTreeNode_DeleteRecursive(instance);
+}
+
 namespace detail {
 
 struct FloatItem
@@ -24,6 +24,8 @@
 #include <string>
 #include <stdio.h>
 #include <stdint.h>
+#include <limits.h>
+#include <chrono>
 
 // https://meekrosoft.wordpress.com/2009/11/09/unit-testing-c-code-with-the-googletest-framework/
 // 1. Define fake functions for the dependencies you want to stub out
@@ -33,6 +35,7 @@
 // 5. Define your tests
 
 #include "common/xml.h"
+#include "xmlparser.h"
 #include "common/lwm2m_tree_node.h"
 #include "common/lwm2m_tree_builder.h"
 #include "lwm2m_core.h"
@@ -123,3 +126,383 @@ TEST_F(XmlTestSuite, test_Xml_FindChildWithGrandchildValue)
     // TODO: check value
     Tree_Delete(rootNode);
 }
+
+TEST_F(XmlTestSuite, test_TreeNode_FindChildByID)
+{
+    // enough children that the parent is indexed, with IDs in reverse order
+    const int numChildren = 100;
+    TreeNode rootNode = Xml_CreateNode("Object");
+    TreeNode_AddChild(rootNode, Xml_CreateNodeWithValue("ID", "%d", 3));
+    for (int i = numChildren - 1; i >= 0; --i)
+    {
+        TreeNode child = Xml_CreateNode("ObjectInstance");
+        TreeNode_AddChild(child, Xml_CreateNodeWithValue("ID", "%d", i));
+        TreeNode_AddChild(rootNode, child);
+    }
+
+    for (int i = 0; i < numChildren; ++i)
+    {
+        TreeNode child = TreeNode_FindChildByID(rootNode, "ObjectInstance", "ID", i);
+        ASSERT_TRUE(NULL != child);
+        EXPECT_EQ(i, atoi((const char *)TreeNode_GetValue(Xml_Find(child, "ID"))));
+    }
+    EXPECT_TRUE(NULL == TreeNode_FindChildByID(rootNode, "ObjectInstance", "ID", numChildren));
+    EXPECT_TRUE(NULL == TreeNode_FindChildByID(rootNode, "Resource", "ID", 0));
+    EXPECT_TRUE(NULL == TreeNode_FindChildByID(NULL, "ObjectInstance", "ID", 0));
+
+    // a child is found once its ID is set, even if it was added before the index was built
+    TreeNode late = Xml_CreateNode("ObjectInstance");
+    TreeNode_AddChild(rootNode, late);
+    EXPECT_TRUE(NULL == TreeNode_FindChildByID(rootNode, "ObjectInstance", "ID", 1000));
+    TreeNode_AddChild(late, Xml_CreateNodeWithValue("ID", "%d", 1000));
+    EXPECT_EQ(late, TreeNode_FindChildByID(rootNode, "ObjectInstance", "ID", 1000));
+
+    // the first of two children with the same ID is found, as by a linear search
+    TreeNode duplicate = Xml_CreateNode("ObjectInstance");
+    TreeNode_AddChild(duplicate, Xml_CreateNodeWithValue("ID", "%d", 5));
+    TreeNode_AddChild(rootNode, duplicate);
+    EXPECT_NE(duplicate, TreeNode_FindChildByID(rootNode, "ObjectInstance", "ID", 5));
+
+    // removing a child drops it from the index
+    TreeNode removed = TreeNode_FindChildByID(rootNode, "ObjectInstance", "ID", 7);
+    ASSERT_TRUE(Tree_Delete(removed));
+    EXPECT_TRUE(NULL == TreeNode_FindChildByID(rootNode, "ObjectInstance", "ID", 7));
+    EXPECT_TRUE(NULL != TreeNode_FindChildByID(rootNode, "ObjectInstance", "ID", 8));
+
+    // changing a child's ID moves it in the index
+    TreeNode renumbered = TreeNode_FindChildByID(rootNode, "ObjectInstance", "ID", 9);
+    ASSERT_TRUE(NULL != renumbered);
+    ASSERT_TRUE(TreeNode_SetValue(Xml_Find(renumbered, "ID"), (const uint8_t *)"2000", 4));
+    EXPECT_TRUE(NULL == TreeNode_FindChildByID(rootNode, "ObjectInstance", "ID", 9));
+    EXPECT_EQ(renumbered, TreeNode_FindChildByID(rootNode, "ObjectInstance", "ID", 2000));
+
+    // as does removing or renaming its ID node
+    ASSERT_TRUE(Tree_Delete(Xml_Find(renumbered, "ID")));
+    EXPECT_TRUE(NULL == TreeNode_FindChildByID(rootNode, "ObjectInstance", "ID", 2000));
+    TreeNode renamed = TreeNode_FindChildByID(rootNode, "ObjectInstance", "ID", 10);
+    ASSERT_TRUE(NULL != renamed);
+    ASSERT_TRUE(TreeNode_SetName(Xml_Find(renamed, "ID"), "Name", 4));
+    EXPECT_TRUE(NULL == TreeNode_FindChildByID(rootNode, "ObjectInstance", "ID", 10));
+    ASSERT_TRUE(TreeNode_SetName(Xml_Find(renamed, "Name"), "ID", 2));
+    EXPECT_EQ(renamed, TreeNode_FindChildByID(rootNode, "ObjectInstance", "ID", 10));
+
+    Tree_Delete(rootNode);
+}
+
+TEST_F(XmlTestSuite, test_binary_round_trip)
+{
+    TreeNode rootNode = Xml_CreateNode("Response");
+    TreeNode_AddChild(rootNode, Xml_CreateNodeWithValue("Type", "%s", "Get"));
+    TreeNode_AddChild(rootNode, Xml_CreateNodeWithValue("Empty", "%s", ""));
+    TreeNode_AddChild(rootNode, Xml_CreateNode("Create"));
+    TreeNode content = Xml_CreateNode("Content");
+    TreeNode_AddChild(content, Xml_CreateNodeWithValue("Value", "%s", "a somewhat longer value containing <, > and & characters"));
+    TreeNode_AddChild(rootNode, content);
+
+    uint8_t buffer[1024];
+    int length = Xml_TreeToBinary(rootNode, buffer, sizeof(buffer));
+    ASSERT_GT(length, 0);
+    ASSERT_TRUE(Xml_IsBinary(buffer, length));
+
+    TreeNode decoded = Xml_BinaryToTree(buffer, length);
+    ASSERT_TRUE(decoded != NULL);
+    EXPECT_STREQ("Response", TreeNode_GetName(decoded));
+    EXPECT_EQ(4, TreeNode_GetChildCount(decoded));
+    EXPECT_STREQ("Get", (const char *)TreeNode_GetValue(Xml_Find(decoded, "Type")));
+    EXPECT_STREQ("", (const char *)TreeNode_GetValue(Xml_Find(decoded, "Empty")));
+    ASSERT_TRUE(Xml_Find(decoded, "Create") != NULL);
+    EXPECT_TRUE(TreeNode_GetValue(Xml_Find(decoded, "Create")) == NULL);
+    EXPECT_STREQ("a somewhat longer value containing <, > and & characters", (const char *)TreeNode_GetValue(TreeNode_Navigate(decoded, "Response/Content/Value")));
+
+    // the encoding is deterministic
+    uint8_t buffer2[1024];
+    ASSERT_EQ(length, Xml_TreeToBinary(decoded, buffer2, sizeof(buffer2)));
+    EXPECT_EQ(0, memcmp(buffer, buffer2, length));
+
+    Tree_Delete(decoded);
+    Tree_Delete(rootNode);
+}
+
+TEST_F(XmlTestSuite, test_binary_handles_invalid_input)
+{
+    TreeNode rootNode = Xml_CreateNode("Request");
+    TreeNode_AddChild(rootNode, Xml_CreateNodeWithValue("Type", "%s", "Set"));
+
+    uint8_t buffer[64];
+    int length = Xml_TreeToBinary(rootNode, buffer, sizeof(buffer));
+    ASSERT_GT(length, 0);
+
+    // too small an output buffer
+    EXPECT_EQ(-1, Xml_TreeToBinary(rootNode, buffer, length - 1));
+    length = Xml_TreeToBinary(rootNode, buffer, sizeof(buffer));
+
+    // every truncation is rejected, as is trailing data
+    for (int i = 0; i < length; i++)
+    {
+        EXPECT_TRUE(Xml_BinaryToTree(buffer, i) == NULL) << "truncated to " << i;
+    }
+    EXPECT_TRUE(Xml_BinaryToTree(buffer, length + 1) == NULL);
+
+    // XML is not mistaken for the binary encoding
+    const char * xml = "<Request><Type>Set</Type></Request>";
+    EXPECT_FALSE(Xml_IsBinary((const uint8_t *)xml, strlen(xml)));
+    EXPECT_TRUE(Xml_BinaryToTree((const uint8_t *)xml, strlen(xml)) == NULL);
+
+    // a child count larger than the remaining input
+    buffer[length - 1] = 0x7f;
+    EXPECT_TRUE(Xml_BinaryToTree(buffer, length) == NULL);
+
+    Tree_Delete(rootNode);
+}
+
+TEST_F(XmlTestSuite, test_compact_string_escapes_and_round_trips)
+{
+    TreeNode rootNode = Xml_CreateNode("Request");
+    TreeNode_AddChild(rootNode, Xml_CreateNodeWithValue("Type", "%s", "Set"));
+    TreeNode_AddChild(rootNode, Xml_CreateNodeWithValue("Value", "%s", "a<b && c>d"));
+    TreeNode_AddChild(rootNode, Xml_CreateNode("Create"));
+
+    const char * expected = "<Request><Type>Set</Type><Value>a&lt;b &amp;&amp; c&gt;d</Value><Create></Create></Request>";
+    char buffer[256];
+    EXPECT_EQ((int)strlen(expected), Xml_TreeToCompactString(rootNode, buffer, sizeof(buffer)));
+    EXPECT_STREQ(expected, buffer);
+
+    size_t length = 0;
+    char * allocated = Xml_TreeToAllocatedString(rootNode, &length);
+    ASSERT_TRUE(allocated != NULL);
+    EXPECT_EQ(strlen(expected), length);
+    EXPECT_STREQ(expected, allocated);
+    free(allocated);
+
+    TreeNode parsed = TreeNode_ParseXML((uint8_t *)buffer, strlen(buffer), true);
+    ASSERT_TRUE(parsed != NULL);
+    EXPECT_STREQ("a<b && c>d", (const char *)TreeNode_GetValue(Xml_Find(parsed, "Value")));
+
+    Tree_Delete(parsed);
+    Tree_Delete(rootNode);
+}
+
+TEST_F(XmlTestSuite, test_compact_string_reports_size_needed)
+{
+    TreeNode rootNode = Xml_CreateNode("Response");
+    TreeNode_AddChild(rootNode, Xml_CreateNodeWithValue("Code", "%d", 200));
+    const char * expected = "<Response><Code>200</Code></Response>";
+    int expectedLength = strlen(expected);
+
+    EXPECT_EQ(expectedLength, Xml_TreeToCompactString(rootNode, NULL, 0));
+
+    // truncated output is still terminated
+    char buffer[16];
+    EXPECT_EQ(expectedLength, Xml_TreeToCompactString(rootNode, buffer, sizeof(buffer)));
+    EXPECT_EQ(0, strncmp(expected, buffer, sizeof(buffer) - 1));
+    EXPECT_EQ('\0', buffer[sizeof(buffer) - 1]);
+
+    // the indented form still fails on overrun, and fits exactly with room for the terminator
+    char indented[256];
+    int indentedLength = Xml_TreeToString(rootNode, indented, sizeof(indented));
+    ASSERT_GT(indentedLength, expectedLength);
+    EXPECT_EQ(-1, Xml_TreeToString(rootNode, indented, indentedLength));
+    EXPECT_EQ(indentedLength, Xml_TreeToString(rootNode, indented, indentedLength + 1));
+    EXPECT_STREQ("<Response>\n <Code>200</Code>\n</Response>\n", indented);
+
+    Tree_Delete(rootNode);
+}
+
+TEST_F(XmlTestSuite, test_Xml_CreateNodeWithValue_formats_integers)
+{
+    const int values[] = { 0, 7, -1, 200, 12345678, INT_MAX, INT_MIN };
+    for (int value : values)
+    {
+        char expected[16];
+        sprintf(expected, "%d", value);
+        TreeNode node = Xml_CreateNodeWithValue("Value", "%d", value);
+        ASSERT_TRUE(node != NULL);
+        EXPECT_STREQ(expected, (const char *)TreeNode_GetValue(node));
+        Tree_Delete(node);
+    }
+
+    TreeNode node = Xml_CreateNodeWithValue("Value", "%d:%s", 3, "abc");
+    EXPECT_STREQ("3:abc", (const char *)TreeNode_GetValue(node));
+    Tree_Delete(node);
+}
+
+// Microbenchmark: encode and decode a typical Read response with each IPC encoding.
+static TreeNode CreateReadResponse(int numResources)
+{
+    TreeNode response = Xml_CreateNode("Response");
+    TreeNode_AddChild(response, Xml_CreateNodeWithValue("Type", "%s", "Read"));
+    TreeNode_AddChild(response, Xml_CreateNodeWithValue("SessionID", "%d", 12345678));
+    TreeNode_AddChild(response, Xml_CreateNodeWithValue("Code", "%d", 200));
+    TreeNode content = Xml_CreateNode("Content");
+    TreeNode clients = Xml_CreateNode("Clients");
+    TreeNode client = Xml_CreateNode("Client");
+    TreeNode_AddChild(client, Xml_CreateNodeWithValue("ID", "%s", "imagination1"));
+    TreeNode objects = Xml_CreateNode("Objects");
+    TreeNode object = Xml_CreateNode("Object");
+    TreeNode_AddChild(object, Xml_CreateNodeWithValue("ID", "%d", 3));
+    TreeNode instance = Xml_CreateNode("ObjectInstance");
+    TreeNode_AddChild(instance, Xml_CreateNodeWithValue("ID", "%d", 0));
+    for (int i = 0; i < numResources; i++)
+    {
+        TreeNode resource = Xml_CreateNode("Resource");
+        TreeNode_AddChild(resource, Xml_CreateNodeWithValue("ID", "%d", i));
+        TreeNode_AddChild(resource, Xml_CreateNodeWithValue("Value", "%s", "SW9uLCBJbWFnaW5hdGlvbiBUZWNobm9sb2dpZXM="));
+        TreeNode result = Xml_CreateNode("Result");
+        TreeNode_AddChild(result, Xml_CreateNodeWithValue("Error", "%s", "AwaError_Success"));
+        TreeNode_AddChild(resource, result);
+        TreeNode_AddChild(instance, resource);
+    }
+    TreeNode_AddChild(object, instance);
+    TreeNode_AddChild(objects, object);
+    TreeNode_AddChild(client, objects);
+    TreeNode_AddChild(clients, client);
+    TreeNode_AddChild(content, clients);
+    TreeNode_AddChild(response, content);
+    return response;
+}
+
+static double MeasureMessagesPerSecond(TreeNode message, bool binary, size_t * encodedLength)
+{
+    static char buffer[65536];
+    const int iterations = 5000;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++)
+    {
+        int length = binary ? Xml_TreeToBinary(message, (uint8_t *)buffer, sizeof(buffer)) :
+                              Xml_TreeToCompactString(message, buffer, sizeof(buffer));
+        TreeNode decoded = binary ? Xml_BinaryToTree((const uint8_t *)buffer, length) :
+                                    TreeNode_ParseXML((uint8_t *)buffer, length, true);
+        EXPECT_TRUE(decoded != NULL);
+        Tree_Delete(decoded);
+        *encodedLength = length;
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return iterations / std::chrono::duration<double>(elapsed).count();
+}
+
+TEST_F(XmlTestSuite, Benchmark_binary_encoding_messages_per_second)
+{
+    TreeNode message = CreateReadResponse(20);
+    size_t xmlLength = 0, binaryLength = 0;
+    double xmlRate = MeasureMessagesPerSecond(message, false, &xmlLength);
+    double binaryRate = MeasureMessagesPerSecond(message, true, &binaryLength);
+    printf("Encode and decode: XML %.0f messages/s (%zu bytes), binary %.0f messages/s (%zu bytes)\n",
+           xmlRate, xmlLength, binaryRate, binaryLength);
+
+    EXPECT_LT(binaryLength, xmlLength);
+    Tree_Delete(message);
+}
+
+TEST_F(XmlTestSuite, Benchmark_compact_serialise_messages_per_second)
+{
+    TreeNode message = CreateReadResponse(20);
+    static char buffer[65536];
+    const int iterations = 20000;
+    int indentedLength = 0, compactLength = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++)
+    {
+        indentedLength = Xml_TreeToString(message, buffer, sizeof(buffer));
+    }
+    double indentedRate = iterations / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++)
+    {
+        compactLength = Xml_TreeToCompactString(message, buffer, sizeof(buffer));
+    }
+    double compactRate = iterations / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("Serialise: indented %.0f messages/s (%d bytes), compact %.0f messages/s (%d bytes)\n",
+           indentedRate, indentedLength, compactRate, compactLength);
+
+    EXPECT_LT(compactLength, indentedLength);
+    Tree_Delete(message);
+}
+
+// Parsing with the fast path must give the same tree as the character-at-a-time parser, which TreeNode_ParseXML
+// uses alone when it is not given the whole document.
+static std::string ParseToString(const std::string & doc, bool wholeDoc)
+{
+    TreeNode node = TreeNode_ParseXML((uint8_t *)doc.data(), doc.size(), wholeDoc);
+    if (node == NULL)
+    {
+        return "(null)";
+    }
+    char * buffer = Xml_TreeToAllocatedString(node, NULL);
+    std::string result(buffer);
+    free(buffer);
+    Tree_Delete(node);
+    return result;
+}
+
+TEST_F(XmlTestSuite, test_XMLParser_ParseDocument_matches_FSM)
+{
+    const std::string longText(300, 'x');
+    std::string deep = "1";
+    for (int i = 0; i < 33; i++)
+    {
+        deep = "<A>" + deep + "</A>";
+    }
+    struct { std::string Doc; bool Fast; } cases[] = {
+        { "<Response>\n <Code>400</Code>\n</Response>\n", true },
+        { "<?xml version=\"1.0\"?>\n<A><B>1</B><C></C><D/><E /></A>", true },
+        { "<A><B>a&lt;b &amp;amp; &quot;c&quot; &apos;d&apos; &gt; &bogus; &</B></A>", true },
+        { "<A><B>" + longText + "&lt;" + longText + "</B></A>", true },
+        { "<A>" + longText + "<B>1</B></A>", false },
+        { "<A>text<B>1</B>tail</A>", true },
+        { "<A><B x=\"1\">1</B></A>", false },
+        { "<A><!-- comment --><B>1</B></A>", false },
+        { "<A><B>1\x01</B></A>", false },
+        { "<A><B>1</B>", false },
+        { "<A></A><B></B>", false },
+        { "<A></B></A>", false },
+        { "<A><B>x</A></B>", false },
+        { "<A><B>1</C></A>", false },
+        { "<A><B>1</B></AB>", false },
+        { "<A><BC>1</B></A>", false },
+        { deep, false },
+        { "no elements", false },
+    };
+
+    for (auto & c : cases)
+    {
+        XMLParser_Context parser = XMLParser_Create();
+        EXPECT_EQ(c.Fast, XMLParser_ParseDocument(parser, c.Doc.data(), c.Doc.size())) << c.Doc;
+        XMLParser_Destroy(parser);
+
+        EXPECT_EQ(ParseToString(c.Doc, false), ParseToString(c.Doc, true)) << c.Doc;
+    }
+
+    const char * escaped = "<A><B>a&lt;b &amp;amp; &bogus; &</B></A>";
+    TreeNode node = TreeNode_ParseXML((uint8_t *)escaped, strlen(escaped), true);
+    ASSERT_TRUE(node != NULL);
+    EXPECT_STREQ("a<b &amp; &bogus; &", (const char *)TreeNode_GetValue(Xml_Find(node, "B")));
+    Tree_Delete(node);
+}
+
+TEST_F(XmlTestSuite, Benchmark_parse_throughput)
+{
+    TreeNode message = CreateReadResponse(1000);
+    char * doc = Xml_TreeToAllocatedString(message, NULL);
+    size_t length = strlen(doc);
+    Tree_Delete(message);
+
+    const int iterations = 50;
+    double rates[2];
+    for (int fast = 0; fast < 2; fast++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++)
+        {
+            TreeNode node = TreeNode_ParseXML((uint8_t *)doc, length, fast == 1);
+            EXPECT_TRUE(node != NULL);
+            Tree_Delete(node);
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        rates[fast] = iterations * length / std::chrono::duration<double>(elapsed).count() / 1e6;
+    }
+    printf("Parse %zu bytes: FSM %.1f MB/s, fast path %.1f MB/s\n", length, rates[0], rates[1]);
+    free(doc);
+}
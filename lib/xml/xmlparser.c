@@ -807,6 +807,209 @@ bool XMLParser_Parse(XMLParser_Context xmlParser, const char *doc, unsigned int
     return result;
 }
 
+/*
+ * Whole-document fast path
+ *
+ * Scans for '<' and '>' with memchr rather than running the FSM per character. Element text is passed to the
+ * character data handler in place, straight from the document, unless it holds entities; those are unescaped in bulk
+ * through a small local buffer. Names are copied to the stack, so nothing is allocated while parsing.
+ */
+#define FAST_TEXT_CHUNK_SIZE        (256)
+#define FAST_PATH_MAX_DEPTH         (32)
+
+typedef struct
+{
+    const char                      *Entity;
+    unsigned int                    Length;
+    char                            Character;
+} XMLParser_entity;
+
+static const XMLParser_entity entities[] =
+{
+    { "&lt;",   4, '<' },
+    { "&gt;",   4, '>' },
+    { "&quot;", 6, '\"' },
+    { "&apos;", 6, '\'' },
+    { "&amp;",  5, '&' },
+};
+
+static const char *noAttributes[] = { NULL };
+
+static void fastPath_charData(XMLParser_Context xmlParser, const char *text, unsigned int length)
+{
+    if(!xmlParser->CharDataHandler)
+        return;
+
+    if(!memchr(text, '&', length))
+    {
+        xmlParser->CharDataHandler(xmlParser->UserData, text, length);
+        return;
+    }
+
+    char chunk[FAST_TEXT_CHUNK_SIZE];
+    unsigned int used = 0;
+    const char *end = text + length;
+    while(text < end)
+    {
+        const char *ampersand = memchr(text, '&', end - text);
+        const char *runEnd = ampersand ? ampersand : end;
+        while(text < runEnd)
+        {
+            unsigned int count = runEnd - text;
+            if(count > FAST_TEXT_CHUNK_SIZE - used)
+                count = FAST_TEXT_CHUNK_SIZE - used;
+            memcpy(&chunk[used], text, count);
+            used += count;
+            text += count;
+            if(used == FAST_TEXT_CHUNK_SIZE)
+            {
+                xmlParser->CharDataHandler(xmlParser->UserData, chunk, used);
+                used = 0;
+            }
+        }
+
+        if(ampersand)
+        {
+            // An unrecognised entity is kept as it is, as XMLParser_unescape does
+            char ch = '&';
+            unsigned int consumed = 1;
+            unsigned int index;
+            for(index = 0; index < sizeof(entities) / sizeof(entities[0]); index++)
+            {
+                if((end - text >= entities[index].Length) && (memcmp(text, entities[index].Entity, entities[index].Length) == 0))
+                {
+                    ch = entities[index].Character;
+                    consumed = entities[index].Length;
+                    break;
+                }
+            }
+            chunk[used++] = ch;
+            text += consumed;
+            if(used == FAST_TEXT_CHUNK_SIZE)
+            {
+                xmlParser->CharDataHandler(xmlParser->UserData, chunk, used);
+                used = 0;
+            }
+        }
+    }
+
+    if(used > 0)
+        xmlParser->CharDataHandler(xmlParser->UserData, chunk, used);
+}
+
+static bool fastPath_copyName(char *name, const char *start, unsigned int length)
+{
+    bool result = false;
+    if(length < MAX_DYNAMIC_STRING_BUFFER_SIZE)
+    {
+        memcpy(name, start, length);
+        name[length] = '\0';
+        result = true;
+    }
+    return result;
+}
+
+bool XMLParser_ParseDocument(XMLParser_Context xmlParser, const char *doc, unsigned int len)
+{
+    if(xmlParser == NULL || doc == NULL || len == 0)
+        return false;
+
+    // The FSM drops these characters wherever they appear, so leave such documents to it
+    unsigned int index;
+    for(index = 0; index < len; index++)
+    {
+        if(BAD_XML_CHAR(doc[index]))
+            return false;
+    }
+
+    char name[MAX_DYNAMIC_STRING_BUFFER_SIZE];
+    const char *end = doc + len;
+    const char *position = doc;
+    const char *text = NULL;                    // Text following the last start tag, or NULL after an end tag
+    const char *openNames[FAST_PATH_MAX_DEPTH];  // Names of the open elements, within the document
+    unsigned int openLengths[FAST_PATH_MAX_DEPTH];
+    unsigned int depth = 0;
+    bool gotRoot = false;
+
+    const char *open;
+    while((open = memchr(position, '<', end - position)) != NULL)
+    {
+        const char *tag = open + 1;
+        const char *close = memchr(tag, '>', end - tag);
+        unsigned int tagLength = close ? close - tag : 0;
+        if(tagLength == 0 || (gotRoot && depth == 0))
+            return false;
+
+        if(*tag == '/')
+        {
+            /* End tag, which must close the innermost open element: the text since the last start tag belongs to it */
+            if(depth == 0 || tagLength - 1 != openLengths[depth - 1] || memcmp(tag + 1, openNames[depth - 1], tagLength - 1) != 0 ||
+               !fastPath_copyName(name, tag + 1, tagLength - 1))
+                return false;
+
+            if(text)
+                fastPath_charData(xmlParser, text, open - text);
+            else if(xmlParser->CharDataHandler)
+                xmlParser->CharDataHandler(xmlParser->UserData, "", 0);
+
+            if(xmlParser->EndHandler)
+                xmlParser->EndHandler(xmlParser->UserData, name);
+            depth--;
+            text = NULL;
+        }
+        else if(*tag == '?')
+        {
+            /* Prolog, only before the root element */
+            if(gotRoot || close[-1] != '?')
+                return false;
+            xmlParser->GotProlog = true;
+            text = close + 1;
+        }
+        else
+        {
+            /* Start tag, optionally self-closing. The FSM passes long text to the handler before it sees a child
+             * element, so leave mixed content of that length to it. Attributes and comments are left to it too. */
+            unsigned int nameLength = 0;
+            while(nameLength < tagLength && tag[nameLength] != ' ' && tag[nameLength] != '/')
+                nameLength++;
+
+            const char *rest = tag + nameLength;
+            unsigned int restLength = tagLength - nameLength;
+            bool selfClosing = (restLength == 1 && rest[0] == '/') || (restLength == 2 && rest[0] == ' ' && rest[1] == '/');
+            if(*tag == '!' || nameLength == 0 || (restLength > 0 && !selfClosing) ||
+               (text && open - text > DEFAULT_DYNAMIC_STRING_BUFFER_SIZE) ||
+               !fastPath_copyName(name, tag, nameLength))
+                return false;
+
+            if(xmlParser->StartHandler)
+                xmlParser->StartHandler(xmlParser->UserData, name, noAttributes);
+            if(selfClosing)
+            {
+                if(xmlParser->EndHandler)
+                    xmlParser->EndHandler(xmlParser->UserData, name);
+            }
+            else
+            {
+                if(depth == FAST_PATH_MAX_DEPTH)
+                    return false;
+                openNames[depth] = tag;
+                openLengths[depth] = nameLength;
+                depth++;
+            }
+            gotRoot = true;
+            text = close + 1;
+        }
+        position = close + 1;
+    }
+
+    if(!gotRoot || depth > 0)
+        return false;
+
+    xmlParser->DocIndex = len;
+    xmlParser->State = XMLParserState_Done;
+    return true;
+}
+
 bool XMLParser_SetCharDataHandler(XMLParser_Context myParser, XMLParser_CharacterDataHandler handler)
 {
     bool result = false;
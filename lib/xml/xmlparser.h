@@ -135,6 +135,12 @@ XMLParser_Context XMLParser_Create (void);
 bool XMLParser_Destroy (XMLParser_Context context);
 bool XMLParser_IsFinished(XMLParser_Context xmlParser);
 bool XMLParser_Parse (XMLParser_Context xmlParser, const char *doc, unsigned int len, bool lastChunk);
+
+/* Parse a complete document without per-character work, for elements without attributes, text, self-closing
+ * elements and a leading prolog, nested no more than 32 deep. Returns false if the document falls outside that subset
+ * or is incomplete or badly nested, possibly after some handlers have run; the caller should then discard what they
+ * built and use XMLParser_Parse. */
+bool XMLParser_ParseDocument (XMLParser_Context xmlParser, const char *doc, unsigned int len);
 bool XMLParser_SetCharDataHandler(XMLParser_Context myParser, XMLParser_CharacterDataHandler handler);
 bool XMLParser_SetEndHandler(XMLParser_Context myParser, XMLParser_EndElementHandler handler);
 bool XMLParser_SetUserData(XMLParser_Context myParser, void *userData);
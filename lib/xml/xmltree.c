@@ -28,7 +28,9 @@
 #include <stdlib.h>
 
 #define INITIAL_TREENODE_CHILD_SLOTS    (16)
-#define MAX_TREENODE_CHILDREN           (128)
+
+// Nodes with fewer children than this are searched linearly rather than indexed
+#define CHILD_INDEX_THRESHOLD           (16)
 
 #define Flow_MemRealloc realloc
 #define Flow_MemAlloc malloc
@@ -59,6 +61,26 @@ static char *FlowString_DuplicateWithLength(const char *text, int textLength)
 
 struct _TreeNode;
 
+typedef struct
+{
+    int ID;
+    struct TreeNodeImpl* Node;              // NULL if the slot is free
+
+} ChildIndexSlot;
+
+// Open-addressed table from integer ID to child, built on the first TreeNode_FindChildByID
+// and caught up with children added since on each later call.
+typedef struct
+{
+    char *ChildName;                        // Name of the children indexed
+    char *IDName;                           // Name of the grandchild holding each child's ID
+    ChildIndexSlot *Slots;
+    uint32_t SlotCount;                     // Always a power of two
+    uint32_t Count;                         // Number of slots in use
+    uint32_t IndexedCount;                  // Children before this position have been indexed
+
+} ChildIndex;
+
 typedef struct
 {
     struct TreeNodeImpl* Parent;            // Link to parent
@@ -70,6 +92,8 @@ typedef struct
     uint8_t     *Value;                         // Node value
     uint32_t ChildID;                       // The ID of this child (relative to its parent node). 0 = invalid, 1 ... n = valid
 
+    ChildIndex *Index;                      // Children by ID, NULL until first searched by ID
+
 } TreeNodeImpl;
 
 
@@ -90,6 +114,224 @@ void HTTP_xmlDOMBuilder_EndElementHandler(void *userData, const char *nodeName);
 void HTTP_xmlDOMBuilder_CharDataHandler(void *userData, const char *s, int len);
 
 
+static void ChildIndex_Free(ChildIndex **index)
+{
+    if (*index)
+    {
+        Flow_MemFree((void **) &(*index)->ChildName);
+        Flow_MemFree((void **) &(*index)->IDName);
+        Flow_MemFree((void **) &(*index)->Slots);
+        Flow_MemFree((void **) index);
+    }
+}
+
+static uint32_t ChildIndex_Hash(int ID)
+{
+    // Knuth's multiplicative hash spreads consecutive IDs across the table
+    return (uint32_t)ID * 2654435761u;
+}
+
+// Read a child's ID the same way xmlif_GetInteger does. Returns false if the child has no ID (yet).
+static bool GetChildID(_treeNode child, const char *idName, int *ID)
+{
+    uint32_t index;
+    for (index = 0; index < child->ChildCount; index++)
+    {
+        _treeNode grandchild = (_treeNode) child->Children[index];
+        if (grandchild && grandchild->Name && (strcmp(grandchild->Name, idName) == 0))
+        {
+            if (grandchild->Value)
+            {
+                *ID = atoi((const char *) grandchild->Value);
+                return true;
+            }
+            break;
+        }
+    }
+    return false;
+}
+
+static bool ChildIndex_Insert(ChildIndex *index, int ID, struct TreeNodeImpl *child)
+{
+    if ((index->Count + 1) * 2 > index->SlotCount)
+    {
+        // Keep the table at most half full so probe sequences stay short
+        uint32_t newSlotCount = index->SlotCount ? index->SlotCount * 2 : INITIAL_TREENODE_CHILD_SLOTS * 2;
+        ChildIndexSlot *newSlots = (ChildIndexSlot *) Flow_MemAlloc(sizeof(ChildIndexSlot) * newSlotCount);
+        if (newSlots == NULL)
+        {
+            return false;
+        }
+        memset(newSlots, 0, sizeof(ChildIndexSlot) * newSlotCount);
+
+        uint32_t slot;
+        for (slot = 0; slot < index->SlotCount; slot++)
+        {
+            if (index->Slots[slot].Node)
+            {
+                uint32_t newSlot = ChildIndex_Hash(index->Slots[slot].ID) & (newSlotCount - 1);
+                while (newSlots[newSlot].Node)
+                {
+                    newSlot = (newSlot + 1) & (newSlotCount - 1);
+                }
+                newSlots[newSlot] = index->Slots[slot];
+            }
+        }
+        Flow_MemFree((void **) &index->Slots);
+        index->Slots = newSlots;
+        index->SlotCount = newSlotCount;
+    }
+
+    uint32_t slot = ChildIndex_Hash(ID) & (index->SlotCount - 1);
+    while (index->Slots[slot].Node)
+    {
+        if (index->Slots[slot].ID == ID)
+        {
+            // Keep the first child with this ID, as a linear search would find
+            return true;
+        }
+        slot = (slot + 1) & (index->SlotCount - 1);
+    }
+    index->Slots[slot].ID = ID;
+    index->Slots[slot].Node = child;
+    index->Count++;
+    return true;
+}
+
+static _treeNode ChildIndex_Lookup(const ChildIndex *index, int ID)
+{
+    if (index->SlotCount)
+    {
+        uint32_t slot = ChildIndex_Hash(ID) & (index->SlotCount - 1);
+        while (index->Slots[slot].Node)
+        {
+            if (index->Slots[slot].ID == ID)
+            {
+                return (_treeNode) index->Slots[slot].Node;
+            }
+            slot = (slot + 1) & (index->SlotCount - 1);
+        }
+    }
+    return NULL;
+}
+
+// A child already in its parent's index has changed in a way that may change its name or ID, so rebuild the
+// index on the next search. Children not yet indexed are picked up as they are.
+static void InvalidateChildIndex(_treeNode child)
+{
+    _treeNode parent = child ? (_treeNode) child->Parent : NULL;
+    if (parent && parent->Index && (child->ChildID > 0) && (child->ChildID - 1 < parent->Index->IndexedCount))
+    {
+        ChildIndex_Free(&parent->Index);
+    }
+}
+
+// As InvalidateChildIndex, for a change to a node that may hold its parent's ID
+static void InvalidateIDNode(_treeNode node)
+{
+    if (node && node->Parent)
+    {
+        InvalidateChildIndex((_treeNode) node->Parent);
+    }
+}
+
+static ChildIndex *GetChildIndex(_treeNode _node, const char *childName, const char *idName)
+{
+    if (_node->Index && ((strcmp(_node->Index->ChildName, childName) != 0) || (strcmp(_node->Index->IDName, idName) != 0)))
+    {
+        ChildIndex_Free(&_node->Index);
+    }
+    if (_node->Index == NULL)
+    {
+        ChildIndex *index = (ChildIndex *) Flow_MemAlloc(sizeof(ChildIndex));
+        if (index)
+        {
+            memset(index, 0, sizeof(ChildIndex));
+            index->ChildName = strdup(childName);
+            index->IDName = strdup(idName);
+            if (index->ChildName && index->IDName)
+            {
+                _node->Index = index;
+            }
+            else
+            {
+                ChildIndex_Free(&index);
+            }
+        }
+    }
+
+    // Index children added since the last search. A child whose ID has not been set yet stops the
+    // catch-up so that it is indexed by a later search; until then it is found by the linear search.
+    ChildIndex *index = _node->Index;
+    while (index && (index->IndexedCount < _node->ChildCount))
+    {
+        _treeNode child = (_treeNode) _node->Children[index->IndexedCount];
+        if (child && child->Name && (strcmp(child->Name, childName) == 0))
+        {
+            int ID;
+            if (!GetChildID(child, idName, &ID))
+            {
+                break;
+            }
+            if (!ChildIndex_Insert(index, ID, (struct TreeNodeImpl *) child))
+            {
+                ChildIndex_Free(&_node->Index);
+                break;
+            }
+        }
+        index->IndexedCount++;
+    }
+    return _node->Index;
+}
+
+TreeNode TreeNode_FindChildByID(const TreeNode node, const char *childName, const char *idName, int ID)
+{
+    _treeNode _node = (_treeNode) node;
+    uint32_t childIndex = 0;
+
+    if ((_node == NULL) || (childName == NULL) || (idName == NULL))
+    {
+        return NULL;
+    }
+
+    if ((_node->ChildCount >= CHILD_INDEX_THRESHOLD) || _node->Index)
+    {
+        ChildIndex *index = GetChildIndex(_node, childName, idName);
+        if (index)
+        {
+            _treeNode child = ChildIndex_Lookup(index, ID);
+            int childID;
+            if (child && (child->Parent == (struct TreeNodeImpl *) _node) && child->Name && (strcmp(child->Name, childName) == 0) &&
+                GetChildID(child, idName, &childID) && (childID == ID))
+            {
+                return child;
+            }
+            if (child)
+            {
+                // the index is out of date, so don't trust it
+                ChildIndex_Free(&_node->Index);
+            }
+            else
+            {
+                childIndex = index->IndexedCount;
+            }
+        }
+    }
+
+    // Search the children not covered by the index
+    for (; childIndex < _node->ChildCount; childIndex++)
+    {
+        _treeNode child = (_treeNode) _node->Children[childIndex];
+        int childID;
+        if (child && child->Name && (strcmp(child->Name, childName) == 0) && GetChildID(child, idName, &childID) && (childID == ID))
+        {
+            return child;
+        }
+    }
+    return NULL;
+}
+
+
 bool TreeNode_AddChild(TreeNode node, TreeNode child)
 {
     bool result = false;
@@ -101,12 +343,13 @@ bool TreeNode_AddChild(TreeNode node, TreeNode child)
         {
             TreeNodeImpl **oldChildrenList = (TreeNodeImpl**) _node->Children;
 
-            // Double list capacity
-            uint32_t newChildrenListSize = sizeof(TreeNode) * (_node->ChildSlots * 2);
+            // Double list capacity; there is no limit on the number of children
+            uint32_t newChildSlots = _node->ChildSlots ? (_node->ChildSlots * 2) : INITIAL_TREENODE_CHILD_SLOTS;
+            uint32_t newChildrenListSize = sizeof(TreeNode) * newChildSlots;
             _node->Children = (struct TreeNodeImpl**) Flow_MemAlloc(newChildrenListSize);
             if (_node->Children)
             {
-                _node->ChildSlots = (_node->ChildSlots * 2);
+                _node->ChildSlots = newChildSlots;
                 memset(_node->Children, 0, newChildrenListSize);
                 memcpy(_node->Children, oldChildrenList, _node->ChildCount * sizeof(TreeNode));
                 Flow_MemFree((void **) &oldChildrenList);
@@ -158,6 +401,11 @@ bool Tree_DetachNode(TreeNode node)
             _parent->ChildCount--;
             _node->Parent = NULL;
 
+            // Children have moved, so rebuild the index on the next search. The node may also have held the
+            // parent's ID, by which the grandparent indexes it.
+            ChildIndex_Free(&_parent->Index);
+            InvalidateChildIndex(_parent);
+
             result = true;
         }
     }
@@ -170,6 +418,7 @@ bool TreeNode_AppendValue(const TreeNode node, const uint8_t* value, const uint3
     _treeNode _node = (_treeNode) node;
     if (_node && value)
     {
+        InvalidateIDNode(_node);
         if (_node->Value)
         {
             int currentLength = strlen((const char*)_node->Value);
@@ -249,6 +498,7 @@ bool TreeNode_DeleteSingle(TreeNode node)
 
         if(_node->Children)
             Flow_MemFree((void **)&_node->Children);
+        ChildIndex_Free(&_node->Index);
 
         Flow_MemFree((void **)&_node);
         result = true;
@@ -411,6 +661,8 @@ bool TreeNode_SetName(const TreeNode node, const char* name, const uint32_t leng
     _treeNode _node = (_treeNode) node;
     if (_node && name)
     {
+        InvalidateChildIndex(_node);
+        InvalidateIDNode(_node);
         if (_node->Name)
             Flow_MemFree((void **) &_node->Name);
 
@@ -445,6 +697,7 @@ bool TreeNode_SetValue(const TreeNode node, const uint8_t* value, const uint32_t
     _treeNode _node = (_treeNode) node;
     if (_node && value)
     {
+        InvalidateIDNode(_node);
         if (_node->Value)
             Flow_MemFree((void **) &_node->Value);
 
@@ -491,6 +744,20 @@ TreeNode Tree_Copy(TreeNode node)
     return _newNode;
 }
 
+static void DeleteSubtree(_treeNode _node)
+{
+    uint32_t childIndex;
+    for (childIndex = 0; childIndex < _node->ChildCount; childIndex++)
+    {
+        if (_node->Children[childIndex])
+        {
+            DeleteSubtree((_treeNode) _node->Children[childIndex]);
+        }
+    }
+    _node->ChildCount = 0;
+    TreeNode_DeleteSingle(_node);
+}
+
 bool Tree_Delete(TreeNode node)
 {
     bool result = false;
@@ -498,54 +765,11 @@ bool Tree_Delete(TreeNode node)
 
     if (_rootNode)
     {
-        _treeNode currentNode = _rootNode;
-        while (currentNode)
-        {
-            // Find the end node of a branch
-            while (currentNode->ChildCount)
-            {
-                uint32_t childIndex;
+        // Unlink the node from its parent, which stays in place
+        Tree_DetachNode(_rootNode);
 
-                for (childIndex = 0; childIndex < currentNode->ChildSlots; childIndex++)
-                {
-                    if (currentNode->Children && currentNode->Children[childIndex])
-                    {
-                        currentNode = (_treeNode) currentNode->Children[childIndex];
-                        childIndex = currentNode->ChildSlots + 1; // Exit 'for' loop
-                    }
-                }
-            }
-
-            //
-            // Should be at bottom of a branch
-            // (next, free the node)
-
-            // If the currentNode has a parent, break the parent's link to the node
-            if (currentNode->Parent)
-            {
-                _treeNode parentNode = (_treeNode) currentNode->Parent;
-                parentNode->Children[currentNode->ChildID-1] = NULL;
-                if (((_treeNode) currentNode->Parent)->ChildCount > 0)
-                    ((_treeNode) currentNode->Parent)->ChildCount--;
-                 currentNode->ChildID = 0;  // The node is no longer a child-node
-            }
-            // else, must be the 'root' node
-            
-            // Free the curentNode's name, value & 'children' array
-            if (currentNode->Name)
-                Flow_MemFree((void **) &currentNode->Name);
-            if (currentNode->Value)
-                Flow_MemFree((void **) &currentNode->Value);
-            if (currentNode->Children)
-                Flow_MemFree((void **) &currentNode->Children);
-
-             // Move currentNode up to its parent before freeing this node
-            _treeNode tempNode = currentNode;
-            currentNode = (_treeNode) currentNode->Parent;
-            Flow_MemFree((void **) &tempNode);
-
-            // Rinse and repeat, now that we're at the new end of the old branch
-        }
+        // Each child is visited once, rather than searching each node's child slots again for every child freed
+        DeleteSubtree(_rootNode);
         result = true;
     }
 
@@ -571,11 +795,18 @@ TreeNode TreeNode_ParseXML(uint8_t* doc, uint32_t length, bool wholeDoc)
             XMLParser_SetCharDataHandler(bodyParser, HTTP_xmlDOMBuilder_CharDataHandler);
             XMLParser_SetEndHandler(bodyParser, HTTP_xmlDOMBuilder_EndElementHandler);
             XMLParser_SetUserData(bodyParser, &root);
-            if (XMLParser_Parse(bodyParser, (const char*) doc, length, wholeDoc))
+
+            bool parsed = wholeDoc && XMLParser_ParseDocument(bodyParser, (const char*) doc, length);
+            if (!parsed)
             {
-                // Parsed ok
+                // The fast path declined the document, so discard anything it built and parse it with the FSM
+                Tree_Delete(root);
+                root = NULL;
+                currentTreeNode = NULL;
+                parsed = XMLParser_Parse(bodyParser, (const char*) doc, length, wholeDoc);
             }
-            else
+
+            if (!parsed)
             {
                 // Parsing failed
                 // Clean up tree
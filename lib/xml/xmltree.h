@@ -41,6 +41,7 @@ bool TreeNode_DeleteSingle(TreeNode node);                      // Delete this n
 int TreeNode_GetChildCount(TreeNode node);
 int TreeNode_GetID(TreeNode node);
 TreeNode TreeNode_GetChild(TreeNode node, uint32_t index);
+TreeNode TreeNode_FindChildByID(const TreeNode node, const char *childName, const char *idName, int ID);  // First child named childName whose idName child has value ID
 const char *TreeNode_GetName(const TreeNode node);
 TreeNode TreeNode_GetParent(const TreeNode node);
 const uint8_t *TreeNode_GetValue(const TreeNode node);
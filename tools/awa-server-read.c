@@ -76,11 +76,10 @@ static void AddTarget(AwaServerReadOperation * operation, const Target * target,
     }
 }
 
-static char * ResponseToCString(const AwaServerSession * session, const AwaServerReadResponse * response, Target ** targets, int numTargets, bool quiet)
+static char * ResponseToCString(const AwaServerSession * session, const AwaServerReadResponse * response, Target ** targets, int numTargets, bool quiet,
+                                AwaObjectID * lastObjectID, AwaObjectInstanceID * lastObjectInstanceID)
 {
     char * cstring = strdup("");
-    AwaObjectID lastObjectID = AWA_INVALID_ID;
-    AwaObjectInstanceID lastObjectInstanceID = AWA_INVALID_ID;
     AwaPathIterator * iterator = AwaServerReadResponse_NewPathIterator(response);
     while (AwaPathIterator_Next(iterator))
     {
@@ -95,7 +94,7 @@ static char * ResponseToCString(const AwaServerSession * session, const AwaServe
             do
             {
                 resourceInstanceID = GetNextTargetResourceInstanceIDFromPath(targets, numTargets, path, &targetIndex);
-                Server_AddPathToCString(&cstring, path, session, (void *)response, ResponseType_ReadResponse, quiet, &lastObjectID, &lastObjectInstanceID, resourceInstanceID);
+                Server_AddPathToCString(&cstring, path, session, (void *)response, ResponseType_ReadResponse, quiet, lastObjectID, lastObjectInstanceID, resourceInstanceID);
             } while (resourceInstanceID != AWA_INVALID_ID);
         }
         else
@@ -115,25 +114,56 @@ static char * ResponseToCString(const AwaServerSession * session, const AwaServe
     return cstring;
 }
 
-static int ProcessReadOperation(const AwaServerSession * session, AwaServerReadOperation * operation, Target ** targets, int numTargets, const char * clientID, bool quiet)
+// The daemon accepts a single path per client in each Read request, so each path is read with
+// its own operation. Several paths are sent together as a single batch.
+static int ProcessReadOperations(const AwaServerSession * session, AwaServerReadOperation ** operations, Target ** targets, int numTargets, const char * clientID, bool quiet)
 {
     int result = 0;
-    const AwaServerReadResponse * response = NULL;
-    char * output = NULL;
-    if (AwaServerReadOperation_Perform(operation, OPERATION_PERFORM_TIMEOUT) != AwaError_Success)
+    AwaObjectID lastObjectID = AWA_INVALID_ID;
+    AwaObjectInstanceID lastObjectInstanceID = AWA_INVALID_ID;
+
+    if (numTargets == 1)
     {
-        Error("AwaServerReadOperation_Perform failed\n");
-        result = 1;
+        if (AwaServerReadOperation_Perform(operations[0], OPERATION_PERFORM_TIMEOUT) != AwaError_Success)
+        {
+            Error("AwaServerReadOperation_Perform failed\n");
+            result = 1;
+        }
+    }
+    else
+    {
+        AwaServerBatchOperation * batch = AwaServerBatchOperation_New(session);
+        int i;
+        for (i = 0; i < numTargets; ++i)
+        {
+            if (targets[i] != NULL)
+            {
+                AwaServerBatchOperation_AddReadOperation(batch, operations[i]);
+            }
+        }
+
+        if (AwaServerBatchOperation_Perform(batch, OPERATION_PERFORM_TIMEOUT) != AwaError_Success)
+        {
+            Error("AwaServerBatchOperation_Perform failed\n");
+            result = 1;
+        }
+        AwaServerBatchOperation_Free(&batch);
     }
 
-    response = AwaServerReadOperation_GetResponse(operation, clientID);
-    output = ResponseToCString(session, response, targets, numTargets, quiet);
-    if (output != NULL)
+    int i;
+    for (i = 0; i < numTargets; ++i)
     {
-        printf("%s", output);
+        if ((numTargets == 1) || (targets[i] != NULL))
+        {
+            const AwaServerReadResponse * response = AwaServerReadOperation_GetResponse(operations[i], clientID);
+            char * output = ResponseToCString(session, response, targets, numTargets, quiet, &lastObjectID, &lastObjectInstanceID);
+            if (output != NULL)
+            {
+                printf("%s", output);
+            }
+            free(output);
+        }
     }
-    free(output);
-    output = NULL;
     return result;
 }
 
@@ -142,7 +172,7 @@ int main(int argc, char ** argv)
     int result = 0;
     struct gengetopt_args_info ai;
     AwaServerSession * session = NULL;
-    AwaServerReadOperation * operation = NULL;
+    AwaServerReadOperation ** operations = NULL;
     Target ** targets = NULL;
 
     if (cmdline_parser(argc, argv, &ai) != 0)
@@ -169,28 +199,29 @@ int main(int argc, char ** argv)
     session = Server_EstablishSession(ai.ipcAddress_arg, ai.ipcPort_arg);
     if (session != NULL)
     {
-        // Create Read operation
-        operation = AwaServerReadOperation_New(session);
-        if (operation == NULL)
-        {
-            Error("AwaServerReadOperation_New failed\n");
-            result = 1;
-            goto cleanup;
-        }
+        targets = calloc(ai.inputs_num, sizeof(Target *));
+        operations = calloc(ai.inputs_num, sizeof(AwaServerReadOperation *));
 
-        targets = malloc(ai.inputs_num * sizeof(Target *));
-        // Add target paths from command line
+        // Create a Read operation for each target path from command line
         int i = 0;
         for (i = 0; i < ai.inputs_num; ++i)
         {
+            operations[i] = AwaServerReadOperation_New(session);
+            if (operations[i] == NULL)
+            {
+                Error("AwaServerReadOperation_New failed\n");
+                result = 1;
+                goto cleanup;
+            }
+
             targets[i] = CreateTarget(ai.inputs[i]);
             if (targets[i] != NULL)
             {
-                AddTarget(operation, targets[i], ai.clientID_arg);
+                AddTarget(operations[i], targets[i], ai.clientID_arg);
             }
         }
 
-        result = ProcessReadOperation(session, operation, targets, ai.inputs_num, ai.clientID_arg, ai.quiet_given);
+        result = ProcessReadOperations(session, operations, targets, ai.inputs_num, ai.clientID_arg, ai.quiet_given);
     }
     else
     {
@@ -199,9 +230,17 @@ int main(int argc, char ** argv)
     }
 
 cleanup:
-    if (operation)
+    if (operations)
     {
-        AwaServerReadOperation_Free(&operation);
+        int i;
+        for (i = 0; i < ai.inputs_num; ++i)
+        {
+            if (operations[i] != NULL)
+            {
+                AwaServerReadOperation_Free(&operations[i]);
+            }
+        }
+        free(operations);
     }
     if (session)
     {
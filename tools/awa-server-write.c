@@ -337,19 +337,54 @@ static int AddTargetWithValue(const AwaServerSession * session, AwaServerWriteOp
     return result;
 }
 
-static int ProcessWriteOperation(AwaServerWriteOperation * operation, const char * clientID)
+// The daemon accepts a single object instance in each Write request, so targets are grouped by object instance,
+// with one Write operation per group. Several groups are sent together as a single batch.
+typedef struct
 {
-    int result = 0;
-    if (AwaServerWriteOperation_Perform(operation, clientID, OPERATION_PERFORM_TIMEOUT) != AwaError_Success)
+    AwaObjectID ObjectID;
+    AwaObjectInstanceID ObjectInstanceID;
+    AwaServerWriteOperation * Operation;
+    int Count;
+} WriteGroup;
+
+static WriteGroup * GetWriteGroup(const AwaServerSession * session, WriteGroup * groups, int * numGroups, const Target * target)
+{
+    WriteGroup * group = NULL;
+    AwaObjectID objectID = AWA_INVALID_ID;
+    AwaObjectInstanceID objectInstanceID = AWA_INVALID_ID;
+    AwaServerSession_PathToIDs(session, target->Path, &objectID, &objectInstanceID, NULL);
+
+    int i;
+    for (i = 0; i < *numGroups; ++i)
     {
-        Error("AwaServerWriteOperation_Perform failed\n");
-        result = 1;
+        if ((groups[i].ObjectID == objectID) && (groups[i].ObjectInstanceID == objectInstanceID))
+        {
+            group = &groups[i];
+            break;
+        }
     }
-    else
+
+    if (group == NULL)
     {
-        Verbose("Write operation completed successfully.\n");
+        AwaServerWriteOperation * operation = AwaServerWriteOperation_New(session, AwaWriteMode_Update);
+        if (operation != NULL)
+        {
+            group = &groups[(*numGroups)++];
+            group->ObjectID = objectID;
+            group->ObjectInstanceID = objectInstanceID;
+            group->Operation = operation;
+            group->Count = 0;
+        }
+        else
+        {
+            Error("AwaServerWriteOperation_New failed\n");
+        }
     }
+    return group;
+}
 
+static void PrintWriteResponse(AwaServerWriteOperation * operation, const char * clientID)
+{
     const AwaServerWriteResponse * response = AwaServerWriteOperation_GetResponse(operation, clientID);
     if (response != NULL)
     {
@@ -373,10 +408,71 @@ static int ProcessWriteOperation(AwaServerWriteOperation * operation, const char
         }
         AwaPathIterator_Free(&iterator);
     }
+}
+
+static int ProcessWriteOperations(const AwaServerSession * session, WriteGroup * groups, int numGroups, const char * clientID)
+{
+    int result = 0;
+    int i;
+
+    // only groups with at least one valid target are sent
+    WriteGroup * firstGroup = NULL;
+    int numValidGroups = 0;
+    for (i = 0; i < numGroups; ++i)
+    {
+        if (groups[i].Count > 0)
+        {
+            firstGroup = (firstGroup == NULL) ? &groups[i] : firstGroup;
+            ++numValidGroups;
+        }
+    }
+
+    if (numValidGroups == 1)
+    {
+        if (AwaServerWriteOperation_Perform(firstGroup->Operation, clientID, OPERATION_PERFORM_TIMEOUT) != AwaError_Success)
+        {
+            Error("AwaServerWriteOperation_Perform failed\n");
+            result = 1;
+        }
+        else
+        {
+            Verbose("Write operation completed successfully.\n");
+        }
+    }
+    else
+    {
+        AwaServerBatchOperation * batch = AwaServerBatchOperation_New(session);
+        for (i = 0; i < numGroups; ++i)
+        {
+            if (groups[i].Count > 0)
+            {
+                AwaServerBatchOperation_AddWriteOperation(batch, groups[i].Operation, clientID);
+            }
+        }
+
+        if (AwaServerBatchOperation_Perform(batch, OPERATION_PERFORM_TIMEOUT) != AwaError_Success)
+        {
+            Error("AwaServerBatchOperation_Perform failed\n");
+            result = 1;
+        }
+        else
+        {
+            Verbose("Write operation completed successfully.\n");
+        }
+        AwaServerBatchOperation_Free(&batch);
+    }
+
+    for (i = 0; i < numGroups; ++i)
+    {
+        if (groups[i].Count > 0)
+        {
+            PrintWriteResponse(groups[i].Operation, clientID);
+        }
+    }
     return result;
 }
 
-static int CreateTargets(const AwaServerSession * session, AwaServerWriteOperation * operation, const char * clientID, char ** targets, unsigned int numCreates)
+static int CreateTargets(const AwaServerSession * session, WriteGroup * groups, int * numGroups, const char * clientID, char ** targets, unsigned int numCreates)
 {
     int count = 0;
     int i = 0;
@@ -388,9 +484,11 @@ static int CreateTargets(const AwaServerSession * session, AwaServerWriteOperati
         Target * target = CreateTarget(targets[i]);
         if (Server_IsObjectTarget(session, target) || Server_IsObjectInstanceTarget(session, target))
         {
-            if (AwaServerWriteOperation_CreateObjectInstance(operation, target->Path) == AwaError_Success)
+            WriteGroup * group = GetWriteGroup(session, groups, numGroups, target);
+            if ((group != NULL) && (AwaServerWriteOperation_CreateObjectInstance(group->Operation, target->Path) == AwaError_Success))
             {
                 Verbose("Create %s\n", target->Path);
+                ++group->Count;
                 ++count;
             }
         }
@@ -409,7 +507,8 @@ int main(int argc, char ** argv)
     int result = 1;
     struct gengetopt_args_info ai; 
     AwaServerSession * session = NULL;
-    AwaServerWriteOperation * operation = NULL;
+    WriteGroup * groups = NULL;
+    int numGroups = 0;
     char address[128];
     unsigned int port;
     if (cmdline_parser(argc, argv, &ai) != 0)
@@ -440,18 +539,17 @@ int main(int argc, char ** argv)
         goto cleanup;
     }
 
-    operation = AwaServerWriteOperation_New(session, AwaWriteMode_Update);
-    if (operation == NULL)
+    groups = calloc(ai.inputs_num + ai.create_given, sizeof(*groups));
+    if (groups == NULL)
     {
-        Error("AwaServerWriteOperation_New failed\n");
-        Server_ReleaseSession(&session);
+        Error("Out of memory\n");
         result = 1;
         goto cleanup;
     }
 
     // Add create directives first
     int count = 0;
-    count = CreateTargets(session, operation, ai.clientID_arg, ai.create_arg, ai.create_given);
+    count = CreateTargets(session, groups, &numGroups, ai.clientID_arg, ai.create_arg, ai.create_given);
 
     // Add target paths and values from the command line
     int i = 0;
@@ -463,8 +561,10 @@ int main(int argc, char ** argv)
             char * value = Server_GetValue(session, target, ai.inputs[i]);
             if (value != NULL)
             {
-                if (AddTargetWithValue(session, operation, target, value) == 0)
+                WriteGroup * group = GetWriteGroup(session, groups, &numGroups, target);
+                if ((group != NULL) && (AddTargetWithValue(session, group->Operation, target, value) == 0))
                 {
+                    ++group->Count;
                     ++count;
                 }
 
@@ -476,13 +576,18 @@ int main(int argc, char ** argv)
     }
     if (count > 0)
     {
-        result = ProcessWriteOperation(operation, ai.clientID_arg);
+        result = ProcessWriteOperations(session, groups, numGroups, ai.clientID_arg);
     }
 
 cleanup:
-    if (operation)
+    if (groups)
     {
-        AwaServerWriteOperation_Free(&operation);
+        int i;
+        for (i = 0; i < numGroups; ++i)
+        {
+            AwaServerWriteOperation_Free(&groups[i].Operation);
+        }
+        free(groups);
     }
     if (session)
     {